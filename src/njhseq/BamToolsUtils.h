@@ -30,6 +30,9 @@
 #include "njhseq/BamToolsUtils/bamExtractUtils.hpp"
 #include "njhseq/BamToolsUtils/BamAlnsCache.hpp"
 #include "njhseq/BamToolsUtils/BamAlnsCacheWithRegion.hpp"
+#include "njhseq/BamToolsUtils/BamMatePairer.hpp"
+#include "njhseq/BamToolsUtils/BamRegionPartitionReader.hpp"
+#include "njhseq/BamToolsUtils/ParallelBamReader.hpp"
 #include "njhseq/BamToolsUtils/BamCountExtractStats.hpp"
 #include "njhseq/BamToolsUtils/ReAlignedSeq.hpp"
 
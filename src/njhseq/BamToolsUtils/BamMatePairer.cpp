@@ -0,0 +1,278 @@
+/*
+ * BamMatePairer.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: nick
+ */
+//
+// njhseq - A library for analyzing sequence data
+// Copyright (C) 2012-2018 Nicholas Hathaway <nicholas.hathaway@umassmed.edu>,
+//
+// This file is part of njhseq.
+//
+// njhseq is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// njhseq is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with njhseq.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include "BamMatePairer.hpp"
+#include <queue>
+
+namespace njhseq {
+
+CompactBamAln::CompactBamAln() = default;
+
+CompactBamAln::CompactBamAln(const BamTools::BamAlignment & bAln) :
+		name_(bAln.Name), queryBases_(bAln.QueryBases), qualities_(bAln.Qualities),
+		alignmentFlag_(bAln.AlignmentFlag), refId_(bAln.RefID),
+		position_(bAln.Position), endPosition_(bAln.GetEndPosition()),
+		insertSize_(bAln.InsertSize) {
+}
+
+//flag bits from the SAM spec, same as BamTools::BamAlignment uses
+bool CompactBamAln::isPaired() const {
+	return 0 != (alignmentFlag_ & 0x0001);
+}
+
+bool CompactBamAln::isMapped() const {
+	return 0 == (alignmentFlag_ & 0x0004);
+}
+
+bool CompactBamAln::isMateMapped() const {
+	return 0 == (alignmentFlag_ & 0x0008);
+}
+
+bool CompactBamAln::isReverseStrand() const {
+	return 0 != (alignmentFlag_ & 0x0010);
+}
+
+bool CompactBamAln::isFirstMate() const {
+	return 0 != (alignmentFlag_ & 0x0040);
+}
+
+seqInfo CompactBamAln::toSeqInfo(bool keepPlusStrandOrientation) const {
+	auto ret = seqInfo(name_, queryBases_, qualities_, SangerQualOffset);
+	if (isReverseStrand() && !keepPlusStrandOrientation) {
+		ret.reverseComplementRead(false, true);
+	}
+	return ret;
+}
+
+uint64_t CompactBamAln::approxBytes() const {
+	//the strings, the record and the list node and hash entry holding it
+	return sizeof(CompactBamAln) + 2 * name_.size() + queryBases_.size()
+			+ qualities_.size() + 64;
+}
+
+void CompactBamAln::writeRecord(std::ostream & out) const {
+	//read names, bases and qualities can't contain tabs or new lines so no escaping is needed
+	out << name_
+			<< "\t" << alignmentFlag_
+			<< "\t" << refId_
+			<< "\t" << position_
+			<< "\t" << endPosition_
+			<< "\t" << insertSize_
+			<< "\t" << order_
+			<< "\t" << queryBases_
+			<< "\t" << qualities_ << "\n";
+}
+
+bool CompactBamAln::readRecord(std::istream & in) {
+	std::string line;
+	if (!std::getline(in, line)) {
+		return false;
+	}
+	std::vector<std::string_view> toks;
+	std::string_view lineView(line);
+	size_t start = 0;
+	size_t pos = lineView.find('\t');
+	while (std::string_view::npos != pos) {
+		toks.emplace_back(lineView.substr(start, pos - start));
+		start = pos + 1;
+		pos = lineView.find('\t', start);
+	}
+	toks.emplace_back(lineView.substr(start));
+	if (9 != toks.size()) {
+		std::stringstream ss;
+		ss << __PRETTY_FUNCTION__ << ", error " << "expected 9 fields in spilled alignment record, found " << toks.size() << "\n";
+		throw std::runtime_error { ss.str() };
+	}
+	name_ = std::string(toks[0]);
+	alignmentFlag_ = njh::StrToNumConverter::stoToNum<uint32_t>(std::string(toks[1]));
+	refId_ = njh::StrToNumConverter::stoToNum<int32_t>(std::string(toks[2]));
+	position_ = njh::StrToNumConverter::stoToNum<int32_t>(std::string(toks[3]));
+	endPosition_ = njh::StrToNumConverter::stoToNum<int32_t>(std::string(toks[4]));
+	insertSize_ = njh::StrToNumConverter::stoToNum<int32_t>(std::string(toks[5]));
+	order_ = njh::StrToNumConverter::stoToNum<uint64_t>(std::string(toks[6]));
+	queryBases_ = std::string(toks[7]);
+	qualities_ = std::string(toks[8]);
+	return true;
+}
+
+BamMatePairer::BamMatePairer(const Pars & pars) :
+		pars_(pars) {
+}
+
+BamMatePairer::~BamMatePairer() {
+	if (!spillDir_.empty() && bfs::exists(spillDir_)) {
+		boost::system::error_code ec;
+		bfs::remove_all(spillDir_, ec);
+	}
+}
+
+bool BamMatePairer::takeMate(const std::string & name, CompactBamAln & mate) {
+	auto search = cachedByName_.find(name);
+	if (cachedByName_.end() == search) {
+		return false;
+	}
+	memoryUsed_ -= search->second->approxBytes();
+	mate = std::move(*search->second);
+	cached_.erase(search->second);
+	cachedByName_.erase(search);
+	return true;
+}
+
+void BamMatePairer::add(const BamTools::BamAlignment & bAln) {
+	cached_.emplace_back(bAln);
+	cached_.back().order_ = addCount_++;
+	auto last = std::prev(cached_.end());
+	auto search = cachedByName_.find(last->name_);
+	if (cachedByName_.end() != search) {
+		//a third alignment with the same name, the older one is left to be an orphan
+		search->second = last;
+	} else {
+		cachedByName_.emplace(last->name_, last);
+	}
+	memoryUsed_ += last->approxBytes();
+	if (memoryUsed_ > pars_.maxMemory_) {
+		spill(false);
+	}
+}
+
+void BamMatePairer::spill(bool all) {
+	if (cached_.empty()) {
+		return;
+	}
+	if (spillDir_.empty()) {
+		spillDir_ = njh::files::make_path(pars_.tmpDir_,
+				bfs::unique_path("BamMatePairer-%%%%-%%%%-%%%%"));
+		bfs::create_directories(spillDir_);
+	}
+	std::vector<CompactBamAln> toSpill;
+	while (!cached_.empty() && (all || memoryUsed_ > pars_.maxMemory_ / 2)) {
+		auto & oldest = cached_.front();
+		memoryUsed_ -= oldest.approxBytes();
+		auto search = cachedByName_.find(oldest.name_);
+		if (cachedByName_.end() != search && search->second == cached_.begin()) {
+			cachedByName_.erase(search);
+		}
+		toSpill.emplace_back(std::move(oldest));
+		cached_.pop_front();
+	}
+	njh::sort(toSpill, [](const CompactBamAln & aln1, const CompactBamAln & aln2) {
+		if (aln1.name_ == aln2.name_) {
+			return aln1.order_ < aln2.order_;
+		}
+		return aln1.name_ < aln2.name_;
+	});
+	auto runFnp = njh::files::make_path(spillDir_,
+			"run_" + estd::to_string(runFnps_.size()) + ".tab.txt");
+	std::ofstream runOut(runFnp.string());
+	if (!runOut) {
+		std::stringstream ss;
+		ss << __PRETTY_FUNCTION__ << ", error " << "couldn't open " << runFnp << " for writing" << "\n";
+		throw std::runtime_error { ss.str() };
+	}
+	for (const auto & aln : toSpill) {
+		aln.writeRecord(runOut);
+	}
+	runFnps_.emplace_back(runFnp);
+}
+
+void BamMatePairer::finish(const PairFunc & pairFunc,
+		const OrphanFunc & orphanFunc) {
+	if (runFnps_.empty()) {
+		//nothing was spilled, everything left is an orphan
+		for (const auto & aln : cached_) {
+			orphanFunc(aln);
+		}
+		cached_.clear();
+		cachedByName_.clear();
+		memoryUsed_ = 0;
+		return;
+	}
+	spill(true);
+	//k-way merge of the runs by name then order
+	std::vector<std::unique_ptr<std::ifstream>> runs;
+	for (const auto & runFnp : runFnps_) {
+		runs.emplace_back(std::make_unique<std::ifstream>(runFnp.string()));
+	}
+	struct RunHead {
+		CompactBamAln aln_;
+		uint32_t runPos_;
+	};
+	auto headGreater = [](const RunHead & head1, const RunHead & head2) {
+		if (head1.aln_.name_ == head2.aln_.name_) {
+			return head1.aln_.order_ > head2.aln_.order_;
+		}
+		return head1.aln_.name_ > head2.aln_.name_;
+	};
+	std::priority_queue<RunHead, std::vector<RunHead>, decltype(headGreater)> heads(headGreater);
+	for (const auto runPos : iter::range<uint32_t>(runs.size())) {
+		RunHead head;
+		head.runPos_ = runPos;
+		if (head.aln_.readRecord(*runs[runPos])) {
+			heads.emplace(std::move(head));
+		}
+	}
+	std::vector<CompactBamAln> group;
+	auto processGroup = [&group, &pairFunc, &orphanFunc]() {
+		//consecutive alignments with the same name are mates, an odd one out is an orphan
+		uint32_t pos = 0;
+		for (; pos + 1 < group.size(); pos += 2) {
+			pairFunc(group[pos + 1], group[pos]);
+		}
+		if (pos < group.size()) {
+			orphanFunc(group[pos]);
+		}
+		group.clear();
+	};
+	while (!heads.empty()) {
+		RunHead head = heads.top();
+		heads.pop();
+		if (!group.empty() && group.front().name_ != head.aln_.name_) {
+			processGroup();
+		}
+		group.emplace_back(std::move(head.aln_));
+		RunHead next;
+		next.runPos_ = head.runPos_;
+		if (next.aln_.readRecord(*runs[head.runPos_])) {
+			heads.emplace(std::move(next));
+		}
+	}
+	processGroup();
+	runs.clear();
+	for (const auto & runFnp : runFnps_) {
+		bfs::remove(runFnp);
+	}
+	runFnps_.clear();
+}
+
+uint64_t BamMatePairer::numberCached() const {
+	return cached_.size();
+}
+
+uint32_t BamMatePairer::numberOfSpills() const {
+	return runFnps_.size();
+}
+
+}  // namespace njhseq
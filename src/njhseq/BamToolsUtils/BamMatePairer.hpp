@@ -0,0 +1,141 @@
+#pragma once
+/*
+ * BamMatePairer.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: nick
+ */
+//
+// njhseq - A library for analyzing sequence data
+// Copyright (C) 2012-2018 Nicholas Hathaway <nicholas.hathaway@umassmed.edu>,
+//
+// This file is part of njhseq.
+//
+// njhseq is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// njhseq is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with njhseq.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#include <api/BamAlignment.h>
+#include "njhseq/common.h"
+#include "njhseq/objects/seqObjects/BaseObjects/seqInfo.hpp"
+
+namespace njhseq {
+
+/**@brief Just the parts of a BamTools::BamAlignment needed to pair and write out mates, no cigar, tags or raw char data
+ *
+ */
+class CompactBamAln {
+public:
+	CompactBamAln();
+	explicit CompactBamAln(const BamTools::BamAlignment & bAln);
+
+	std::string name_;
+	std::string queryBases_;
+	std::string qualities_;
+	uint32_t alignmentFlag_{0};
+	int32_t refId_{-1};
+	int32_t position_{-1};
+	int32_t endPosition_{-1};
+	int32_t insertSize_{0};
+	uint64_t order_{0}; /**< the order the alignment was added in, keeps mates in file order after spilling */
+
+	bool isPaired() const;
+	bool isMapped() const;
+	bool isMateMapped() const;
+	bool isReverseStrand() const;
+	bool isFirstMate() const;
+
+	/**@brief Convert to seqInfo, same as bamAlnToSeqInfo()
+	 *
+	 * @param keepPlusStrandOrientation if true the sequence is left in the reference orientation
+	 * @return the seq
+	 */
+	seqInfo toSeqInfo(bool keepPlusStrandOrientation = false) const;
+
+	/**@brief rough number of bytes held, used to cap memory
+	 *
+	 */
+	uint64_t approxBytes() const;
+
+	void writeRecord(std::ostream & out) const;
+	bool readRecord(std::istream & in);
+};
+
+/**@brief Pair mates out of a name unsorted bam while holding at most a set amount of unmatched alignments in memory
+ *
+ * Unmatched alignments are held in the order they were added, when the memory cap is reached the oldest are sorted by name and
+ * written to a run file on disk, mates that are far apart in the file end up in the runs and are paired by merging the runs when finish() is called
+ *
+ */
+class BamMatePairer {
+public:
+	struct Pars {
+		uint64_t maxMemory_ = 1024UL * 1024UL * 1024UL; /**< approximate bytes of unmatched alignments to hold before spilling to disk */
+		bfs::path tmpDir_ = "./"; /**< where spill runs are written, they are removed when done */
+	};
+
+	/**@brief a pair of mates, first is the alignment seen second in the file and second is the mate seen first (the cached mate)
+	 *
+	 */
+	using PairFunc = std::function<void(const CompactBamAln &, const CompactBamAln &)>;
+	using OrphanFunc = std::function<void(const CompactBamAln &)>;
+
+	explicit BamMatePairer(const Pars & pars);
+	~BamMatePairer();
+
+	BamMatePairer(const BamMatePairer & other) = delete;
+	BamMatePairer & operator=(const BamMatePairer & other) = delete;
+
+	const Pars pars_;
+
+	/**@brief If the mate of name is held in memory take it out into mate
+	 *
+	 * @param name the name of the alignment
+	 * @param mate the mate to fill
+	 * @return whether the mate was found
+	 */
+	bool takeMate(const std::string & name, CompactBamAln & mate);
+
+	/**@brief Hold an alignment until it's mate comes along, spilling the oldest alignments to disk if over the memory cap
+	 *
+	 * @param bAln the alignment
+	 */
+	void add(const BamTools::BamAlignment & bAln);
+
+	/**@brief Pair up any mates spilled to disk and hand over everything left without a mate, leaves the pairer empty
+	 *
+	 * @param pairFunc called for each pair of mates
+	 * @param orphanFunc called for each alignment without a mate
+	 */
+	void finish(const PairFunc & pairFunc, const OrphanFunc & orphanFunc);
+
+	uint64_t numberCached() const;
+	uint32_t numberOfSpills() const;
+
+private:
+	std::list<CompactBamAln> cached_; /**< oldest first */
+	std::unordered_map<std::string, std::list<CompactBamAln>::iterator> cachedByName_;
+	uint64_t memoryUsed_{0};
+	uint64_t addCount_{0};
+
+	bfs::path spillDir_;
+	std::vector<bfs::path> runFnps_;
+
+	/**@brief spill the oldest alignments until at least half the cap is free, or everything if all is true
+	 *
+	 */
+	void spill(bool all);
+};
+
+}  // namespace njhseq
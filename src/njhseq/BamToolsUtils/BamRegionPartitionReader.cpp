@@ -0,0 +1,160 @@
+/*
+ * BamRegionPartitionReader.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: nick
+ */
+//
+// njhseq - A library for analyzing sequence data
+// Copyright (C) 2012-2018 Nicholas Hathaway <nicholas.hathaway@umassmed.edu>,
+//
+// This file is part of njhseq.
+//
+// njhseq is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// njhseq is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with njhseq.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include "BamRegionPartitionReader.hpp"
+#include "njhseq/BamToolsUtils/BamToolsUtils.hpp"
+
+namespace njhseq {
+
+BamRegionPartitionReader::Partition::Partition(uint32_t regionPos,
+		const GenomicRegion & window, bool firstInRegion, bool lastInRegion) :
+		regionPos_(regionPos), window_(window), firstInRegion_(firstInRegion),
+		lastInRegion_(lastInRegion) {
+}
+
+BamRegionPartitionReader::BamRegionPartitionReader(const bfs::path & bamFnp,
+		const std::vector<GenomicRegion> & regions, const Pars & pars) :
+		bamFnp_(bamFnp), pars_(pars), pool_(bamFnp, std::max<uint32_t>(1, pars.numThreads_)) {
+	if (0 == pars_.windowSize_) {
+		std::stringstream ss;
+		ss << __PRETTY_FUNCTION__ << ", error " << "windowSize_ can't be 0" << "\n";
+		throw std::runtime_error { ss.str() };
+	}
+	for (const auto regionPos : iter::range<uint32_t>(regions.size())) {
+		const auto & region = regions[regionPos];
+		size_t windowStart = region.start_;
+		do {
+			GenomicRegion window = region;
+			window.start_ = windowStart;
+			window.end_ = std::min<size_t>(region.end_, windowStart + pars_.windowSize_);
+			partitions_.emplace_back(regionPos, window, windowStart == region.start_,
+					window.end_ >= region.end_);
+			windowStart = window.end_;
+		} while (windowStart < region.end_);
+	}
+	decoded_.resize(partitions_.size());
+	ready_.resize(partitions_.size(), false);
+	errors_.resize(partitions_.size());
+	pool_.openBamFile();
+	for (uint32_t t = 0; t < std::max<uint32_t>(1, pars_.numThreads_); ++t) {
+		threads_.emplace_back(&BamRegionPartitionReader::decodePartitions, this);
+	}
+}
+
+BamRegionPartitionReader::~BamRegionPartitionReader() {
+	{
+		std::lock_guard<std::mutex> lock(mut_);
+		stop_ = true;
+	}
+	cv_.notify_all();
+	njh::concurrent::joinAllJoinableThreads(threads_);
+}
+
+const std::vector<BamRegionPartitionReader::Partition> & BamRegionPartitionReader::partitions() const {
+	return partitions_;
+}
+
+void BamRegionPartitionReader::decodePartition(const Partition & partition,
+		std::vector<BamTools::BamAlignment> & alns) {
+	auto reader = pool_.popReader();
+	setBamFileRegionThrow(*reader, partition.window_);
+	BamTools::BamAlignment bAln;
+	while (reader->GetNextAlignment(bAln)) {
+		if (pars_.primaryOnly_ && !bAln.IsPrimaryAlignment()) {
+			continue;
+		}
+		//alignments overlapping a window boundary are reported for both windows, only keep them in the window they start in,
+		//the first and last window of a region keep everything the region would have reported
+		if (!partition.firstInRegion_
+				&& bAln.Position < static_cast<int64_t>(partition.window_.start_)) {
+			continue;
+		}
+		if (!partition.lastInRegion_
+				&& bAln.Position >= static_cast<int64_t>(partition.window_.end_)) {
+			continue;
+		}
+		alns.emplace_back(bAln);
+	}
+}
+
+void BamRegionPartitionReader::decodePartitions() {
+	const uint32_t partitionsAhead = 0 == pars_.partitionsAhead_ ?
+			2 * std::max<uint32_t>(1, pars_.numThreads_) : pars_.partitionsAhead_;
+	while (true) {
+		uint32_t partPos = 0;
+		{
+			std::unique_lock<std::mutex> lock(mut_);
+			//don't get too far ahead of the consumer so memory stays bounded
+			cv_.wait(lock, [this, &partitionsAhead]() {
+				return stop_ || nextToDecode_ >= partitions_.size()
+						|| nextToDecode_ < nextToHandBack_ + partitionsAhead;
+			});
+			if (stop_ || nextToDecode_ >= partitions_.size()) {
+				return;
+			}
+			partPos = nextToDecode_++;
+		}
+		std::vector<BamTools::BamAlignment> alns;
+		std::exception_ptr error;
+		try {
+			decodePartition(partitions_[partPos], alns);
+		} catch (...) {
+			error = std::current_exception();
+		}
+		{
+			std::lock_guard<std::mutex> lock(mut_);
+			decoded_[partPos] = std::move(alns);
+			errors_[partPos] = error;
+			ready_[partPos] = true;
+		}
+		cv_.notify_all();
+	}
+}
+
+bool BamRegionPartitionReader::getNextPartition(uint32_t & regionPos,
+		std::vector<BamTools::BamAlignment> & alns) {
+	alns.clear();
+	std::unique_lock<std::mutex> lock(mut_);
+	if (nextToHandBack_ >= partitions_.size()) {
+		return false;
+	}
+	const uint32_t partPos = nextToHandBack_;
+	cv_.wait(lock, [this, &partPos]() {
+		return ready_[partPos];
+	});
+	if (nullptr != errors_[partPos]) {
+		std::rethrow_exception(errors_[partPos]);
+	}
+	regionPos = partitions_[partPos].regionPos_;
+	std::swap(alns, decoded_[partPos]);
+	std::vector<BamTools::BamAlignment>().swap(decoded_[partPos]);
+	++nextToHandBack_;
+	lock.unlock();
+	cv_.notify_all();
+	return true;
+}
+
+}  // namespace njhseq
@@ -0,0 +1,110 @@
+#pragma once
+/*
+ * BamRegionPartitionReader.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: nick
+ */
+//
+// njhseq - A library for analyzing sequence data
+// Copyright (C) 2012-2018 Nicholas Hathaway <nicholas.hathaway@umassmed.edu>,
+//
+// This file is part of njhseq.
+//
+// njhseq is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// njhseq is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with njhseq.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#include <api/BamAlignment.h>
+#include "njhseq/common.h"
+#include "njhseq/objects/BioDataObject/GenomicRegion.hpp"
+#include "njhseq/concurrency/pools/BamReaderPool.hpp"
+
+namespace njhseq {
+
+/**@brief Read the alignments of regions of an indexed bam on a pool of readers, handing them back in region order
+ *
+ * Regions are cut into windows (partitions) which are decoded ahead of time by several threads each with their own
+ * BamTools::BamReader, the partitions are handed back in order and each alignment is only handed back once
+ * for the region it was found in so replaying the partitions gives the same alignments in the same order as iterating a
+ * single reader over each region
+ *
+ */
+class BamRegionPartitionReader {
+public:
+	struct Pars {
+		uint32_t numThreads_ = 1;
+		uint32_t windowSize_ = 100000; /**< regions larger than this are split into windows of this size */
+		uint32_t partitionsAhead_ = 0; /**< how many partitions can be decoded ahead of the one being consumed, 0 for twice numThreads_ */
+		bool primaryOnly_ = true; /**< skip secondary alignments while decoding */
+	};
+
+	struct Partition {
+		Partition(uint32_t regionPos, const GenomicRegion & window, bool firstInRegion,
+				bool lastInRegion);
+		uint32_t regionPos_;
+		GenomicRegion window_;
+		bool firstInRegion_;
+		bool lastInRegion_;
+	};
+
+	/**@brief Set up the partitions and start decoding them
+	 *
+	 * @param bamFnp the bam file, must be indexed
+	 * @param regions the regions to read
+	 * @param pars the threads and window size
+	 */
+	BamRegionPartitionReader(const bfs::path & bamFnp,
+			const std::vector<GenomicRegion> & regions, const Pars & pars);
+
+	~BamRegionPartitionReader();
+
+	BamRegionPartitionReader(const BamRegionPartitionReader & other) = delete;
+	BamRegionPartitionReader & operator=(const BamRegionPartitionReader & other) = delete;
+
+	const bfs::path bamFnp_;
+	const Pars pars_;
+
+	/**@brief Get the alignments of the next partition, waiting for it to be decoded if needed
+	 *
+	 * @param regionPos the position in the input regions the partition belongs to
+	 * @param alns the alignments, cleared first
+	 * @return false when all partitions have been handed back
+	 */
+	bool getNextPartition(uint32_t & regionPos,
+			std::vector<BamTools::BamAlignment> & alns);
+
+	const std::vector<Partition> & partitions() const;
+
+private:
+	std::vector<Partition> partitions_;
+	concurrent::BamReaderPool pool_;
+
+	std::mutex mut_;
+	std::condition_variable cv_;
+	uint32_t nextToDecode_{0};
+	uint32_t nextToHandBack_{0};
+	bool stop_{false};
+	std::vector<std::vector<BamTools::BamAlignment>> decoded_;
+	std::vector<bool> ready_;
+	std::vector<std::exception_ptr> errors_;
+
+	std::vector<std::thread> threads_;
+
+	void decodePartitions();
+	void decodePartition(const Partition & partition,
+			std::vector<BamTools::BamAlignment> & alns);
+};
+
+}  // namespace njhseq
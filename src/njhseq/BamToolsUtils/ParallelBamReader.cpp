@@ -0,0 +1,487 @@
+/*
+ * ParallelBamReader.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: nick
+ */
+//
+// njhseq - A library for analyzing sequence data
+// Copyright (C) 2012-2018 Nicholas Hathaway <nicholas.hathaway@umassmed.edu>,
+//
+// This file is part of njhseq.
+//
+// njhseq is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// njhseq is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with njhseq.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include "ParallelBamReader.hpp"
+#include <zlib.h>
+
+namespace njhseq {
+
+//fixed field offsets from the bam spec
+namespace {
+constexpr size_t refIdOffset = 0;
+constexpr size_t posOffset = 4;
+constexpr size_t nameLenOffset = 8;
+constexpr size_t mapqOffset = 9;
+constexpr size_t binOffset = 10;
+constexpr size_t nCigarOffset = 12;
+constexpr size_t flagOffset = 14;
+constexpr size_t seqLenOffset = 16;
+constexpr size_t mateRefIdOffset = 20;
+constexpr size_t matePosOffset = 24;
+constexpr size_t tlenOffset = 28;
+constexpr size_t nameOffset = 32;
+
+constexpr char seqLookUp[] = "=ACMGRSVTWYHKDBN";
+constexpr char cigarLookUp[] = "MIDNSHP=X";
+constexpr size_t bgzfHeaderLen = 18;
+constexpr size_t bgzfFooterLen = 8;
+}  // namespace
+
+int32_t LazyBamRecord::refId() const {
+	return readField<int32_t>(refIdOffset);
+}
+
+int32_t LazyBamRecord::position() const {
+	return readField<int32_t>(posOffset);
+}
+
+uint8_t LazyBamRecord::nameLength() const {
+	return readField<uint8_t>(nameLenOffset);
+}
+
+uint8_t LazyBamRecord::mapQuality() const {
+	return readField<uint8_t>(mapqOffset);
+}
+
+uint16_t LazyBamRecord::bin() const {
+	return readField<uint16_t>(binOffset);
+}
+
+uint16_t LazyBamRecord::numberOfCigarOps() const {
+	return readField<uint16_t>(nCigarOffset);
+}
+
+uint16_t LazyBamRecord::alignmentFlag() const {
+	return readField<uint16_t>(flagOffset);
+}
+
+int32_t LazyBamRecord::queryLength() const {
+	return readField<int32_t>(seqLenOffset);
+}
+
+int32_t LazyBamRecord::mateRefId() const {
+	return readField<int32_t>(mateRefIdOffset);
+}
+
+int32_t LazyBamRecord::matePosition() const {
+	return readField<int32_t>(matePosOffset);
+}
+
+int32_t LazyBamRecord::insertSize() const {
+	return readField<int32_t>(tlenOffset);
+}
+
+bool LazyBamRecord::isPaired() const {
+	return 0 != (alignmentFlag() & 0x0001);
+}
+
+bool LazyBamRecord::isMapped() const {
+	return 0 == (alignmentFlag() & 0x0004);
+}
+
+bool LazyBamRecord::isMateMapped() const {
+	return 0 == (alignmentFlag() & 0x0008);
+}
+
+bool LazyBamRecord::isReverseStrand() const {
+	return 0 != (alignmentFlag() & 0x0010);
+}
+
+bool LazyBamRecord::isFirstMate() const {
+	return 0 != (alignmentFlag() & 0x0040);
+}
+
+bool LazyBamRecord::isPrimaryAlignment() const {
+	return 0 == (alignmentFlag() & 0x0100);
+}
+
+size_t LazyBamRecord::cigarOffset() const {
+	return nameOffset + nameLength();
+}
+
+size_t LazyBamRecord::seqOffset() const {
+	return cigarOffset() + 4 * numberOfCigarOps();
+}
+
+size_t LazyBamRecord::qualOffset() const {
+	return seqOffset() + (queryLength() + 1) / 2;
+}
+
+size_t LazyBamRecord::tagOffset() const {
+	return qualOffset() + queryLength();
+}
+
+std::string LazyBamRecord::name() const {
+	//name is null terminated
+	return std::string(data_.data() + nameOffset, std::max<uint8_t>(1, nameLength()) - 1);
+}
+
+std::string LazyBamRecord::queryBases() const {
+	const int32_t len = queryLength();
+	std::string ret(len, 'N');
+	const size_t offset = seqOffset();
+	for (int32_t pos = 0; pos < len; ++pos) {
+		const uint8_t packed = static_cast<uint8_t>(data_[offset + pos / 2]);
+		ret[pos] = seqLookUp[0 == pos % 2 ? packed >> 4 : packed & 0x0F];
+	}
+	return ret;
+}
+
+std::string LazyBamRecord::qualities() const {
+	const int32_t len = queryLength();
+	const size_t offset = qualOffset();
+	if (len > 0 && static_cast<char>(0xFF) == data_[offset]) {
+		//qualities not stored, BamTools fills these with 0xFF
+		return std::string(len, static_cast<char>(0xFF));
+	}
+	std::string ret(data_, offset, len);
+	for (auto & c : ret) {
+		c += 33;
+	}
+	return ret;
+}
+
+std::vector<BamTools::CigarOp> LazyBamRecord::cigarData() const {
+	std::vector<BamTools::CigarOp> ret;
+	const uint16_t nOps = numberOfCigarOps();
+	ret.reserve(nOps);
+	const size_t offset = cigarOffset();
+	for (uint16_t op = 0; op < nOps; ++op) {
+		const uint32_t packed = readField<uint32_t>(offset + 4 * op);
+		const uint32_t opType = packed & 0x0F;
+		ret.emplace_back(opType < 9 ? cigarLookUp[opType] : '?', packed >> 4);
+	}
+	return ret;
+}
+
+std::string LazyBamRecord::tagData() const {
+	const size_t offset = tagOffset();
+	return offset < data_.size() ? data_.substr(offset) : std::string();
+}
+
+void LazyBamRecord::toBamAlignment(BamTools::BamAlignment & bAln) const {
+	bAln.Name = name();
+	bAln.Length = queryLength();
+	bAln.QueryBases = queryBases();
+	bAln.Qualities = qualities();
+	bAln.TagData = tagData();
+	bAln.RefID = refId();
+	bAln.Position = position();
+	bAln.Bin = bin();
+	bAln.MapQuality = mapQuality();
+	bAln.AlignmentFlag = alignmentFlag();
+	bAln.CigarData = cigarData();
+	bAln.MateRefID = mateRefId();
+	bAln.MatePosition = matePosition();
+	bAln.InsertSize = insertSize();
+	//aligned bases built the same as BamTools
+	bAln.AlignedBases.clear();
+	if (!bAln.QueryBases.empty() && !bAln.CigarData.empty()) {
+		bAln.AlignedBases.reserve(bAln.QueryBases.size());
+		size_t queryPos = 0;
+		for (const auto & op : bAln.CigarData) {
+			switch (op.Type) {
+			case 'M':
+			case 'I':
+			case '=':
+			case 'X':
+				bAln.AlignedBases.append(bAln.QueryBases, queryPos, op.Length);
+				queryPos += op.Length;
+				break;
+			case 'S':
+				queryPos += op.Length;
+				break;
+			case 'D':
+				bAln.AlignedBases.append(op.Length, '-');
+				break;
+			case 'P':
+				bAln.AlignedBases.append(op.Length, '*');
+				break;
+			case 'N':
+				bAln.AlignedBases.append(op.Length, 'N');
+				break;
+			default:
+				break;
+			}
+		}
+	}
+}
+
+ParallelBamReader::ParallelBamReader(const bfs::path & bamFnp,
+		const Pars & pars) :
+		bamFnp_(bamFnp), pars_(pars), in_(bamFnp.string(), std::ios::binary) {
+	if (!in_) {
+		std::stringstream ss;
+		ss << __PRETTY_FUNCTION__ << ", error " << "couldn't open " << bamFnp_ << "\n";
+		throw std::runtime_error { ss.str() };
+	}
+	for (uint32_t t = 0; t < std::max<uint32_t>(1, pars_.numThreads_); ++t) {
+		threads_.emplace_back(&ParallelBamReader::inflateBlocks, this);
+	}
+	try {
+		readHeader();
+	} catch (...) {
+		{
+			std::lock_guard<std::mutex> lock(mut_);
+			stop_ = true;
+		}
+		cv_.notify_all();
+		njh::concurrent::joinAllJoinableThreads(threads_);
+		throw;
+	}
+}
+
+ParallelBamReader::~ParallelBamReader() {
+	{
+		std::lock_guard<std::mutex> lock(mut_);
+		stop_ = true;
+	}
+	cv_.notify_all();
+	njh::concurrent::joinAllJoinableThreads(threads_);
+}
+
+const std::string & ParallelBamReader::getHeaderText() const {
+	return headerText_;
+}
+
+const BamTools::RefVector & ParallelBamReader::getReferenceData() const {
+	return refData_;
+}
+
+bool ParallelBamReader::readCompressedBlock(std::string & block) {
+	block.resize(bgzfHeaderLen);
+	in_.read(&block[0], bgzfHeaderLen);
+	if (0 == in_.gcount()) {
+		return false;
+	}
+	const auto header = reinterpret_cast<const unsigned char *>(block.data());
+	if (bgzfHeaderLen != static_cast<size_t>(in_.gcount()) || 31 != header[0]
+			|| 139 != header[1] || 8 != header[2] || 0 == (header[3] & 4)
+			|| 'B' != header[12] || 'C' != header[13]) {
+		std::stringstream ss;
+		ss << __PRETTY_FUNCTION__ << ", error " << bamFnp_ << " doesn't contain a valid BGZF block header" << "\n";
+		throw std::runtime_error { ss.str() };
+	}
+	const size_t blockSize = (header[16] | (header[17] << 8)) + 1;
+	if (blockSize < bgzfHeaderLen + bgzfFooterLen) {
+		std::stringstream ss;
+		ss << __PRETTY_FUNCTION__ << ", error " << bamFnp_ << " contains a BGZF block with an invalid size of " << blockSize << "\n";
+		throw std::runtime_error { ss.str() };
+	}
+	block.resize(blockSize);
+	in_.read(&block[bgzfHeaderLen], blockSize - bgzfHeaderLen);
+	if (blockSize - bgzfHeaderLen != static_cast<size_t>(in_.gcount())) {
+		std::stringstream ss;
+		ss << __PRETTY_FUNCTION__ << ", error " << bamFnp_ << " ended in the middle of a BGZF block" << "\n";
+		throw std::runtime_error { ss.str() };
+	}
+	return true;
+}
+
+void ParallelBamReader::inflateBlock(const std::string & block, std::string & out) {
+	const auto footer = reinterpret_cast<const unsigned char *>(block.data() + block.size() - 4);
+	const uint32_t inflatedSize = footer[0] | (footer[1] << 8) | (footer[2] << 16)
+			| (static_cast<uint32_t>(footer[3]) << 24);
+	out.resize(inflatedSize);
+	if (0 == inflatedSize) {
+		return;
+	}
+	z_stream zs;
+	zs.zalloc = Z_NULL;
+	zs.zfree = Z_NULL;
+	zs.opaque = Z_NULL;
+	zs.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(block.data() + bgzfHeaderLen));
+	zs.avail_in = block.size() - bgzfHeaderLen - bgzfFooterLen;
+	zs.next_out = reinterpret_cast<Bytef *>(&out[0]);
+	zs.avail_out = inflatedSize;
+	//raw deflate data, the gzip header and footer are handled here
+	if (Z_OK != inflateInit2(&zs, -15)) {
+		std::stringstream ss;
+		ss << __PRETTY_FUNCTION__ << ", error " << "couldn't initialize zlib" << "\n";
+		throw std::runtime_error { ss.str() };
+	}
+	const int status = inflate(&zs, Z_FINISH);
+	const uint64_t totalOut = zs.total_out;
+	inflateEnd(&zs);
+	if (Z_STREAM_END != status || totalOut != inflatedSize) {
+		std::stringstream ss;
+		ss << __PRETTY_FUNCTION__ << ", error " << "failed to inflate BGZF block, zlib status: " << status << "\n";
+		throw std::runtime_error { ss.str() };
+	}
+}
+
+void ParallelBamReader::inflateBlocks() {
+	const uint64_t blocksAhead = 0 == pars_.blocksAhead_ ?
+			16 * std::max<uint32_t>(1, pars_.numThreads_) : pars_.blocksAhead_;
+	std::string block;
+	while (true) {
+		uint64_t blockPos = 0;
+		{
+			std::unique_lock<std::mutex> lock(mut_);
+			cv_.wait(lock, [this, &blocksAhead]() {
+				return stop_ || inDone_ || nextToRead_ < nextToHandBack_ + blocksAhead;
+			});
+			if (stop_ || inDone_) {
+				return;
+			}
+			//the file is read under the lock so blocks are numbered in file order, only the inflating is done in parallel
+			try {
+				if (!readCompressedBlock(block)) {
+					inDone_ = true;
+				}
+			} catch (...) {
+				readError_ = std::current_exception();
+				inDone_ = true;
+			}
+			if (inDone_) {
+				lock.unlock();
+				cv_.notify_all();
+				return;
+			}
+			blockPos = nextToRead_++;
+		}
+		InflatedBlock inflated;
+		try {
+			inflateBlock(block, inflated.data_);
+		} catch (...) {
+			inflated.error_ = std::current_exception();
+		}
+		{
+			std::lock_guard<std::mutex> lock(mut_);
+			inflated_.emplace(blockPos, std::move(inflated));
+		}
+		cv_.notify_all();
+	}
+}
+
+bool ParallelBamReader::nextBlock() {
+	std::unique_lock<std::mutex> lock(mut_);
+	cv_.wait(lock, [this]() {
+		return inflated_.count(nextToHandBack_) > 0 || (inDone_ && nextToHandBack_ >= nextToRead_);
+	});
+	auto search = inflated_.find(nextToHandBack_);
+	if (inflated_.end() == search) {
+		if (nullptr != readError_) {
+			std::rethrow_exception(readError_);
+		}
+		return false;
+	}
+	if (nullptr != search->second.error_) {
+		std::rethrow_exception(search->second.error_);
+	}
+	buffer_ = std::move(search->second.data_);
+	bufferPos_ = 0;
+	inflated_.erase(search);
+	++nextToHandBack_;
+	lock.unlock();
+	cv_.notify_all();
+	return true;
+}
+
+bool ParallelBamReader::readBytes(char * dest, size_t n) {
+	size_t amountRead = 0;
+	while (amountRead < n) {
+		if (bufferPos_ >= buffer_.size()) {
+			//empty blocks (e.g. the EOF marker block) are skipped over
+			if (!nextBlock()) {
+				if (0 == amountRead) {
+					return false;
+				}
+				std::stringstream ss;
+				ss << __PRETTY_FUNCTION__ << ", error " << bamFnp_ << " ended in the middle of a record" << "\n";
+				throw std::runtime_error { ss.str() };
+			}
+			continue;
+		}
+		const size_t amount = std::min(n - amountRead, buffer_.size() - bufferPos_);
+		std::memcpy(dest + amountRead, buffer_.data() + bufferPos_, amount);
+		bufferPos_ += amount;
+		amountRead += amount;
+	}
+	return true;
+}
+
+void ParallelBamReader::readHeader() {
+	char magic[4];
+	if (!readBytes(magic, 4) || 0 != std::memcmp(magic, "BAM\1", 4)) {
+		std::stringstream ss;
+		ss << __PRETTY_FUNCTION__ << ", error " << bamFnp_ << " isn't a bam file" << "\n";
+		throw std::runtime_error { ss.str() };
+	}
+	auto readInt = [this]() {
+		int32_t ret = 0;
+		if (!readBytes(reinterpret_cast<char *>(&ret), sizeof(ret))) {
+			std::stringstream ss;
+			ss << __PRETTY_FUNCTION__ << ", error " << bamFnp_ << " ended in the middle of the header" << "\n";
+			throw std::runtime_error { ss.str() };
+		}
+		return ret;
+	};
+	const int32_t textLen = readInt();
+	headerText_.resize(textLen);
+	if (textLen > 0) {
+		readBytes(&headerText_[0], textLen);
+	}
+	//the text is allowed to be null padded
+	headerText_.erase(std::find(headerText_.begin(), headerText_.end(), '\0'), headerText_.end());
+	const int32_t numRefs = readInt();
+	for (int32_t refPos = 0; refPos < numRefs; ++refPos) {
+		const int32_t nameLen = readInt();
+		std::string name(nameLen, '\0');
+		if (nameLen > 0) {
+			readBytes(&name[0], nameLen);
+		}
+		name.erase(std::find(name.begin(), name.end(), '\0'), name.end());
+		const int32_t refLen = readInt();
+		refData_.emplace_back(name, refLen);
+	}
+}
+
+bool ParallelBamReader::getNextRecord(LazyBamRecord & record) {
+	int32_t blockSize = 0;
+	if (!readBytes(reinterpret_cast<char *>(&blockSize), sizeof(blockSize))) {
+		return false;
+	}
+	if (blockSize < static_cast<int32_t>(nameOffset)) {
+		std::stringstream ss;
+		ss << __PRETTY_FUNCTION__ << ", error " << bamFnp_ << " contains a record with an invalid size of " << blockSize << "\n";
+		throw std::runtime_error { ss.str() };
+	}
+	record.data_.resize(blockSize);
+	readBytes(&record.data_[0], blockSize);
+	return true;
+}
+
+bool ParallelBamReader::getNextAlignment(BamTools::BamAlignment & bAln) {
+	LazyBamRecord record;
+	if (!getNextRecord(record)) {
+		return false;
+	}
+	record.toBamAlignment(bAln);
+	return true;
+}
+
+}  // namespace njhseq
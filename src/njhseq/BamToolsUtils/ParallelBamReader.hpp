@@ -0,0 +1,172 @@
+#pragma once
+/*
+ * ParallelBamReader.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: nick
+ */
+//
+// njhseq - A library for analyzing sequence data
+// Copyright (C) 2012-2018 Nicholas Hathaway <nicholas.hathaway@umassmed.edu>,
+//
+// This file is part of njhseq.
+//
+// njhseq is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// njhseq is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with njhseq.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#include <api/BamAlignment.h>
+#include <api/BamAux.h>
+#include "njhseq/common.h"
+
+namespace njhseq {
+
+/**@brief A bam record kept as it's raw bytes, the fixed fields are read straight from the bytes and the name, bases, qualities,
+ * cigar and tags are only built when asked for
+ *
+ */
+class LazyBamRecord {
+public:
+	std::string data_; /**< the record after the block_size field, as laid out in the bam spec */
+
+	int32_t refId() const;
+	int32_t position() const;
+	uint8_t mapQuality() const;
+	uint16_t bin() const;
+	uint16_t alignmentFlag() const;
+	int32_t queryLength() const;
+	int32_t mateRefId() const;
+	int32_t matePosition() const;
+	int32_t insertSize() const;
+
+	bool isPaired() const;
+	bool isMapped() const;
+	bool isMateMapped() const;
+	bool isReverseStrand() const;
+	bool isFirstMate() const;
+	bool isPrimaryAlignment() const;
+
+	std::string name() const;
+	std::string queryBases() const;
+	/**@brief the qualities as sanger encoded chars, same as BamTools::BamAlignment::Qualities
+	 *
+	 */
+	std::string qualities() const;
+	std::vector<BamTools::CigarOp> cigarData() const;
+	std::string tagData() const;
+
+	/**@brief Fill in a BamTools::BamAlignment the same way BamTools::BamReader::GetNextAlignment would
+	 *
+	 * @param bAln the alignment to fill
+	 */
+	void toBamAlignment(BamTools::BamAlignment & bAln) const;
+
+private:
+	uint8_t nameLength() const;
+	uint16_t numberOfCigarOps() const;
+	size_t cigarOffset() const;
+	size_t seqOffset() const;
+	size_t qualOffset() const;
+	size_t tagOffset() const;
+
+	template<typename T>
+	T readField(size_t offset) const {
+		T ret;
+		std::memcpy(&ret, data_.data() + offset, sizeof(T));
+		return ret;
+	}
+};
+
+/**@brief Read a bam file front to back with the BGZF blocks inflated on other threads
+ *
+ * Compressed blocks are read and inflated ahead of the consumer by a pool of threads and handed back in file order through a
+ * bounded buffer, records are handed back as LazyBamRecord so scans that only need the flag or position don't pay to build
+ * strings, assumes a little endian host like most of the bam readers out there
+ *
+ */
+class ParallelBamReader {
+public:
+	struct Pars {
+		uint32_t numThreads_ = 1; /**< threads inflating blocks, the thread reading records is in addition to these */
+		uint32_t blocksAhead_ = 0; /**< how many blocks can be inflated ahead of the consumer, 0 for 16 per thread */
+	};
+
+	ParallelBamReader(const bfs::path & bamFnp, const Pars & pars);
+	~ParallelBamReader();
+
+	ParallelBamReader(const ParallelBamReader & other) = delete;
+	ParallelBamReader & operator=(const ParallelBamReader & other) = delete;
+
+	const bfs::path bamFnp_;
+	const Pars pars_;
+
+	const std::string & getHeaderText() const;
+	const BamTools::RefVector & getReferenceData() const;
+
+	/**@brief Get the next record
+	 *
+	 * @param record the record to fill
+	 * @return false at the end of the file
+	 */
+	bool getNextRecord(LazyBamRecord & record);
+
+	/**@brief Get the next record fully decoded into a BamTools::BamAlignment
+	 *
+	 * @param bAln the alignment to fill
+	 * @return false at the end of the file
+	 */
+	bool getNextAlignment(BamTools::BamAlignment & bAln);
+
+private:
+	std::string headerText_;
+	BamTools::RefVector refData_;
+
+	std::ifstream in_;
+
+	struct InflatedBlock {
+		std::string data_;
+		std::exception_ptr error_;
+	};
+
+	std::mutex mut_;
+	std::condition_variable cv_;
+	uint64_t nextToRead_{0};
+	uint64_t nextToHandBack_{0};
+	bool inDone_{false};
+	bool stop_{false};
+	std::exception_ptr readError_;
+	std::map<uint64_t, InflatedBlock> inflated_;
+	std::vector<std::thread> threads_;
+
+	std::string buffer_; /**< the block currently being consumed */
+	size_t bufferPos_{0};
+
+	void inflateBlocks();
+	/**@brief read the next compressed block, must hold mut_
+	 *
+	 * @return false at the end of the file
+	 */
+	bool readCompressedBlock(std::string & block);
+	static void inflateBlock(const std::string & block, std::string & out);
+
+	bool nextBlock();
+	/**@brief read n bytes of the decompressed stream
+	 *
+	 * @return false if at the end of the stream before any bytes were read, throws if the stream ends part way through
+	 */
+	bool readBytes(char * dest, size_t n);
+	void readHeader();
+};
+
+}  // namespace njhseq
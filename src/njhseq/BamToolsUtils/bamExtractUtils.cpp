@@ -85,6 +85,49 @@ BamExtractor::BamExtractor(bool verbose ):verbose_(verbose) {
 
 }
 
+void BamExtractor::forEachAlnInRegions(const bfs::path & bamFnp,
+		const std::vector<GenomicRegion> & regions,
+		const std::function<void(const BamTools::BamAlignment &, const GenomicRegion &)> & func) {
+	if (regionReaderPars_.numThreads_ <= 1) {
+		BamTools::BamReader bReader;
+		BamTools::BamAlignment bAln;
+		bReader.Open(bamFnp.string());
+		checkBamOpenThrow(bReader, bamFnp);
+		loadBamIndexThrow(bReader);
+		for (const auto & region : regions) {
+			if (verbose_) {
+				std::cout << region.uid_ << std::endl;
+			}
+			setBamFileRegionThrow(bReader, region);
+			while (bReader.GetNextAlignment(bAln)) {
+				//skip secondary alignments
+				if (!bAln.IsPrimaryAlignment()) {
+					continue;
+				}
+				func(bAln, region);
+			}
+		}
+	} else {
+		//partitions are decoded ahead on a pool of readers and replayed here in order so any mate caching done by func
+		//sees the alignments exactly as a single reader would have given them
+		auto pars = regionReaderPars_;
+		pars.primaryOnly_ = true;
+		BamRegionPartitionReader partitionReader(bamFnp, regions, pars);
+		std::vector<BamTools::BamAlignment> alns;
+		uint32_t regionPos = 0;
+		uint32_t lastRegionPos = std::numeric_limits<uint32_t>::max();
+		while (partitionReader.getNextPartition(regionPos, alns)) {
+			if (verbose_ && regionPos != lastRegionPos) {
+				std::cout << regions[regionPos].uid_ << std::endl;
+			}
+			lastRegionPos = regionPos;
+			for (const auto & bAln : alns) {
+				func(bAln, regions[regionPos]);
+			}
+		}
+	}
+}
+
 BamExtractor::BamExtractSeqsResults BamExtractor::extractReadsFromBamRegion(
 		const bfs::path & bamFnp, const GenomicRegion & region,
 		double percInRegion) {
@@ -209,17 +252,12 @@ void BamExtractor::writeExtractReadsFromBamRegion(
 		const OutOptions & outOpts) {
 
 	BamTools::BamReader bReader;
-	BamTools::BamAlignment bAln;
 	bReader.Open(bamFnp.string());
 	checkBamOpenThrow(bReader, bamFnp);
 	loadBamIndexThrow(bReader);
 	auto refs = bReader.GetReferenceData();
 	BamAlnsCache alnCache;
 	auto refData = bReader.GetReferenceData();
-	std::unordered_map<std::string, uint32_t> refNameToId;
-	for (auto pos : iter::range(refData.size())) {
-		refNameToId[refData[pos].RefName] = pos;
-	}
 	//pair writer
 	SeqIOOptions outOptsPaired(outOpts.outFilename_,
 			SeqIOOptions::outFormats::FASTQPAIRED, outOpts);
@@ -229,31 +267,16 @@ void BamExtractor::writeExtractReadsFromBamRegion(
 			SeqIOOptions::outFormats::FASTQ, outOpts);
 	SeqOutput writer(outOptsSingle);
 
-	if (!bReader.SetRegion(refNameToId.at(region.chrom_), region.start_,
-			refNameToId.at(region.chrom_), region.end_)) {
-		std::stringstream ss;
-		ss << bReader.GetErrorString() << std::endl;
-		ss << "Failed to set region" << std::endl;
-		ss << "Region: " << refNameToId.at(region.chrom_) << std::endl;
-		ss << "Start: " << region.start_ << std::endl;
-		ss << "Stop: " << region.end_ << std::endl;
-		throw std::runtime_error { ss.str() };
-	}
-
-	while (bReader.GetNextAlignment(bAln)) {
-		//skip secondary alignments
-		if (!bAln.IsPrimaryAlignment()) {
-			continue;
-		}
+	auto processAln = [&](const BamTools::BamAlignment & bAln, const GenomicRegion &) {
 		//get only alignments that fall mostly in this region, setting percInRegion
 		//would save any read that had any fall bases in this region
 		if (region.getPercInRegion(bAln, refData) < percInRegion) {
-			continue;
+			return;
 		}
 		if (bAln.IsPaired()) {
 			if (bAln.MateRefID != bAln.RefID) {
 				// do non-concordant chromosome mapping operation
-				continue;
+				return;
 			}
 			//uncommenting this will make it so unmapping mate will now be recovered
 //			if (!bAln.IsMapped() || !bAln.IsMateMapped()) {
@@ -266,7 +289,7 @@ void BamExtractor::writeExtractReadsFromBamRegion(
 					//if mapped to the same place and the mate is yet to be encountered
 					//enter into cache for until mate is encountered
 					alnCache.add(bAln);
-					continue;
+					return;
 				}
 			}
 			if (bAln.MatePosition <= bAln.Position) {
@@ -276,7 +299,7 @@ void BamExtractor::writeExtractReadsFromBamRegion(
 					//do orphaned operation
 					//this could be due mate not falling in this region;
 					writer.openWrite(bamAlnToSeqInfo(bAln));
-					continue;
+					return;
 				} else {
 					auto search = alnCache.get(bAln.Name);
 					PairedRead outRead;
@@ -305,7 +328,8 @@ void BamExtractor::writeExtractReadsFromBamRegion(
 				writer.openWrite(bamAlnToSeqInfo(bAln));
 			}
 		}
-	}
+	};
+	forEachAlnInRegions(bamFnp, {region}, processAln);
 	//save the orphans;
 	if (len(alnCache) > 0) {
 		auto names = alnCache.getNames();
@@ -2186,193 +2210,167 @@ BamExtractor::ExtractedFilesOpts BamExtractor::extractReadsFromBamWrite(
 
 
 
-	BamTools::BamReader bReader;
-	bReader.Open(opts.firstName_.string());
-	checkBamOpenThrow(bReader, opts.firstName_.string());
+	//blocks are inflated on other threads and records are only fully decoded once they're known to be primary alignments
+	ParallelBamReader bReader(opts.firstName_, bamReadPars_);
+	LazyBamRecord record;
 
 	BamTools::BamAlignment bAln;
-	BamAlnsCache alnCache;
-
-	while (bReader.GetNextAlignment(bAln)) {
-		if (!bAln.IsPrimaryAlignment()) {
-			continue;
-		}
-		if (!bAln.IsPaired()) {
-			if (!bAln.IsMapped()) {
-				++ret.unpairedUnMapped_;
-				unmappedSinglesWriter.openWrite(bamAlnToSeqInfo(bAln));
+	//mates are held in a memory capped cache that spills the oldest unmatched alignments to disk, see BamMatePairer
+	BamMatePairer matePairer(matePairerPars_);
+
+	//bAln is the mate seen second, search is the mate seen first
+	auto processPair = [&](const CompactBamAln & bAln, const CompactBamAln & search) {
+		if (!bAln.isMapped() && !bAln.isMateMapped()) {
+			++ret.pairsUnMapped_;
+			if (bAln.isFirstMate()) {
+				unmappedPairWriter.openWrite(
+						PairedRead(bAln.toSeqInfo(), search.toSeqInfo(), false));
 			} else {
-				++ret.unpaiedReads_;
-				if (referenceOrientation) {
-					mappedSinglesWriter.openWrite(
-							seqInfo(bAln.Name, bAln.QueryBases, bAln.Qualities,
-									SangerQualOffset));
-				} else {
-					mappedSinglesWriter.openWrite(bamAlnToSeqInfo(bAln));
-				}
+				unmappedPairWriter.openWrite(
+						PairedRead(search.toSeqInfo(), bAln.toSeqInfo(), false));
 			}
 		} else {
-			if (!alnCache.has(bAln.Name)) {
-				//pair hasn't been added to cache yet so add to cache
-				//this only works if mate and first mate have the same name
-				alnCache.add(bAln);
-				continue;
-			} else {
-
-				auto search = alnCache.get(bAln.Name);
-				if (!bAln.IsMapped() && !bAln.IsMateMapped()) {
-					++ret.pairsUnMapped_;
-					if (bAln.IsFirstMate()) {
-						unmappedPairWriter.openWrite(
-								PairedRead(bamAlnToSeqInfo(bAln), bamAlnToSeqInfo(*search),
-										false));
-					} else {
-						unmappedPairWriter.openWrite(
-								PairedRead(bamAlnToSeqInfo(*search), bamAlnToSeqInfo(bAln),
-										false));
-					}
-				} else {
-
-					if(referenceOrientation){
-						seqInfo bAlnSeq(bAln.Name, bAln.QueryBases, bAln.Qualities,
-								SangerQualOffset);
-						seqInfo searchSeq(search->Name, search->QueryBases,
-								search->Qualities, SangerQualOffset);
-
-						if (bAln.IsMapped() && search->IsMapped()) {
-							//test for concordant
-							if (bAln.RefID == search->RefID
-									&& std::abs(bAln.InsertSize) < insertLengthCutOff_) {
-								if(bAln.IsReverseStrand() != search->IsReverseStrand()){
-									++ret.pairedReads_;
-									if (bAln.IsFirstMate()) {
-										mappedPairWriter.openWrite(
-												PairedRead(bAlnSeq, searchSeq, false));
-									} else {
-										mappedPairWriter.openWrite(
-												PairedRead(searchSeq, bAlnSeq, false));
-									}
-								}else{
-									//inverse mates will there be written in technically the wrong orientation to each other but in the reference orientation
-									++ret.inverse_;
-									if (bAln.IsFirstMate()) {
-										inversePairWriter.openWrite(
-												PairedRead(bAlnSeq, searchSeq, false));
-									} else {
-										inversePairWriter.openWrite(
-												PairedRead(searchSeq, bAlnSeq, false));
-									}
-								}
+			if (referenceOrientation) {
+				seqInfo bAlnSeq = bAln.toSeqInfo(true);
+				seqInfo searchSeq = search.toSeqInfo(true);
+
+				if (bAln.isMapped() && search.isMapped()) {
+					//test for concordant
+					if (bAln.refId_ == search.refId_
+							&& static_cast<uint32_t>(std::abs(bAln.insertSize_)) < insertLengthCutOff_) {
+						if (bAln.isReverseStrand() != search.isReverseStrand()) {
+							++ret.pairedReads_;
+							if (bAln.isFirstMate()) {
+								mappedPairWriter.openWrite(
+										PairedRead(bAlnSeq, searchSeq, false));
 							} else {
-								//discordant if mapping to different chromosome or very far away from each other
-								++ret.discordant_;
-								if (bAln.IsFirstMate()) {
-									discordantPairWriter.openWrite(
-											PairedRead(bAlnSeq, searchSeq, false));
-								} else {
-									discordantPairWriter.openWrite(
-											PairedRead(searchSeq, bAlnSeq, false));
-								}
+								mappedPairWriter.openWrite(
+										PairedRead(searchSeq, bAlnSeq, false));
 							}
 						} else {
-							++ret.pairedReadsMateUnmapped_;
-							//when mate is unmapped the same operation is done to the mate as the other mate, not sure why, so to fix orientation (or at least keep the read in the orientation of it's mate)
-							if (bAln.IsMapped() && !search->IsMapped()) {
-								searchSeq.reverseComplementRead(false, true);
-							} else if (!bAln.IsMapped() && search->IsMapped()) {
-								bAlnSeq.reverseComplementRead(false, true);
+							//inverse mates will there be written in technically the wrong orientation to each other but in the reference orientation
+							++ret.inverse_;
+							if (bAln.isFirstMate()) {
+								inversePairWriter.openWrite(
+										PairedRead(bAlnSeq, searchSeq, false));
 							} else {
-								//this shouldn't be happening....
-							}
-							if (throwAwayUnmmpaedMates) {
-								if (bAln.IsMapped() && !search->IsMapped()) {
-									mappedSinglesWriter.openWrite(bAlnSeq);
-									thrownAwayMateWriter.openWrite(searchSeq);
-								} else if (!bAln.IsMapped() && search->IsMapped()) {
-									mappedSinglesWriter.openWrite(searchSeq);
-									thrownAwayMateWriter.openWrite(bAlnSeq);
-								}
-							}else{
-								if (bAln.IsFirstMate()) {
-									mateUnmappedPairWriter.openWrite(
-											PairedRead(bAlnSeq, searchSeq, false));
-								} else {
-									mateUnmappedPairWriter.openWrite(
-											PairedRead(searchSeq, bAlnSeq, false));
-								}
+								inversePairWriter.openWrite(
+										PairedRead(searchSeq, bAlnSeq, false));
 							}
-
 						}
-						//to make it here at least one of alignments had to have mapped
 					} else {
-						if (bAln.RefID == search->RefID
-								&& std::abs(bAln.InsertSize) < insertLengthCutOff_) {
-							if(bAln.IsReverseStrand() != search->IsReverseStrand()){
-								++ret.pairedReads_;
-								if (bAln.IsFirstMate()) {
-									mappedPairWriter.openWrite(
-											PairedRead(bamAlnToSeqInfo(bAln), bamAlnToSeqInfo(*search),
-													false));
-								} else {
-									mappedPairWriter.openWrite(
-											PairedRead(bamAlnToSeqInfo(*search), bamAlnToSeqInfo(bAln),
-													false));
-								}
-							}else{
-								++ret.inverse_;
-								if (bAln.IsFirstMate()) {
-									inversePairWriter.openWrite(
-											PairedRead(bamAlnToSeqInfo(bAln),
-													bamAlnToSeqInfo(*search), false));
-								} else {
-									inversePairWriter.openWrite(
-											PairedRead(bamAlnToSeqInfo(*search),
-													bamAlnToSeqInfo(bAln), false));
-								}
-							}
-
+						//discordant if mapping to different chromosome or very far away from each other
+						++ret.discordant_;
+						if (bAln.isFirstMate()) {
+							discordantPairWriter.openWrite(
+									PairedRead(bAlnSeq, searchSeq, false));
 						} else {
-							++ret.discordant_;
-							if (bAln.IsFirstMate()) {
-								discordantPairWriter.openWrite(
-										PairedRead(bamAlnToSeqInfo(bAln),
-												bamAlnToSeqInfo(*search), false));
-							} else {
-								discordantPairWriter.openWrite(
-										PairedRead(bamAlnToSeqInfo(*search),
-												bamAlnToSeqInfo(bAln), false));
-							}
+							discordantPairWriter.openWrite(
+									PairedRead(searchSeq, bAlnSeq, false));
+						}
+					}
+				} else {
+					++ret.pairedReadsMateUnmapped_;
+					//when mate is unmapped the same operation is done to the mate as the other mate, not sure why, so to fix orientation (or at least keep the read in the orientation of it's mate)
+					if (bAln.isMapped() && !search.isMapped()) {
+						searchSeq.reverseComplementRead(false, true);
+					} else if (!bAln.isMapped() && search.isMapped()) {
+						bAlnSeq.reverseComplementRead(false, true);
+					} else {
+						//this shouldn't be happening....
+					}
+					if (throwAwayUnmmpaedMates) {
+						if (bAln.isMapped() && !search.isMapped()) {
+							mappedSinglesWriter.openWrite(bAlnSeq);
+							thrownAwayMateWriter.openWrite(searchSeq);
+						} else if (!bAln.isMapped() && search.isMapped()) {
+							mappedSinglesWriter.openWrite(searchSeq);
+							thrownAwayMateWriter.openWrite(bAlnSeq);
+						}
+					} else {
+						if (bAln.isFirstMate()) {
+							mateUnmappedPairWriter.openWrite(
+									PairedRead(bAlnSeq, searchSeq, false));
+						} else {
+							mateUnmappedPairWriter.openWrite(
+									PairedRead(searchSeq, bAlnSeq, false));
 						}
 					}
 				}
-				// now that operations have been computed, remove ther other mate found from cache
-				alnCache.remove(search->Name);
-				continue;
+				//to make it here at least one of alignments had to have mapped
+			} else {
+				if (bAln.refId_ == search.refId_
+						&& static_cast<uint32_t>(std::abs(bAln.insertSize_)) < insertLengthCutOff_) {
+					if (bAln.isReverseStrand() != search.isReverseStrand()) {
+						++ret.pairedReads_;
+						if (bAln.isFirstMate()) {
+							mappedPairWriter.openWrite(
+									PairedRead(bAln.toSeqInfo(), search.toSeqInfo(), false));
+						} else {
+							mappedPairWriter.openWrite(
+									PairedRead(search.toSeqInfo(), bAln.toSeqInfo(), false));
+						}
+					} else {
+						++ret.inverse_;
+						if (bAln.isFirstMate()) {
+							inversePairWriter.openWrite(
+									PairedRead(bAln.toSeqInfo(), search.toSeqInfo(), false));
+						} else {
+							inversePairWriter.openWrite(
+									PairedRead(search.toSeqInfo(), bAln.toSeqInfo(), false));
+						}
+					}
+				} else {
+					++ret.discordant_;
+					if (bAln.isFirstMate()) {
+						discordantPairWriter.openWrite(
+								PairedRead(bAln.toSeqInfo(), search.toSeqInfo(), false));
+					} else {
+						discordantPairWriter.openWrite(
+								PairedRead(search.toSeqInfo(), bAln.toSeqInfo(), false));
+					}
+				}
 			}
 		}
-	}
+	};
 
-	//save the orphans;
-	if (len(alnCache) > 0) {
-		auto names = alnCache.getNames();
-		for (const auto & name : names) {
-			auto search = alnCache.get(name);
-			if (!search->IsMapped()) {
+	auto processOrphan = [&](const CompactBamAln & search) {
+		if (!search.isMapped()) {
+			++ret.unpairedUnMapped_;
+			unmappedSinglesWriter.openWrite(search.toSeqInfo());
+		} else {
+			++ret.unpaiedReads_;
+			mappedSinglesWriter.openWrite(search.toSeqInfo(referenceOrientation));
+		}
+	};
+
+	CompactBamAln search;
+	while (bReader.getNextRecord(record)) {
+		if (!record.isPrimaryAlignment()) {
+			continue;
+		}
+		record.toBamAlignment(bAln);
+		if (!bAln.IsPaired()) {
+			if (!bAln.IsMapped()) {
 				++ret.unpairedUnMapped_;
-				unmappedSinglesWriter.openWrite(bamAlnToSeqInfo(*search));
+				unmappedSinglesWriter.openWrite(bamAlnToSeqInfo(bAln));
 			} else {
 				++ret.unpaiedReads_;
-				if (!referenceOrientation) {
-					mappedSinglesWriter.openWrite(bamAlnToSeqInfo(*search));
-				} else {
-					mappedSinglesWriter.openWrite(
-							seqInfo(search->Name, search->QueryBases, search->Qualities,
-									SangerQualOffset));
-				}
+				mappedSinglesWriter.openWrite(bamAlnToSeqInfo(bAln, referenceOrientation));
+			}
+		} else {
+			if (matePairer.takeMate(bAln.Name, search)) {
+				processPair(CompactBamAln(bAln), search);
+			} else {
+				//pair hasn't been added to cache yet so add to cache
+				//this only works if mate and first mate have the same name
+				matePairer.add(bAln);
 			}
-			alnCache.remove(name);
 		}
 	}
+
+	//pair up any spilled mates and save the orphans;
+	matePairer.finish(processPair, processOrphan);
 	if(verbose_){
 		ret.log(std::cout, opts.firstName_);
 	}
@@ -2518,7 +2516,6 @@ BamExtractor::ExtractedFilesOpts BamExtractor::extractReadsWtihCrossRegionMappin
 		throw std::runtime_error{overalMessage.str()};
 	}
 	BamTools::BamReader bReader;
-	BamTools::BamAlignment bAln;
 	bReader.Open(inOutOpts.firstName_.string());
 	checkBamOpenThrow(bReader, inOutOpts.firstName_.string());
 	loadBamIndexThrow(bReader);
@@ -2540,34 +2537,23 @@ BamExtractor::ExtractedFilesOpts BamExtractor::extractReadsWtihCrossRegionMappin
 
 	ret.inUnpaired_ = SeqIOOptions::genFastqIn(outUnpaired.getPriamryOutName());
 
-	for (const auto regionPos : iter::range(regions.size())) {
-		const auto & region = regions[regionPos];
-		if (verbose_) {
-			std::cout << region.uid_ << std::endl;
-		}
-		setBamFileRegionThrow(bReader, region);
-
-		while (bReader.GetNextAlignment(bAln)) {
-			//skip secondary alignments
-			if (!bAln.IsPrimaryAlignment()) {
-				continue;
-			}
-			if (bAln.IsMapped()
-					&& region.getPercInRegion(bAln, refData) >= percInRegion) {
-				++ret.unpaiedReads_;
-				if (originalOrientation) {
-					writer.openWrite(bamAlnToSeqInfo(bAln));
-				} else {
-					seqInfo bAlnSeq(bAln.Name, bAln.QueryBases, bAln.Qualities,
-							SangerQualOffset);
-					if (region.reverseSrand_) {
-						bAlnSeq.reverseComplementRead(false, true);
-					}
-					writer.openWrite(bAlnSeq);
+	auto processAln = [&](const BamTools::BamAlignment & bAln, const GenomicRegion & region) {
+		if (bAln.IsMapped()
+				&& region.getPercInRegion(bAln, refData) >= percInRegion) {
+			++ret.unpaiedReads_;
+			if (originalOrientation) {
+				writer.openWrite(bamAlnToSeqInfo(bAln));
+			} else {
+				seqInfo bAlnSeq(bAln.Name, bAln.QueryBases, bAln.Qualities,
+						SangerQualOffset);
+				if (region.reverseSrand_) {
+					bAlnSeq.reverseComplementRead(false, true);
 				}
+				writer.openWrite(bAlnSeq);
 			}
 		}
-	}
+	};
+	forEachAlnInRegions(inOutOpts.firstName_, regions, processAln);
 	return ret;
 }
 
@@ -2796,30 +2782,19 @@ BamExtractor::ExtractedFilesOpts BamExtractor::extractReadsWtihCrossRegionMappin
 		bWriter.SaveAlignment(bAln);
 	};
 
-	for (const auto regionPos : iter::range(regions.size())) {
-		const auto & region = regions[regionPos];
-		if (verbose_) {
-			std::cout << region.uid_ << std::endl;
+	auto processAln = [&](const BamTools::BamAlignment & bAln, const GenomicRegion & region) {
+		//handle non-mapping sequences
+		if (bAln.IsPaired() && !bAln.IsMapped() && !bAln.IsMateMapped()) {
+			++ret.pairsUnMapped_;
+			//only interested in pairs with at least 1 pair mapping
+			return;
+		} else if (!bAln.IsPaired() && !bAln.IsMapped()){
+			++ret.unpairedUnMapped_;
+			//only interested in seqs that are mapping
+			return;
 		}
-		setBamFileRegionThrow(bReader, region);
-
-		while (bReader.GetNextAlignment(bAln)) {
-			//skip secondary alignments
-			if (!bAln.IsPrimaryAlignment()) {
-				continue;
-			}
-			//handle non-mapping sequences
-			if (bAln.IsPaired() && !bAln.IsMapped() && !bAln.IsMateMapped()) {
-				++ret.pairsUnMapped_;
-				//only interested in pairs with at least 1 pair mapping
-				continue;
-			} else if (!bAln.IsPaired() && !bAln.IsMapped()){
-				++ret.unpairedUnMapped_;
-				//only interested in seqs that are mapping
-				continue;
-			}
-			//get only alignments that fall mostly in this region, setting percInRegion to 0
-			//would save any read that had any fall bases in this region
+		//get only alignments that fall mostly in this region, setting percInRegion to 0
+		//would save any read that had any fall bases in this region
 //			if (bAln.IsMapped() && region.getPercInRegion(bAln, refData) < percInRegion) {
 //				//if mate is unmapped and it came before this
 //				if(!bAln.IsMateMapped() && alnCache.has(bAln.Name)){
@@ -2834,219 +2809,219 @@ BamExtractor::ExtractedFilesOpts BamExtractor::extractReadsWtihCrossRegionMappin
 //			if(print){
 //				std::cout << njh::json::toJson(bAln) << std::endl;
 //			}
-			if (bAln.IsPaired()) {
-				if (!alnCache.has(bAln.Name)) {
-					//enter into cache for until mate is encountered
-					alnCache.addWithRegion(bAln, region);
-					continue;
-				} else {
-					auto search = alnCache.get(bAln.Name);
-					auto searchRegion = alnCache.getRegion(bAln.Name);
-					if (nullptr == search) {
-						std::stringstream ss;
-						ss << __FILE__ << "  " << __LINE__ << " "<< __PRETTY_FUNCTION__
-								<< ", error search shouldn't be able to be nulltpr here"
-								<< "\n";
-						throw std::runtime_error { ss.str() };
-					}
-					if(nullptr == searchRegion){
-						std::stringstream ss;
-						ss << __FILE__ << "  " << __LINE__ << " "<< __PRETTY_FUNCTION__
-								<< ", error region shouldn't be able to be nulltpr here, something has gone wrong"
-								<< "\n";
-						throw std::runtime_error { ss.str() };
-					}
-					bool bAlnIn = false;
-					bool searchIn = false;
+		if (bAln.IsPaired()) {
+			if (!alnCache.has(bAln.Name)) {
+				//enter into cache for until mate is encountered
+				alnCache.addWithRegion(bAln, region);
+				return;
+			} else {
+				auto search = alnCache.get(bAln.Name);
+				auto searchRegion = alnCache.getRegion(bAln.Name);
+				if (nullptr == search) {
+					std::stringstream ss;
+					ss << __FILE__ << "  " << __LINE__ << " "<< __PRETTY_FUNCTION__
+							<< ", error search shouldn't be able to be nulltpr here"
+							<< "\n";
+					throw std::runtime_error { ss.str() };
+				}
+				if(nullptr == searchRegion){
+					std::stringstream ss;
+					ss << __FILE__ << "  " << __LINE__ << " "<< __PRETTY_FUNCTION__
+							<< ", error region shouldn't be able to be nulltpr here, something has gone wrong"
+							<< "\n";
+					throw std::runtime_error { ss.str() };
+				}
+				bool bAlnIn = false;
+				bool searchIn = false;
 
 
 
-					seqInfo bAlnSeq(bAln.Name, bAln.QueryBases, bAln.Qualities,
-							SangerQualOffset);
-					seqInfo searchSeq(search->Name, search->QueryBases,
-							search->Qualities, SangerQualOffset);
+				seqInfo bAlnSeq(bAln.Name, bAln.QueryBases, bAln.Qualities,
+						SangerQualOffset);
+				seqInfo searchSeq(search->Name, search->QueryBases,
+						search->Qualities, SangerQualOffset);
 
-					if (bAln.IsMapped()) {
-						bAlnIn = region.getPercInRegion(bAln, refData) >= percInRegion;
-						if (region.reverseSrand_) {
-							bAlnSeq.reverseComplementRead(false, true);
-						}
+				if (bAln.IsMapped()) {
+					bAlnIn = region.getPercInRegion(bAln, refData) >= percInRegion;
+					if (region.reverseSrand_) {
+						bAlnSeq.reverseComplementRead(false, true);
 					}
+				}
 
-					if(search->IsMapped()){
-						searchIn = searchRegion->getPercInRegion(*search, refData) >= percInRegion;
-						if(searchRegion->reverseSrand_){
-							searchSeq.reverseComplementRead(false, true);
-						}
+				if(search->IsMapped()){
+					searchIn = searchRegion->getPercInRegion(*search, refData) >= percInRegion;
+					if(searchRegion->reverseSrand_){
+						searchSeq.reverseComplementRead(false, true);
 					}
+				}
 
-					if(bAln.IsMapped() && search->IsMapped()){
-						if(bAln.RefID == search->RefID && std::abs(bAln.InsertSize) < insertLengthCutOff_){
-							//concordant mapping to the current region, reorient
-							if (searchIn && bAlnIn) {
-								//check for inverse mapping
-								if (bAln.IsReverseStrand() == search->IsReverseStrand()) {
-									writeInversePair(bAln, bAlnSeq, *search, searchSeq);
-								} else {
-									writeRegPair(bAln, bAlnSeq, *search, searchSeq);
-								}
-							}else if(searchIn){
-								writeMateFilteredOff(*search, *searchRegion);
-								writeTheThrownAwayMate(bAln, bAlnSeq);
-							}else if(bAlnIn){
-								writeMateFilteredOff(bAln, region);
-								writeTheThrownAwayMate(*search, searchSeq);
+				if(bAln.IsMapped() && search->IsMapped()){
+					if(bAln.RefID == search->RefID && std::abs(bAln.InsertSize) < insertLengthCutOff_){
+						//concordant mapping to the current region, reorient
+						if (searchIn && bAlnIn) {
+							//check for inverse mapping
+							if (bAln.IsReverseStrand() == search->IsReverseStrand()) {
+								writeInversePair(bAln, bAlnSeq, *search, searchSeq);
+							} else {
+								writeRegPair(bAln, bAlnSeq, *search, searchSeq);
 							}
-						} else {
-							if (searchIn && bAlnIn) {
-								//if these checks end up being the same it means the seq is now in the original orientation
-								//if false then they are now in the reverse complement of what they use to be
-								bool bAlnCheck = region.reverseSrand_ == bAln.IsReverseStrand();
-								bool searchCheck = searchRegion->reverseSrand_ == search->IsReverseStrand();
-								//if the checks equal each other that means the mates are now in the opposite orientation from each other and therefore are inverse mapping
-								if(bAlnCheck == searchCheck){
-									writeInversePair(bAln, bAlnSeq, *search, searchSeq);
-								}else{
-									writeDiscordantPair(bAln, bAlnSeq, *search, searchSeq);
-								}
-							}else if(searchIn){
-								writeMateFilteredOff(*search, *searchRegion);
-								writeTheThrownAwayMate(bAln, bAlnSeq);
-							}else if(bAlnIn){
-								writeMateFilteredOff(bAln, region);
-								writeTheThrownAwayMate(*search, searchSeq);
+						}else if(searchIn){
+							writeMateFilteredOff(*search, *searchRegion);
+							writeTheThrownAwayMate(bAln, bAlnSeq);
+						}else if(bAlnIn){
+							writeMateFilteredOff(bAln, region);
+							writeTheThrownAwayMate(*search, searchSeq);
+						}
+					} else {
+						if (searchIn && bAlnIn) {
+							//if these checks end up being the same it means the seq is now in the original orientation
+							//if false then they are now in the reverse complement of what they use to be
+							bool bAlnCheck = region.reverseSrand_ == bAln.IsReverseStrand();
+							bool searchCheck = searchRegion->reverseSrand_ == search->IsReverseStrand();
+							//if the checks equal each other that means the mates are now in the opposite orientation from each other and therefore are inverse mapping
+							if(bAlnCheck == searchCheck){
+								writeInversePair(bAln, bAlnSeq, *search, searchSeq);
+							}else{
+								writeDiscordantPair(bAln, bAlnSeq, *search, searchSeq);
 							}
+						}else if(searchIn){
+							writeMateFilteredOff(*search, *searchRegion);
+							writeTheThrownAwayMate(bAln, bAlnSeq);
+						}else if(bAlnIn){
+							writeMateFilteredOff(bAln, region);
+							writeTheThrownAwayMate(*search, searchSeq);
 						}
-					}else if(bAln.IsMapped()){
-						if (throwAwayUnmappedMate) {
-							if(bAlnIn){
-								writeThrowAwayUnmappedMate(bAln, bAlnSeq);
-								writeTheThrownAwayUnmappedMate(*search, searchSeq);
+					}
+				}else if(bAln.IsMapped()){
+					if (throwAwayUnmappedMate) {
+						if(bAlnIn){
+							writeThrowAwayUnmappedMate(bAln, bAlnSeq);
+							writeTheThrownAwayUnmappedMate(*search, searchSeq);
+						}
+					} else {
+						//first check to see if un mapped mate is likely falling within the region of interest
+						/**@todo should incorporate insert size if possible */
+						size_t posibleMatePosition = bAln.Position;
+						size_t possibleMatePostionEnd = 0;
+						bool reverseStrand = bAln.IsReverseStrand();
+						if(bAln.IsReverseStrand()){
+							//possibleMatePostionEnd = bAln.Position > static_cast<int64_t>(bAln.QueryBases.size()) ? bAln.Position - bAln.QueryBases.size() : 0;
+							possibleMatePostionEnd = bAln.Position;
+							posibleMatePosition = possibleMatePostionEnd > search->QueryBases.size() ? possibleMatePostionEnd - search->QueryBases.size() : 0;
+						}else{
+							posibleMatePosition += bAln.QueryBases.size();
+							possibleMatePostionEnd = posibleMatePosition + search->QueryBases.size();
+						}
+						bool matePass = false;
+						if(bAln.IsReverseStrand()){
+							//include mate if the read points off the beginning of the region
+							if(possibleMatePostionEnd < search->QueryBases.size()){
+								matePass = true;
 							}
 						} else {
-							//first check to see if un mapped mate is likely falling within the region of interest
-							/**@todo should incorporate insert size if possible */
-							size_t posibleMatePosition = bAln.Position;
-							size_t possibleMatePostionEnd = 0;
-							bool reverseStrand = bAln.IsReverseStrand();
-							if(bAln.IsReverseStrand()){
-								//possibleMatePostionEnd = bAln.Position > static_cast<int64_t>(bAln.QueryBases.size()) ? bAln.Position - bAln.QueryBases.size() : 0;
-								possibleMatePostionEnd = bAln.Position;
-								posibleMatePosition = possibleMatePostionEnd > search->QueryBases.size() ? possibleMatePostionEnd - search->QueryBases.size() : 0;
+							GenomicRegion possibleMateReg(search->Name, refData[bAln.RefID].RefName, posibleMatePosition, possibleMatePostionEnd, reverseStrand);
+							double mateBases = search->QueryBases.size();
+							matePass = (mateBases > 0 && possibleMateReg.getOverlapLen(region)/mateBases >= percInRegion);
+						}
+
+						//if(mateBases > 0 && possibleMateReg.getOverlapLen(region)/mateBases >= percInRegion){
+						//if(posibleMatePosition >= region.start_ && posibleMatePosition < region.end_){
+						if (matePass) {
+							//since to make it here at least one of the mates had to align, just check which one did
+							if(!region.reverseSrand_){
+								searchSeq.reverseComplementRead(false, true);
+							}
+							if(bAlnIn){
+								writeMateUnmappedPair(bAln, bAlnSeq, *search, searchSeq);
 							}else{
-								posibleMatePosition += bAln.QueryBases.size();
-								possibleMatePostionEnd = posibleMatePosition + search->QueryBases.size();
+								writeUnmappedMateFilteredPair(*search, searchSeq);
 							}
-							bool matePass = false;
-							if(bAln.IsReverseStrand()){
-								//include mate if the read points off the beginning of the region
-								if(possibleMatePostionEnd < search->QueryBases.size()){
-									matePass = true;
-								}
-							} else {
-								GenomicRegion possibleMateReg(search->Name, refData[bAln.RefID].RefName, posibleMatePosition, possibleMatePostionEnd, reverseStrand);
-								double mateBases = search->QueryBases.size();
-								matePass = (mateBases > 0 && possibleMateReg.getOverlapLen(region)/mateBases >= percInRegion);
+						}else{
+							if(bAlnIn){
+								writeThrowAwayUnmappedMate(bAln, bAlnSeq);
+								writeTheThrownAwayUnmappedMate(*search, searchSeq);
 							}
+						}
+					}
+				}else if(search->IsMapped()){
+					if (throwAwayUnmappedMate) {
+						if(searchIn){
+							writeThrowAwayUnmappedMate(*search, searchSeq);
+							writeTheThrownAwayUnmappedMate(bAln, bAlnSeq);
+						}
+					} else {
+						/**@todo should incorporate insert size if possible */
+						//first check to see if un mapped mate is likely falling within the region of interest
+						size_t posibleMatePosition = search->Position;
+						size_t possibleMatePostionEnd = 0;
+						bool reverseStrand = search->IsReverseStrand();
+						if(search->IsReverseStrand()){
+							//possibleMatePostionEnd = search->Position > static_cast<int64_t>(search->QueryBases.size()) ? search->Position - search->QueryBases.size() : 0;
+							possibleMatePostionEnd = search->Position;
+							posibleMatePosition = possibleMatePostionEnd > bAln.QueryBases.size() ? possibleMatePostionEnd - bAln.QueryBases.size() : 0;
+						} else {
+							posibleMatePosition += search->QueryBases.size();
+							possibleMatePostionEnd = posibleMatePosition + bAln.QueryBases.size();
+						}
 
-							//if(mateBases > 0 && possibleMateReg.getOverlapLen(region)/mateBases >= percInRegion){
-							//if(posibleMatePosition >= region.start_ && posibleMatePosition < region.end_){
-							if (matePass) {
-								//since to make it here at least one of the mates had to align, just check which one did
-								if(!region.reverseSrand_){
-									searchSeq.reverseComplementRead(false, true);
-								}
-								if(bAlnIn){
-									writeMateUnmappedPair(bAln, bAlnSeq, *search, searchSeq);
-								}else{
-									writeUnmappedMateFilteredPair(*search, searchSeq);
-								}
-							}else{
-								if(bAlnIn){
-									writeThrowAwayUnmappedMate(bAln, bAlnSeq);
-									writeTheThrownAwayUnmappedMate(*search, searchSeq);
-								}
+						bool matePass = false;
+						if(search->IsReverseStrand()){
+							//include mate if the read points off the beginning of the region
+							if(possibleMatePostionEnd < bAln.QueryBases.size()){
+								matePass = true;
 							}
+						} else {
+							GenomicRegion possibleMateReg(bAln.Name, refData[search->RefID].RefName, posibleMatePosition, possibleMatePostionEnd, reverseStrand);
+							double mateBases = bAln.QueryBases.size();
+							matePass = (mateBases > 0 && possibleMateReg.getOverlapLen(*searchRegion)/mateBases >= percInRegion);
 						}
-					}else if(search->IsMapped()){
-						if (throwAwayUnmappedMate) {
+						//if(posibleMatePosition >= searchRegion->start_ && posibleMatePosition < searchRegion->end_){
+						if(matePass){
+							//since to make it here at least one of the mates had to align, just check which one did
+							if(!searchRegion->reverseSrand_){
+								bAlnSeq.reverseComplementRead(false, true);
+							}
 							if(searchIn){
-								writeThrowAwayUnmappedMate(*search, searchSeq);
-								writeTheThrownAwayUnmappedMate(bAln, bAlnSeq);
+								writeMateUnmappedPair(bAln, bAlnSeq, *search, searchSeq);
+							}else{
+								writeUnmappedMateFilteredPair(bAln, bAlnSeq);
 							}
 						} else {
-							/**@todo should incorporate insert size if possible */
-							//first check to see if un mapped mate is likely falling within the region of interest
-							size_t posibleMatePosition = search->Position;
-							size_t possibleMatePostionEnd = 0;
-							bool reverseStrand = search->IsReverseStrand();
-							if(search->IsReverseStrand()){
-								//possibleMatePostionEnd = search->Position > static_cast<int64_t>(search->QueryBases.size()) ? search->Position - search->QueryBases.size() : 0;
-								possibleMatePostionEnd = search->Position;
-								posibleMatePosition = possibleMatePostionEnd > bAln.QueryBases.size() ? possibleMatePostionEnd - bAln.QueryBases.size() : 0;
-							} else {
-								posibleMatePosition += search->QueryBases.size();
-								possibleMatePostionEnd = posibleMatePosition + bAln.QueryBases.size();
-							}
-
-							bool matePass = false;
-							if(search->IsReverseStrand()){
-								//include mate if the read points off the beginning of the region
-								if(possibleMatePostionEnd < bAln.QueryBases.size()){
-									matePass = true;
-								}
-							} else {
-								GenomicRegion possibleMateReg(bAln.Name, refData[search->RefID].RefName, posibleMatePosition, possibleMatePostionEnd, reverseStrand);
-								double mateBases = bAln.QueryBases.size();
-								matePass = (mateBases > 0 && possibleMateReg.getOverlapLen(*searchRegion)/mateBases >= percInRegion);
-							}
-							//if(posibleMatePosition >= searchRegion->start_ && posibleMatePosition < searchRegion->end_){
-							if(matePass){
-								//since to make it here at least one of the mates had to align, just check which one did
-								if(!searchRegion->reverseSrand_){
-									bAlnSeq.reverseComplementRead(false, true);
-								}
-								if(searchIn){
-									writeMateUnmappedPair(bAln, bAlnSeq, *search, searchSeq);
-								}else{
-									writeUnmappedMateFilteredPair(bAln, bAlnSeq);
-								}
-							} else {
-								if (searchIn) {
-									writeThrowAwayUnmappedMate(*search, searchSeq);
-									writeTheThrownAwayUnmappedMate(bAln, bAlnSeq);
-								}
+							if (searchIn) {
+								writeThrowAwayUnmappedMate(*search, searchSeq);
+								writeTheThrownAwayUnmappedMate(bAln, bAlnSeq);
 							}
 						}
-					}else{
-						std::stringstream ss;
-						ss << __FILE__ << " " << __LINE__ << " " << __PRETTY_FUNCTION__
-								<< ", error shouldn't be able to reach here"
-								<< "\n";
-						throw std::runtime_error { ss.str() };
 					}
-					// now that operations have been computed, remove first mate found from cache
-					alnCache.remove(search->Name);
+				}else{
+					std::stringstream ss;
+					ss << __FILE__ << " " << __LINE__ << " " << __PRETTY_FUNCTION__
+							<< ", error shouldn't be able to reach here"
+							<< "\n";
+					throw std::runtime_error { ss.str() };
 				}
-			} else {
-				if(region.getPercInRegion(bAln, refData) >= percInRegion){
-					//unpaired read
-					++ret.unpaiedReads_;
-					if (originalOrientation) {
-						writer.openWrite(bamAlnToSeqInfo(bAln));
-					} else {
-						seqInfo outSeq(bAln.Name, bAln.QueryBases, bAln.Qualities,
-								SangerQualOffset);
-						//put in the orientation of the output region
-						if(region.reverseSrand_){
-							outSeq.reverseComplementRead(false, true);
-						}
-						writer.openWrite(outSeq);
+				// now that operations have been computed, remove first mate found from cache
+				alnCache.remove(search->Name);
+			}
+		} else {
+			if(region.getPercInRegion(bAln, refData) >= percInRegion){
+				//unpaired read
+				++ret.unpaiedReads_;
+				if (originalOrientation) {
+					writer.openWrite(bamAlnToSeqInfo(bAln));
+				} else {
+					seqInfo outSeq(bAln.Name, bAln.QueryBases, bAln.Qualities,
+							SangerQualOffset);
+					//put in the orientation of the output region
+					if(region.reverseSrand_){
+						outSeq.reverseComplementRead(false, true);
 					}
+					writer.openWrite(outSeq);
 				}
 			}
 		}
-	}
+	};
+	forEachAlnInRegions(inOutOpts.firstName_, regions, processAln);
 
 	//save the orphans;
 	/**@todo these will mostly be pairs that had mates that didn't fall in any regions,
@@ -24,6 +24,9 @@
 // along with njhseq.  If not, see <http://www.gnu.org/licenses/>.
 //
 #include "njhseq/BamToolsUtils/BamToolsUtils.hpp"
+#include "njhseq/BamToolsUtils/BamMatePairer.hpp"
+#include "njhseq/BamToolsUtils/BamRegionPartitionReader.hpp"
+#include "njhseq/BamToolsUtils/ParallelBamReader.hpp"
 #include "njhseq/objects/BioDataObject/GenomicRegion.hpp"
 #include "njhseq/objects/seqObjects/Paired/PairedRead.hpp"
 
@@ -168,6 +171,20 @@ public:
 
 	uint32_t insertLengthCutOff_ = 1000;
 
+	BamMatePairer::Pars matePairerPars_; /**< memory cap and spill directory for holding unmatched mates in extractReadsFromBamWrite */
+	ParallelBamReader::Pars bamReadPars_; /**< threads inflating BGZF blocks in the whole file extractions */
+	BamRegionPartitionReader::Pars regionReaderPars_; /**< set numThreads_ above 1 to decode regions on a pool of readers in the region based extractions */
+
+	/**@brief Call func on every primary alignment in regions in order, decoding partitions of the regions on several threads if regionReaderPars_.numThreads_ > 1
+	 *
+	 * @param bamFnp the bam file, must be indexed
+	 * @param regions the regions
+	 * @param func called with each alignment and the region it came from, always called from the calling thread
+	 */
+	void forEachAlnInRegions(const bfs::path & bamFnp,
+			const std::vector<GenomicRegion> & regions,
+			const std::function<void(const BamTools::BamAlignment &, const GenomicRegion &)> & func);
+
 };
 
 
@@ -24,6 +24,7 @@
 //
 
 #include "njhseq/GenomeUtils/GenomeMapping/MultiGenomeMapper.hpp"
+#include "njhseq/GenomeUtils/GenomeMapping/SeedExtendMapper.hpp"
 
 
 
@@ -26,7 +26,7 @@
 
 #include "GenomicRegionCounter.hpp"
 #include "njhseq/objects/BioDataObject/BioDataFileIO.hpp"
-#include "njhseq/objects/BioDataObject/GFFCore.hpp"
+#include "njhseq/objects/BioDataObject/GFFAnnotationIndex.hpp"
 #include "njhseq/BamToolsUtils.h"
 
 
@@ -92,33 +92,15 @@ void GenomicRegionCounter::increaseCounts(
 
 std::set<std::string> GenomicRegionCounter::getIntersectingGffIds(const bfs::path & gffFnp, const VecStr & features)const {
 	std::set<std::string> idsFromData;
-	BioDataFileIO<GFFCore> reader { IoOptions(InOptions(gffFnp)) };
-	reader.openIn();
-	uint32_t count = 0;
-	std::string line = "";
-	std::shared_ptr<GFFCore> gRecord = reader.readNextRecord();
-	while (nullptr != gRecord) {
-		if (njh::in(gRecord->type_, features) ) {
-			for (const auto & gCount : counts_) {
-				if (gCount.second.region_.overlaps(*gRecord)) {
-					idsFromData.emplace(gRecord->getIDAttr());
-					break;
-				}
+	auto index = GFFAnnotationIndex::getIndex(gffFnp);
+	for (const auto & gCount : counts_) {
+		const auto & region = gCount.second.region_;
+		for (const auto recordPos : index->getOverlapping(region.chrom_, region.start_, region.end_)) {
+			const auto & gRecord = index->getRecord(recordPos);
+			if (njh::in(gRecord.type_, features) && region.overlaps(gRecord)) {
+				idsFromData.emplace(gRecord.getIDAttr());
 			}
 		}
-		bool end = false;
-		while ('#' == reader.inFile_->peek()) {
-			if (njh::files::nextLineBeginsWith(*reader.inFile_, "##FASTA")) {
-				end = true;
-				break;
-			}
-			njh::files::crossPlatGetline(*reader.inFile_, line);
-		}
-		if (end) {
-			break;
-		}
-		gRecord = reader.readNextRecord();
-		++count;
 	}
 	return idsFromData;
 }
@@ -128,14 +110,14 @@ std::set<std::string> GenomicRegionCounter::getIntersectingGffIds(const bfs::pat
 GenomicRegionCounter GenomicRegionCounter::countRegionsInBam(const bfs::path & bamFnp){
 		GenomicRegionCounter gCounter;
 
-		BamTools::BamReader bReader;
-		bReader.Open(bamFnp.string());
-		checkBamOpenThrow(bReader, bamFnp);
-
+		//unmapped records are skipped without being decoded
+		ParallelBamReader bReader(bamFnp, ParallelBamReader::Pars());
+		LazyBamRecord record;
 		BamTools::BamAlignment bAln;
-		auto refData = bReader.GetReferenceData();
-		while (bReader.GetNextAlignment(bAln)) {
-			if (bAln.IsMapped()) {
+		auto refData = bReader.getReferenceData();
+		while (bReader.getNextRecord(record)) {
+			if (record.isMapped()) {
+				record.toBamAlignment(bAln);
 				gCounter.increaseCount(GenomicRegion(bAln, refData), 1);
 			}
 		}
@@ -358,6 +358,31 @@ std::unordered_map<std::string, MultiGenomeMapper::AlignCmdOutput> MultiGenomeMa
 
 
 
+std::unordered_map<std::string, MultiGenomeMapper::AlignCmdOutput> MultiGenomeMapper::alignToGenomesBuiltIn(
+		const SeqIOOptions & inputOpts, const bfs::path & outputPrefix,
+		const SeedExtendMapper::Pars & mapperPars) const {
+	std::unordered_map<std::string, AlignCmdOutput> ret;
+	uint64_t maxLen = 0;
+	auto inputSeqs = SeqInput::getSeqVec<seqInfo>(inputOpts, maxLen);
+	aligner alignerObj(maxLen + 2 * mapperPars.extendPadding_,
+			gapScoringParameters(5, 1, 0, 0, 0, 0), substituteMatrix(2, -2));
+	//genomes are done one at a time with all threads used for mapping the sequences
+	for (const auto & genome : genomes_) {
+		bfs::path outFnp = outputPrefix.string() + genome.first + "_aligned.sorted.bam";
+		AlignCmdOutput output(outFnp);
+		if (bfs::exists(outFnp)
+				&& njh::files::firstFileIsOlder(inputOpts.firstName_, outFnp)
+				&& njh::files::firstFileIsOlder(genome.second->fnp_, outFnp)) {
+		} else {
+			SeedExtendMapper mapper(genome.second->fnpTwoBit_, mapperPars);
+			auto bAlns = mapper.mapSeqsToBamAlignments(inputSeqs, alignerObj, pars_.numThreads_);
+			mapper.writeSortedBam(bAlns, outFnp);
+		}
+		ret.emplace(genome.first, output);
+	}
+	return ret;
+}
+
 std::unordered_map<std::string, std::vector<GenomicRegion>> MultiGenomeMapper::getRegionsFromBams(
 		const std::unordered_map<std::string, bfs::path> & bamFnps) const {
 	std::unordered_map<std::string, std::vector<GenomicRegion>> ret;
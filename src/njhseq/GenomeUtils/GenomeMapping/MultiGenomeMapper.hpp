@@ -25,6 +25,7 @@
 //
 #include "njhseq/utils.h"
 #include "njhseq/GenomeUtils/GenomeMapping/GenomicRegionCounter.hpp"
+#include "njhseq/GenomeUtils/GenomeMapping/SeedExtendMapper.hpp"
 #include "njhseq/objects/BioDataObject/reading.hpp"
 #include "njhseq/system.h"
 
@@ -123,6 +124,17 @@ public:
 			const SeqIOOptions & inputOpts, const bfs::path & outputPrefix,
 			const BioCmdsUtils::LastZPars & pars = BioCmdsUtils::LastZPars()) const;
 
+	/**@brief Same as alignToGenomes but maps in memory with a SeedExtendMapper rather than calling bowtie2, still writes out the same sorted and indexed bam files
+	 *
+	 * @param inputOpts the sequences to map
+	 * @param outputPrefix the prefix for the bam files, the same as alignToGenomes
+	 * @param mapperPars the parameters for the mapper
+	 * @return the output for each genome, rOutput_ is left empty
+	 */
+	std::unordered_map<std::string, AlignCmdOutput> alignToGenomesBuiltIn(
+			const SeqIOOptions & inputOpts, const bfs::path & outputPrefix,
+			const SeedExtendMapper::Pars & mapperPars = SeedExtendMapper::Pars()) const;
+
 	std::unordered_map<std::string, std::vector<GenomicRegion>> getRegionsFromBams(
 			const std::unordered_map<std::string, bfs::path> & bamFnps) const;
 
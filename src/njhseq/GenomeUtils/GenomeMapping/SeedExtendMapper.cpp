@@ -0,0 +1,425 @@
+/*
+ * SeedExtendMapper.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: nick
+ */
+//
+// njhseq - A library for analyzing sequence data
+// Copyright (C) 2012-2018 Nicholas Hathaway <nicholas.hathaway@umassmed.edu>,
+//
+// This file is part of njhseq.
+//
+// njhseq is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// njhseq is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with njhseq.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "SeedExtendMapper.hpp"
+#include "njhseq/IO/SeqIO/SeqInput.hpp"
+#include "njhseq/helpers/seqUtil.hpp"
+#include "njhseq/readVectorManipulation/readVectorOperations/massGetters.hpp"
+
+namespace njhseq {
+
+namespace {
+
+uint8_t baseToTwoBit(char base) {
+	switch (base) {
+	case 'A':
+	case 'a':
+		return 0;
+	case 'C':
+	case 'c':
+		return 1;
+	case 'G':
+	case 'g':
+		return 2;
+	case 'T':
+	case 't':
+		return 3;
+	default:
+		return 4;
+	}
+}
+
+//invertible integer hash so minimizers aren't biased towards poly-A kmers
+uint64_t mixKmerHash(uint64_t kmer) {
+	kmer = (kmer ^ (kmer >> 30)) * UINT64_C(0xbf58476d1ce4e5b9);
+	kmer = (kmer ^ (kmer >> 27)) * UINT64_C(0x94d049bb133111eb);
+	return kmer ^ (kmer >> 31);
+}
+
+}  // namespace
+
+SeedExtendMapper::SeedExtendMapper(const std::vector<seqInfo> & refs,
+		const Pars & pars) :
+		pars_(pars), refs_(refs) {
+	if (0 == pars_.kLen_ || pars_.kLen_ > 31) {
+		std::stringstream ss;
+		ss << __PRETTY_FUNCTION__ << ", error " << "kLen_ should be between 1 and 31, not " << pars_.kLen_ << "\n";
+		throw std::runtime_error { ss.str() };
+	}
+	if (0 == pars_.windowSize_) {
+		std::stringstream ss;
+		ss << __PRETTY_FUNCTION__ << ", error " << "windowSize_ can't be 0" << "\n";
+		throw std::runtime_error { ss.str() };
+	}
+	for (auto & ref : refs_) {
+		std::transform(ref.seq_.begin(), ref.seq_.end(), ref.seq_.begin(),
+				[](char base) {return static_cast<char>(::toupper(base));});
+		refData_.emplace_back(ref.name_, ref.seq_.size());
+	}
+	indexRefs();
+}
+
+SeedExtendMapper::SeedExtendMapper(const bfs::path & genomeFnp,
+		const Pars & pars) :
+		SeedExtendMapper(readInRefs(genomeFnp), pars) {
+}
+
+std::vector<seqInfo> SeedExtendMapper::readInRefs(const bfs::path & genomeFnp) {
+	std::vector<seqInfo> ret;
+	if (".2bit" == genomeFnp.extension().string()) {
+		TwoBit::TwoBitFile tReader(genomeFnp);
+		auto lens = tReader.getSeqLens();
+		auto names = njh::getVecOfMapKeys(lens);
+		njh::sort(names);
+		for (const auto & name : names) {
+			std::string seq;
+			tReader[name]->getSequence(seq, 0, lens.at(name), false);
+			ret.emplace_back(name, seq);
+		}
+	} else {
+		ret = SeqInput::getSeqVec<seqInfo>(SeqIOOptions(genomeFnp, SeqIOOptions::getInFormatFromFnp(genomeFnp), false));
+	}
+	for (auto & ref : ret) {
+		std::transform(ref.seq_.begin(), ref.seq_.end(), ref.seq_.begin(),
+				[](char base) {return static_cast<char>(::toupper(base));});
+	}
+	return ret;
+}
+
+void SeedExtendMapper::setMinimizers(const std::string & seq,
+		std::vector<Minimizer> & minimizers) const {
+	minimizers.clear();
+	if (seq.size() < pars_.kLen_) {
+		return;
+	}
+	const uint64_t invalid = std::numeric_limits<uint64_t>::max();
+	const uint64_t mask = (UINT64_C(1) << (2 * pars_.kLen_)) - 1;
+	std::vector<uint64_t> hashes(seq.size() - pars_.kLen_ + 1, invalid);
+	uint64_t kmer = 0;
+	uint32_t validLen = 0;
+	for (const auto pos : iter::range(seq.size())) {
+		auto code = baseToTwoBit(seq[pos]);
+		if (code > 3) {
+			//kmers spanning ambiguous bases aren't indexed
+			kmer = 0;
+			validLen = 0;
+			continue;
+		}
+		kmer = ((kmer << 2) | code) & mask;
+		++validLen;
+		if (validLen >= pars_.kLen_) {
+			hashes[pos + 1 - pars_.kLen_] = mixKmerHash(kmer);
+		}
+	}
+	const uint64_t windowSize = std::min<uint64_t>(pars_.windowSize_, hashes.size());
+	for (uint64_t winStart = 0; winStart + windowSize <= hashes.size(); ++winStart) {
+		uint64_t minHash = invalid;
+		uint32_t minPos = 0;
+		for (uint64_t pos = winStart; pos < winStart + windowSize; ++pos) {
+			if (hashes[pos] < minHash) {
+				minHash = hashes[pos];
+				minPos = pos;
+			}
+		}
+		if (invalid != minHash
+				&& (minimizers.empty() || minimizers.back().pos_ != minPos)) {
+			minimizers.emplace_back(Minimizer { minHash, minPos });
+		}
+	}
+}
+
+void SeedExtendMapper::indexRefs() {
+	index_.clear();
+	std::vector<Minimizer> minimizers;
+	for (const auto refId : iter::range(refs_.size())) {
+		setMinimizers(refs_[refId].seq_, minimizers);
+		for (const auto & minimizer : minimizers) {
+			index_[minimizer.hash_].emplace_back(
+					Seed { static_cast<uint32_t>(refId), minimizer.pos_ });
+		}
+	}
+}
+
+std::vector<SeedExtendMapper::Hit> SeedExtendMapper::mapSeq(const seqInfo & seq,
+		aligner & alignerObj) const {
+	std::vector<Hit> ret;
+	if (seq.seq_.size() < pars_.kLen_) {
+		return ret;
+	}
+	//gather seeds on both strands, diagonal is refPos - readPos of the strand aligned
+	std::vector<Anchor> anchors;
+	std::vector<Minimizer> minimizers;
+	for (const bool reverse : { false, true }) {
+		std::string query = reverse ? seqUtil::reverseComplement(seq.seq_, "DNA") : seq.seq_;
+		setMinimizers(query, minimizers);
+		for (const auto & minimizer : minimizers) {
+			auto search = index_.find(minimizer.hash_);
+			if (index_.end() == search || search->second.size() > pars_.maxOccurrences_) {
+				continue;
+			}
+			for (const auto & seed : search->second) {
+				anchors.emplace_back(
+						Anchor { seed.refId_, reverse,
+								static_cast<int64_t>(seed.refPos_) - static_cast<int64_t>(minimizer.pos_),
+								minimizer.pos_ });
+			}
+		}
+	}
+	if (anchors.empty()) {
+		return ret;
+	}
+	std::sort(anchors.begin(), anchors.end(), [](const Anchor & a1, const Anchor & a2) {
+		if (a1.reverse_ != a2.reverse_) {
+			return a1.reverse_ < a2.reverse_;
+		}
+		if (a1.refId_ != a2.refId_) {
+			return a1.refId_ < a2.refId_;
+		}
+		if (a1.diagonal_ != a2.diagonal_) {
+			return a1.diagonal_ < a2.diagonal_;
+		}
+		return a1.readPos_ < a2.readPos_;
+	});
+
+	//cluster seeds that are on the same strand and reference and within maxDiagonalGap_ of the previous seed's diagonal
+	struct SeedCluster {
+		uint32_t refId_;
+		bool reverse_;
+		int64_t minDiagonal_;
+		int64_t maxDiagonal_;
+		std::vector<uint32_t> readPositions_;
+		uint32_t coverage_ = 0;
+	};
+	std::vector<SeedCluster> clusters;
+	for (const auto & anchor : anchors) {
+		if (clusters.empty() || clusters.back().refId_ != anchor.refId_
+				|| clusters.back().reverse_ != anchor.reverse_
+				|| anchor.diagonal_ - clusters.back().maxDiagonal_ > static_cast<int64_t>(pars_.maxDiagonalGap_)) {
+			clusters.emplace_back(SeedCluster { anchor.refId_, anchor.reverse_, anchor.diagonal_, anchor.diagonal_, { }, 0 });
+		}
+		clusters.back().maxDiagonal_ = anchor.diagonal_;
+		clusters.back().readPositions_.emplace_back(anchor.readPos_);
+	}
+	for (auto & cluster : clusters) {
+		//the number of read bases covered by the seeds' kmers
+		njh::sort(cluster.readPositions_);
+		uint32_t coveredUpTo = 0;
+		for (const auto readPos : cluster.readPositions_) {
+			uint32_t kmerEnd = readPos + pars_.kLen_;
+			if (kmerEnd > coveredUpTo) {
+				cluster.coverage_ += kmerEnd - std::max(readPos, coveredUpTo);
+				coveredUpTo = kmerEnd;
+			}
+		}
+	}
+	clusters.erase(std::remove_if(clusters.begin(), clusters.end(),
+			[this](const SeedCluster & cluster) {
+				return cluster.readPositions_.size() < pars_.minSeeds_;
+			}), clusters.end());
+	if (clusters.empty()) {
+		return ret;
+	}
+	std::stable_sort(clusters.begin(), clusters.end(),
+			[](const SeedCluster & c1, const SeedCluster & c2) {
+				return c1.coverage_ > c2.coverage_;
+			});
+
+	//extend the best clusters
+	const uint32_t bestCoverage = clusters.front().coverage_;
+	const uint32_t maxHits = pars_.primaryOnly_ ? 1 : std::max<uint32_t>(1, pars_.maxHits_);
+	for (const auto & cluster : clusters) {
+		if (ret.size() >= maxHits || cluster.coverage_ < pars_.secondaryFrac_ * bestCoverage) {
+			break;
+		}
+		const auto & ref = refs_[cluster.refId_];
+		int64_t refStart = std::max<int64_t>(0, cluster.minDiagonal_ - static_cast<int64_t>(pars_.extendPadding_));
+		int64_t refEnd = std::min<int64_t>(ref.seq_.size(),
+				cluster.maxDiagonal_ + static_cast<int64_t>(seq.seq_.size() + pars_.extendPadding_));
+		if (refEnd <= refStart) {
+			continue;
+		}
+		seqInfo refWindow(ref.name_, ref.seq_.substr(refStart, refEnd - refStart));
+		seqInfo query = seq;
+		if (cluster.reverse_) {
+			query.reverseComplementRead(false, true);
+		}
+		uint64_t maxLen = alignerObj.parts_.maxSize_;
+		readVec::getMaxLength(query, maxLen);
+		readVec::getMaxLength(refWindow, maxLen);
+		alignerObj.parts_.setMaxSize(maxLen);
+		//no caching, the windows are rarely the same twice
+		alignerObj.alignRegGlobal(refWindow, query);
+		const auto & alnRef = alignerObj.alignObjectA_.seqBase_.seq_;
+		const auto & alnQuery = alignerObj.alignObjectB_.seqBase_.seq_;
+
+		//only the columns between the first and last columns where both have a base are reported, query bases outside are soft clipped
+		uint32_t firstCol = std::numeric_limits<uint32_t>::max();
+		uint32_t lastCol = 0;
+		for (const auto col : iter::range<uint32_t>(alnRef.size())) {
+			if ('-' != alnRef[col] && '-' != alnQuery[col]) {
+				firstCol = std::min(firstCol, col);
+				lastCol = col;
+			}
+		}
+		if (std::numeric_limits<uint32_t>::max() == firstCol) {
+			continue;
+		}
+		auto countNonGaps = [](const std::string & seq, uint32_t start, uint32_t end) {
+			return static_cast<uint32_t>(std::count_if(seq.begin() + start, seq.begin() + end,
+					[](char base) {return '-' != base;}));
+		};
+		Hit hit;
+		hit.refId_ = cluster.refId_;
+		hit.seedCoverage_ = cluster.coverage_;
+		hit.alnScore_ = alignerObj.parts_.score_;
+		uint32_t leftClip = countNonGaps(alnQuery, 0, firstCol);
+		uint32_t rightClip = countNonGaps(alnQuery, lastCol + 1, alnQuery.size());
+		if (leftClip > 0) {
+			hit.cigarData_.emplace_back(BamTools::CigarOp('S', leftClip));
+		}
+		for (const auto col : iter::range(firstCol, lastCol + 1)) {
+			char type = 'M';
+			if ('-' == alnRef[col]) {
+				type = 'I';
+			} else if ('-' == alnQuery[col]) {
+				type = 'D';
+			}
+			if (!hit.cigarData_.empty() && type == hit.cigarData_.back().Type) {
+				++hit.cigarData_.back().Length;
+			} else {
+				hit.cigarData_.emplace_back(BamTools::CigarOp(type, 1));
+			}
+		}
+		if (rightClip > 0) {
+			hit.cigarData_.emplace_back(BamTools::CigarOp('S', rightClip));
+		}
+		uint32_t regionStart = refStart + countNonGaps(alnRef, 0, firstCol);
+		uint32_t regionEnd = regionStart + countNonGaps(alnRef, firstCol, lastCol + 1);
+		hit.gRegion_ = GenomicRegion(seq.name_, ref.name_, regionStart, regionEnd, cluster.reverse_);
+		hit.alnRefSeq_ = alignerObj.alignObjectA_.seqBase_.getSubRead(firstCol, lastCol + 1 - firstCol);
+		hit.alnQuerySeq_ = alignerObj.alignObjectB_.seqBase_.getSubRead(firstCol, lastCol + 1 - firstCol);
+		alignerObj.alignObjectA_.seqBase_ = hit.alnRefSeq_;
+		alignerObj.alignObjectB_.seqBase_ = hit.alnQuerySeq_;
+		alignerObj.profileAlignment(refWindow, query, false, false, false);
+		hit.comp_ = alignerObj.comp_;
+		ret.emplace_back(hit);
+	}
+	if (ret.empty()) {
+		return ret;
+	}
+	std::stable_sort(ret.begin(), ret.end(), [](const Hit & hit1, const Hit & hit2) {
+		return hit1.alnScore_ > hit2.alnScore_;
+	});
+	//mapping quality from how much better the best hit is than the next best, either extended or just seeded
+	double nextBest = 0;
+	if (ret.size() > 1) {
+		nextBest = std::max<double>(0, ret[1].alnScore_);
+	} else if (clusters.size() > 1 && bestCoverage > 0) {
+		nextBest = std::max<double>(0, ret.front().alnScore_) * clusters[1].coverage_ / bestCoverage;
+	}
+	double best = std::max<double>(1, ret.front().alnScore_);
+	ret.front().mapQuality_ = static_cast<uint16_t>(std::round(60 * std::max<double>(0, (best - nextBest) / best)));
+	for (const auto pos : iter::range<uint64_t>(1, ret.size())) {
+		ret[pos].primary_ = false;
+		ret[pos].mapQuality_ = 0;
+	}
+	return ret;
+}
+
+BamTools::BamAlignment SeedExtendMapper::toBamAlignment(const seqInfo & seq,
+		const Hit & hit) const {
+	BamTools::BamAlignment ret;
+	seqInfo plusStrandSeq = seq;
+	if (hit.gRegion_.reverseSrand_) {
+		plusStrandSeq.reverseComplementRead(false, true);
+	}
+	ret.Name = seq.name_;
+	ret.QueryBases = plusStrandSeq.seq_;
+	ret.Qualities = plusStrandSeq.getFastqQualString(SangerQualOffset);
+	ret.Length = plusStrandSeq.seq_.size();
+	ret.RefID = hit.refId_;
+	ret.Position = hit.gRegion_.start_;
+	ret.CigarData = hit.cigarData_;
+	ret.MapQuality = hit.mapQuality_;
+	ret.MateRefID = -1;
+	ret.MatePosition = -1;
+	ret.InsertSize = 0;
+	ret.SetIsMapped(true);
+	ret.SetIsReverseStrand(hit.gRegion_.reverseSrand_);
+	ret.SetIsPrimaryAlignment(hit.primary_);
+	return ret;
+}
+
+BamTools::BamAlignment SeedExtendMapper::genUnmappedBamAlignment(const seqInfo & seq) {
+	BamTools::BamAlignment ret;
+	ret.Name = seq.name_;
+	ret.QueryBases = seq.seq_;
+	ret.Qualities = seq.getFastqQualString(SangerQualOffset);
+	ret.Length = seq.seq_.size();
+	ret.RefID = -1;
+	ret.Position = -1;
+	ret.MateRefID = -1;
+	ret.MatePosition = -1;
+	ret.InsertSize = 0;
+	ret.SetIsMapped(false);
+	return ret;
+}
+
+void SeedExtendMapper::writeSortedBam(std::vector<BamTools::BamAlignment> & bAlns,
+		const bfs::path & outFnp) const {
+	//unmapped records have a RefID of -1 so cast to unsigned to put them last
+	std::stable_sort(bAlns.begin(), bAlns.end(),
+			[](const BamTools::BamAlignment & bAln1, const BamTools::BamAlignment & bAln2) {
+				if (bAln1.RefID != bAln2.RefID) {
+					return static_cast<uint32_t>(bAln1.RefID) < static_cast<uint32_t>(bAln2.RefID);
+				}
+				return bAln1.Position < bAln2.Position;
+			});
+	std::stringstream header;
+	header << "@HD\tVN:1.4\tSO:coordinate" << "\n";
+	for (const auto & ref : refData_) {
+		header << "@SQ\tSN:" << ref.RefName << "\tLN:" << ref.RefLength << "\n";
+	}
+	header << "@PG\tID:njhseq-SeedExtendMapper\tPN:njhseq" << "\n";
+	{
+		BamTools::BamWriter bWriter;
+		if (!bWriter.Open(outFnp.string(), header.str(), refData_)) {
+			std::stringstream ss;
+			ss << __PRETTY_FUNCTION__ << ", error " << "couldn't open " << outFnp << " for writing" << "\n";
+			ss << bWriter.GetErrorString() << "\n";
+			throw std::runtime_error { ss.str() };
+		}
+		for (const auto & bAln : bAlns) {
+			bWriter.SaveAlignment(bAln);
+		}
+		bWriter.Close();
+	}
+	BamTools::BamReader bReader;
+	bReader.Open(outFnp.string());
+	checkBamOpenThrow(bReader, outFnp);
+	bReader.CreateIndex();
+}
+
+}  // namespace njhseq
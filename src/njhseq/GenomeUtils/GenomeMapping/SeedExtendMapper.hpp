@@ -0,0 +1,218 @@
+#pragma once
+/*
+ * SeedExtendMapper.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: nick
+ */
+//
+// njhseq - A library for analyzing sequence data
+// Copyright (C) 2012-2018 Nicholas Hathaway <nicholas.hathaway@umassmed.edu>,
+//
+// This file is part of njhseq.
+//
+// njhseq is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// njhseq is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with njhseq.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "njhseq/utils.h"
+#include "njhseq/BamToolsUtils/BamToolsUtils.hpp"
+#include "njhseq/objects/BioDataObject/GenomicRegion.hpp"
+#include "njhseq/concurrency/pools/AlignerPool.hpp"
+
+namespace njhseq {
+
+/**@brief An in process seed and extend mapper for small references (e.g. amplicon targets against a few Mb of genome)
+ *
+ * The reference is indexed by (w,k) minimizers, read minimizers on both strands are looked up to get seeds which are
+ * clustered by reference diagonal, and the best clusters are extended with a global alignment (free end gaps) of the read
+ * against the reference window the cluster covers, this avoids writing out sequences and calling bowtie2/lastz and
+ * then reading back in a bam file
+ *
+ */
+class SeedExtendMapper {
+public:
+
+	struct Pars {
+		uint32_t kLen_ = 15; /**< kmer length of the minimizers, max 31 */
+		uint32_t windowSize_ = 10; /**< the number of consecutive kmers each minimizer is chosen from */
+		uint32_t maxOccurrences_ = 500; /**< minimizers that occur more than this in the reference are ignored as repeats */
+		uint32_t maxDiagonalGap_ = 50; /**< the max difference in diagonal between seeds to still be clustered together, bounds the indel size between seeds */
+		uint32_t minSeeds_ = 2; /**< the minimum number of seeds for a cluster to be extended */
+		uint32_t extendPadding_ = 20; /**< the amount of reference added on each side of a cluster before extending */
+		uint32_t maxHits_ = 5; /**< the max number of clusters to extend per read */
+		double secondaryFrac_ = 0.5; /**< clusters with less than this fraction of the best cluster's seed coverage aren't extended */
+		bool primaryOnly_ = true; /**< only report the best hit for each read */
+	};
+
+	/**@brief A hit of a read to the reference
+	 *
+	 */
+	struct Hit {
+		uint32_t refId_ = 0; /**< the position of the reference in refData_ */
+		GenomicRegion gRegion_; /**< the region the read aligned to, reverseSrand_ set if the reverse complement of the read aligned */
+		seqInfo alnRefSeq_; /**< the aligned reference covering only where the read aligned */
+		seqInfo alnQuerySeq_; /**< the aligned read, reverse complemented if on the reverse strand */
+		comparison comp_;
+		int32_t alnScore_ = 0;
+		uint32_t seedCoverage_ = 0; /**< the number of read bases covered by seeds in the cluster */
+		uint16_t mapQuality_ = 0;
+		bool primary_ = true;
+		std::vector<BamTools::CigarOp> cigarData_;
+	};
+
+	/**@brief Index the given reference sequences
+	 *
+	 * @param refs the reference sequences, the order will be the order of refData_
+	 * @param pars the mapping parameters
+	 */
+	SeedExtendMapper(const std::vector<seqInfo> & refs, const Pars & pars);
+
+	/**@brief Index a genome file, either a 2bit file or anything SeqInput can read
+	 *
+	 * @param genomeFnp the genome file
+	 * @param pars the mapping parameters
+	 */
+	SeedExtendMapper(const bfs::path & genomeFnp, const Pars & pars);
+
+	const Pars pars_;
+	std::vector<seqInfo> refs_;
+	BamTools::RefVector refData_;
+
+	/**@brief Read in the reference sequences from a 2bit file (by extension .2bit) or any other file SeqInput can read, sequences are upper cased
+	 *
+	 */
+	static std::vector<seqInfo> readInRefs(const bfs::path & genomeFnp);
+
+	/**@brief Map a single sequence
+	 *
+	 * @param seq the sequence to map
+	 * @param alignerObj the aligner to extend with, it's max size will be increased if needed
+	 * @return the hits sorted best first, empty if nothing mapped
+	 */
+	std::vector<Hit> mapSeq(const seqInfo & seq, aligner & alignerObj) const;
+
+	/**@brief Map sequences with multiple threads
+	 *
+	 * @param seqs the sequences to map
+	 * @param alnPool the pool to get the per thread aligners from, should already be initialized
+	 * @param numThreads the number of threads to use
+	 * @return the hits for each sequence in the same order as seqs
+	 */
+	template<typename T>
+	std::vector<std::vector<Hit>> mapSeqs(const std::vector<T> & seqs,
+			concurrent::AlignerPool & alnPool, uint32_t numThreads) const {
+		std::vector<std::vector<Hit>> ret(seqs.size());
+		std::vector<uint32_t> positions(seqs.size());
+		njh::iota<uint32_t>(positions, 0);
+		njh::concurrent::LockableQueue<uint32_t> posQueue(positions);
+		auto mapSeqsFunc = [this, &seqs, &ret, &alnPool, &posQueue]() {
+			auto alignerObj = alnPool.popAligner();
+			uint32_t pos = 0;
+			while (posQueue.getVal(pos)) {
+				//each position is only ever set by one thread so no lock is needed
+				ret[pos] = mapSeq(getSeqBase(seqs[pos]), *alignerObj);
+			}
+		};
+		uint32_t threadsToUse = std::max<uint32_t>(1, numThreads);
+		if (1 == threadsToUse) {
+			mapSeqsFunc();
+		} else {
+			std::vector<std::thread> threads;
+			for (uint32_t t = 0; t < threadsToUse; ++t) {
+				threads.emplace_back(mapSeqsFunc);
+			}
+			njh::concurrent::joinAllJoinableThreads(threads);
+		}
+		return ret;
+	}
+
+	/**@brief Map sequences with multiple threads and convert the hits to bam alignments
+	 *
+	 * @param seqs the sequences to map
+	 * @param alnPool the pool to get the per thread aligners from, should already be initialized
+	 * @param numThreads the number of threads to use
+	 * @return the alignments in the order of seqs, sequences with no hits get an unmapped record, the RefIDs refer to refData_
+	 */
+	template<typename T>
+	std::vector<BamTools::BamAlignment> mapSeqsToBamAlignments(const std::vector<T> & seqs,
+			concurrent::AlignerPool & alnPool, uint32_t numThreads) const {
+		auto hits = mapSeqs(seqs, alnPool, numThreads);
+		std::vector<BamTools::BamAlignment> ret;
+		for (const auto pos : iter::range(seqs.size())) {
+			if (hits[pos].empty()) {
+				ret.emplace_back(genUnmappedBamAlignment(getSeqBase(seqs[pos])));
+			} else {
+				for (const auto & hit : hits[pos]) {
+					ret.emplace_back(toBamAlignment(getSeqBase(seqs[pos]), hit));
+				}
+			}
+		}
+		return ret;
+	}
+
+	/**@brief Map sequences with multiple threads with copies of alignerObj
+	 *
+	 * @param seqs the sequences to map
+	 * @param alignerObj the aligner to copy for each thread
+	 * @param numThreads the number of threads to use
+	 * @return the alignments in the order of seqs, sequences with no hits get an unmapped record, the RefIDs refer to refData_
+	 */
+	template<typename T>
+	std::vector<BamTools::BamAlignment> mapSeqsToBamAlignments(const std::vector<T> & seqs,
+			const aligner & alignerObj, uint32_t numThreads) const {
+		uint32_t threadsToUse = std::max<uint32_t>(1, numThreads);
+		concurrent::AlignerPool alnPool(alignerObj, threadsToUse);
+		alnPool.initAligners();
+		return mapSeqsToBamAlignments(seqs, alnPool, threadsToUse);
+	}
+
+	/**@brief Convert a hit into a bam alignment, the query bases are stored in the plus strand orientation of the reference like a bam file would
+	 *
+	 */
+	BamTools::BamAlignment toBamAlignment(const seqInfo & seq, const Hit & hit) const;
+
+	static BamTools::BamAlignment genUnmappedBamAlignment(const seqInfo & seq);
+
+	/**@brief Write alignments out to a sorted and indexed bam file
+	 *
+	 * @param bAlns the alignments, will be sorted by position
+	 * @param outFnp the bam file to write to
+	 */
+	void writeSortedBam(std::vector<BamTools::BamAlignment> & bAlns,
+			const bfs::path & outFnp) const;
+
+private:
+	struct Seed {
+		uint32_t refId_;
+		uint32_t refPos_;
+	};
+	struct Minimizer {
+		uint64_t hash_;
+		uint32_t pos_;
+	};
+	struct Anchor {
+		uint32_t refId_;
+		bool reverse_;
+		int64_t diagonal_;
+		uint32_t readPos_;
+	};
+
+	std::unordered_map<uint64_t, std::vector<Seed>> index_;
+
+	void indexRefs();
+
+	void setMinimizers(const std::string & seq, std::vector<Minimizer> & minimizers) const;
+
+};
+
+}  // namespace njhseq
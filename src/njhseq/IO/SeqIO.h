@@ -34,5 +34,6 @@
 #include "njhseq/IO/SeqIO/SeqIO.hpp"
 #include "njhseq/IO/SeqIO/ClustalReader.hpp"
 #include "njhseq/IO/SeqIO/MultiSeqIO.hpp"
+#include "njhseq/IO/SeqIO/MultiSeqOutWriteBehind.hpp"
 #include "njhseq/IO/SeqIO/MultiSeqOutCache.hpp"
 #include "njhseq/IO/SeqIO/SeqIOOptsWithTime.hpp"
@@ -93,17 +93,25 @@ void MultiSeqIO::closeOutForReopeningAll() {
 }
 
 void MultiSeqIO::closeNext() {
-	auto nextUp = outsOpen_.front();
-	outsOpen_.pop_front();
-	while (openPriorityCounts_[nextUp] > 1) {
-		--openPriorityCounts_[nextUp];
-		nextUp = outsOpen_.front();
+	while (!outsOpen_.empty()) {
+		auto nextUp = outsOpen_.front();
 		outsOpen_.pop_front();
+		auto readIO = readIos_.find(nextUp);
+		if (!readIO->second->out_.outOpen()) {
+			//left over from a writer that has already been closed
+			openPriorityCounts_[nextUp] = 0;
+			continue;
+		}
+		if (openPriorityCounts_[nextUp] > 1) {
+			//written to more recently, there's a later entry for it
+			--openPriorityCounts_[nextUp];
+			continue;
+		}
+		std::lock_guard<std::mutex> lock(readIO->second->mut_);
+		readIO->second->out_.closeOutForReopening();
+		openPriorityCounts_[nextUp] = 0;
+		return;
 	}
-	auto readIO = readIos_.find(nextUp);
-	std::lock_guard<std::mutex> lock(readIO->second->mut_);
-	readIO->second->out_.closeOutForReopening();
-	openPriorityCounts_[nextUp] = 0;
 }
 
 uint32_t MultiSeqIO::getOpenLimit() const {
@@ -131,14 +139,29 @@ void MultiSeqIO::containsReaderThrow(const std::string & uid) const {
 }
 
 
+void MultiSeqIO::openWriteFormatted(const std::string & uid,
+		const std::string & primary, const std::string & secondary) {
+	containsReaderThrow(uid);
+	auto & readIO = readIos_.at(uid);
+	std::unique_lock<std::mutex> ioLock(readIO->mut_, std::defer_lock);
+	{
+		std::lock_guard<std::mutex> lock(mut_);
+		ioLock.lock();
+		openOutLockFree(uid);
+	}
+	readIO->out_.openWriteFormatted(primary, secondary);
+}
+
 void MultiSeqIO::openOut(const std::string & uid){
+	containsReaderThrow(uid);
+	std::lock_guard<std::mutex> lock(mut_);
+	std::lock_guard<std::mutex> ioLock(readIos_.at(uid)->mut_);
+	openOutLockFree(uid);
+}
+
+void MultiSeqIO::openOutLockFree(const std::string & uid){
 	//std::cout << __PRETTY_FUNCTION__ << 1 << std::endl;
 	//std::cout << uid << std::endl;
-	containsReaderThrow(uid);
-	//std::cout << __PRETTY_FUNCTION__ << 2 << std::endl;
-	mut_.lock();
-	std::lock_guard<std::mutex> lock(readIos_.at(uid)->mut_);
-	//std::cout << __PRETTY_FUNCTION__ << 3 << std::endl;
 	auto readIO = readIos_.find(uid);
 	//std::cout << __PRETTY_FUNCTION__ << 4 << std::endl;
 	if (!readIO->second->out_.outOpen()) {
@@ -170,8 +193,6 @@ void MultiSeqIO::openOut(const std::string & uid){
 	//std::cout << __PRETTY_FUNCTION__ << 13 << std::endl;
 	++openPriorityCounts_[uid];
 	//std::cout << __PRETTY_FUNCTION__ << 14 << std::endl;
-	mut_.unlock();
-	//std::cout << __PRETTY_FUNCTION__ << 15 << std::endl;
 }
 
 
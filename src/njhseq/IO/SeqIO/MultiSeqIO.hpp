@@ -134,6 +134,18 @@ public:
 	 */
 	void openWrite(const std::string & uid, const std::string & line);
 
+	/**@brief Write text already formatted by SeqOutput::formatNoCheck for uid, opening the outputs if needed
+	 *
+	 * Unlike openOut() followed by a write, the writer's lock is taken before the open limit lock is released so another thread can't close the file in between,
+	 * which makes this safe to call from several threads at once
+	 *
+	 * @param uid The uid of the writer
+	 * @param primary The text for the primary file
+	 * @param secondary The text for the secondary file, ignored if empty
+	 */
+	void openWriteFormatted(const std::string & uid, const std::string & primary,
+			const std::string & secondary);
+
 	/**@brief
 	 *
 	 * @param uid Uid of the reader
@@ -155,6 +167,7 @@ public:
 
 	template<typename T>
 	friend class MultiSeqOutCache;
+	friend class MultiSeqOutWriteBehind;
 private:
 	/**@brief Check for the SeqIO and throw an exception if it isn't found
 	 *
@@ -177,6 +190,11 @@ private:
 	 */
 	void closeNext();
 
+	/**@brief Open uid if it isn't open, must hold mut_ and the lock for uid
+	 *
+	 */
+	void openOutLockFree(const std::string & uid);
+
 	std::mutex mut_;/**< mutex to lock the class*/
 
 };
@@ -25,84 +25,79 @@
  *      Author: nick
  */
 
-#include "njhseq/IO/SeqIO/MultiSeqIO.hpp"
-//#include <shared_mutex>
+#include "njhseq/IO/SeqIO/MultiSeqOutWriteBehind.hpp"
 
 namespace njhseq {
 
 /**@brief A class to cache reads rather than writing at once to limit io usage
+ *
+ * Reads are formatted as they are added and written out behind the caller by MultiSeqOutWriteBehind's flusher threads, the cache limit
+ * is the number of reads added between handing every buffer over to the flushers
  *
  */
 template<typename T>
 class MultiSeqOutCache {
 public:
 
+	MultiSeqOutCache() :
+			MultiSeqOutCache(MultiSeqOutWriteBehind::Pars { }) {
+	}
+
+	/**@brief Construct with the settings for the write behind threads
+	 *
+	 * @param writeBehindPars number of flusher threads and memory limits for the formatted reads held
+	 */
+	explicit MultiSeqOutCache(const MultiSeqOutWriteBehind::Pars & writeBehindPars) :
+			writeBehind_(writers_, writeBehindPars) {
+	}
+
 	/**@brief create a reader with the uid and options
 	 *
 	 * @param uid the uid for the reader
 	 * @param opts The options for the reader
 	 */
 	void addReader(const std::string & uid, const SeqIOOptions & opts) {
-		//std::unique_lock<std::shared_timed_mutex> lock(mut_,std::defer_lock);
 		writers_.addReader(uid, opts);
 	}
 
 	/**@brief Add a read to cache for the uid SeqIO
 	 *
 	 * This will add the read to the cache and if it hits the cache limit
-	 * it will write the cache and then clear it
+	 * it will hand the cache off to be written
 	 *
 	 * @param uid the uid of the SeqIO
 	 * @param read the read to add
 	 */
 	void add(const std::string & uid, const T & read) {
-		writers_.containsReaderThrow(uid);
-		//std::unique_lock<std::shared_timed_mutex> lock(mut_,std::defer_lock);
-		cache_[uid].push_back(read);
+		writeBehind_.add(uid, read);
 		++cacheSize_;
-		if (cacheSize_ == cacheLimit_) {
-			writeCache();
+		if (cacheSize_ >= cacheLimit_) {
+			writeBehind_.queueAll();
+			cacheSize_ = 0;
 		}
 	}
 	/**@brief Add a reads to cache for the uid SeqIO
 	 *
 	 * This will add the reads to the cache and if it hits the cache limit
-	 * it will write the cache and then clear it
+	 * it will hand the cache off to be written
 	 *
 	 * @param uid the uid of the SeqIO
 	 * @param reads the reads to add
 	 */
 	void add(const std::string & uid, const std::vector<T> & reads) {
-		writers_.containsReaderThrow(uid);
-		//std::unique_lock<std::shared_timed_mutex> lock(mut_,std::defer_lock);
 		for (const auto & read : reads) {
-			cache_[uid].push_back(read);
-			++cacheSize_;
-			if (cacheSize_ == cacheLimit_) {
-				writeCache();
-			}
+			add(uid, read);
 		}
 	}
-	/**@brief Write cache and then clear it
+	/**@brief Write cache and wait for it to be written
 	 *
 	 */
 	void writeCache() {
-		//std::unique_lock<std::shared_timed_mutex> lock(mut_,std::defer_lock);
 		writeCacheLockFree();
 	}
 
 	void writeCacheLockFree() {
-		for (const auto & reads : cache_) {
-			if(reads.second.empty()){
-				continue;
-			}
-			//std::cout << __PRETTY_FUNCTION__ << std::endl;
-			writers_.openWrite(reads.first, reads.second);
-			//std::cout << __PRETTY_FUNCTION__ << std::endl;
-		}
-		for (auto & reads : cache_) {
-			reads.second.clear();
-		}
+		writeBehind_.flushAll();
 		cacheSize_ = 0;
 	}
 
@@ -110,7 +105,6 @@ public:
 	 *
 	 */
 	void closeOutAll() {
-		//std::unique_lock<std::shared_timed_mutex> lock(mut_,std::defer_lock);
 		writeCache();
 		writers_.closeOutAll();
 	}
@@ -119,7 +113,6 @@ public:
 	 *
 	 */
 	void closeOutForReopeningAll() {
-		//std::unique_lock<std::shared_timed_mutex> lock(mut_,std::defer_lock);
 		writeCache();
 		writers_.closeOutForReopeningAll();
 	}
@@ -129,7 +122,6 @@ public:
 	 * @return the cache limit
 	 */
 	uint32_t getCacheLimit() const {
-		//std::shared_lock<std::shared_timed_mutex> lock(mut_,std::defer_lock);
 		return cacheLimit_;
 	}
 
@@ -138,7 +130,6 @@ public:
 	 * @param cacheLimit Set the new cache limit
 	 */
 	void setCacheLimit(uint32_t cacheLimit) {
-		//std::unique_lock<std::shared_timed_mutex> lock(mut_,std::defer_lock);
 		cacheLimit_ = cacheLimit;
 	}
 
@@ -147,7 +138,6 @@ public:
 	 * @param fileOpenLimit the new file open limit
 	 */
 	void setOpenLimit(uint32_t fileOpenLimit){
-		//std::unique_lock<std::shared_timed_mutex> lock(mut_,std::defer_lock);
 		writers_.setOpenLimit(fileOpenLimit);
 	}
 
@@ -159,23 +149,19 @@ public:
 	}
 
 	void containsReaderThrow(const std::string & uid) const {
-		//std::shared_lock<std::shared_timed_mutex> lock(mut_,std::defer_lock);
 		writers_.containsReaderThrow(uid);
 	}
 
 	bool containsReader(const std::string & uid) const {
-		//std::shared_lock<std::shared_timed_mutex> lock(mut_,std::defer_lock);
 		return writers_.containsReader(uid);
 	}
 
 private:
 
-	std::unordered_map<std::string, std::vector<T>> cache_; /**< The cache of reads*/
 	uint32_t cacheLimit_ = 50000;/**< The cache limit*/
 	uint32_t cacheSize_ = 0;/**< The current cache size*/
-	MultiSeqIO writers_;/**< The MultiSeqIO responsible for writing the cache*/
-
-	//std::shared_timed_mutex mut_; /**< to make thread safe*/
+	MultiSeqIO writers_;/**< The MultiSeqIO responsible for writing the cache, declared before writeBehind_ so it outlives the flushers*/
+	MultiSeqOutWriteBehind writeBehind_;/**< formats and holds the reads and writes them out on its own threads*/
 };
 
 }  // namespace njhseq
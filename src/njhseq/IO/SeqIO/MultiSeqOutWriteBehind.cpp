@@ -0,0 +1,177 @@
+/*
+ * MultiSeqOutWriteBehind.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: nick
+ */
+//
+// njhseq - A library for analyzing sequence data
+// Copyright (C) 2012-2018 Nicholas Hathaway <nicholas.hathaway@umassmed.edu>,
+//
+// This file is part of njhseq.
+//
+// njhseq is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// njhseq is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with njhseq.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include "MultiSeqOutWriteBehind.hpp"
+
+namespace njhseq {
+
+uint64_t MultiSeqOutWriteBehind::Buffer::size() const {
+	return primary_.size() + secondary_.size();
+}
+
+MultiSeqOutWriteBehind::MultiSeqOutWriteBehind(MultiSeqIO & writers,
+		const Pars & pars) :
+		pars_(pars), writers_(writers) {
+	for (uint32_t t = 0; t < std::max<uint32_t>(1, pars_.numThreads_); ++t) {
+		threads_.emplace_back(&MultiSeqOutWriteBehind::flush, this);
+	}
+}
+
+MultiSeqOutWriteBehind::~MultiSeqOutWriteBehind() {
+	{
+		std::lock_guard<std::mutex> lock(mut_);
+		stop_ = true;
+	}
+	cv_.notify_all();
+	njh::concurrent::joinAllJoinableThreads(threads_);
+}
+
+void MultiSeqOutWriteBehind::rethrowErrorLockFree() {
+	if (nullptr != error_) {
+		auto error = error_;
+		error_ = nullptr;
+		std::rethrow_exception(error);
+	}
+}
+
+void MultiSeqOutWriteBehind::queueLockFree(const std::string & uid,
+		Buffer & buffer) {
+	if (!buffer.queued_) {
+		buffer.queued_ = true;
+		queue_.emplace_back(uid);
+	}
+}
+
+void MultiSeqOutWriteBehind::queueAllLockFree() {
+	for (auto & buffer : buffers_) {
+		if (buffer.second.size() > 0) {
+			queueLockFree(buffer.first, buffer.second);
+		}
+	}
+}
+
+void MultiSeqOutWriteBehind::addFormatted(const std::string & uid,
+		const std::string & primary, const std::string & secondary) {
+	const uint64_t amount = primary.size() + secondary.size();
+	std::unique_lock<std::mutex> lock(mut_);
+	rethrowErrorLockFree();
+	if (bufferedBytes_ > 0 && bufferedBytes_ + amount > pars_.maxBufferedBytes_) {
+		//back pressure, get everything written out and wait for room
+		queueAllLockFree();
+		cv_.notify_all();
+		cv_.wait(lock, [this, &amount]() {
+			return nullptr != error_ || 0 == bufferedBytes_
+					|| bufferedBytes_ + amount <= pars_.maxBufferedBytes_;
+		});
+		rethrowErrorLockFree();
+	}
+	auto & buffer = buffers_[uid];
+	buffer.primary_.append(primary);
+	buffer.secondary_.append(secondary);
+	bufferedBytes_ += amount;
+	if (buffer.size() >= pars_.flushBytes_ && !buffer.queued_) {
+		queueLockFree(uid, buffer);
+		lock.unlock();
+		cv_.notify_all();
+	}
+}
+
+void MultiSeqOutWriteBehind::queueAll() {
+	{
+		std::lock_guard<std::mutex> lock(mut_);
+		queueAllLockFree();
+	}
+	cv_.notify_all();
+}
+
+void MultiSeqOutWriteBehind::flushAll() {
+	std::unique_lock<std::mutex> lock(mut_);
+	queueAllLockFree();
+	cv_.notify_all();
+	cv_.wait(lock, [this]() {
+		return nullptr != error_ || (queue_.empty() && 0 == inFlight_);
+	});
+	rethrowErrorLockFree();
+}
+
+uint64_t MultiSeqOutWriteBehind::getBufferedBytes() {
+	std::lock_guard<std::mutex> lock(mut_);
+	return bufferedBytes_;
+}
+
+void MultiSeqOutWriteBehind::flush() {
+	//only one flusher works on a writer at a time so its text stays in the order it was added
+	auto nextRunnable = [this]() {
+		return std::find_if(queue_.begin(), queue_.end(),
+				[this](const std::string & uid) {
+					return !buffers_.at(uid).inFlight_;
+				});
+	};
+	std::string primary;
+	std::string secondary;
+	while (true) {
+		std::string uid;
+		{
+			std::unique_lock<std::mutex> lock(mut_);
+			cv_.wait(lock, [this, &nextRunnable]() {
+				return stop_ || queue_.end() != nextRunnable();
+			});
+			auto next = nextRunnable();
+			if (queue_.end() == next) {
+				//stopping
+				return;
+			}
+			uid = *next;
+			queue_.erase(next);
+			auto & buffer = buffers_.at(uid);
+			buffer.queued_ = false;
+			buffer.inFlight_ = true;
+			++inFlight_;
+			primary.clear();
+			secondary.clear();
+			std::swap(primary, buffer.primary_);
+			std::swap(secondary, buffer.secondary_);
+		}
+		std::exception_ptr error;
+		try {
+			writers_.openWriteFormatted(uid, primary, secondary);
+		} catch (...) {
+			error = std::current_exception();
+		}
+		{
+			std::lock_guard<std::mutex> lock(mut_);
+			if (nullptr != error && nullptr == error_) {
+				error_ = error;
+			}
+			buffers_.at(uid).inFlight_ = false;
+			--inFlight_;
+			bufferedBytes_ -= primary.size() + secondary.size();
+		}
+		cv_.notify_all();
+	}
+}
+
+}  // namespace njhseq
@@ -0,0 +1,129 @@
+#pragma once
+/*
+ * MultiSeqOutWriteBehind.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: nick
+ */
+//
+// njhseq - A library for analyzing sequence data
+// Copyright (C) 2012-2018 Nicholas Hathaway <nicholas.hathaway@umassmed.edu>,
+//
+// This file is part of njhseq.
+//
+// njhseq is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// njhseq is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with njhseq.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include "njhseq/IO/SeqIO/MultiSeqIO.hpp"
+
+namespace njhseq {
+
+/**@brief Write behind buffering for the writers of a MultiSeqIO
+ *
+ * Reads are formatted into a text buffer per writer as they are added, full buffers are handed to a pool of flusher threads that
+ * open the file (keeping to MultiSeqIO's open file limit), compress if needed and append, so the thread adding reads never waits on a file
+ * unless the total amount buffered hits the memory limit
+ *
+ */
+class MultiSeqOutWriteBehind {
+public:
+	struct Pars {
+		uint32_t numThreads_ = 1; /**< number of flusher threads */
+		uint64_t maxBufferedBytes_ = 256UL * 1024UL * 1024UL; /**< total formatted bytes held (buffered and being written) before adding blocks */
+		uint64_t flushBytes_ = 1024UL * 1024UL; /**< a writer's buffer is handed to the flushers once it holds this much */
+	};
+
+	/**@brief Start the flushers
+	 *
+	 * @param writers the writers to write to, readers should be added to it before reads are added here
+	 * @param pars threads and memory limits
+	 */
+	MultiSeqOutWriteBehind(MultiSeqIO & writers, const Pars & pars);
+
+	/**@brief Stops the flushers, anything not flushed with flushAll() is dropped
+	 *
+	 */
+	~MultiSeqOutWriteBehind();
+
+	MultiSeqOutWriteBehind(const MultiSeqOutWriteBehind & other) = delete;
+	MultiSeqOutWriteBehind & operator=(const MultiSeqOutWriteBehind & other) = delete;
+
+	const Pars pars_;
+
+	/**@brief Format read for the writer uid and buffer it
+	 *
+	 * @param uid the uid of the writer
+	 * @param read the read
+	 */
+	template<typename T>
+	void add(const std::string & uid, const T & read) {
+		writers_.containsReaderThrow(uid);
+		std::lock_guard<std::mutex> formatLock(formatMut_);
+		primaryFormat_.str("");
+		secondaryFormat_.str("");
+		writers_.readIos_.at(uid)->out_.formatNoCheck(read, primaryFormat_, secondaryFormat_);
+		addFormatted(uid, primaryFormat_.str(), secondaryFormat_.str());
+	}
+
+	/**@brief Hand every buffer to the flushers without waiting for them to be written
+	 *
+	 */
+	void queueAll();
+
+	/**@brief Write everything buffered and wait until it has been written
+	 *
+	 */
+	void flushAll();
+
+	/**@brief The number of formatted bytes currently held, buffered and being written
+	 *
+	 */
+	uint64_t getBufferedBytes();
+
+private:
+	struct Buffer {
+		std::string primary_;
+		std::string secondary_;
+		bool queued_ { false };
+		bool inFlight_ { false };
+
+		uint64_t size() const;
+	};
+
+	MultiSeqIO & writers_;
+
+	std::mutex formatMut_;
+	std::ostringstream primaryFormat_;
+	std::ostringstream secondaryFormat_;
+
+	std::mutex mut_;
+	std::condition_variable cv_;
+	std::unordered_map<std::string, Buffer> buffers_;
+	std::deque<std::string> queue_; /**< uids with buffers waiting for a flusher */
+	uint64_t bufferedBytes_ { 0 };
+	uint32_t inFlight_ { 0 };
+	bool stop_ { false };
+	std::exception_ptr error_;
+
+	std::vector<std::thread> threads_;
+
+	void addFormatted(const std::string & uid, const std::string & primary,
+			const std::string & secondary);
+	void queueLockFree(const std::string & uid, Buffer & buffer);
+	void queueAllLockFree();
+	void rethrowErrorLockFree();
+	void flush();
+};
+
+}  // namespace njhseq
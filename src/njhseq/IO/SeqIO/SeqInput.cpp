@@ -246,7 +246,7 @@ void SeqInput::setReaderFunc(){
 			break;
 		case SeqIOOptions::inFormats::BAM:
 			readerFunc_ = [this](seqInfo & seq) {
-				return readNextBam(*bReader_, seq, *aln_, ioOptions_.processed_);
+				return readNextBam(*bReader_, seq, *bamRecord_, ioOptions_.processed_);
 			};
 			break;
 		case SeqIOOptions::inFormats::SFFTXT:
@@ -344,10 +344,10 @@ void SeqInput::openInLockFree() {
 		openPrimSec();
 		break;
 	case SeqIOOptions::inFormats::BAM:
-		bReader_ = std::make_unique<BamTools::BamReader>();
-		aln_ = std::make_unique<BamTools::BamAlignment>();
-		bReader_->Open(ioOptions_.firstName_.string());
-		if (!bReader_->IsOpen()) {
+		bamRecord_ = std::make_unique<LazyBamRecord>();
+		try {
+			bReader_ = std::make_unique<ParallelBamReader>(ioOptions_.firstName_, ParallelBamReader::Pars());
+		} catch (const std::exception &) {
 			failedToOpen = true;
 		}
 		break;
@@ -397,9 +397,7 @@ void SeqInput::closeInLockFree() {
 	if(inOpen_){
 		priReader_ = nullptr;
 		secReader_ = nullptr;
-		if (bReader_ && bReader_->IsOpen()) {
-			bReader_->Close();
-		}
+		bReader_ = nullptr;
 		inOpen_ = false;
 		firstTimeReaderFunc_ = [this](seqInfo & seq) {
 			if (!inOpen_) {
@@ -484,11 +482,11 @@ bool SeqInput::readNextRead(PairedRead & seq) {
 	return false;
 }
 
-bool SeqInput::readNextBam(BamTools::BamReader & bReader, seqInfo& read,
-		BamTools::BamAlignment & aln, bool processed) {
-	bool succes = bReader.GetNextAlignment(aln);
+bool SeqInput::readNextBam(ParallelBamReader & bReader, seqInfo& read,
+		LazyBamRecord & record, bool processed) {
+	bool succes = bReader.getNextRecord(record);
 	if (succes) {
-		read = seqInfo(aln.Name, aln.QueryBases, aln.Qualities,
+		read = seqInfo(record.name(), record.queryBases(), record.qualities(),
 				SangerQualOffset);
 	}
 	return succes;
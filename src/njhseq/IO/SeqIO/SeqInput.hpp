@@ -35,6 +35,7 @@
 #include "njhseq/objects/seqObjects/Paired/PairedRead.hpp"
 #include "njhseq/objects/seqObjects/sffObject.hpp"
 #include "njhseq/IO/SeqIO/SeqIOOptions.hpp"
+#include "njhseq/BamToolsUtils/ParallelBamReader.hpp"
 #include "njhseq/readVectorManipulation/readVectorOperations.h"
 
 
@@ -237,8 +238,8 @@ private:
 	std::vector<unsigned long long> secIndex_;
 	bool indexLoad_ = false;
 
-	std::unique_ptr<BamTools::BamReader> bReader_;
-	std::unique_ptr<BamTools::BamAlignment> aln_;
+	std::unique_ptr<ParallelBamReader> bReader_; /**< inflates on a background thread, only the name, bases and qualities are decoded */
+	std::unique_ptr<LazyBamRecord> bamRecord_;
 
 
 	std::unique_ptr<InputStream> priReader_;
@@ -261,8 +262,8 @@ private:
 	bool readNextFastqStream(const VecStr & data, const uint32_t lCount, uint32_t offSet, seqInfo& read,
 			bool processed);
 
-	bool readNextBam(BamTools::BamReader & bReader, seqInfo& read,
-			BamTools::BamAlignment & aln, bool processed);
+	bool readNextBam(ParallelBamReader & bReader, seqInfo& read,
+			LazyBamRecord & record, bool processed);
 
 	VecStr readSffTxtHeader(std::istream & inFile);
 	bool readNextSff(std::istream & inFile, sffObject & read);
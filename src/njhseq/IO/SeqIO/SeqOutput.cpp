@@ -127,19 +127,25 @@ void SeqOutput::write(const seqInfo & read) {
 }
 
 void SeqOutput::writeNoCheck(const seqInfo & seq) {
+	formatNoCheck(seq, *primaryOut_,
+			nullptr == secondaryOut_ ? *primaryOut_ : *secondaryOut_);
+}
+
+void SeqOutput::formatNoCheck(const seqInfo & seq, std::ostream & primary,
+		std::ostream & secondary) const {
 	switch (ioOptions_.outFormat_) {
 	case SeqIOOptions::outFormats::FASTA:
 	case SeqIOOptions::outFormats::FASTAGZ:
 
-		seq.outPutSeq(*primaryOut_);
+		seq.outPutSeq(primary);
 		break;
 	case SeqIOOptions::outFormats::FASTQ:
 	case SeqIOOptions::outFormats::FASTQGZ:
-		seq.outPutFastq(*primaryOut_);
+		seq.outPutFastq(primary);
 		break;
 	case SeqIOOptions::outFormats::FASTAQUAL:
-		seq.outPutSeq(*primaryOut_);
-		seq.outPutQual(*secondaryOut_);
+		seq.outPutSeq(primary);
+		seq.outPutQual(secondary);
 		break;
 	default:
 		throw std::runtime_error { njh::bashCT::boldRed(
@@ -149,6 +155,22 @@ void SeqOutput::writeNoCheck(const seqInfo & seq) {
 	}
 }
 
+void SeqOutput::openWriteFormatted(const std::string & primary,
+		const std::string & secondary) {
+	if (!outOpen_) {
+		openOut();
+	}
+	primaryOut_->write(primary.data(), primary.size());
+	if (!secondary.empty()) {
+		if (nullptr == secondaryOut_) {
+			std::stringstream ss;
+			ss << __PRETTY_FUNCTION__ << ", error " << "given text for a secondary file but " << ioOptions_.out_.outName() << " doesn't have one" << "\n";
+			throw std::runtime_error { ss.str() };
+		}
+		secondaryOut_->write(secondary.data(), secondary.size());
+	}
+}
+
 void SeqOutput::openWrite(const seqInfo & read) {
 	if (!outOpen_) {
 		openOut();
@@ -157,13 +179,19 @@ void SeqOutput::openWrite(const seqInfo & read) {
 }
 
 void SeqOutput::writeNoCheck(const PairedRead & seq) {
+	formatNoCheck(seq, *primaryOut_,
+			nullptr == secondaryOut_ ? *primaryOut_ : *secondaryOut_);
+}
+
+void SeqOutput::formatNoCheck(const PairedRead & seq, std::ostream & primary,
+		std::ostream & secondary) const {
 	if (SeqIOOptions::outFormats::FASTQPAIRED == ioOptions_.outFormat_ || SeqIOOptions::outFormats::FASTQPAIREDGZ == ioOptions_.outFormat_) {
-		seq.seqBase_.outPutFastq(*primaryOut_);
+		seq.seqBase_.outPutFastq(primary);
 		seqInfo mateInfo = seq.mateSeqBase_;
 		if(seq.mateRComplemented_){
 			mateInfo.reverseComplementRead(false, true);
 		}
-		mateInfo.outPutFastq(*secondaryOut_);
+		mateInfo.outPutFastq(secondary);
 	} else {
 		throw std::runtime_error {
 				"Error in " + std::string(__PRETTY_FUNCTION__)
@@ -123,6 +123,37 @@ public:
 		}
 	}
 
+	/**@brief Format seq exactly as writeNoCheck would write it but into the given streams, so the formatting can be done away from the files
+	 *
+	 * @param seq the seq to format
+	 * @param primary the text for the primary file
+	 * @param secondary the text for the secondary file (the qual file or the second mate), untouched for single file formats
+	 */
+	template<typename T>
+	void formatNoCheck(const T & seq, std::ostream & primary, std::ostream & secondary) const {
+		formatNoCheck(seq.seqBase_, primary, secondary);
+	}
+
+	template<typename T>
+	void formatNoCheck(const std::unique_ptr<T> & seq, std::ostream & primary, std::ostream & secondary) const {
+		formatNoCheck(*seq, primary, secondary);
+	}
+
+	template<typename T>
+	void formatNoCheck(const std::shared_ptr<T> & seq, std::ostream & primary, std::ostream & secondary) const {
+		formatNoCheck(*seq, primary, secondary);
+	}
+
+	void formatNoCheck(const seqInfo & seq, std::ostream & primary, std::ostream & secondary) const;
+	void formatNoCheck(const PairedRead & seq, std::ostream & primary, std::ostream & secondary) const;
+
+	/**@brief Write text already formatted by formatNoCheck, opening the files if needed
+	 *
+	 * @param primary text for the primary file
+	 * @param secondary text for the secondary file, ignored if empty
+	 */
+	void openWriteFormatted(const std::string & primary, const std::string & secondary);
+
 	template<typename T>
 	static void write(const std::vector<T> & reads, const SeqIOOptions & opts){
 		SeqOutput writer(opts);
@@ -20,6 +20,7 @@
 
 #include "ManipulateTableRunner.hpp"
 #include "njhseq/objects/dataContainers/tables/table.hpp"
+#include "njhseq/objects/dataContainers/tables/ColumnarTable.hpp"
 #include "njhseq/objects/dataContainers/tables/TableReader.hpp"
 
 #include "njhseq/objects/Meta/MetaDataInName.hpp"
@@ -55,6 +56,7 @@ ManipulateTableRunner::ManipulateTableRunner() :
 					addFunc("splitColumnContainingMeta",splitColumnContainingMeta, false),
 					addFunc("roughHistogramOfColumn",roughHistogramOfColumn, false),
 					addFunc("removeColumns",removeColumns, false),
+					addFunc("joinTables",joinTables, false),
 				}, "ManipulateTable", "1") {
 }
 //
@@ -74,7 +76,7 @@ int ManipulateTableRunner::splitColumnContainingMeta(
 	setUp.processNonRquiredDefaults();
 	bool sorting = setUp.processSorting();
 	setUp.finishSetUp(std::cout);
-	table inTab(setUp.ioOptions_);
+	table inTab(setUp.ioOptions_, setUp.numThreads_);
 	inTab.checkForColumnsThrow({column}, __PRETTY_FUNCTION__);
 	std::set<std::string> metaFields;
 	std::unordered_map<std::string, VecStr> metaValues;
@@ -83,7 +85,7 @@ int ManipulateTableRunner::splitColumnContainingMeta(
 	for (const auto & row : inTab.content_) {
 		if(MetaDataInName::nameHasMetaData(row[inTab.getColPos(column)])){
 			MetaDataInName rowMeta(row[inTab.getColPos(column)]);
-			auto metas = getVectorOfMapKeys(rowMeta.meta_);
+			auto metas = rowMeta.getMetaKeys();
 			std::copy(metas.begin(), metas.end(),
 					std::inserter(metaFields, metaFields.end()));
 			noneContainMeta = false;
@@ -94,11 +96,11 @@ int ManipulateTableRunner::splitColumnContainingMeta(
 		for (auto & row : inTab.content_) {
 			if(MetaDataInName::nameHasMetaData(row[inTab.getColPos(column)])){
 				MetaDataInName rowMeta(row[inTab.getColPos(column)]);
-				for(const auto & m : rowMeta.meta_){
+				for(const auto & m : rowMeta.toMap()){
 					metaValues[m.first].emplace_back(m.second);
 				}
 				for(const auto & metaField : metaFields){
-					if(!njh::in(metaField, rowMeta.meta_)){
+					if(!rowMeta.containsMeta(metaField)){
 						metaValues[metaField].emplace_back("NA");
 					}
 				}
@@ -228,7 +230,7 @@ int ManipulateTableRunner::tableExtractCriteria(
 	setUp.setOption(lessThan, "--lessThan",
 			"Take numbers less than value in cutOff flag");
 	setUp.finishSetUp(std::cout);
-	table inTab(setUp.ioOptions_);
+	table inTab(setUp.ioOptions_, setUp.numThreads_);
 	table outTab;
 	if (lessThan) {
 		auto compLess = [cutOff](const std::string & str) {
@@ -255,7 +257,7 @@ int ManipulateTableRunner::removeColumns(
 	setUp.processDefaultProgram(true);
 	setUp.setOption(columns, "--columns","Columns to remove", true);
 	setUp.finishSetUp(std::cout);
-	table outTab(setUp.ioOptions_);
+	table outTab(setUp.ioOptions_, setUp.numThreads_);
 
 	outTab.checkForColumnsThrow(columns, __PRETTY_FUNCTION__);
 	for(const auto & col : columns){
@@ -265,6 +267,70 @@ int ManipulateTableRunner::removeColumns(
 	return 0;
 }
 
+int ManipulateTableRunner::joinTables(
+		const njh::progutils::CmdArgs & inputCommands) {
+	ManipulateTableSetUp setUp(inputCommands);
+	bfs::path otherFnp = "";
+	std::string columns = "";
+	std::string otherColumns = "";
+	std::string joinTypeStr = "inner";
+	std::string fill = "NA";
+	setUp.description_ = "Join two tables on matching values in columns";
+	setUp.examples_.emplace_back("MASTERPROGRAM SUBPROGRAM --file info.tsv --otherFile meta.tsv --columns sample --joinType left --delim tab --header --out joined.tsv #add meta data to every row of info.tsv");
+	setUp.processDefaultProgram(true);
+	setUp.setOption(otherFnp, "--otherFile", "The table to join with, read with the same delimiter and header settings as --file", true);
+	setUp.setOption(columns, "--columns", "Columns to join on, comma separated", true);
+	setUp.setOption(otherColumns, "--otherColumns", "Columns in --otherFile to join on if named differently, comma separated, defaults to --columns");
+	setUp.setOption(joinTypeStr, "--joinType", "Join type, inner (only matching rows), left (all rows of --file) or outer (all rows of both)");
+	setUp.setOption(fill, "--fill", "Value for the columns of unmatched rows");
+	setUp.processStreamingOptions();
+	setUp.finishSetUp(std::cout);
+
+	auto joinType = table::strToJoinType(joinTypeStr);
+	auto byColumns = tokenizeString(columns, ",");
+	auto otherByColumns = "" == otherColumns ? byColumns : tokenizeString(otherColumns, ",");
+	TableIOOpts otherOpts = setUp.ioOptions_;
+	otherOpts.in_.inFilename_ = otherFnp;
+
+	if (setUp.streaming_ || ColumnarTable::inputIsLarge(setUp.ioOptions_)
+			|| ColumnarTable::inputIsLarge(otherOpts)) {
+		//the joined rows are written out as they're made so there's no table to sort
+		if ("" != setUp.sortByColumn_) {
+			std::stringstream ss;
+			ss << __PRETTY_FUNCTION__ << ", error "
+					<< "--sortByColumn can't be used when streaming the join (--streaming or a large --file/--otherFile), sort the joined output afterwards"
+					<< "\n";
+			throw std::runtime_error { ss.str() };
+		}
+		TableJoiner::Pars joinPars;
+		joinPars.type_ = joinType;
+		joinPars.fill_ = fill;
+		joinPars.memoryBudget_ = setUp.streamingPars_.memoryBudget_;
+		joinPars.tmpDir_ = setUp.streamingPars_.tmpDir_;
+		TableJoiner joiner(setUp.ioOptions_, otherOpts, byColumns, otherByColumns, joinPars);
+		std::string outDelim = setUp.ioOptions_.outDelim_;
+		if ("tab" == outDelim) {
+			outDelim = "\t";
+		} else if ("whitespace" == outDelim) {
+			outDelim = " ";
+		}
+		if ("" == setUp.ioOptions_.out_.outFilename_) {
+			joiner.join(std::cout, outDelim, true);
+		} else {
+			OutputStream out(setUp.ioOptions_.out_);
+			joiner.join(out, outDelim, true);
+		}
+		return 0;
+	}
+	table inTab(setUp.ioOptions_, setUp.numThreads_);
+	table otherTab(otherOpts, setUp.numThreads_);
+	auto outTab = inTab.join(otherTab, byColumns, otherByColumns, joinType, fill);
+	if (setUp.sortByColumn_ != "") {
+		outTab.sortTable(setUp.sortByColumn_, setUp.decending_);
+	}
+	outTab.outPutContents(setUp.ioOptions_);
+	return 0;
+}
 
 int ManipulateTableRunner::addColumn(
 		const njh::progutils::CmdArgs & inputCommands) {
@@ -276,7 +342,7 @@ int ManipulateTableRunner::addColumn(
 	setUp.setOption(columnName, "--newColumnName","Name of the new Column to add to table", true);
 	setUp.setOption(elementStr, "--element","What to Add to the Table Under Column, can be several comma sep values or just one",true);
 	setUp.finishSetUp(std::cout);
-	table outTab(setUp.ioOptions_);
+	table outTab(setUp.ioOptions_, setUp.numThreads_);
 	auto toks = tokenizeString(elementStr, ",");
 	auto colToks = tokenizeString(columnName, ",");
 	if(colToks.size() > 1){
@@ -332,7 +398,7 @@ int ManipulateTableRunner::roughHistogramOfColumn(
 	}
 	setUp.finishSetUp(std::cout);
 
-	table inTab(setUp.ioOptions_);
+	table inTab(setUp.ioOptions_, setUp.numThreads_);
 	auto colPos = inTab.getColPos(columnName);
 
 	std::vector<double> columnValues;
@@ -404,9 +470,19 @@ int ManipulateTableRunner::countColumn(
 	setUp.processDefaultProgram(true);
 	std::string columnName = "";
 	setUp.setOption(columnName, "--columnName", "columnName", true);
+	setUp.processStreamingOptions();
 	setUp.finishSetUp(std::cout);
 	auto toks = tokenizeString(columnName, ",");
-	table inTab(setUp.ioOptions_);
+	if (setUp.streaming_ || ColumnarTable::inputIsLarge(setUp.ioOptions_)) {
+		StreamingTableAggregator aggregator(setUp.ioOptions_, setUp.streamingPars_);
+		auto ret = aggregator.countColumns(toks);
+		if (setUp.sortByColumn_ != "") {
+			ret.sortTable(setUp.sortByColumn_, setUp.decending_);
+		}
+		ret.outPutContents(setUp.ioOptions_);
+		return 0;
+	}
+	table inTab(setUp.ioOptions_, setUp.numThreads_);
 	if (toks.size() == 1) {
 		auto counts = inTab.countColumn(columnName);
 		table ret(counts, { "element", "count" });
@@ -429,7 +505,7 @@ int ManipulateTableRunner::catOrganized(
 		const njh::progutils::CmdArgs & inputCommands) {
 	ManipulateTableSetUp setUp(inputCommands);
 	setUp.setUpCatOrganized();
-	table inTab(setUp.ioOptions_);
+	table inTab(setUp.ioOptions_, setUp.numThreads_);
 	inTab.outPutContents(setUp.ioOptions_);
 	return 0;
 }
@@ -438,7 +514,7 @@ int ManipulateTableRunner::changeDelim(
 		const njh::progutils::CmdArgs & inputCommands) {
 	ManipulateTableSetUp setUp(inputCommands);
 	setUp.setUpChangeDelim();
-	table inTab(setUp.ioOptions_);
+	table inTab(setUp.ioOptions_, setUp.numThreads_);
 	inTab.outPutContents(setUp.ioOptions_);
 	return 0;
 }
@@ -447,7 +523,14 @@ int ManipulateTableRunner::sortTable(
 		const njh::progutils::CmdArgs & inputCommands) {
 	ManipulateTableSetUp setUp(inputCommands);
 	setUp.setUpSortTable();
-	table inTab(setUp.ioOptions_);
+	if (ColumnarTable::inputIsLarge(setUp.ioOptions_)) {
+		//large inputs are sorted column wise so values are only parsed once
+		ColumnarTable inTab(setUp.ioOptions_, setUp.numThreads_);
+		inTab.sortTable(setUp.sortByColumn_, setUp.decending_);
+		inTab.outPutContents(setUp.ioOptions_);
+		return 0;
+	}
+	table inTab(setUp.ioOptions_, setUp.numThreads_);
 	inTab.sortTable(setUp.sortByColumn_, setUp.decending_);
 	inTab.outPutContents(setUp.ioOptions_);
 	return 0;
@@ -472,7 +555,19 @@ int ManipulateTableRunner::tableExtractColumns(const njh::progutils::CmdArgs & i
 
   auto extractColumns = getInputValues(columns, ",");
 
-	table inTab(setUp.ioOptions_);
+	if (ColumnarTable::inputIsLarge(setUp.ioOptions_)) {
+		ColumnarTable outTab = ColumnarTable(setUp.ioOptions_, setUp.numThreads_).getColumns(extractColumns);
+		if (setUp.sortByColumn_ != "") {
+			outTab.sortTable(setUp.sortByColumn_, setUp.decending_);
+		}
+		if (getUniqueRows) {
+			outTab = outTab.getUniqueRows();
+		}
+		outTab.outPutContents(setUp.ioOptions_);
+		return 0;
+	}
+
+	table inTab(setUp.ioOptions_, setUp.numThreads_);
 	table outTab = inTab.getColumns(extractColumns);
 
 	if (setUp.sortByColumn_ != "") {
@@ -508,7 +603,7 @@ int ManipulateTableRunner::tableExtractElementsWithPattern(
 
 	setUp.finishSetUp(std::cout);
 
-	table inTab(setUp.ioOptions_);
+	table inTab(setUp.ioOptions_, setUp.numThreads_);
 	table outTab;
 	if (opposite) {
 		outTab = inTab.getRowsNotContainingPattern(column, std::regex { patStr });
@@ -539,7 +634,7 @@ int ManipulateTableRunner::tableExtractElementsStartingWith(const njh::progutils
 	setUp.setOption(getUniqueRows, "--getUniqueRows", "GetUniqueRows");
 	setUp.finishSetUp(std::cout);
 
-	table inTab(setUp.ioOptions_);
+	table inTab(setUp.ioOptions_, setUp.numThreads_);
 	table outTab = inTab.getRowsMatchingPattern(column, std::regex{"^" + patStr});
 
 	if (setUp.sortByColumn_ != "") {
@@ -564,7 +659,7 @@ int ManipulateTableRunner::tableExtractColumnsStartsWith(const njh::progutils::C
 	setUp.setOption(getUniqueRows, "--getUniqueRows", "GetUniqueRows");
 	setUp.finishSetUp(std::cout);
 
-	table inTab(setUp.ioOptions_);
+	table inTab(setUp.ioOptions_, setUp.numThreads_);
 	table outTab = inTab.getColumnsMatchingPattern(std::regex{patStr});
 
 	if (setUp.sortByColumn_ != "") {
@@ -589,7 +684,7 @@ int ManipulateTableRunner::tableExtractColumnsWithPattern(const njh::progutils::
 	setUp.setOption(getUniqueRows, "--getUniqueRows", "GetUniqueRows");
 	setUp.finishSetUp(std::cout);
 
-	table inTab(setUp.ioOptions_);
+	table inTab(setUp.ioOptions_, setUp.numThreads_);
 	table outTab = inTab.getColumnsMatchingPattern(std::regex{"^" + patStr});
 
 	if (setUp.sortByColumn_ != "") {
@@ -608,7 +703,7 @@ int ManipulateTableRunner::trimContent(
 	ManipulateTableSetUp setUp(inputCommands);
 	std::string trimAt = "";
 	setUp.setUpTrimContent(trimAt);
-	table inTab(setUp.ioOptions_);
+	table inTab(setUp.ioOptions_, setUp.numThreads_);
 	inTab.trimElementsAtFirstOccurenceOf(trimAt);
 	if (setUp.sortByColumn_ != "") {
 		inTab.sortTable(setUp.sortByColumn_, setUp.decending_);
@@ -621,7 +716,7 @@ int ManipulateTableRunner::getStats(
 	ManipulateTableSetUp setUp(inputCommands);
 	std::string trimAt = "(";
 	setUp.setUpGetStats(trimAt);
-	table inTab(setUp.ioOptions_);
+	table inTab(setUp.ioOptions_, setUp.numThreads_);
 	inTab.trimElementsAtFirstOccurenceOf(trimAt);
 	table outTable = inTab.getStatsTable();
 	if (setUp.sortByColumn_ != "") {
@@ -655,7 +750,6 @@ int ManipulateTableRunner::splitTable(
 		}
 		writer.add(colVal, njh::conToStr(line, tabReader.tabOpts_.outDelim_));
 	}
-	table inTab(setUp.ioOptions_);
 	return 0;
 }
 
@@ -668,7 +762,15 @@ int ManipulateTableRunner::aggregateTable(
 	bool advance = false;
 	setUp.setUpAggregateTable(functionName, advance, columnName);
 
-	table inTab(setUp.ioOptions_);
+	if (StreamingTableAggregator::isAggregateFunction(functionName)
+			&& (setUp.streaming_ || ColumnarTable::inputIsLarge(setUp.ioOptions_))) {
+		StreamingTableAggregator aggregator(setUp.ioOptions_, setUp.streamingPars_);
+		table outTable = aggregator.aggregate(columnName, functionName, advance);
+		outTable.outPutContents(setUp.ioOptions_);
+		return 0;
+	}
+
+	table inTab(setUp.ioOptions_, setUp.numThreads_);
 
 	if (advance) {
 		table outTable = inTab.aggregateAdvance(columnName, functionName);
@@ -686,7 +788,13 @@ int ManipulateTableRunner::pivotTable(
 	std::string column = "";
 	std::string matchColumn = "";
 	setUp.setUpPivotTable(column, matchColumn);
-	table inTab(setUp.ioOptions_);
+	if (setUp.streaming_ || ColumnarTable::inputIsLarge(setUp.ioOptions_)) {
+		StreamingTableAggregator aggregator(setUp.ioOptions_, setUp.streamingPars_);
+		auto ans = aggregator.pivot(column, matchColumn);
+		ans.outPutContents(setUp.ioOptions_);
+		return 0;
+	}
+	table inTab(setUp.ioOptions_, setUp.numThreads_);
 
 	// split the table on the column
 	auto tables = inTab.splitTableOnColumn(column);
@@ -855,7 +963,7 @@ int ManipulateTableRunner::cBind(
 					<< fileIter->second.first << std::endl;
 		}
 	}
-	table inTab(setUp.ioOptions_);
+	table inTab(setUp.ioOptions_, setUp.numThreads_);
 	table mainTable;
 	uint32_t count = 0;
 	for (const auto &file : allFiles) {
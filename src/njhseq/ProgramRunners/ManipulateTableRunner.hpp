@@ -36,6 +36,7 @@ class ManipulateTableRunner : public njh::progutils::ProgramRunner {
 
   static int addColumn(const njh::progutils::CmdArgs & inputCommands);
   static int removeColumns(const njh::progutils::CmdArgs & inputCommands);
+  static int joinTables(const njh::progutils::CmdArgs & inputCommands);
   static int changeDelim(const njh::progutils::CmdArgs & inputCommands);
   static int sortTable(const njh::progutils::CmdArgs & inputCommands);
 
@@ -279,6 +279,7 @@ void ManipulateTableSetUp::setUpAggregateTable(std::string &functionName,
   setOption(columnName, "-colName,-columnName,-column", "ColumnName", true);
   setOption(functionName, "-function,-functionName", "StatFunction");
   setOption(advance, "-advance", "AdvacnedAgrregation");
+  processStreamingOptions();
   finishSetUp(std::cout);
 }
 void ManipulateTableSetUp::setUpPivotTable(std::string &columnName,
@@ -303,6 +304,7 @@ void ManipulateTableSetUp::setUpPivotTable(std::string &columnName,
   processDefaultProgram();
   setOption(columnName, "-colName,-columnName,-column", "ColumnName", true);
   setOption(matchColumn, "-matchColumn,-columnMatch", "Matchcolumn", true);
+  processStreamingOptions();
   finishSetUp(std::cout);
 }
 
@@ -312,12 +314,21 @@ bool ManipulateTableSetUp::processFileName(bool required) {
   return setOption(ioOptions_.in_.inFilename_, "--file", "Input FileName", required);
 }
 
+void ManipulateTableSetUp::processStreamingOptions() {
+	setOption(streaming_, "--streaming", "Stream through the file rather than reading it all in, defaults to on for files over 100MB");
+	uint64_t memoryBudgetMb = streamingPars_.memoryBudget_ / (1024 * 1024);
+	setOption(memoryBudgetMb, "--memoryBudget", "When streaming, approximate megabytes of group data to hold in memory before spilling to disk");
+	streamingPars_.memoryBudget_ = memoryBudgetMb * 1024 * 1024;
+	setOption(streamingPars_.tmpDir_, "--tmpDir", "When streaming, the directory to spill to");
+}
+
 void ManipulateTableSetUp::processNonRquiredDefaults() {
 	setOption(ioOptions_.hasHeader_, "--header", "HeaderPresent");
 	if(ioOptions_.hasHeader_){
 		addHeader_ = true;
 	}
 	setOption(ioOptions_.inDelim_, "--delim", "FileDelimiter");
+	setOption(numThreads_, "--numThreads", "Number of threads to use when reading in the table");
 	if(!addHeader_){
 		setOption(addHeader_, "--addHeader", "If input doesn't have a header add a header to the output, will default to col.[COL_NUM]");
 	}
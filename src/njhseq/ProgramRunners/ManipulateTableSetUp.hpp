@@ -25,6 +25,7 @@
 //
 
 #include "njhseq/objects/dataContainers/tables/TableIOOpts.hpp"
+#include "njhseq/objects/dataContainers/tables/StreamingTableAggregator.hpp"
 #include <njhcpp/progutils.h>
 
 namespace njhseq {
@@ -44,6 +45,9 @@ class ManipulateTableSetUp : public njh::progutils::ProgramSetUp {
   bool addHeader_ = false;
   bool verbose_ = false;
   bool debug_ = false;
+  bool streaming_ = false;
+  uint32_t numThreads_ = 1;
+  StreamingTableAggregator::Pars streamingPars_;
 
 	void initializeDefaults();
 
@@ -77,6 +81,7 @@ class ManipulateTableSetUp : public njh::progutils::ProgramSetUp {
   void processNonRquiredDefaults();
   bool processSorting(bool required = false);
   void processWriteOutOptions();
+  void processStreamingOptions();
   bool processDefaultProgram(bool fileRequired = true);
   void processDirectoryOutputName(const std::string &defaultName,
                                   bool mustMakeDirectory);
@@ -27,4 +27,5 @@
 #include "njhseq/alignment/alnCache.h"
 #include "njhseq/alignment/aligner.h"
 #include "njhseq/alignment/stripedSmithWaterman.h"
+#include "njhseq/alignment/multipleAlignment.h"
 
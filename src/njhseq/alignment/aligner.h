@@ -27,6 +27,7 @@
 
 
 #include "njhseq/alignment/aligner/alnParts.hpp"
+#include "njhseq/alignment/aligner/AlignmentOps.hpp"
 #include "njhseq/alignment/aligner/aligner.hpp"
 #include "njhseq/alignment/aligner/alignCalc.hpp"
 
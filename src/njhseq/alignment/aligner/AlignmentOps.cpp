@@ -0,0 +1,323 @@
+/*
+ * AlignmentOps.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: nick
+ */
+// njhseq - A library for analyzing sequence data
+// Copyright (C) 2012-2018 Nicholas Hathaway <nicholas.hathaway@umassmed.edu>,
+//
+// This file is part of njhseq.
+//
+// njhseq is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// njhseq is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with njhseq.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "AlignmentOps.hpp"
+
+namespace njhseq {
+
+bool AlignmentOps::Op::consumesA() const {
+	return OpType::INSERTION != type_;
+}
+
+bool AlignmentOps::Op::consumesB() const {
+	return OpType::DELETION != type_;
+}
+
+uint32_t AlignmentOps::Op::alnEnd() const {
+	return alnPos_ + length_;
+}
+
+void AlignmentOps::clear() {
+	ops_.clear();
+	aStart_ = 0;
+	aEnd_ = 0;
+	bStart_ = 0;
+	bEnd_ = 0;
+	alnLength_ = 0;
+}
+
+void AlignmentOps::addRun(OpType type, uint32_t length, uint32_t aPos,
+		uint32_t bPos) {
+	if (0 == length) {
+		return;
+	}
+	if (!ops_.empty() && type == ops_.back().type_) {
+		ops_.back().length_ += length;
+	} else {
+		ops_.emplace_back(Op { type, length, aPos, bPos, alnLength_ });
+	}
+	alnLength_ += length;
+}
+
+void AlignmentOps::addAlignedRun(const std::string & seqA,
+		const std::string & seqB, uint32_t aPos, uint32_t bPos, uint32_t length,
+		const substituteMatrix & scoring) {
+	for (uint32_t pos = 0; pos < length; ++pos) {
+		addRun(0 > scoring.mat_[seqA[aPos + pos]][seqB[bPos + pos]] ?
+						OpType::MISMATCH : OpType::MATCH, 1, aPos + pos, bPos + pos);
+	}
+}
+
+void AlignmentOps::setFromGapInfos(const std::string & seqA,
+		const std::string & seqB, const std::vector<gapInfo> & gapInfos,
+		const substituteMatrix & scoring) {
+	ops_.clear();
+	alnLength_ = 0;
+	aGaps_.clear();
+	bGaps_.clear();
+	//gap positions are into the ungapped sequences, so sorting them gives the order they're hit walking the alignment
+	for (const auto & g : gapInfos) {
+		if (g.gapInA_) {
+			aGaps_.emplace_back(g.pos_, g.size_);
+		} else {
+			bGaps_.emplace_back(g.pos_, g.size_);
+		}
+	}
+	auto byPos = [](const std::pair<uint32_t, uint32_t> & p1,
+			const std::pair<uint32_t, uint32_t> & p2) {
+		return p1.first < p2.first;
+	};
+	std::stable_sort(aGaps_.begin(), aGaps_.end(), byPos);
+	std::stable_sort(bGaps_.begin(), bGaps_.end(), byPos);
+	auto throwBadGaps = [this](uint32_t aPos, uint32_t bPos) {
+		std::stringstream ss;
+		ss << __PRETTY_FUNCTION__ << ", error " << "gap info doesn't fit the sequences, stuck at A position "
+				<< aPos << " of [" << aStart_ << "," << aEnd_ << ") and B position "
+				<< bPos << " of [" << bStart_ << "," << bEnd_ << ")" << "\n";
+		throw std::runtime_error { ss.str() };
+	};
+	uint32_t aPos = aStart_;
+	uint32_t bPos = bStart_;
+	auto aGap = aGaps_.begin();
+	auto bGap = bGaps_.begin();
+	while (true) {
+		if (aGaps_.end() != aGap && aGap->first == aPos) {
+			addRun(OpType::INSERTION, aGap->second, aPos, bPos);
+			bPos += aGap->second;
+			++aGap;
+			continue;
+		}
+		if (bGaps_.end() != bGap && bGap->first == bPos) {
+			addRun(OpType::DELETION, bGap->second, aPos, bPos);
+			aPos += bGap->second;
+			++bGap;
+			continue;
+		}
+		if (aPos >= aEnd_ && bPos >= bEnd_) {
+			break;
+		}
+		if (aPos > aEnd_ || bPos > bEnd_
+				|| (aGaps_.end() != aGap && aGap->first < aPos)
+				|| (bGaps_.end() != bGap && bGap->first < bPos)) {
+			throwBadGaps(aPos, bPos);
+		}
+		uint32_t runLength = std::min(aEnd_ - aPos, bEnd_ - bPos);
+		if (aGaps_.end() != aGap) {
+			runLength = std::min(runLength, aGap->first - aPos);
+		}
+		if (bGaps_.end() != bGap) {
+			runLength = std::min(runLength, bGap->first - bPos);
+		}
+		if (0 == runLength) {
+			throwBadGaps(aPos, bPos);
+		}
+		addAlignedRun(seqA, seqB, aPos, bPos, runLength, scoring);
+		aPos += runLength;
+		bPos += runLength;
+	}
+	if (aPos != aEnd_ || bPos != bEnd_ || aGaps_.end() != aGap
+			|| bGaps_.end() != bGap) {
+		throwBadGaps(aPos, bPos);
+	}
+}
+
+void AlignmentOps::setGlobal(const std::string & seqA, const std::string & seqB,
+		const alnInfoGlobal & gHolder, const substituteMatrix & scoring) {
+	aStart_ = 0;
+	aEnd_ = seqA.size();
+	bStart_ = 0;
+	bEnd_ = seqB.size();
+	setFromGapInfos(seqA, seqB, gHolder.gapInfos_, scoring);
+}
+
+void AlignmentOps::setLocal(const std::string & seqA, const std::string & seqB,
+		const alnInfoLocal & lHolder, const substituteMatrix & scoring) {
+	aStart_ = lHolder.localAStart_;
+	aEnd_ = lHolder.localAStart_ + lHolder.localASize_;
+	bStart_ = lHolder.localBStart_;
+	bEnd_ = lHolder.localBStart_ + lHolder.localBSize_;
+	if (aEnd_ > seqA.size() || bEnd_ > seqB.size()) {
+		std::stringstream ss;
+		ss << __PRETTY_FUNCTION__ << ", error " << "local alignment region A ["
+				<< aStart_ << "," << aEnd_ << ") B [" << bStart_ << "," << bEnd_
+				<< ") is past the end of the sequences, A size: " << seqA.size()
+				<< ", B size: " << seqB.size() << "\n";
+		throw std::runtime_error { ss.str() };
+	}
+	setFromGapInfos(seqA, seqB, lHolder.gapInfos_, scoring);
+}
+
+void AlignmentOps::setFromGapped(const std::string & gappedA,
+		const std::string & gappedB, const substituteMatrix & scoring,
+		char gapChar) {
+	if (gappedA.size() != gappedB.size()) {
+		std::stringstream ss;
+		ss << __PRETTY_FUNCTION__ << ", error "
+				<< "gapped sequences should be the same length, A size: "
+				<< gappedA.size() << ", B size: " << gappedB.size() << "\n";
+		throw std::runtime_error { ss.str() };
+	}
+	ops_.clear();
+	alnLength_ = 0;
+	aStart_ = 0;
+	bStart_ = 0;
+	uint32_t aPos = 0;
+	uint32_t bPos = 0;
+	for (uint32_t col = 0; col < gappedA.size(); ++col) {
+		if (gapChar == gappedA[col]) {
+			addRun(OpType::INSERTION, 1, aPos, bPos);
+			++bPos;
+		} else if (gapChar == gappedB[col]) {
+			addRun(OpType::DELETION, 1, aPos, bPos);
+			++aPos;
+		} else {
+			addRun(0 > scoring.mat_[gappedA[col]][gappedB[col]] ?
+							OpType::MISMATCH : OpType::MATCH, 1, aPos, bPos);
+			++aPos;
+			++bPos;
+		}
+	}
+	aEnd_ = aPos;
+	bEnd_ = bPos;
+}
+
+uint32_t AlignmentOps::getOpIndexForAlnPos(uint32_t alnPos) const {
+	if (alnPos >= alnLength_) {
+		std::stringstream ss;
+		ss << __PRETTY_FUNCTION__ << ", error " << "alnPos " << alnPos
+				<< " is greater than or equal to the alignment length "
+				<< alnLength_ << "\n";
+		throw std::runtime_error { ss.str() };
+	}
+	auto op = std::upper_bound(ops_.begin(), ops_.end(), alnPos,
+			[](uint32_t pos, const Op & other) {
+				return pos < other.alnPos_;
+			});
+	return std::distance(ops_.begin(), op) - 1;
+}
+
+uint32_t AlignmentOps::getSeqAPosForAlnPos(uint32_t alnPos) const {
+	const auto & op = ops_[getOpIndexForAlnPos(alnPos)];
+	return op.aPos_ - aStart_ + (op.consumesA() ? alnPos - op.alnPos_ : 0);
+}
+
+uint32_t AlignmentOps::getSeqBPosForAlnPos(uint32_t alnPos) const {
+	const auto & op = ops_[getOpIndexForAlnPos(alnPos)];
+	return op.bPos_ - bStart_ + (op.consumesB() ? alnPos - op.alnPos_ : 0);
+}
+
+uint32_t AlignmentOps::getAlnPosForSeqAPos(uint32_t seqAPos) const {
+	const uint32_t aPos = aStart_ + seqAPos;
+	for (const auto & op : ops_) {
+		if (op.consumesA() && aPos >= op.aPos_ && aPos < op.aPos_ + op.length_) {
+			return op.alnPos_ + aPos - op.aPos_;
+		}
+	}
+	std::stringstream ss;
+	ss << __PRETTY_FUNCTION__ << ", error " << "seqAPos " << seqAPos
+			<< " is greater than or equal to the number of bases of A in the alignment, "
+			<< aEnd_ - aStart_ << "\n";
+	throw std::runtime_error { ss.str() };
+}
+
+uint32_t AlignmentOps::getAlnPosForSeqBPos(uint32_t seqBPos) const {
+	const uint32_t bPos = bStart_ + seqBPos;
+	for (const auto & op : ops_) {
+		if (op.consumesB() && bPos >= op.bPos_ && bPos < op.bPos_ + op.length_) {
+			return op.alnPos_ + bPos - op.bPos_;
+		}
+	}
+	std::stringstream ss;
+	ss << __PRETTY_FUNCTION__ << ", error " << "seqBPos " << seqBPos
+			<< " is greater than or equal to the number of bases of B in the alignment, "
+			<< bEnd_ - bStart_ << "\n";
+	throw std::runtime_error { ss.str() };
+}
+
+uint32_t AlignmentOps::countEndGaps(bool gapsInA) const {
+	if (ops_.empty()) {
+		return 0;
+	}
+	const OpType gapType = gapsInA ? OpType::INSERTION : OpType::DELETION;
+	uint32_t ret = 0;
+	if (gapType == ops_.front().type_) {
+		ret += ops_.front().length_;
+	}
+	//a single run of gaps is counted from both ends the same as countBeginChar() + countEndChar() would
+	if (gapType == ops_.back().type_) {
+		ret += ops_.back().length_;
+	}
+	return ret;
+}
+
+std::string AlignmentOps::toCigar(bool extended) const {
+	std::string ret;
+	uint32_t pendingMatch = 0;
+	for (const auto & op : ops_) {
+		if (!extended
+				&& (OpType::MATCH == op.type_ || OpType::MISMATCH == op.type_)) {
+			pendingMatch += op.length_;
+			continue;
+		}
+		if (0 != pendingMatch) {
+			ret.append(estd::to_string(pendingMatch));
+			ret.push_back('M');
+			pendingMatch = 0;
+		}
+		ret.append(estd::to_string(op.length_));
+		switch (op.type_) {
+		case OpType::MATCH:
+			ret.push_back('=');
+			break;
+		case OpType::MISMATCH:
+			ret.push_back('X');
+			break;
+		case OpType::INSERTION:
+			ret.push_back('I');
+			break;
+		case OpType::DELETION:
+			ret.push_back('D');
+			break;
+		}
+	}
+	if (0 != pendingMatch) {
+		ret.append(estd::to_string(pendingMatch));
+		ret.push_back('M');
+	}
+	return ret;
+}
+
+Json::Value AlignmentOps::toJson() const {
+	Json::Value ret;
+	ret["class"] = "njhseq::AlignmentOps";
+	ret["aStart_"] = njh::json::toJson(aStart_);
+	ret["aEnd_"] = njh::json::toJson(aEnd_);
+	ret["bStart_"] = njh::json::toJson(bStart_);
+	ret["bEnd_"] = njh::json::toJson(bEnd_);
+	ret["alnLength_"] = njh::json::toJson(alnLength_);
+	ret["cigar"] = njh::json::toJson(toCigar());
+	return ret;
+}
+
+}  // namespace njhseq
@@ -0,0 +1,225 @@
+#pragma once
+/*
+ * AlignmentOps.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: nick
+ */
+// njhseq - A library for analyzing sequence data
+// Copyright (C) 2012-2018 Nicholas Hathaway <nicholas.hathaway@umassmed.edu>,
+//
+// This file is part of njhseq.
+//
+// njhseq is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// njhseq is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with njhseq.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "njhseq/alignment/alignerUtils/substituteMatrix.hpp"
+#include "njhseq/alignment/alnCache/alnInfoGlobal.hpp"
+#include "njhseq/alignment/alnCache/alnInfoLocal.hpp"
+
+namespace njhseq {
+
+/**@brief An alignment of sequence A (normally the reference) to sequence B (normally the query) stored as runs of operations
+ *
+ * Each run holds where it starts in A, in B and in the alignment so the alignment can be walked without building the gapped
+ * sequences, positions into A and B are into the whole sequences, for a local alignment they start at the start of the aligned region
+ *
+ */
+class AlignmentOps {
+public:
+
+	enum class OpType : uint8_t {
+		MATCH, /**< aligned bases that don't score below 0 */
+		MISMATCH, /**< aligned bases that score below 0 */
+		INSERTION, /**< bases in B with a gap in A */
+		DELETION /**< bases in A with a gap in B */
+	};
+
+	struct Op {
+		OpType type_;
+		uint32_t length_; /**< number of alignment columns in the run */
+		uint32_t aPos_; /**< position in A of the run, for an INSERTION the position of the A base after the gap */
+		uint32_t bPos_; /**< position in B of the run, for a DELETION the position of the B base after the gap */
+		uint32_t alnPos_; /**< alignment column the run starts at */
+
+		bool consumesA() const;
+		bool consumesB() const;
+		uint32_t alnEnd() const;
+	};
+
+	std::vector<Op> ops_;
+	uint32_t aStart_ { 0 }; /**< first position in A that is in the alignment */
+	uint32_t aEnd_ { 0 }; /**< one past the last position in A that is in the alignment */
+	uint32_t bStart_ { 0 };
+	uint32_t bEnd_ { 0 };
+	uint32_t alnLength_ { 0 }; /**< number of alignment columns */
+
+	void clear();
+
+	/**@brief Set from a global alignment's gap info
+	 *
+	 * @param seqA the first sequence aligned
+	 * @param seqB the second sequence aligned
+	 * @param gHolder the gap info of the alignment
+	 * @param scoring the scoring used to call aligned bases a match or mismatch
+	 */
+	void setGlobal(const std::string & seqA, const std::string & seqB,
+			const alnInfoGlobal & gHolder, const substituteMatrix & scoring);
+
+	/**@brief Set from a local alignment's gap info
+	 *
+	 * @param seqA the first sequence aligned
+	 * @param seqB the second sequence aligned
+	 * @param lHolder the gap info and aligned region of the alignment
+	 * @param scoring the scoring used to call aligned bases a match or mismatch
+	 */
+	void setLocal(const std::string & seqA, const std::string & seqB,
+			const alnInfoLocal & lHolder, const substituteMatrix & scoring);
+
+	/**@brief Set from an already gapped pair of sequences, a column with a gap in A is an INSERTION even if B has a gap there as well
+	 *
+	 * Positions are then into the sequences with the gapped columns of each taken out, see removeGaps()
+	 *
+	 * @param gappedA the gapped A
+	 * @param gappedB the gapped B, same length as gappedA
+	 * @param scoring the scoring used to call aligned bases a match or mismatch
+	 * @param gapChar the gap character
+	 */
+	void setFromGapped(const std::string & gappedA, const std::string & gappedB,
+			const substituteMatrix & scoring, char gapChar = '-');
+
+	/**@brief Get the index of the op covering the alignment column alnPos
+	 *
+	 */
+	uint32_t getOpIndexForAlnPos(uint32_t alnPos) const;
+
+	/**@brief The number of bases of A in the alignment before column alnPos, the same as getRealPosForAlnPos() on the gapped A
+	 *
+	 */
+	uint32_t getSeqAPosForAlnPos(uint32_t alnPos) const;
+	/**@brief The number of bases of B in the alignment before column alnPos, the same as getRealPosForAlnPos() on the gapped B
+	 *
+	 */
+	uint32_t getSeqBPosForAlnPos(uint32_t alnPos) const;
+
+	/**@brief The alignment column of the seqAPos base of A in the alignment (counted from aStart_), the same as getAlnPosForRealPos() on the gapped A
+	 *
+	 */
+	uint32_t getAlnPosForSeqAPos(uint32_t seqAPos) const;
+	/**@brief The alignment column of the seqBPos base of B in the alignment (counted from bStart_), the same as getAlnPosForRealPos() on the gapped B
+	 *
+	 */
+	uint32_t getAlnPosForSeqBPos(uint32_t seqBPos) const;
+
+	/**@brief The number of gap columns at the front and back of the alignment in A (gapsInA true) or B
+	 *
+	 */
+	uint32_t countEndGaps(bool gapsInA) const;
+
+	/**@brief The element of A at alignment column alnPos, gapped A if it's a gap
+	 *
+	 */
+	template<typename T>
+	typename T::value_type getAlnA(const T & seqA, uint32_t alnPos,
+			const typename T::value_type gapped) const {
+		const auto & op = ops_[getOpIndexForAlnPos(alnPos)];
+		if (!op.consumesA()) {
+			return gapped;
+		}
+		return seqA[op.aPos_ + alnPos - op.alnPos_];
+	}
+
+	/**@brief The element of B at alignment column alnPos, gapped if it's a gap
+	 *
+	 */
+	template<typename T>
+	typename T::value_type getAlnB(const T & seqB, uint32_t alnPos,
+			const typename T::value_type gapped) const {
+		const auto & op = ops_[getOpIndexForAlnPos(alnPos)];
+		if (!op.consumesB()) {
+			return gapped;
+		}
+		return seqB[op.bPos_ + alnPos - op.alnPos_];
+	}
+
+	/**@brief Build the gapped A and B, the same as alignCalc::rearrangeGlobal/rearrangeLocal would give
+	 *
+	 * @param seqA the A the alignment was set with
+	 * @param seqB the B the alignment was set with
+	 * @param gappedA filled with the gapped A
+	 * @param gappedB filled with the gapped B
+	 * @param fill the element to put in the gaps
+	 */
+	template<typename T>
+	void buildGapped(const T & seqA, const T & seqB, T & gappedA, T & gappedB,
+			const typename T::value_type fill) const {
+		gappedA.clear();
+		gappedB.clear();
+		gappedA.reserve(alnLength_);
+		gappedB.reserve(alnLength_);
+		for (const auto & op : ops_) {
+			if (op.consumesA()) {
+				gappedA.insert(gappedA.end(), seqA.begin() + op.aPos_,
+						seqA.begin() + op.aPos_ + op.length_);
+			} else {
+				gappedA.insert(gappedA.end(), op.length_, fill);
+			}
+			if (op.consumesB()) {
+				gappedB.insert(gappedB.end(), seqB.begin() + op.bPos_,
+						seqB.begin() + op.bPos_ + op.length_);
+			} else {
+				gappedB.insert(gappedB.end(), op.length_, fill);
+			}
+		}
+	}
+
+	/**@brief Take the gapped columns out of gapped A and B the way setFromGapped() counts them, gives the sequences its positions are into
+	 *
+	 */
+	template<typename T>
+	void removeGaps(const T & gappedA, const T & gappedB, T & seqA,
+			T & seqB) const {
+		seqA.clear();
+		seqB.clear();
+		for (const auto & op : ops_) {
+			if (op.consumesA()) {
+				seqA.insert(seqA.end(), gappedA.begin() + op.alnPos_,
+						gappedA.begin() + op.alnEnd());
+			}
+			if (op.consumesB()) {
+				seqB.insert(seqB.end(), gappedB.begin() + op.alnPos_,
+						gappedB.begin() + op.alnEnd());
+			}
+		}
+	}
+
+	/**@brief A CIGAR string with A as the reference, extended uses = and X for matches and mismatches rather than M
+	 *
+	 */
+	std::string toCigar(bool extended = true) const;
+
+	Json::Value toJson() const;
+
+private:
+	std::vector<std::pair<uint32_t, uint32_t>> aGaps_; /**< reused while setting, pos and size of the gaps in A */
+	std::vector<std::pair<uint32_t, uint32_t>> bGaps_;
+
+	void addRun(OpType type, uint32_t length, uint32_t aPos, uint32_t bPos);
+	void addAlignedRun(const std::string & seqA, const std::string & seqB,
+			uint32_t aPos, uint32_t bPos, uint32_t length,
+			const substituteMatrix & scoring);
+	void setFromGapInfos(const std::string & seqA, const std::string & seqB,
+			const std::vector<gapInfo> & gapInfos, const substituteMatrix & scoring);
+};
+
+}  // namespace njhseq
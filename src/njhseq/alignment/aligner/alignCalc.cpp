@@ -31,8 +31,9 @@
 
 namespace njhseq {
 
-void alignCalc::runSmithSave(const std::string& objA, const std::string& objB,
-                         alnParts& parts) {
+template<typename SCORER>
+void alignCalc::runSmithSaveImpl(const std::string& objA, const std::string& objB,
+                         alnParts& parts, const SCORER & scorer) {
   // std::cout << "doing smith reg" << std::endl;
   // std::cout<<"mark smith non simple"<<std::endl;
   /*if (currentSetUp_ != "smith") {
@@ -116,7 +117,7 @@ void alignCalc::runSmithSave(const std::string& objA, const std::string& objB,
       parts.ScoreMatrix_[i][j].leftInheritPtr = ptrFlag;
       // int match = scoringArray[objA.seqBase_.seq_[i -
       // 1]-'A'][objB.seqBase_.seq_[j - 1]-'A'];
-      int match = parts.scoring_.mat_[objA[i - 1]][objB[j - 1]];
+      int match = scorer(i - 1, j - 1);
       parts.ScoreMatrix_[i][j].diagInherit =
           match + smithMaximum(parts.ScoreMatrix_[i - 1][j - 1].upInherit,
                                parts.ScoreMatrix_[i - 1][j - 1].leftInherit,
@@ -229,8 +230,9 @@ void alignCalc::runSmithSave(const std::string& objA, const std::string& objB,
 
 
 
-void alignCalc::runNeedleSave(const std::string& objA, const std::string& objB,
-                          alnParts& parts) {
+template<typename SCORER>
+void alignCalc::runNeedleSaveImpl(const std::string& objA, const std::string& objB,
+                          alnParts& parts, const SCORER & scorer) {
   parts.gHolder_.gapInfos_.clear();
   parts.gHolder_.addFromFile_ = false;
   // Create the alignment score matrix to do the alignment, a column for each
@@ -300,7 +302,7 @@ void alignCalc::runNeedleSave(const std::string& objA, const std::string& objB,
         parts.gapScores_.gapOpen_;
     parts.ScoreMatrix_[i][j].leftInheritPtr = 'U';
     //diag
-    int32_t match = parts.scoring_.mat_[objA[i - 1]][objB[j - 1]];
+    int32_t match = scorer(i - 1, j - 1);
     parts.ScoreMatrix_[i][j].diagInherit = parts.ScoreMatrix_[i - 1][j - 1].leftInherit + match;
     parts.ScoreMatrix_[i][j].diagInheritPtr = 'L';
   }
@@ -326,7 +328,7 @@ void alignCalc::runNeedleSave(const std::string& objA, const std::string& objB,
       parts.ScoreMatrix_[i][j].leftInheritPtr = ptrFlag;
 
       //diag inherit will also have to be from the left
-			int32_t match = parts.scoring_.mat_[objA[i - 1]][objB[j - 1]];
+			int32_t match = scorer(i - 1, j - 1);
       parts.ScoreMatrix_[i][j].diagInherit =
           parts.ScoreMatrix_[i - 1][j - 1].leftInherit + match;
       parts.ScoreMatrix_[i][j].diagInheritPtr = 'L';
@@ -354,7 +356,7 @@ void alignCalc::runNeedleSave(const std::string& objA, const std::string& objB,
           parts.gapScores_.gapOpen_;
       parts.ScoreMatrix_[i][j].leftInheritPtr = 'U';
       //diag inherit is always coming from up
-      int32_t match = parts.scoring_.mat_[objA[i - 1]][objB[j - 1]];
+      int32_t match = scorer(i - 1, j - 1);
       parts.ScoreMatrix_[i][j].diagInherit = parts.ScoreMatrix_[i - 1][j - 1].upInherit + match;
       parts.ScoreMatrix_[i][j].diagInheritPtr = 'U';
     }
@@ -380,7 +382,7 @@ void alignCalc::runNeedleSave(const std::string& objA, const std::string& objB,
                       ptrFlag);
     parts.ScoreMatrix_[i][j].leftInheritPtr = ptrFlag;
     //diag inherit will also have to be from the left
-		int32_t match = parts.scoring_.mat_[objA[i - 1]][objB[j - 1]];
+		int32_t match = scorer(i - 1, j - 1);
     parts.ScoreMatrix_[i][j].diagInherit =
         parts.ScoreMatrix_[i - 1][j - 1].leftInherit + match;
     parts.ScoreMatrix_[i][j].diagInheritPtr = 'L';
@@ -406,7 +408,7 @@ void alignCalc::runNeedleSave(const std::string& objA, const std::string& objB,
         parts.gapScores_.gapRightRefOpen_;
     parts.ScoreMatrix_[i][j].leftInheritPtr = 'U';
     //diag inherit is always coming from up
-    int32_t match = parts.scoring_.mat_[objA[i - 1]][objB[j - 1]];
+    int32_t match = scorer(i - 1, j - 1);
     parts.ScoreMatrix_[i][j].diagInherit = parts.ScoreMatrix_[i - 1][j - 1].upInherit + match;
     parts.ScoreMatrix_[i][j].diagInheritPtr = 'U';
   }
@@ -449,7 +451,7 @@ void alignCalc::runNeedleSave(const std::string& objA, const std::string& objB,
                         ptrFlag);
       parts.ScoreMatrix_[i][j].leftInheritPtr = ptrFlag;
       //diag, match or mismatch
-      int32_t match = parts.scoring_.mat_[objA[i - 1]][objB[j - 1]];
+      int32_t match = scorer(i - 1, j - 1);
       parts.ScoreMatrix_[i][j].diagInherit =
           match +
           needleMaximum(parts.ScoreMatrix_[i - 1][j - 1].upInherit,
@@ -486,7 +488,7 @@ void alignCalc::runNeedleSave(const std::string& objA, const std::string& objB,
                         ptrFlag);
       parts.ScoreMatrix_[i][j].leftInheritPtr = ptrFlag;
     	//normal diag
-      int32_t match = parts.scoring_.mat_[objA[i - 1]][objB[j - 1]];
+      int32_t match = scorer(i - 1, j - 1);
       parts.ScoreMatrix_[i][j].diagInherit =
           match +
           needleMaximum(parts.ScoreMatrix_[i - 1][j - 1].upInherit,
@@ -523,7 +525,7 @@ void alignCalc::runNeedleSave(const std::string& objA, const std::string& objB,
                         ptrFlag);
       parts.ScoreMatrix_[i][j].leftInheritPtr = ptrFlag;
     	//normal diag
-      int32_t match = parts.scoring_.mat_[objA[i - 1]][objB[j - 1]];
+      int32_t match = scorer(i - 1, j - 1);
       parts.ScoreMatrix_[i][j].diagInherit =
           match +
           needleMaximum(parts.ScoreMatrix_[i - 1][j - 1].upInherit,
@@ -560,7 +562,7 @@ void alignCalc::runNeedleSave(const std::string& objA, const std::string& objB,
                       ptrFlag);
     parts.ScoreMatrix_[i][j].leftInheritPtr = ptrFlag;
   	//normal diag
-    int32_t match = parts.scoring_.mat_[objA[i - 1]][objB[j - 1]];
+    int32_t match = scorer(i - 1, j - 1);
     parts.ScoreMatrix_[i][j].diagInherit =
         match +
         needleMaximum(parts.ScoreMatrix_[i - 1][j - 1].upInherit,
@@ -640,8 +642,9 @@ void alignCalc::runNeedleSave(const std::string& objA, const std::string& objB,
 
 
 
-void alignCalc::runNeedleOnlyEndGapsSave(const std::string& objA, const std::string& objB,
-                          alnParts& parts) {
+template<typename SCORER>
+void alignCalc::runNeedleOnlyEndGapsSaveImpl(const std::string& objA, const std::string& objB,
+                          alnParts& parts, const SCORER & scorer) {
 	//std::cout << __PRETTY_FUNCTION__ << " " << __LINE__ <<  std::endl;
 
   parts.gHolder_.gapInfos_.clear();
@@ -702,7 +705,7 @@ void alignCalc::runNeedleOnlyEndGapsSave(const std::string& objA, const std::str
   	const uint32_t i = 1;
   	const uint32_t j = 1;
     //diag
-    int32_t match = parts.scoring_.mat_[objA[i - 1]][objB[j - 1]];
+    int32_t match = scorer(i - 1, j - 1);
     parts.ScoreMatrix_[i][j].diagInherit = parts.ScoreMatrix_[i - 1][j - 1].leftInherit + match;
     parts.ScoreMatrix_[i][j].diagInheritPtr = 'L';
   }
@@ -711,7 +714,7 @@ void alignCalc::runNeedleOnlyEndGapsSave(const std::string& objA, const std::str
     const uint32_t i = 1;
 		for (uint32_t j = 2; j < lenb - 1; ++j) {
       //diag inherit will also have to be from the left
-			int32_t match = parts.scoring_.mat_[objA[i - 1]][objB[j - 1]];
+			int32_t match = scorer(i - 1, j - 1);
       parts.ScoreMatrix_[i][j].diagInherit =
           parts.ScoreMatrix_[i - 1][j - 1].leftInherit + match;
       parts.ScoreMatrix_[i][j].diagInheritPtr = 'L';
@@ -723,7 +726,7 @@ void alignCalc::runNeedleOnlyEndGapsSave(const std::string& objA, const std::str
 		const uint32_t j = 1;
     for (uint32_t i = 2; i < lena - 1 ; ++i) {
       //diag inherit is always coming from up
-      int32_t match = parts.scoring_.mat_[objA[i - 1]][objB[j - 1]];
+      int32_t match = scorer(i - 1, j - 1);
       parts.ScoreMatrix_[i][j].diagInherit = parts.ScoreMatrix_[i - 1][j - 1].upInherit + match;
       parts.ScoreMatrix_[i][j].diagInheritPtr = 'U';
     }
@@ -735,7 +738,7 @@ void alignCalc::runNeedleOnlyEndGapsSave(const std::string& objA, const std::str
   	const uint32_t j = lenb - 1;
   	const uint32_t i = 1;
     //diag inherit will also have to be from the left
-		int32_t match = parts.scoring_.mat_[objA[i - 1]][objB[j - 1]];
+		int32_t match = scorer(i - 1, j - 1);
     parts.ScoreMatrix_[i][j].diagInherit =
         parts.ScoreMatrix_[i - 1][j - 1].leftInherit + match;
     parts.ScoreMatrix_[i][j].diagInheritPtr = 'L';
@@ -758,7 +761,7 @@ void alignCalc::runNeedleOnlyEndGapsSave(const std::string& objA, const std::str
         parts.gapScores_.gapRightRefOpen_;
     parts.ScoreMatrix_[i][j].leftInheritPtr = 'U';
     //diag inherit is always coming from up
-    int32_t match = parts.scoring_.mat_[objA[i - 1]][objB[j - 1]];
+    int32_t match = scorer(i - 1, j - 1);
     parts.ScoreMatrix_[i][j].diagInherit = parts.ScoreMatrix_[i - 1][j - 1].upInherit + match;
     parts.ScoreMatrix_[i][j].diagInheritPtr = 'U';
   }
@@ -767,7 +770,7 @@ void alignCalc::runNeedleOnlyEndGapsSave(const std::string& objA, const std::str
     for (uint32_t j = 2; j < lenb - 1 ; ++j) {
     	//char ptrFlag;
       //diag, match or mismatch
-      int32_t match = parts.scoring_.mat_[objA[i - 1]][objB[j - 1]];
+      int32_t match = scorer(i - 1, j - 1);
       parts.ScoreMatrix_[i][j].diagInherit =  match + parts.ScoreMatrix_[i - 1][j - 1].diagInherit;
       parts.ScoreMatrix_[i][j].diagInheritPtr = 'D';
     }
@@ -795,7 +798,7 @@ void alignCalc::runNeedleOnlyEndGapsSave(const std::string& objA, const std::str
 			}
 			parts.ScoreMatrix_[i][j].leftInheritPtr = ptrFlag;
     	//normal diag
-      int32_t match = parts.scoring_.mat_[objA[i - 1]][objB[j - 1]];
+      int32_t match = scorer(i - 1, j - 1);
       parts.ScoreMatrix_[i][j].diagInherit = match + parts.ScoreMatrix_[i - 1][j - 1].diagInherit;
       parts.ScoreMatrix_[i][j].diagInheritPtr = 'D';
     }
@@ -822,7 +825,7 @@ void alignCalc::runNeedleOnlyEndGapsSave(const std::string& objA, const std::str
       parts.ScoreMatrix_[i][j].upInheritPtr = ptrFlag;
 
     	//normal diag
-      int32_t match = parts.scoring_.mat_[objA[i - 1]][objB[j - 1]];
+      int32_t match = scorer(i - 1, j - 1);
       parts.ScoreMatrix_[i][j].diagInherit =
           match + parts.ScoreMatrix_[i - 1][j - 1].diagInherit;
       parts.ScoreMatrix_[i][j].diagInheritPtr = 'D';
@@ -868,7 +871,7 @@ void alignCalc::runNeedleOnlyEndGapsSave(const std::string& objA, const std::str
 		}
 		parts.ScoreMatrix_[i][j].leftInheritPtr = ptrFlag;
 		//normal diag
-		int32_t match = parts.scoring_.mat_[objA[i - 1]][objB[j - 1]];
+		int32_t match = scorer(i - 1, j - 1);
 		parts.ScoreMatrix_[i][j].diagInherit = match
 				+ parts.ScoreMatrix_[i - 1][j - 1].diagInherit;
 		parts.ScoreMatrix_[i][j].diagInheritPtr = 'D';
@@ -939,6 +942,27 @@ void alignCalc::runNeedleOnlyEndGapsSave(const std::string& objA, const std::str
 }
 
 
+void alignCalc::runNeedleSave(const std::string& objA, const std::string& objB,
+                          alnParts& parts) {
+	runWithScorer(objA, objB, parts, [&objA, &objB, &parts](const auto & scorer) {
+		runNeedleSaveImpl(objA, objB, parts, scorer);
+	});
+}
+
+void alignCalc::runNeedleOnlyEndGapsSave(const std::string& objA, const std::string& objB,
+                          alnParts& parts) {
+	runWithScorer(objA, objB, parts, [&objA, &objB, &parts](const auto & scorer) {
+		runNeedleOnlyEndGapsSaveImpl(objA, objB, parts, scorer);
+	});
+}
+
+void alignCalc::runSmithSave(const std::string& objA, const std::string& objB,
+                         alnParts& parts) {
+	runWithScorer(objA, objB, parts, [&objA, &objB, &parts](const auto & scorer) {
+		runSmithSaveImpl(objA, objB, parts, scorer);
+	});
+}
+
 alignCalc::MatCursor alignCalc::runNeedleDiagonalSaveInit(
 									const std::string& objA,
 									const std::string& objB,
@@ -1066,7 +1090,7 @@ alignCalc::MatCursor alignCalc::runNeedleDiagonalSaveInit(
                         ptrFlag);
       parts.ScoreMatrix_[i][j].leftInheritPtr = ptrFlag;
       //diag, match or mismatch
-      int32_t match = parts.scoring_.mat_[objA[i - 1]][objB[j - 1]];
+      int32_t match = parts.getScoring().mat_[objA[i - 1]][objB[j - 1]];
       parts.ScoreMatrix_[i][j].diagInherit =
           match +
           needleMaximum(parts.ScoreMatrix_[i - 1][j - 1].upInherit,
@@ -1106,7 +1130,7 @@ alignCalc::MatCursor alignCalc::runNeedleDiagonalSaveInit(
                         ptrFlag);
       parts.ScoreMatrix_[i][j].leftInheritPtr = ptrFlag;
       	//normal diag
-      int32_t match = parts.scoring_.mat_[objA[i - 1]][objB[j - 1]];
+      int32_t match = parts.getScoring().mat_[objA[i - 1]][objB[j - 1]];
       parts.ScoreMatrix_[i][j].diagInherit =
           match +
           needleMaximum(parts.ScoreMatrix_[i - 1][j - 1].upInherit,
@@ -1144,7 +1168,7 @@ alignCalc::MatCursor alignCalc::runNeedleDiagonalSaveInit(
                         ptrFlag);
       parts.ScoreMatrix_[i][j].leftInheritPtr = ptrFlag;
       //normal diag
-      int32_t match = parts.scoring_.mat_[objA[i - 1]][objB[j - 1]];
+      int32_t match = parts.getScoring().mat_[objA[i - 1]][objB[j - 1]];
       parts.ScoreMatrix_[i][j].diagInherit =
           match +
           needleMaximum(parts.ScoreMatrix_[i - 1][j - 1].upInherit,
@@ -1183,7 +1207,7 @@ alignCalc::MatCursor alignCalc::runNeedleDiagonalSaveInit(
                       ptrFlag);
     parts.ScoreMatrix_[i][j].leftInheritPtr = ptrFlag;
   		//normal diag
-    int32_t match = parts.scoring_.mat_[objA[i - 1]][objB[j - 1]];
+    int32_t match = parts.getScoring().mat_[objA[i - 1]][objB[j - 1]];
     parts.ScoreMatrix_[i][j].diagInherit =
         match +
         needleMaximum(parts.ScoreMatrix_[i - 1][j - 1].upInherit,
@@ -1216,7 +1240,7 @@ alignCalc::MatCursor alignCalc::runNeedleDiagonalSaveInit(
                       ptrFlag);
     parts.ScoreMatrix_[i][j].leftInheritPtr = ptrFlag;
   		//normal diag
-    int32_t match = parts.scoring_.mat_[objA[i - 1]][objB[j - 1]];
+    int32_t match = parts.getScoring().mat_[objA[i - 1]][objB[j - 1]];
     parts.ScoreMatrix_[i][j].diagInherit =
         match +
         needleMaximum(parts.ScoreMatrix_[i - 1][j - 1].upInherit,
@@ -1249,7 +1273,7 @@ alignCalc::MatCursor alignCalc::runNeedleDiagonalSaveInit(
 											ptrFlag);
 		parts.ScoreMatrix_[i][j].leftInheritPtr = ptrFlag;
   		//normal diag
-    int32_t match = parts.scoring_.mat_[objA[i - 1]][objB[j - 1]];
+    int32_t match = parts.getScoring().mat_[objA[i - 1]][objB[j - 1]];
     parts.ScoreMatrix_[i][j].diagInherit =
         match +
         needleMaximum(parts.ScoreMatrix_[i - 1][j - 1].upInherit,
@@ -1430,7 +1454,7 @@ alignCalc::MatCursor alignCalc::runNeedleDiagonalSaveStep(
           parts.ScoreMatrix_[i][j].diagInheritPtr = '\0';
   			}else{
     			//regular diag inherit
-    			int32_t match = parts.scoring_.mat_[objA[i - 1]][objB[j - 1]];
+    			int32_t match = parts.getScoring().mat_[objA[i - 1]][objB[j - 1]];
           parts.ScoreMatrix_[i][j].diagInherit =
               match +
               needleMaximum(parts.ScoreMatrix_[i - 1][j - 1].upInherit,
@@ -1497,7 +1521,7 @@ alignCalc::MatCursor alignCalc::runNeedleDiagonalSaveStep(
     		    parts.ScoreMatrix_[i][j].diagInherit = std::numeric_limits<int32_t>::lowest()/2;
     			}else{
       			//regular diag inherit
-      			int32_t match = parts.scoring_.mat_[objA[i - 1]][objB[j - 1]];
+      			int32_t match = parts.getScoring().mat_[objA[i - 1]][objB[j - 1]];
   					parts.ScoreMatrix_[i][j].diagInherit =
   							match +
   							needleMaximum(parts.ScoreMatrix_[i - 1][j - 1].upInherit,
@@ -1580,7 +1604,7 @@ alignCalc::MatCursor alignCalc::runNeedleDiagonalSaveStep(
                         ptrFlag);
       parts.ScoreMatrix_[i][j].leftInheritPtr = ptrFlag;
       //diag, match or mismatch
-      int32_t match = parts.scoring_.mat_[objA[i - 1]][objB[j - 1]];
+      int32_t match = parts.getScoring().mat_[objA[i - 1]][objB[j - 1]];
       parts.ScoreMatrix_[i][j].diagInherit =
           match +
           needleMaximum(parts.ScoreMatrix_[i - 1][j - 1].upInherit,
@@ -1630,7 +1654,7 @@ alignCalc::MatCursor alignCalc::runNeedleDiagonalSaveStep(
                         ptrFlag);
       parts.ScoreMatrix_[i][j].leftInheritPtr = ptrFlag;
       //diag, match or mismatch
-      int32_t match = parts.scoring_.mat_[objA[i - 1]][objB[j - 1]];
+      int32_t match = parts.getScoring().mat_[objA[i - 1]][objB[j - 1]];
       parts.ScoreMatrix_[i][j].diagInherit =
           match +
           needleMaximum(parts.ScoreMatrix_[i - 1][j - 1].upInherit,
@@ -1680,7 +1704,7 @@ alignCalc::MatCursor alignCalc::runNeedleDiagonalSaveStep(
                         ptrFlag);
       parts.ScoreMatrix_[i][j].leftInheritPtr = ptrFlag;
       //diag, match or mismatch
-      int32_t match = parts.scoring_.mat_[objA[i - 1]][objB[j - 1]];
+      int32_t match = parts.getScoring().mat_[objA[i - 1]][objB[j - 1]];
       parts.ScoreMatrix_[i][j].diagInherit =
           match +
           needleMaximum(parts.ScoreMatrix_[i - 1][j - 1].upInherit,
@@ -1721,7 +1745,7 @@ alignCalc::MatCursor alignCalc::runNeedleDiagonalSaveStep(
 				//just one down from last time, so normal diagonal
 				char ptrFlag;
 				//normal diag
-				int32_t match = parts.scoring_.mat_[objA[i - 1]][objB[j - 1]];
+				int32_t match = parts.getScoring().mat_[objA[i - 1]][objB[j - 1]];
 				parts.ScoreMatrix_[i][j].diagInherit = match
 						+ needleMaximum(parts.ScoreMatrix_[i - 1][j - 1].upInherit,
 								parts.ScoreMatrix_[i - 1][j - 1].leftInherit,
@@ -1763,7 +1787,7 @@ alignCalc::MatCursor alignCalc::runNeedleDiagonalSaveStep(
                         ptrFlag);
       parts.ScoreMatrix_[i][j].leftInheritPtr = ptrFlag;
      	// normal diag
-      int32_t match = parts.scoring_.mat_[objA[i - 1]][objB[j - 1]];
+      int32_t match = parts.getScoring().mat_[objA[i - 1]][objB[j - 1]];
       parts.ScoreMatrix_[i][j].diagInherit =
           match +
           needleMaximum(parts.ScoreMatrix_[i - 1][j - 1].upInherit,
@@ -1818,7 +1842,7 @@ alignCalc::MatCursor alignCalc::runNeedleDiagonalSaveStep(
 				//just one over from last time, so normal diagonal
 				char ptrFlag;
 				//normal diag
-				int32_t match = parts.scoring_.mat_[objA[i - 1]][objB[j - 1]];
+				int32_t match = parts.getScoring().mat_[objA[i - 1]][objB[j - 1]];
 				parts.ScoreMatrix_[i][j].diagInherit =
 						match +
 						needleMaximum(parts.ScoreMatrix_[i - 1][j - 1].upInherit,
@@ -1860,7 +1884,7 @@ alignCalc::MatCursor alignCalc::runNeedleDiagonalSaveStep(
                         ptrFlag);
       parts.ScoreMatrix_[i][j].leftInheritPtr = ptrFlag;
       	//normal diag
-      int32_t match = parts.scoring_.mat_[objA[i - 1]][objB[j - 1]];
+      int32_t match = parts.getScoring().mat_[objA[i - 1]][objB[j - 1]];
       parts.ScoreMatrix_[i][j].diagInherit =
           match +
           needleMaximum(parts.ScoreMatrix_[i - 1][j - 1].upInherit,
@@ -1900,7 +1924,7 @@ alignCalc::MatCursor alignCalc::runNeedleDiagonalSaveStep(
                       ptrFlag);
     parts.ScoreMatrix_[i][j].leftInheritPtr = ptrFlag;
   		//normal diag
-    int32_t match = parts.scoring_.mat_[objA[i - 1]][objB[j - 1]];
+    int32_t match = parts.getScoring().mat_[objA[i - 1]][objB[j - 1]];
     parts.ScoreMatrix_[i][j].diagInherit =
         match +
         needleMaximum(parts.ScoreMatrix_[i - 1][j - 1].upInherit,
@@ -1933,7 +1957,7 @@ alignCalc::MatCursor alignCalc::runNeedleDiagonalSaveStep(
                       ptrFlag);
     parts.ScoreMatrix_[i][j].leftInheritPtr = ptrFlag;
   		//normal diag
-    int32_t match = parts.scoring_.mat_[objA[i - 1]][objB[j - 1]];
+    int32_t match = parts.getScoring().mat_[objA[i - 1]][objB[j - 1]];
     parts.ScoreMatrix_[i][j].diagInherit =
         match +
         needleMaximum(parts.ScoreMatrix_[i - 1][j - 1].upInherit,
@@ -1966,7 +1990,7 @@ alignCalc::MatCursor alignCalc::runNeedleDiagonalSaveStep(
 											ptrFlag);
 		parts.ScoreMatrix_[i][j].leftInheritPtr = ptrFlag;
   		//normal diag
-    int32_t match = parts.scoring_.mat_[objA[i - 1]][objB[j - 1]];
+    int32_t match = parts.getScoring().mat_[objA[i - 1]][objB[j - 1]];
     parts.ScoreMatrix_[i][j].diagInherit =
         match +
         needleMaximum(parts.ScoreMatrix_[i - 1][j - 1].upInherit,
@@ -2309,6 +2333,238 @@ void alignCalc::runNeedleDiagonalSave(
   //std::cout << __PRETTY_FUNCTION__ << " " << __LINE__ << std::endl;
 }
 
+namespace {
 
-}  // namespace njhseq
+/**@brief The scores for a row of runNeedleScoresOneToMany() from a score profile of the query, one row of the profile per letter
+ *
+ */
+class ProfileLaneScorer {
+public:
+	ProfileLaneScorer(const std::string & query, const substituteMatrix & scoring) :
+			query_(query), scoring_(scoring) {
+		rowForChar_.fill(-1);
+	}
+
+	/**@brief Add the profile row for letter if it's not there yet, has to be done for every letter before setRow() as adding moves the profile
+	 *
+	 */
+	uint32_t getProfileRow(char letter) {
+		const auto charPos = static_cast<unsigned char>(letter) & 127;
+		if (rowForChar_[charPos] < 0) {
+			rowForChar_[charPos] = profile_.size() / (query_.size() + 1);
+			profile_.emplace_back(0);
+			for (const auto & queryLetter : query_) {
+				profile_.emplace_back(scoring_.mat_[letter][queryLetter]);
+			}
+		}
+		return rowForChar_[charPos];
+	}
+
+	void setRow(uint32_t lane, char letter) {
+		rows_[lane] = profile_.data() + getProfileRow(letter) * (query_.size() + 1);
+	}
+	void setFinished(uint32_t lane) {
+		//finished lanes keep going on the first row of the profile, their scores are already taken
+		rows_[lane] = profile_.data();
+	}
+	void setColumn(uint32_t j, std::array<int32_t, alignCalc::oneToManyLanes_> & laneScores) const {
+		for (uint32_t lane = 0; lane < alignCalc::oneToManyLanes_; ++lane) {
+			laneScores[lane] = rows_[lane][j];
+		}
+	}
+
+private:
+	const std::string & query_;
+	const substituteMatrix & scoring_;
+	std::vector<int32_t> profile_; /**< profile_[row * (query_.size() + 1) + j] is the score of the row's letter against query_[j - 1] */
+	std::array<int32_t, 128> rowForChar_;
+	std::array<const int32_t *, alignCalc::oneToManyLanes_> rows_;
+};
+
+/**@brief The scores for a row of runNeedleScoresOneToMany() when the scoring is simple, a compare of each lane's code against the query's
+ *
+ */
+class SimpleLaneScorer {
+public:
+	SimpleLaneScorer(const std::vector<uint8_t> & queryCodes, const FlatSubstituteMatrix & scoring) :
+			scoring_(scoring), match_(scoring.getMatch()), mismatch_(scoring.getMismatch()) {
+		//offset by one so j indexes it directly
+		queryCodes_.emplace_back(FlatSubstituteMatrix::notInAlphabet_);
+		queryCodes_.insert(queryCodes_.end(), queryCodes.begin(), queryCodes.end());
+	}
 
+	void setRow(uint32_t lane, char letter) {
+		codes_[lane] = scoring_.getCode(letter);
+	}
+	void setFinished(uint32_t lane) {
+		codes_[lane] = 0;
+	}
+	void setColumn(uint32_t j, std::array<int32_t, alignCalc::oneToManyLanes_> & laneScores) const {
+		const int32_t queryCode = queryCodes_[j];
+		for (uint32_t lane = 0; lane < alignCalc::oneToManyLanes_; ++lane) {
+			laneScores[lane] = codes_[lane] == queryCode ? match_ : mismatch_;
+		}
+	}
+
+private:
+	const FlatSubstituteMatrix & scoring_;
+	const int32_t match_;
+	const int32_t mismatch_;
+	std::vector<uint8_t> queryCodes_;
+	std::array<int32_t, alignCalc::oneToManyLanes_> codes_;
+};
+
+}  // namespace
+
+void alignCalc::runNeedleScoresOneToMany(const std::string& query,
+		const std::vector<const std::string *>& targets, alnParts& parts,
+		std::vector<int32_t>& scores) {
+	scores.assign(targets.size(), 0);
+	const uint32_t lenB = query.size();
+	//the rows for the first and last base are special cased in runNeedleSave and overlap when a sequence is only
+	//one base long, so leave those to it
+	std::vector<uint32_t> batched;
+	batched.reserve(targets.size());
+	for (const auto pos : iter::range(targets.size())) {
+		if (lenB < 2 || targets[pos]->size() < 2) {
+			runNeedleSave(*targets[pos], query, parts);
+			scores[pos] = parts.score_;
+		} else {
+			batched.emplace_back(pos);
+		}
+	}
+	if (batched.empty()) {
+		return;
+	}
+	//group targets of similar length so the lanes of a batch finish close together
+	std::stable_sort(batched.begin(), batched.end(),
+			[&targets](uint32_t pos1, uint32_t pos2) {
+				return targets[pos1]->size() < targets[pos2]->size();
+			});
+	bool allEncoded = parts.getFlatScoring().isSimple()
+			&& parts.getFlatScoring().encode(query, parts.encodedB_);
+	for (const auto pos : batched) {
+		if (!allEncoded) {
+			break;
+		}
+		allEncoded = parts.getFlatScoring().encode(*targets[pos], parts.encodedA_);
+	}
+	if (allEncoded) {
+		SimpleLaneScorer laneScorer(parts.encodedB_, parts.getFlatScoring());
+		runNeedleScoresLanes(targets, batched, lenB, parts.gapScores_, laneScorer, scores);
+	} else {
+		ProfileLaneScorer laneScorer(query, parts.getScoring());
+		for (const auto pos : batched) {
+			for (const auto c : *targets[pos]) {
+				laneScorer.getProfileRow(c);
+			}
+		}
+		runNeedleScoresLanes(targets, batched, lenB, parts.gapScores_, laneScorer, scores);
+	}
+}
+
+template<typename LANE_SCORER>
+void alignCalc::runNeedleScoresLanes(
+		const std::vector<const std::string *>& targets,
+		const std::vector<uint32_t>& batched, uint32_t lenB,
+		const gapScoringParameters& gaps, LANE_SCORER& laneScorer,
+		std::vector<int32_t>& scores) {
+	constexpr uint32_t lanes = oneToManyLanes_;
+	//the up, left and diagonal scores of the previous and current row, [j * lanes + lane]
+	const uint32_t rowSize = (lenB + 1) * lanes;
+	std::vector<int32_t> prevUp(rowSize), prevLeft(rowSize), prevDiag(rowSize);
+	std::vector<int32_t> curUp(rowSize), curLeft(rowSize), curDiag(rowSize);
+	for (uint32_t batchStart = 0; batchStart < batched.size(); batchStart += lanes) {
+		const uint32_t batchSize = std::min<uint32_t>(lanes, batched.size() - batchStart);
+		std::array<uint32_t, lanes> lenA;
+		uint32_t maxLenA = 0;
+		for (uint32_t lane = 0; lane < lanes; ++lane) {
+			lenA[lane] = lane < batchSize ? targets[batched[batchStart + lane]]->size() : 0;
+			maxLenA = std::max(maxLenA, lenA[lane]);
+		}
+		//row 0, only the left scores are used
+		for (uint32_t lane = 0; lane < lanes; ++lane) {
+			prevLeft[lane] = 0;
+		}
+		for (uint32_t j = 1; j <= lenB; ++j) {
+			const int32_t left = -gaps.gapLeftRefOpen_ - static_cast<int32_t>(j - 1) * gaps.gapLeftRefExtend_;
+			for (uint32_t lane = 0; lane < lanes; ++lane) {
+				prevLeft[j * lanes + lane] = left;
+			}
+		}
+		for (uint32_t i = 1; i <= maxLenA; ++i) {
+			std::array<int32_t, lanes> leftOpen;
+			std::array<int32_t, lanes> leftExtend;
+			for (uint32_t lane = 0; lane < lanes; ++lane) {
+				if (i <= lenA[lane]) {
+					laneScorer.setRow(lane, (*targets[batched[batchStart + lane]])[i - 1]);
+				} else {
+					laneScorer.setFinished(lane);
+				}
+				const bool lastRow = i == lenA[lane];
+				leftOpen[lane] = lastRow ? gaps.gapRightRefOpen_ : gaps.gapOpen_;
+				leftExtend[lane] = lastRow ? gaps.gapRightRefExtend_ : gaps.gapExtend_;
+			}
+			//column 0
+			const int32_t upCol0 = -gaps.gapLeftQueryOpen_ - static_cast<int32_t>(i - 1) * gaps.gapLeftQueryExtend_;
+			const int32_t prevUpCol0 = 1 == i ? 0 : upCol0 + gaps.gapLeftQueryExtend_;
+			for (uint32_t lane = 0; lane < lanes; ++lane) {
+				curUp[lane] = upCol0;
+			}
+			for (uint32_t j = 1; j <= lenB; ++j) {
+				const int32_t upOpen = lenB == j ? gaps.gapRightQueryOpen_ : gaps.gapOpen_;
+				const int32_t upExtend = lenB == j ? gaps.gapRightQueryExtend_ : gaps.gapExtend_;
+				const uint32_t cell = j * lanes;
+				const uint32_t leftCell = (j - 1) * lanes;
+				std::array<int32_t, lanes> laneScores;
+				laneScorer.setColumn(j, laneScores);
+				if (1 == i) {
+					//the first row can only come from the left gap in row 0
+					for (uint32_t lane = 0; lane < lanes; ++lane) {
+						curUp[cell + lane] = prevLeft[cell + lane] - upOpen;
+						curDiag[cell + lane] = prevLeft[leftCell + lane] + laneScores[lane];
+					}
+				} else if (1 == j) {
+					//the first column's diagonal can only come from the up gap in column 0
+					for (uint32_t lane = 0; lane < lanes; ++lane) {
+						curUp[cell + lane] = std::max(prevUp[cell + lane] - upExtend,
+								std::max(prevLeft[cell + lane], prevDiag[cell + lane]) - upOpen);
+						curDiag[cell + lane] = prevUpCol0 + laneScores[lane];
+					}
+				} else {
+					for (uint32_t lane = 0; lane < lanes; ++lane) {
+						curUp[cell + lane] = std::max(prevUp[cell + lane] - upExtend,
+								std::max(prevLeft[cell + lane], prevDiag[cell + lane]) - upOpen);
+						curDiag[cell + lane] = laneScores[lane]
+								+ std::max(prevUp[leftCell + lane],
+										std::max(prevLeft[leftCell + lane], prevDiag[leftCell + lane]));
+					}
+				}
+				if (1 == j) {
+					//the first column can only come from the up gap in column 0
+					for (uint32_t lane = 0; lane < lanes; ++lane) {
+						curLeft[cell + lane] = upCol0 - leftOpen[lane];
+					}
+				} else {
+					for (uint32_t lane = 0; lane < lanes; ++lane) {
+						curLeft[cell + lane] = std::max(curLeft[leftCell + lane] - leftExtend[lane],
+								std::max(curUp[leftCell + lane], curDiag[leftCell + lane]) - leftOpen[lane]);
+					}
+				}
+			}
+			for (uint32_t lane = 0; lane < batchSize; ++lane) {
+				if (i == lenA[lane]) {
+					const uint32_t cell = lenB * lanes + lane;
+					scores[batched[batchStart + lane]] = std::max(curUp[cell],
+							std::max(curLeft[cell], curDiag[cell]));
+				}
+			}
+			std::swap(prevUp, curUp);
+			std::swap(prevLeft, curLeft);
+			std::swap(prevDiag, curDiag);
+		}
+	}
+}
+
+
+}  // namespace njhseq
@@ -103,6 +103,64 @@ class alignCalc {
       return d;
     }
   }
+  /**@brief Scores with substituteMatrix::mat_ by the letters, for sequences parts.flatScoring_ can't encode
+   *
+   */
+  struct CharScorer {
+  	const std::string & objA_;
+  	const std::string & objB_;
+  	const substituteMatrix & scoring_;
+  	int32_t operator()(uint32_t posA, uint32_t posB) const {
+  		return scoring_.mat_[objA_[posA]][objB_[posB]];
+  	}
+  };
+
+  /**@brief Scores encoded sequences with the flat table of a FlatSubstituteMatrix
+   *
+   */
+  struct FlatScorer {
+  	const uint8_t * codesA_;
+  	const uint8_t * codesB_;
+  	const int32_t * mat_;
+  	int32_t operator()(uint32_t posA, uint32_t posB) const {
+  		return mat_[codesA_[posA] * FlatSubstituteMatrix::maxCodes_ + codesB_[posB]];
+  	}
+  };
+
+  /**@brief Scores encoded sequences when the FlatSubstituteMatrix is simple, the score is a compare of the codes
+   *
+   */
+  struct SimpleScorer {
+  	const uint8_t * codesA_;
+  	const uint8_t * codesB_;
+  	int32_t match_;
+  	int32_t mismatch_;
+  	int32_t operator()(uint32_t posA, uint32_t posB) const {
+  		return codesA_[posA] == codesB_[posB] ? match_ : mismatch_;
+  	}
+  };
+
+  /**@brief Call func with the fastest scorer for objA and objB, SimpleScorer or FlatScorer if parts.flatScoring_ can encode both
+   * (into parts.encodedA_ and parts.encodedB_) otherwise CharScorer
+   *
+   */
+  template<typename FUNC>
+  static void runWithScorer(const std::string& objA, const std::string& objB,
+  		alnParts& parts, FUNC func) {
+  	if (parts.getFlatScoring().encode(objA, parts.encodedA_)
+  			&& parts.getFlatScoring().encode(objB, parts.encodedB_)) {
+  		if (parts.getFlatScoring().isSimple()) {
+  			func(SimpleScorer { parts.encodedA_.data(), parts.encodedB_.data(),
+  					parts.getFlatScoring().getMatch(), parts.getFlatScoring().getMismatch() });
+  		} else {
+  			func(FlatScorer { parts.encodedA_.data(), parts.encodedB_.data(),
+  					parts.getFlatScoring().data() });
+  		}
+  	} else {
+  		func(CharScorer { objA, objB, parts.getScoring() });
+  	}
+  }
+
   static void runNeedleSave(const std::string& objA, const std::string& objB,
                             alnParts& parts);
   static void runNeedleOnlyEndGapsSave(const std::string& objA, const std::string& objB,
@@ -111,6 +169,27 @@ class alignCalc {
   static void runSmithSave(const std::string& objA, const std::string& objB,
                            alnParts& parts);
 
+  /**@brief The number of targets runNeedleScoresOneToMany() scores together, one per lane of its row buffers
+   *
+   */
+  static constexpr uint32_t oneToManyLanes_ = 8;
+
+  /**@brief Get the score runNeedleSave(*targets[pos], query, parts) would give for every target without the traceback
+   *
+   * Targets of similar length are scored oneToManyLanes_ at a time against a score profile of the query built once (or by comparing
+   * codes when parts.flatScoring_ is simple and can encode the sequences), each lane is one target so the inner loops are over the lanes and can be vectorized, only two rows are kept per lane so
+   * parts.ScoreMatrix_ doesn't need to be big enough for the sequences. Targets or a query of less than two bases go through
+   * runNeedleSave() so parts.score_ and parts.gHolder_ can be changed
+   *
+   * @param query the sequence aligned as the second sequence (objB) in each alignment
+   * @param targets the sequences aligned as the first sequence (objA)
+   * @param parts the gap and match scoring to use
+   * @param scores filled with the score for each target, in the order of targets
+   */
+  static void runNeedleScoresOneToMany(const std::string& query,
+  		const std::vector<const std::string *>& targets, alnParts& parts,
+			std::vector<int32_t>& scores);
+
 
 
 
@@ -187,6 +266,22 @@ class alignCalc {
       }
     }
   }
+
+ private:
+  template<typename SCORER>
+  static void runNeedleSaveImpl(const std::string& objA, const std::string& objB,
+                                alnParts& parts, const SCORER & scorer);
+  template<typename SCORER>
+  static void runNeedleOnlyEndGapsSaveImpl(const std::string& objA, const std::string& objB,
+                                           alnParts& parts, const SCORER & scorer);
+  template<typename SCORER>
+  static void runSmithSaveImpl(const std::string& objA, const std::string& objB,
+                               alnParts& parts, const SCORER & scorer);
+  template<typename LANE_SCORER>
+  static void runNeedleScoresLanes(const std::vector<const std::string *>& targets,
+  		const std::vector<uint32_t>& batched, uint32_t lenB,
+			const gapScoringParameters& gaps, LANE_SCORER& laneScorer,
+			std::vector<int32_t>& scores);
 };
 
 
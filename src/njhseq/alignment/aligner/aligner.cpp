@@ -26,20 +26,20 @@ namespace njhseq {
 
 void aligner::resetAlnCache(){
 	alnHolder_.clearHolders();
-	alnHolder_.addHolder(parts_.gapScores_, parts_.scoring_);
+	alnHolder_.addHolder(parts_.gapScores_, parts_.getScoring());
 }
 
 aligner::aligner() :
 		parts_(alnParts()) {
 	countEndGaps_ = false;
 	weighHomopolymers_ = false;
-	alnHolder_.addHolder(parts_.gapScores_, parts_.scoring_);
+	alnHolder_.addHolder(parts_.gapScores_, parts_.getScoring());
 	setDefaultQualities();
 }
 
 aligner::aligner(uint64_t maxSize, const gapScoringParameters& gapPars) :
 		parts_(maxSize, gapPars) {
-	alnHolder_.addHolder(parts_.gapScores_, parts_.scoring_);
+	alnHolder_.addHolder(parts_.gapScores_, parts_.getScoring());
 	countEndGaps_ = false;
 	weighHomopolymers_ = false;
 	setDefaultQualities();
@@ -57,7 +57,7 @@ aligner::aligner(uint64_t maxSize, const gapScoringParameters& gapPars,
 aligner::aligner(uint64_t maxSize, const gapScoringParameters& gapPars,
 		const substituteMatrix& scoreMatrix, bool countEndGaps) :
 		parts_(maxSize, gapPars, scoreMatrix), countEndGaps_(countEndGaps) {
-	alnHolder_.addHolder(parts_.gapScores_, parts_.scoring_);
+	alnHolder_.addHolder(parts_.gapScores_, parts_.getScoring());
 	weighHomopolymers_ = false;
 	setDefaultQualities();
 }
@@ -68,14 +68,14 @@ aligner::aligner(uint64_t maxSize, const gapScoringParameters & gapPars,
 		parts_(maxSize, gapPars, subMatrix),  kMaps_(
 				kmaps), qScorePars_(qScorePars), countEndGaps_(countEndGaps), weighHomopolymers_(
 				weighHomopolymers) {
-	alnHolder_.addHolder(parts_.gapScores_, parts_.scoring_);
+	alnHolder_.addHolder(parts_.gapScores_, parts_.getScoring());
 
 }
 
 void aligner::setGapScoring(const gapScoringParameters & gapPars){
 	parts_.gapScores_ = gapPars;
 	if(alnHolder_.globalHolder_.find(gapPars.uniqueIdentifer_) == alnHolder_.globalHolder_.end()){
-		alnHolder_.addHolder(gapPars, parts_.scoring_);
+		alnHolder_.addHolder(gapPars, parts_.getScoring());
 	}
 }
 
@@ -262,6 +262,37 @@ void aligner::alignRegLocal(const seqInfo & ref, const seqInfo & read){
 
 
 
+aligner::OneToManyAlignments aligner::alignOneToMany(const seqInfo & query,
+		const std::vector<const seqInfo *> & targets, uint32_t topK) {
+	OneToManyAlignments ret;
+	std::vector<const std::string *> targetSeqs;
+	targetSeqs.reserve(targets.size());
+	for (const auto & target : targets) {
+		targetSeqs.emplace_back(&target->seq_);
+	}
+	alignCalc::runNeedleScoresOneToMany(query.seq_, targetSeqs, parts_, ret.scores_);
+	numberOfAlingmentsDone_ += targets.size();
+	if (0 == topK) {
+		return ret;
+	}
+	ret.best_.resize(targets.size());
+	njh::iota<uint32_t>(ret.best_, 0);
+	std::stable_sort(ret.best_.begin(), ret.best_.end(),
+			[&ret](uint32_t pos1, uint32_t pos2) {
+				return ret.scores_[pos1] > ret.scores_[pos2];
+			});
+	if (ret.best_.size() > topK) {
+		ret.best_.resize(topK);
+	}
+	for (const auto pos : ret.best_) {
+		alignScoreCacheGlobal(targets[pos]->seq_, query.seq_);
+		ret.bestAlignments_.emplace_back();
+		ret.bestAlignments_.back().setGlobal(targets[pos]->seq_, query.seq_,
+				parts_.gHolder_, parts_.getScoring());
+	}
+	return ret;
+}
+
 std::pair<uint32_t, uint32_t> aligner::findReversePrimer(const std::string& read,
                                         				const std::string& primer){
 	alignScoreCache(read, primer, true);
@@ -275,6 +306,7 @@ std::pair<uint32_t, uint32_t> aligner::findReversePrimer(const baseReadObject& r
 
 void aligner::rearrangeSeq(const std::string& firstRead,
 		const std::string& secondRead, bool local) {
+	alnOpsOnly_ = false;
 	alignObjectA_.seqBase_ = seqInfo("A", firstRead);
 	alignObjectB_.seqBase_ = seqInfo("B", secondRead);
 	if (local) {
@@ -292,37 +324,70 @@ void aligner::rearrangeSeq(const std::string& firstRead,
 
 void aligner::rearrangeObjs(const seqInfo& firstRead, const seqInfo& secondRead,
 		bool local) {
-	alignObjectA_.seqBase_ = firstRead;
-	alignObjectB_.seqBase_ = secondRead;
 	if (local) {
-		alignCalc::rearrangeLocal(alignObjectA_.seqBase_.seq_,
-				alignObjectB_.seqBase_.seq_, '-', parts_.lHolder_);
-		alignCalc::rearrangeLocal(alignObjectA_.seqBase_.qual_,
-				alignObjectB_.seqBase_.qual_, 0, parts_.lHolder_);
+		rearrangeObjsLocal(firstRead, secondRead);
 	} else {
-		alignCalc::rearrangeGlobal(alignObjectA_.seqBase_.seq_,
-				alignObjectB_.seqBase_.seq_, '-', parts_.gHolder_);
-		alignCalc::rearrangeGlobal(alignObjectA_.seqBase_.qual_,
-				alignObjectB_.seqBase_.qual_, 0, parts_.gHolder_);
+		rearrangeObjsGlobal(firstRead, secondRead);
 	}
 }
 
 void aligner::rearrangeObjsLocal(const seqInfo& firstRead, const seqInfo& secondRead){
-	alignObjectA_.seqBase_ = firstRead;
-	alignObjectB_.seqBase_ = secondRead;
-	alignCalc::rearrangeLocal(alignObjectA_.seqBase_.seq_,
-			alignObjectB_.seqBase_.seq_, '-', parts_.lHolder_);
-	alignCalc::rearrangeLocal(alignObjectA_.seqBase_.qual_,
-			alignObjectB_.seqBase_.qual_, 0, parts_.lHolder_);
+	alnOps_.setLocal(firstRead.seq_, secondRead.seq_, parts_.lHolder_,
+			parts_.getScoring());
+	alnOpsOnly_ = !buildGappedAlignment_;
+	if (buildGappedAlignment_) {
+		buildGappedAlignment(firstRead, secondRead);
+	}
 }
 
 void aligner::rearrangeObjsGlobal(const seqInfo& firstRead, const seqInfo& secondRead){
+	alnOps_.setGlobal(firstRead.seq_, secondRead.seq_, parts_.gHolder_,
+			parts_.getScoring());
+	alnOpsOnly_ = !buildGappedAlignment_;
+	if (buildGappedAlignment_) {
+		buildGappedAlignment(firstRead, secondRead);
+	}
+}
+
+void aligner::buildGappedAlignment(const seqInfo& firstRead,
+		const seqInfo& secondRead) {
+	if (&firstRead == &alignObjectA_.seqBase_ || &firstRead == &alignObjectB_.seqBase_
+			|| &secondRead == &alignObjectA_.seqBase_ || &secondRead == &alignObjectB_.seqBase_) {
+		//the gapped sequences are built in place so copy the input first
+		const seqInfo firstCopy = firstRead;
+		const seqInfo secondCopy = secondRead;
+		buildGappedAlignment(firstCopy, secondCopy);
+		return;
+	}
 	alignObjectA_.seqBase_ = firstRead;
 	alignObjectB_.seqBase_ = secondRead;
-	alignCalc::rearrangeGlobal(alignObjectA_.seqBase_.seq_,
-			alignObjectB_.seqBase_.seq_, '-', parts_.gHolder_);
-	alignCalc::rearrangeGlobal(alignObjectA_.seqBase_.qual_,
-			alignObjectB_.seqBase_.qual_, 0, parts_.gHolder_);
+	alnOps_.buildGapped(firstRead.seq_, secondRead.seq_,
+			alignObjectA_.seqBase_.seq_, alignObjectB_.seqBase_.seq_, '-');
+	alnOps_.buildGapped(firstRead.qual_, secondRead.qual_,
+			alignObjectA_.seqBase_.qual_, alignObjectB_.seqBase_.qual_, 0);
+	alnOpsOnly_ = false;
+}
+
+aligner::NoGappedAlignmentGuard::NoGappedAlignmentGuard(aligner & alignerObj) :
+		alignerObj_(alignerObj), previous_(alignerObj.buildGappedAlignment_) {
+	alignerObj_.buildGappedAlignment_ = false;
+}
+
+aligner::NoGappedAlignmentGuard::~NoGappedAlignmentGuard() {
+	alignerObj_.buildGappedAlignment_ = previous_;
+	if (previous_) {
+		//go back to working off of alignObjectA_ and alignObjectB_ so ones set by hand are used
+		alignerObj_.alnOpsOnly_ = false;
+	}
+}
+
+aligner::CountsOnlyProfileGuard::CountsOnlyProfileGuard(aligner & alignerObj) :
+		alignerObj_(alignerObj), previous_(alignerObj.profileDetails_) {
+	alignerObj_.profileDetails_ = false;
+}
+
+aligner::CountsOnlyProfileGuard::~CountsOnlyProfileGuard() {
+	alignerObj_.profileDetails_ = previous_;
 }
 
 
@@ -339,127 +404,83 @@ void aligner::setQual(QualScorePars pars) {
 }
 
 
-const comparison & aligner::profilePrimerAlignment(const seqInfo& objectA,
-                            const seqInfo& objectB){
-  resetAlignmentInfo();
-	uint32_t firstOffset = 0;
-	uint32_t secondOffset = 0;
-	uint32_t gappedBasesInA = 0;
-	uint32_t gappedBasesInB = 0;
-
-  for (uint32_t i = 0; i < len(alignObjectA_); ++i) {
-  	//gap in alignObjectA, normally reference sequence
-    if (alignObjectA_.seqBase_.seq_[i] == '-') {
-      ++firstOffset;
-			gap newGap = gap(i, getSeqPosForAlnAPos(i), getSeqPosForAlnBPos(i),
-					alignObjectB_.seqBase_.seq_.substr(i, 1),
-					alignObjectB_.seqBase_.qual_[i], true);
-      while (alignObjectA_.seqBase_.seq_[i + 1] == '-') {
-        newGap.gapedSequence_.append(
-            alignObjectB_.seqBase_.seq_.substr(i + 1, 1));
-        ++newGap.size_;
-        newGap.qualities_.emplace_back(alignObjectB_.seqBase_.qual_[i + 1]);
-        ++i;
-        ++firstOffset;
-      }
-			bool endGap = (newGap.startPos_ + newGap.size_ >= len(alignObjectA_)) || 0 == newGap.startPos_;
-			if (!endGap) {
-				gappedBasesInA += newGap.size_;
-				handleGapCountingInA(newGap);
-				comp_.distances_.alignmentGaps_.insert(
-						std::make_pair(newGap.startPos_, newGap));
-			} else if (countEndGaps_) {
-				handleGapCountingInA(newGap);
-				comp_.distances_.alignmentGaps_.insert(
-						std::make_pair(newGap.startPos_, newGap));
-			}
-      continue;
-    }
-    //gap in alignObjectB, normally query sequence
-    if (alignObjectB_.seqBase_.seq_[i] == '-') {
-      ++secondOffset;
-			gap newGap = gap(i, getSeqPosForAlnAPos(i), getSeqPosForAlnBPos(i),
-					alignObjectA_.seqBase_.seq_.substr(i, 1),
-					alignObjectA_.seqBase_.qual_[i], false);
-      while (alignObjectB_.seqBase_.seq_[i + 1] == '-') {
-        newGap.gapedSequence_.append(
-            alignObjectA_.seqBase_.seq_.substr(i + 1, 1));
-        ++newGap.size_;
-        newGap.qualities_.emplace_back(alignObjectA_.seqBase_.qual_[i + 1]);
-        ++i;
-        ++secondOffset;
-      }
-      bool endGap = (newGap.startPos_ + newGap.size_ >= len(alignObjectB_)) || 0 == newGap.startPos_;
-			if (!endGap) {
-				gappedBasesInB += newGap.size_;
-				handleGapCountingInB(newGap);
-				comp_.distances_.alignmentGaps_.insert(
-										std::make_pair(newGap.startPos_, newGap));
-			}else if (countEndGaps_) {
-				handleGapCountingInB(newGap);
-				comp_.distances_.alignmentGaps_.insert(
-										std::make_pair(newGap.startPos_, newGap));
-			}
-      continue;
-    }
-    if (0 > parts_.scoring_.mat_[alignObjectA_.seqBase_.seq_[i]]
-                         [alignObjectB_.seqBase_.seq_[i]]) {
-      ++comp_.hqMismatches_;
-      comp_.distances_.mismatches_.insert(std::make_pair(
-                  i,
-                  mismatch(
-                      alignObjectA_.seqBase_.seq_[i], alignObjectA_.seqBase_.qual_[i],
-                      objectA.getLeadQual(i - firstOffset, qScorePars_.qualThresWindow_),
-                      objectA.getTrailQual(i - firstOffset,qScorePars_.qualThresWindow_), i - firstOffset,
-                      alignObjectB_.seqBase_.seq_[i], alignObjectB_.seqBase_.qual_[i],
-                      objectB.getLeadQual(i - secondOffset,qScorePars_.qualThresWindow_),
-                      objectB.getTrailQual(i - secondOffset,qScorePars_.qualThresWindow_), i - secondOffset,
-                      0,0)));
-    } else {
-      ++comp_.highQualityMatches_;
-    }
-  }
-
-	uint32_t gappedLeftEndA = 0;
-	uint32_t gappedRightEndA = 0;
-	if (alignObjectA_.seqBase_.seq_.front() == '-') {
-		gappedLeftEndA += countBeginChar(alignObjectA_.seqBase_.seq_);
+std::pair<const seqInfo *, const seqInfo *> aligner::getAlnOpsSeqs(
+		const seqInfo& objectA, const seqInfo& objectB) {
+	if (alnOpsOnly_) {
+		if (alnOps_.aEnd_ > objectA.seq_.size() || alnOps_.bEnd_ > objectB.seq_.size()) {
+			std::stringstream ss;
+			ss << __PRETTY_FUNCTION__ << ", error "
+					<< "the sequences given aren't the ones that were aligned, alignment goes to "
+					<< alnOps_.aEnd_ << " in " << objectA.name_ << " and " << alnOps_.bEnd_
+					<< " in " << objectB.name_ << " but their lengths are "
+					<< objectA.seq_.size() << " and " << objectB.seq_.size() << "\n";
+			throw std::runtime_error { ss.str() };
+		}
+		return {&objectA, &objectB};
 	}
-	if (alignObjectA_.seqBase_.seq_.back() == '-') {
-		gappedRightEndA += countEndChar(alignObjectA_.seqBase_.seq_);
+	//alignObjectA_ and alignObjectB_ can be set by hand so work off of them
+	const auto & gappedA = alignObjectA_.seqBase_;
+	const auto & gappedB = alignObjectB_.seqBase_;
+	if (gappedA.qual_.size() != gappedA.seq_.size()
+			|| gappedB.qual_.size() != gappedB.seq_.size()) {
+		std::stringstream ss;
+		ss << __PRETTY_FUNCTION__ << ", error "
+				<< "alignObjectA_ and alignObjectB_ need a quality for each base, seq sizes: "
+				<< gappedA.seq_.size() << " " << gappedB.seq_.size()
+				<< ", qual sizes: " << gappedA.qual_.size() << " "
+				<< gappedB.qual_.size() << "\n";
+		throw std::runtime_error { ss.str() };
 	}
-	uint32_t gappedEndA = gappedRightEndA + gappedLeftEndA;
+	alnOps_.setFromGapped(gappedA.seq_, gappedB.seq_, parts_.getScoring());
+	alnOps_.removeGaps(gappedA.seq_, gappedB.seq_, gaplessA_.seq_, gaplessB_.seq_);
+	alnOps_.removeGaps(gappedA.qual_, gappedB.qual_, gaplessA_.qual_, gaplessB_.qual_);
+	return {&gaplessA_, &gaplessB_};
+}
 
-	uint32_t gappedLeftEndB = 0;
-	uint32_t gappedRightEndB = 0;
-	if (alignObjectB_.seqBase_.seq_.front() == '-') {
-		gappedLeftEndB += countBeginChar(alignObjectB_.seqBase_.seq_);
+gap aligner::getAlnOpsGap(const AlignmentOps::Op & op, uint32_t start,
+		const seqInfo & seqA, const seqInfo & seqB, bool addQualities) const {
+	const uint32_t offset = start - op.alnPos_;
+	const uint32_t size = op.length_ - offset;
+	//the gapped bases come from the sequence without the gap
+	const bool gapInA = AlignmentOps::OpType::INSERTION == op.type_;
+	const seqInfo & gappedFrom = gapInA ? seqB : seqA;
+	const uint32_t gappedFromPos = (gapInA ? op.bPos_ : op.aPos_) + offset;
+	gap ret(start,
+			op.aPos_ - alnOps_.aStart_ + (gapInA ? 0 : offset),
+			op.bPos_ - alnOps_.bStart_ + (gapInA ? offset : 0),
+			gappedFrom.seq_.substr(gappedFromPos, size),
+			gappedFrom.qual_[gappedFromPos], gapInA);
+	if (addQualities) {
+		ret.qualities_.insert(ret.qualities_.end(),
+				gappedFrom.qual_.begin() + gappedFromPos + 1,
+				gappedFrom.qual_.begin() + gappedFromPos + size);
 	}
-	if (alignObjectB_.seqBase_.seq_.back() == '-') {
-		gappedRightEndB += countEndChar(alignObjectB_.seqBase_.seq_);
-	}
-	uint32_t gappedEndB = gappedLeftEndB + gappedRightEndB;
+	return ret;
+}
 
-	uint32_t gappedEnd = gappedEndA + gappedEndB;
+void aligner::setAlnOpsDistances(const seqInfo& objectA, const seqInfo& objectB,
+		uint32_t gappedBasesInA, uint32_t gappedBasesInB, uint32_t gapEvents) {
+	uint32_t gappedEnd = alnOps_.countEndGaps(true) + alnOps_.countEndGaps(false);
 
 	//objectA (ref)
-	comp_.distances_.ref_.covered_ = len(alignObjectA_) - gappedBasesInA - gappedEnd;
+	comp_.distances_.ref_.covered_ = alnOps_.alnLength_ - gappedBasesInA - gappedEnd;
 	comp_.distances_.ref_.coverage_ = static_cast<double>(comp_.distances_.ref_.covered_)/len(objectA);
 	comp_.distances_.ref_.identities_ = comp_.highQualityMatches_ + comp_.lowQualityMatches_;
 	comp_.distances_.ref_.identity_ = static_cast<double>(comp_.distances_.ref_.identities_)/len(objectA);
 	//objectB (query)
-	comp_.distances_.query_.covered_ = len(alignObjectB_) - gappedBasesInB - gappedEnd;
+	comp_.distances_.query_.covered_ = alnOps_.alnLength_ - gappedBasesInB - gappedEnd;
 	comp_.distances_.query_.coverage_ = static_cast<double>(comp_.distances_.query_.covered_)/len(objectB);
 	comp_.distances_.query_.identities_ = comp_.highQualityMatches_ + comp_.lowQualityMatches_;
 	comp_.distances_.query_.identity_ = static_cast<double>(comp_.distances_.query_.identities_)/len(objectB);
 	//of the overlapping alignment
-	comp_.distances_.basesInAln_ = len(alignObjectA_) - gappedEnd;
+	comp_.distances_.basesInAln_ = alnOps_.alnLength_ - gappedEnd;
   comp_.distances_.percentMatch_ = (comp_.highQualityMatches_ + comp_.lowQualityMatches_)/static_cast<double>(comp_.distances_.basesInAln_);
   comp_.distances_.percentMismatch_ = (comp_.hqMismatches_ + comp_.lqMismatches_)/static_cast<double>(comp_.distances_.basesInAln_);
   comp_.distances_.percentGaps_ = (gappedBasesInA + gappedBasesInB)/static_cast<double>(comp_.distances_.basesInAln_);
+  //gapEvents is the number of gaps that would be in alignmentGaps_ so this works when they aren't being recorded
   comp_.distances_.overLappingEvents_ = comp_.highQualityMatches_
 			+ comp_.lowQualityMatches_ + comp_.hqMismatches_ + comp_.lqMismatches_
-			+ comp_.lowKmerMismatches_ + comp_.distances_.alignmentGaps_.size();
+			+ comp_.lowKmerMismatches_ + gapEvents;
   if(comp_.distances_.overLappingEvents_ == 0){
   		comp_.distances_.eventBasedIdentity_ = 0;
   }else{
@@ -469,21 +490,88 @@ const comparison & aligner::profilePrimerAlignment(const seqInfo& objectA,
   comp_.refName_ = objectA.name_;
   comp_.queryName_ = objectB.name_;
   comp_.alnScore_ = parts_.score_;
+}
+
+const comparison & aligner::profilePrimerAlignment(const seqInfo& objectA,
+                            const seqInfo& objectB){
+  resetAlignmentInfo();
+	const auto alnSeqs = getAlnOpsSeqs(objectA, objectB);
+	const seqInfo & seqA = *alnSeqs.first;
+	const seqInfo & seqB = *alnSeqs.second;
+	uint32_t gappedBasesInA = 0;
+	uint32_t gappedBasesInB = 0;
+	uint32_t gapEvents = 0;
+
+	for (const auto & op : alnOps_.ops_) {
+		//gap in A (normally reference sequence) or in B (normally query sequence)
+		if (!op.consumesA() || !op.consumesB()) {
+			bool endGap = op.alnEnd() >= alnOps_.alnLength_ || 0 == op.alnPos_;
+			if (!endGap || countEndGaps_) {
+				if (!endGap) {
+					(op.consumesA() ? gappedBasesInB : gappedBasesInA) += op.length_;
+				}
+				handleAlnOpsGapCounting(op, op.alnPos_, seqA, seqB);
+				++gapEvents;
+				if (profileDetails_) {
+					comp_.distances_.alignmentGaps_.insert(
+							std::make_pair(op.alnPos_, getAlnOpsGap(op, op.alnPos_, seqA, seqB, true)));
+				}
+			}
+			continue;
+		}
+		if (AlignmentOps::OpType::MATCH == op.type_) {
+			comp_.highQualityMatches_ += op.length_;
+			continue;
+		}
+		comp_.hqMismatches_ += op.length_;
+		if (!profileDetails_) {
+			continue;
+		}
+		for (uint32_t i = op.alnPos_; i < op.alnEnd(); ++i) {
+			const uint32_t aPos = op.aPos_ + i - op.alnPos_;
+			const uint32_t bPos = op.bPos_ + i - op.alnPos_;
+			const uint32_t aRelPos = aPos - alnOps_.aStart_;
+			const uint32_t bRelPos = bPos - alnOps_.bStart_;
+			comp_.distances_.mismatches_.insert(std::make_pair(
+									i,
+									mismatch(
+											seqA.seq_[aPos], seqA.qual_[aPos],
+											objectA.getLeadQual(aRelPos, qScorePars_.qualThresWindow_),
+											objectA.getTrailQual(aRelPos,qScorePars_.qualThresWindow_), aRelPos,
+											seqB.seq_[bPos], seqB.qual_[bPos],
+											objectB.getLeadQual(bRelPos,qScorePars_.qualThresWindow_),
+											objectB.getTrailQual(bRelPos,qScorePars_.qualThresWindow_), bRelPos,
+											0,0)));
+		}
+	}
+	setAlnOpsDistances(objectA, objectB, gappedBasesInA, gappedBasesInB, gapEvents);
   return comp_;
 }
 
 
 size_t aligner::getAlignPosForSeqAPos(size_t seqAPos){
+	if (alnOpsOnly_) {
+		return alnOps_.getAlnPosForSeqAPos(seqAPos);
+	}
 	return getAlnPosForRealPos(alignObjectA_.seqBase_.seq_, seqAPos);
 }
 size_t aligner::getAlignPosForSeqBPos(size_t seqBPos){
+	if (alnOpsOnly_) {
+		return alnOps_.getAlnPosForSeqBPos(seqBPos);
+	}
 	return getAlnPosForRealPos(alignObjectB_.seqBase_.seq_, seqBPos);
 
 }
 size_t aligner::getSeqPosForAlnAPos(size_t alnAPos){
+	if (alnOpsOnly_) {
+		return alnOps_.getSeqAPosForAlnPos(alnAPos);
+	}
 	return getRealPosForAlnPos(alignObjectA_.seqBase_.seq_, alnAPos);
 }
 size_t aligner::getSeqPosForAlnBPos(size_t alnBPos){
+	if (alnOpsOnly_) {
+		return alnOps_.getSeqBPosForAlnPos(alnBPos);
+	}
 	return getRealPosForAlnPos(alignObjectB_.seqBase_.seq_, alnBPos);
 }
 
@@ -491,346 +579,160 @@ const comparison & aligner::profileAlignment(const seqInfo& objectA,
 		const seqInfo& objectB, bool checkKmer, bool usingQuality,
 		bool doingMatchQuality, uint32_t start, uint32_t stop) {
   resetAlignmentInfo();
-	uint32_t firstOffset = 0;
-	uint32_t secondOffset = 0;
+	const auto alnSeqs = getAlnOpsSeqs(objectA, objectB);
+	const seqInfo & seqA = *alnSeqs.first;
+	const seqInfo & seqB = *alnSeqs.second;
+	qualCheckA_.setQual(objectA.qual_, qScorePars_);
+	qualCheckB_.setQual(objectB.qual_, qScorePars_);
 	uint32_t gappedBasesInA = 0;
 	uint32_t gappedBasesInB = 0;
-	uint32_t numberOfGaps = 0;
-  //if the start is the very beginning, need to calculate the offset
-  if (start != 0) {
-    for (uint32_t i = 0; i < start; ++i) {
-    	//gap in alignObjectA, normally reference sequence
-      if (alignObjectA_.seqBase_.seq_[i] == '-') {
-        ++firstOffset;
-        while (alignObjectA_.seqBase_.seq_[i + 1] == '-' && (i + 1) != start) {
-          ++i;
-          ++firstOffset;
-        }
-        continue;
-      }
-      //gap in alignObjectB, normally query sequence
-      if (alignObjectB_.seqBase_.seq_[i] == '-') {
-        ++secondOffset;
-        while (alignObjectB_.seqBase_.seq_[i + 1] == '-' && (i + 1) != start) {
-          ++i;
-          ++secondOffset;
-        }
-        continue;
-      }
-    }
-  }
+	uint32_t gapEvents = 0;
   //if stop not manually set this to the size of the alignment
   /**@todo consider throwing an exception or at least printing
    *  a warning if the stop is request to be greater than the sequence*/
-  if (stop == 0 || stop > alignObjectA_.seqBase_.seq_.size()) {
-    stop = alignObjectA_.seqBase_.seq_.size();
+  if (stop == 0 || stop > alnOps_.alnLength_) {
+    stop = alnOps_.alnLength_;
   }
-  for (uint32_t i = start; i < stop; ++i) {
-  	//gap in alignObjectA, normally reference sequence
-    if (alignObjectA_.seqBase_.seq_[i] == '-') {
-      ++firstOffset;
-			gap newGap = gap(i, getSeqPosForAlnAPos(i), getSeqPosForAlnBPos(i),
-					alignObjectB_.seqBase_.seq_.substr(i, 1),
-					alignObjectB_.seqBase_.qual_[i], true);
-      while (alignObjectA_.seqBase_.seq_[i + 1] == '-') {
-        newGap.gapedSequence_.append(
-            alignObjectB_.seqBase_.seq_.substr(i + 1, 1));
-        ++newGap.size_;
-        newGap.qualities_.emplace_back(alignObjectB_.seqBase_.qual_[i + 1]);
-        ++i;
-        ++firstOffset;
-      }
-      /**@todo for now this is kept the real stop and start for
-       *  reasons this function is used for but this might change
-       *   or become a new function*/
-			bool endGap = (newGap.startPos_ + newGap.size_ >= len(alignObjectA_)) || 0 == newGap.startPos_;
-			if (!endGap) {
-				gappedBasesInA += newGap.size_;
-				++numberOfGaps;
-				handleGapCountingInA(newGap);
-				comp_.distances_.alignmentGaps_.insert(
-						std::make_pair(newGap.startPos_, newGap));
-			} else if (countEndGaps_) {
-				++numberOfGaps;
-				handleGapCountingInA(newGap);
-				comp_.distances_.alignmentGaps_.insert(
-						std::make_pair(newGap.startPos_, newGap));
+	for (const auto & op : alnOps_.ops_) {
+		if (op.alnEnd() <= start) {
+			continue;
+		}
+		if (op.alnPos_ >= stop) {
+			break;
+		}
+		const uint32_t opStart = std::max(op.alnPos_, start);
+		//gap in A (normally reference sequence) or in B (normally query sequence)
+		if (!op.consumesA() || !op.consumesB()) {
+			/**@todo for now a gap that starts before stop is kept whole and the end gap check is against the
+			 *  real stop and start for reasons this function is used for but this might change
+			 *   or become a new function*/
+			bool endGap = op.alnEnd() >= alnOps_.alnLength_ || 0 == opStart;
+			if (!endGap || countEndGaps_) {
+				if (!endGap) {
+					(op.consumesA() ? gappedBasesInB : gappedBasesInA) += op.alnEnd() - opStart;
+				}
+				handleAlnOpsGapCounting(op, opStart, seqA, seqB);
+				++gapEvents;
+				if (profileDetails_) {
+					comp_.distances_.alignmentGaps_.insert(
+							std::make_pair(opStart, getAlnOpsGap(op, opStart, seqA, seqB, true)));
+				}
 			}
-      continue;
-    }
-    //gap in alignObjectB, normally query sequence
-    if (alignObjectB_.seqBase_.seq_[i] == '-') {
-      ++secondOffset;
-			gap newGap = gap(i, getSeqPosForAlnAPos(i), getSeqPosForAlnBPos(i),
-					alignObjectA_.seqBase_.seq_.substr(i, 1),
-					alignObjectA_.seqBase_.qual_[i], false);
-      while (alignObjectB_.seqBase_.seq_[i + 1] == '-' ) {
-        newGap.gapedSequence_.append(
-            alignObjectA_.seqBase_.seq_.substr(i + 1, 1));
-        ++newGap.size_;
-        newGap.qualities_.emplace_back(alignObjectA_.seqBase_.qual_[i + 1]);
-        ++i;
-        ++secondOffset;
-      }
-      /**@todo for now this is kept the real stop and start for
-       *  reasons this function is used for but this might change
-       *   or become a new function*/
-      bool endGap = (newGap.startPos_ + newGap.size_ >= alignObjectB_.seqBase_.seq_.length()) || 0 == newGap.startPos_;
-			if (!endGap) {
-				++numberOfGaps;
-				gappedBasesInB += newGap.size_;
-				handleGapCountingInB(newGap);
-				comp_.distances_.alignmentGaps_.insert(
-										std::make_pair(newGap.startPos_, newGap));
-			}else if (countEndGaps_) {
-				++numberOfGaps;
-				handleGapCountingInB(newGap);
-				comp_.distances_.alignmentGaps_.insert(
-										std::make_pair(newGap.startPos_, newGap));
+			continue;
+		}
+		const uint32_t opStop = std::min(op.alnEnd(), stop);
+		if (AlignmentOps::OpType::MATCH == op.type_) {
+			if (usingQuality && doingMatchQuality) {
+				for (uint32_t i = opStart; i < opStop; ++i) {
+					//relative positions are the same as positions in the gapped sequences
+					if (qualCheckA_.checkQual(op.aPos_ + i - op.alnPos_ - alnOps_.aStart_)
+							&& qualCheckB_.checkQual(op.bPos_ + i - op.alnPos_ - alnOps_.bStart_)) {
+						comp_.highQualityMatches_++;
+					} else {
+						comp_.lowQualityMatches_++;
+					}
+				}
+			} else {
+				comp_.highQualityMatches_ += opStop - opStart;
 			}
-      continue;
-    }
-    if ( 0 > parts_.scoring_.mat_[alignObjectA_.seqBase_.seq_[i]]
-                                 [alignObjectB_.seqBase_.seq_[i]]) {
-			auto firstK = getKmerPos(i - firstOffset, kMaps_.kLength_, objectA.seq_);
-			auto secondK = getKmerPos(i - secondOffset, kMaps_.kLength_, objectB.seq_);
-      if (usingQuality) {
-  			/*if (objectA.checkQual(i - firstOffset, qScorePars_)
-  					&& objectB.checkQual(i - secondOffset, qScorePars_)) {*/
-  			/*if (objectB.checkQual(i - secondOffset, qScorePars_)) {*/
-  			if ( (objectA.cnt_ >= 3 || objectA.checkQual(i - firstOffset, qScorePars_) )
-  					&& objectB.checkQual(i - secondOffset, qScorePars_)) {
-
-          if (checkKmer &&
-              (kMaps_.isKmerLowFreq(firstK)
-  								|| kMaps_.isKmerLowFreq(secondK))) {
-            ++comp_.lowKmerMismatches_;
-            comp_.distances_.lowKmerMismatches_.insert(std::make_pair(
-                i,
-                mismatch(
-                    alignObjectA_.seqBase_.seq_[i], alignObjectA_.seqBase_.qual_[i],
-                    objectA.getLeadQual(i - firstOffset,qScorePars_.qualThresWindow_),
-                    objectA.getTrailQual(i - firstOffset,qScorePars_.qualThresWindow_), i - firstOffset,
-                    alignObjectB_.seqBase_.seq_[i], alignObjectB_.seqBase_.qual_[i],
-                    objectB.getLeadQual(i - secondOffset,qScorePars_.qualThresWindow_),
-                    objectB.getTrailQual(i - secondOffset,qScorePars_.qualThresWindow_), i - secondOffset,
-										kMaps_.kmersByPos_->getKmerFreq(secondK),
-										kMaps_.kmersNoPos_->getKmerFreq(secondK))));
-          } else {
-            ++comp_.hqMismatches_;
-            comp_.distances_.mismatches_.insert(std::make_pair(
-                          i,
-                          mismatch(
-                              alignObjectA_.seqBase_.seq_[i], alignObjectA_.seqBase_.qual_[i],
-                              objectA.getLeadQual(i - firstOffset,qScorePars_.qualThresWindow_),
-                              objectA.getTrailQual(i - firstOffset,qScorePars_.qualThresWindow_), i - firstOffset,
-                              alignObjectB_.seqBase_.seq_[i], alignObjectB_.seqBase_.qual_[i],
-                              objectB.getLeadQual(i - secondOffset,qScorePars_.qualThresWindow_),
-                              objectB.getTrailQual(i - secondOffset,qScorePars_.qualThresWindow_), i - secondOffset,
-															kMaps_.kmersByPos_->getKmerFreq(secondK),
-															kMaps_.kmersNoPos_->getKmerFreq(secondK))));
-          }
-        } else {
-        	comp_.distances_.mismatches_.insert(std::make_pair(
-              i,
-              mismatch(
-                  alignObjectA_.seqBase_.seq_[i], alignObjectA_.seqBase_.qual_[i],
-                  objectA.getLeadQual(i - firstOffset,qScorePars_.qualThresWindow_),
-                  objectA.getTrailQual(i - firstOffset,qScorePars_.qualThresWindow_), i - firstOffset,
-                  alignObjectB_.seqBase_.seq_[i], alignObjectB_.seqBase_.qual_[i],
-                  objectB.getLeadQual(i - secondOffset,qScorePars_.qualThresWindow_),
-                  objectB.getTrailQual(i - secondOffset,qScorePars_.qualThresWindow_), i - secondOffset,
-                  kMaps_.kmersByPos_->getKmerFreq(secondK),
-									kMaps_.kmersNoPos_->getKmerFreq(secondK))));
-          ++comp_.lqMismatches_;
-        }
-      } else {
-        if (checkKmer &&
-            (kMaps_.isKmerLowFreq(firstK)
-								|| kMaps_.isKmerLowFreq(secondK))) {
-          ++comp_.lowKmerMismatches_;
-          comp_.distances_.lowKmerMismatches_.insert(std::make_pair(
-              i,
-              mismatch(
-                  alignObjectA_.seqBase_.seq_[i], alignObjectA_.seqBase_.qual_[i],
-                  objectA.getLeadQual(i - firstOffset,qScorePars_.qualThresWindow_),
-                  objectA.getTrailQual(i - firstOffset,qScorePars_.qualThresWindow_), i - firstOffset,
-                  alignObjectB_.seqBase_.seq_[i], alignObjectB_.seqBase_.qual_[i],
-                  objectB.getLeadQual(i - secondOffset,qScorePars_.qualThresWindow_),
-                  objectB.getTrailQual(i - secondOffset,qScorePars_.qualThresWindow_), i - secondOffset,
+			continue;
+		}
+		for (uint32_t i = opStart; i < opStop; ++i) {
+			const uint32_t aPos = op.aPos_ + i - op.alnPos_;
+			const uint32_t bPos = op.bPos_ + i - op.alnPos_;
+			//relative positions are the same as positions in the gapped sequences
+			const uint32_t aRelPos = aPos - alnOps_.aStart_;
+			const uint32_t bRelPos = bPos - alnOps_.bStart_;
+			const bool lowQuality = usingQuality
+					&& !((objectA.cnt_ >= 3 || qualCheckA_.checkQual(aRelPos))
+							&& qualCheckB_.checkQual(bRelPos));
+			if (!profileDetails_ && (lowQuality || !checkKmer)) {
+				//no need for the kmers
+				++(lowQuality ? comp_.lqMismatches_ : comp_.hqMismatches_);
+				continue;
+			}
+			auto firstK = getKmerPos(aRelPos, kMaps_.kLength_, objectA.seq_);
+			auto secondK = getKmerPos(bRelPos, kMaps_.kLength_, objectB.seq_);
+			const bool lowKmer = !lowQuality && checkKmer
+					&& (kMaps_.isKmerLowFreq(firstK) || kMaps_.isKmerLowFreq(secondK));
+			if (lowQuality) {
+				++comp_.lqMismatches_;
+			} else if (lowKmer) {
+				++comp_.lowKmerMismatches_;
+			} else {
+				++comp_.hqMismatches_;
+			}
+			if (!profileDetails_) {
+				continue;
+			}
+			(lowKmer ? comp_.distances_.lowKmerMismatches_ : comp_.distances_.mismatches_).insert(
+					std::make_pair(i,
+							mismatch(
+									seqA.seq_[aPos], seqA.qual_[aPos],
+									objectA.getLeadQual(aRelPos,qScorePars_.qualThresWindow_),
+									objectA.getTrailQual(aRelPos,qScorePars_.qualThresWindow_), aRelPos,
+									seqB.seq_[bPos], seqB.qual_[bPos],
+									objectB.getLeadQual(bRelPos,qScorePars_.qualThresWindow_),
+									objectB.getTrailQual(bRelPos,qScorePars_.qualThresWindow_), bRelPos,
 									kMaps_.kmersByPos_->getKmerFreq(secondK),
 									kMaps_.kmersNoPos_->getKmerFreq(secondK))));
-        } else {
-          ++comp_.hqMismatches_;
-          comp_.distances_.mismatches_.insert(std::make_pair(
-                        i,
-                        mismatch(
-                            alignObjectA_.seqBase_.seq_[i], alignObjectA_.seqBase_.qual_[i],
-                            objectA.getLeadQual(i - firstOffset,qScorePars_.qualThresWindow_),
-                            objectA.getTrailQual(i - firstOffset,qScorePars_.qualThresWindow_), i - firstOffset,
-                            alignObjectB_.seqBase_.seq_[i], alignObjectB_.seqBase_.qual_[i],
-                            objectB.getLeadQual(i - secondOffset,qScorePars_.qualThresWindow_),
-                            objectB.getTrailQual(i - secondOffset,qScorePars_.qualThresWindow_), i - secondOffset,
-														kMaps_.kmersByPos_->getKmerFreq(secondK),
-														kMaps_.kmersNoPos_->getKmerFreq(secondK))));
-        }
-      }
-    } else {
-      if (usingQuality) {
-        if (doingMatchQuality) {
-          if (objectA.checkQual(i - firstOffset, qScorePars_) &&
-              objectB.checkQual(i - secondOffset, qScorePars_)) {
-            comp_.highQualityMatches_++;
-          } else {
-            comp_.lowQualityMatches_++;
-          }
-        } else {
-          comp_.highQualityMatches_++;
-        }
-      } else {
-        ++comp_.highQualityMatches_;
-      }
-    }
-  }
-
-	uint32_t gappedLeftEndA = 0;
-	uint32_t gappedRightEndA = 0;
-	if (alignObjectA_.seqBase_.seq_.front() == '-') {
-		gappedLeftEndA += countBeginChar(alignObjectA_.seqBase_.seq_);
-	}
-	if (alignObjectA_.seqBase_.seq_.back() == '-') {
-		gappedRightEndA += countEndChar(alignObjectA_.seqBase_.seq_);
-	}
-	uint32_t gappedEndA = gappedRightEndA + gappedLeftEndA;
-
-	uint32_t gappedLeftEndB = 0;
-	uint32_t gappedRightEndB = 0;
-	if (alignObjectB_.seqBase_.seq_.front() == '-') {
-		gappedLeftEndB += countBeginChar(alignObjectB_.seqBase_.seq_);
-	}
-	if (alignObjectB_.seqBase_.seq_.back() == '-') {
-		gappedRightEndB += countEndChar(alignObjectB_.seqBase_.seq_);
+		}
 	}
-	uint32_t gappedEndB = gappedLeftEndB + gappedRightEndB;
-
-	uint32_t gappedEnd = gappedEndA + gappedEndB;
-
-	//objectA (ref)
-	comp_.distances_.ref_.covered_ = len(alignObjectA_) - gappedBasesInA - gappedEnd;
-	comp_.distances_.ref_.coverage_ = static_cast<double>(comp_.distances_.ref_.covered_)/len(objectA);
-	comp_.distances_.ref_.identities_ = comp_.highQualityMatches_ + comp_.lowQualityMatches_;
-	comp_.distances_.ref_.identity_ = static_cast<double>(comp_.distances_.ref_.identities_)/len(objectA);
-	//objectB (query)
-	comp_.distances_.query_.covered_ = len(alignObjectB_) - gappedBasesInB - gappedEnd;
-	comp_.distances_.query_.coverage_ = static_cast<double>(comp_.distances_.query_.covered_)/len(objectB);
-	comp_.distances_.query_.identities_ = comp_.highQualityMatches_ + comp_.lowQualityMatches_;
-	comp_.distances_.query_.identity_ = static_cast<double>(comp_.distances_.query_.identities_)/len(objectB);
-	//of the overlapping alignment
-	comp_.distances_.basesInAln_ = len(alignObjectA_) - gappedEnd;
-  comp_.distances_.percentMatch_ = (comp_.highQualityMatches_ + comp_.lowQualityMatches_)/static_cast<double>(comp_.distances_.basesInAln_);
-  comp_.distances_.percentMismatch_ = (comp_.hqMismatches_ + comp_.lqMismatches_)/static_cast<double>(comp_.distances_.basesInAln_);
-  comp_.distances_.percentGaps_ = (gappedBasesInA + gappedBasesInB)/static_cast<double>(comp_.distances_.basesInAln_);
-  comp_.distances_.overLappingEvents_ = comp_.highQualityMatches_
-			+ comp_.lowQualityMatches_ + comp_.hqMismatches_ + comp_.lqMismatches_
-			+ comp_.lowKmerMismatches_ + comp_.distances_.alignmentGaps_.size();
-  if(comp_.distances_.overLappingEvents_ == 0){
-  		comp_.distances_.eventBasedIdentity_ = 0;
-  }else{
-  		comp_.distances_.eventBasedIdentity_ = (comp_.highQualityMatches_ + comp_.lowQualityMatches_)/static_cast<double>(comp_.distances_.overLappingEvents_);
-  }
-  comp_.setEventBaseIdentityHq();
-  comp_.refName_ = objectA.name_;
-  comp_.queryName_ = objectB.name_;
-  comp_.alnScore_ = parts_.score_;
+	setAlnOpsDistances(objectA, objectB, gappedBasesInA, gappedBasesInB, gapEvents);
   return comp_;
 }
 
 
-
-
-
-
-
-
 comparison aligner::compareAlignment(
     const seqInfo& objectA, const seqInfo& objectB,
     bool checkKmers) {
 
-	resetAlignmentInfo();;
-	uint32_t firstOffset = 0;
-	uint32_t secondOffset = 0;
+	resetAlignmentInfo();
+	const auto alnSeqs = getAlnOpsSeqs(objectA, objectB);
+	const seqInfo & seqA = *alnSeqs.first;
+	const seqInfo & seqB = *alnSeqs.second;
+	qualCheckA_.setQual(objectA.qual_, qScorePars_);
+	qualCheckB_.setQual(objectB.qual_, qScorePars_);
   uint32_t gappedBasesInA  = 0;
   uint32_t gappedBasesInB  = 0;
-  uint32_t numberOfGaps = 0;
-  for (uint32_t i = 0; i < len(alignObjectA_); ++i) {
-  	//gap in alignObjectA, normally reference sequence
-    if (alignObjectA_.seqBase_.seq_[i] == '-') {
-    	++numberOfGaps;
-      ++firstOffset;
-			gap newGap = gap(i, getSeqPosForAlnAPos(i), getSeqPosForAlnBPos(i),
-					alignObjectB_.seqBase_.seq_.substr(i, 1),
-					alignObjectB_.seqBase_.qual_[i], true);
-      while (alignObjectA_.seqBase_.seq_[i + 1] == '-') {
-        newGap.gapedSequence_.append(
-            alignObjectB_.seqBase_.seq_.substr(i + 1, 1));
-        ++newGap.size_;
-        //newGap.qualities_.emplace_back(alignObjectB_.seqBase_.qual_[i + 1]);
-        ++i;
-        ++firstOffset;
-      }
-      bool endGap = (newGap.startPos_ + newGap.size_ >= len(alignObjectA_)) || 0 == newGap.startPos_;
+  uint32_t gapEvents = 0;
+	for (const auto & op : alnOps_.ops_) {
+		//gap in A (normally reference sequence) or in B (normally query sequence)
+		if (!op.consumesA() || !op.consumesB()) {
+			bool endGap = op.alnEnd() >= alnOps_.alnLength_ || 0 == op.alnPos_;
 			if (!endGap) {
-				gappedBasesInA += newGap.size_;
-				++numberOfGaps;
-				handleGapCountingInA(newGap);
-				comp_.distances_.alignmentGaps_.insert(
-						std::make_pair(newGap.startPos_, newGap));
+				handleAlnOpsGapCounting(op, op.alnPos_, seqA, seqB);
+				if (op.consumesA()) {
+					gappedBasesInB += op.length_;
+				} else {
+					gappedBasesInA += op.length_;
+					++gapEvents;
+					if (profileDetails_) {
+						comp_.distances_.alignmentGaps_.insert(
+								std::make_pair(op.alnPos_, getAlnOpsGap(op, op.alnPos_, seqA, seqB, false)));
+					}
+				}
 			} else if (countEndGaps_) {
-				++numberOfGaps;
-				handleGapCountingInA(newGap);
+				handleAlnOpsGapCounting(op, op.alnPos_, seqA, seqB);
 			}
-      continue;
-    }
-    //gap in alignObjectB, normally query sequence
-    if (alignObjectB_.seqBase_.seq_[i] == '-') {
-      ++secondOffset;
-			gap newGap = gap(i, getSeqPosForAlnAPos(i), getSeqPosForAlnBPos(i),
-					alignObjectA_.seqBase_.seq_.substr(i, 1),
-					alignObjectA_.seqBase_.qual_[i], false);
-      while (alignObjectB_.seqBase_.seq_[i + 1] == '-') {
-        newGap.gapedSequence_.append(
-            alignObjectA_.seqBase_.seq_.substr(i + 1, 1));
-        ++newGap.size_;
-        //newGap.qualities_.emplace_back(alignObjectA_.seqBase_.qual_[i + 1]);
-        ++i;
-        ++secondOffset;
-      }
-      bool endGap = (newGap.startPos_ + newGap.size_ >= alignObjectB_.seqBase_.seq_.length()) || 0 == newGap.startPos_;
-			if (!endGap) {
-				++numberOfGaps;
-				gappedBasesInB += newGap.size_;
-				handleGapCountingInB(newGap);
-			} else if (countEndGaps_) {
-				++numberOfGaps;
-				handleGapCountingInB(newGap);
+			continue;
+		}
+		/**@todo consider changing this to be scoringMatrix_[A][B] < 0
+		 *  instead to allow custom scoring matrix scores to determine mismatch */
+		for (uint32_t i = op.alnPos_; i < op.alnEnd(); ++i) {
+			const uint32_t aPos = op.aPos_ + i - op.alnPos_;
+			const uint32_t bPos = op.bPos_ + i - op.alnPos_;
+			if (seqA.seq_[aPos] == seqB.seq_[bPos]) {
+				++comp_.highQualityMatches_;
+				continue;
 			}
-      continue;
-    }
-    /**@todo consider changing this to be scoringMatrix_[A][B] < 0
-     *  instead to allow custom scoring matrix scores to determine mismatch */
-		if (alignObjectA_.seqBase_.seq_[i] != alignObjectB_.seqBase_.seq_[i]) {
-			/*if (objectA.checkQual(i - firstOffset, qScorePars_)
-					&& objectB.checkQual(i - secondOffset, qScorePars_)) {*/
-			/*if (objectB.checkQual(i - secondOffset, qScorePars_)) {*/
-			if ( (objectA.cnt_ >= 3 || objectA.checkQual(i - firstOffset, qScorePars_) )
-					&& objectB.checkQual(i - secondOffset, qScorePars_)) {
-				auto firstK = getKmerPos(i - firstOffset, kMaps_.kLength_,
-						objectA.seq_);
-				auto secondK = getKmerPos(i - secondOffset, kMaps_.kLength_,
-						objectB.seq_);
+			const uint32_t aRelPos = aPos - alnOps_.aStart_;
+			const uint32_t bRelPos = bPos - alnOps_.bStart_;
+			if ( (objectA.cnt_ >= 3 || qualCheckA_.checkQual(aRelPos) )
+					&& qualCheckB_.checkQual(bRelPos)) {
 				if (checkKmers
-						&& (kMaps_.isKmerLowFreq(firstK)
-								|| kMaps_.isKmerLowFreq(secondK))) {
+						&& (kMaps_.isKmerLowFreq(getKmerPos(aRelPos, kMaps_.kLength_, objectA.seq_))
+								|| kMaps_.isKmerLowFreq(getKmerPos(bRelPos, kMaps_.kLength_, objectB.seq_)))) {
 					++comp_.lowKmerMismatches_;
 				} else {
 					++comp_.hqMismatches_;
@@ -838,213 +740,131 @@ comparison aligner::compareAlignment(
 			} else {
 				++comp_.lqMismatches_;
 			}
-		} else {
-			++comp_.highQualityMatches_;
 		}
-  }
-
-
-	uint32_t gappedLeftEndA = 0;
-	uint32_t gappedRightEndA = 0;
-	if (alignObjectA_.seqBase_.seq_.front() == '-') {
-		gappedLeftEndA += countBeginChar(alignObjectA_.seqBase_.seq_);
 	}
-	if (alignObjectA_.seqBase_.seq_.back() == '-') {
-		gappedRightEndA += countEndChar(alignObjectA_.seqBase_.seq_);
-	}
-	uint32_t gappedEndA = gappedRightEndA + gappedLeftEndA;
-
-	uint32_t gappedLeftEndB = 0;
-	uint32_t gappedRightEndB = 0;
-	if (alignObjectB_.seqBase_.seq_.front() == '-') {
-		gappedLeftEndB += countBeginChar(alignObjectB_.seqBase_.seq_);
-	}
-	if (alignObjectB_.seqBase_.seq_.back() == '-') {
-		gappedRightEndB += countEndChar(alignObjectB_.seqBase_.seq_);
-	}
-	uint32_t gappedEndB = gappedLeftEndB + gappedRightEndB;
-
-	uint32_t gappedEnd = gappedEndA + gappedEndB;
-
-	//objectA (ref)
-	comp_.distances_.ref_.covered_ = len(alignObjectA_) - gappedBasesInA - gappedEnd;
-	comp_.distances_.ref_.coverage_ = static_cast<double>(comp_.distances_.ref_.covered_)/len(objectA);
-	comp_.distances_.ref_.identities_ = comp_.highQualityMatches_ + comp_.lowQualityMatches_;
-	comp_.distances_.ref_.identity_ = static_cast<double>(comp_.distances_.ref_.identities_)/len(objectA);
-	//objectB (query)
-	comp_.distances_.query_.covered_ = len(alignObjectB_) - gappedBasesInB - gappedEnd;
-	comp_.distances_.query_.coverage_ = static_cast<double>(comp_.distances_.query_.covered_)/len(objectB);
-	comp_.distances_.query_.identities_ = comp_.highQualityMatches_ + comp_.lowQualityMatches_;
-	comp_.distances_.query_.identity_ = static_cast<double>(comp_.distances_.query_.identities_)/len(objectB);
-	//of the overlapping alignment
-	comp_.distances_.basesInAln_ = len(alignObjectA_) - gappedEnd;
-  comp_.distances_.percentMatch_ = (comp_.highQualityMatches_ + comp_.lowQualityMatches_)/static_cast<double>(comp_.distances_.basesInAln_);
-  comp_.distances_.percentMismatch_ = (comp_.hqMismatches_ + comp_.lqMismatches_)/static_cast<double>(comp_.distances_.basesInAln_);
-  comp_.distances_.percentGaps_ = (gappedBasesInA + gappedBasesInB)/static_cast<double>(comp_.distances_.basesInAln_);
-  comp_.distances_.overLappingEvents_ = comp_.highQualityMatches_
-			+ comp_.lowQualityMatches_ + comp_.hqMismatches_ + comp_.lqMismatches_
-			+ comp_.lowKmerMismatches_ + comp_.distances_.alignmentGaps_.size();
-  if(comp_.distances_.overLappingEvents_ == 0){
-  	comp_.distances_.eventBasedIdentity_ = 0;
-  }else{
-  	comp_.distances_.eventBasedIdentity_ = (comp_.highQualityMatches_ + comp_.lowQualityMatches_)/static_cast<double>(comp_.distances_.overLappingEvents_);
-  }
-  comp_.setEventBaseIdentityHq();
-  comp_.refName_ = objectA.name_;
-  comp_.queryName_ = objectB.name_;
-  comp_.alnScore_ = parts_.score_;
+	setAlnOpsDistances(objectA, objectB, gappedBasesInA, gappedBasesInB, gapEvents);
   return comp_;
 }
 
-void aligner::handleGapCountingInA(gap& currentGap) {
-	if (!seqUtil::isHomopolyer(currentGap.gapedSequence_) || !weighHomopolymers_) {
-		if (currentGap.size_ >= 3) {
+template<typename GAPPED, typename OTHER>
+void aligner::handleGapCounting(uint32_t startPos, uint32_t size,
+		char gappedBase, bool homopolymer, uint32_t alnLength,
+		const GAPPED & gappedAt, const OTHER & otherAt) {
+	if (!homopolymer || !weighHomopolymers_) {
+		if (size >= 3) {
 			++comp_.largeBaseIndel_;
-		} else if (currentGap.size_ == 2) {
+		} else if (size == 2) {
 			++comp_.twoBaseIndel_;
-		} else if (currentGap.size_ == 1) {
+		} else if (size == 1) {
 			++comp_.oneBaseIndel_;
 		}
 	} else {
-		uint32_t alnABases = 0;
-		uint32_t alnBBases = 0;
+		uint32_t gappedBases = 0;
+		uint32_t otherBases = 0;
 		// forwards
 		uint32_t cursor = 0;
-		while ((currentGap.startPos_ + currentGap.size_ + cursor)
-				< alignObjectA_.seqBase_.seq_.size()
-				&& alignObjectA_.seqBase_.seq_[currentGap.startPos_ + currentGap.size_
-						+ cursor] == currentGap.gapedSequence_[0]) {
-			++alnABases;
+		while ((startPos + size + cursor) < alnLength
+				&& gappedAt(startPos + size + cursor) == gappedBase) {
+			++gappedBases;
 			++cursor;
 		}
 		cursor = 1;
 		// backwards
-		while (cursor <= currentGap.startPos_
-				&& alignObjectA_.seqBase_.seq_[currentGap.startPos_ - cursor]
-						== currentGap.gapedSequence_[0]) {
-			++alnABases;
+		while (cursor <= startPos
+				&& gappedAt(startPos - cursor) == gappedBase) {
+			++gappedBases;
 			++cursor;
 		}
 		cursor = 0;
 		// forwards
-		while ((currentGap.startPos_ + cursor) < alignObjectB_.seqBase_.seq_.size()
-				&& alignObjectB_.seqBase_.seq_[currentGap.startPos_ + cursor]
-						== currentGap.gapedSequence_[0]) {
-			++alnBBases;
+		while ((startPos + cursor) < alnLength
+				&& otherAt(startPos + cursor) == gappedBase) {
+			++otherBases;
 			++cursor;
 		}
 		cursor = 1;
 		// backwards
-		while (cursor <= currentGap.startPos_
-				&& alignObjectB_.seqBase_.seq_[currentGap.startPos_ - cursor]
-						== currentGap.gapedSequence_[0]) {
-			++alnBBases;
+		while (cursor <= startPos
+				&& otherAt(startPos - cursor) == gappedBase) {
+			++otherBases;
 			++cursor;
 		}
 		//if it is a whole chuck of homopolymer missing, no weighting
-		if (alnBBases == 0 || alnABases == 0) {
-			if (currentGap.size_ >= 3) {
+		if (gappedBases == 0 || otherBases == 0) {
+			if (size >= 3) {
 				++comp_.largeBaseIndel_;
-			} else if (currentGap.size_ == 2) {
+			} else if (size == 2) {
 				++comp_.twoBaseIndel_;
-			} else if (currentGap.size_ == 1) {
+			} else if (size == 1) {
 				++comp_.oneBaseIndel_;
 			}
 		} else {
-			/*double currentScore = currentGap.size_
-					/ ((alnABases * alignObjectA_.seqBase_.cnt_
-							+ alnBBases * alignObjectB_.seqBase_.cnt_)
-							/ (alignObjectA_.seqBase_.cnt_ + alignObjectB_.seqBase_.cnt_));*/
-			double currentScore = currentGap.size_ / static_cast<double>(alnABases + alnBBases);
-			if (currentGap.size_ >= 3) {
+			double currentScore = size / static_cast<double>(gappedBases + otherBases);
+			if (size >= 3) {
 				if (currentScore > 1) {
 					++comp_.largeBaseIndel_;
 				} else {
 					comp_.largeBaseIndel_ += currentScore;
 				}
-			} else if (currentGap.size_ == 2) {
+			} else if (size == 2) {
 				comp_.twoBaseIndel_ += currentScore;
-			} else if (currentGap.size_ == 1) {
+			} else if (size == 1) {
 				comp_.oneBaseIndel_ += currentScore;
 			}
 		}
 	}
 }
-void aligner::handleGapCountingInB(gap& currentGap) {
-	if (!seqUtil::isHomopolyer(currentGap.gapedSequence_) || !weighHomopolymers_) {
-		if (currentGap.size_ >= 3) {
-			++comp_.largeBaseIndel_;
-		} else if (currentGap.size_ == 2) {
-			++comp_.twoBaseIndel_;
-		} else if (currentGap.size_ == 1) {
-			++comp_.oneBaseIndel_;
+
+void aligner::handleAlnOpsGapCounting(const AlignmentOps::Op & op,
+		uint32_t start, const seqInfo & seqA, const seqInfo & seqB) {
+	const uint32_t size = op.alnEnd() - start;
+	//the gapped bases come from the sequence without the gap
+	const bool gapInA = AlignmentOps::OpType::INSERTION == op.type_;
+	const std::string & gappedFrom = gapInA ? seqB.seq_ : seqA.seq_;
+	const uint32_t gappedFromPos = (gapInA ? op.bPos_ : op.aPos_) + start - op.alnPos_;
+	const char gappedBase = gappedFrom[gappedFromPos];
+	bool homopolymer = true;
+	for (uint32_t pos = gappedFromPos + 1; pos < gappedFromPos + size; ++pos) {
+		if (gappedFrom[pos] != gappedBase) {
+			homopolymer = false;
+			break;
 		}
+	}
+	auto alnAAt = [this, &seqA](uint32_t alnPos) {
+		return alnOps_.getAlnA(seqA.seq_, alnPos, '-');
+	};
+	auto alnBAt = [this, &seqB](uint32_t alnPos) {
+		return alnOps_.getAlnB(seqB.seq_, alnPos, '-');
+	};
+	if (gapInA) {
+		handleGapCounting(start, size, gappedBase, homopolymer,
+				alnOps_.alnLength_, alnAAt, alnBAt);
 	} else {
-		uint32_t alnABases = 0;
-		uint32_t alnBBases = 0;
-		// forwards
-		uint32_t cursor = 0;
-		while ((currentGap.startPos_ + currentGap.size_ + cursor)
-				< alignObjectB_.seqBase_.seq_.size()
-				&& alignObjectB_.seqBase_.seq_[currentGap.startPos_ + currentGap.size_
-						+ cursor] == currentGap.gapedSequence_[0]) {
-			++alnBBases;
-			++cursor;
-		}
-		cursor = 1;
-		// backwards
-		while (cursor <= currentGap.startPos_
-				&& alignObjectB_.seqBase_.seq_[currentGap.startPos_ - cursor]
-						== currentGap.gapedSequence_[0]) {
-			++alnBBases;
-			++cursor;
-		}
-		cursor = 0;
-		// forwards
-		while ((currentGap.startPos_ + cursor) < alignObjectA_.seqBase_.seq_.size()
-				&& alignObjectA_.seqBase_.seq_[currentGap.startPos_ + cursor]
-						== currentGap.gapedSequence_[0]) {
-			++alnABases;
-			++cursor;
-		}
-		cursor = 1;
-		// backwards
-		while (cursor <= currentGap.startPos_
-				&& alignObjectA_.seqBase_.seq_[currentGap.startPos_ - cursor]
-						== currentGap.gapedSequence_[0]) {
-			++alnABases;
-			++cursor;
-		}
-		//if it is a whole chuck of homopolymer missing, no weighting
-		if (alnBBases == 0 || alnABases == 0) {
-			if (currentGap.size_ >= 3) {
-				++comp_.largeBaseIndel_;
-			} else if (currentGap.size_ == 2) {
-				++comp_.twoBaseIndel_;
-			} else if (currentGap.size_ == 1) {
-				++comp_.oneBaseIndel_;
-			}
-		} else {
-			/*double currentScore = currentGap.size_
-					/ ((alnABases * alignObjectA_.seqBase_.cnt_
-							+ alnBBases * alignObjectB_.seqBase_.cnt_)
-							/ (alignObjectA_.seqBase_.cnt_ + alignObjectB_.seqBase_.cnt_));*/
-			double currentScore = currentGap.size_ / static_cast<double>(alnABases + alnBBases);
-			if (currentGap.size_ >= 3) {
-				if (currentScore > 1) {
-					++comp_.largeBaseIndel_;
-				} else {
-					comp_.largeBaseIndel_ += currentScore;
-				}
-			} else if (currentGap.size_ == 2) {
-				comp_.twoBaseIndel_ += currentScore;
-			} else if (currentGap.size_ == 1) {
-				comp_.oneBaseIndel_ += currentScore;
-			}
-		}
+		handleGapCounting(start, size, gappedBase, homopolymer,
+				alnOps_.alnLength_, alnBAt, alnAAt);
 	}
 }
 
+void aligner::handleGapCountingInA(gap& currentGap) {
+	const auto & alnA = alignObjectA_.seqBase_.seq_;
+	const auto & alnB = alignObjectB_.seqBase_.seq_;
+	handleGapCounting(currentGap.startPos_, currentGap.size_,
+			currentGap.gapedSequence_[0],
+			seqUtil::isHomopolyer(currentGap.gapedSequence_), alnA.size(),
+			[&alnA](uint32_t alnPos) {return alnA[alnPos];},
+			[&alnB](uint32_t alnPos) {return alnB[alnPos];});
+}
+
+void aligner::handleGapCountingInB(gap& currentGap) {
+	const auto & alnA = alignObjectA_.seqBase_.seq_;
+	const auto & alnB = alignObjectB_.seqBase_.seq_;
+	handleGapCounting(currentGap.startPos_, currentGap.size_,
+			currentGap.gapedSequence_[0],
+			seqUtil::isHomopolyer(currentGap.gapedSequence_), alnB.size(),
+			[&alnB](uint32_t alnPos) {return alnB[alnPos];},
+			[&alnA](uint32_t alnPos) {return alnA[alnPos];});
+}
+
 void aligner::outPutParameterInfo(std::ostream& out) const {
   out << "numberOfOneIndel:" << comp_.oneBaseIndel_
       << " numberOfTwoIndel:" << comp_.twoBaseIndel_
@@ -1400,7 +1220,7 @@ void aligner::scoreAlignment(bool editTheSame) {
         //++editDistance_;
       }
     }
-    parts_.score_ += parts_.scoring_.mat_[alignObjectA_.seqBase_.seq_[i]]
+    parts_.score_ += parts_.getScoring().mat_[alignObjectA_.seqBase_.seq_[i]]
                            [alignObjectB_.seqBase_.seq_[i]];
   }
   comp_.alnScore_ = parts_.score_;
@@ -1408,6 +1228,7 @@ void aligner::scoreAlignment(bool editTheSame) {
 
 void aligner::noAlignSetAndScore(const seqInfo& objectA,
 		const seqInfo& objectB) {
+	alnOpsOnly_ = false;
 	alignObjectA_.seqBase_ = objectA;
 	alignObjectB_.seqBase_ = objectB;
 
@@ -1489,7 +1310,7 @@ void aligner::setDefaultQualities() {
 };
 
 void aligner::setGeneralScorring(int32_t generalMatch, int32_t generalMismatch){
-	parts_.scoring_ = substituteMatrix(generalMatch, generalMismatch);
+	parts_.setScoring(substituteMatrix(generalMatch, generalMismatch));
 }
 
 
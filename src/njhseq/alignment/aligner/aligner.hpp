@@ -26,6 +26,7 @@
 #include "njhseq/alignment/alignerUtils.h"
 #include "njhseq/alignment/alnCache/alnInfoHolder.hpp"
 #include "njhseq/alignment/aligner/alnParts.hpp"
+#include "njhseq/alignment/aligner/AlignmentOps.hpp"
 
 namespace njhseq {
 
@@ -64,6 +65,49 @@ class aligner {
   // to hold the sequence alignments
   baseReadObject alignObjectA_;
   baseReadObject alignObjectB_;
+  /**@brief The last alignment as runs of operations, set by all the align functions that set alignObjectA_ and alignObjectB_
+   *
+   */
+  AlignmentOps alnOps_;
+  /**@brief When false the align functions only set alnOps_ and leave alignObjectA_ and alignObjectB_ as they were, profileAlignment(),
+   * profilePrimerAlignment(), compareAlignment() and the position conversion functions then work off of alnOps_ and the sequences
+   * given to them have to be the ones that were aligned, call buildGappedAlignment() to get the gapped sequences
+   */
+  bool buildGappedAlignment_ = true;
+
+  /**@brief Turns off building the gapped alignment for the life of the guard, for loops that only need the comparison
+   *
+   * The gapped alignment isn't kept once the guard is gone, so align again before using alignObjectA_ and alignObjectB_ after it
+   */
+  class NoGappedAlignmentGuard {
+  public:
+  	explicit NoGappedAlignmentGuard(aligner & alignerObj);
+  	~NoGappedAlignmentGuard();
+  	NoGappedAlignmentGuard(const NoGappedAlignmentGuard & other) = delete;
+  	NoGappedAlignmentGuard & operator=(const NoGappedAlignmentGuard & other) = delete;
+  private:
+  	aligner & alignerObj_;
+  	const bool previous_;
+  };
+
+  /**@brief When false profileAlignment(), profilePrimerAlignment() and compareAlignment() only set the counts and identities in comp_
+   * and leave comp_.distances_.mismatches_, lowKmerMismatches_ and alignmentGaps_ empty, for loops that only filter on the comparison
+   */
+  bool profileDetails_ = true;
+
+  /**@brief Turns off recording the mismatches and gaps when profiling for the life of the guard
+   *
+   */
+  class CountsOnlyProfileGuard {
+  public:
+  	explicit CountsOnlyProfileGuard(aligner & alignerObj);
+  	~CountsOnlyProfileGuard();
+  	CountsOnlyProfileGuard(const CountsOnlyProfileGuard & other) = delete;
+  	CountsOnlyProfileGuard & operator=(const CountsOnlyProfileGuard & other) = delete;
+  private:
+  	aligner & alignerObj_;
+  	const bool previous_;
+  };
 
   alnParts parts_;
   alnInfoMasterHolder alnHolder_;
@@ -170,6 +214,34 @@ class aligner {
 	}
 	void alignRegLocal(const seqInfo & ref, const seqInfo & read);
 
+	/**@brief The results of alignOneToMany()
+	 *
+	 */
+	struct OneToManyAlignments {
+		std::vector<int32_t> scores_; /**< the score of each target, in the order the targets were given */
+		std::vector<uint32_t> best_; /**< the positions in the targets given of the best scoring targets, best first with ties in the order given */
+		std::vector<AlignmentOps> bestAlignments_; /**< the alignment of the target to the query for each of best_ */
+	};
+
+	/**@brief Globally align query against each of targets, the scores are the ones alignCacheGlobal(*targets[pos], query) would give
+	 *
+	 * The scores come from alignCalc::runNeedleScoresOneToMany() which scores several targets at once without a traceback, then the
+	 * topK best are aligned in full with alignScoreCacheGlobal() so parts_ is left set to the last of those, alignObjectA_/alignObjectB_
+	 * and alnOps_ aren't changed
+	 *
+	 * @param query the sequence aligned as the second sequence (the read)
+	 * @param targets the sequences aligned as the first sequence (the refs)
+	 * @param topK the number of best scoring targets to get the full alignments for, 0 for just the scores
+	 * @return the scores and the alignments of the best
+	 */
+	OneToManyAlignments alignOneToMany(const seqInfo & query,
+			const std::vector<const seqInfo *> & targets, uint32_t topK = 0);
+	template<typename READ>
+	OneToManyAlignments alignOneToMany(const READ & query,
+			const std::vector<const seqInfo *> & targets, uint32_t topK = 0){
+		return alignOneToMany(getSeqBase(query), targets, topK);
+	}
+
 	std::pair<uint32_t, uint32_t> findReversePrimer(const std::string& read,
 			const std::string& primer);
 	std::pair<uint32_t, uint32_t> findReversePrimer(const baseReadObject& read,
@@ -197,6 +269,17 @@ class aligner {
 		rearrangeObjs(getSeqBase(ref), getSeqBase(read), local);
 	}
 
+	/**@brief Set alignObjectA_ and alignObjectB_ to the gapped sequences of the last alignment
+	 *
+	 * @param firstRead the first sequence that was aligned
+	 * @param secondRead the second sequence that was aligned
+	 */
+	void buildGappedAlignment(const seqInfo& firstRead, const seqInfo& secondRead);
+	template<typename READ1, typename READ2>
+	void buildGappedAlignment(const READ1 & ref, const READ2 & read){
+		buildGappedAlignment(getSeqBase(ref), getSeqBase(read));
+	}
+
   void noAlignSetAndScore(const seqInfo& objectA,
                           const seqInfo& objectB);
 	template<typename READ1, typename READ2>
@@ -278,6 +361,25 @@ class aligner {
  public:
   void setGeneralScorring(int32_t generalMatch, int32_t generalMismatch);
 
+ private:
+	bool alnOpsOnly_ = false; /**< alnOps_ is the last alignment and alignObjectA_/alignObjectB_ weren't built */
+	seqInfo gaplessA_; /**< reused to hold the sequences alnOps_ is into when it was set from alignObjectA_/alignObjectB_ */
+	seqInfo gaplessB_;
+	QualWindowChecker qualCheckA_; /**< reused to check the qualities of the sequences being profiled */
+	QualWindowChecker qualCheckB_;
+
+	std::pair<const seqInfo *, const seqInfo *> getAlnOpsSeqs(
+			const seqInfo& objectA, const seqInfo& objectB);
+	gap getAlnOpsGap(const AlignmentOps::Op & op, uint32_t start,
+			const seqInfo & seqA, const seqInfo & seqB, bool addQualities) const;
+	void handleAlnOpsGapCounting(const AlignmentOps::Op & op, uint32_t start,
+			const seqInfo & seqA, const seqInfo & seqB);
+	template<typename GAPPED, typename OTHER>
+	void handleGapCounting(uint32_t startPos, uint32_t size, char gappedBase,
+			bool homopolymer, uint32_t alnLength, const GAPPED & gappedAt,
+			const OTHER & otherAt);
+	void setAlnOpsDistances(const seqInfo& objectA, const seqInfo& objectB,
+			uint32_t gappedBasesInA, uint32_t gappedBasesInB, uint32_t gapEvents);
 };
 
 
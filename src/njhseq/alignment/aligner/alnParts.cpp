@@ -35,7 +35,9 @@ alnParts::alnParts(uint64_t maxSize, const gapScoringParameters& gapScores)
     : maxSize_(maxSize + 10),
       gapScores_(gapScores),
       ScoreMatrix_(std::vector<std::vector<scoreMatrixCell>>(
-          maxSize_, std::vector<scoreMatrixCell>(maxSize_))) {}
+          maxSize_, std::vector<scoreMatrixCell>(maxSize_))) {
+	flatScoring_.set(scoring_, flatScoring_.getAlphabet());
+}
 
 
 alnParts::alnParts(uint64_t maxSize, const gapScoringParameters& gapScores,
@@ -44,13 +46,17 @@ alnParts::alnParts(uint64_t maxSize, const gapScoringParameters& gapScores,
       gapScores_(gapScores),
       scoring_(scoring),
       ScoreMatrix_(std::vector<std::vector<scoreMatrixCell>>(
-          maxSize_, std::vector<scoreMatrixCell>(maxSize_))) {}
+          maxSize_, std::vector<scoreMatrixCell>(maxSize_))) {
+	flatScoring_.set(scoring_, flatScoring_.getAlphabet());
+}
 alnParts::alnParts()
     : maxSize_(400),
       gapScores_(gapScoringParameters()),
       scoring_(substituteMatrix(2, -2)),
       ScoreMatrix_(std::vector<std::vector<scoreMatrixCell>>(
-          maxSize_, std::vector<scoreMatrixCell>(maxSize_))) {}
+          maxSize_, std::vector<scoreMatrixCell>(maxSize_))) {
+	flatScoring_.set(scoring_, flatScoring_.getAlphabet());
+}
 
 void alnParts::setMaxSize(uint64_t maxSize){
 	if(maxSize  > maxSize_){
@@ -62,5 +68,14 @@ void alnParts::setMaxSize(uint64_t maxSize){
 	}
 }
 
+void alnParts::setScoring(const substituteMatrix & scoring){
+	scoring_ = scoring;
+	flatScoring_.set(scoring_, flatScoring_.getAlphabet());
+}
+
+void alnParts::setFlatScoringAlphabet(FlatSubstituteMatrix::Alphabet alphabet){
+	flatScoring_.set(scoring_, alphabet);
+}
+
 }  // namespace njhseq
 
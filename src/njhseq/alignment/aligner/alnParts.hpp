@@ -53,13 +53,33 @@ public:
   uint64_t maxSize_;
   // gap scores
   gapScoringParameters gapScores_;
-  substituteMatrix scoring_;
+private:
+  substituteMatrix scoring_; /**< only set through setScoring() so flatScoring_ always matches it */
+  FlatSubstituteMatrix flatScoring_; /**< scoring_ for encoded sequences */
+public:
+  std::vector<uint8_t> encodedA_; /**< reused by alignCalc to hold the encoded sequences */
+  std::vector<uint8_t> encodedB_;
   alnInfoGlobal gHolder_;
   alnInfoLocal lHolder_;
   // the matrix
   std::vector<std::vector<scoreMatrixCell>> ScoreMatrix_;
 
   void setMaxSize(uint64_t maxSize);
+
+  const substituteMatrix & getScoring() const {
+  	return scoring_;
+  }
+  const FlatSubstituteMatrix & getFlatScoring() const {
+  	return flatScoring_;
+  }
+  /**@brief Set scoring_ and rebuild flatScoring_ from it, keeping the current alphabet
+   *
+   */
+  void setScoring(const substituteMatrix & scoring);
+  /**@brief Set flatScoring_ from scoring_ for a different alphabet, sequences with letters outside it are scored with scoring_
+   *
+   */
+  void setFlatScoringAlphabet(FlatSubstituteMatrix::Alphabet alphabet);
 };
 
 }  // namespace njhseq
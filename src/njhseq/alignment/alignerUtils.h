@@ -31,7 +31,9 @@
 #include "njhseq/alignment/alignerUtils/alignerUtils.hpp"
 #include "njhseq/alignment/alignerUtils/gapScoring.hpp"
 #include "njhseq/alignment/alignerUtils/QualScorePars.hpp"
+#include "njhseq/alignment/alignerUtils/QualWindowChecker.hpp"
 #include "njhseq/alignment/alignerUtils/substituteMatrix.hpp"
+#include "njhseq/alignment/alignerUtils/FlatSubstituteMatrix.hpp"
 #include "njhseq/alignment/alignerUtils/mismatch.hpp"
 #include "njhseq/alignment/alignerUtils/gaps.hpp"
 
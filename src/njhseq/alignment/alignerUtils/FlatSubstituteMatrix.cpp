@@ -0,0 +1,155 @@
+/*
+ * FlatSubstituteMatrix.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: nick
+ */
+// njhseq - A library for analyzing sequence data
+// Copyright (C) 2012-2018 Nicholas Hathaway <nicholas.hathaway@umassmed.edu>,
+//
+// This file is part of njhseq.
+//
+// njhseq is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// njhseq is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with njhseq.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "FlatSubstituteMatrix.hpp"
+
+namespace njhseq {
+
+FlatSubstituteMatrix::FlatSubstituteMatrix() {
+	codes_.fill(notInAlphabet_);
+	mat_.fill(0);
+}
+
+FlatSubstituteMatrix::FlatSubstituteMatrix(const substituteMatrix & scoring,
+		Alphabet alphabet) {
+	set(scoring, alphabet);
+}
+
+std::string FlatSubstituteMatrix::getLetters(Alphabet alphabet) {
+	switch (alphabet) {
+	case Alphabet::DNA:
+		return "ACGTN";
+		break;
+	case Alphabet::DEGENERATE_DNA:
+		return "ACGTNRYKMSWBDHV";
+		break;
+	case Alphabet::PROTEIN:
+		return "ACDEFGHIKLMNPQRSTVWYBZX*";
+		break;
+	default: {
+		std::stringstream ss;
+		ss << __PRETTY_FUNCTION__ << ", error " << "unhandled alphabet: "
+				<< static_cast<uint32_t>(alphabet) << "\n";
+		throw std::runtime_error { ss.str() };
+	}
+		break;
+	}
+}
+
+void FlatSubstituteMatrix::set(const substituteMatrix & scoring,
+		Alphabet alphabet) {
+	alphabet_ = alphabet;
+	codes_.fill(notInAlphabet_);
+	mat_.fill(0);
+	const std::string upperLetters = getLetters(alphabet);
+	std::string allLetters = upperLetters;
+	for (const auto letter : upperLetters) {
+		const char lower = static_cast<char>(std::tolower(letter));
+		if (lower != letter) {
+			allLetters.push_back(lower);
+		}
+	}
+	//the letter each code's scores are taken from
+	std::vector<char> codeLetters;
+	for (const auto letter : upperLetters) {
+		codes_[static_cast<unsigned char>(letter)] = codeLetters.size();
+		codeLetters.emplace_back(letter);
+	}
+	for (const auto letter : upperLetters) {
+		const char lower = static_cast<char>(std::tolower(letter));
+		if (lower == letter) {
+			continue;
+		}
+		bool sameScores = true;
+		for (const auto other : allLetters) {
+			if (scoring.mat_[lower][other] != scoring.mat_[letter][other]
+					|| scoring.mat_[other][lower] != scoring.mat_[other][letter]) {
+				sameScores = false;
+				break;
+			}
+		}
+		if (sameScores) {
+			codes_[static_cast<unsigned char>(lower)] = codes_[static_cast<unsigned char>(letter)];
+		} else if (codeLetters.size() < maxCodes_) {
+			codes_[static_cast<unsigned char>(lower)] = codeLetters.size();
+			codeLetters.emplace_back(lower);
+		}
+		//otherwise the lower case letter is left out and sequences with it can't be encoded
+	}
+	numberOfCodes_ = codeLetters.size();
+	for (const auto codeA : iter::range(numberOfCodes_)) {
+		for (const auto codeB : iter::range(numberOfCodes_)) {
+			mat_[codeA * maxCodes_ + codeB] =
+					scoring.mat_[codeLetters[codeA]][codeLetters[codeB]];
+		}
+	}
+	match_ = mat_[0];
+	mismatch_ = mat_[1];
+	simple_ = true;
+	for (const auto codeA : iter::range(numberOfCodes_)) {
+		for (const auto codeB : iter::range(numberOfCodes_)) {
+			if (mat_[codeA * maxCodes_ + codeB] != (codeA == codeB ? match_ : mismatch_)) {
+				simple_ = false;
+				break;
+			}
+		}
+		if (!simple_) {
+			break;
+		}
+	}
+}
+
+bool FlatSubstituteMatrix::encode(const std::string & seq,
+		std::vector<uint8_t> & codes) const {
+	codes.resize(seq.size());
+	uint8_t missing = 0;
+	for (const auto pos : iter::range(seq.size())) {
+		codes[pos] = codes_[static_cast<unsigned char>(seq[pos])];
+		//branch free so the loop can be vectorized, notInAlphabet_ is the only code with the high bit set
+		missing |= codes[pos];
+	}
+	return 0 == (missing & 128);
+}
+
+FlatSubstituteMatrix::Alphabet FlatSubstituteMatrix::getAlphabet() const {
+	return alphabet_;
+}
+
+uint32_t FlatSubstituteMatrix::numberOfCodes() const {
+	return numberOfCodes_;
+}
+
+bool FlatSubstituteMatrix::isSimple() const {
+	return simple_;
+}
+
+int32_t FlatSubstituteMatrix::getMatch() const {
+	return match_;
+}
+
+int32_t FlatSubstituteMatrix::getMismatch() const {
+	return mismatch_;
+}
+
+}  // namespace njhseq
@@ -0,0 +1,107 @@
+#pragma once
+/*
+ * FlatSubstituteMatrix.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: nick
+ */
+// njhseq - A library for analyzing sequence data
+// Copyright (C) 2012-2018 Nicholas Hathaway <nicholas.hathaway@umassmed.edu>,
+//
+// This file is part of njhseq.
+//
+// njhseq is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// njhseq is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with njhseq.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "njhseq/alignment/alignerUtils/substituteMatrix.hpp"
+
+namespace njhseq {
+
+/**@brief A substituteMatrix for a small alphabet, letters are encoded to small integer codes and the scores kept in one flat cache aligned table
+ *
+ * Set from a substituteMatrix and gives exactly the scores it gives for every letter of the alphabet, a lower case letter shares the code of
+ * its upper case letter when the matrix scores them the same, sequences with a letter not in the alphabet can't be encoded and should be scored
+ * with the substituteMatrix instead. Has to be set again if the substituteMatrix it was set from is changed
+ *
+ */
+class FlatSubstituteMatrix {
+public:
+
+	enum class Alphabet : uint8_t {
+		DNA, /**< ACGTN */
+		DEGENERATE_DNA, /**< ACGTN and the IUPAC degenerate bases */
+		PROTEIN /**< the 20 amino acids plus B, Z, X and the stop * */
+	};
+
+	static constexpr uint32_t maxCodes_ = 32; /**< the most codes an alphabet can have, also the row length of the table */
+	static constexpr uint8_t notInAlphabet_ = 255;
+
+	/**@brief An empty matrix, nothing can be encoded until set
+	 *
+	 */
+	FlatSubstituteMatrix();
+	FlatSubstituteMatrix(const substituteMatrix & scoring, Alphabet alphabet);
+
+	/**@brief Set the codes and scores for alphabet from scoring
+	 *
+	 * @param scoring the scores to copy
+	 * @param alphabet the letters to encode
+	 */
+	void set(const substituteMatrix & scoring, Alphabet alphabet);
+
+	/**@brief Encode seq into codes
+	 *
+	 * @param seq the sequence to encode
+	 * @param codes filled with the code of each letter
+	 * @return false if seq has a letter not in the alphabet, codes is then not usable
+	 */
+	bool encode(const std::string & seq, std::vector<uint8_t> & codes) const;
+
+	int32_t score(uint8_t codeA, uint8_t codeB) const {
+		return mat_[codeA * maxCodes_ + codeB];
+	}
+	/**@brief The table of scores, the score of codeA to codeB is at codeA * maxCodes_ + codeB
+	 *
+	 */
+	const int32_t * data() const {
+		return mat_.data();
+	}
+	uint8_t getCode(char letter) const {
+		return codes_[static_cast<unsigned char>(letter)];
+	}
+
+	Alphabet getAlphabet() const;
+	uint32_t numberOfCodes() const;
+	/**@brief Whether every code scores match to itself and mismatch to every other code so scoring is just a compare
+	 *
+	 */
+	bool isSimple() const;
+	int32_t getMatch() const;
+	int32_t getMismatch() const;
+
+	/**@brief The upper case letters of alphabet
+	 *
+	 */
+	static std::string getLetters(Alphabet alphabet);
+
+private:
+	Alphabet alphabet_ { Alphabet::DEGENERATE_DNA };
+	uint32_t numberOfCodes_ { 0 };
+	bool simple_ { false };
+	int32_t match_ { 0 };
+	int32_t mismatch_ { 0 };
+	std::array<uint8_t, 256> codes_;
+	alignas(64) std::array<int32_t, maxCodes_ * maxCodes_> mat_;
+};
+
+}  // namespace njhseq
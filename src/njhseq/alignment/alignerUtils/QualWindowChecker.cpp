@@ -0,0 +1,77 @@
+/*
+ * QualWindowChecker.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: nick
+ */
+// njhseq - A library for analyzing sequence data
+// Copyright (C) 2012-2018 Nicholas Hathaway <nicholas.hathaway@umassmed.edu>,
+//
+// This file is part of njhseq.
+//
+// njhseq is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// njhseq is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with njhseq.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "QualWindowChecker.hpp"
+
+namespace njhseq {
+
+void QualWindowChecker::setQual(const std::vector<uint8_t> & qual,
+		const QualScorePars & pars) {
+	qual_ = &qual;
+	pars_ = pars;
+	built_ = false;
+}
+
+uint32_t QualWindowChecker::countLow(uint32_t start, uint32_t end) const {
+	if (start >= end) {
+		return 0;
+	}
+	return lowCounts_[end] - lowCounts_[start];
+}
+
+bool QualWindowChecker::checkQual(uint32_t pos) {
+	if (nullptr == qual_) {
+		std::stringstream ss;
+		ss << __PRETTY_FUNCTION__ << ", error " << "qualities haven't been set" << "\n";
+		throw std::runtime_error { ss.str() };
+	}
+	const auto & qual = *qual_;
+	if (qual[pos] <= pars_.primaryQual_) {
+		return false;
+	}
+	if (0 == pars_.qualThresWindow_) {
+		return true;
+	}
+	if (!built_) {
+		lowCounts_.resize(qual.size() + 1);
+		lowCounts_[0] = 0;
+		for (uint32_t i = 0; i < qual.size(); ++i) {
+			lowCounts_[i + 1] = lowCounts_[i] + (qual[i] <= pars_.secondaryQual_ ? 1 : 0);
+		}
+		built_ = true;
+	}
+	const uint32_t window = pars_.qualThresWindow_;
+	//the windows match seqInfo::checkLeadQual() and seqInfo::checkTrailQual(), the lead window is
+	//skipped when it would go off the front and the trail window never includes the last base
+	if (pos >= window && 0 != countLow(pos - window, pos)) {
+		return false;
+	}
+	uint32_t trailEnd = qual.size() - 1;
+	if (pos + window + 1 < trailEnd) {
+		trailEnd = pos + window + 1;
+	}
+	return 0 == countLow(pos + 1, trailEnd);
+}
+
+}  // namespace njhseq
@@ -0,0 +1,63 @@
+#pragma once
+/*
+ * QualWindowChecker.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: nick
+ */
+// njhseq - A library for analyzing sequence data
+// Copyright (C) 2012-2018 Nicholas Hathaway <nicholas.hathaway@umassmed.edu>,
+//
+// This file is part of njhseq.
+//
+// njhseq is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// njhseq is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with njhseq.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "njhseq/alignment/alignerUtils/QualScorePars.hpp"
+
+namespace njhseq {
+
+/**@brief Answers seqInfo::checkQual() for every position of a read in constant time
+ *
+ * Keeps a running count of the qualities at or below QualScorePars::secondaryQual_ so checking the window around a position is
+ * a subtraction rather than a walk over the window, the counts are only built on the first check after setQual() and the buffer is
+ * reused between reads
+ *
+ */
+class QualWindowChecker {
+public:
+
+	/**@brief Set the qualities to check, nothing is computed until the first call to checkQual()
+	 *
+	 * @param qual the qualities, has to stay alive and unchanged while checking
+	 * @param pars the quality thresholds
+	 */
+	void setQual(const std::vector<uint8_t> & qual, const QualScorePars & pars);
+
+	/**@brief Whether the quality at pos passes, the same answer as seqInfo::checkQual(pos, pars)
+	 *
+	 * @param pos the position in the qualities
+	 * @return true if the base at pos and the window around it pass
+	 */
+	bool checkQual(uint32_t pos);
+
+private:
+	const std::vector<uint8_t> * qual_ = nullptr;
+	QualScorePars pars_;
+	bool built_ = false;
+	std::vector<uint32_t> lowCounts_; /**< lowCounts_[i] is the number of qualities before i at or below the secondary quality */
+
+	uint32_t countLow(uint32_t start, uint32_t end) const;
+};
+
+}  // namespace njhseq
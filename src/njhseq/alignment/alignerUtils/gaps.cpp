@@ -21,6 +21,7 @@
 #include <iostream>
 #include <sstream>
 #include "njhseq/utils.h"
+#include "njhseq/objects/seqObjects/BaseObjects/QualityScores.hpp"
 
 namespace njhseq {
 
@@ -35,7 +36,7 @@ gap::gap(uint32_t startPos,
 			seqPos_(seqPos),
 			size_(gapedSequence.size()),
 			gapedSequence_(gapedSequence),
-			qualities_{firstQual},
+			qualities_{QualityScores::toStored(firstQual)},
 			ref_(ref)
       {}
 
@@ -47,7 +48,7 @@ std::string gap::strInfoHeader(const std::string & delim) {
 std::string gap::strInfo(const std::string & delim) const {
 	return vectorToString(
 			toVecStr(ref_ ? "insertion" : "deletion", refPos_, seqPos_,
-					gapedSequence_, vectorToString(qualities_, ",")), delim);
+					gapedSequence_, QualityScores::toString(qualities_, ",")), delim);
 }
 
 void gap::switchSeqAndRef(){
@@ -68,7 +69,7 @@ Json::Value gap::toJson() const {
 	ret["startPos_"] = njh::json::toJson(startPos_);
 	ret["size_"] = njh::json::toJson(size_);
 	ret["gapedSequence_"] = njh::json::toJson(gapedSequence_);
-	ret["qualities_"] = njh::json::toJson(qualities_);
+	ret["qualities_"] = njh::json::toJson(QualityScores::toUInt32(qualities_));
 
 	ret["refPos_"] = njh::json::toJson(refPos_);
 	ret["seqPos_"] = njh::json::toJson(seqPos_);
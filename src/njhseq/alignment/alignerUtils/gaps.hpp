@@ -56,7 +56,7 @@ public:
 	uint32_t seqPos_; /**< Position in actual sequence, seq */
 	uint32_t size_; /**< Position in actual sequence, will be ref pos or query */
 	std::string gapedSequence_; /**< The sequence that is missing */
-	std::vector<uint32_t> qualities_; /**< The quality scores of the gaped sequence */
+	std::vector<uint8_t> qualities_; /**< The quality scores of the gaped sequence, one byte each like seqInfo::qual_ */
 	bool ref_; /**< ref == true : insertion, ref == false: deletion*/
 
 	/*
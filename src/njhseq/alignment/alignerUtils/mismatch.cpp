@@ -18,10 +18,11 @@
 // along with njhseq.  If not, see <http://www.gnu.org/licenses/>.
 //
 #include "mismatch.hpp"
+#include "njhseq/objects/seqObjects/BaseObjects/QualityScores.hpp"
 
 namespace njhseq {
-inline bool qualPass(const std::vector<uint32_t> & quals, uint32_t qualCutOff){
-	return quals.empty() ? true : std::all_of(quals.begin(), quals.end(),[qualCutOff](uint32_t qual){return qual >qualCutOff;});
+inline bool qualPass(const std::vector<uint8_t> & quals, uint32_t qualCutOff){
+	return quals.empty() ? true : std::all_of(quals.begin(), quals.end(),[qualCutOff](uint8_t qual){return qual >qualCutOff;});
 }
 
 bool mismatch::highQuality(const QualScorePars & qScorePars) const{
@@ -96,11 +97,11 @@ std::string mismatch::outputInfoString() const {
     out << "transversion\t";
   }
   out << refBasePos << "\t" << refBase << "\t" << refQual << "\t"
-      << vectorToString(refLeadingQual, ",") << "\t"
-      << vectorToString(refTrailingQual, ",") << "\t" << seqBasePos << "\t"
+      << QualityScores::toString(refLeadingQual, ",") << "\t"
+      << QualityScores::toString(refTrailingQual, ",") << "\t" << seqBasePos << "\t"
       << seqBase << "\t" << seqQual << "\t"
-      << vectorToString(seqLeadingQual, ",") << "\t"
-      << vectorToString(seqTrailingQual, ",") << "\t" << kMerFreqByPos << "\t"
+      << QualityScores::toString(seqLeadingQual, ",") << "\t"
+      << QualityScores::toString(seqTrailingQual, ",") << "\t" << kMerFreqByPos << "\t"
       << kMerFreq;
   return out.str();
 }
@@ -109,13 +110,13 @@ Json::Value mismatch::toJson()const{
 	ret["class"] = njh::json::toJson("njhseq::mismatch");
 	ret["refBase"] = njh::json::toJson(refBase);
 	ret["refQual"] = njh::json::toJson(refQual);
-	ret["refLeadingQual"] = njh::json::toJson(refLeadingQual);
-	ret["refTrailingQual"] = njh::json::toJson(refTrailingQual);
+	ret["refLeadingQual"] = njh::json::toJson(QualityScores::toUInt32(refLeadingQual));
+	ret["refTrailingQual"] = njh::json::toJson(QualityScores::toUInt32(refTrailingQual));
 	ret["refBasePos"] = njh::json::toJson(refBasePos);
 	ret["seqBase"] = njh::json::toJson(seqBase);
 	ret["seqQual"] = njh::json::toJson(seqQual);
-	ret["seqLeadingQual"] = njh::json::toJson(seqLeadingQual);
-	ret["seqTrailingQual"] = njh::json::toJson(seqTrailingQual);
+	ret["seqLeadingQual"] = njh::json::toJson(QualityScores::toUInt32(seqLeadingQual));
+	ret["seqTrailingQual"] = njh::json::toJson(QualityScores::toUInt32(seqTrailingQual));
 	ret["seqBasePos"] = njh::json::toJson(seqBasePos);
 	ret["kMerFreqByPos"] = njh::json::toJson(kMerFreqByPos);
 	ret["kMerFreq"] = njh::json::toJson(kMerFreq);
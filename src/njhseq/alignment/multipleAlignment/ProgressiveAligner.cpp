@@ -0,0 +1,497 @@
+/*
+ * ProgressiveAligner.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: nick
+ */
+//
+// njhseq - A library for analyzing sequence data
+// Copyright (C) 2012-2018 Nicholas Hathaway <nicholas.hathaway@umassmed.edu>,
+//
+// This file is part of njhseq.
+//
+// njhseq is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// njhseq is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with njhseq.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "ProgressiveAligner.hpp"
+#include "njhseq/alignment/aligner/aligner.hpp"
+#include "njhseq/IO/SeqIO/SeqInput.hpp"
+
+#include <string_view>
+
+namespace njhseq {
+
+namespace {
+
+typedef std::vector<std::vector<std::pair<char, double>>> ProfileColumns;
+
+/**@brief For each column, the fraction of rows with each non gap character
+ *
+ */
+ProfileColumns genProfileColumns(const std::vector<std::string> & rows) {
+	const uint32_t alnLen = rows.front().size();
+	ProfileColumns ret(alnLen);
+	std::array<uint32_t, 127> counts;
+	for (const auto col : iter::range(alnLen)) {
+		counts.fill(0);
+		for (const auto & row : rows) {
+			const unsigned char c = row[col];
+			if ('-' != c && c < 127) {
+				++counts[c];
+			}
+		}
+		for (const auto c : iter::range<uint32_t>(127)) {
+			if (counts[c] > 0) {
+				ret[col].emplace_back(static_cast<char>(c),
+						counts[c] / static_cast<double>(rows.size()));
+			}
+		}
+	}
+	return ret;
+}
+
+/**@brief Fraction of kmers shared between two sequences
+ *
+ */
+double fracKmersShared(const std::unordered_map<std::string_view, uint32_t> & kmers1,
+		uint64_t len1,
+		const std::unordered_map<std::string_view, uint32_t> & kmers2,
+		uint64_t len2, uint32_t kLen) {
+	uint64_t minLen = std::min(len1, len2);
+	if (minLen < kLen) {
+		return 0;
+	}
+	uint32_t shared = 0;
+	for (const auto & k : kmers1) {
+		auto otherK = kmers2.find(k.first);
+		if (kmers2.end() != otherK) {
+			shared += std::min(k.second, otherK->second);
+		}
+	}
+	return shared / static_cast<double>(minLen - kLen + 1);
+}
+
+}  // namespace
+
+ProgressiveAligner::ProgressiveAligner(const gapScoringParameters & gapScores,
+		const substituteMatrix & scoring) :
+		gapScores_(gapScores), scoring_(scoring) {
+}
+
+ProgressiveAligner::ProgressiveAligner(const aligner & alignerObj) :
+		ProgressiveAligner(alignerObj.parts_.gapScores_,
+				alignerObj.parts_.getScoring()) {
+}
+
+ProgressiveAligner::ProgressiveAligner() :
+		ProgressiveAligner(gapScoringParameters(5, 1), substituteMatrix(2, -2)) {
+}
+
+alnInfoGlobal ProgressiveAligner::genGlobalAlnInfo(const std::string & seq){
+	uint64_t pos = 0;
+	uint32_t gapOffSet = 0;
+	uint32_t gapSize = 0;
+	uint32_t gapStartSiteInSeq = 0;
+	//first is pos, second is gap size
+	std::vector<std::pair<uint32_t, uint32_t>> gapInfos;
+	while(pos != seq.size()){
+		if(seq[pos] == '-'){
+			if(gapSize == 0){
+				gapStartSiteInSeq = pos - gapOffSet;
+			}
+			++gapSize;
+			++gapOffSet;
+		} else {
+			//log gap if currently building one
+			if(gapSize > 0){
+				gapInfos.emplace_back(gapStartSiteInSeq, gapSize);
+			}
+			//reset
+			gapSize = 0;
+			gapStartSiteInSeq = 0;
+		}
+		++pos;
+	}
+	if(gapSize > 0){
+		gapInfos.emplace_back(gapStartSiteInSeq, gapSize);
+	}
+	//sort backwards and add appropriate number of zeros, starting from back so pos is not invalidated
+	std::sort(gapInfos.begin(),
+			gapInfos.end(), [](const std::pair<uint32_t, uint32_t> & p1,
+					const std::pair<uint32_t, uint32_t> & p2){ return p1.first > p2.first;});
+	std::vector<gapInfo> gInfos;
+	for(const auto & g : gapInfos){
+		gInfos.emplace_back(gapInfo(g.first, g.second, false));
+	}
+	return alnInfoGlobal(gInfos, 1, false);
+}
+
+std::vector<seqInfo> ProgressiveAligner::alignSeqs(const SeqIOOptions & opts) const {
+	SeqInput reader(opts);
+	auto seqs = reader.readAllReads<seqInfo>();
+	alignSeqs(seqs);
+	return seqs;
+}
+
+std::vector<alnInfoGlobal> ProgressiveAligner::genMultipleAlnInfos(
+		const std::vector<std::string> & seqs) const {
+	std::vector<alnInfoGlobal> ret;
+	auto alnSeqs = alignStrs(seqs);
+	for (const auto & alnSeq : alnSeqs) {
+		ret.emplace_back(genGlobalAlnInfo(alnSeq));
+	}
+	return ret;
+}
+
+std::vector<std::string> ProgressiveAligner::alignStrs(
+		const std::vector<std::string> & seqs) const {
+	if (seqs.size() < 2) {
+		return seqs;
+	}
+	for (const auto & seq : seqs) {
+		if (seq.empty()) {
+			std::stringstream ss;
+			ss << __PRETTY_FUNCTION__ << ", error " << "can't align empty sequences" << "\n";
+			throw std::runtime_error { ss.str() };
+		}
+	}
+	//kmer distances for the guide tree
+	std::vector<std::unordered_map<std::string_view, uint32_t>> kmers(seqs.size());
+	for (const auto seqPos : iter::range(seqs.size())) {
+		std::string_view seqView(seqs[seqPos]);
+		for (uint64_t pos = 0; pos + pars_.kLen_ <= seqView.size(); ++pos) {
+			++kmers[seqPos][seqView.substr(pos, pars_.kLen_)];
+		}
+	}
+	std::vector<std::vector<double>> dists(seqs.size(),
+			std::vector<double>(seqs.size(), 0));
+	for (const auto row : iter::range(seqs.size())) {
+		for (const auto col : iter::range(row)) {
+			double dist = 1
+					- fracKmersShared(kmers[row], seqs[row].size(), kmers[col],
+							seqs[col].size(), pars_.kLen_);
+			dists[row][col] = dist;
+			dists[col][row] = dist;
+		}
+	}
+
+	//UPGMA guide tree, profiles are aligned as they are joined
+	struct ProfileNode {
+		std::vector<uint32_t> members_;
+		std::vector<std::string> rows_;
+	};
+	std::vector<ProfileNode> nodes;
+	for (const auto seqPos : iter::range<uint32_t>(seqs.size())) {
+		nodes.emplace_back(ProfileNode { { seqPos }, { seqs[seqPos] } });
+	}
+	std::vector<bool> active(nodes.size(), true);
+	for (uint32_t joins = 0; joins + 1 < seqs.size(); ++joins) {
+		double minDist = std::numeric_limits<double>::max();
+		uint32_t bestRow = 0;
+		uint32_t bestCol = 0;
+		for (const auto row : iter::range<uint32_t>(nodes.size())) {
+			if (!active[row]) {
+				continue;
+			}
+			for (const auto col : iter::range<uint32_t>(row)) {
+				if (active[col] && dists[row][col] < minDist) {
+					minDist = dists[row][col];
+					bestRow = row;
+					bestCol = col;
+				}
+			}
+		}
+		const double colSize = nodes[bestCol].members_.size();
+		const double rowSize = nodes[bestRow].members_.size();
+		for (const auto other : iter::range<uint32_t>(nodes.size())) {
+			if (!active[other] || other == bestCol || other == bestRow) {
+				continue;
+			}
+			double dist = (dists[bestCol][other] * colSize
+					+ dists[bestRow][other] * rowSize) / (colSize + rowSize);
+			dists[bestCol][other] = dist;
+			dists[other][bestCol] = dist;
+		}
+		nodes[bestCol].rows_ = alignProfiles(nodes[bestCol].rows_, nodes[bestRow].rows_);
+		addOtherVec(nodes[bestCol].members_, nodes[bestRow].members_);
+		active[bestRow] = false;
+		nodes[bestRow] = ProfileNode { };
+	}
+	const auto & root = nodes[std::distance(active.begin(),
+			std::find(active.begin(), active.end(), true))];
+	std::vector<std::string> ret(seqs.size());
+	for (const auto memberPos : iter::range(root.members_.size())) {
+		ret[root.members_[memberPos]] = root.rows_[memberPos];
+	}
+	if (pars_.refinementIterations_ > 0 && seqs.size() > 2) {
+		ret = refine(ret);
+	}
+	return ret;
+}
+
+std::vector<std::string> ProgressiveAligner::alignProfiles(
+		const std::vector<std::string> & profileA,
+		const std::vector<std::string> & profileB) const {
+	const uint32_t lenA = profileA.front().size();
+	const uint32_t lenB = profileB.front().size();
+	const auto colsA = genProfileColumns(profileA);
+	const auto colsB = genProfileColumns(profileB);
+	const uint64_t matCols = lenB + 1;
+	const double negInf = -std::numeric_limits<double>::infinity();
+	//M is a column of each aligned, X is a column of A against a gap, Y a gap against a column of B
+	enum class DPState : uint8_t {
+		M, X, Y
+	};
+	std::vector<double> scoreM((lenA + 1) * matCols, negInf);
+	std::vector<double> scoreX((lenA + 1) * matCols, negInf);
+	std::vector<double> scoreY((lenA + 1) * matCols, negInf);
+	std::vector<DPState> ptrM((lenA + 1) * matCols, DPState::M);
+	std::vector<DPState> ptrX((lenA + 1) * matCols, DPState::M);
+	std::vector<DPState> ptrY((lenA + 1) * matCols, DPState::M);
+	auto bestOf = [](double m, double x, double y, DPState & ptr) {
+		if (m >= x && m >= y) {
+			ptr = DPState::M;
+			return m;
+		} else if (x >= y) {
+			ptr = DPState::X;
+			return x;
+		}
+		ptr = DPState::Y;
+		return y;
+	};
+	scoreM[0] = 0;
+	for (uint32_t i = 0; i <= lenA; ++i) {
+		for (uint32_t j = 0; j <= lenB; ++j) {
+			const uint64_t cell = i * matCols + j;
+			if (i > 0 && j > 0) {
+				const uint64_t diag = (i - 1) * matCols + j - 1;
+				double match = 0;
+				for (const auto & a : colsA[i - 1]) {
+					for (const auto & b : colsB[j - 1]) {
+						match += a.second * b.second * scoring_.mat_[a.first][b.first];
+					}
+				}
+				scoreM[cell] = match
+						+ bestOf(scoreM[diag], scoreX[diag], scoreY[diag], ptrM[cell]);
+			}
+			if (i > 0) {
+				//gap in B, terminal gaps use the end gap scoring
+				int32_t open = gapScores_.gapOpen_;
+				int32_t extend = gapScores_.gapExtend_;
+				if (0 == j) {
+					open = gapScores_.gapLeftQueryOpen_;
+					extend = gapScores_.gapLeftQueryExtend_;
+				} else if (lenB == j) {
+					open = gapScores_.gapRightQueryOpen_;
+					extend = gapScores_.gapRightQueryExtend_;
+				}
+				const uint64_t up = (i - 1) * matCols + j;
+				scoreX[cell] = bestOf(scoreM[up] - open, scoreX[up] - extend,
+						scoreY[up] - open, ptrX[cell]);
+			}
+			if (j > 0) {
+				//gap in A
+				int32_t open = gapScores_.gapOpen_;
+				int32_t extend = gapScores_.gapExtend_;
+				if (0 == i) {
+					open = gapScores_.gapLeftRefOpen_;
+					extend = gapScores_.gapLeftRefExtend_;
+				} else if (lenA == i) {
+					open = gapScores_.gapRightRefOpen_;
+					extend = gapScores_.gapRightRefExtend_;
+				}
+				const uint64_t left = i * matCols + j - 1;
+				scoreY[cell] = bestOf(scoreM[left] - open, scoreX[left] - open,
+						scoreY[left] - extend, ptrY[cell]);
+			}
+		}
+	}
+	//trace back
+	std::string ops;
+	ops.reserve(lenA + lenB);
+	uint32_t i = lenA;
+	uint32_t j = lenB;
+	DPState state;
+	const uint64_t lastCell = lenA * matCols + lenB;
+	bestOf(scoreM[lastCell], scoreX[lastCell], scoreY[lastCell], state);
+	while (i > 0 || j > 0) {
+		const uint64_t cell = i * matCols + j;
+		switch (state) {
+		case DPState::M:
+			ops.push_back('M');
+			state = ptrM[cell];
+			--i;
+			--j;
+			break;
+		case DPState::X:
+			ops.push_back('X');
+			state = ptrX[cell];
+			--i;
+			break;
+		case DPState::Y:
+			ops.push_back('Y');
+			state = ptrY[cell];
+			--j;
+			break;
+		}
+	}
+	std::reverse(ops.begin(), ops.end());
+	std::vector<std::string> ret;
+	ret.reserve(profileA.size() + profileB.size());
+	for (const auto & row : profileA) {
+		std::string alnRow;
+		alnRow.reserve(ops.size());
+		uint32_t pos = 0;
+		for (const auto op : ops) {
+			if ('Y' == op) {
+				alnRow.push_back('-');
+			} else {
+				alnRow.push_back(row[pos]);
+				++pos;
+			}
+		}
+		ret.emplace_back(alnRow);
+	}
+	for (const auto & row : profileB) {
+		std::string alnRow;
+		alnRow.reserve(ops.size());
+		uint32_t pos = 0;
+		for (const auto op : ops) {
+			if ('X' == op) {
+				alnRow.push_back('-');
+			} else {
+				alnRow.push_back(row[pos]);
+				++pos;
+			}
+		}
+		ret.emplace_back(alnRow);
+	}
+	return ret;
+}
+
+double ProgressiveAligner::sumOfPairsScore(
+		const std::vector<std::string> & alnSeqs) const {
+	if (alnSeqs.empty()) {
+		return 0;
+	}
+	const uint32_t alnLen = alnSeqs.front().size();
+	double score = 0;
+	std::array<uint32_t, 127> counts;
+	for (const auto col : iter::range(alnLen)) {
+		counts.fill(0);
+		for (const auto & row : alnSeqs) {
+			const unsigned char c = row[col];
+			if ('-' != c && c < 127) {
+				++counts[c];
+			}
+		}
+		double colScore = 0;
+		for (const auto a : iter::range<uint32_t>(127)) {
+			if (0 == counts[a]) {
+				continue;
+			}
+			for (const auto b : iter::range<uint32_t>(127)) {
+				if (0 == counts[b]) {
+					continue;
+				}
+				double pairs = a == b ?
+						counts[a] * (counts[a] - 1.0) :
+						static_cast<double>(counts[a]) * counts[b];
+				colScore += pairs * scoring_.mat_[a][b];
+			}
+		}
+		score += colScore / 2;
+	}
+	const double otherSeqs = alnSeqs.size() - 1;
+	for (const auto & row : alnSeqs) {
+		uint32_t pos = 0;
+		while (pos < alnLen) {
+			if ('-' != row[pos]) {
+				++pos;
+				continue;
+			}
+			uint32_t runStart = pos;
+			while (pos < alnLen && '-' == row[pos]) {
+				++pos;
+			}
+			uint32_t runLen = pos - runStart;
+			if (runLen == alnLen) {
+				continue;
+			}
+			int32_t open = gapScores_.gapOpen_;
+			int32_t extend = gapScores_.gapExtend_;
+			if (0 == runStart) {
+				open = gapScores_.gapLeftQueryOpen_;
+				extend = gapScores_.gapLeftQueryExtend_;
+			} else if (alnLen == pos) {
+				open = gapScores_.gapRightQueryOpen_;
+				extend = gapScores_.gapRightQueryExtend_;
+			}
+			score -= (open + (runLen - 1.0) * extend) * otherSeqs;
+		}
+	}
+	return score;
+}
+
+std::vector<std::string> ProgressiveAligner::refine(
+		std::vector<std::string> alnSeqs) const {
+	double currentScore = sumOfPairsScore(alnSeqs);
+	for (uint32_t iteration = 0; iteration < pars_.refinementIterations_; ++iteration) {
+		bool improved = false;
+		for (const auto seqPos : iter::range(alnSeqs.size())) {
+			std::vector<std::string> rest;
+			for (const auto otherPos : iter::range(alnSeqs.size())) {
+				if (otherPos != seqPos) {
+					rest.emplace_back(alnSeqs[otherPos]);
+				}
+			}
+			//remove the columns that were only there for the removed sequence
+			std::vector<std::string> strippedRest(rest.size());
+			for (const auto col : iter::range(rest.front().size())) {
+				bool allGaps = std::all_of(rest.begin(), rest.end(),
+						[&col](const std::string & row) {return '-' == row[col];});
+				if (!allGaps) {
+					for (const auto rowPos : iter::range(rest.size())) {
+						strippedRest[rowPos].push_back(rest[rowPos][col]);
+					}
+				}
+			}
+			std::string single = alnSeqs[seqPos];
+			single.erase(std::remove(single.begin(), single.end(), '-'), single.end());
+			auto realigned = alignProfiles(strippedRest, { single });
+			std::vector<std::string> candidate;
+			candidate.reserve(alnSeqs.size());
+			uint32_t restPos = 0;
+			for (const auto otherPos : iter::range(alnSeqs.size())) {
+				if (otherPos == seqPos) {
+					candidate.emplace_back(realigned.back());
+				} else {
+					candidate.emplace_back(realigned[restPos]);
+					++restPos;
+				}
+			}
+			double candidateScore = sumOfPairsScore(candidate);
+			if (candidateScore > currentScore) {
+				currentScore = candidateScore;
+				alnSeqs = candidate;
+				improved = true;
+			}
+		}
+		if (!improved) {
+			break;
+		}
+	}
+	return alnSeqs;
+}
+
+}  // namespace njhseq
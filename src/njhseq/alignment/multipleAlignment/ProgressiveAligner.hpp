@@ -0,0 +1,194 @@
+#pragma once
+/*
+ * ProgressiveAligner.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: nick
+ */
+//
+// njhseq - A library for analyzing sequence data
+// Copyright (C) 2012-2018 Nicholas Hathaway <nicholas.hathaway@umassmed.edu>,
+//
+// This file is part of njhseq.
+//
+// njhseq is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// njhseq is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with njhseq.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "njhseq/objects/seqObjects/BaseObjects/seqInfo.hpp"
+#include "njhseq/alignment/alnCache/alnInfoGlobal.hpp"
+#include "njhseq/alignment/alignerUtils/gapScoring.hpp"
+#include "njhseq/alignment/alignerUtils/substituteMatrix.hpp"
+#include "njhseq/alignment/aligner/alignCalc.hpp"
+#include "njhseq/IO/SeqIO/SeqIOOptions.hpp"
+
+namespace njhseq {
+
+class aligner;
+
+/**@brief An in process progressive multiple sequence aligner, can be used in place of Muscler to avoid calling out to muscle
+ *
+ * Builds a UPGMA guide tree from kmer distances, then aligns profiles up the tree with an affine gap profile-profile dynamic programming
+ * using the same gap and substitution scoring as aligner, optionally followed by leave-one-out refinement
+ *
+ */
+class ProgressiveAligner {
+public:
+
+	struct ProgressiveAlignerPars {
+		uint32_t kLen_ = 5; /**< kmer length for the guide tree distances */
+		uint32_t refinementIterations_ = 0; /**< the number of passes of leave-one-out refinement, 0 for none */
+	};
+
+	ProgressiveAligner(const gapScoringParameters & gapScores,
+			const substituteMatrix & scoring);
+
+	/**@brief Construct with the gap and substitution scoring of an aligner
+	 *
+	 */
+	ProgressiveAligner(const aligner & alignerObj);
+
+	/**@brief Construct with default scoring, 2 match -2 mismatch, 5 gap open, 1 gap extend
+	 *
+	 */
+	ProgressiveAligner();
+
+	gapScoringParameters gapScores_;
+	substituteMatrix scoring_;
+	ProgressiveAlignerPars pars_;
+
+	/**@brief Generate the gap info for a sequence from how it looks in a multiple alignment
+	 *
+	 * @param seq the gapped sequence
+	 * @return the gaps to insert into the ungapped sequence, as query gaps
+	 */
+	static alnInfoGlobal genGlobalAlnInfo(const std::string & seq);
+
+	/**@brief Align the sequences
+	 *
+	 * @param seqs the ungapped sequences to align
+	 * @return the gaps to insert into each input sequence, in the same order as seqs
+	 */
+	std::vector<alnInfoGlobal> genMultipleAlnInfos(const std::vector<std::string> & seqs) const;
+
+	/**@brief Align the sequences
+	 *
+	 * @param seqs the ungapped sequences to align
+	 * @return the gapped sequences, all the same length, in the same order as seqs
+	 */
+	std::vector<std::string> alignStrs(const std::vector<std::string> & seqs) const;
+
+	/**@brief Align the sequences read in with opts
+	 *
+	 * @param opts the options to read in the sequences
+	 * @return a vector of the aligned seqs
+	 */
+	std::vector<seqInfo> alignSeqs(const SeqIOOptions & opts) const;
+
+	/**@brief Align the sequences in seqs at the selected positions, the other seqs are left alone
+	 *
+	 * @param seqs the sequences to align
+	 * @param selected only align these selected sequences at these positions, will throw if out of range
+	 */
+	template<typename T, typename POSTYPE>
+	void alignSeqs(std::vector<T> & seqs,
+			const std::vector<POSTYPE> & selected) const {
+		std::vector<std::string> strs;
+		std::vector<POSTYPE> nonEmpty;
+		for (const auto & pos : selected) {
+			if (pos >= seqs.size()) {
+				std::stringstream ss;
+				ss << __PRETTY_FUNCTION__ << ", error position out of range, pos: "
+						<< pos << ", size: " << seqs.size() << "\n";
+				throw std::out_of_range { ss.str() };
+			}
+			if ("" != getSeqBase(seqs[pos]).seq_) {
+				nonEmpty.emplace_back(pos);
+				strs.emplace_back(getSeqBase(seqs[pos]).seq_);
+			}
+		}
+		auto gapInfos = genMultipleAlnInfos(strs);
+		for (const auto idx : iter::range(nonEmpty.size())) {
+			auto & currentRead = getSeqBase(seqs[nonEmpty[idx]]);
+			alignCalc::rearrangeGlobalQueryOnly(currentRead.seq_, '-', gapInfos[idx]);
+			alignCalc::rearrangeGlobalQueryOnly(currentRead.qual_, 0, gapInfos[idx]);
+		}
+	}
+
+	/**@brief Align all the sequences in seqs
+	 *
+	 * @param seqs the sequences to align
+	 */
+	template<typename T>
+	void alignSeqs(std::vector<T> & seqs) const {
+		std::vector<uint64_t> allSelected(seqs.size());
+		njh::iota<uint64_t>(allSelected, 0);
+		alignSeqs(seqs, allSelected);
+	}
+
+	/**@brief Align the sequences in seqs, leave the original seqs alone
+	 *
+	 * @param seqs the sequence to align
+	 * @return a vector of the aligned seqs
+	 */
+	template<typename T>
+	std::vector<T> alignSeqsRet(std::vector<T> seqs) const {
+		alignSeqs(seqs);
+		return seqs;
+	}
+
+	/**@brief Align several independent sets of sequences in parallel
+	 *
+	 * @param seqSets the sets of sequences, each set is aligned on its own
+	 * @param numThreads the number of threads to use
+	 */
+	template<typename T>
+	void alignSeqSets(std::vector<std::vector<T>> & seqSets, uint32_t numThreads) const {
+		std::vector<uint32_t> setPositions(seqSets.size());
+		njh::iota<uint32_t>(setPositions, 0);
+		njh::concurrent::LockableQueue<uint32_t> setQueue(setPositions);
+		auto alignSets = [this, &seqSets, &setQueue]() {
+			uint32_t setPos = 0;
+			while (setQueue.getVal(setPos)) {
+				alignSeqs(seqSets[setPos]);
+			}
+		};
+		std::vector<std::thread> threads;
+		for (uint32_t t = 0; t < std::max<uint32_t>(1, numThreads); ++t) {
+			threads.emplace_back(alignSets);
+		}
+		njh::concurrent::joinAllJoinableThreads(threads);
+	}
+
+	/**@brief The sum of pairs score of a multiple alignment, used to judge refinement
+	 *
+	 * @param alnSeqs the aligned sequences, should all be the same length
+	 * @return the sum of pairs substitution score minus the gap penalties of each sequence weighted by the number of other sequences
+	 */
+	double sumOfPairsScore(const std::vector<std::string> & alnSeqs) const;
+
+private:
+
+	/**@brief Align two profiles, the rows of each profile are all the same length
+	 *
+	 * @param profileA the first profile's rows
+	 * @param profileB the second profile's rows
+	 * @return the rows of profileA followed by the rows of profileB with the needed gaps inserted
+	 */
+	std::vector<std::string> alignProfiles(const std::vector<std::string> & profileA,
+			const std::vector<std::string> & profileB) const;
+
+	std::vector<std::string> refine(std::vector<std::string> alnSeqs) const;
+
+};
+
+}  // namespace njhseq
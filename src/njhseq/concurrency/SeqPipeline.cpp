@@ -0,0 +1,62 @@
+/*
+ * SeqPipeline.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: nick
+ */
+// njhseq - A library for analyzing sequence data
+// Copyright (C) 2012-2018 Nicholas Hathaway <nicholas.hathaway@umassmed.edu>,
+//
+// This file is part of njhseq.
+//
+// njhseq is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// njhseq is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with njhseq.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "SeqPipeline.hpp"
+
+namespace njhseq {
+
+SeqPipelineStageCounts::SeqPipelineStageCounts(const std::string & name) :
+		name_(name) {
+}
+
+double SeqPipelineStageCounts::seconds() const {
+	return nanoseconds_.load() / 1e9;
+}
+
+double SeqPipelineStageCounts::readsPerSecond() const {
+	const double secs = seconds();
+	return secs > 0 ? readsIn_.load() / secs : 0;
+}
+
+void SeqPipelineStageCounts::addBatch(uint64_t readsIn, uint64_t readsPassed,
+		const std::chrono::steady_clock::time_point & start) {
+	readsIn_ += readsIn;
+	readsPassed_ += readsPassed;
+	nanoseconds_ += std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now() - start).count();
+}
+
+void SeqPipelineStageCounts::writeHeader(std::ostream & out) {
+	out << "stage\treadsIn\treadsPassed\tseconds\treadsPerSecond" << "\n";
+}
+
+void SeqPipelineStageCounts::writeCounts(std::ostream & out) const {
+	out << name_
+			<< "\t" << readsIn_.load()
+			<< "\t" << readsPassed_.load()
+			<< "\t" << seconds()
+			<< "\t" << readsPerSecond() << "\n";
+}
+
+}  // namespace njhseq
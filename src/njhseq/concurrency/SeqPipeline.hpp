@@ -0,0 +1,367 @@
+#pragma once
+/*
+ * SeqPipeline.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: nick
+ */
+// njhseq - A library for analyzing sequence data
+// Copyright (C) 2012-2018 Nicholas Hathaway <nicholas.hathaway@umassmed.edu>,
+//
+// This file is part of njhseq.
+//
+// njhseq is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// njhseq is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with njhseq.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "njhseq/IO/SeqIO/SeqInput.hpp"
+#include "njhseq/IO/SeqIO/SeqOutput.hpp"
+#include "njhseq/readVectorManipulation/readVectorHelpers/ReadCheckerChain.hpp"
+
+namespace njhseq {
+
+/**@brief Throughput counts for one stage of a SeqPipeline, safe to read while the pipeline is running
+ *
+ */
+class SeqPipelineStageCounts {
+public:
+	explicit SeqPipelineStageCounts(const std::string & name);
+
+	const std::string name_;
+	std::atomic<uint64_t> readsIn_ { 0 };
+	std::atomic<uint64_t> readsPassed_ { 0 };
+	std::atomic<uint64_t> nanoseconds_ { 0 }; /**< time spent in the stage, summed over the threads running it*/
+
+	double seconds() const;
+	/**@brief reads per second of time spent in the stage, per thread
+	 *
+	 */
+	double readsPerSecond() const;
+
+	void addBatch(uint64_t readsIn, uint64_t readsPassed,
+			const std::chrono::steady_clock::time_point & start);
+
+	static void writeHeader(std::ostream & out);
+	void writeCounts(std::ostream & out) const;
+};
+
+/**@brief Run a chain of per read stages over a sequence file with one thread reading, several threads running the stages and one thread writing
+ *
+ * Reads are read in batches and handed through bounded queues so only Pars::batchesInFlight_ batches are held at once, each stage is run over the whole batch
+ * before the next so its timing is cheap, a read a stage fails isn't given to the later stages and is handed to the writer as failed,
+ * stages are shared between the worker threads so they need to be safe to call concurrently (ReadChecker::checkRead and the readVecTrimmer functions are)
+ *
+ * @todo make stages that need per thread state easier to add, for now capture a pool in the stage
+ */
+template<typename T>
+class SeqPipeline {
+public:
+	struct Pars {
+		uint32_t numThreads_ = 1; /**< threads running the stages, the reader and writer each run on their own thread */
+		uint32_t batchSize_ = 1000; /**< reads per batch */
+		uint32_t batchesInFlight_ = 0; /**< batches read but not written yet before reading waits, 0 for 4 per worker thread */
+		bool keepOrder_ = true; /**< write reads in the order they were read */
+	};
+
+	/**@brief a stage of the pipeline, return false to fail the read
+	 *
+	 */
+	typedef std::function<bool(T & read)> Stage;
+	/**@brief called on the thread that called run() for each read, passed is false if a stage failed it
+	 *
+	 */
+	typedef std::function<void(T & read, bool passed)> Writer;
+
+	explicit SeqPipeline(const Pars & pars) :
+			pars_(pars), readCounts_("read"), writeCounts_("write") {
+		if (0 == pars_.batchSize_) {
+			std::stringstream ss;
+			ss << __PRETTY_FUNCTION__ << ", error " << "batchSize_ can't be 0" << "\n";
+			throw std::runtime_error { ss.str() };
+		}
+	}
+
+	const Pars pars_;
+
+	/**@brief Add a stage, stages are run in the order added
+	 *
+	 * @param name the name of the stage for the counts
+	 * @param stage the stage
+	 */
+	void addStage(const std::string & name, const Stage & stage) {
+		stages_.emplace_back(stage);
+		stageCounts_.emplace_back(std::make_unique<SeqPipelineStageCounts>(name));
+	}
+
+	/**@brief Add a ReadChecker as a stage, T needs to be a type ReadChecker::checkRead takes (seqInfo or PairedRead)
+	 *
+	 * @param name the name of the stage for the counts
+	 * @param checker the checker
+	 */
+	void addChecker(const std::string & name,
+			const std::shared_ptr<const ReadChecker> & checker) {
+		addStage(name, [checker](T & read) {
+			return checker->checkRead(read);
+		});
+	}
+
+	/**@brief Add a ReadCheckerChain as one stage so its checks share a pass over each read, T needs to be seqInfo or PairedRead
+	 *
+	 * @param name the name of the stage for the counts
+	 * @param chain the checkers
+	 */
+	void addCheckerChain(const std::string & name,
+			const std::shared_ptr<const ReadCheckerChain> & chain) {
+		addStage(name, [chain](T & read) {
+			return chain->checkRead(read);
+		});
+	}
+
+	/**@brief Run the pipeline over all the reads in reader, the reader should already be open
+	 *
+	 * @param reader the input
+	 * @param writer called for every read once it has gone through the stages
+	 */
+	void run(SeqInput & reader, const Writer & writer) {
+		RunState state;
+		const uint32_t numThreads = std::max<uint32_t>(1, pars_.numThreads_);
+		const uint64_t batchesInFlight = 0 == pars_.batchesInFlight_ ?
+				4 * numThreads : pars_.batchesInFlight_;
+		std::vector<std::thread> threads;
+		threads.emplace_back([this, &state, &reader, &batchesInFlight]() {
+			readBatches(state, reader, batchesInFlight);
+		});
+		for (uint32_t t = 0; t < numThreads; ++t) {
+			threads.emplace_back([this, &state]() {
+				processBatches(state);
+			});
+		}
+		writeBatches(state, writer);
+		{
+			std::lock_guard<std::mutex> lock(state.mut_);
+			state.stop_ = true;
+		}
+		state.cv_.notify_all();
+		njh::concurrent::joinAllJoinableThreads(threads);
+		if (nullptr != state.error_) {
+			std::rethrow_exception(state.error_);
+		}
+	}
+
+	/**@brief Run the pipeline over the file in inOpts writing the reads that pass to passOut and the ones that fail to failOut
+	 *
+	 * @param inOpts the input
+	 * @param passOut where to write passing reads
+	 * @param failOut where to write failing reads, nullptr to drop them
+	 */
+	void run(const SeqIOOptions & inOpts, SeqOutput & passOut,
+			SeqOutput * failOut = nullptr) {
+		SeqInput reader(inOpts);
+		reader.openIn();
+		run(reader, [&passOut, &failOut](T & read, bool passed) {
+			if (passed) {
+				passOut.openWrite(read);
+			} else if (nullptr != failOut) {
+				failOut->openWrite(read);
+			}
+		});
+	}
+
+	/**@brief The counts for the reading, each stage in the order they were added and the writing
+	 *
+	 */
+	std::vector<const SeqPipelineStageCounts *> getCounts() const {
+		std::vector<const SeqPipelineStageCounts *> ret { &readCounts_ };
+		for (const auto & counts : stageCounts_) {
+			ret.emplace_back(counts.get());
+		}
+		ret.emplace_back(&writeCounts_);
+		return ret;
+	}
+
+	/**@brief Write a tab delimited table of the counts
+	 *
+	 */
+	void writeCounts(std::ostream & out) const {
+		SeqPipelineStageCounts::writeHeader(out);
+		for (const auto & counts : getCounts()) {
+			counts->writeCounts(out);
+		}
+	}
+
+private:
+	std::vector<Stage> stages_;
+	std::vector<std::unique_ptr<SeqPipelineStageCounts>> stageCounts_;
+	SeqPipelineStageCounts readCounts_;
+	SeqPipelineStageCounts writeCounts_;
+
+	struct Batch {
+		uint64_t index_ { 0 };
+		std::vector<T> reads_;
+		std::vector<char> passed_;
+	};
+
+	struct RunState {
+		std::mutex mut_;
+		std::condition_variable cv_;
+		std::deque<Batch> toProcess_;
+		std::map<uint64_t, Batch> processed_;
+		uint64_t inFlight_ { 0 }; /**< batches read but not written yet */
+		bool readDone_ { false };
+		bool stop_ { false };
+		std::exception_ptr error_;
+
+		void setError(std::exception_ptr error) {
+			{
+				std::lock_guard<std::mutex> lock(mut_);
+				if (nullptr == error_) {
+					error_ = error;
+				}
+				stop_ = true;
+			}
+			cv_.notify_all();
+		}
+	};
+
+	void readBatches(RunState & state, SeqInput & reader,
+			uint64_t batchesInFlight) {
+		try {
+			uint64_t batchIndex = 0;
+			T read;
+			while (true) {
+				{
+					std::unique_lock<std::mutex> lock(state.mut_);
+					state.cv_.wait(lock, [&state, &batchesInFlight]() {
+						return state.stop_ || state.inFlight_ < batchesInFlight;
+					});
+					if (state.stop_) {
+						return;
+					}
+				}
+				const auto start = std::chrono::steady_clock::now();
+				Batch batch;
+				batch.index_ = batchIndex++;
+				batch.reads_.reserve(pars_.batchSize_);
+				while (batch.reads_.size() < pars_.batchSize_ && reader.readNextRead(read)) {
+					batch.reads_.emplace_back(std::move(read));
+				}
+				readCounts_.addBatch(batch.reads_.size(), batch.reads_.size(), start);
+				const bool done = batch.reads_.empty();
+				{
+					std::lock_guard<std::mutex> lock(state.mut_);
+					if (done) {
+						state.readDone_ = true;
+					} else {
+						++state.inFlight_;
+						state.toProcess_.emplace_back(std::move(batch));
+					}
+				}
+				state.cv_.notify_all();
+				if (done) {
+					return;
+				}
+			}
+		} catch (...) {
+			state.setError(std::current_exception());
+		}
+	}
+
+	void processBatches(RunState & state) {
+		try {
+			while (true) {
+				Batch batch;
+				{
+					std::unique_lock<std::mutex> lock(state.mut_);
+					state.cv_.wait(lock, [&state]() {
+						return state.stop_ || !state.toProcess_.empty() || state.readDone_;
+					});
+					if (state.stop_ || state.toProcess_.empty()) {
+						return;
+					}
+					batch = std::move(state.toProcess_.front());
+					state.toProcess_.pop_front();
+				}
+				batch.passed_.assign(batch.reads_.size(), 1);
+				for (const auto stagePos : iter::range(stages_.size())) {
+					const auto start = std::chrono::steady_clock::now();
+					uint64_t readsIn = 0;
+					uint64_t readsPassed = 0;
+					for (const auto readPos : iter::range(batch.reads_.size())) {
+						if (!batch.passed_[readPos]) {
+							continue;
+						}
+						++readsIn;
+						if (stages_[stagePos](batch.reads_[readPos])) {
+							++readsPassed;
+						} else {
+							batch.passed_[readPos] = 0;
+						}
+					}
+					stageCounts_[stagePos]->addBatch(readsIn, readsPassed, start);
+				}
+				{
+					std::lock_guard<std::mutex> lock(state.mut_);
+					state.processed_.emplace(batch.index_, std::move(batch));
+				}
+				state.cv_.notify_all();
+			}
+		} catch (...) {
+			state.setError(std::current_exception());
+		}
+	}
+
+	void writeBatches(RunState & state, const Writer & writer) {
+		try {
+			uint64_t nextToWrite = 0;
+			while (true) {
+				Batch batch;
+				{
+					std::unique_lock<std::mutex> lock(state.mut_);
+					auto writable = [this, &state, &nextToWrite]() {
+						return pars_.keepOrder_ ?
+								state.processed_.end() != state.processed_.find(nextToWrite) :
+								!state.processed_.empty();
+					};
+					state.cv_.wait(lock, [&state, &writable]() {
+						return state.stop_ || writable() || (state.readDone_ && 0 == state.inFlight_);
+					});
+					if (state.stop_ || !writable()) {
+						//either an error or everything has been written
+						return;
+					}
+					auto next = pars_.keepOrder_ ? state.processed_.find(nextToWrite) : state.processed_.begin();
+					batch = std::move(next->second);
+					state.processed_.erase(next);
+				}
+				const auto start = std::chrono::steady_clock::now();
+				uint64_t readsPassed = 0;
+				for (const auto readPos : iter::range(batch.reads_.size())) {
+					writer(batch.reads_[readPos], batch.passed_[readPos]);
+					if (batch.passed_[readPos]) {
+						++readsPassed;
+					}
+				}
+				writeCounts_.addBatch(batch.reads_.size(), readsPassed, start);
+				{
+					std::lock_guard<std::mutex> lock(state.mut_);
+					--state.inFlight_;
+					++nextToWrite;
+				}
+				state.cv_.notify_all();
+			}
+		} catch (...) {
+			state.setError(std::current_exception());
+		}
+	}
+};
+
+}  // namespace njhseq
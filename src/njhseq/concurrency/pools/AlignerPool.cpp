@@ -42,7 +42,7 @@ AlignerPool::AlignerPool(uint64_t startingMaxLen, const gapScoringParameters & g
 
 AlignerPool::AlignerPool(const aligner & alignerObj, const size_t size) :
 		startingMaxLen_(alignerObj.parts_.maxSize_), gapInfo_(alignerObj.parts_.gapScores_), scoring_(
-				alignerObj.parts_.scoring_), size_(size) {
+				alignerObj.parts_.getScoring()), size_(size) {
 	for (uint32_t i = 0; i < size_; ++i) {
 		aligners_.emplace_back(alignerObj);
 	}
@@ -105,6 +105,15 @@ void AlignerPool::destoryAlignersNoLock(){
 	}
 }
 
+void AlignerPool::mergeAlnCachesInto(aligner & alignerObj){
+	std::lock_guard<std::mutex> lock(poolmtx_); // GUARD
+	for (const aligner& pooledAligner : aligners_) {
+		if (pooledAligner.numberOfAlingmentsDone_ > 0) {
+			alignerObj.alnHolder_.mergeOtherHolder(pooledAligner.alnHolder_);
+		}
+	}
+}
+
 void AlignerPool::pushAligner(aligner& alignerObj){
 	if(!closing_){
 		AlignerPool* p = this;
@@ -78,6 +78,13 @@ public:
 
 	void destoryAligners();
 
+	/**@brief Merge the alignment caches of all the pooled aligners into the cache of alignerObj
+	 *
+	 * @param alignerObj the aligner to merge the caches into
+	 * @warning should only be called once all popped aligners have been returned to the pool (e.g. after all worker threads have been joined)
+	 */
+	void mergeAlnCachesInto(aligner & alignerObj);
+
 };
 
 class AlignerPoolException: public njh::err::Exception {
@@ -28,5 +28,6 @@
 #include "njhseq/helpers/profiler.hpp"
 #include "njhseq/helpers/consensusHelper.hpp"
 #include "njhseq/helpers/GHDNA.hpp"
+#include "njhseq/helpers/SeqKernels.hpp"
 
 
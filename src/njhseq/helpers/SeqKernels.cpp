@@ -0,0 +1,540 @@
+/*
+ * SeqKernels.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: nick
+ */
+// njhseq - A library for analyzing sequence data
+// Copyright (C) 2012-2018 Nicholas Hathaway <nicholas.hathaway@umassmed.edu>,
+//
+// This file is part of njhseq.
+//
+// njhseq is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// njhseq is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with njhseq.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "SeqKernels.hpp"
+#include <atomic>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define NJHSEQ_SEQKERNELS_X86 1
+#include <immintrin.h>
+#endif
+
+namespace njhseq {
+
+namespace {
+
+/**@brief The complement of every character, 0 for characters without one
+ *
+ */
+struct ComplementTables {
+	std::array<uint8_t, 256> dna_;
+	std::array<uint8_t, 256> rna_;
+
+	ComplementTables() {
+		dna_.fill(0);
+		const std::string from = "ACGTURYSWKMBVDHN";
+		const std::string to =   "TGCAAYRSWMKVBHDN";
+		for (const auto pos : iter::range(from.size())) {
+			dna_[static_cast<uint8_t>(from[pos])] = to[pos];
+			dna_[static_cast<uint8_t>(std::tolower(from[pos]))] = std::tolower(to[pos]);
+		}
+		for (const auto c : std::string(".-*")) {
+			dna_[static_cast<uint8_t>(c)] = c;
+		}
+		rna_ = dna_;
+		rna_['A'] = 'U';
+		rna_['a'] = 'u';
+	}
+};
+
+const ComplementTables & getComplementTables() {
+	static const ComplementTables tables;
+	return tables;
+}
+
+std::atomic<SeqKernels::Level> & getLevelState() {
+	static std::atomic<SeqKernels::Level> level { SeqKernels::getSupportedLevel() };
+	return level;
+}
+
+//scalar, also used for the ends the vector versions don't cover
+
+bool reverseComplementScalar(const char * seq, char * out, size_t start,
+		size_t len, const std::array<uint8_t, 256> & table) {
+	uint8_t missing = 0;
+	for (size_t pos = start; pos < len; ++pos) {
+		const uint8_t comp = table[static_cast<uint8_t>(seq[len - 1 - pos])];
+		missing |= (0 == comp);
+		out[pos] = static_cast<char>(comp);
+	}
+	return 0 == missing;
+}
+
+void homopolymerRunEndsScalar(const char * seq, size_t start, size_t len,
+		std::vector<uint32_t> & ends) {
+	for (size_t pos = start; pos + 1 < len; ++pos) {
+		if (seq[pos] != seq[pos + 1]) {
+			ends.emplace_back(pos + 1);
+		}
+	}
+}
+
+uint32_t countQualsAtOrAboveScalar(const uint8_t * quals, size_t start,
+		size_t len, uint8_t cutOff) {
+	uint32_t ret = 0;
+	for (size_t pos = start; pos < len; ++pos) {
+		ret += (quals[pos] >= cutOff);
+	}
+	return ret;
+}
+
+size_t findFirstQualBelowScalar(const uint8_t * quals, size_t start,
+		size_t len, uint8_t cutOff) {
+	for (size_t pos = start; pos < len; ++pos) {
+		if (quals[pos] < cutOff) {
+			return pos;
+		}
+	}
+	return len;
+}
+
+#if defined(NJHSEQ_SEQKERNELS_X86)
+
+/**@brief The complement table split by the high half of each character so it can be looked up 16 characters at a time with a byte shuffle,
+ * only characters 0x20-0x2F and 0x40-0x7F have complements
+ *
+ */
+struct NibbleTables {
+	alignas(16) std::array<uint8_t, 16> punct_;
+	alignas(16) std::array<uint8_t, 16> upperLow_;
+	alignas(16) std::array<uint8_t, 16> upperHigh_;
+	alignas(16) std::array<uint8_t, 16> lowerLow_;
+	alignas(16) std::array<uint8_t, 16> lowerHigh_;
+
+	explicit NibbleTables(const std::array<uint8_t, 256> & table) {
+		for (const auto pos : iter::range<uint32_t>(16)) {
+			punct_[pos] = table[0x20 + pos];
+			upperLow_[pos] = table[0x40 + pos];
+			upperHigh_[pos] = table[0x50 + pos];
+			lowerLow_[pos] = table[0x60 + pos];
+			lowerHigh_[pos] = table[0x70 + pos];
+		}
+	}
+};
+
+const NibbleTables & getNibbleTables(bool rna) {
+	static const NibbleTables dna(getComplementTables().dna_);
+	static const NibbleTables rnaTables(getComplementTables().rna_);
+	return rna ? rnaTables : dna;
+}
+
+__attribute__((target("ssse3")))
+bool reverseComplementSSSE3(const char * seq, char * out, size_t len,
+		const NibbleTables & nibbles, const std::array<uint8_t, 256> & table) {
+	const __m128i reverseMask = _mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+	const __m128i lowNibble = _mm_set1_epi8(0x0F);
+	const __m128i punct = _mm_load_si128(reinterpret_cast<const __m128i *>(nibbles.punct_.data()));
+	const __m128i upperLow = _mm_load_si128(reinterpret_cast<const __m128i *>(nibbles.upperLow_.data()));
+	const __m128i upperHigh = _mm_load_si128(reinterpret_cast<const __m128i *>(nibbles.upperHigh_.data()));
+	const __m128i lowerLow = _mm_load_si128(reinterpret_cast<const __m128i *>(nibbles.lowerLow_.data()));
+	const __m128i lowerHigh = _mm_load_si128(reinterpret_cast<const __m128i *>(nibbles.lowerHigh_.data()));
+	__m128i missing = _mm_setzero_si128();
+	size_t pos = 0;
+	for (; pos + 16 <= len; pos += 16) {
+		const __m128i bases = _mm_shuffle_epi8(
+				_mm_loadu_si128(reinterpret_cast<const __m128i *>(seq + len - pos - 16)), reverseMask);
+		const __m128i lo = _mm_and_si128(bases, lowNibble);
+		const __m128i hi = _mm_and_si128(_mm_srli_epi16(bases, 4), lowNibble);
+		__m128i comp = _mm_and_si128(_mm_cmpeq_epi8(hi, _mm_set1_epi8(2)), _mm_shuffle_epi8(punct, lo));
+		comp = _mm_or_si128(comp, _mm_and_si128(_mm_cmpeq_epi8(hi, _mm_set1_epi8(4)), _mm_shuffle_epi8(upperLow, lo)));
+		comp = _mm_or_si128(comp, _mm_and_si128(_mm_cmpeq_epi8(hi, _mm_set1_epi8(5)), _mm_shuffle_epi8(upperHigh, lo)));
+		comp = _mm_or_si128(comp, _mm_and_si128(_mm_cmpeq_epi8(hi, _mm_set1_epi8(6)), _mm_shuffle_epi8(lowerLow, lo)));
+		comp = _mm_or_si128(comp, _mm_and_si128(_mm_cmpeq_epi8(hi, _mm_set1_epi8(7)), _mm_shuffle_epi8(lowerHigh, lo)));
+		missing = _mm_or_si128(missing, _mm_cmpeq_epi8(comp, _mm_setzero_si128()));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(out + pos), comp);
+	}
+	const bool allFound = 0 == _mm_movemask_epi8(missing);
+	return reverseComplementScalar(seq, out, pos, len, table) && allFound;
+}
+
+__attribute__((target("avx2")))
+bool reverseComplementAVX2(const char * seq, char * out, size_t len,
+		const NibbleTables & nibbles, const std::array<uint8_t, 256> & table) {
+	const __m256i reverseMask = _mm256_setr_epi8(
+			15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0,
+			15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+	const __m256i lowNibble = _mm256_set1_epi8(0x0F);
+	const __m256i punct = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i *>(nibbles.punct_.data())));
+	const __m256i upperLow = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i *>(nibbles.upperLow_.data())));
+	const __m256i upperHigh = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i *>(nibbles.upperHigh_.data())));
+	const __m256i lowerLow = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i *>(nibbles.lowerLow_.data())));
+	const __m256i lowerHigh = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i *>(nibbles.lowerHigh_.data())));
+	__m256i missing = _mm256_setzero_si256();
+	size_t pos = 0;
+	for (; pos + 32 <= len; pos += 32) {
+		const __m256i laneReversed = _mm256_shuffle_epi8(
+				_mm256_loadu_si256(reinterpret_cast<const __m256i *>(seq + len - pos - 32)), reverseMask);
+		const __m256i bases = _mm256_permute2x128_si256(laneReversed, laneReversed, 0x01);
+		const __m256i lo = _mm256_and_si256(bases, lowNibble);
+		const __m256i hi = _mm256_and_si256(_mm256_srli_epi16(bases, 4), lowNibble);
+		__m256i comp = _mm256_and_si256(_mm256_cmpeq_epi8(hi, _mm256_set1_epi8(2)), _mm256_shuffle_epi8(punct, lo));
+		comp = _mm256_or_si256(comp, _mm256_and_si256(_mm256_cmpeq_epi8(hi, _mm256_set1_epi8(4)), _mm256_shuffle_epi8(upperLow, lo)));
+		comp = _mm256_or_si256(comp, _mm256_and_si256(_mm256_cmpeq_epi8(hi, _mm256_set1_epi8(5)), _mm256_shuffle_epi8(upperHigh, lo)));
+		comp = _mm256_or_si256(comp, _mm256_and_si256(_mm256_cmpeq_epi8(hi, _mm256_set1_epi8(6)), _mm256_shuffle_epi8(lowerLow, lo)));
+		comp = _mm256_or_si256(comp, _mm256_and_si256(_mm256_cmpeq_epi8(hi, _mm256_set1_epi8(7)), _mm256_shuffle_epi8(lowerHigh, lo)));
+		missing = _mm256_or_si256(missing, _mm256_cmpeq_epi8(comp, _mm256_setzero_si256()));
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(out + pos), comp);
+	}
+	const bool allFound = 0 == _mm256_movemask_epi8(missing);
+	return reverseComplementScalar(seq, out, pos, len, table) && allFound;
+}
+
+/**@brief Sum the bytes of counts, each byte is a count of at most 255
+ *
+ */
+__attribute__((target("ssse3")))
+uint32_t sumByteCounts128(__m128i counts) {
+	const __m128i sums = _mm_sad_epu8(counts, _mm_setzero_si128());
+	return _mm_cvtsi128_si32(sums) + _mm_extract_epi16(sums, 4);
+}
+
+__attribute__((target("avx2")))
+uint32_t sumByteCounts256(__m256i counts) {
+	const __m256i sums = _mm256_sad_epu8(counts, _mm256_setzero_si256());
+	return _mm256_extract_epi64(sums, 0) + _mm256_extract_epi64(sums, 1)
+			+ _mm256_extract_epi64(sums, 2) + _mm256_extract_epi64(sums, 3);
+}
+
+__attribute__((target("ssse3")))
+void homopolymerRunEndsSSSE3(const char * seq, size_t len,
+		std::vector<uint32_t> & ends) {
+	size_t pos = 0;
+	for (; pos + 17 <= len; pos += 16) {
+		const __m128i bases = _mm_loadu_si128(reinterpret_cast<const __m128i *>(seq + pos));
+		const __m128i next = _mm_loadu_si128(reinterpret_cast<const __m128i *>(seq + pos + 1));
+		uint32_t changes = ~static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bases, next))) & 0xFFFFu;
+		while (0 != changes) {
+			ends.emplace_back(pos + __builtin_ctz(changes) + 1);
+			changes &= changes - 1;
+		}
+	}
+	homopolymerRunEndsScalar(seq, pos, len, ends);
+}
+
+__attribute__((target("avx2")))
+void homopolymerRunEndsAVX2(const char * seq, size_t len,
+		std::vector<uint32_t> & ends) {
+	size_t pos = 0;
+	for (; pos + 33 <= len; pos += 32) {
+		const __m256i bases = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(seq + pos));
+		const __m256i next = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(seq + pos + 1));
+		uint32_t changes = ~static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(bases, next)));
+		while (0 != changes) {
+			ends.emplace_back(pos + __builtin_ctz(changes) + 1);
+			changes &= changes - 1;
+		}
+	}
+	homopolymerRunEndsScalar(seq, pos, len, ends);
+}
+
+//a quality is at or above the cut off when the max of the two is the quality,
+//the matches are counted in bytes that are summed every 255 blocks before they can overflow
+
+__attribute__((target("ssse3")))
+uint32_t countQualsAtOrAboveSSSE3(const uint8_t * quals, size_t len,
+		uint8_t cutOff) {
+	const __m128i cut = _mm_set1_epi8(static_cast<char>(cutOff));
+	uint32_t ret = 0;
+	size_t pos = 0;
+	while (pos + 16 <= len) {
+		__m128i counts = _mm_setzero_si128();
+		for (uint32_t block = 0; block < 255 && pos + 16 <= len; ++block, pos += 16) {
+			const __m128i q = _mm_loadu_si128(reinterpret_cast<const __m128i *>(quals + pos));
+			counts = _mm_sub_epi8(counts, _mm_cmpeq_epi8(_mm_max_epu8(q, cut), q));
+		}
+		ret += sumByteCounts128(counts);
+	}
+	return ret + countQualsAtOrAboveScalar(quals, pos, len, cutOff);
+}
+
+__attribute__((target("avx2")))
+uint32_t countQualsAtOrAboveAVX2(const uint8_t * quals, size_t len,
+		uint8_t cutOff) {
+	const __m256i cut = _mm256_set1_epi8(static_cast<char>(cutOff));
+	uint32_t ret = 0;
+	size_t pos = 0;
+	while (pos + 32 <= len) {
+		__m256i counts = _mm256_setzero_si256();
+		for (uint32_t block = 0; block < 255 && pos + 32 <= len; ++block, pos += 32) {
+			const __m256i q = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(quals + pos));
+			counts = _mm256_sub_epi8(counts, _mm256_cmpeq_epi8(_mm256_max_epu8(q, cut), q));
+		}
+		ret += sumByteCounts256(counts);
+	}
+	return ret + countQualsAtOrAboveScalar(quals, pos, len, cutOff);
+}
+
+__attribute__((target("ssse3")))
+size_t findFirstQualBelowSSSE3(const uint8_t * quals, size_t len,
+		uint8_t cutOff) {
+	const __m128i cut = _mm_set1_epi8(static_cast<char>(cutOff));
+	size_t pos = 0;
+	for (; pos + 16 <= len; pos += 16) {
+		const __m128i q = _mm_loadu_si128(reinterpret_cast<const __m128i *>(quals + pos));
+		const uint32_t below = ~static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(q, cut), q))) & 0xFFFFu;
+		if (0 != below) {
+			return pos + __builtin_ctz(below);
+		}
+	}
+	return findFirstQualBelowScalar(quals, pos, len, cutOff);
+}
+
+__attribute__((target("avx2")))
+size_t findFirstQualBelowAVX2(const uint8_t * quals, size_t len,
+		uint8_t cutOff) {
+	const __m256i cut = _mm256_set1_epi8(static_cast<char>(cutOff));
+	size_t pos = 0;
+	for (; pos + 32 <= len; pos += 32) {
+		const __m256i q = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(quals + pos));
+		const uint32_t below = ~static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_max_epu8(q, cut), q)));
+		if (0 != below) {
+			return pos + __builtin_ctz(below);
+		}
+	}
+	return findFirstQualBelowScalar(quals, pos, len, cutOff);
+}
+
+#endif
+
+}  // namespace
+
+SeqKernels::Level SeqKernels::getSupportedLevel() {
+#if defined(NJHSEQ_SEQKERNELS_X86)
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2")) {
+		return Level::AVX2;
+	}
+	if (__builtin_cpu_supports("ssse3")) {
+		return Level::SSSE3;
+	}
+#endif
+	return Level::SCALAR;
+}
+
+SeqKernels::Level SeqKernels::getLevel() {
+	return getLevelState().load(std::memory_order_relaxed);
+}
+
+void SeqKernels::setLevel(Level level) {
+	getLevelState().store(std::min(level, getSupportedLevel()),
+			std::memory_order_relaxed);
+}
+
+std::string SeqKernels::getLevelName(Level level) {
+	switch (level) {
+	case Level::SCALAR:
+		return "scalar";
+		break;
+	case Level::SSSE3:
+		return "ssse3";
+		break;
+	case Level::AVX2:
+		return "avx2";
+		break;
+	default: {
+		std::stringstream ss;
+		ss << __PRETTY_FUNCTION__ << ", error " << "unhandled level: "
+				<< static_cast<uint32_t>(level) << "\n";
+		throw std::runtime_error { ss.str() };
+	}
+		break;
+	}
+}
+
+bool SeqKernels::reverseComplement(const std::string & seq, std::string & out,
+		bool rna) {
+	out.resize(seq.size());
+	const auto & table = rna ? getComplementTables().rna_ : getComplementTables().dna_;
+#if defined(NJHSEQ_SEQKERNELS_X86)
+	switch (getLevel()) {
+	case Level::AVX2:
+		return reverseComplementAVX2(seq.data(), &out[0], seq.size(), getNibbleTables(rna), table);
+		break;
+	case Level::SSSE3:
+		return reverseComplementSSSE3(seq.data(), &out[0], seq.size(), getNibbleTables(rna), table);
+		break;
+	default:
+		break;
+	}
+#endif
+	return reverseComplementScalar(seq.data(), &out[0], 0, seq.size(), table);
+}
+
+void SeqKernels::countBases(const std::string & seq,
+		std::array<uint32_t, 256> & counts) {
+	//a byte histogram doesn't vectorize, four tables break the dependency between repeats of the same base instead
+	std::array<std::array<uint32_t, 256>, 4> tables { };
+	const auto data = reinterpret_cast<const uint8_t *>(seq.data());
+	size_t pos = 0;
+	for (; pos + 4 <= seq.size(); pos += 4) {
+		++tables[0][data[pos]];
+		++tables[1][data[pos + 1]];
+		++tables[2][data[pos + 2]];
+		++tables[3][data[pos + 3]];
+	}
+	for (; pos < seq.size(); ++pos) {
+		++tables[0][data[pos]];
+	}
+	for (const auto c : iter::range<uint32_t>(256)) {
+		counts[c] += tables[0][c] + tables[1][c] + tables[2][c] + tables[3][c];
+	}
+}
+
+void SeqKernels::homopolymerRunEnds(const std::string & seq,
+		std::vector<uint32_t> & ends) {
+	ends.clear();
+	if (seq.empty()) {
+		return;
+	}
+#if defined(NJHSEQ_SEQKERNELS_X86)
+	switch (getLevel()) {
+	case Level::AVX2:
+		homopolymerRunEndsAVX2(seq.data(), seq.size(), ends);
+		break;
+	case Level::SSSE3:
+		homopolymerRunEndsSSSE3(seq.data(), seq.size(), ends);
+		break;
+	default:
+		homopolymerRunEndsScalar(seq.data(), 0, seq.size(), ends);
+		break;
+	}
+#else
+	homopolymerRunEndsScalar(seq.data(), 0, seq.size(), ends);
+#endif
+	ends.emplace_back(seq.size());
+}
+
+uint32_t SeqKernels::countQualsAtOrAbove(const std::vector<uint8_t> & quals,
+		uint32_t cutOff) {
+	if (cutOff > std::numeric_limits<uint8_t>::max()) {
+		return 0;
+	}
+	const uint8_t cut = cutOff;
+#if defined(NJHSEQ_SEQKERNELS_X86)
+	switch (getLevel()) {
+	case Level::AVX2:
+		return countQualsAtOrAboveAVX2(quals.data(), quals.size(), cut);
+		break;
+	case Level::SSSE3:
+		return countQualsAtOrAboveSSSE3(quals.data(), quals.size(), cut);
+		break;
+	default:
+		break;
+	}
+#endif
+	return countQualsAtOrAboveScalar(quals.data(), 0, quals.size(), cut);
+}
+
+size_t SeqKernels::findFirstQualBelow(const std::vector<uint8_t> & quals,
+		uint32_t cutOff) {
+	if (cutOff > std::numeric_limits<uint8_t>::max()) {
+		return 0;
+	}
+	const uint8_t cut = cutOff;
+#if defined(NJHSEQ_SEQKERNELS_X86)
+	switch (getLevel()) {
+	case Level::AVX2:
+		return findFirstQualBelowAVX2(quals.data(), quals.size(), cut);
+		break;
+	case Level::SSSE3:
+		return findFirstQualBelowSSSE3(quals.data(), quals.size(), cut);
+		break;
+	default:
+		break;
+	}
+#endif
+	return findFirstQualBelowScalar(quals.data(), 0, quals.size(), cut);
+}
+
+void SeqKernels::benchmark(std::ostream & out, uint32_t seqLength,
+		uint32_t numberOfSeqs, uint32_t iterations) {
+	std::mt19937 gen(7);
+	std::uniform_int_distribution<uint32_t> baseDist(0, 3);
+	std::uniform_int_distribution<uint32_t> qualDist(2, 41);
+	const std::string bases = "ACGT";
+	std::vector<std::string> seqs(numberOfSeqs, std::string(seqLength, 'A'));
+	std::vector<std::vector<uint8_t>> quals(numberOfSeqs, std::vector<uint8_t>(seqLength, 0));
+	for (const auto seqPos : iter::range(numberOfSeqs)) {
+		for (const auto pos : iter::range(seqLength)) {
+			seqs[seqPos][pos] = bases[baseDist(gen)];
+			quals[seqPos][pos] = qualDist(gen);
+		}
+	}
+	std::vector<std::pair<std::string, std::function<uint64_t(uint32_t)>>> kernels;
+	std::string rComp;
+	kernels.emplace_back("reverseComplement", [&seqs, &rComp](uint32_t seqPos) -> uint64_t {
+		reverseComplement(seqs[seqPos], rComp);
+		return static_cast<uint8_t>(rComp.front());
+	});
+	std::array<uint32_t, 256> counts;
+	kernels.emplace_back("countBases", [&seqs, &counts](uint32_t seqPos) -> uint64_t {
+		counts.fill(0);
+		countBases(seqs[seqPos], counts);
+		return counts['G'];
+	});
+	std::vector<uint32_t> ends;
+	kernels.emplace_back("homopolymerRunEnds", [&seqs, &ends](uint32_t seqPos) -> uint64_t {
+		homopolymerRunEnds(seqs[seqPos], ends);
+		return ends.size();
+	});
+	kernels.emplace_back("countQualsAtOrAbove", [&quals](uint32_t seqPos) -> uint64_t {
+		return countQualsAtOrAbove(quals[seqPos], 30);
+	});
+	kernels.emplace_back("findFirstQualBelow", [&quals](uint32_t seqPos) -> uint64_t {
+		return findFirstQualBelow(quals[seqPos], 5);
+	});
+
+	const auto startingLevel = getLevel();
+	std::vector<Level> levels { Level::SCALAR };
+	if (getSupportedLevel() >= Level::SSSE3) {
+		levels.emplace_back(Level::SSSE3);
+	}
+	if (getSupportedLevel() >= Level::AVX2) {
+		levels.emplace_back(Level::AVX2);
+	}
+	out << "kernel\tlevel\tseconds\tmillionBasesPerSecond\tcheckSum" << "\n";
+	for (const auto & kernel : kernels) {
+		for (const auto level : levels) {
+			setLevel(level);
+			uint64_t checkSum = 0;
+			const auto start = std::chrono::steady_clock::now();
+			for (uint32_t iteration = 0; iteration < iterations; ++iteration) {
+				for (const auto seqPos : iter::range(numberOfSeqs)) {
+					checkSum += kernel.second(seqPos);
+				}
+			}
+			const double seconds = std::chrono::duration<double>(
+					std::chrono::steady_clock::now() - start).count();
+			const double millionBases = static_cast<double>(seqLength) * numberOfSeqs * iterations / 1000000.0;
+			out << kernel.first
+					<< "\t" << getLevelName(level)
+					<< "\t" << seconds
+					<< "\t" << (seconds > 0 ? millionBases / seconds : 0)
+					<< "\t" << checkSum << "\n";
+		}
+	}
+	setLevel(startingLevel);
+}
+
+}  // namespace njhseq
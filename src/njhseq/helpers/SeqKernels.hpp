@@ -0,0 +1,99 @@
+#pragma once
+/*
+ * SeqKernels.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: nick
+ */
+// njhseq - A library for analyzing sequence data
+// Copyright (C) 2012-2018 Nicholas Hathaway <nicholas.hathaway@umassmed.edu>,
+//
+// This file is part of njhseq.
+//
+// njhseq is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// njhseq is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with njhseq.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "njhseq/utils.h"
+
+namespace njhseq {
+
+/**@brief Per read loops over sequences and qualities written with SSSE3 and AVX2 on x86-64 and plain loops everywhere else
+ *
+ * The instruction set is picked the first time a kernel is called from what the cpu supports, every level gives exactly the same results
+ *
+ */
+class SeqKernels {
+public:
+	enum class Level : uint8_t {
+		SCALAR, SSSE3, AVX2
+	};
+
+	/**@brief The level the kernels are running at
+	 *
+	 */
+	static Level getLevel();
+	/**@brief The best level this cpu supports
+	 *
+	 */
+	static Level getSupportedLevel();
+	/**@brief Run the kernels at level, mostly for comparing levels, levels above getSupportedLevel() are lowered to it, not meant to be changed while other threads are using the kernels
+	 *
+	 */
+	static void setLevel(Level level);
+	static std::string getLevelName(Level level);
+
+	/**@brief Reverse complement seq into out, handles upper and lower case IUPAC bases and the gap/padding characters . - *
+	 *
+	 * @param seq the sequence
+	 * @param out set to the reverse complement
+	 * @param rna complement A to U rather than T
+	 * @return false if seq has a character without a complement, out is then not usable
+	 */
+	static bool reverseComplement(const std::string & seq, std::string & out,
+			bool rna = false);
+
+	/**@brief Add the count of each character in seq to counts
+	 *
+	 */
+	static void countBases(const std::string & seq,
+			std::array<uint32_t, 256> & counts);
+
+	/**@brief The end (not inclusive) of each homopolymer run in seq, empty for an empty seq
+	 *
+	 */
+	static void homopolymerRunEnds(const std::string & seq,
+			std::vector<uint32_t> & ends);
+
+	/**@brief The number of qualities at or above cutOff
+	 *
+	 */
+	static uint32_t countQualsAtOrAbove(const std::vector<uint8_t> & quals,
+			uint32_t cutOff);
+	/**@brief The position of the first quality below cutOff, quals.size() if there isn't one
+	 *
+	 */
+	static size_t findFirstQualBelow(const std::vector<uint8_t> & quals,
+			uint32_t cutOff);
+
+	/**@brief Time each kernel at each level this cpu supports on random reads and write a tab delimited table of the times
+	 *
+	 * @param out where to write the table
+	 * @param seqLength the length of the random reads
+	 * @param numberOfSeqs the number of random reads
+	 * @param iterations the number of times to run each kernel over all the reads
+	 */
+	static void benchmark(std::ostream & out, uint32_t seqLength = 250,
+			uint32_t numberOfSeqs = 10000, uint32_t iterations = 20);
+};
+
+}  // namespace njhseq
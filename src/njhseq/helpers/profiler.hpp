@@ -721,13 +721,13 @@ void profiler::outputQualityForGraphing(const std::vector<T>& reads,
         if (i >= rIter->seqBase_.qual_.size()) {
           out << "";
         } else {
-          out << rIter->seqBase_.qual_[i];
+          out << static_cast<uint32_t>(rIter->seqBase_.qual_[i]);
         }
       } else {
         if (i >= rIter->seqBase_.qual_.size()) {
           out << "";
         } else {
-          out << "\t" << rIter->seqBase_.qual_[i];
+          out << "\t" << static_cast<uint32_t>(rIter->seqBase_.qual_[i]);
         }
       }
     }
@@ -18,6 +18,7 @@
 // along with njhseq.  If not, see <http://www.gnu.org/licenses/>.
 //
 #include "seqUtil.hpp"
+#include "njhseq/helpers/SeqKernels.hpp"
 #include "njhseq/IO/fileUtils.hpp"
 
 namespace njhseq {
@@ -39,8 +40,12 @@ int seqUtil::calculateWeightOfProteinInt(const std::string &protein) {
 
 std::string seqUtil::reverseComplement(const std::string &seq,
                                        const std::string &seqType) {
-  size_t numChar = seq.size();
   std::string outSeq("");
+  if (SeqKernels::reverseComplement(seq, outSeq, seqType != "DNA")) {
+    return outSeq;
+  }
+  //a character without a complement, go through base by base to report it
+  size_t numChar = seq.size();
   outSeq.resize(numChar);
   char thisBase, outBase;
   for (size_t i = 0; i < numChar; ++i) {
@@ -337,38 +342,14 @@ std::string seqUtil::convertOneCodon(const std::string &codon) {
   return outSeq;
 }
 
-std::string seqUtil::convertToProtein(const std::string &seq, size_t start,
-                                      bool forceStartM) {
-
-  size_t numChar = seq.size() > start ? seq.size() - start : seq.size();
-
-  std::string outSeq("");
-  if(numChar < 3){
-  		return outSeq;
-  }
-  outSeq.resize(numChar / 3);  // numChar is exactly divisible by 3.
-  // In below, cB is currentBase.
-  char cB[3];
-	char newBase;
-
-//  std::cout << "seq: " << seq << std::endl;
+namespace {
 
-  for (size_t i = start; i < seq.size() - 2; i += 3) {
-//  	std::cout << "i: " << i << ", outSeq: " << outSeq << std::endl;
-    cB[0] = static_cast<char>(toupper(seq[i]));
-    cB[1] = static_cast<char>(toupper(seq[i + 1]));
-    cB[2] = static_cast<char>(toupper(seq[i + 2]));
-//    std::cout << "\tcB:" << cB << std::endl;
-    if (cB[0] == 'T') {
-      cB[0] = 'U';
-    }
-    if (cB[1] == 'T') {
-      cB[1] = 'U';
-    }
-    if (cB[2] == 'T') {
-      cB[2] = 'U';
-    }
-    newBase = '0';  // We'll designate * as Stop,
+/**@brief The amino acid for a codon whose bases have already been upper cased with T changed to U, anything not U, C or A is read as G except
+ * for the last base
+ *
+ */
+char translateCodon(const char cB[3]) {
+    char newBase = '0';  // We'll designate * as Stop,
     // and 1 as error.
     if(cB[0] == '-' || cB[1] == '-' || cB[2] == '-'){
     	newBase = 'X';
@@ -454,12 +435,82 @@ std::string seqUtil::convertToProtein(const std::string &seq, size_t start,
 				newBase = 'G';
 			}
 		}
+    return newBase;
+}
+
+/**@brief translateCodon as a table, the rules only tell apart U (or T), C, A, G, a gap and anything else so each base is reduced to one of those
+ * six classes and a codon is one look up
+ *
+ */
+class CodonTable {
+public:
+	static constexpr uint32_t numberOfClasses_ = 6;
+
+	CodonTable() {
+		const char classBases[numberOfClasses_] = { 'U', 'C', 'A', 'G', '-', 'N' };
+		classes_.fill(numberOfClasses_ - 1);
+		for (uint32_t letter = 0; letter < 256; ++letter) {
+			char upper = static_cast<char>(toupper(static_cast<char>(letter)));
+			if ('T' == upper) {
+				upper = 'U';
+			}
+			for (uint32_t baseClass = 0; baseClass < numberOfClasses_; ++baseClass) {
+				if (classBases[baseClass] == upper) {
+					classes_[letter] = baseClass;
+					break;
+				}
+			}
+		}
+		for (uint32_t first = 0; first < numberOfClasses_; ++first) {
+			for (uint32_t second = 0; second < numberOfClasses_; ++second) {
+				for (uint32_t third = 0; third < numberOfClasses_; ++third) {
+					const char cB[3] = { classBases[first], classBases[second], classBases[third] };
+					aminos_[(first * numberOfClasses_ + second) * numberOfClasses_ + third] = translateCodon(cB);
+				}
+			}
+		}
+	}
+
+	char translate(char first, char second, char third) const {
+		return aminos_[(classes_[static_cast<unsigned char>(first)] * numberOfClasses_
+				+ classes_[static_cast<unsigned char>(second)]) * numberOfClasses_
+				+ classes_[static_cast<unsigned char>(third)]];
+	}
+
+private:
+	std::array<uint8_t, 256> classes_;
+	std::array<char, numberOfClasses_ * numberOfClasses_ * numberOfClasses_> aminos_;
+};
+
+const CodonTable & getCodonTable() {
+	static const CodonTable codonTable;
+	return codonTable;
+}
+
+}  // namespace
+
+std::string seqUtil::convertToProtein(const std::string &seq, size_t start,
+                                      bool forceStartM) {
+
+  size_t numChar = seq.size() > start ? seq.size() - start : seq.size();
 
+  std::string outSeq("");
+  if(numChar < 3){
+  		return outSeq;
+  }
+  outSeq.resize(numChar / 3);  // numChar is exactly divisible by 3.
+  const auto & codonTable = getCodonTable();
+  for (size_t i = start; i < seq.size() - 2; i += 3) {
+    char newBase = codonTable.translate(seq[i], seq[i + 1], seq[i + 2]);
     if (forceStartM && (i == start)) {
+      // In below, cB is currentBase.
     	std::string cBstring = "   ";
-      cBstring[0] = cB[0];
-      cBstring[1] = cB[1];
-      cBstring[2] = cB[2];
+      for (uint32_t basePos = 0; basePos < 3; ++basePos) {
+        cBstring[basePos] = static_cast<char>(toupper(seq[i + basePos]));
+        if (cBstring[basePos] == 'T') {
+          cBstring[basePos] = 'U';
+        }
+      }
       // Below are all the known start codons.
       if ((cBstring == "AUG") || (cBstring == "GUG") || (cBstring == "UUG") ||
           (cBstring == "AUU") || (cBstring == "CUG")) {
@@ -469,8 +520,6 @@ std::string seqUtil::convertToProtein(const std::string &seq, size_t start,
     outSeq[(i - start) / 3] = newBase;
   }
 
-//	std::cout << "final outSeq: " << outSeq << std::endl;
-
   return outSeq;
 }
 
@@ -974,47 +1023,53 @@ void seqUtil::processQualityWindowString(const std::string &qualityWindowString,
 	}
 }
 
-bool seqUtil::checkQualityWindow(int windowSize, int minimumAverageQaul,
-                                 int stepSize,
-                                 const std::vector<uint32_t> &quality) {
-  bool pass = true;
+namespace {
+
+/**@brief The start of the first window, stepping by stepSize, with an average quality below minimumAverageQaul, quality.size() if every window passes
+ *
+ */
+template<typename T>
+size_t firstFailedQualityWindow(int windowSize, int minimumAverageQaul,
+                                int stepSize, const std::vector<T> &quality) {
   uint32_t currentPos = 0;
-  while ((windowSize + currentPos) < quality.size() && pass) {
+  while ((windowSize + currentPos) < quality.size()) {
     uint32_t sum = 0;
     for (const auto & qPos : iter::range(currentPos, currentPos + windowSize)) {
       sum += quality[qPos];
     }
     if ((static_cast<double>(sum) / windowSize) < minimumAverageQaul) {
-      pass = false;
-      break;
-    } else {
-      currentPos += stepSize;
+      return currentPos;
     }
+    currentPos += stepSize;
   }
-  return pass;
+  return quality.size();
+}
+
+}  // namespace
+
+bool seqUtil::checkQualityWindow(int windowSize, int minimumAverageQaul,
+                                 int stepSize,
+                                 const std::vector<uint32_t> &quality) {
+  return quality.size()
+      == firstFailedQualityWindow(windowSize, minimumAverageQaul, stepSize, quality);
+}
+bool seqUtil::checkQualityWindow(int windowSize, int minimumAverageQaul,
+                                 int stepSize,
+                                 const std::vector<uint8_t> &quality) {
+  return quality.size()
+      == firstFailedQualityWindow(windowSize, minimumAverageQaul, stepSize, quality);
 }
 size_t seqUtil::checkQualityWindowPos(int windowSize, int minimumAverageQaul,
                                       int stepSize,
                                       const std::vector<uint32_t> &quality) {
-	bool pass = true;
-  uint32_t currentPos = 0;
-  while ((windowSize + currentPos) < quality.size() && pass) {
-    uint32_t sum = 0;
-    for (const auto & qPos : iter::range(currentPos, currentPos + windowSize)) {
-      sum += quality[qPos];
-    }
-    if ((static_cast<double>(sum) / windowSize) < minimumAverageQaul) {
-      pass = false;
-      break;
-    } else {
-      currentPos += stepSize;
-    }
-  }
-  if (pass) {
-    return quality.size() - 1;
-  } else {
-    return currentPos;
-  }
+  auto pos = firstFailedQualityWindow(windowSize, minimumAverageQaul, stepSize, quality);
+  return quality.size() == pos ? quality.size() - 1 : pos;
+}
+size_t seqUtil::checkQualityWindowPos(int windowSize, int minimumAverageQaul,
+                                      int stepSize,
+                                      const std::vector<uint8_t> &quality) {
+  auto pos = firstFailedQualityWindow(windowSize, minimumAverageQaul, stepSize, quality);
+  return quality.size() == pos ? quality.size() - 1 : pos;
 }
 
 bool seqUtil::doesSequenceContainDegenerativeBase(const std::string &seq) {
@@ -1124,7 +1179,7 @@ uint64_t seqUtil::getNumberOfPossibleDNAStrandsFromProtein(
 }
 
 void seqUtil::removeLowerCase(std::string &sequence,
-                              std::vector<uint32_t> &quality) {
+                              std::vector<uint8_t> &quality) {
   for (uint32_t i = 0; i < sequence.size(); i++) {
     if (islower(sequence[i])) {
       sequence.erase(sequence.begin() + i);
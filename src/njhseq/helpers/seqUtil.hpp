@@ -107,9 +107,15 @@ class seqUtil {
   static size_t checkQualityWindowPos(int windowSize, int minimumAverageQaul,
                                       int stepSize,
                                       const std::vector<uint32_t> &quality);
+  static size_t checkQualityWindowPos(int windowSize, int minimumAverageQaul,
+                                      int stepSize,
+                                      const std::vector<uint8_t> &quality);
   static bool checkQualityWindow(int windowSize, int minimumAverageQaul,
                                  int stepSize,
                                  const std::vector<uint32_t> &quality);
+  static bool checkQualityWindow(int windowSize, int minimumAverageQaul,
+                                 int stepSize,
+                                 const std::vector<uint8_t> &quality);
   static void processQualityWindowString(const std::string &qualityWindowString,
                                          uint32_t &qualityWindowLength,
 																				 uint32_t &qualityWindowStep,
@@ -134,7 +140,7 @@ class seqUtil {
 
 
   static void removeLowerCase(std::string &sequence,
-                              std::vector<uint32_t> &quality);
+                              std::vector<uint8_t> &quality);
 
   static std::pair<std::string, std::vector<uint32_t>> removeLowerCaseReturn(
       std::string sequence, std::vector<uint32_t> quality);
@@ -24,6 +24,7 @@
 #include "njhseq/objects/BioDataObject/BioDataFileIO.hpp"
 #include "njhseq/objects/BioDataObject/GenomicRegion.hpp"
 #include "njhseq/objects/BioDataObject/GFFCore.hpp"
+#include "njhseq/objects/BioDataObject/GFFAnnotationIndex.hpp"
 #include "njhseq/objects/BioDataObject/reading.hpp"
 #include "njhseq/objects/BioDataObject/RefSeqGeneRecord.hpp"
 #include "njhseq/objects/BioDataObject/RepeatMaskerRecord.hpp"
@@ -0,0 +1,259 @@
+/*
+ * GFFAnnotationIndex.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: nick
+ */
+// njhseq - A library for analyzing sequence data
+// Copyright (C) 2012-2018 Nicholas Hathaway <nicholas.hathaway@umassmed.edu>,
+//
+// This file is part of njhseq.
+//
+// njhseq is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// njhseq is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with njhseq.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "GFFAnnotationIndex.hpp"
+#include "njhseq/objects/BioDataObject/BioDataFileIO.hpp"
+
+namespace njhseq {
+
+const std::vector<uint32_t> GFFAnnotationIndex::empty_;
+std::mutex GFFAnnotationIndex::cacheMut_;
+std::unordered_map<std::string, std::shared_ptr<const GFFAnnotationIndex>> GFFAnnotationIndex::cache_;
+
+GFFAnnotationIndex::GFFAnnotationIndex(const bfs::path & gffFnp) :
+		gffFnp_(gffFnp), time_(njh::files::last_write_time(gffFnp)) {
+	BioDataFileIO<GFFCore> reader { IoOptions(InOptions(gffFnp_)) };
+	reader.openIn();
+	std::string line = "";
+	GFFCore record;
+	while (reader.readNextRecord(record)) {
+		const uint32_t recordPos = records_.size();
+		recordIdCodes_.emplace_back(record.hasAttr("ID") ? internId(record.getAttr("ID")) : noId_);
+		if (noId_ != recordIdCodes_.back()) {
+			recordsForId_[recordIdCodes_.back()].emplace_back(recordPos);
+		}
+		if (record.hasAttr("Parent")) {
+			for (const auto & parent : tokenizeString(record.getAttr("Parent"), ",")) {
+				childrenForId_[internId(parent)].emplace_back(recordPos);
+			}
+		}
+		if (record.hasAttr("Derives_from")) {
+			derivedForId_[internId(record.getAttr("Derives_from"))].emplace_back(recordPos);
+		}
+		records_.emplace_back(std::move(record));
+		bool end = false;
+		while ('#' == reader.inFile_->peek()) {
+			if (njh::files::nextLineBeginsWith(*reader.inFile_, "##FASTA")) {
+				end = true;
+				break;
+			}
+			njh::files::crossPlatGetline(*reader.inFile_, line);
+		}
+		if (end) {
+			break;
+		}
+	}
+	std::unordered_map<std::string, std::vector<uint32_t>> chromPositions;
+	for (const auto recordPos : iter::range(records_.size())) {
+		chromPositions[records_[recordPos].seqid_].emplace_back(recordPos);
+	}
+	for (auto & chrom : chromPositions) {
+		buildChromRecords(chrom.second, chroms_[chrom.first]);
+	}
+}
+
+void GFFAnnotationIndex::buildChromRecords(std::vector<uint32_t> & positions,
+		ChromRecords & chromRecords) const {
+	//by start and then longest first so a record comes after every record that contains it
+	std::stable_sort(positions.begin(), positions.end(),
+			[this](uint32_t pos1, uint32_t pos2) {
+				if (records_[pos1].start_ == records_[pos2].start_) {
+					return records_[pos1].end_ > records_[pos2].end_;
+				}
+				return records_[pos1].start_ < records_[pos2].start_;
+			});
+	//the stack holds the chain of records containing the current one, the top is its parent
+	std::vector<uint32_t> topLevel;
+	std::vector<std::vector<uint32_t>> contained(positions.size());
+	std::vector<uint32_t> containing;
+	for (const auto sortedPos : iter::range<uint32_t>(positions.size())) {
+		while (!containing.empty()
+				&& records_[positions[containing.back()]].end_ < records_[positions[sortedPos]].end_) {
+			containing.pop_back();
+		}
+		if (containing.empty()) {
+			topLevel.emplace_back(sortedPos);
+		} else {
+			contained[containing.back()].emplace_back(sortedPos);
+		}
+		containing.emplace_back(sortedPos);
+	}
+	//lay the lists out one after another, the top level first, then each record's sublist as it's reached
+	std::vector<uint32_t> laidOutSortedPos;
+	laidOutSortedPos.reserve(positions.size());
+	auto addList = [this, &positions, &chromRecords, &laidOutSortedPos](const std::vector<uint32_t> & list) {
+		for (const auto sortedPos : list) {
+			const auto recordPos = positions[sortedPos];
+			laidOutSortedPos.emplace_back(sortedPos);
+			chromRecords.recordPositions_.emplace_back(recordPos);
+			//gff is 1 based and end inclusive
+			chromRecords.starts_.emplace_back(records_[recordPos].start_ - 1);
+			chromRecords.ends_.emplace_back(records_[recordPos].end_);
+			chromRecords.sublistStarts_.emplace_back(0);
+			chromRecords.sublistEnds_.emplace_back(0);
+		}
+	};
+	addList(topLevel);
+	chromRecords.topLevelEnd_ = topLevel.size();
+	for (uint32_t laidOutPos = 0; laidOutPos < laidOutSortedPos.size(); ++laidOutPos) {
+		const auto & sublist = contained[laidOutSortedPos[laidOutPos]];
+		if (!sublist.empty()) {
+			chromRecords.sublistStarts_[laidOutPos] = laidOutSortedPos.size();
+			addList(sublist);
+			chromRecords.sublistEnds_[laidOutPos] = laidOutSortedPos.size();
+		}
+	}
+}
+
+uint32_t GFFAnnotationIndex::internId(const std::string & id) {
+	auto search = idCodes_.find(id);
+	if (idCodes_.end() != search) {
+		return search->second;
+	}
+	const uint32_t code = recordsForId_.size();
+	idCodes_.emplace(id, code);
+	recordsForId_.emplace_back();
+	childrenForId_.emplace_back();
+	derivedForId_.emplace_back();
+	return code;
+}
+
+std::shared_ptr<const GFFAnnotationIndex> GFFAnnotationIndex::getIndex(
+		const bfs::path & gffFnp) {
+	const auto key = njh::files::normalize(gffFnp).string();
+	{
+		std::lock_guard<std::mutex> lock(cacheMut_);
+		auto search = cache_.find(key);
+		if (cache_.end() != search
+				&& search->second->time_ == njh::files::last_write_time(gffFnp)) {
+			return search->second;
+		}
+	}
+	//build without holding the lock so other files can be looked up, two threads asking for the same new file will both build it
+	auto index = std::make_shared<const GFFAnnotationIndex>(gffFnp);
+	std::lock_guard<std::mutex> lock(cacheMut_);
+	cache_[key] = index;
+	return index;
+}
+
+uint32_t GFFAnnotationIndex::numberOfRecords() const {
+	return records_.size();
+}
+
+const GFFCore & GFFAnnotationIndex::getRecord(uint32_t recordPos) const {
+	if (recordPos >= records_.size()) {
+		std::stringstream ss;
+		ss << __PRETTY_FUNCTION__ << ", error " << "recordPos: " << recordPos
+				<< " out of range, number of records: " << records_.size() << "\n";
+		throw std::out_of_range { ss.str() };
+	}
+	return records_[recordPos];
+}
+
+const std::vector<uint32_t> & GFFAnnotationIndex::getRecordsWithId(
+		const std::string & id) const {
+	auto search = idCodes_.find(id);
+	if (idCodes_.end() == search) {
+		return empty_;
+	}
+	return recordsForId_[search->second];
+}
+
+const std::vector<uint32_t> & GFFAnnotationIndex::getChildren(
+		uint32_t recordPos) const {
+	getRecord(recordPos);
+	if (noId_ == recordIdCodes_[recordPos]) {
+		return empty_;
+	}
+	return childrenForId_[recordIdCodes_[recordPos]];
+}
+
+const std::vector<uint32_t> & GFFAnnotationIndex::getDerivedFrom(
+		uint32_t recordPos) const {
+	getRecord(recordPos);
+	if (noId_ == recordIdCodes_[recordPos]) {
+		return empty_;
+	}
+	return derivedForId_[recordIdCodes_[recordPos]];
+}
+
+std::vector<uint32_t> GFFAnnotationIndex::getDescendants(
+		uint32_t recordPos) const {
+	getRecord(recordPos);
+	std::vector<uint32_t> ret;
+	std::vector<char> added(records_.size(), 0);
+	std::vector<char> visitedIds(recordsForId_.size(), 0);
+	std::vector<uint32_t> idsToVisit;
+	if (noId_ != recordIdCodes_[recordPos]) {
+		idsToVisit.emplace_back(recordIdCodes_[recordPos]);
+		visitedIds[recordIdCodes_[recordPos]] = 1;
+	}
+	while (!idsToVisit.empty()) {
+		const auto idCode = idsToVisit.back();
+		idsToVisit.pop_back();
+		for (const auto child : childrenForId_[idCode]) {
+			if (added[child] || child == recordPos) {
+				continue;
+			}
+			added[child] = 1;
+			ret.emplace_back(child);
+			const auto childId = recordIdCodes_[child];
+			if (noId_ != childId && !visitedIds[childId]) {
+				visitedIds[childId] = 1;
+				idsToVisit.emplace_back(childId);
+			}
+		}
+	}
+	std::sort(ret.begin(), ret.end());
+	return ret;
+}
+
+std::vector<uint32_t> GFFAnnotationIndex::getOverlapping(
+		const std::string & chrom, size_t start, size_t end) const {
+	std::vector<uint32_t> ret;
+	auto search = chroms_.find(chrom);
+	if (chroms_.end() == search || end <= start) {
+		return ret;
+	}
+	const auto & chromRecords = search->second;
+	std::vector<std::pair<uint32_t, uint32_t>> lists { { 0, chromRecords.topLevelEnd_ } };
+	while (!lists.empty()) {
+		const auto list = lists.back();
+		lists.pop_back();
+		//the ends increase along a list so skip to the first record ending after start, then take records until they start at or after end,
+		//a sublist only needs searching when the record containing it overlaps
+		uint32_t pos = std::upper_bound(chromRecords.ends_.begin() + list.first,
+				chromRecords.ends_.begin() + list.second, start) - chromRecords.ends_.begin();
+		for (; pos < list.second && chromRecords.starts_[pos] < end; ++pos) {
+			ret.emplace_back(chromRecords.recordPositions_[pos]);
+			if (chromRecords.sublistStarts_[pos] != chromRecords.sublistEnds_[pos]) {
+				lists.emplace_back(chromRecords.sublistStarts_[pos], chromRecords.sublistEnds_[pos]);
+			}
+		}
+	}
+	std::sort(ret.begin(), ret.end());
+	return ret;
+}
+
+}  // namespace njhseq
@@ -0,0 +1,124 @@
+#pragma once
+/*
+ * GFFAnnotationIndex.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: nick
+ */
+// njhseq - A library for analyzing sequence data
+// Copyright (C) 2012-2018 Nicholas Hathaway <nicholas.hathaway@umassmed.edu>,
+//
+// This file is part of njhseq.
+//
+// njhseq is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// njhseq is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with njhseq.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "njhseq/objects/BioDataObject/GFFCore.hpp"
+#include <mutex>
+
+namespace njhseq {
+
+/**@brief All the records of a GFF file parsed once and indexed by ID, by parent and by position
+ *
+ * Records are referred to by their position in the file (counting only the records, up to any ##FASTA section), the IDs named in ID, Parent and
+ * Derives_from attributes are interned so parent/child links are lists of record positions rather than string searches, and each
+ * chromosome keeps its records in a nested containment list so overlap queries only visit the records that overlap (plus a binary search
+ * per sublist), records spanning a whole chromosome like NCBI's region records don't turn queries into a scan
+ *
+ */
+class GFFAnnotationIndex {
+public:
+	/**@brief Read and index all the records in gffFnp
+	 *
+	 */
+	explicit GFFAnnotationIndex(const bfs::path & gffFnp);
+
+	/**@brief Get the index for gffFnp, built on the first call and shared after that unless the file has been written to since, safe to call from several threads
+	 *
+	 * @param gffFnp the gff file
+	 * @return the index
+	 */
+	static std::shared_ptr<const GFFAnnotationIndex> getIndex(const bfs::path & gffFnp);
+
+	const bfs::path gffFnp_;
+	const std::chrono::time_point<std::chrono::system_clock> time_; /**< last write time of gffFnp_ when read */
+
+	uint32_t numberOfRecords() const;
+	const GFFCore & getRecord(uint32_t recordPos) const;
+
+	/**@brief The records with an ID attribute of id, normally one but features like CDS can be split over several lines
+	 *
+	 */
+	const std::vector<uint32_t> & getRecordsWithId(const std::string & id) const;
+	/**@brief The records that have the ID of the record at recordPos in their Parent attribute, in file order
+	 *
+	 */
+	const std::vector<uint32_t> & getChildren(uint32_t recordPos) const;
+	/**@brief The records whose Derives_from attribute is the ID of the record at recordPos, in file order
+	 *
+	 */
+	const std::vector<uint32_t> & getDerivedFrom(uint32_t recordPos) const;
+	/**@brief The children of the record at recordPos, their children and so on, each once and in file order
+	 *
+	 */
+	std::vector<uint32_t> getDescendants(uint32_t recordPos) const;
+
+	/**@brief The records that overlap the region by at least one base, in file order
+	 *
+	 * @param chrom the chromosome
+	 * @param start the zero based start
+	 * @param end the end, not inclusive
+	 * @return the positions of the overlapping records
+	 */
+	std::vector<uint32_t> getOverlapping(const std::string & chrom, size_t start,
+			size_t end) const;
+
+private:
+	std::vector<GFFCore> records_;
+	static constexpr uint32_t noId_ = std::numeric_limits<uint32_t>::max();
+	std::vector<uint32_t> recordIdCodes_; /**< the code of each record's ID, noId_ if it doesn't have one */
+	std::unordered_map<std::string, uint32_t> idCodes_;
+	std::vector<std::vector<uint32_t>> recordsForId_; /**< by ID code */
+	std::vector<std::vector<uint32_t>> childrenForId_; /**< by ID code */
+	std::vector<std::vector<uint32_t>> derivedForId_; /**< by ID code */
+
+	/**@brief The records of a chromosome as a nested containment list, records contained in another record are in that record's sublist
+	 *
+	 * Each sublist is contiguous and no record in a sublist contains another, so both the starts and the ends increase along a sublist
+	 *
+	 */
+	struct ChromRecords {
+		std::vector<uint32_t> recordPositions_;
+		std::vector<size_t> starts_; /**< zero based */
+		std::vector<size_t> ends_;
+		std::vector<uint32_t> sublistStarts_; /**< the records contained in record i are sublistStarts_[i] up to sublistEnds_[i] */
+		std::vector<uint32_t> sublistEnds_;
+		uint32_t topLevelEnd_ = 0; /**< the top level list is 0 up to topLevelEnd_ */
+	};
+	std::unordered_map<std::string, ChromRecords> chroms_;
+
+	uint32_t internId(const std::string & id);
+	/**@brief Build the nested containment list for one chromosome
+	 *
+	 * @param positions the positions of the chromosome's records, gets sorted
+	 * @param chromRecords filled in
+	 */
+	void buildChromRecords(std::vector<uint32_t> & positions,
+			ChromRecords & chromRecords) const;
+
+	static const std::vector<uint32_t> empty_;
+	static std::mutex cacheMut_;
+	static std::unordered_map<std::string, std::shared_ptr<const GFFAnnotationIndex>> cache_;
+};
+
+}  // namespace njhseq
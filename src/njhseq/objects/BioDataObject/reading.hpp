@@ -27,6 +27,7 @@
 
 #include "njhseq/objects/BioDataObject/BedRecordCore.hpp"
 #include "njhseq/objects/BioDataObject/GFFCore.hpp"
+#include "njhseq/objects/BioDataObject/GFFAnnotationIndex.hpp"
 #include "njhseq/objects/BioDataObject/RefSeqGeneRecord.hpp"
 #include "njhseq/objects/BioDataObject/RepeatMaskerRecord.hpp"
 #include "njhseq/objects/BioDataObject/GenomicRegion.hpp"
@@ -81,60 +82,47 @@ Json::Value intersectBedLocsWtihGffRecords(
 	for (auto & inputRegion : beds) {
 		getRef(inputRegion).extraFields_.emplace_back("");
 	}
-	std::unordered_map<std::string, std::vector<uint32_t>> bedsByChrome;
-
-	BioDataFileIO<GFFCore> reader { IoOptions(InOptions(pars.gffFnp_)) };
-	reader.openIn();
-	uint32_t count = 0;
-	std::string line = "";
-	std::shared_ptr<GFFCore> gRecord = reader.readNextRecord();
-	for (const auto & bPos : iter::range(beds.size())) {
-		bedsByChrome[getRef(beds[bPos]).chrom_].emplace_back(bPos);
-	}
-	while (nullptr != gRecord) {
-		if (pars.selectFeatures_.empty() || njh::in(gRecord->type_, pars.selectFeatures_)) {
-			auto gRegion = GenomicRegion(*gRecord);
-			for (auto & inputRegionPos : bedsByChrome[gRegion.chrom_]) {
-
-				if (GenomicRegion(getRef(beds[inputRegionPos])).overlaps(gRegion)) {
-					if("" != getRef(beds[inputRegionPos]).extraFields_.back()){
-						getRef(beds[inputRegionPos]).extraFields_.back().append(",");
-					}
-					getRef(beds[inputRegionPos]).extraFields_.back().append("[");
-					getRef(beds[inputRegionPos]).extraFields_.back().append(
-							"ID=" + gRecord->getAttr("ID") + ";");
-					if(pars.selectFeatures_.empty() || 1 != pars.selectFeatures_.size()){
-						getRef(beds[inputRegionPos]).extraFields_.back().append("feature=" + gRecord->type_ + ";");
-					}
-					if (!ret.isMember(gRecord->getAttr("ID"))) {
-						ret[gRecord->getAttr("ID")] = gRecord->toJson();
-					}
-					for (const auto & attr : pars.extraAttributes_) {
-						if (gRecord->hasAttr(attr)) {
-							getRef(beds[inputRegionPos]).extraFields_.back().append(
-									attr + "=" + gRecord->getAttr(attr) + ";");
-						} else {
-							getRef(beds[inputRegionPos]).extraFields_.back().append(
-									attr + "=" + "NA" + ";");
-						}
-					}
-					getRef(beds[inputRegionPos]).extraFields_.back().append("]");
-				}
+	auto index = GFFAnnotationIndex::getIndex(pars.gffFnp_);
+	//records are added to ret in file order so the first record with an ID is the one kept
+	std::set<uint32_t> overlappedRecords;
+	for (auto & inputRegion : beds) {
+		auto & bed = getRef(inputRegion);
+		const GenomicRegion bedRegion(bed);
+		for (const auto recordPos : index->getOverlapping(bedRegion.chrom_, bedRegion.start_, bedRegion.end_)) {
+			const auto & gRecord = index->getRecord(recordPos);
+			if (!pars.selectFeatures_.empty() && !njh::in(gRecord.type_, pars.selectFeatures_)) {
+				continue;
 			}
-		}
-		bool end = false;
-		while ('#' == reader.inFile_->peek()) {
-			if (njh::files::nextLineBeginsWith(*reader.inFile_, "##FASTA")) {
-				end = true;
-				break;
+			if (!bedRegion.overlaps(GenomicRegion(gRecord))) {
+				continue;
+			}
+			overlappedRecords.emplace(recordPos);
+			if("" != bed.extraFields_.back()){
+				bed.extraFields_.back().append(",");
 			}
-			njh::files::crossPlatGetline(*reader.inFile_, line);
+			bed.extraFields_.back().append("[");
+			bed.extraFields_.back().append(
+					"ID=" + gRecord.getAttr("ID") + ";");
+			if(pars.selectFeatures_.empty() || 1 != pars.selectFeatures_.size()){
+				bed.extraFields_.back().append("feature=" + gRecord.type_ + ";");
+			}
+			for (const auto & attr : pars.extraAttributes_) {
+				if (gRecord.hasAttr(attr)) {
+					bed.extraFields_.back().append(
+							attr + "=" + gRecord.getAttr(attr) + ";");
+				} else {
+					bed.extraFields_.back().append(
+							attr + "=" + "NA" + ";");
+				}
+			}
+			bed.extraFields_.back().append("]");
 		}
-		if (end) {
-			break;
+	}
+	for (const auto recordPos : overlappedRecords) {
+		const auto & gRecord = index->getRecord(recordPos);
+		if (!ret.isMember(gRecord.getAttr("ID"))) {
+			ret[gRecord.getAttr("ID")] = gRecord.toJson();
 		}
-		gRecord = reader.readNextRecord();
-		++count;
 	}
 	return ret;
 }
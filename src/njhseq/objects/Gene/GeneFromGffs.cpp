@@ -8,6 +8,7 @@
 #include "GeneFromGffs.hpp"
 #include "njhseq/objects/BioDataObject/reading.hpp"
 #include "njhseq/objects/BioDataObject/BioDataFileIO.hpp"
+#include "njhseq/objects/BioDataObject/GFFAnnotationIndex.hpp"
 
 namespace njhseq {
 
@@ -427,74 +428,42 @@ std::unordered_map<std::string, table> GeneFromGffs::getIntronExonTables() const
 std::unordered_map<std::string, std::shared_ptr<GeneFromGffs>> GeneFromGffs::getGenesFromGffForIds(
 		const bfs::path & gffFnp,
 		const std::set<std::string> & ids){
-
-	std::unordered_map<std::string, std::set<std::string>> parents;
-	std::unordered_map<std::string, std::vector<std::shared_ptr<GFFCore>>> gffRecs;
+	auto index = GFFAnnotationIndex::getIndex(gffFnp);
 	std::unordered_map<std::string, std::shared_ptr<GeneFromGffs>> genes;
-	BioDataFileIO<GFFCore> reader{IoOptions(InOptions(gffFnp))};
-	std::vector<std::shared_ptr<GFFCore>> cache;
-	reader.openIn();
-	uint32_t count = 0;
-	std::string line = "";
 	VecStr deirvedFromRecordFeatures {"polypeptide"};
-	std::shared_ptr<GFFCore> gRecord = reader.readNextRecord();
 	VecStr allowableFeatureType {"gene", "pseudogene"};
-	while (nullptr != gRecord) {
-		if(gRecord->hasAttr("ID") && njh::in(gRecord->getAttr("ID"), ids) ){
-			if(!njh::in(gRecord->type_, allowableFeatureType)) {// "gene" != gRecord->type_){
+	for(const auto & id : ids){
+		const auto & geneRecordPositions = index->getRecordsWithId(id);
+		if(geneRecordPositions.empty()){
+			continue;
+		}
+		std::set<uint32_t> recordPositions;
+		for(const auto geneRecordPos : geneRecordPositions){
+			const auto & geneRecord = index->getRecord(geneRecordPos);
+			if(!njh::in(geneRecord.type_, allowableFeatureType)) {
 				std::stringstream ss;
-				ss << __PRETTY_FUNCTION__ << ", error feature type needs to be gene, not " << gRecord->type_ << "\n";
+				ss << __PRETTY_FUNCTION__ << ", error feature type needs to be gene, not " << geneRecord.type_ << "\n";
 				throw std::runtime_error{ss.str()};
 			}
-			auto currentId = gRecord->getAttr("ID");
-			parents[currentId].insert(gRecord->getAttr("ID"));
-			gffRecs[currentId].emplace_back(std::make_shared<GFFCore>(*gRecord));
-		}else if(gRecord->hasAttr("Parent")){
-			auto currentParents = tokenizeString(gRecord->getAttr("Parent"), ",");
-			for(const auto & currentParent : currentParents){
-				for(auto & p : parents){
-					if(njh::in(currentParent, p.second)){
-						p.second.insert(gRecord->getAttr("ID"));
-						gffRecs[p.first].emplace_back(std::make_shared<GFFCore>(*gRecord));
-					}
-				}
-			}
-		} else if(njh::in(gRecord->type_, deirvedFromRecordFeatures) ){
-			cache.emplace_back(std::make_shared<GFFCore>(*gRecord));
+			recordPositions.emplace(geneRecordPos);
+			auto descendants = index->getDescendants(geneRecordPos);
+			recordPositions.insert(descendants.begin(), descendants.end());
 		}
-		if("gene" == gRecord->type_){
-			for(const auto & fromCache : cache){
-				//grab any possible polypeptides or misc records,
-				//I have found that sometimes these come before the gene record so you have to keep a cache around since the last cache
-				//there might be a better way of doing this
-				if(fromCache->hasAttr("Derives_from")){
-					auto currentParent = fromCache->getAttr("Derives_from");
-					for(auto & p : parents){
-						if(njh::in(currentParent, p.second)){
-							gffRecs[p.first].emplace_back(std::make_shared<GFFCore>(*fromCache));
-						}
-					}
+		//grab any polypeptides that aren't linked by Parent but derive from the gene or one of its features
+		std::vector<uint32_t> derivedFromPositions(recordPositions.begin(), recordPositions.end());
+		for(const auto recordPos : derivedFromPositions){
+			for(const auto derivedPos : index->getDerivedFrom(recordPos)){
+				const auto & derived = index->getRecord(derivedPos);
+				if(!derived.hasAttr("Parent") && njh::in(derived.type_, deirvedFromRecordFeatures)){
+					recordPositions.emplace(derivedPos);
 				}
 			}
-			cache.clear();
-		}
-		bool end = false;
-		while ('#' == reader.inFile_->peek()) {
-			if (njh::files::nextLineBeginsWith(*reader.inFile_, "##FASTA")) {
-				end = true;
-				break;
-			}
-			njh::files::crossPlatGetline(*reader.inFile_, line);
 		}
-		if (end) {
-			break;
+		std::vector<std::shared_ptr<GFFCore>> gffRecs;
+		for(const auto recordPos : recordPositions){
+			gffRecs.emplace_back(std::make_shared<GFFCore>(index->getRecord(recordPos)));
 		}
-		gRecord = reader.readNextRecord();
-		++count;
-	}
-
-	for(const auto & geneGffs : gffRecs){
-		genes[geneGffs.first] = std::make_shared<GeneFromGffs>(geneGffs.second);
+		genes[id] = std::make_shared<GeneFromGffs>(gffRecs);
 	}
 	return genes;
 }
@@ -76,6 +76,7 @@ void GeneSeqInfo::setTable(){
 					len(protein_.seq_) > pos / 3 ? std::string(1, protein_.seq_[pos / 3]) : "NA");
 		}
 	}
+	posIndex_ = std::make_shared<const GenePosIndex>(*this);
 }
 
 Bed6RecordCore GeneSeqInfo::genBedFromAAPositions(uint32_t aaStart,
@@ -186,7 +187,7 @@ GeneSeqInfo::GenePosInfo rowToGenePosInfo(const table & infoTab, const VecStr &
 	info.codonPos_ = njh::StrToNumConverter::stoToNum<uint32_t>(row[infoTab.getColPos("codonPos")]);
 
 	info.base_ = row[infoTab.getColPos("base")].front();
-	info.base_ = row[infoTab.getColPos("aminoAcid")].front();
+	info.aa_ = row[infoTab.getColPos("aminoAcid")].front();
 	return info;
 }
 
@@ -254,6 +255,88 @@ std::unordered_map<uint32_t, std::tuple<GeneSeqInfo::GenePosInfo,GeneSeqInfo::Ge
 }
 
 
+GeneSeqInfo::GenePosIndex::GenePosIndex(const GeneSeqInfo & info) :
+		posOffset_(info.pars_.oneBasedPos_ ? 1 : 0) {
+	if (0 == info.infoTab_.nRow()) {
+		std::stringstream ss;
+		ss << __PRETTY_FUNCTION__ << ", error  infoTable not set yet" << "\n";
+		throw std::runtime_error { ss.str() };
+	}
+	infos_.resize(info.infoTab_.nRow());
+	uint32_t gDnaStop = 0;
+	gDnaStart_ = std::numeric_limits<uint32_t>::max();
+	for (const auto & row : info.infoTab_.content_) {
+		auto posInfo = rowToGenePosInfo(info.infoTab_, row);
+		if (posInfo.cDNAPos_ - posOffset_ >= infos_.size()) {
+			std::stringstream ss;
+			ss << __PRETTY_FUNCTION__ << ", error cDNA position " << posInfo.cDNAPos_
+					<< " is out of range for a cDNA of length " << infos_.size() << "\n";
+			throw std::runtime_error { ss.str() };
+		}
+		gDnaStart_ = std::min(gDnaStart_, posInfo.gDNAPos_);
+		gDnaStop = std::max(gDnaStop, posInfo.gDNAPos_ + 1);
+		infos_[posInfo.cDNAPos_ - posOffset_] = posInfo;
+	}
+	cDnaForGDna_.assign(gDnaStop - gDnaStart_, std::numeric_limits<uint32_t>::max());
+	for (const auto pos : iter::range<uint32_t>(infos_.size())) {
+		cDnaForGDna_[infos_[pos].gDNAPos_ - gDnaStart_] = pos;
+	}
+}
+
+bool GeneSeqInfo::GenePosIndex::hasGDnaPos(uint32_t gDnaPos) const {
+	return gDnaPos >= gDnaStart_ && gDnaPos - gDnaStart_ < cDnaForGDna_.size()
+			&& std::numeric_limits<uint32_t>::max() != cDnaForGDna_[gDnaPos - gDnaStart_];
+}
+
+const GeneSeqInfo::GenePosInfo & GeneSeqInfo::GenePosIndex::atGDnaPos(
+		uint32_t gDnaPos) const {
+	if (!hasGDnaPos(gDnaPos)) {
+		std::stringstream ss;
+		ss << __PRETTY_FUNCTION__ << ", error gDNA position " << gDnaPos
+				<< " is not part of the cDNA" << "\n";
+		throw std::out_of_range { ss.str() };
+	}
+	return infos_[cDnaForGDna_[gDnaPos - gDnaStart_]];
+}
+
+const GeneSeqInfo::GenePosInfo & GeneSeqInfo::GenePosIndex::atCDnaPos(
+		uint32_t cDnaPos) const {
+	if (cDnaPos < posOffset_ || cDnaPos - posOffset_ >= infos_.size()) {
+		std::stringstream ss;
+		ss << __PRETTY_FUNCTION__ << ", error cDNA position " << cDnaPos
+				<< " is out of range for a cDNA of length " << infos_.size() << "\n";
+		throw std::out_of_range { ss.str() };
+	}
+	return infos_[cDnaPos - posOffset_];
+}
+
+std::tuple<GeneSeqInfo::GenePosInfo, GeneSeqInfo::GenePosInfo,
+		GeneSeqInfo::GenePosInfo> GeneSeqInfo::GenePosIndex::atAAPos(
+		uint32_t aaPos) const {
+	if (aaPos < posOffset_ || (aaPos - posOffset_) * 3 + 2 >= infos_.size()) {
+		std::stringstream ss;
+		ss << __PRETTY_FUNCTION__ << ", error amino acid position " << aaPos
+				<< " doesn't have a full codon in a cDNA of length " << infos_.size()
+				<< "\n";
+		throw std::out_of_range { ss.str() };
+	}
+	const uint32_t codonStart = (aaPos - posOffset_) * 3;
+	return std::make_tuple(infos_[codonStart], infos_[codonStart + 1],
+			infos_[codonStart + 2]);
+}
+
+uint32_t GeneSeqInfo::GenePosIndex::numberOfCDnaPositions() const {
+	return infos_.size();
+}
+
+const GeneSeqInfo::GenePosIndex & GeneSeqInfo::getPosIndex() const {
+	if (nullptr == posIndex_) {
+		std::stringstream ss;
+		ss << __PRETTY_FUNCTION__ << ", error  infoTable not set yet" << "\n";
+		throw std::runtime_error { ss.str() };
+	}
+	return *posIndex_;
+}
 
 }  // namespace njhseq
 
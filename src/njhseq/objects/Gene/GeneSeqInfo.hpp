@@ -57,6 +57,42 @@ public:
 	std::unordered_map<uint32_t, GenePosInfo> getInfosByCDNAPos() const;
 	std::unordered_map<uint32_t, std::tuple<GenePosInfo,GenePosInfo,GenePosInfo>> getInfosByAAPos() const;
 
+	/**@brief The same infos as infoTab_ held in arrays so a gDNA, cDNA or amino acid position is an index rather than a table parse and hash lookup
+	 *
+	 * Positions given and returned are as in infoTab_ (so one based if pars_.oneBasedPos_ was set), built by setTable() and not changed afterwards so
+	 * can be shared read only between threads
+	 */
+	class GenePosIndex {
+	public:
+		explicit GenePosIndex(const GeneSeqInfo & info);
+
+		bool hasGDnaPos(uint32_t gDnaPos) const;
+		/**@brief throws std::out_of_range if gDnaPos isn't part of the cDNA
+		 *
+		 */
+		const GenePosInfo & atGDnaPos(uint32_t gDnaPos) const;
+		const GenePosInfo & atCDnaPos(uint32_t cDnaPos) const;
+		/**@brief The infos of the three bases of the codon of aaPos, throws std::out_of_range if aaPos doesn't have a full codon
+		 *
+		 */
+		std::tuple<GenePosInfo,GenePosInfo,GenePosInfo> atAAPos(uint32_t aaPos) const;
+
+		uint32_t numberOfCDnaPositions() const;
+
+	private:
+		uint32_t posOffset_ { 0 };
+		uint32_t gDnaStart_ { 0 }; /**< the smallest gDNA position, cDnaForGDna_ starts at it */
+		std::vector<uint32_t> cDnaForGDna_; /**< the position in infos_ for each gDNA position, std::numeric_limits<uint32_t>::max() for positions not in the cDNA */
+		std::vector<GenePosInfo> infos_; /**< by cDNA position */
+	};
+
+	/**@brief The dense position lookups, throws if setTable() hasn't been called
+	 *
+	 */
+	const GenePosIndex & getPosIndex() const;
+
+private:
+	std::shared_ptr<const GenePosIndex> posIndex_;
 
 };
 
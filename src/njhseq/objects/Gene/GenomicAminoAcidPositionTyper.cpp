@@ -86,17 +86,78 @@ std::map<uint32_t, char> GenomicAminoAcidPositionTyper::typeAlignment(
 		TwoBit::TwoBitFile & tReader,
 		aligner & alignerObj,
 		const BamTools::RefVector & refData) {
+	std::map<uint32_t, char> aminoTyping;
+	auto aminos = typeAlignmentPositions(bAln, currentGene, currentGeneInfo,
+			tReader, alignerObj, refData);
+	if (!aminos.empty()) {
+		const auto & positions = aminoPositionsForTyping_.at(currentGene.gene_->getIDAttr());
+		for (const auto pos : iter::range(positions.size())) {
+			aminoTyping[positions[pos]] = aminos[pos];
+		}
+	}
+	return aminoTyping;
+}
+
+std::vector<std::vector<char>> GenomicAminoAcidPositionTyper::typeAlignments(
+		const std::vector<BamTools::BamAlignment> & bAlns,
+		const VecStr & geneIds,
+		const std::unordered_map<std::string, std::shared_ptr<GeneFromGffs>> & genes,
+		const std::unordered_map<std::string, std::shared_ptr<GeneSeqInfo>> & geneInfos,
+		const bfs::path & twoBitFnp,
+		concurrent::AlignerPool & alnPool,
+		const BamTools::RefVector & refData,
+		uint32_t numThreads) const {
+	if (bAlns.size() != geneIds.size()) {
+		std::stringstream ss;
+		ss << __PRETTY_FUNCTION__ << ", error " << "bAlns size, " << bAlns.size()
+				<< ", doesn't match geneIds size, " << geneIds.size() << "\n";
+		throw std::runtime_error { ss.str() };
+	}
+	std::vector<std::vector<char>> ret(bAlns.size());
+	std::vector<uint32_t> positions(bAlns.size());
+	njh::iota<uint32_t>(positions, 0);
+	njh::concurrent::LockableQueue<uint32_t> posQueue(positions);
+	auto typeFunc = [this, &bAlns, &geneIds, &genes, &geneInfos, &twoBitFnp,
+									 &alnPool, &refData, &ret, &posQueue]() {
+		auto alignerObj = alnPool.popAligner();
+		TwoBit::TwoBitFile tReader(twoBitFnp);
+		uint32_t pos = 0;
+		while (posQueue.getVal(pos)) {
+			//each position is only ever set by one thread so no lock is needed
+			ret[pos] = typeAlignmentPositions(bAlns[pos], *genes.at(geneIds[pos]),
+					*geneInfos.at(geneIds[pos]), tReader, *alignerObj, refData);
+		}
+	};
+	uint32_t threadsToUse = std::max<uint32_t>(1, numThreads);
+	if (1 == threadsToUse) {
+		typeFunc();
+	} else {
+		std::vector<std::thread> threads;
+		for (uint32_t t = 0; t < threadsToUse; ++t) {
+			threads.emplace_back(typeFunc);
+		}
+		njh::concurrent::joinAllJoinableThreads(threads);
+	}
+	return ret;
+}
+
+std::vector<char> GenomicAminoAcidPositionTyper::typeAlignmentPositions(
+		const BamTools::BamAlignment & bAln,
+		const GeneFromGffs & currentGene,
+		const GeneSeqInfo & currentGeneInfo,
+		TwoBit::TwoBitFile & tReader,
+		aligner & alignerObj,
+		const BamTools::RefVector & refData) const {
 
 	auto results = std::make_shared<AlignmentResults>(bAln, refData, true);
-	std::map<uint32_t, char> aminoTyping;
+	std::vector<char> aminoTyping;
 
 	results->setRefSeq(tReader);
 	results->setComparison(true);
 
 	bool endsAtStopCodon = false;
 	uint32_t transStart = 0;
-	std::unordered_map<size_t, alnInfoLocal> balnAlnInfo = bamAlnToAlnInfoLocal(bAln);
-	auto genePosInfoByGDna = currentGeneInfo.getInfosByGDNAPos();
+	const auto & genePosIndex = currentGeneInfo.getPosIndex();
 	const auto & transcript = currentGene.mRNAs_.front();
 	seqInfo balnSeq(bAln.Name);
 	std::vector<GFFCore> cDNAIntersectedWith;
@@ -110,27 +171,27 @@ std::map<uint32_t, char> GenomicAminoAcidPositionTyper::typeAlignment(
 			&& results->gRegion_.end_ <= cDNAIntersectedWith.front().end_) {
 		balnSeq = *(results->alnSeq_);
 		if (currentGene.gene_->isReverseStrand()) {
-			if (genePosInfoByGDna.at(results->gRegion_.start_).cDNAPos_
+			if (genePosIndex.atGDnaPos(results->gRegion_.start_).cDNAPos_
 					== currentGeneInfo.cDna_.seq_.size() - 1) {
 				endsAtStopCodon = true;
 			}
 			uint32_t gPos = results->gRegion_.end_ - 1;
-			auto codon = genePosInfoByGDna.at(gPos).codonPos_;
+			auto codon = genePosIndex.atGDnaPos(gPos).codonPos_;
 			while (0 != codon) {
 				--gPos;
-				codon = genePosInfoByGDna.at(gPos).codonPos_;
+				codon = genePosIndex.atGDnaPos(gPos).codonPos_;
 				++transStart;
 			}
 		} else {
-			if (genePosInfoByGDna.at(results->gRegion_.end_ - 1).cDNAPos_
+			if (genePosIndex.atGDnaPos(results->gRegion_.end_ - 1).cDNAPos_
 					== currentGeneInfo.cDna_.seq_.size() - 1) {
 				endsAtStopCodon = true;
 			}
 			uint32_t gPos = results->gRegion_.start_;
-			uint32_t codon = genePosInfoByGDna.at(gPos).codonPos_;
+			uint32_t codon = genePosIndex.atGDnaPos(gPos).codonPos_;
 			while (0 != codon) {
 				++gPos;
-				codon = genePosInfoByGDna.at(gPos).codonPos_;
+				codon = genePosIndex.atGDnaPos(gPos).codonPos_;
 				++transStart;
 			}
 		}
@@ -146,19 +207,19 @@ std::map<uint32_t, char> GenomicAminoAcidPositionTyper::typeAlignment(
 		if (currentGene.gene_->isReverseStrand()) {
 			auto cDnaStop = cDNAIntersectedWith.back().end_;
 			uint32_t gPos = std::min(cDnaStop, results->gRegion_.end_) - 1;
-			auto codon = genePosInfoByGDna.at(gPos).codonPos_;
+			auto codon = genePosIndex.atGDnaPos(gPos).codonPos_;
 			while (0 != codon) {
 				--gPos;
-				codon = genePosInfoByGDna.at(gPos).codonPos_;
+				codon = genePosIndex.atGDnaPos(gPos).codonPos_;
 				++transStart;
 			}
 		} else {
 			auto cDnaStart = cDNAIntersectedWith.front().start_ - 1;
 			uint32_t gPos = std::max(cDnaStart, results->gRegion_.start_);
-			uint32_t codon = genePosInfoByGDna.at(gPos).codonPos_;
+			uint32_t codon = genePosIndex.atGDnaPos(gPos).codonPos_;
 			while (0 != codon) {
 				++gPos;
-				codon = genePosInfoByGDna.at(gPos).codonPos_;
+				codon = genePosIndex.atGDnaPos(gPos).codonPos_;
 				++transStart;
 			}
 		}
@@ -183,12 +244,12 @@ std::map<uint32_t, char> GenomicAminoAcidPositionTyper::typeAlignment(
 		uint32_t cDnaStart = *std::min_element(starts.begin(), starts.end());
 		uint32_t cDnaStop = *std::max_element(ends.begin(), ends.end());
 		if (currentGene.gene_->isReverseStrand()) {
-			if (genePosInfoByGDna.at(cDnaStart).cDNAPos_
+			if (genePosIndex.atGDnaPos(cDnaStart).cDNAPos_
 					== currentGeneInfo.cDna_.seq_.size() - 1) {
 				endsAtStopCodon = true;
 			}
 		} else {
-			if (genePosInfoByGDna.at(cDnaStop - 1).cDNAPos_
+			if (genePosIndex.atGDnaPos(cDnaStop - 1).cDNAPos_
 					== currentGeneInfo.cDna_.seq_.size() - 1) {
 				endsAtStopCodon = true;
 			}
@@ -212,13 +273,15 @@ std::map<uint32_t, char> GenomicAminoAcidPositionTyper::typeAlignment(
 				alignerObj.alignObjectA_.seqBase_.seq_, proteinAlnStart);
 		uint32_t proteinStop = getRealPosForAlnPos(
 				alignerObj.alignObjectA_.seqBase_.seq_, proteinAlnStop);
-		for (const auto & pos : aminoPositionsForTyping_.at(currentGene.gene_->getIDAttr())) {
+		const auto & positions = aminoPositionsForTyping_.at(currentGene.gene_->getIDAttr());
+		aminoTyping.reserve(positions.size());
+		for (const auto & pos : positions) {
 			if (pos < proteinStart || pos > proteinStop) {
-				aminoTyping[pos] = ' ';
+				aminoTyping.emplace_back(' ');
 			} else {
 				auto posAln = getAlnPosForRealPos(
 						alignerObj.alignObjectA_.seqBase_.seq_, pos);
-				aminoTyping[pos] = alignerObj.alignObjectB_.seqBase_.seq_[posAln];
+				aminoTyping.emplace_back(alignerObj.alignObjectB_.seqBase_.seq_[posAln]);
 			}
 		}
 	}
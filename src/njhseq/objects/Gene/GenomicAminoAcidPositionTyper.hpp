@@ -10,6 +10,7 @@
 
 #include "njhseq/objects/Gene/GeneSeqInfo.hpp"
 #include "njhseq/objects/Gene/GeneFromGffs.hpp"
+#include "njhseq/concurrency/pools/AlignerPool.hpp"
 
 
 
@@ -67,6 +68,40 @@ public:
 			TwoBit::TwoBitFile & tReader,
 			aligner & alignerObj,
 			const BamTools::RefVector & refData);
+
+	/**@brief Type the amino acids for the alignment without building a map, only reads the typer so can be called from several threads
+	 *
+	 * @return the amino acid for each position in aminoPositionsForTyping_ for the gene (in the same order), ' ' for positions the alignment doesn't cover, empty if the gene isn't being typed
+	 */
+	std::vector<char> typeAlignmentPositions(
+			const BamTools::BamAlignment & bAln,
+			const GeneFromGffs & currentGene,
+			const GeneSeqInfo & currentGeneInfo,
+			TwoBit::TwoBitFile & tReader,
+			aligner & alignerObj,
+			const BamTools::RefVector & refData) const;
+
+	/**@brief Type many alignments with multiple threads
+	 *
+	 * @param bAlns the alignments to type
+	 * @param geneIds the gene each alignment intersects, same size as bAlns
+	 * @param genes the genes by gene ID
+	 * @param geneInfos the base information for each gene by gene ID, should have had their tables set
+	 * @param twoBitFnp the genome the alignments are to, each thread opens its own reader
+	 * @param alnPool the pool to get the per thread aligners from, should already be initialized
+	 * @param refData the chromosome index to chrom name from bam reader
+	 * @param numThreads the number of threads to use
+	 * @return the typing of each alignment in the order of bAlns, see typeAlignmentPositions
+	 */
+	std::vector<std::vector<char>> typeAlignments(
+			const std::vector<BamTools::BamAlignment> & bAlns,
+			const VecStr & geneIds,
+			const std::unordered_map<std::string, std::shared_ptr<GeneFromGffs>> & genes,
+			const std::unordered_map<std::string, std::shared_ptr<GeneSeqInfo>> & geneInfos,
+			const bfs::path & twoBitFnp,
+			concurrent::AlignerPool & alnPool,
+			const BamTools::RefVector & refData,
+			uint32_t numThreads) const;
 };
 
 
@@ -114,7 +114,7 @@ std::unordered_map<std::string, TranslatorByAlignment::TranslateSeqRes> Translat
 	std::unordered_map<std::string, TranslateSeqRes> ret;
 	for(const auto & transcript : currentGene.mRNAs_){
 		auto currentTranscriptInfo = transcriptInfosForGene.at(transcript->getIDAttr());
-		auto genePosInfoByGDna = currentTranscriptInfo->getInfosByGDNAPos();
+		const auto & genePosIndex = currentTranscriptInfo->getPosIndex();
 		bool endsAtStopCodon = false;
 		uint32_t transStart = 0;
 		seqInfo balnSeq(realigned.querySeq_.name_);
@@ -133,27 +133,27 @@ std::unordered_map<std::string, TranslatorByAlignment::TranslateSeqRes> Translat
 					&& realigned.gRegion_.end_ <= cDNAIntersectedWith.front().end_) {
 				balnSeq = realigned.querySeq_;
 				if (currentGene.gene_->isReverseStrand()) {
-					if (genePosInfoByGDna.at(realigned.gRegion_.start_).cDNAPos_
+					if (genePosIndex.atGDnaPos(realigned.gRegion_.start_).cDNAPos_
 							== currentTranscriptInfo->cDna_.seq_.size() - 1) {
 						endsAtStopCodon = true;
 					}
 					uint32_t gPos = realigned.gRegion_.end_ - 1;
-					auto codon = genePosInfoByGDna.at(gPos).codonPos_;
+					auto codon = genePosIndex.atGDnaPos(gPos).codonPos_;
 					while (0 != codon) {
 						--gPos;
-						codon = genePosInfoByGDna.at(gPos).codonPos_;
+						codon = genePosIndex.atGDnaPos(gPos).codonPos_;
 						++transStart;
 					}
 				} else {
-					if (genePosInfoByGDna.at(realigned.gRegion_.end_ - 1).cDNAPos_
+					if (genePosIndex.atGDnaPos(realigned.gRegion_.end_ - 1).cDNAPos_
 							== currentTranscriptInfo->cDna_.seq_.size() - 1) {
 						endsAtStopCodon = true;
 					}
 					uint32_t gPos = realigned.gRegion_.start_;
-					uint32_t codon = genePosInfoByGDna.at(gPos).codonPos_;
+					uint32_t codon = genePosIndex.atGDnaPos(gPos).codonPos_;
 					while (0 != codon) {
 						++gPos;
-						codon = genePosInfoByGDna.at(gPos).codonPos_;
+						codon = genePosIndex.atGDnaPos(gPos).codonPos_;
 						++transStart;
 					}
 				}
@@ -168,19 +168,19 @@ std::unordered_map<std::string, TranslatorByAlignment::TranslateSeqRes> Translat
 				if (currentGene.gene_->isReverseStrand()) {
 					auto cDnaStop = cDNAIntersectedWith.back().end_;
 					uint32_t gPos = std::min(cDnaStop, realigned.gRegion_.end_) - 1;
-					auto codon = genePosInfoByGDna.at(gPos).codonPos_;
+					auto codon = genePosIndex.atGDnaPos(gPos).codonPos_;
 					while (0 != codon) {
 						--gPos;
-						codon = genePosInfoByGDna.at(gPos).codonPos_;
+						codon = genePosIndex.atGDnaPos(gPos).codonPos_;
 						++transStart;
 					}
 				} else {
 					auto cDnaStart = cDNAIntersectedWith.front().start_ - 1;
 					uint32_t gPos = std::max(cDnaStart, realigned.gRegion_.start_);
-					uint32_t codon = genePosInfoByGDna.at(gPos).codonPos_;
+					uint32_t codon = genePosIndex.atGDnaPos(gPos).codonPos_;
 					while (0 != codon) {
 						++gPos;
-						codon = njh::mapAt(genePosInfoByGDna, gPos).codonPos_;
+						codon = genePosIndex.atGDnaPos(gPos).codonPos_;
 						++transStart;
 					}
 				}
@@ -203,12 +203,12 @@ std::unordered_map<std::string, TranslatorByAlignment::TranslateSeqRes> Translat
 				uint32_t cDnaStart = *std::min_element(starts.begin(), starts.end());
 				uint32_t cDnaStop = *std::max_element(ends.begin(), ends.end());
 				if (currentGene.gene_->isReverseStrand()) {
-					if (genePosInfoByGDna.at(cDnaStart).cDNAPos_
+					if (genePosIndex.atGDnaPos(cDnaStart).cDNAPos_
 							== currentTranscriptInfo->cDna_.seq_.size() - 1) {
 						endsAtStopCodon = true;
 					}
 				} else {
-					if (genePosInfoByGDna.at(cDnaStop - 1).cDNAPos_
+					if (genePosIndex.atGDnaPos(cDnaStop - 1).cDNAPos_
 							== currentTranscriptInfo->cDna_.seq_.size() - 1) {
 						endsAtStopCodon = true;
 					}
@@ -232,9 +232,8 @@ std::unordered_map<std::string, TranslatorByAlignment::TranslateSeqRes> Translat
 			uint32_t firstAmino = getRealPosForAlnPos(alignerObj.alignObjectA_.seqBase_.seq_, alignerObj.alignObjectB_.seqBase_.seq_.find_first_not_of("-"));
 			uint32_t lastAmino = getRealPosForAlnPos(alignerObj.alignObjectA_.seqBase_.seq_, alignerObj.alignObjectB_.seqBase_.seq_.find_last_not_of("-"));
 			lastAmino = std::min<uint32_t>(lastAmino,len(currentTranscriptInfo->protein_) - 1);
-			auto aminoInfos = currentTranscriptInfo->getInfosByAAPos();
-			tRes.firstAminoInfo_ = njh::mapAt(aminoInfos, firstAmino);
-			tRes.lastAminoInfo_ = njh::mapAt(aminoInfos, lastAmino);
+			tRes.firstAminoInfo_ = genePosIndex.atAAPos(firstAmino);
+			tRes.lastAminoInfo_ = genePosIndex.atAAPos(lastAmino);
 			tRes.cDna_ = balnSeq.getSubRead(transStart, cDnaLen);
 			tRes.transcriptName_ = transcript->getIDAttr();
 			tRes.translation_ = balnSeqTrans;
@@ -266,7 +265,7 @@ std::unordered_map<std::string, TranslatorByAlignment::TranslateSeqRes> Translat
 
 	for(const auto & transcript : currentGene.mRNAs_){
 		auto currentTranscriptInfo = transcriptInfosForGene.at(transcript->getIDAttr());
-		auto genePosInfoByGDna = currentTranscriptInfo->getInfosByGDNAPos();
+		const auto & genePosIndex = currentTranscriptInfo->getPosIndex();
 		bool endsAtStopCodon = false;
 		uint32_t transStart = 0;
 		seqInfo balnSeq(bAln.Name);
@@ -285,27 +284,27 @@ std::unordered_map<std::string, TranslatorByAlignment::TranslateSeqRes> Translat
 					&& results->gRegion_.end_ <= cDNAIntersectedWith.front().end_) {
 				balnSeq = *(results->alnSeq_);
 				if (currentGene.gene_->isReverseStrand()) {
-					if (genePosInfoByGDna.at(results->gRegion_.start_).cDNAPos_
+					if (genePosIndex.atGDnaPos(results->gRegion_.start_).cDNAPos_
 							== currentTranscriptInfo->cDna_.seq_.size() - 1) {
 						endsAtStopCodon = true;
 					}
 					uint32_t gPos = results->gRegion_.end_ - 1;
-					auto codon = genePosInfoByGDna.at(gPos).codonPos_;
+					auto codon = genePosIndex.atGDnaPos(gPos).codonPos_;
 					while (0 != codon) {
 						--gPos;
-						codon = genePosInfoByGDna.at(gPos).codonPos_;
+						codon = genePosIndex.atGDnaPos(gPos).codonPos_;
 						++transStart;
 					}
 				} else {
-					if (genePosInfoByGDna.at(results->gRegion_.end_ - 1).cDNAPos_
+					if (genePosIndex.atGDnaPos(results->gRegion_.end_ - 1).cDNAPos_
 							== currentTranscriptInfo->cDna_.seq_.size() - 1) {
 						endsAtStopCodon = true;
 					}
 					uint32_t gPos = results->gRegion_.start_;
-					uint32_t codon = genePosInfoByGDna.at(gPos).codonPos_;
+					uint32_t codon = genePosIndex.atGDnaPos(gPos).codonPos_;
 					while (0 != codon) {
 						++gPos;
-						codon = genePosInfoByGDna.at(gPos).codonPos_;
+						codon = genePosIndex.atGDnaPos(gPos).codonPos_;
 						++transStart;
 					}
 				}
@@ -321,19 +320,19 @@ std::unordered_map<std::string, TranslatorByAlignment::TranslateSeqRes> Translat
 				if (currentGene.gene_->isReverseStrand()) {
 					auto cDnaStop = cDNAIntersectedWith.back().end_;
 					uint32_t gPos = std::min(cDnaStop, results->gRegion_.end_) - 1;
-					auto codon = genePosInfoByGDna.at(gPos).codonPos_;
+					auto codon = genePosIndex.atGDnaPos(gPos).codonPos_;
 					while (0 != codon) {
 						--gPos;
-						codon = genePosInfoByGDna.at(gPos).codonPos_;
+						codon = genePosIndex.atGDnaPos(gPos).codonPos_;
 						++transStart;
 					}
 				} else {
 					auto cDnaStart = cDNAIntersectedWith.front().start_ - 1;
 					uint32_t gPos = std::max(cDnaStart, results->gRegion_.start_);
-					uint32_t codon = genePosInfoByGDna.at(gPos).codonPos_;
+					uint32_t codon = genePosIndex.atGDnaPos(gPos).codonPos_;
 					while (0 != codon) {
 						++gPos;
-						codon = genePosInfoByGDna.at(gPos).codonPos_;
+						codon = genePosIndex.atGDnaPos(gPos).codonPos_;
 						++transStart;
 					}
 				}
@@ -358,12 +357,12 @@ std::unordered_map<std::string, TranslatorByAlignment::TranslateSeqRes> Translat
 				uint32_t cDnaStart = *std::min_element(starts.begin(), starts.end());
 				uint32_t cDnaStop = *std::max_element(ends.begin(), ends.end());
 				if (currentGene.gene_->isReverseStrand()) {
-					if (genePosInfoByGDna.at(cDnaStart).cDNAPos_
+					if (genePosIndex.atGDnaPos(cDnaStart).cDNAPos_
 							== currentTranscriptInfo->cDna_.seq_.size() - 1) {
 						endsAtStopCodon = true;
 					}
 				} else {
-					if (genePosInfoByGDna.at(cDnaStop - 1).cDNAPos_
+					if (genePosIndex.atGDnaPos(cDnaStop - 1).cDNAPos_
 							== currentTranscriptInfo->cDna_.seq_.size() - 1) {
 						endsAtStopCodon = true;
 					}
@@ -391,9 +390,8 @@ std::unordered_map<std::string, TranslatorByAlignment::TranslateSeqRes> Translat
 			uint32_t lastAmino = getRealPosForAlnPos(alignerObj.alignObjectA_.seqBase_.seq_, alignerObj.alignObjectA_.seqBase_.seq_.find_last_not_of("-"));
 			lastAmino = std::min<uint32_t>(lastAmino,len(currentTranscriptInfo->protein_) - 1);
 
-			auto aminoInfos = currentTranscriptInfo->getInfosByAAPos();
-			tRes.firstAminoInfo_ = njh::mapAt(aminoInfos, firstAmino);
-			tRes.lastAminoInfo_ = njh::mapAt(aminoInfos, lastAmino);
+			tRes.firstAminoInfo_ = genePosIndex.atAAPos(firstAmino);
+			tRes.lastAminoInfo_ = genePosIndex.atAAPos(lastAmino);
 			tRes.cDna_ = balnSeq.getSubRead(transStart, cDnaLen);
 			tRes.transcriptName_ = transcript->getIDAttr();
 			tRes.translation_ = balnSeqTrans;
@@ -409,6 +407,9 @@ std::unordered_map<std::string, TranslatorByAlignment::TranslateSeqRes> Translat
 
 
 TranslatorByAlignment::TranslatorByAlignment(const TranslatorByAlignmentPars & pars): pars_(pars){
+	if(pars_.useBuiltInMapper_){
+		return;
+	}
 	njh::sys::requireExternalProgramThrow("samtools");
 	if(!pars_.useLastz_){
 		njh::sys::requireExternalProgramThrow("bowtie2");
@@ -433,20 +434,29 @@ TranslatorByAlignment::TranslatorByAlignmentResult TranslatorByAlignment::run(co
 	uint64_t seqMaxLen = 0;
 
 	VecStr names;
+	//only kept when mapping in memory
+	std::vector<seqInfo> inputSeqs;
 	{
 		//write out fasta file of input
 		seqInfo seq;
 		SeqInput reader(seqOpts);
 		reader.openIn();
-		SeqOutput writer(SeqIOOptions::genFastaOut(seqInputFnp));
-		writer.openOut();
+		std::unique_ptr<SeqOutput> writer;
+		if(!pars_.useBuiltInMapper_){
+			writer = std::make_unique<SeqOutput>(SeqIOOptions::genFastaOut(seqInputFnp));
+			writer->openOut();
+		}
 		uint32_t pos = 0;
 		while(reader.readNextRead(seq)){
 			readVec::getMaxLength(seq, seqMaxLen);
 			names.emplace_back(seq.name_);
 			seq.name_ = estd::to_string(pos);
 			++pos;
-			writer.write(seq);
+			if(pars_.useBuiltInMapper_){
+				inputSeqs.emplace_back(seq);
+			}else{
+				writer->write(seq);
+			}
 		}
 	}
 
@@ -456,7 +466,7 @@ TranslatorByAlignment::TranslatorByAlignmentResult TranslatorByAlignment::run(co
 
 	BioCmdsUtils bRunner(false);
 	bRunner.RunFaToTwoBit(pars_.lzPars_.genomeFnp);
-	if(!pars_.useLastz_){
+	if(!pars_.useLastz_ && !pars_.useBuiltInMapper_){
 		bRunner.RunBowtie2Index(pars_.lzPars_.genomeFnp);
 	}
 
@@ -465,24 +475,49 @@ TranslatorByAlignment::TranslatorByAlignmentResult TranslatorByAlignment::run(co
 
 	TwoBit::TwoBitFile tReader(twoBitFnp);
 
-	auto uniqueSeqInOpts = SeqIOOptions::genFastaIn(seqInputFnp);
-	uniqueSeqInOpts.out_.outFilename_ = njh::files::make_path(pars_.workingDirtory_, "aligned_inputSeqs.sorted.bam");
-	uniqueSeqInOpts.out_.outExtention_ = ".sorted.bam";
-	fnpsToRemove.emplace_back(uniqueSeqInOpts.out_.outFilename_);
-	fnpsToRemove.emplace_back(uniqueSeqInOpts.out_.outFilename_.string() + ".bai");
-
-	uniqueSeqInOpts.out_.transferOverwriteOpts(seqOpts.out_);
-	if(!pars_.useLastz_){
-		auto bowtieRunOut = bRunner.bowtie2Align(uniqueSeqInOpts, pars_.lzPars_.genomeFnp, pars_.additionalBowtieArguments_);
-
-		//auto bowtieRunOut = bRunner.bowtie2Align(uniqueSeqInOpts, pars_.lzPars_.genomeFnp, "-D 20 -R 3 -N 1 -L 15 -i S,1,0.5 --end-to-end");
-		BioCmdsUtils::checkRunOutThrow(bowtieRunOut, __PRETTY_FUNCTION__);
+	//mapped alignments, either from the bam file written by bowtie2/lastz or straight from the built in mapper
+	std::vector<BamTools::BamAlignment> bAlns;
+	BamTools::RefVector refData;
+	if(pars_.useBuiltInMapper_){
+		SeedExtendMapper mapper(bfs::path(twoBitFnp), pars_.mapperPars_);
+		aligner mapperAligner(seqMaxLen + 2 * pars_.mapperPars_.extendPadding_, gapScoringParameters(5,1,0,0,0,0), substituteMatrix(2,-2));
+		for(const auto & bAln : mapper.mapSeqsToBamAlignments(inputSeqs, mapperAligner, pars_.numThreads_)){
+			if (bAln.IsMapped()) {
+				bAlns.emplace_back(bAln);
+			}
+		}
+		refData = mapper.refData_;
 	}else{
-		auto lastzRunOut = bRunner.lastzAlign(uniqueSeqInOpts, pars_.lzPars_);
-		BioCmdsUtils::checkRunOutThrow(lastzRunOut, __PRETTY_FUNCTION__);
+		auto uniqueSeqInOpts = SeqIOOptions::genFastaIn(seqInputFnp);
+		uniqueSeqInOpts.out_.outFilename_ = njh::files::make_path(pars_.workingDirtory_, "aligned_inputSeqs.sorted.bam");
+		uniqueSeqInOpts.out_.outExtention_ = ".sorted.bam";
+		fnpsToRemove.emplace_back(uniqueSeqInOpts.out_.outFilename_);
+		fnpsToRemove.emplace_back(uniqueSeqInOpts.out_.outFilename_.string() + ".bai");
+
+		uniqueSeqInOpts.out_.transferOverwriteOpts(seqOpts.out_);
+		if(!pars_.useLastz_){
+			auto bowtieRunOut = bRunner.bowtie2Align(uniqueSeqInOpts, pars_.lzPars_.genomeFnp, pars_.additionalBowtieArguments_);
+
+			//auto bowtieRunOut = bRunner.bowtie2Align(uniqueSeqInOpts, pars_.lzPars_.genomeFnp, "-D 20 -R 3 -N 1 -L 15 -i S,1,0.5 --end-to-end");
+			BioCmdsUtils::checkRunOutThrow(bowtieRunOut, __PRETTY_FUNCTION__);
+		}else{
+			auto lastzRunOut = bRunner.lastzAlign(uniqueSeqInOpts, pars_.lzPars_);
+			BioCmdsUtils::checkRunOutThrow(lastzRunOut, __PRETTY_FUNCTION__);
+		}
+		BamTools::BamReader bReader;
+		bReader.Open(uniqueSeqInOpts.out_.outName().string());
+		checkBamOpenThrow(bReader, uniqueSeqInOpts.out_.outName());
+		refData = bReader.GetReferenceData();
+		BamTools::BamAlignment bAln;
+		while (bReader.GetNextAlignment(bAln)) {
+			if (bAln.IsMapped()) {
+				bAlns.emplace_back(bAln);
+			}
+		}
 	}
 
-	auto regionsCounter = GenomicRegionCounter::countRegionsInBam(uniqueSeqInOpts.out_.outName());
+	GenomicRegionCounter regionsCounter;
+	regionsCounter.increaseCounts(bAlns, refData);
 	auto ids = regionsCounter.getIntersectingGffIds(pars_.gffFnp_);
 	ret.geneIds_ = ids;
 
@@ -529,30 +564,83 @@ TranslatorByAlignment::TranslatorByAlignmentResult TranslatorByAlignment::run(co
 			}
 		}
 	}
-	BamTools::BamReader bReader;
-	bReader.Open(uniqueSeqInOpts.out_.outName().string());
-	checkBamOpenThrow(bReader, uniqueSeqInOpts.out_.outName());
-	auto refData = bReader.GetReferenceData();
-	BamTools::BamAlignment bAln;
 	auto chromLengths = tReader.getSeqLens();
 
-	while (bReader.GetNextAlignment(bAln)) {
-		if (bAln.IsMapped() && bAln.IsPrimaryAlignment()) {
-			bAln.Name = names[njh::StrToNumConverter::stoToNum<uint32_t>(bAln.Name)];
-			auto balnGenomicRegion = GenomicRegion(bAln, refData);
-			auto results = ReAlignedSeq::genRealignment(bAln, refData, alignObjSeq, chromLengths, tReader, rPars.realnPars);
-			ret.seqAlns_[bAln.Name].emplace_back(results);
-			if (!njh::in(balnGenomicRegion.createUidFromCoords(), alnRegionToGeneIds)) {
-				continue;
-			}
-			for (const auto & g : alnRegionToGeneIds.at(balnGenomicRegion.createUidFromCoords())) {
-				const auto & currentGene = genes.at(g);
-				const auto & currentGeneInfo = ret.transcriptInfosForGene_.at(g);
-				auto translations = translateBasedOnAlignment(results, *currentGene, currentGeneInfo, alignObj);
-				for(const auto & trans : translations){
-					ret.translations_[bAln.Name].emplace(trans);
+	std::vector<uint32_t> primaryPositions;
+	for (const auto pos : iter::range<uint32_t>(bAlns.size())) {
+		if (bAlns[pos].IsPrimaryAlignment()) {
+			bAlns[pos].Name = names[njh::StrToNumConverter::stoToNum<uint32_t>(bAlns[pos].Name)];
+			primaryPositions.emplace_back(pos);
+		}
+	}
+	//realign and translate each primary alignment on whichever thread pops it, the genes, their position indexes and the region look ups are only read
+	//so are shared, each thread has its own aligners and twobit reader and results are kept by position and added in input order after so
+	//the output doesn't depend on the number of threads
+	std::vector<ReAlignedSeq> realignments(primaryPositions.size());
+	std::vector<std::unordered_map<std::string, TranslateSeqRes>> translationsPerAln(primaryPositions.size());
+	{
+		std::vector<uint32_t> jobs(primaryPositions.size());
+		njh::iota<uint32_t>(jobs, 0);
+		njh::concurrent::LockableQueue<uint32_t> jobQueue(jobs);
+		uint32_t threadsToUse = std::max<uint32_t>(1, std::min<uint32_t>(pars_.numThreads_, primaryPositions.size()));
+		concurrent::AlignerPool proteinAlnPool(alignObj, threadsToUse);
+		proteinAlnPool.initAligners();
+		concurrent::AlignerPool seqAlnPool(alignObjSeq, threadsToUse);
+		seqAlnPool.initAligners();
+		const auto & transcriptInfosForGene = ret.transcriptInfosForGene_;
+		//the first error from any thread is re-thrown after the join so it reaches the caller the same as with one thread
+		std::exception_ptr error;
+		std::mutex errorMut;
+		std::atomic<bool> failed { false };
+		auto realignAndTranslate = [&jobQueue, &proteinAlnPool, &seqAlnPool, &twoBitFnp,
+																&bAlns, &primaryPositions, &refData, &chromLengths, &rPars, &alnRegionToGeneIds,
+																&genes, &transcriptInfosForGene, &realignments, &translationsPerAln,
+																&error, &errorMut, &failed]() {
+			try {
+				auto proteinAligner = proteinAlnPool.popAligner();
+				auto seqAligner = seqAlnPool.popAligner();
+				TwoBit::TwoBitFile threadTReader(twoBitFnp);
+				uint32_t job = 0;
+				while (!failed && jobQueue.getVal(job)) {
+					const auto & bAln = bAlns[primaryPositions[job]];
+					realignments[job] = ReAlignedSeq::genRealignment(bAln, refData, *seqAligner, chromLengths, threadTReader, rPars.realnPars);
+					auto geneIdsSearch = alnRegionToGeneIds.find(GenomicRegion(bAln, refData).createUidFromCoords());
+					if (alnRegionToGeneIds.end() == geneIdsSearch) {
+						continue;
+					}
+					for (const auto & g : geneIdsSearch->second) {
+						auto translations = translateBasedOnAlignment(realignments[job], *genes.at(g), transcriptInfosForGene.at(g), *proteinAligner);
+						for (const auto & trans : translations) {
+							translationsPerAln[job].emplace(trans);
+						}
+					}
 				}
+			} catch (...) {
+				std::lock_guard<std::mutex> lock(errorMut);
+				if (nullptr == error) {
+					error = std::current_exception();
+				}
+				failed = true;
+			}
+		};
+		if (1 == threadsToUse) {
+			realignAndTranslate();
+		} else {
+			std::vector<std::thread> threads;
+			for (uint32_t t = 0; t < threadsToUse; ++t) {
+				threads.emplace_back(realignAndTranslate);
 			}
+			njh::concurrent::joinAllJoinableThreads(threads);
+		}
+		if (nullptr != error) {
+			std::rethrow_exception(error);
+		}
+	}
+	for (const auto job : iter::range(primaryPositions.size())) {
+		const auto & name = bAlns[primaryPositions[job]].Name;
+		ret.seqAlns_[name].emplace_back(realignments[job]);
+		for (const auto & trans : translationsPerAln[job]) {
+			ret.translations_[name].emplace(trans);
 		}
 	}
 	if(!pars_.keepTemporaryFiles_){
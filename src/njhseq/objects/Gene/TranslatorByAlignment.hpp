@@ -62,6 +62,9 @@ public:
 		bfs::path gffFnp_ = "";
 		BioCmdsUtils::LastZPars lzPars_;
 		bool useLastz_ = false;
+		bool useBuiltInMapper_ = false; /**< map with SeedExtendMapper in memory rather than calling out to bowtie2/lastz */
+		SeedExtendMapper::Pars mapperPars_;
+		uint32_t numThreads_ = 1;
 		std::string additionalBowtieArguments_;
 		bfs::path workingDirtory_;
 
@@ -26,6 +26,7 @@
 //
 
 
+#include "njhseq/objects/Meta/MetaStringPool.hpp"
 #include "njhseq/objects/Meta/MetaDataInName.hpp"
 #include "njhseq/objects/Meta/GroupMetaData.hpp"
 #include "njhseq/objects/Meta/MultipleGroupMetaData.hpp"
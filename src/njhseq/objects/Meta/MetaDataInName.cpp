@@ -22,36 +22,212 @@
 // You should have received a copy of the GNU General Public License
 // along with njhseq.  If not, see <http://www.gnu.org/licenses/>.
 //
-
 #include "MetaDataInName.hpp"
 #include "njhseq/utils/stringUtils.hpp"
 
 namespace njhseq {
 
+namespace {
+
+/**@brief Call func(key, value) for each key=value field in a meta section, splitting on the ; that aren't inside nested brackets,
+ * stops early if func returns false
+ *
+ */
+template<typename FUNC>
+void forEachMetaField(std::string_view section, const std::string & name, FUNC func) {
+	size_t tokStart = 0;
+	size_t equalPos = std::string_view::npos;
+	int32_t depth = 0;
+	for (size_t pos = 0; pos <= section.size(); ++pos) {
+		if (section.size() == pos || (';' == section[pos] && 0 == depth)) {
+			if (pos > tokStart) {
+				auto tok = section.substr(tokStart, pos - tokStart);
+				if (std::string_view::npos == equalPos) {
+					std::stringstream ss;
+					ss << "Error in : " << __PRETTY_FUNCTION__
+							<< ", values should be separated by one =, no = found in tok: " << tok << " from name: " << name
+							<< std::endl;
+					throw std::runtime_error { ss.str() };
+				}
+				if (!func(tok.substr(0, equalPos - tokStart), tok.substr(equalPos - tokStart + 1))) {
+					return;
+				}
+			}
+			tokStart = pos + 1;
+			equalPos = std::string_view::npos;
+		} else if ('[' == section[pos]) {
+			++depth;
+		} else if (']' == section[pos]) {
+			--depth;
+		} else if ('=' == section[pos] && 0 == depth && std::string_view::npos == equalPos) {
+			equalPos = pos;
+		}
+	}
+}
+
+bool findInMetaSection(std::string_view section, std::string_view key,
+		std::string_view & value) {
+	bool found = false;
+	forEachMetaField(section, std::string(), [&key, &value, &found](std::string_view fieldKey, std::string_view fieldValue) {
+		if (fieldKey == key) {
+			value = fieldValue;
+			found = true;
+		}
+		return !found;
+	});
+	return found;
+}
+
+/**@brief Numbers, as they tend to be per read (positions, counts), only the characters of integers and decimals
+ *
+ */
+bool looksNumeric(std::string_view value) {
+	bool hasDigit = false;
+	for (const auto c : value) {
+		if (std::isdigit(static_cast<unsigned char>(c))) {
+			hasDigit = true;
+		} else if ('.' != c && '-' != c && '+' != c && 'e' != c && 'E' != c) {
+			return false;
+		}
+	}
+	return hasDigit;
+}
+
+/**@brief Sequences like UMIs and barcodes, nearly every read has a different one
+ *
+ */
+bool looksLikeSeq(std::string_view value) {
+	return value.size() >= MetaDataInName::minUnpooledSeqLength_
+			&& std::all_of(value.begin(), value.end(), [](char c) {
+				return std::string_view::npos != std::string_view("ACGTUNacgtun").find(c);
+			});
+}
+
+}  // namespace
+
+MetaDataInName::Entry MetaDataInName::makeEntry(std::string_view key,
+		std::string_view val) {
+	Entry ret { MetaStringPool::keys().intern(key), inlineValueId_, std::string() };
+	auto & values = MetaStringPool::values();
+	//already interned values cost nothing more to refer to
+	if (values.find(val, ret.valueId_)) {
+		return ret;
+	}
+	if (val.size() <= maxPooledValueLength_ && !looksNumeric(val)
+			&& !looksLikeSeq(val) && values.size() < maxPooledValues_) {
+		ret.valueId_ = values.intern(val);
+	} else {
+		ret.valueId_ = inlineValueId_;
+		ret.value_.assign(val.data(), val.size());
+	}
+	return ret;
+}
+
 
 MetaDataInName::MetaDataInName() {
 
 }
 
 MetaDataInName::MetaDataInName(const std::string & str) {
-	processNameForMeta(str, false);
+	auto section = getMetaSection(str);
+	//check the fields now so a bad name fails here like it would if it was parsed up front
+	forEachMetaField(section, str, [&section, &str](std::string_view key, std::string_view) {
+		uint32_t keyCount = 0;
+		forEachMetaField(section, str, [&key, &keyCount](std::string_view otherKey, std::string_view) {
+			if (otherKey == key) {
+				++keyCount;
+			}
+			return true;
+		});
+		if (keyCount > 1) {
+			std::stringstream ss;
+			ss << "Error in " << njh::bashCT::bold << __PRETTY_FUNCTION__
+					<< njh::bashCT::reset << " attempting to add meta, "
+					<< njh::bashCT::bold << key << njh::bashCT::reset
+					<< ", that's already in meta_, use replace = true to replace"
+					<< std::endl;
+			throw std::runtime_error { ss.str() };
+		}
+		return true;
+	});
+	raw_.assign(section.data(), section.size());
 }
 
+void MetaDataInName::internRaw() {
+	if (!raw_.empty()) {
+		forEachMetaField(raw_, raw_, [this](std::string_view key, std::string_view value) {
+			entries_.emplace_back(makeEntry(key, value));
+			return true;
+		});
+		std::string().swap(raw_);
+	}
+}
+
+void MetaDataInName::getFields(
+		std::vector<std::pair<std::string_view, std::string_view>> & fields) const {
+	fields.clear();
+	if (raw_.empty()) {
+		for (const auto & entry : entries_) {
+			fields.emplace_back(MetaStringPool::keys().get(entry.keyId_), entry.value());
+		}
+	} else {
+		forEachMetaField(raw_, raw_, [&fields](std::string_view key, std::string_view value) {
+			fields.emplace_back(key, value);
+			return true;
+		});
+	}
+}
+
+void MetaDataInName::addMetaEntry(Entry entry, bool replace) {
+	internRaw();
+	for (auto & current : entries_) {
+		if (entry.keyId_ == current.keyId_) {
+			if (!replace) {
+				std::stringstream ss;
+				ss << "Error in " << njh::bashCT::bold << __PRETTY_FUNCTION__
+						<< njh::bashCT::reset << " attempting to add meta, "
+						<< njh::bashCT::bold << MetaStringPool::keys().get(entry.keyId_) << njh::bashCT::reset
+						<< ", that's already in meta_, use replace = true to replace"
+						<< std::endl;
+				throw std::runtime_error { ss.str() };
+			}
+			current = std::move(entry);
+			return;
+		}
+	}
+	entries_.emplace_back(std::move(entry));
+}
+
+void MetaDataInName::addMetaStr(std::string_view key, std::string_view val,
+		bool replace) {
+	addMetaEntry(makeEntry(key, val), replace);
+}
 
 void MetaDataInName::removeMeta(const std::string & metaField){
 	containsMetaThrow(metaField, __PRETTY_FUNCTION__);
-	meta_.erase(metaField);
+	internRaw();
+	uint32_t keyId = 0;
+	MetaStringPool::keys().find(metaField, keyId);
+	entries_.erase(std::remove_if(entries_.begin(), entries_.end(),
+			[&keyId](const Entry & entry) {
+				return keyId == entry.keyId_;
+			}), entries_.end());
 }
 
 void MetaDataInName::addMeta(const MetaDataInName & otherMeta, bool replace) {
-	for(const auto & meta : otherMeta.meta_){
-		addMeta(meta.first, meta.second, replace);
+	if (otherMeta.raw_.empty()) {
+		for (const auto & entry : otherMeta.entries_) {
+			addMetaEntry(entry, replace);
+		}
+	} else {
+		forEachMetaField(otherMeta.raw_, otherMeta.raw_, [this, &replace](std::string_view key, std::string_view value) {
+			addMetaStr(key, value, replace);
+			return true;
+		});
 	}
 }
 
-
-void MetaDataInName::processNameForMeta(const std::string & name, bool replace){
-
+std::string_view MetaDataInName::getMetaSection(const std::string & name) {
 	auto firstBracket = name.find("[");
 	if(std::string::npos == firstBracket){
 		std::stringstream ss;
@@ -75,167 +251,130 @@ void MetaDataInName::processNameForMeta(const std::string & name, bool replace){
 				<< std::endl;
 		throw std::runtime_error { ss.str() };
 	}
-	auto openingBrackets = findOccurences(name, "[");
-	auto closingBrackets = findOccurences(name, "]");
-	if(openingBrackets.size() > 1){
-		/**@todo still some corner cases that need to be handled below, like if there is two opening brackets before the close e.g. [text[text] ]*/
-		if(openingBrackets.size() != closingBrackets.size()){
+	if (std::string::npos != name.find("[", firstBracket + 1)) {
+		/**@todo still some corner cases that need to be handled, like brackets that are balanced in count but not in order e.g. []text[ ]*/
+		auto openingCount = std::count(name.begin(), name.end(), '[');
+		auto closingCount = std::count(name.begin(), name.end(), ']');
+		if (openingCount != closingCount) {
 			std::stringstream ss;
 			ss << "Error in : " << __PRETTY_FUNCTION__
 					<< " unequal number of opening and closing brackets" << " from name: " << name
-					<< ", opening:" << openingBrackets.size() << ", closing:" <<closingBrackets.size()
+					<< ", opening:" << openingCount << ", closing:" << closingCount
 					<< std::endl;
 			throw std::runtime_error{ss.str()};
 		}
+	}
+	return std::string_view(name).substr(firstBracket + 1, secondBracket - firstBracket - 1);
+}
 
-		auto nextBracketPos = name.find("[", firstBracket + 1);
-		std::vector<std::pair<size_t, size_t>> bracketsPositions;
-		while(std::string::npos != nextBracketPos ){
-			auto nextCloseBracket = name.find("]", nextBracketPos);
-			uint32_t openBracketCount = 0;
-			auto theNextOpeningBracket =  name.find("[", nextBracketPos + 1);
-			while(theNextOpeningBracket < nextCloseBracket){
-				++openBracketCount;
-				theNextOpeningBracket =  name.find("[", theNextOpeningBracket + 1);
-			}
-			for(uint32_t bracketCount = 0; bracketCount < openBracketCount; ++bracketCount){
-				nextCloseBracket = name.find("]", nextCloseBracket + 1);
-			}
-			if(std::string::npos == nextCloseBracket){
-				std::stringstream ss;
-				ss << "Error in : " << __PRETTY_FUNCTION__
-						<< "could not find the next closing bracket after open bracketPosition: "
-						<< nextBracketPos << " from name: " << name << std::endl;
-				throw std::runtime_error { ss.str() };
-			}
-			bracketsPositions.emplace_back(std::make_pair(nextBracketPos, nextCloseBracket));
-			nextBracketPos = name.find("[", nextCloseBracket);
-		}
-		std::unordered_map<std::string, std::string> extractKeyToks;
-		uint32_t tokNum = 0;
-		auto modName = name;
-		for(const auto & position : iter::reversed(bracketsPositions)){
-			std::string replacementTokenName = "TOKEN_TO_BE_REPLACED." + estd::to_string(tokNum);
-			extractKeyToks[replacementTokenName] = name.substr(position.first, position.second + 1 - position.first);
-			modName.erase(modName.begin() + position.first, modName.begin() + 1 + position.second);
-			modName.insert(modName.begin() + position.first, replacementTokenName.begin(), replacementTokenName.end());
-			++tokNum;
-		}
-		auto modName_firstBracket = modName.find("[");
-		if(std::string::npos == modName_firstBracket){
-			std::stringstream ss;
-			ss << "Error in : " << __PRETTY_FUNCTION__
-					<< ", could not find [ in " << modName << std::endl;
-			throw std::runtime_error{ss.str()};
-		}
-		auto modName_secondBracket = modName.rfind("]");
-		if(std::string::npos == modName_secondBracket){
-			std::stringstream ss;
-			ss << "Error in : " << __PRETTY_FUNCTION__
-					<< ", could not find ] in " << modName  << " after " << modName_firstBracket
-					<< std::endl;
-			throw std::runtime_error{ss.str()};
-		}
-		if(modName_firstBracket > modName_secondBracket){
-			std::stringstream ss;
-			ss << "Error in : " << __PRETTY_FUNCTION__ << ", [ must come before ] "
-					<< "\n";
-			ss << "[ pos: " << modName_firstBracket << "; ] pos: " << modName_secondBracket << "\n"
-					<< std::endl;
-			throw std::runtime_error { ss.str() };
-		}
-		auto toks = njh::tokenizeString(modName.substr(modName_firstBracket + 1, modName_secondBracket - modName_firstBracket - 1), ";");
-		for(const auto & tok : toks){
-//			auto subToks = njh::tokenizeString(tok, "=");
-//			if(2 != subToks.size()){
-//				std::stringstream ss;
-//				ss << "Error in : " << __PRETTY_FUNCTION__
-//						<< "values should be separated by one =, not " << subToks.size()
-//						<< " for tok: " << tok << " from modName: " << modName
-//						<< ", originalName: " << name << std::endl;
-//				throw std::runtime_error { ss.str() };
-//			}else{
-//				auto metaFieldKey = subToks[0];
-//				auto metaFieldValue = subToks[1];
-//				for(const auto & nameReplace : extractKeyToks){
-//					metaFieldKey = njh::replaceString(metaFieldKey, nameReplace.first, nameReplace.second);
-//					metaFieldValue = njh::replaceString(metaFieldValue, nameReplace.first, nameReplace.second);
-//				}
-//				addMeta(metaFieldKey, metaFieldValue, replace);
-//			}
-			auto firstEqual = tok.find("=");
-			if(std::string::npos == firstEqual){
-				std::stringstream ss;
-				ss << "Error in : " << __PRETTY_FUNCTION__
-						<< "values should be separated by one =, no equal sign found in  " << "tok: " << tok << " from modName: " << modName
-						<< ", originalName: " << name << std::endl;
-				throw std::runtime_error { ss.str() };
-			}else{
-				auto metaFieldKey = tok.substr(0, tok.find("="));
-				auto metaFieldValue = firstEqual == tok.size()? std::string("") : tok.substr(tok.find("=") + 1);
-				for(const auto & nameReplace : extractKeyToks){
-					metaFieldKey = njh::replaceString(metaFieldKey, nameReplace.first, nameReplace.second);
-					metaFieldValue = njh::replaceString(metaFieldValue, nameReplace.first, nameReplace.second);
-				}
-				addMeta(metaFieldKey, metaFieldValue, replace);
-			}
-		}
-	}else{
-		auto toks = njh::tokenizeString(name.substr(firstBracket + 1, secondBracket - firstBracket - 1), ";");
-		for(const auto & tok : toks){
-//			auto subToks = njh::tokenizeString(tok, "=");
-//			if(2 != subToks.size()){
-//				std::stringstream ss;
-//				ss << "Error in : " << __PRETTY_FUNCTION__
-//						<< "values should be separated by one =, not " << subToks.size() << " for tok: " << tok << " from name: " << name
-//						<< std::endl;
-//				throw std::runtime_error{ss.str()};
-//			}else{
-//				addMeta(subToks[0], subToks[1], replace);
-//			}
-			auto firstEqual = tok.find("=");
-			if(std::string::npos == firstEqual){
+void MetaDataInName::processNameForMeta(const std::string & name, bool replace){
+	auto section = getMetaSection(name);
+	internRaw();
+	forEachMetaField(section, name, [this, &replace](std::string_view key, std::string_view value) {
+		addMetaStr(key, value, replace);
+		return true;
+	});
+}
 
-				std::stringstream ss;
-				ss << "Error in : " << __PRETTY_FUNCTION__
-						<< "values should be separated by one =, no = found in tok: " << tok << " from name: " << name
-						<< std::endl;
-				throw std::runtime_error{ss.str()};
-			}else{
-				addMeta(tok.substr(0, tok.find("=")), firstEqual == tok.size() ? std::string("") : tok.substr(tok.find("=") + 1), replace);
-			}
-		}
+bool MetaDataInName::containsMeta(const std::string & key) const {
+	if (!raw_.empty()) {
+		std::string_view value;
+		return findInMetaSection(raw_, key, value);
 	}
+	uint32_t keyId = 0;
+	if (!MetaStringPool::keys().find(key, keyId)) {
+		return false;
+	}
+	return entries_.end() != std::find_if(entries_.begin(), entries_.end(),
+			[&keyId](const Entry & entry) {
+				return keyId == entry.keyId_;
+			});
 }
 
-bool MetaDataInName::containsMeta(const std::string & key) const {
-	return meta_.find(key) != meta_.end();
+void MetaDataInName::throwNoMeta(const std::string & key, const std::string & funcName) const {
+	std::stringstream ss;
+	ss << funcName << ", error no meta field " << key << "\n";
+	ss << "Options are: " << njh::conToStr(getMetaKeys(), ", ") << "\n";
+	throw std::runtime_error{ss.str()};
 }
 
 void MetaDataInName::containsMetaThrow(const std::string & key, const std::string & funcName) const{
 	if(!containsMeta(key)){
-		std::stringstream ss;
-		ss << funcName << ", error no meta field " << key << "\n";
-		ss << "Options are: " << njh::conToStr(njh::getVecOfMapKeys(meta_), ", ") << "\n";
-		throw std::runtime_error{ss.str()};
+		throwNoMeta(key, funcName);
+	}
+}
+
+std::string_view MetaDataInName::getRawMetaValue(const std::string & key) const {
+	std::string_view value;
+	if (!findInMetaSection(raw_, key, value)) {
+		throwNoMeta(key, __PRETTY_FUNCTION__);
+	}
+	return value;
+}
+
+const MetaDataInName::Entry & MetaDataInName::getEntry(const std::string & key) const {
+	uint32_t keyId = 0;
+	if (MetaStringPool::keys().find(key, keyId)) {
+		for (const auto & entry : entries_) {
+			if (keyId == entry.keyId_) {
+				return entry;
+			}
+		}
 	}
+	throwNoMeta(key, __PRETTY_FUNCTION__);
+	return entries_.front();
 }
 
 std::string MetaDataInName::getMeta(const std::string & key) const {
-	auto search = meta_.find(key);
-	if (search != meta_.end()) {
-		return search->second;
-	}else{
-		std::stringstream ss;
-		ss << __FILE__ << " - " << __LINE__ << " : " << __PRETTY_FUNCTION__ << ", error no meta field " << key << "\n";
-		ss << "Options are: " << njh::conToStr(njh::getVecOfMapKeys(meta_), ", ") << "\n";
-		throw std::runtime_error{ss.str()};
+	if (!raw_.empty()) {
+		return std::string(getRawMetaValue(key));
+	}
+	return std::string(getEntry(key).value());
+}
+
+uint32_t MetaDataInName::size() const {
+	if (raw_.empty()) {
+		return entries_.size();
+	}
+	uint32_t ret = 0;
+	forEachMetaField(raw_, raw_, [&ret](std::string_view, std::string_view) {
+		++ret;
+		return true;
+	});
+	return ret;
+}
+
+bool MetaDataInName::empty() const {
+	return 0 == size();
+}
+
+void MetaDataInName::clear() {
+	entries_.clear();
+	raw_.clear();
+}
+
+VecStr MetaDataInName::getMetaKeys() const {
+	VecStr ret;
+	std::vector<std::pair<std::string_view, std::string_view>> fields;
+	getFields(fields);
+	for (const auto & field : fields) {
+		ret.emplace_back(field.first);
 	}
-	return "";
+	return ret;
+}
+
+std::unordered_map<std::string, std::string> MetaDataInName::toMap() const {
+	std::unordered_map<std::string, std::string> ret;
+	std::vector<std::pair<std::string_view, std::string_view>> fields;
+	getFields(fields);
+	for (const auto & field : fields) {
+		ret.emplace(field.first, field.second);
+	}
+	return ret;
 }
 
 std::string MetaDataInName::pasteLevels(const std::string & sep) const{
-	return pasteLevels(getVectorOfMapKeys(meta_), sep);
+	return pasteLevels(getMetaKeys(), sep);
 }
 
 std::string MetaDataInName::pasteLevels(const VecStr & metalevels,
@@ -251,42 +390,65 @@ std::string MetaDataInName::pasteLevels(const VecStr & metalevels,
 	}
 }
 
-std::string MetaDataInName::createMetaName() const {
-	std::string newMeta = "[";
-	auto metaKeys = njh::getVecOfMapKeys(meta_);
+void MetaDataInName::appendMetaName(
+		const std::vector<std::pair<std::string_view, std::string_view>> & fields,
+		std::string & out) {
+	out.push_back('[');
+	bool first = true;
+	for (const auto & field : fields) {
+		if (!first) {
+			out.push_back(';');
+		}
+		first = false;
+		out.append(field.first);
+		out.push_back('=');
+		out.append(field.second);
+	}
+	out.push_back(']');
+}
+
+void MetaDataInName::createMetaName(std::string & out) const {
+	std::vector<std::pair<std::string_view, std::string_view>> fields;
+	getFields(fields);
+	using Field = std::pair<std::string_view, std::string_view>;
 	//sort integer by their actual numerical values if all keys numbers
-	if(std::all_of(metaKeys.begin(), metaKeys.end(), [](const std::string & str){ return njh::strAllDigits(str);}) ){
-		njh::sort(metaKeys, [](const std::string & str1, const std::string & str2){
-			return njh::StrToNumConverter::stoToNum<uint32_t>(str1) < njh::StrToNumConverter::stoToNum<uint32_t>(str2);
+	if (std::all_of(fields.begin(), fields.end(), [](const Field & field) {
+		return njh::strAllDigits(std::string(field.first));
+	})) {
+		njh::sort(fields, [](const Field & field1, const Field & field2) {
+			return njh::StrToNumConverter::stoToNum<uint32_t>(std::string(field1.first))
+					< njh::StrToNumConverter::stoToNum<uint32_t>(std::string(field2.first));
+		});
+	} else {
+		njh::sort(fields, [](const Field & field1, const Field & field2) {
+			return field1.first < field2.first;
 		});
-	}else{
-		njh::sort(metaKeys);
-	}
-	for (const auto & metaKey : metaKeys) {
-		const auto & meta = meta_.at(metaKey);
-		if ("[" != newMeta) {
-			newMeta.append(";" + metaKey + "=" + meta);
-		} else {
-			newMeta.append(metaKey + "=" + meta);
-		}
 	}
-	newMeta.append("]");
+	out.clear();
+	appendMetaName(fields, out);
+}
+
+void MetaDataInName::createMetaName(std::string & out,
+		const std::function<bool(const std::string &, const std::string &)> & metaKeyPredSorter) const {
+	std::vector<std::pair<std::string_view, std::string_view>> fields;
+	getFields(fields);
+	using Field = std::pair<std::string_view, std::string_view>;
+	njh::sort(fields, [&metaKeyPredSorter](const Field & field1, const Field & field2) {
+		return metaKeyPredSorter(std::string(field1.first), std::string(field2.first));
+	});
+	out.clear();
+	appendMetaName(fields, out);
+}
+
+std::string MetaDataInName::createMetaName() const {
+	std::string newMeta;
+	createMetaName(newMeta);
 	return newMeta;
 }
 
 std::string MetaDataInName::createMetaName(const std::function<bool(const std::string &, const std::string &)> & metaKeyPredSorter) const{
-	std::string newMeta = "[";
-	auto metaKeys = njh::getVecOfMapKeys(meta_);
-	njh::sort(metaKeys, metaKeyPredSorter);
-	for (const auto & metaKey : metaKeys) {
-		const auto & meta = meta_.at(metaKey);
-		if ("[" != newMeta) {
-			newMeta.append(";" + metaKey + "=" + meta);
-		} else {
-			newMeta.append(metaKey + "=" + meta);
-		}
-	}
-	newMeta.append("]");
+	std::string newMeta;
+	createMetaName(newMeta, metaKeyPredSorter);
 	return newMeta;
 }
 
@@ -302,16 +464,17 @@ void MetaDataInName::resetMetaInName(std::string & name,
 				<< std::endl;
 		throw std::runtime_error { ss.str() };
 	}
-	std::string newMeta = createMetaName();
+	//re-used between calls so resetting names read after read doesn't allocate a new meta name each time
+	thread_local std::string newMeta;
+	createMetaName(newMeta);
 	if (std::string::npos != firstOpeningBracket
 			&& std::string::npos != secondBracket) {
-		name = name.substr(0, firstOpeningBracket) + newMeta
-				+ name.substr(secondBracket + 1);
+		name.replace(firstOpeningBracket, secondBracket + 1 - firstOpeningBracket, newMeta);
 	} else {
 		if (std::numeric_limits<size_t>::max() != pos && pos < name.size()) {
-			name.insert(name.begin() + pos, newMeta.begin(), newMeta.end());
+			name.insert(pos, newMeta);
 		} else {
-			name += newMeta;
+			name.append(newMeta);
 		}
 	}
 }
@@ -330,7 +493,7 @@ void MetaDataInName::removeMetaDataInName(std::string & name){
 		}
 		if (std::string::npos != firstBracket
 				&& std::string::npos != secondBracket) {
-			name = name.substr(0, firstBracket) + name.substr(secondBracket + 1);
+			name.erase(firstBracket, secondBracket + 1 - firstBracket);
 		}
 	}
 }
@@ -365,7 +528,7 @@ MetaDataInName MetaDataInName::genMetaFromJson(const Json::Value & val){
 Json::Value MetaDataInName::toJson() const{
 	Json::Value ret;
 	ret["class"] = njh::json::toJson(njh::getTypeName(*this));
-	ret["meta_"] = njh::json::toJson(meta_);
+	ret["meta_"] = njh::json::toJson(toMap());
 	return ret;
 }
 
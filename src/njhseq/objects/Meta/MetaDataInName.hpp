@@ -24,38 +24,51 @@
 // along with njhseq.  If not, see <http://www.gnu.org/licenses/>.
 //
 #include "njhseq/common.h"
+#include "njhseq/objects/Meta/MetaStringPool.hpp"
 
 namespace njhseq {
 
 
+/**@brief Meta data stored in a name as [key1=value1;key2=value2]
+ *
+ * Keys and values are interned in MetaStringPool so each meta is a small vector of (key id, value id) pairs, meta constructed from a name
+ * holds on to the raw text between the brackets and only interns it on the first change, lookups and writing it out work off of the raw text
+ * without interning, typed lookups on interned values are cached per value so getMeta<T> doesn't re-convert values it has already seen.
+ *
+ * The pool never frees anything, so only values that look like they come from a small set are interned, numbers (positions, counts),
+ * sequences of at least minUnpooledSeqLength_ bases (UMIs, barcodes) and values longer than maxPooledValueLength_ are held by the meta
+ * itself, as is every new value once MetaStringPool::values() holds maxPooledValues_ strings, so per read values can't grow the pool
+ * without limit
+ *
+ */
 class MetaDataInName {
 public:
 
 	MetaDataInName();
 	MetaDataInName(const std::string & str);
 
-	std::unordered_map<std::string, std::string> meta_;
+	static constexpr uint32_t maxPooledValueLength_ = 32; /**< longer values are held by the meta rather than interned */
+	static constexpr uint32_t minUnpooledSeqLength_ = 6; /**< values of only bases this long or longer are held by the meta rather than interned */
+	static constexpr uint32_t maxPooledValues_ = 1U << 20; /**< values not already interned are held by the meta once MetaStringPool::values() is this big */
 
 	template<typename T>
 	void addMeta(const std::string & key, const T & val, bool replace = false) {
-		if (containsMeta(key) && !replace) {
-			std::stringstream ss;
-			ss << "Error in " << njh::bashCT::bold << __PRETTY_FUNCTION__
-					<< njh::bashCT::reset << " attempting to add meta, "
-					<< njh::bashCT::bold << key << njh::bashCT::reset
-					<< ", that's already in meta_, use replace = true to replace"
-					<< std::endl;
-			throw std::runtime_error { ss.str() };
-		} else {
-			meta_[key] = estd::to_string(val);
-		}
+		addMetaStr(key, estd::to_string(val), replace);
 	}
 
 	void addMeta(const MetaDataInName & otherMeta, bool replace);
 
 	template<typename T>
 	T getMeta(const std::string & key) const {
-		return njh::lexical_cast<T>(getMeta(key));
+		if (!raw_.empty()) {
+			//converted straight from the name's text, interning it would keep per read values in MetaStringPool::values() for good
+			return njh::lexical_cast<T>(std::string(getRawMetaValue(key)));
+		}
+		const auto & entry = getEntry(key);
+		if (inlineValueId_ == entry.valueId_) {
+			return njh::lexical_cast<T>(entry.value_);
+		}
+		return MetaTypedValueCache<T>::get(entry.valueId_);
 	}
 
 
@@ -69,9 +82,25 @@ public:
 
 	std::string getMeta(const std::string & key) const;
 
+	/**@brief the number of meta fields
+	 *
+	 */
+	uint32_t size() const;
+	bool empty() const;
+	void clear();
+
+	VecStr getMetaKeys() const;
+	std::unordered_map<std::string, std::string> toMap() const;
+
 	std::string createMetaName() const;
 	std::string createMetaName(const std::function<bool(const std::string &, const std::string &)> & metaKeyPredSorter) const;
 
+	/**@brief Write the meta as [key1=value1;key2=value2] into out, replacing what's in out, so a buffer can be re-used between calls
+	 *
+	 */
+	void createMetaName(std::string & out) const;
+	void createMetaName(std::string & out, const std::function<bool(const std::string &, const std::string &)> & metaKeyPredSorter) const;
+
 
 	std::string pasteLevels(const std::string & sep = "") const;
 	std::string pasteLevels(const VecStr & metalevels, const std::string & sep = "") const;
@@ -97,6 +126,53 @@ public:
 	}
 
 	static MetaDataInName genMetaFromJson(const Json::Value & val);
+
+private:
+	static constexpr uint32_t inlineValueId_ = std::numeric_limits<uint32_t>::max();
+
+	struct Entry {
+		uint32_t keyId_; /**< into MetaStringPool::keys() */
+		uint32_t valueId_; /**< into MetaStringPool::values(), inlineValueId_ if the value is in value_ */
+		std::string value_; /**< the value when it isn't interned */
+
+		std::string_view value() const {
+			if (inlineValueId_ == valueId_) {
+				return value_;
+			}
+			return MetaStringPool::values().get(valueId_);
+		}
+	};
+
+	std::vector<Entry> entries_;
+	std::string raw_; /**< the text between the brackets of the name this was made from, until it's interned into entries_*/
+
+	/**@brief Make an entry for key and val, interning val only if it doesn't look unbounded and the pool has room, see the class brief
+	 *
+	 */
+	static Entry makeEntry(std::string_view key, std::string_view val);
+	void addMetaStr(std::string_view key, std::string_view val, bool replace);
+	void addMetaEntry(Entry entry, bool replace);
+	void internRaw();
+	/**@brief Set fields to the (key, value) pairs, views into raw_ or the pools so reading meta never interns anything
+	 *
+	 */
+	void getFields(std::vector<std::pair<std::string_view, std::string_view>> & fields) const;
+	/**@brief The value for key in raw_, only for when raw_ isn't empty
+	 *
+	 */
+	std::string_view getRawMetaValue(const std::string & key) const;
+	/**@brief The entry for key in entries_, only for when raw_ is empty
+	 *
+	 */
+	const Entry & getEntry(const std::string & key) const;
+	void throwNoMeta(const std::string & key, const std::string & funcName) const;
+	static void appendMetaName(const std::vector<std::pair<std::string_view, std::string_view>> & fields,
+			std::string & out);
+
+	/**@brief Get the text between the meta brackets of name, throws if the brackets are malformed
+	 *
+	 */
+	static std::string_view getMetaSection(const std::string & name);
 };
 
 template<>
@@ -104,9 +180,10 @@ inline bool MetaDataInName::getMeta(const std::string & key) const {
 	return "true" == njh::strToLowerRet(getMeta(key));
 }
 
-
-}  // namespace njhseq
-
-
+template<>
+inline std::string MetaDataInName::getMeta(const std::string & key) const {
+	return getMeta(key);
+}
 
 
+}  // namespace njhseq
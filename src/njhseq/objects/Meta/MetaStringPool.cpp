@@ -0,0 +1,97 @@
+/*
+ * MetaStringPool.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: nick
+ */
+// njhseq - A library for analyzing sequence data
+// Copyright (C) 2012-2018 Nicholas Hathaway <nicholas.hathaway@umassmed.edu>,
+//
+// This file is part of njhseq.
+//
+// njhseq is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// njhseq is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with njhseq.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "MetaStringPool.hpp"
+
+namespace njhseq {
+
+MetaStringPool::MetaStringPool() :
+		chunks_(std::make_unique<std::unique_ptr<std::string[]>[]>(maxChunks_)) {
+}
+
+MetaStringPool & MetaStringPool::keys() {
+	static MetaStringPool pool;
+	return pool;
+}
+
+MetaStringPool & MetaStringPool::values() {
+	static MetaStringPool pool;
+	return pool;
+}
+
+bool MetaStringPool::find(std::string_view str, uint32_t & id) const {
+	std::shared_lock<std::shared_timed_mutex> lock(mut_);
+	auto search = ids_.find(str);
+	if (ids_.end() == search) {
+		return false;
+	}
+	id = search->second;
+	return true;
+}
+
+uint32_t MetaStringPool::intern(std::string_view str) {
+	uint32_t id = 0;
+	if (find(str, id)) {
+		return id;
+	}
+	std::unique_lock<std::shared_timed_mutex> lock(mut_);
+	//could have been added while waiting on the lock
+	auto search = ids_.find(str);
+	if (ids_.end() != search) {
+		return search->second;
+	}
+	id = size_.load(std::memory_order_relaxed);
+	if (id >= chunkSize_ * maxChunks_) {
+		std::stringstream ss;
+		ss << __PRETTY_FUNCTION__ << ", error " << "pool is full, can only hold "
+				<< chunkSize_ * maxChunks_ << " distinct strings" << "\n";
+		throw std::runtime_error { ss.str() };
+	}
+	auto & chunk = chunks_[id / chunkSize_];
+	if (nullptr == chunk) {
+		chunk = std::make_unique<std::string[]>(chunkSize_);
+	}
+	auto & stored = chunk[id % chunkSize_];
+	stored.assign(str.data(), str.size());
+	ids_.emplace(std::string_view(stored), id);
+	//publish after the string is in place so get() never sees a partially written entry
+	size_.store(id + 1, std::memory_order_release);
+	return id;
+}
+
+const std::string & MetaStringPool::get(uint32_t id) const {
+	if (id >= size_.load(std::memory_order_acquire)) {
+		std::stringstream ss;
+		ss << __PRETTY_FUNCTION__ << ", error " << "id " << id
+				<< " is out of range, pool size: " << size() << "\n";
+		throw std::runtime_error { ss.str() };
+	}
+	return chunks_[id / chunkSize_][id % chunkSize_];
+}
+
+uint32_t MetaStringPool::size() const {
+	return size_.load(std::memory_order_acquire);
+}
+
+}  // namespace njhseq
@@ -0,0 +1,113 @@
+#pragma once
+/*
+ * MetaStringPool.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: nick
+ */
+// njhseq - A library for analyzing sequence data
+// Copyright (C) 2012-2018 Nicholas Hathaway <nicholas.hathaway@umassmed.edu>,
+//
+// This file is part of njhseq.
+//
+// njhseq is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// njhseq is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with njhseq.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "njhseq/common.h"
+#include <mutex>
+#include <shared_mutex>
+#include <string_view>
+
+namespace njhseq {
+
+/**@brief A process wide pool of interned strings, each distinct string is stored once and referred to by a stable uint32_t id
+ *
+ * Used for the keys and values of MetaDataInName, strings are never removed so this suits text with a limited number of distinct values
+ * (sample names, replicate numbers etc), MetaDataInName keeps numbers, long values and values past its own cap out of here so it doesn't fill up,
+ * getting the string for an id doesn't take a lock
+ *
+ */
+class MetaStringPool {
+public:
+	MetaStringPool();
+
+	MetaStringPool(const MetaStringPool & other) = delete;
+	MetaStringPool & operator=(const MetaStringPool & other) = delete;
+
+	/**@brief The pool for meta keys
+	 *
+	 */
+	static MetaStringPool & keys();
+	/**@brief The pool for meta values
+	 *
+	 */
+	static MetaStringPool & values();
+
+	/**@brief Get the id for str, adding it if it isn't in the pool
+	 *
+	 * @param str the string
+	 * @return the id of str
+	 */
+	uint32_t intern(std::string_view str);
+
+	/**@brief Look up the id for str without adding it
+	 *
+	 * @param str the string
+	 * @param id set to the id of str if found
+	 * @return whether str is in the pool
+	 */
+	bool find(std::string_view str, uint32_t & id) const;
+
+	/**@brief Get the string for id, the reference stays valid for the life of the pool
+	 *
+	 * @param id an id returned by intern()
+	 * @return the string
+	 */
+	const std::string & get(uint32_t id) const;
+
+	uint32_t size() const;
+
+	static constexpr uint32_t chunkSize_ = 4096;
+	static constexpr uint32_t maxChunks_ = 4096;
+
+private:
+	mutable std::shared_timed_mutex mut_;
+	std::unordered_map<std::string_view, uint32_t> ids_; /**< views into the strings held in chunks_ */
+	std::unique_ptr<std::unique_ptr<std::string[]>[]> chunks_; /**< fixed size so readers never see it move */
+	std::atomic<uint32_t> size_ { 0 };
+};
+
+/**@brief A per thread cache of meta values converted to T, keyed by the value's id in MetaStringPool::values()
+ *
+ */
+template<typename T>
+class MetaTypedValueCache {
+public:
+	static constexpr size_t maxCacheSize_ = 4096; /**< cleared when it gets bigger than this so unique per read values don't pile up */
+
+	static T get(uint32_t valueId) {
+		thread_local std::unordered_map<uint32_t, T> cache;
+		auto search = cache.find(valueId);
+		if (cache.end() != search) {
+			return search->second;
+		}
+		T ret = njh::lexical_cast<T>(MetaStringPool::values().get(valueId));
+		if (cache.size() >= maxCacheSize_) {
+			cache.clear();
+		}
+		cache.emplace(valueId, ret);
+		return ret;
+	}
+};
+
+}  // namespace njhseq
@@ -37,8 +37,8 @@ table seqsToMetaTable(const std::vector<T> & seqs){
 	for(auto & seq : seqs){
 		if(MetaDataInName::nameHasMetaData(getSeqBase(seq).name_)){
 			MetaDataInName metaData(getSeqBase(seq).name_);
-			for(const auto & meta : metaData.meta_){
-				allMetaKeys.emplace(meta.first);
+			for(const auto & metaKey : metaData.getMetaKeys()){
+				allMetaKeys.emplace(metaKey);
 			}
 		}
 	}
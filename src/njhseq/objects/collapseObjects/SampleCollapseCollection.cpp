@@ -299,7 +299,7 @@ void SampleCollapseCollection::setUpSampleFromPrevious(
 			MetaDataInName seqMeta(seq.name_);
 			auto topClusterName = seqMeta.getMeta("TopClusterName");
 			seqMeta.removeMeta("TopClusterName");
-			if(seqMeta.meta_.size() == 0){
+			if(seqMeta.empty()){
 				MetaDataInName::removeMetaDataInName(seq.name_);
 			}else{
 				seqMeta.resetMetaInName(seq.name_);
@@ -347,7 +347,7 @@ void SampleCollapseCollection::setUpSampleFromPrevious(
 			MetaDataInName seqMeta(seq.name_);
 			auto topClusterName = seqMeta.getMeta("TopClusterName");
 			seqMeta.removeMeta("TopClusterName");
-			if(seqMeta.meta_.size() == 0){
+			if(seqMeta.empty()){
 //				std::cout << seq.name_ << std::endl;
 				MetaDataInName::removeMetaDataInName(seq.name_);
 //				std::cout << seq.name_ << std::endl;
@@ -583,11 +583,50 @@ void SampleCollapseCollection::clearSamples(const VecStr & sampleNames) {
 
 void SampleCollapseCollection::investigateChimeras(double chiCutOff,
 		aligner & alignerObj) {
+	investigateChimeras(chiCutOff, alignerObj, 1);
+}
+
+void SampleCollapseCollection::investigateChimeras(double chiCutOff,
+		aligner & alignerObj, uint32_t numThreads) {
 	comparison onlyHpErrors;
 	onlyHpErrors.oneBaseIndel_ = 1;
 	onlyHpErrors.twoBaseIndel_ = 0;
 	onlyHpErrors.largeBaseIndel_ = .99;
 
+	//the top two variants of each sample, read from its final file the first time they're needed and read again after the sample is re-dumped below
+	std::unordered_map<std::string, std::vector<seqInfo>> topSeqsForSample;
+	auto getTopSeqs = [this,&topSeqsForSample](const std::string & otherSampleName) -> const std::vector<seqInfo> & {
+		auto search = topSeqsForSample.find(otherSampleName);
+		if (topSeqsForSample.end() != search) {
+			return search->second;
+		}
+		auto otherSampOpts = SeqIOOptions(
+				njh::files::make_path(masterOutputDir_, "samplesOutput",
+						otherSampleName, "final",
+						otherSampleName + inputOptions_.getOutExtension()).string(),
+				inputOptions_.inFormat_, true);
+		SeqInput otherReader(otherSampOpts);
+		otherReader.openIn();
+		std::vector<seqInfo> topSeqs;
+		uint32_t seqCount = 0;
+		seqInfo otherSeq;
+		while (seqCount < 2 && otherReader.readNextRead(otherSeq)) {
+			++seqCount;
+			if (otherSeq.frac_ < 0.01) {
+				continue;
+			}
+			topSeqs.emplace_back(otherSeq);
+		}
+		return topSeqsForSample.emplace(otherSampleName, std::move(topSeqs)).first->second;
+	};
+
+	uint32_t threadsToUse = std::max<uint32_t>(1, numThreads);
+	std::unique_ptr<concurrent::AlignerPool> alnPool;
+	if (threadsToUse > 1) {
+		alnPool = std::make_unique<concurrent::AlignerPool>(alignerObj, threadsToUse);
+		alnPool->initAligners();
+	}
+
 	table chiInfoTab(VecStr { "sample", "numClustersSaved",
 			"totalClustersChecked", "clusterSavedNames" });
 	for (const auto & sampleName : popNames_.samples_) {
@@ -597,58 +636,87 @@ void SampleCollapseCollection::investigateChimeras(double chiCutOff,
 				njh::in(sampleName, lowRepCntSamples_)){
 			continue;
 		}
-
+		auto & clusters = sampleCollapses_[sampleName]->collapsed_.clusters_;
 		uint32_t clustersNotSaved = 0;
 		//first mark the suspicious clusters as being chimeric
-		for (auto &clus : sampleCollapses_[sampleName]->collapsed_.clusters_) {
-			if (clus.isClusterAtLeastChimericCutOff(chiCutOff)) {
-				clus.seqBase_.markAsChimeric();
+		std::vector<uint32_t> chimericPositions;
+		for (const auto clusPos : iter::range(clusters.size())) {
+			if (clusters[clusPos].isClusterAtLeastChimericCutOff(chiCutOff)) {
+				clusters[clusPos].seqBase_.markAsChimeric();
+			}
+			if (clusters[clusPos].seqBase_.isChimeric()) {
+				chimericPositions.emplace_back(clusPos);
 			}
 		}
-		//now check to see if it is ever the top two variants of a sample and if it is unmark it
-		for (auto & clus : sampleCollapses_[sampleName]->collapsed_.clusters_) {
-			if (clus.seqBase_.isChimeric()) {
-				bool saved = false;
-				for (const auto & otherSampleName : popNames_.samples_) {
-					if (otherSampleName != sampleName
-							&& !njh::containsSubString(stringToLowerReturn(otherSampleName),
-									"control")
-							&& !njh::containsSubString(stringToLowerReturn(sampleName),
-									"control")) {
-						auto otherSampOpts = SeqIOOptions(
-								njh::files::make_path(masterOutputDir_, "samplesOutput",
-										otherSampleName, "final",
-										otherSampleName + inputOptions_.getOutExtension()).string(),
-								inputOptions_.inFormat_, true);
-						SeqInput otherReader(otherSampOpts);
-						otherReader.openIn();
-						uint32_t seqCount = 0;
-						seqInfo otherSeq;
-						while (otherReader.readNextRead(otherSeq) && seqCount < 2) {
-							++seqCount;
-							if (otherSeq.frac_ < 0.01) {
-								continue;
-							}
-							alignerObj.alignCacheGlobal(otherSeq, clus.seqBase_);
-							alignerObj.profilePrimerAlignment(otherSeq, clus.seqBase_);
-
-							if (onlyHpErrors.passErrorProfile(alignerObj.comp_)) {
-								clus.seqBase_.unmarkAsChimeric();
-								for (auto & subRead : clus.reads_) {
-									subRead->seqBase_.unmarkAsChimeric();
-								}
-								clus.resetInfos();
-								clustersSavedFromChi.emplace_back(clus.seqBase_.name_);
-								saved = true;
-								break;
-							}
-						}
+		//the top variants of the other samples to compare against
+		std::vector<const std::vector<seqInfo> *> otherTopSeqs;
+		if (!chimericPositions.empty()
+				&& !njh::containsSubString(stringToLowerReturn(sampleName), "control")) {
+			for (const auto & otherSampleName : popNames_.samples_) {
+				if (otherSampleName != sampleName
+						&& !njh::containsSubString(stringToLowerReturn(otherSampleName),
+								"control")) {
+					otherTopSeqs.emplace_back(&getTopSeqs(otherSampleName));
+				}
+			}
+		}
+		//now check to see if it is ever the top two variants of a sample, the clusters aren't changed here so they can be checked on several threads,
+		//timesSaved is the number of samples where it is
+		std::vector<uint32_t> timesSaved(chimericPositions.size(), 0);
+		auto countTimesSaved = [&clusters,&chimericPositions,&otherTopSeqs,&onlyHpErrors,&timesSaved](
+				aligner & currentAligner, uint32_t pos) {
+			const auto & clus = clusters[chimericPositions[pos]];
+			//only the comparison is needed
+			aligner::NoGappedAlignmentGuard noGappedGuard(currentAligner);
+			for (const auto & topSeqs : otherTopSeqs) {
+				for (const auto & otherSeq : *topSeqs) {
+					currentAligner.alignCacheGlobal(otherSeq, clus.seqBase_);
+					currentAligner.profilePrimerAlignment(otherSeq, clus.seqBase_);
+					if (onlyHpErrors.passErrorProfile(currentAligner.comp_)) {
+						++timesSaved[pos];
+						break;
 					}
 				}
-				if (!saved) {
-					++clustersNotSaved;
+			}
+		};
+		if (nullptr == alnPool || chimericPositions.size() < 2) {
+			for (const auto pos : iter::range(chimericPositions.size())) {
+				countTimesSaved(alignerObj, pos);
+			}
+		} else {
+			std::vector<uint32_t> positions(chimericPositions.size());
+			njh::iota<uint32_t>(positions, 0);
+			njh::concurrent::LockableQueue<uint32_t> posQueue(positions);
+			auto checkClusters = [&posQueue,&alnPool,&countTimesSaved]() {
+				auto currentAligner = alnPool->popAligner();
+				uint32_t pos = 0;
+				while (posQueue.getVal(pos)) {
+					countTimesSaved(*currentAligner, pos);
 				}
+			};
+			std::vector<std::thread> threads;
+			for (uint32_t t = 0; t < threadsToUse; ++t) {
+				threads.emplace_back(checkClusters);
 			}
+			njh::concurrent::joinAllJoinableThreads(threads);
+		}
+		for (const auto pos : iter::range(chimericPositions.size())) {
+			if (0 == timesSaved[pos]) {
+				++clustersNotSaved;
+				continue;
+			}
+			auto & clus = clusters[chimericPositions[pos]];
+			clus.seqBase_.unmarkAsChimeric();
+			for (auto & subRead : clus.reads_) {
+				subRead->seqBase_.unmarkAsChimeric();
+			}
+			clus.resetInfos();
+			//listed once for each sample it was a top variant in
+			for (uint32_t times = 0; times < timesSaved[pos]; ++times) {
+				clustersSavedFromChi.emplace_back(clus.seqBase_.name_);
+			}
+		}
+		if (!clusters.empty()) {
 			sampleCollapses_[sampleName]->collapsed_.setSetInfo();
 		}
 		chiInfoTab.content_.emplace_back(
@@ -658,6 +726,11 @@ void SampleCollapseCollection::investigateChimeras(double chiCutOff,
 						clustersSavedFromChi.size() + clustersNotSaved,
 						vectorToString(clustersSavedFromChi, ",")));
 		dumpSample(sampleName);
+		//the final file was just re-written
+		topSeqsForSample.erase(sampleName);
+	}
+	if (nullptr != alnPool) {
+		alnPool->mergeAlnCachesInto(alignerObj);
 	}
 	TableIOOpts chiOutOptions(
 			OutOptions(masterOutputDir_.string() + "chiInfo", ".tab.txt"), "\t",
@@ -1072,7 +1145,7 @@ void SampleCollapseCollection::loadInPreviousPop(const std::set<std::string> & s
 		MetaDataInName inputMeta(inputSeq.name_);
 		auto topClusterName = inputMeta.getMeta("TopClusterName");
 		inputMeta.removeMeta("TopClusterName");
-		if(inputMeta.meta_.size() == 0){
+		if(inputMeta.empty()){
 			MetaDataInName::removeMetaDataInName(inputSeq.name_);
 		}else{
 			inputMeta.resetMetaInName(inputSeq.name_);
@@ -1244,16 +1317,16 @@ void SampleCollapseCollection::printAllSubClusterInfo(const OutOptions& outOpts,
 		for(const auto & excluded : sampleCollapses_.at(sampName)->excluded_.clusters_){
 			if(MetaDataInName::nameHasMetaData(excluded.seqBase_.name_)){
 				MetaDataInName excmeta(excluded.seqBase_.name_);
-				for(const auto & mf : excmeta.meta_){
-					allMetaFields.emplace(mf.first);
+				for(const auto & mf : excmeta.getMetaKeys()){
+					allMetaFields.emplace(mf);
 				}
 			}
 		}
 		for(const auto & collapsed : sampleCollapses_.at(sampName)->collapsed_.clusters_){
 			if(MetaDataInName::nameHasMetaData(collapsed.seqBase_.name_)){
 				MetaDataInName excmeta(collapsed.seqBase_.name_);
-				for(const auto & mf : excmeta.meta_){
-					allMetaFields.emplace(mf.first);
+				for(const auto & mf : excmeta.getMetaKeys()){
+					allMetaFields.emplace(mf);
 				}
 			}
 		}
@@ -139,6 +139,10 @@ public:
 	void checkForSampleThrow(const std::string & funcName, const std::string & sampleName) const;
 
 	void investigateChimeras(double chiCutOff, aligner & alignerObj);
+	/**@brief Same as investigateChimeras() above but with the chimeric clusters of each sample checked against the other samples' top variants over numThreads threads
+	 *
+	 */
+	void investigateChimeras(double chiCutOff, aligner & alignerObj, uint32_t numThreads);
 
 	std::vector<sampleCluster> createPopInput();
 
@@ -29,6 +29,7 @@
 #include "njhseq/seqToolsUtils.h"
 #include "njhseq/readVectorManipulation.h"
 #include "njhseq/objects/kmer/kmerCalculator.hpp"
+#include "njhseq/concurrency/pools/AlignerPool.hpp"
 #include "njhseq/objects/seqObjects/Clusters/cluster.hpp"
 #include "njhseq/objects/collapseObjects/opts.h"
 #include "njhseq/objects/dataContainers/tables/table.hpp"
@@ -103,10 +104,53 @@ public:
 	table markChimeras(std::vector<READ> &processedReads, aligner &alignerObj,
 			const ChimeraOpts & chiOpts) const;
 
+	/**@brief Same as markChimeras() above but with the possibly chimeric reads checked over numThreads threads, each with its own copy of alignerObj,
+	 * the alignments made by the copies are merged into alignerObj's cache afterwards
+	 *
+	 */
+  template<typename READ>
+	table markChimeras(std::vector<READ> &processedReads, aligner &alignerObj,
+			const ChimeraOpts & chiOpts, uint32_t numThreads) const;
+
 
 	table markChimerasTest(std::vector<cluster> &processedReads, aligner &alignerObj,
 			const ChimeraOpts & chiOpts) const;
 
+private:
+	/**@brief The parents found for a chimeric read and the read positions of their cross overs
+	 *
+	 */
+	struct ChiParLocs {
+		ChiParLocs(size_t endReadMinReadPos, size_t endPosition,
+				size_t frontReadMinReadPos, size_t frontPosition) :
+				endReadMinReadPos_(endReadMinReadPos),
+				endPosition_(endPosition),
+				frontReadMinReadPos_(frontReadMinReadPos),
+				frontPosition_(frontPosition) {
+
+		}
+		size_t endReadMinReadPos_;
+		size_t endPosition_;
+
+		size_t frontReadMinReadPos_;
+		size_t frontPosition_;
+
+	};
+
+	/**@brief Look for a cross over between two of the reads before subPos that would make the read at subPos chimeric, doesn't change processedReads
+	 *
+	 * @param processedReads the reads sorted by count
+	 * @param subPos the position of the read to check
+	 * @param alignerObj the aligner to use
+	 * @param chiOpts the chimera options
+	 * @param parentKmers the kmers of the reads when ChimeraOpts::parentKmerPrefilterLen_ is set, otherwise empty
+	 * @param crossOver set to the parents found if the read is chimeric
+	 * @return whether the read is chimeric
+	 */
+	template<typename READ>
+	bool findChimeraCrossOver(const std::vector<READ> &processedReads,
+			size_t subPos, aligner &alignerObj, const ChimeraOpts & chiOpts,
+			const std::vector<std::unordered_set<std::string>> & parentKmers, ChiParLocs & crossOver) const;
 
 };
 
@@ -118,6 +162,9 @@ void collapser::findMatch(CLUSTER &read,
                                  size_t &amountAdded,
 																 aligner &alignerObj) const{
 
+	//only the comparisons are needed here, so skip building the gapped sequences and recording the errors
+	aligner::NoGappedAlignmentGuard noGappedGuard(alignerObj);
+	aligner::CountsOnlyProfileGuard countsOnlyGuard(alignerObj);
 	uint32_t count = 0;
   double bestScore = 0;
   bool foundMatch = false;
@@ -475,14 +522,12 @@ void collapser::runClustering(std::vector<CLUSTER> &currentClusters,
 		std::vector<uint64_t> & positions,
 		CollapseIterations iteratorMap,
 		aligner &alignerObj) const{
+	//the sort keys of the clusters, kept so that after each iteration only the clusters whose count or error changed are re-sorted
+	std::vector<readVecSorter::CountErrorKey> sortKeys;
 	{
 		njh::stopWatch watch;
-		auto comp =
-				[&currentClusters](const uint64_t & pos1, const uint64_t & pos2) {
-					return currentClusters[pos1] < currentClusters[pos2];
-				};
 		watch.setLapName("sortReadVector");
-		njh::sort(positions, comp);
+		readVecSorter::sortPositionsByCountErrorKey(currentClusters, positions, sortKeys);
 		if (opts_.verboseOpts_.debug_) {
 			watch.logLapTimes(std::cout, true, 6, true);
 		}
@@ -506,12 +551,8 @@ void collapser::runClustering(std::vector<CLUSTER> &currentClusters,
 					alignerObj);
 		}
 		njh::stopWatch watch;
-		auto comp =
-				[&currentClusters](const uint64_t & pos1, const uint64_t & pos2) {
-					return currentClusters[pos1] < currentClusters[pos2];
-				};
 		watch.setLapName("sortReadVector");
-		njh::sort(positions, comp);
+		readVecSorter::resortChangedPositions(currentClusters, positions, sortKeys);
 		if (opts_.verboseOpts_.debug_) {
 			watch.logLapTimes(std::cout, true, 6, true);
 		}
@@ -519,278 +560,359 @@ void collapser::runClustering(std::vector<CLUSTER> &currentClusters,
 }
 
 template<typename READ>
-table collapser::markChimeras(std::vector<READ> &processedReads,
-		aligner &alignerObj, const ChimeraOpts & chiOpts) const {
-	table ret(VecStr { "read", "readCnt",
-		"parent1", "parent1Cnt", "parent1Ratio", "parent1SeqPos",
-		"parent2", "parent2Cnt", "parent2Ratio", "parent2SeqPos" });
-	//assumes clusters are coming in sorted by total count
-	if (processedReads.size() <= 2) {
-		return ret;
+bool collapser::findChimeraCrossOver(const std::vector<READ> &processedReads,
+		size_t subPos, aligner &alignerObj, const ChimeraOpts & chiOpts,
+		const std::vector<std::unordered_set<std::string>> & parentKmers, ChiParLocs & crossOver) const {
+	//skip if the clusters to investigate fall below or is equal to the run cut off
+	//normally set to 1 as singlets are going to be thrown out anyways
+	if (getSeqBase(processedReads[subPos]).cnt_ <= chiOpts.runCutOff_) {
+		return false;
 	}
-	if (opts_.verboseOpts_.verbose_) {
-		std::cout << "Marking Chimeras" << std::endl;
-		std::cout << "Initial Pass" << std::endl;
+	//gather the possible parents before aligning anything
+	std::vector<size_t> parentPositions;
+	std::vector<std::string> frontKmers;
+	std::vector<std::string> endKmers;
+	if (!parentKmers.empty()) {
+		const auto & subSeq = getSeqBase(processedReads[subPos]).seq_;
+		const size_t kLen = chiOpts.parentKmerPrefilterLen_;
+		const size_t half = subSeq.size() / 2;
+		for (size_t kPos = 0; kPos + kLen <= subSeq.size(); ++kPos) {
+			if (kPos + kLen <= half) {
+				frontKmers.emplace_back(subSeq.substr(kPos, kLen));
+			} else if (kPos >= half) {
+				endKmers.emplace_back(subSeq.substr(kPos, kLen));
+			}
+		}
 	}
-	//subPos is the position of the clusters to investigate for being possibly chimeric
-	for (const auto & subPos : iter::range<size_t>(2, processedReads.size())) {
-		if (opts_.verboseOpts_.verbose_) {
-			std::cout << subPos << ":" << processedReads.size() << "\r";
-			std::cout.flush();
+	//pos is the position of the possible parents
+	for (const auto &pos : iter::range<size_t>(0, subPos)) {
+		if (opts_.verboseOpts_.verbose_ && opts_.verboseOpts_.debug_) {
+			std::cout << std::endl;
+			std::cout << getSeqBase(processedReads[pos]).name_ << std::endl;
+			std::cout << getSeqBase(processedReads[subPos]).name_ << std::endl;
+			std::cout << "getSeqBase(processedReads[pos]).cnt_"
+					<< getSeqBase(processedReads[pos]).cnt_ << std::endl;
+			std::cout << "getSeqBase(processedReads[pos]).frac_"
+					<< getSeqBase(processedReads[pos]).frac_ << std::endl;
+			std::cout << "getSeqBase(processedReads[subPos]).cnt_"
+					<< getSeqBase(processedReads[subPos]).cnt_ << std::endl;
+			std::cout << "getSeqBase(processedReads[subPos]).frac_"
+					<< getSeqBase(processedReads[subPos]).frac_ << std::endl;
 		}
-		//skip if the clusters to investigate fall below or is equal to the run cut off
-		//normally set to 1 as singlets are going to be thrown out anyways
-		if (getSeqBase(processedReads[subPos]).cnt_ <= chiOpts.runCutOff_) {
+		//skip if the proportion of reads is less than parentFreqs
+		if ((getSeqBase(processedReads[pos]).cnt_
+				/ getSeqBase(processedReads[subPos]).cnt_) < chiOpts.parentFreqs_) {
 			continue;
 		}
-		std::map<size_t, std::vector<size_t>> endChiPos;
-		std::map<size_t, std::vector<size_t>> frontChiPos;
-		//pos is the position of the possible parents
-		for (const auto &pos : iter::range<size_t>(0, subPos)) {
-			if (opts_.verboseOpts_.verbose_ && opts_.verboseOpts_.debug_) {
-				std::cout << std::endl;
-				std::cout << getSeqBase(processedReads[pos]).name_ << std::endl;
-				std::cout << getSeqBase(processedReads[subPos]).name_ << std::endl;
-				std::cout << "getSeqBase(processedReads[pos]).cnt_"
-						<< getSeqBase(processedReads[pos]).cnt_ << std::endl;
-				std::cout << "getSeqBase(processedReads[pos]).frac_"
-						<< getSeqBase(processedReads[pos]).frac_ << std::endl;
-				std::cout << "getSeqBase(processedReads[subPos]).cnt_"
-						<< getSeqBase(processedReads[subPos]).cnt_ << std::endl;
-				std::cout << "getSeqBase(processedReads[subPos]).frac_"
-						<< getSeqBase(processedReads[subPos]).frac_ << std::endl;
-			}
-			//skip if the proportion of reads is less than parentFreqs
-			if ((getSeqBase(processedReads[pos]).cnt_
-					/ getSeqBase(processedReads[subPos]).cnt_) < chiOpts.parentFreqs_) {
+		//skip if the same exact sequence
+		if (getSeqBase(processedReads[pos]).seq_
+				== getSeqBase(processedReads[subPos]).seq_) {
+			continue;
+		}
+		//skip if the parent shares no kmers with either half of the read
+		if (!parentKmers.empty()) {
+			const auto & kmers = parentKmers[pos];
+			auto shared = [&kmers](const std::vector<std::string> & halfKmers) {
+				return std::any_of(halfKmers.begin(), halfKmers.end(),
+						[&kmers](const std::string & k) {return kmers.end() != kmers.find(k);});
+			};
+			if (!shared(frontKmers) && !shared(endKmers)) {
 				continue;
 			}
-			//skip if the same exact sequence
-			if (getSeqBase(processedReads[pos]).seq_
-					== getSeqBase(processedReads[subPos]).seq_) {
-				continue;
+		}
+		parentPositions.emplace_back(pos);
+	}
+	//a cross over needs two different parents
+	if (parentPositions.size() < 2) {
+		return false;
+	}
+	std::map<size_t, std::vector<size_t>> endChiPos;
+	std::map<size_t, std::vector<size_t>> frontChiPos;
+	for (const auto &pos : parentPositions) {
+		//global align
+		alignerObj.alignCacheGlobal(processedReads[pos], processedReads[subPos]);
+		//profile alignment
+		alignerObj.profileAlignment(processedReads[pos], processedReads[subPos],
+				false, true, false);
+		if (opts_.verboseOpts_.verbose_ && opts_.verboseOpts_.debug_) {
+			std::cout << "alignerObj.mismatches_.size()"
+					<< alignerObj.comp_.distances_.mismatches_.size() << std::endl;
+			std::cout << "alignerObj.alignmentGaps_.size()"
+					<< alignerObj.comp_.distances_.alignmentGaps_.size() << std::endl;
+		}
+		std::map<uint32_t, mismatch> savedMismatches =
+				alignerObj.comp_.distances_.mismatches_;
+		//remove any low quality errors
+		if (!chiOpts.keepLowQaulityMismatches_) {
+			std::vector<uint32_t> lowQualMismatches;
+			for (const auto & mis : savedMismatches) {
+				if (!mis.second.highQuality(alignerObj.qScorePars_)) {
+					lowQualMismatches.emplace_back(mis.first);
+				}
 			}
-			//global align
-			alignerObj.alignCacheGlobal(processedReads[pos], processedReads[subPos]);
-			//profile alignment
-			alignerObj.profileAlignment(processedReads[pos], processedReads[subPos],
-					false, true, false);
-			if (opts_.verboseOpts_.verbose_ && opts_.verboseOpts_.debug_) {
-				std::cout << "alignerObj.mismatches_.size()"
-						<< alignerObj.comp_.distances_.mismatches_.size() << std::endl;
-				std::cout << "alignerObj.alignmentGaps_.size()"
-						<< alignerObj.comp_.distances_.alignmentGaps_.size() << std::endl;
+			for (const auto & er : lowQualMismatches) {
+				savedMismatches.erase(er);
 			}
-			std::map<uint32_t, mismatch> savedMismatches =
-					alignerObj.comp_.distances_.mismatches_;
-			//remove any low quality errors
-			if (!chiOpts.keepLowQaulityMismatches_) {
-				std::vector<uint32_t> lowQualMismatches;
-				for (const auto & mis : savedMismatches) {
-					if (!mis.second.highQuality(alignerObj.qScorePars_)) {
-						lowQualMismatches.emplace_back(mis.first);
+		}
+
+		if (alignerObj.comp_.distances_.mismatches_.size() > 0
+				|| alignerObj.comp_.twoBaseIndel_ > 0
+				|| alignerObj.comp_.largeBaseIndel_ > 0) {
+			//save the current mismatches and gap infos
+
+			auto savedGapInfo = alignerObj.comp_.distances_.alignmentGaps_;
+			size_t frontPos = 0;
+			size_t endPos = std::numeric_limits<size_t>::max();
+			if (savedMismatches.size() > 0) {
+				bool passEnd = true;
+				bool passFront = true;
+				//check front until first mismatch
+				if (savedMismatches.begin()->second.seqBasePos + 1
+						<= chiOpts.overLapSizeCutoff_) {
+					passFront = false;
+				} else {
+					alignerObj.profileAlignment(processedReads[pos],
+							processedReads[subPos], false, true, false, 0,
+							savedMismatches.begin()->first);
+					passFront = chiOpts.chiOverlap_.passErrorProfile(alignerObj.comp_);
+					if (passFront) {
+						frontPos = savedMismatches.begin()->second.seqBasePos;
+						//processedReads[subPos].frontChiPos.insert( {
+						//	savedMismatches.begin()->second.seqBasePos, pos });
 					}
 				}
-				for (const auto & er : lowQualMismatches) {
-					savedMismatches.erase(er);
+				//check end from last mismatch
+				if (chiOpts.overLapSizeCutoff_
+						>= (len(getSeqBase(processedReads[subPos]))
+								- savedMismatches.rbegin()->second.seqBasePos)) {
+					passEnd = false;
+				} else {
+					alignerObj.profileAlignment(processedReads[pos],
+							processedReads[subPos], false, true, false,
+							savedMismatches.rbegin()->first + 1);
+					passEnd = chiOpts.chiOverlap_.passErrorProfile(alignerObj.comp_);
+					if (passEnd) {
+						endPos = savedMismatches.rbegin()->second.seqBasePos;
+
+						//processedReads[subPos].endChiPos.insert( {
+						//		savedMismatches.rbegin()->second.seqBasePos, pos });
+					}
 				}
 			}
 
-			if (alignerObj.comp_.distances_.mismatches_.size() > 0
-					|| alignerObj.comp_.twoBaseIndel_ > 0
-					|| alignerObj.comp_.largeBaseIndel_ > 0) {
-				//save the current mismatches and gap infos
-
-				auto savedGapInfo = alignerObj.comp_.distances_.alignmentGaps_;
-				size_t frontPos = 0;
-				size_t endPos = std::numeric_limits<size_t>::max();
-				if (savedMismatches.size() > 0) {
-					bool passEnd = true;
-					bool passFront = true;
-					//check front until first mismatch
-					if (savedMismatches.begin()->second.seqBasePos + 1
-							<= chiOpts.overLapSizeCutoff_) {
-						passFront = false;
-					} else {
-						alignerObj.profileAlignment(processedReads[pos],
-								processedReads[subPos], false, true, false, 0,
-								savedMismatches.begin()->first);
-						passFront = chiOpts.chiOverlap_.passErrorProfile(alignerObj.comp_);
-						if (passFront) {
-							frontPos = savedMismatches.begin()->second.seqBasePos;
-							//processedReads[subPos].frontChiPos.insert( {
-							//	savedMismatches.begin()->second.seqBasePos, pos });
-						}
+			if (savedGapInfo.size() > 0) {
+				//check front until first large gap
+				for (const auto & g : savedGapInfo) {
+					if (g.second.size_ <= 1) {
+						continue;
+					}
+					if (g.second.seqPos_ + 1 <= chiOpts.overLapSizeCutoff_) {
+						continue;
 					}
-					//check end from last mismatch
-					if (chiOpts.overLapSizeCutoff_
-							>= (len(getSeqBase(processedReads[subPos]))
-									- savedMismatches.rbegin()->second.seqBasePos)) {
-						passEnd = false;
-					} else {
-						alignerObj.profileAlignment(processedReads[pos],
-								processedReads[subPos], false, true, false,
-								savedMismatches.rbegin()->first + 1);
-						passEnd = chiOpts.chiOverlap_.passErrorProfile(alignerObj.comp_);
-						if (passEnd) {
-							endPos = savedMismatches.rbegin()->second.seqBasePos;
-
-							//processedReads[subPos].endChiPos.insert( {
-							//		savedMismatches.rbegin()->second.seqBasePos, pos });
+					alignerObj.profileAlignment(processedReads[pos],
+							processedReads[subPos], false, true, false, 0,
+							g.second.startPos_);
+					if (chiOpts.chiOverlap_.passErrorProfile(alignerObj.comp_)) {
+						size_t gapPos = getRealPosForAlnPos(
+								alignerObj.alignObjectB_.seqBase_.seq_, g.second.startPos_);
+						if (gapPos > frontPos) {
+							frontPos = gapPos;
 						}
+						//processedReads[subPos].frontChiPos.insert(
+						//		{ getRealPosForAlnPos(alignerObj.alignObjectB_.seqBase_.seq_, g.second.startPos_), pos });
 					}
+					break;
 				}
 
-				if (savedGapInfo.size() > 0) {
-					//check front until first large gap
-					for (const auto & g : savedGapInfo) {
-						if (g.second.size_ <= 1) {
-							continue;
-						}
-						if (g.second.seqPos_ + 1 <= chiOpts.overLapSizeCutoff_) {
-							continue;
-						}
-						alignerObj.profileAlignment(processedReads[pos],
-								processedReads[subPos], false, true, false, 0,
-								g.second.startPos_);
-						if (chiOpts.chiOverlap_.passErrorProfile(alignerObj.comp_)) {
-							size_t gapPos = getRealPosForAlnPos(
-									alignerObj.alignObjectB_.seqBase_.seq_, g.second.startPos_);
-							if (gapPos > frontPos) {
-								frontPos = gapPos;
-							}
-							//processedReads[subPos].frontChiPos.insert(
-							//		{ getRealPosForAlnPos(alignerObj.alignObjectB_.seqBase_.seq_, g.second.startPos_), pos });
-						}
-						break;
+				//check end from last large gap
+				for (const auto & g : iter::reversed(savedGapInfo)) {
+					if (g.second.size_ <= 1) {
+						continue;
 					}
-
-					//check end from last large gap
-					for (const auto & g : iter::reversed(savedGapInfo)) {
-						if (g.second.size_ <= 1) {
-							continue;
-						}
-						if (len(getSeqBase(processedReads[subPos]))
-								- (g.second.seqPos_ + g.second.size_)
-								<= chiOpts.overLapSizeCutoff_) {
-							continue;
-						}
-						alignerObj.profileAlignment(processedReads[pos],
-								processedReads[subPos], false, true, false,
-								g.second.startPos_ + g.second.size_);
-
-						if (chiOpts.chiOverlap_.passErrorProfile(alignerObj.comp_)) {
-							size_t gapPos = 0;
-							if (g.second.ref_) {
+					if (len(getSeqBase(processedReads[subPos]))
+							- (g.second.seqPos_ + g.second.size_)
+							<= chiOpts.overLapSizeCutoff_) {
+						continue;
+					}
+					alignerObj.profileAlignment(processedReads[pos],
+							processedReads[subPos], false, true, false,
+							g.second.startPos_ + g.second.size_);
+
+					if (chiOpts.chiOverlap_.passErrorProfile(alignerObj.comp_)) {
+						size_t gapPos = 0;
+						if (g.second.ref_) {
+							gapPos = getRealPosForAlnPos(
+									alignerObj.alignObjectB_.seqBase_.seq_, g.second.startPos_)
+									+ g.second.size_ - 1;
+							//processedReads[subPos].endChiPos.insert(
+							//		{ getRealPosForAlnPos(alignerObj.alignObjectB_.seqBase_.seq_,
+							//				g.second.startPos_) + g.second.size_ - 1, pos });
+						} else {
+							/**@todo something else should probably happen if this is 0 */
+							if (0
+									== getRealPosForAlnPos(
+											alignerObj.alignObjectB_.seqBase_.seq_,
+											g.second.startPos_)) {
 								gapPos = getRealPosForAlnPos(
-										alignerObj.alignObjectB_.seqBase_.seq_, g.second.startPos_)
-										+ g.second.size_ - 1;
+										alignerObj.alignObjectB_.seqBase_.seq_,
+										g.second.startPos_);
 								//processedReads[subPos].endChiPos.insert(
 								//		{ getRealPosForAlnPos(alignerObj.alignObjectB_.seqBase_.seq_,
-								//				g.second.startPos_) + g.second.size_ - 1, pos });
+								//				g.second.startPos_), pos });
 							} else {
-								/**@todo something else should probably happen if this is 0 */
-								if (0
-										== getRealPosForAlnPos(
-												alignerObj.alignObjectB_.seqBase_.seq_,
-												g.second.startPos_)) {
-									gapPos = getRealPosForAlnPos(
-											alignerObj.alignObjectB_.seqBase_.seq_,
-											g.second.startPos_);
-									//processedReads[subPos].endChiPos.insert(
-									//		{ getRealPosForAlnPos(alignerObj.alignObjectB_.seqBase_.seq_,
-									//				g.second.startPos_), pos });
-								} else {
-									gapPos = getRealPosForAlnPos(
-											alignerObj.alignObjectB_.seqBase_.seq_,
-											g.second.startPos_) - 1;
-									//processedReads[subPos].endChiPos.insert(
-									//		{ getRealPosForAlnPos(alignerObj.alignObjectB_.seqBase_.seq_,
-									//				g.second.startPos_) - 1, pos });
-								}
-							}
-							if (gapPos < endPos) {
-								endPos = gapPos;
+								gapPos = getRealPosForAlnPos(
+										alignerObj.alignObjectB_.seqBase_.seq_,
+										g.second.startPos_) - 1;
+								//processedReads[subPos].endChiPos.insert(
+								//		{ getRealPosForAlnPos(alignerObj.alignObjectB_.seqBase_.seq_,
+								//				g.second.startPos_) - 1, pos });
 							}
 						}
-						break;
+						if (gapPos < endPos) {
+							endPos = gapPos;
+						}
 					}
-				} // pass gaps size > 0
-				//check to see if we have an endPos
-				if (std::numeric_limits<size_t>::max() != endPos) {
-					endChiPos[endPos].emplace_back(pos);
-				}
-				//check to see if we have a frontPos
-				if (0 != frontPos) {
-					frontChiPos[frontPos].emplace_back(pos);
+					break;
 				}
-			} // pass has errors
-		} // pos loop
-
-		struct ChiParLocs {
-			ChiParLocs(size_t endReadMinReadPos, size_t endPosition,
-					size_t frontReadMinReadPos, size_t frontPosition) :
-					endReadMinReadPos_(endReadMinReadPos),
-					endPosition_(endPosition),
-					frontReadMinReadPos_(frontReadMinReadPos),
-					frontPosition_(frontPosition) {
-
+			} // pass gaps size > 0
+			//check to see if we have an endPos
+			if (std::numeric_limits<size_t>::max() != endPos) {
+				endChiPos[endPos].emplace_back(pos);
 			}
-			size_t endReadMinReadPos_;
-			size_t endPosition_;
-
-			size_t frontReadMinReadPos_;
-			size_t frontPosition_;
-
-		};
+			//check to see if we have a frontPos
+			if (0 != frontPos) {
+				frontChiPos[frontPos].emplace_back(pos);
+			}
+		} // pass has errors
+	}
 
-		if (!endChiPos.empty() && !frontChiPos.empty()) {
-			if (endChiPos.begin()->first < frontChiPos.rbegin()->first) {
-				std::vector<ChiParLocs> crossOvers;
-				for(const auto & endChi : endChiPos){
-					for(const auto & frontChi : iter::reversed(frontChiPos)){
-						if(endChi.first + chiOpts.posSpacing_ < frontChi.first){
-							for(const auto & endReadPos : endChi.second){
-								for(const auto & frontReadPos : frontChi.second){
-									if(endReadPos != frontReadPos){
-										crossOvers.emplace_back(ChiParLocs{
-											endReadPos, endChi.first,
-											frontReadPos, frontChi.first});
-									}
+	if (!endChiPos.empty() && !frontChiPos.empty()) {
+		if (endChiPos.begin()->first < frontChiPos.rbegin()->first) {
+			std::vector<ChiParLocs> crossOvers;
+			for(const auto & endChi : endChiPos){
+				for(const auto & frontChi : iter::reversed(frontChiPos)){
+					if(endChi.first + chiOpts.posSpacing_ < frontChi.first){
+						for(const auto & endReadPos : endChi.second){
+							for(const auto & frontReadPos : frontChi.second){
+								if(endReadPos != frontReadPos){
+									crossOvers.emplace_back(ChiParLocs{
+										endReadPos, endChi.first,
+										frontReadPos, frontChi.first});
 								}
 							}
 						}
 					}
-					if(!crossOvers.empty()){
-						break;
-					}
 				}
 				if(!crossOvers.empty()){
-					getSeqBase(processedReads[subPos]).markAsChimeric();
-					njh::sort(crossOvers, [](const ChiParLocs & p1, const ChiParLocs & p2){
-						if(p1.endReadMinReadPos_ == p2.endReadMinReadPos_){
-							return p1.frontReadMinReadPos_ < p2.frontReadMinReadPos_;
-						}else{
-							return p1.endReadMinReadPos_ < p2.endReadMinReadPos_;
-						}
-					});
-
-					ret.content_.emplace_back(
-							toVecStr(
-									getSeqBase(processedReads[subPos]).name_,
-									getSeqBase(processedReads[subPos]).cnt_,
-									getSeqBase(processedReads[crossOvers.front().frontReadMinReadPos_]).name_,
-									getSeqBase(processedReads[crossOvers.front().frontReadMinReadPos_]).cnt_,
-									getSeqBase(processedReads[crossOvers.front().frontReadMinReadPos_]).cnt_/getSeqBase(processedReads[subPos]).cnt_,
-									crossOvers.front().frontPosition_,
-									getSeqBase(processedReads[crossOvers.front().endReadMinReadPos_]).name_,
-									getSeqBase(processedReads[crossOvers.front().endReadMinReadPos_]).cnt_,
-									getSeqBase(processedReads[crossOvers.front().endReadMinReadPos_]).cnt_/getSeqBase(processedReads[subPos]).cnt_,
-									crossOvers.front().endPosition_));
+					break;
 				}
-			} // is chimeric loop
+			}
+			if(!crossOvers.empty()){
+				njh::sort(crossOvers, [](const ChiParLocs & p1, const ChiParLocs & p2){
+					if(p1.endReadMinReadPos_ == p2.endReadMinReadPos_){
+						return p1.frontReadMinReadPos_ < p2.frontReadMinReadPos_;
+					}else{
+						return p1.endReadMinReadPos_ < p2.endReadMinReadPos_;
+					}
+				});
+				crossOver = crossOvers.front();
+				return true;
+			}
+		} // is chimeric loop
+	}
+	return false;
+}
+
+template<typename READ>
+table collapser::markChimeras(std::vector<READ> &processedReads,
+		aligner &alignerObj, const ChimeraOpts & chiOpts) const {
+	return markChimeras(processedReads, alignerObj, chiOpts, 1);
+}
+
+template<typename READ>
+table collapser::markChimeras(std::vector<READ> &processedReads,
+		aligner &alignerObj, const ChimeraOpts & chiOpts, uint32_t numThreads) const {
+	table ret(VecStr { "read", "readCnt",
+		"parent1", "parent1Cnt", "parent1Ratio", "parent1SeqPos",
+		"parent2", "parent2Cnt", "parent2Ratio", "parent2SeqPos" });
+	//assumes clusters are coming in sorted by total count
+	if (processedReads.size() <= 2) {
+		return ret;
+	}
+	if (opts_.verboseOpts_.verbose_) {
+		std::cout << "Marking Chimeras" << std::endl;
+		std::cout << "Initial Pass" << std::endl;
+	}
+	std::vector<std::unordered_set<std::string>> parentKmers;
+	if (chiOpts.parentKmerPrefilterLen_ > 0) {
+		const size_t kLen = chiOpts.parentKmerPrefilterLen_;
+		//the last read is never a parent
+		for (const auto & pos : iter::range<size_t>(0, processedReads.size() - 1)) {
+			const auto & seq = getSeqBase(processedReads[pos]).seq_;
+			std::unordered_set<std::string> kmers;
+			for (size_t kPos = 0; kPos + kLen <= seq.size(); ++kPos) {
+				kmers.emplace(seq.substr(kPos, kLen));
+			}
+			parentKmers.emplace_back(std::move(kmers));
 		}
-	} // subPos loop
+	}
+	//subPos is the position of the clusters to investigate for being possibly chimeric
+	//the reads aren't changed while looking for cross overs so each one can be checked independently,
+	//the marking is done afterwards in order so the names in the table are the same as checking them one after the other
+	const uint32_t numberOfCandidates = processedReads.size() - 2;
+	std::vector<char> isChimeric(numberOfCandidates, 0);
+	std::vector<ChiParLocs> crossOvers(numberOfCandidates, ChiParLocs { 0, 0, 0, 0 });
+	uint32_t threadsToUse = std::max<uint32_t>(1, numThreads);
+	if (1 == threadsToUse) {
+		for (const auto & subPos : iter::range<size_t>(2, processedReads.size())) {
+			if (opts_.verboseOpts_.verbose_) {
+				std::cout << subPos << ":" << processedReads.size() << "\r";
+				std::cout.flush();
+			}
+			isChimeric[subPos - 2] = findChimeraCrossOver(processedReads, subPos,
+					alignerObj, chiOpts, parentKmers, crossOvers[subPos - 2]);
+		}
+	} else {
+		std::vector<uint32_t> positions(numberOfCandidates);
+		njh::iota<uint32_t>(positions, 0);
+		njh::concurrent::LockableQueue<uint32_t> posQueue(positions);
+		concurrent::AlignerPool alnPool(alignerObj, threadsToUse);
+		alnPool.initAligners();
+		auto checkCandidates = [this, &processedReads, &chiOpts, &parentKmers,
+				&isChimeric, &crossOvers, &posQueue, &alnPool]() {
+			auto currentAligner = alnPool.popAligner();
+			uint32_t pos = 0;
+			while (posQueue.getVal(pos)) {
+				isChimeric[pos] = findChimeraCrossOver(processedReads, pos + 2,
+						*currentAligner, chiOpts, parentKmers, crossOvers[pos]);
+			}
+		};
+		std::vector<std::thread> threads;
+		for (uint32_t t = 0; t < threadsToUse; ++t) {
+			threads.emplace_back(checkCandidates);
+		}
+		njh::concurrent::joinAllJoinableThreads(threads);
+		alnPool.mergeAlnCachesInto(alignerObj);
+	}
+	for (const auto & subPos : iter::range<size_t>(2, processedReads.size())) {
+		if (!isChimeric[subPos - 2]) {
+			continue;
+		}
+		const auto & crossOver = crossOvers[subPos - 2];
+		getSeqBase(processedReads[subPos]).markAsChimeric();
+		ret.content_.emplace_back(
+				toVecStr(
+						getSeqBase(processedReads[subPos]).name_,
+						getSeqBase(processedReads[subPos]).cnt_,
+						getSeqBase(processedReads[crossOver.frontReadMinReadPos_]).name_,
+						getSeqBase(processedReads[crossOver.frontReadMinReadPos_]).cnt_,
+						getSeqBase(processedReads[crossOver.frontReadMinReadPos_]).cnt_/getSeqBase(processedReads[subPos]).cnt_,
+						crossOver.frontPosition_,
+						getSeqBase(processedReads[crossOver.endReadMinReadPos_]).name_,
+						getSeqBase(processedReads[crossOver.endReadMinReadPos_]).cnt_,
+						getSeqBase(processedReads[crossOver.endReadMinReadPos_]).cnt_/getSeqBase(processedReads[subPos]).cnt_,
+						crossOver.endPosition_));
+	}
 	if (opts_.verboseOpts_.verbose_) {
 		std::cout << std::endl;
 	}
@@ -798,4 +920,3 @@ table collapser::markChimeras(std::vector<READ> &processedReads,
 }
 
 }  // namespace njhseq
-
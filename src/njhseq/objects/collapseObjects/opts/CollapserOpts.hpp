@@ -38,6 +38,7 @@ struct ChimeraOpts {
 	bool keepLowQaulityMismatches_ = false;
 
 	uint32_t posSpacing_ = 3;
+	uint32_t parentKmerPrefilterLen_ = 0; /**< if not 0, possible parents sharing no kmers of this length with either half of a read aren't aligned to it, faster but a parent overlapping by only a few bases can be missed */
 };
 
 
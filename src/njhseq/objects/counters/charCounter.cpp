@@ -24,6 +24,8 @@
 // along with njhseq.  If not, see <http://www.gnu.org/licenses/>.
 //
 #include "charCounter.hpp"
+#include "njhseq/helpers/SeqKernels.hpp"
+#include "njhseq/objects/seqObjects/BaseObjects/QualityScores.hpp"
 
 namespace njhseq {
 
@@ -45,7 +47,7 @@ Json::Value charCounter::toJson() const {
 
 	auto & allQuals = ret["allQualities_"];
 	for (auto let : alphabet_) {
-		allQuals[std::string(1, let)] = njh::json::toJson(allQualities_[let]);
+		allQuals[std::string(1, let)] = njh::json::toJson(QualityScores::toUInt32(allQualities_[let]));
 	}
 	ret["allowNewChars_"] = njh::json::toJson(allowNewChars_);
 	ret["alphabet_"] = njh::json::toJson(alphabet_);
@@ -280,26 +282,37 @@ void charCounter::increaseCountOfBase(const char &base, double cnt) {
 	chars_[base] += cnt;
 }
 void charCounter::increaseCountByString(const std::string &seq) {
-	for (const auto & c : seq) {
-		chars_[c] += 1;
+	std::array<uint32_t, 256> counts { };
+	SeqKernels::countBases(seq, counts);
+	for (const auto c : iter::range(chars_.size())) {
+		chars_[c] += counts[c];
 	}
 }
 void charCounter::increaseCountByString(const std::string &seq, double cnt) {
-	for (const auto & c : seq) {
-		chars_[c] += cnt;
+	if (cnt >= 0 && std::floor(cnt) == cnt) {
+		//adding a whole number count once per base is the same as adding it times the number of bases
+		std::array<uint32_t, 256> counts { };
+		SeqKernels::countBases(seq, counts);
+		for (const auto c : iter::range(chars_.size())) {
+			chars_[c] += counts[c] * cnt;
+		}
+	} else {
+		for (const auto & c : seq) {
+			chars_[c] += cnt;
+		}
 	}
 }
 
 void charCounter::increaseCountOfBaseQual(const char &base, uint32_t qual) {
 	chars_[base] += 1;
 	qualities_[base] += qual;
-	allQualities_[base].emplace_back(qual);
+	allQualities_[base].emplace_back(QualityScores::toStored(qual));
 }
 void charCounter::increaseCountOfBaseQual(const char &base, uint32_t qual,
 		double cnt) {
 	chars_[base] += cnt;
 	qualities_[base] += qual * cnt;
-	addOtherVec(allQualities_[base], std::vector<uint32_t>(cnt, qual));
+	allQualities_[base].insert(allQualities_[base].end(), static_cast<size_t>(cnt), QualityScores::toStored(qual));
 }
 
 void charCounter::increaseCountByStringQual(const std::string &seq,
@@ -307,7 +320,7 @@ void charCounter::increaseCountByStringQual(const std::string &seq,
 	for (const auto & pos : iter::range(seq.size())) {
 		chars_[seq[pos]] += 1;
 		qualities_[seq[pos]] += qualities[pos];
-		allQualities_[seq[pos]].emplace_back(qualities[pos]);
+		allQualities_[seq[pos]].emplace_back(QualityScores::toStored(qualities[pos]));
 	}
 }
 void charCounter::increaseCountByStringQual(const std::string &seq,
@@ -315,8 +328,8 @@ void charCounter::increaseCountByStringQual(const std::string &seq,
 	for (const auto & pos : iter::range(seq.size())) {
 		chars_[seq[pos]] += cnt;
 		qualities_[seq[pos]] += qualities[pos] * cnt;
-		addOtherVec(allQualities_[seq[pos]],
-				std::vector<uint32_t>(cnt, qualities[pos]));
+		allQualities_[seq[pos]].insert(allQualities_[seq[pos]].end(), static_cast<size_t>(cnt),
+				QualityScores::toStored(qualities[pos]));
 	}
 }
 
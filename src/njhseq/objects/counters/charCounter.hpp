@@ -45,7 +45,7 @@ public:
   std::array<double, 127> fractions_;
 
   std::array<uint32_t, 127> qualities_;
-  std::array<std::vector<uint32_t>, 127> allQualities_;
+  std::array<std::vector<uint8_t>, 127> allQualities_; /**< every quality added, one byte each like seqInfo::qual_ */
   bool allowNewChars_ = true;
   //
   std::vector<char> alphabet_;
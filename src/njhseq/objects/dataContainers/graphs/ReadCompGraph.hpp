@@ -33,6 +33,7 @@
 #include "njhseq/seqToolsUtils/RefDetermination/BestRefDetector.hpp"
 #include "njhseq/objects/Meta/MultipleGroupMetaData.hpp"
 #include "njhseq/concurrency/pools/AlignerPool.hpp"
+#include "njhseq/seqToolsUtils/AlignerDistCalc.hpp"
 
 
 
@@ -63,6 +64,24 @@ public:
 		}
 	}
 
+	/**@brief Construct with a sparse distance matrix, only the pairs in distances will get edges
+	 *
+	 * @param distances the sparse distances, row_ and col_ are positions in reads
+	 * @param reads the reads the distance graph is describing
+	 */
+	template<typename T>
+	ReadCompGraph(const std::vector<SparseDistance<comparison>> & distances,
+			const std::vector<T> & reads) {
+		for (const auto & pos : iter::range(reads.size())) {
+			this->addNode(getSeqBase(reads[pos]).name_,
+					std::make_shared<seqInfo>(getSeqBase(reads[pos])));
+		}
+		for (const auto & dist : distances) {
+			this->addEdge(getSeqBase(reads[dist.row_]).name_,
+					getSeqBase(reads[dist.col_]).name_, dist.dist_);
+		}
+	}
+
 	/**@brief Construct with just reads for the edges to be added latter
 	 *
 	 * @param reads the sequences to add, a copy of the seqBases will be copied and used
@@ -169,40 +188,98 @@ public:
 
 };
 
+/**@brief Generate a comparison graph between all reads, each thread gets an aligner from alnPool for the whole run
+ *
+ * @param reads the reads to compare
+ * @param alnPool the pool of aligners, should already be initialized
+ * @param numThreads number of threads to use
+ * @return a graph with an edge between every read
+ */
 template<typename T>
 ReadCompGraph genReadComparisonGraph(const std::vector<T> & reads,
-		aligner & alignerObj,
-		std::unordered_map<std::string, std::unique_ptr<aligner>>& aligners,
-		std::mutex & alignerLock, uint32_t numThreads) {
-	std::function<
-			comparison(const T &, const T &,
-					std::unordered_map<std::string, std::unique_ptr<aligner>>&, aligner&)> getMismatchesFunc =
-			[&alignerLock](const T & read1, const T & read2,
-					std::unordered_map<std::string, std::unique_ptr<aligner>>& aligners,
-					aligner &alignerObj) {
-				alignerLock.lock();
-				auto threadId = estd::to_string(std::this_thread::get_id());
-				//std::cout << threadId<< std::endl;
-				if(aligners.find(threadId) == aligners.end()) {
-					aligners.emplace(threadId, std::make_unique<aligner>(alignerObj));
-				}
-				alignerLock.unlock();
-				aligners.at(threadId)->alignCache(getSeqBase(read1),getSeqBase(read2), false);
-				aligners.at(threadId)->profilePrimerAlignment(getSeqBase(read1), getSeqBase(read2));
-				return aligners.at(threadId)->comp_;
+		concurrent::AlignerPool & alnPool, uint32_t numThreads) {
+	std::function<comparison(const T &, const T &, aligner &)> getCompFunc =
+			[](const T & read1, const T & read2, aligner & alignerObj) {
+				alignerObj.alignCache(getSeqBase(read1),getSeqBase(read2), false);
+				alignerObj.profilePrimerAlignment(getSeqBase(read1), getSeqBase(read2));
+				return alignerObj.comp_;
+			};
+	auto distances = getDistanceWithAlignerPool(reads, alnPool, numThreads, getCompFunc);
+	return ReadCompGraph(distances, reads);
+}
+
+/**@brief Generate a comparison graph between reads, each thread gets it's own copy of alignerObj and the alignment caches are merged back into alignerObj at the end
+ *
+ * @param reads the reads to compare
+ * @param alignerObj the aligner to copy per thread
+ * @param numThreads number of threads to use
+ * @param sparsePars if not null only the pairs passing this kmer candidate filter are aligned and given an edge, otherwise every pair is
+ * @return a graph with an edge between every read, or between every candidate pair when sparsePars is given
+ */
+template<typename T>
+ReadCompGraph genReadComparisonGraph(const std::vector<T> & reads,
+		aligner & alignerObj, uint32_t numThreads,
+		const KmerCandidatePairIndex::Pars * sparsePars = nullptr) {
+	std::function<comparison(const T &, const T &, aligner &)> getCompFunc =
+			[](const T & read1, const T & read2, aligner & alignerObj) {
+				alignerObj.alignCache(getSeqBase(read1),getSeqBase(read2), false);
+				alignerObj.profilePrimerAlignment(getSeqBase(read1), getSeqBase(read2));
+				return alignerObj.comp_;
+			};
+	if (nullptr != sparsePars) {
+		uint32_t threadsToUse = std::max<uint32_t>(1, numThreads);
+		concurrent::AlignerPool alnPool(alignerObj, threadsToUse);
+		alnPool.initAligners();
+		std::function<bool(const comparison &)> keepAll = [](const comparison &) {
+			return true;
+		};
+		auto distances = getSparseDistanceWithAlignerPool(reads, alnPool,
+				threadsToUse, *sparsePars, getCompFunc, keepAll);
+		alnPool.mergeAlnCachesInto(alignerObj);
+		return ReadCompGraph(distances, reads);
+	}
+	auto distances = getDistanceWithAligner(reads, alignerObj, numThreads, getCompFunc);
+	return ReadCompGraph(distances, reads);
+}
+
+/**@brief Generate a comparison graph with edges only between reads that could be within the edit limits of candidatePars
+ *
+ * Pairs are pre-filtered with a kmer index so only candidate pairs are aligned, edges are only added when keepFunc is true,
+ * memory scales with the number of edges rather than all pairs
+ *
+ * @param reads the reads to compare
+ * @param alnPool the pool of aligners, should already be initialized
+ * @param numThreads number of threads to use
+ * @param candidatePars the kmer filter parameters, pairs within candidatePars.maxEdits_ edits (or minIdentity_) are guaranteed to be aligned
+ * @param keepFunc whether to add an edge for a computed comparison
+ * @return a graph with edges only between the kept pairs
+ */
+template<typename T>
+ReadCompGraph genSparseReadComparisonGraph(const std::vector<T> & reads,
+		concurrent::AlignerPool & alnPool, uint32_t numThreads,
+		const KmerCandidatePairIndex::Pars & candidatePars,
+		const std::function<bool(const comparison &)> & keepFunc) {
+	std::function<comparison(const T &, const T &, aligner &)> getCompFunc =
+			[](const T & read1, const T & read2, aligner & alignerObj) {
+				alignerObj.alignCache(getSeqBase(read1),getSeqBase(read2), false);
+				alignerObj.profilePrimerAlignment(getSeqBase(read1), getSeqBase(read2));
+				return alignerObj.comp_;
 			};
-	auto distances = getDistanceNonConst(reads, numThreads, getMismatchesFunc,
-			aligners, alignerObj);
+	auto distances = getSparseDistanceWithAlignerPool(reads, alnPool, numThreads,
+			candidatePars, getCompFunc, keepFunc);
 	return ReadCompGraph(distances, reads);
 }
 
+/**@brief Older interface kept so existing callers still compile, the aligner map and lock are not used, per thread aligners now come from an AlignerPool
+ *
+ */
 template<typename T>
+[[deprecated("the aligner map and lock are unused, call genReadComparisonGraph(reads, alignerObj, numThreads)")]]
 ReadCompGraph genReadComparisonGraph(const std::vector<T> & reads,
-		aligner & alignerObj, uint32_t numThreads) {
-	std::unordered_map<std::string, std::unique_ptr<aligner>> aligners;
-	std::mutex alignerLock;
-	return genReadComparisonGraph(reads, alignerObj, aligners, alignerLock,
-			numThreads);
+		aligner & alignerObj,
+		std::unordered_map<std::string, std::unique_ptr<aligner>>& /*aligners*/,
+		std::mutex & /*alignerLock*/, uint32_t numThreads) {
+	return genReadComparisonGraph(reads, alignerObj, numThreads);
 }
 
 }  // namespace njhseq
@@ -90,6 +90,24 @@ public:
 	  }
 	}
 
+	/**@brief Construct with a sparse distance matrix, only the pairs in distances will get edges
+	 *
+	 * @param distances the sparse distances, row_ and col_ are positions in reads
+	 * @param reads the reads the distance graph is describing
+	 */
+	template<typename T>
+	readDistGraph(const std::vector<SparseDistance<DIST>> & distances,
+			const std::vector<T> & reads) {
+		for (const auto & pos : iter::range(reads.size())) {
+			this->addNode(getSeqBase(reads[pos]).name_,
+					std::make_shared<seqInfo>(getSeqBase(reads[pos])));
+		}
+		for (const auto & dist : distances) {
+			this->addEdge(getSeqBase(reads[dist.row_]).name_,
+					getSeqBase(reads[dist.col_]).name_, dist.dist_);
+		}
+	}
+
 	/**@brief  Construct with just a vector of reads for edges to be added latter
 	 *
 	 * @param reads the seqsuences to construct with
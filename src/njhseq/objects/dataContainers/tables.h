@@ -28,7 +28,11 @@
 
 
 #include "njhseq/objects/dataContainers/tables/table.hpp"
+#include "njhseq/objects/dataContainers/tables/ColumnarTable.hpp"
 #include "njhseq/objects/dataContainers/tables/MasterTableCache.hpp"
 #include "njhseq/objects/dataContainers/tables/MasterTableStaticCache.hpp"
 #include "njhseq/objects/dataContainers/tables/TableCache.hpp"
+#include "njhseq/objects/dataContainers/tables/DelimitedTextParser.hpp"
 #include "njhseq/objects/dataContainers/tables/TableReader.hpp"
+#include "njhseq/objects/dataContainers/tables/StreamingTableAggregator.hpp"
+#include "njhseq/objects/dataContainers/tables/TableJoiner.hpp"
@@ -0,0 +1,546 @@
+/*
+ * ColumnarTable.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: nick
+ */
+//
+// njhseq - A library for analyzing sequence data
+// Copyright (C) 2012-2018 Nicholas Hathaway <nicholas.hathaway@umassmed.edu>,
+//
+// This file is part of njhseq.
+//
+// njhseq is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// njhseq is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with njhseq.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "ColumnarTable.hpp"
+#include "njhseq/IO/InputStream.hpp"
+#include "njhseq/IO/OutputStream.hpp"
+#include "njhseq/objects/dataContainers/tables/DelimitedTextParser.hpp"
+
+namespace njhseq {
+
+std::string ColumnarTable::getColumnTypeStr(ColumnType type) {
+	switch (type) {
+	case ColumnType::INT:
+		return "int";
+		break;
+	case ColumnType::DOUBLE:
+		return "double";
+		break;
+	case ColumnType::STRING:
+		return "string";
+		break;
+	default:
+		break;
+	}
+	return "string";
+}
+
+ColumnarTable::Column::Column(const std::string & name) :
+		name_(name) {
+}
+
+uint32_t ColumnarTable::Column::intern(const std::string & val) {
+	auto search = levelToCode_.find(val);
+	if (levelToCode_.end() != search) {
+		return search->second;
+	}
+	uint32_t code = levels_.size();
+	levels_.emplace_back(val);
+	levelToCode_.emplace(val, code);
+	return code;
+}
+
+void ColumnarTable::Column::addValue(const std::string & val) {
+	codes_.emplace_back(intern(val));
+}
+
+const std::string & ColumnarTable::Column::getValue(uint32_t rowPos) const {
+	return levels_[codes_[rowPos]];
+}
+
+ColumnarTable::ColumnType ColumnarTable::Column::inferType() const {
+	if (levels_.empty()) {
+		return ColumnType::STRING;
+	}
+	bool allInts = true;
+	for (const auto & level : levels_) {
+		if (allInts && isIntStr(level)) {
+			continue;
+		}
+		allInts = false;
+		if (!isDoubleStr(level)) {
+			return ColumnType::STRING;
+		}
+	}
+	return allInts ? ColumnType::INT : ColumnType::DOUBLE;
+}
+
+std::vector<uint32_t> ColumnarTable::Column::genLevelRanks() const {
+	std::vector<uint32_t> levelOrder(levels_.size());
+	njh::iota<uint32_t>(levelOrder, 0);
+	//each level is only parsed once here rather than on every comparison while sorting the rows
+	switch (inferType()) {
+	case ColumnType::INT: {
+		std::vector<int64_t> vals;
+		vals.reserve(levels_.size());
+		for (const auto & level : levels_) {
+			vals.emplace_back(std::stoll(level));
+		}
+		std::sort(levelOrder.begin(), levelOrder.end(),
+				[&vals, this](uint32_t level1, uint32_t level2) {
+					if (vals[level1] == vals[level2]) {
+						return levels_[level1] < levels_[level2];
+					}
+					return vals[level1] < vals[level2];
+				});
+		break;
+	}
+	case ColumnType::DOUBLE: {
+		std::vector<double> vals;
+		vals.reserve(levels_.size());
+		for (const auto & level : levels_) {
+			vals.emplace_back(std::stod(level));
+		}
+		std::sort(levelOrder.begin(), levelOrder.end(),
+				[&vals, this](uint32_t level1, uint32_t level2) {
+					if (vals[level1] == vals[level2]) {
+						return levels_[level1] < levels_[level2];
+					}
+					return vals[level1] < vals[level2];
+				});
+		break;
+	}
+	case ColumnType::STRING:
+	default:
+		std::sort(levelOrder.begin(), levelOrder.end(),
+				[this](uint32_t level1, uint32_t level2) {
+					return levels_[level1] < levels_[level2];
+				});
+		break;
+	}
+	std::vector<uint32_t> ranks(levels_.size());
+	for (const auto rank : iter::range<uint32_t>(levelOrder.size())) {
+		ranks[levelOrder[rank]] = rank;
+	}
+	return ranks;
+}
+
+ColumnarTable::ColumnarTable() = default;
+
+ColumnarTable::ColumnarTable(const VecStr & columnNames) :
+		hasHeader_(true) {
+	for (const auto & colName : columnNames) {
+		columns_.emplace_back(colName);
+	}
+	namedColumns_ = columns_.size();
+	setColNamePositions();
+}
+
+ColumnarTable::ColumnarTable(const table & tab) :
+		ColumnarTable(tab.columnNames_) {
+	hasHeader_ = tab.hasHeader_;
+	for (const auto & row : tab.content_) {
+		addRow(row);
+	}
+}
+
+ColumnarTable::ColumnarTable(const TableIOOpts & opts, uint32_t numThreads) {
+	InputStream in(opts.in_);
+	populateTable(in, opts.inDelim_, opts.hasHeader_, numThreads);
+}
+
+void ColumnarTable::setColNamePositions() {
+	colNameToPos_.clear();
+	for (const auto pos : iter::range<uint32_t>(namedColumns_)) {
+		colNameToPos_[columns_[pos].name_] = pos;
+	}
+}
+
+void ColumnarTable::populateTable(std::istream & in, const std::string & inDelim,
+		bool header, uint32_t numThreads) {
+	std::string delim = inDelim;
+	if ("tab" == delim) {
+		delim = "\t";
+	}
+	hasHeader_ = header;
+	columns_.clear();
+	namedColumns_ = 0;
+	nRow_ = 0;
+	bool firstLine = true;
+	auto addToks = [this, &firstLine, &header](const VecStr & toks) {
+		if (firstLine) {
+			firstLine = false;
+			if (header) {
+				for (const auto & tok : toks) {
+					columns_.emplace_back(tok);
+				}
+				namedColumns_ = columns_.size();
+				setColNamePositions();
+				return;
+			}
+			for (const auto i : iter::range(toks.size())) {
+				columns_.emplace_back("col." + leftPadNumStr(i, toks.size()));
+			}
+			namedColumns_ = columns_.size();
+			setColNamePositions();
+		}
+		addRow(toks);
+	};
+	if (numThreads > 1) {
+		//tokenizing is done in parallel a batch of blocks at a time, interning stays on this thread to keep the row order
+		DelimitedTextParser::Pars parserPars;
+		parserPars.numThreads_ = numThreads;
+		DelimitedTextParser parser(in, delim, parserPars);
+		std::vector<VecStr> rows;
+		while (parser.getNextRows(rows)) {
+			for (const auto & row : rows) {
+				addToks(row);
+			}
+			rows.clear();
+		}
+	} else {
+		std::string currentLine = "";
+		while (njh::files::crossPlatGetline(in, currentLine)) {
+			addToks(tokenizeString(currentLine, delim, true));
+		}
+	}
+}
+
+void ColumnarTable::addRow(const VecStr & row) {
+	//long rows add unnamed columns with the earlier rows padded, the same as table::addPaddingToEndOfRows
+	while (row.size() > columns_.size()) {
+		columns_.emplace_back("");
+		for (uint32_t rowPos = 0; rowPos < nRow_; ++rowPos) {
+			columns_.back().addValue("");
+		}
+	}
+	//short rows are padded with empty values the same as table
+	for (const auto colPos : iter::range(columns_.size())) {
+		columns_[colPos].addValue(colPos < row.size() ? row[colPos] : "");
+	}
+	++nRow_;
+}
+
+table ColumnarTable::toTable() const {
+	table ret(getColumnNames());
+	ret.hasHeader_ = hasHeader_;
+	ret.content_.reserve(nRow_);
+	for (const auto rowPos : iter::range(nRow_)) {
+		VecStr row;
+		row.reserve(columns_.size());
+		for (const auto & col : columns_) {
+			row.emplace_back(col.getValue(rowPos));
+		}
+		ret.content_.emplace_back(std::move(row));
+	}
+	return ret;
+}
+
+uint32_t ColumnarTable::nCol() const {
+	return namedColumns_;
+}
+
+uint32_t ColumnarTable::nRow() const {
+	return nRow_;
+}
+
+bool ColumnarTable::empty() const {
+	return 0 == nRow_;
+}
+
+VecStr ColumnarTable::getColumnNames() const {
+	VecStr ret;
+	for (const auto pos : iter::range(namedColumns_)) {
+		ret.emplace_back(columns_[pos].name_);
+	}
+	return ret;
+}
+
+uint32_t ColumnarTable::getColPos(const std::string & colName) const {
+	auto search = colNameToPos_.find(colName);
+	if (colNameToPos_.end() == search) {
+		std::stringstream ss;
+		ss << __PRETTY_FUNCTION__ << ", error " << "no column named " << colName << "\n";
+		ss << "options are: " << njh::conToStr(getColumnNames(), ", ") << "\n";
+		throw std::runtime_error { ss.str() };
+	}
+	return search->second;
+}
+
+bool ColumnarTable::containsColumn(const std::string & colName) const {
+	return njh::in(colName, colNameToPos_);
+}
+
+void ColumnarTable::checkForColumnsThrow(const VecStr & requiredColumns,
+		const std::string & funcName) const {
+	VecStr missing;
+	for (const auto & col : requiredColumns) {
+		if (!containsColumn(col)) {
+			missing.emplace_back(col);
+		}
+	}
+	if (!missing.empty()) {
+		std::stringstream ss;
+		ss << funcName << ", error table is missing the following columns: "
+				<< njh::conToStr(missing, ", ") << "\n";
+		ss << "options are: " << njh::conToStr(getColumnNames(), ", ") << "\n";
+		throw std::runtime_error { ss.str() };
+	}
+}
+
+const ColumnarTable::Column & ColumnarTable::getColumn(const std::string & colName) const {
+	return columns_[getColPos(colName)];
+}
+
+VecStr ColumnarTable::getColumnValues(const std::string & colName) const {
+	const auto & col = getColumn(colName);
+	VecStr ret;
+	ret.reserve(nRow_);
+	for (const auto code : col.codes_) {
+		ret.emplace_back(col.levels_[code]);
+	}
+	return ret;
+}
+
+ColumnarTable::ColumnType ColumnarTable::getColumnType(const std::string & colName) const {
+	return getColumn(colName).inferType();
+}
+
+void ColumnarTable::sortTable(const VecStr & byColumns, bool decending) {
+	checkForColumnsThrow(byColumns, __PRETTY_FUNCTION__);
+	//sort on the ranks of the values, so only integer comparisons are done per row
+	std::vector<const std::vector<uint32_t> *> colCodes;
+	std::vector<std::vector<uint32_t>> colRanks;
+	for (const auto & colName : byColumns) {
+		const auto & col = getColumn(colName);
+		colCodes.emplace_back(&col.codes_);
+		colRanks.emplace_back(col.genLevelRanks());
+	}
+	std::vector<uint32_t> order(nRow_);
+	njh::iota<uint32_t>(order, 0);
+	std::stable_sort(order.begin(), order.end(),
+			[&colCodes, &colRanks, decending](uint32_t row1, uint32_t row2) {
+				for (const auto colPos : iter::range(colCodes.size())) {
+					uint32_t rank1 = colRanks[colPos][(*colCodes[colPos])[row1]];
+					uint32_t rank2 = colRanks[colPos][(*colCodes[colPos])[row2]];
+					if (rank1 != rank2) {
+						return decending ? rank1 > rank2 : rank1 < rank2;
+					}
+				}
+				return false;
+			});
+	for (auto & col : columns_) {
+		std::vector<uint32_t> sortedCodes;
+		sortedCodes.reserve(nRow_);
+		for (const auto rowPos : order) {
+			sortedCodes.emplace_back(col.codes_[rowPos]);
+		}
+		col.codes_ = std::move(sortedCodes);
+	}
+}
+
+void ColumnarTable::sortTable(const std::string & byThisColumn, bool decending) {
+	if (!containsColumn(byThisColumn)) {
+		std::cerr << "Table does not contain " << byThisColumn
+				<< " not sorting table" << "\n";
+		std::cerr << "options are: " << vectorToString(getColumnNames(), ",") << "\n";
+		return;
+	}
+	sortTable(VecStr { byThisColumn }, decending);
+}
+
+std::vector<uint32_t> ColumnarTable::getRowPositions(const std::string & forColumn,
+		const std::string & element) const {
+	const auto & col = getColumn(forColumn);
+	std::vector<uint32_t> ret;
+	auto search = col.levelToCode_.find(element);
+	if (col.levelToCode_.end() == search) {
+		return ret;
+	}
+	const uint32_t code = search->second;
+	for (const auto rowPos : iter::range(nRow_)) {
+		if (code == col.codes_[rowPos]) {
+			ret.emplace_back(rowPos);
+		}
+	}
+	return ret;
+}
+
+std::vector<uint32_t> ColumnarTable::getRowPositionsByValue(const std::string & forColumn,
+		const std::function<bool(const std::string &)> & pred) const {
+	const auto & col = getColumn(forColumn);
+	std::vector<bool> levelPasses;
+	levelPasses.reserve(col.levels_.size());
+	for (const auto & level : col.levels_) {
+		levelPasses.emplace_back(pred(level));
+	}
+	std::vector<uint32_t> ret;
+	for (const auto rowPos : iter::range(nRow_)) {
+		if (levelPasses[col.codes_[rowPos]]) {
+			ret.emplace_back(rowPos);
+		}
+	}
+	return ret;
+}
+
+std::vector<uint32_t> ColumnarTable::getRowPositionsByNumber(const std::string & forColumn,
+		const std::function<bool(double)> & pred) const {
+	const auto & col = getColumn(forColumn);
+	if (ColumnType::STRING == col.inferType()) {
+		std::stringstream ss;
+		ss << __PRETTY_FUNCTION__ << ", error " << "column " << forColumn << " isn't numeric" << "\n";
+		throw std::runtime_error { ss.str() };
+	}
+	return getRowPositionsByValue(forColumn, [&pred](const std::string & level) {
+		return pred(std::stod(level));
+	});
+}
+
+ColumnarTable ColumnarTable::getRows(const std::string & forColumn,
+		const std::string & element) const {
+	return getRows(getRowPositions(forColumn, element));
+}
+
+ColumnarTable ColumnarTable::getRows(const std::vector<uint32_t> & rowPositions) const {
+	ColumnarTable ret;
+	ret.hasHeader_ = hasHeader_;
+	ret.namedColumns_ = namedColumns_;
+	ret.colNameToPos_ = colNameToPos_;
+	for (const auto & col : columns_) {
+		//the levels are shared as is, some may go unused in the subset
+		Column subCol(col.name_);
+		subCol.levels_ = col.levels_;
+		subCol.levelToCode_ = col.levelToCode_;
+		subCol.codes_.reserve(rowPositions.size());
+		for (const auto rowPos : rowPositions) {
+			if (rowPos >= nRow_) {
+				std::stringstream ss;
+				ss << __PRETTY_FUNCTION__ << ", error " << "row position " << rowPos
+						<< " out of range, number of rows: " << nRow_ << "\n";
+				throw std::out_of_range { ss.str() };
+			}
+			subCol.codes_.emplace_back(col.codes_[rowPos]);
+		}
+		ret.columns_.emplace_back(std::move(subCol));
+	}
+	ret.nRow_ = rowPositions.size();
+	return ret;
+}
+
+ColumnarTable ColumnarTable::getColumns(const VecStr & columnNames) const {
+	checkForColumnsThrow(columnNames, __PRETTY_FUNCTION__);
+	ColumnarTable ret;
+	ret.hasHeader_ = hasHeader_;
+	for (const auto & colName : columnNames) {
+		ret.columns_.emplace_back(getColumn(colName));
+	}
+	ret.namedColumns_ = ret.columns_.size();
+	ret.nRow_ = nRow_;
+	ret.setColNamePositions();
+	return ret;
+}
+
+ColumnarTable ColumnarTable::getUniqueRows() const {
+	//rows are hashed on their codes, rows in the same bucket are then compared code by code
+	std::unordered_map<uint64_t, std::vector<uint32_t>> keptByHash;
+	std::vector<uint32_t> kept;
+	for (const auto rowPos : iter::range(nRow_)) {
+		uint64_t hash = 0;
+		for (const auto & col : columns_) {
+			hash ^= std::hash<uint32_t>()(col.codes_[rowPos]) + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+		}
+		auto & bucket = keptByHash[hash];
+		bool found = false;
+		for (const auto otherRowPos : bucket) {
+			bool same = true;
+			for (const auto & col : columns_) {
+				if (col.codes_[rowPos] != col.codes_[otherRowPos]) {
+					same = false;
+					break;
+				}
+			}
+			if (same) {
+				found = true;
+				break;
+			}
+		}
+		if (!found) {
+			bucket.emplace_back(rowPos);
+			kept.emplace_back(rowPos);
+		}
+	}
+	return getRows(kept);
+}
+
+void ColumnarTable::outPutContents(TableIOOpts options) const {
+	if ("tab" == options.outDelim_) {
+		options.outDelim_ = "\t";
+	} else if ("whitespace" == options.outDelim_) {
+		options.outDelim_ = " ";
+	}
+	if (options.outOrganized_) {
+		//organized output needs the column widths so just use table's
+		auto tab = toTable();
+		if ("" == options.out_.outFilename_) {
+			tab.outPutContentOrganized(std::cout);
+		} else {
+			tab.outPutContents(options);
+		}
+		return;
+	}
+	if ("" == options.out_.outFilename_) {
+		outPutContents(std::cout, options.outDelim_);
+	} else {
+		bool writeHeader = hasHeader_ && !(bfs::exists(options.out_.outName()) && options.out_.append_);
+		OutputStream outFile(options.out_);
+		if (writeHeader) {
+			outFile << vectorToString(getColumnNames(), options.outDelim_) << "\n";
+		}
+		outPutRows(outFile, options.outDelim_);
+		outFile.flush();
+	}
+}
+
+void ColumnarTable::outPutContents(std::ostream & out, std::string delim) const {
+	if ("tab" == delim) {
+		delim = "\t";
+	} else if ("whitespace" == delim) {
+		delim = " ";
+	}
+	if (hasHeader_) {
+		out << vectorToString(getColumnNames(), delim) << "\n";
+	}
+	outPutRows(out, delim);
+}
+
+void ColumnarTable::outPutRows(std::ostream & out, const std::string & delim) const {
+	for (const auto rowPos : iter::range(nRow_)) {
+		for (const auto colPos : iter::range(columns_.size())) {
+			if (colPos > 0) {
+				out << delim;
+			}
+			out << columns_[colPos].getValue(rowPos);
+		}
+		out << "\n";
+	}
+}
+
+bool ColumnarTable::inputIsLarge(const TableIOOpts & opts, uintmax_t sizeCutOff) {
+	return "" != opts.in_.inFilename_ && bfs::exists(opts.in_.inFilename_)
+			&& bfs::is_regular_file(opts.in_.inFilename_)
+			&& bfs::file_size(opts.in_.inFilename_) >= sizeCutOff;
+}
+
+}  // namespace njhseq
@@ -0,0 +1,163 @@
+#pragma once
+/*
+ * ColumnarTable.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: nick
+ */
+//
+// njhseq - A library for analyzing sequence data
+// Copyright (C) 2012-2018 Nicholas Hathaway <nicholas.hathaway@umassmed.edu>,
+//
+// This file is part of njhseq.
+//
+// njhseq is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// njhseq is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with njhseq.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "njhseq/objects/dataContainers/tables/table.hpp"
+
+namespace njhseq {
+
+/**@brief A column oriented table for large inputs, each column is dictionary encoded so each unique value is only stored once
+ *
+ * Every value is kept as it's original string so converting to and from table is lossless, column types (int, double or string)
+ * are inferred from the unique values so sorting and numeric filtering only parse each unique value once rather than on every comparison
+ *
+ */
+class ColumnarTable {
+public:
+
+	enum class ColumnType {
+		INT, DOUBLE, STRING
+	};
+
+	static std::string getColumnTypeStr(ColumnType type);
+
+	class Column {
+	public:
+		Column(const std::string & name);
+
+		std::string name_;
+		std::vector<uint32_t> codes_; /**< for each row, the position of it's value in levels_ */
+		std::vector<std::string> levels_; /**< the unique values of the column, in the order they were first seen */
+		std::unordered_map<std::string, uint32_t> levelToCode_;
+
+		/**@brief Get the code for a value, adding it as a new level if it hasn't been seen before
+		 *
+		 */
+		uint32_t intern(const std::string & val);
+		void addValue(const std::string & val);
+		const std::string & getValue(uint32_t rowPos) const;
+
+		/**@brief Infer the type from the levels, int if all levels are ints, double if all are numbers, otherwise string
+		 *
+		 */
+		ColumnType inferType() const;
+
+		/**@brief The rank of each level when ordered by the column type, equal ranks only for identical strings
+		 *
+		 */
+		std::vector<uint32_t> genLevelRanks() const;
+	};
+
+	ColumnarTable();
+	ColumnarTable(const VecStr & columnNames);
+	explicit ColumnarTable(const table & tab);
+	ColumnarTable(const TableIOOpts & opts, uint32_t numThreads = 1);
+
+	std::vector<Column> columns_;
+	uint32_t namedColumns_ = 0; /**< the columns in columns_ past this came from rows longer than the header, like table they have no name and aren't written in the header */
+	std::unordered_map<std::string, uint32_t> colNameToPos_;
+	bool hasHeader_ = true;
+
+	/**@brief Read in a table, with numThreads more than 1 the lines are tokenized in blocks with DelimitedTextParser
+	 *
+	 */
+	void populateTable(std::istream & in, const std::string & inDelim = "whitespace",
+			bool header = false, uint32_t numThreads = 1);
+
+	/**@brief Add a row, short rows are padded with empty values and long rows add unnamed columns (with earlier rows padded) the same as reading into a table
+	 *
+	 */
+	void addRow(const VecStr & row);
+
+	table toTable() const;
+
+	uint32_t nCol() const;
+	uint32_t nRow() const;
+	bool empty() const;
+
+	VecStr getColumnNames() const;
+	uint32_t getColPos(const std::string & colName) const;
+	bool containsColumn(const std::string & colName) const;
+	void checkForColumnsThrow(const VecStr & requiredColumns,
+			const std::string & funcName) const;
+
+	const Column & getColumn(const std::string & colName) const;
+	VecStr getColumnValues(const std::string & colName) const;
+	ColumnType getColumnType(const std::string & colName) const;
+
+	/**@brief Sort by the columns in order, each column compared by it's inferred type, ties keep their current order
+	 *
+	 */
+	void sortTable(const VecStr & byColumns, bool decending);
+	/**@brief Sort by a single column, if there's no such column a warning is written to std::cerr and the table is left as is like table::sortTable
+	 *
+	 */
+	void sortTable(const std::string & byThisColumn, bool decending);
+
+	std::vector<uint32_t> getRowPositions(const std::string & forColumn,
+			const std::string & element) const;
+
+	/**@brief Get the rows where the value in forColumn passes pred, pred is called once per unique value rather than per row
+	 *
+	 */
+	std::vector<uint32_t> getRowPositionsByValue(const std::string & forColumn,
+			const std::function<bool(const std::string &)> & pred) const;
+
+	/**@brief Get the rows where the numeric value in forColumn passes pred, will throw if the column isn't numeric
+	 *
+	 */
+	std::vector<uint32_t> getRowPositionsByNumber(const std::string & forColumn,
+			const std::function<bool(double)> & pred) const;
+
+	ColumnarTable getRows(const std::string & forColumn,
+			const std::string & element) const;
+	ColumnarTable getRows(const std::vector<uint32_t> & rowPositions) const;
+
+	ColumnarTable getColumns(const VecStr & columnNames) const;
+
+	/**@brief Get the unique rows, keeping the first occurrence of each in the current order
+	 *
+	 */
+	ColumnarTable getUniqueRows() const;
+
+	void outPutContents(TableIOOpts options) const;
+	void outPutContents(std::ostream & out, std::string delim) const;
+
+	/**@brief Whether the input is large enough that it would be better to use a ColumnarTable rather than a table
+	 *
+	 * @param opts the table input options
+	 * @param sizeCutOff the file size cut off in bytes
+	 */
+	static bool inputIsLarge(const TableIOOpts & opts,
+			uintmax_t sizeCutOff = 100 * 1024 * 1024);
+
+private:
+	uint32_t nRow_ = 0;
+
+	void setColNamePositions();
+	void outPutRows(std::ostream & out, const std::string & delim) const;
+};
+
+}  // namespace njhseq
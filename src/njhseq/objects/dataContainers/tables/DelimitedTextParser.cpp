@@ -0,0 +1,154 @@
+/*
+ * DelimitedTextParser.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: nick
+ */
+//
+// njhseq - A library for analyzing sequence data
+// Copyright (C) 2012-2018 Nicholas Hathaway <nicholas.hathaway@umassmed.edu>,
+//
+// This file is part of njhseq.
+//
+// njhseq is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// njhseq is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with njhseq.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "DelimitedTextParser.hpp"
+#include "njhseq/objects/dataContainers/tables/TableReader.hpp"
+
+namespace njhseq {
+
+DelimitedTextParser::DelimitedTextParser(std::istream & in,
+		const std::string & delim, const Pars & pars) :
+		in_(in), delim_(delim), pars_(pars) {
+	if ("tab" == delim_) {
+		delim_ = "\t";
+	}
+	if (0 == pars_.blockSize_) {
+		std::stringstream ss;
+		ss << __PRETTY_FUNCTION__ << ", error " << "blockSize_ can't be 0" << "\n";
+		throw std::runtime_error { ss.str() };
+	}
+}
+
+void DelimitedTextParser::splitLines(std::string_view block,
+		std::vector<std::string_view> & lines) {
+	lines.clear();
+	size_t start = 0;
+	for (size_t pos = 0; pos < block.size(); ++pos) {
+		if ('\n' == block[pos] || '\r' == block[pos]) {
+			lines.emplace_back(block.substr(start, pos - start));
+			if ('\r' == block[pos] && pos + 1 < block.size() && '\n' == block[pos + 1]) {
+				++pos;
+			}
+			start = pos + 1;
+		}
+	}
+	if (start < block.size()) {
+		lines.emplace_back(block.substr(start));
+	}
+}
+
+bool DelimitedTextParser::readNextBlock(std::string & block) {
+	block.clear();
+	std::swap(block, remainder_);
+	while (!done_) {
+		const size_t oldSize = block.size();
+		block.resize(oldSize + pars_.blockSize_);
+		in_.read(&block[oldSize], pars_.blockSize_);
+		const size_t amountRead = in_.gcount();
+		block.resize(oldSize + amountRead);
+		if (amountRead < pars_.blockSize_) {
+			//end of the stream, everything left is complete
+			done_ = true;
+			break;
+		}
+		//cut after the last line ending, a \r as the last character might be the start of a \r\n so it can't be cut on
+		size_t cut = block.find_last_of('\n');
+		if (std::string::npos == cut && block.size() > 1) {
+			cut = block.find_last_of('\r', block.size() - 2);
+		}
+		if (std::string::npos != cut) {
+			remainder_.assign(block, cut + 1, std::string::npos);
+			block.resize(cut + 1);
+			break;
+		}
+		//no line ending yet, keep reading until the line is complete
+	}
+	return !block.empty();
+}
+
+void DelimitedTextParser::parseBlock(const std::string & block,
+		std::vector<VecStr> & rows) const {
+	std::vector<std::string_view> lines;
+	splitLines(block, lines);
+	rows.reserve(rows.size() + lines.size());
+	std::vector<std::string_view> toks;
+	for (const auto & line : lines) {
+		TableReader::tokenizeLineViews(line, delim_, toks);
+		rows.emplace_back(toks.begin(), toks.end());
+	}
+}
+
+bool DelimitedTextParser::getNextRows(std::vector<VecStr> & rows) {
+	const uint32_t numThreads = std::max<uint32_t>(1, pars_.numThreads_);
+	std::vector<std::string> blocks;
+	std::string block;
+	while (blocks.size() < numThreads && readNextBlock(block)) {
+		blocks.emplace_back(std::move(block));
+		block = std::string();
+	}
+	if (blocks.empty()) {
+		return false;
+	}
+	if (1 == blocks.size()) {
+		parseBlock(blocks.front(), rows);
+		return true;
+	}
+	//each block is parsed into it's own rows and then appended in order
+	std::vector<std::vector<VecStr>> blockRows(blocks.size());
+	std::vector<uint32_t> blockPositions(blocks.size());
+	njh::iota<uint32_t>(blockPositions, 0);
+	njh::concurrent::LockableQueue<uint32_t> blockQueue(blockPositions);
+	auto parseBlocks = [this, &blocks, &blockRows, &blockQueue]() {
+		uint32_t blockPos = 0;
+		while (blockQueue.getVal(blockPos)) {
+			parseBlock(blocks[blockPos], blockRows[blockPos]);
+			//release the text as soon as it's parsed
+			std::string().swap(blocks[blockPos]);
+		}
+	};
+	std::vector<std::thread> threads;
+	for (uint32_t t = 0; t < std::min<uint32_t>(numThreads, blocks.size()); ++t) {
+		threads.emplace_back(parseBlocks);
+	}
+	njh::concurrent::joinAllJoinableThreads(threads);
+	uint64_t totalRows = rows.size();
+	for (const auto & bRows : blockRows) {
+		totalRows += bRows.size();
+	}
+	rows.reserve(totalRows);
+	for (auto & bRows : blockRows) {
+		std::move(bRows.begin(), bRows.end(), std::back_inserter(rows));
+	}
+	return true;
+}
+
+std::vector<VecStr> DelimitedTextParser::getAllRows() {
+	std::vector<VecStr> ret;
+	while (getNextRows(ret)) {
+	}
+	return ret;
+}
+
+}  // namespace njhseq
@@ -0,0 +1,91 @@
+#pragma once
+/*
+ * DelimitedTextParser.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: nick
+ */
+//
+// njhseq - A library for analyzing sequence data
+// Copyright (C) 2012-2018 Nicholas Hathaway <nicholas.hathaway@umassmed.edu>,
+//
+// This file is part of njhseq.
+//
+// njhseq is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// njhseq is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with njhseq.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "njhseq/utils.h"
+
+namespace njhseq {
+
+/**@brief Parse delimited text in large blocks split on line endings, with each block tokenized on it's own thread
+ *
+ * Reads from any stream so compressed input is decompressed by the stream (e.g. InputStream) before being split, rows are
+ * always returned in file order, line endings are handled the same as njh::files::crossPlatGetline (\n, \r\n or \r)
+ *
+ */
+class DelimitedTextParser {
+public:
+
+	struct Pars {
+		uint32_t numThreads_ = 1;
+		uint64_t blockSize_ = 4 * 1024 * 1024; /**< bytes read per block, blocks are extended to the end of the last line */
+	};
+
+	/**@brief Set up to read from in
+	 *
+	 * @param in the stream to read, read from the current position so a header line can already be consumed
+	 * @param delim the delimiter, "whitespace" for runs of white space, "tab" for tab
+	 * @param pars the block size and number of threads
+	 */
+	DelimitedTextParser(std::istream & in, const std::string & delim,
+			const Pars & pars);
+
+	std::istream & in_;
+	std::string delim_;
+	const Pars pars_;
+
+	/**@brief Read in and tokenize the next numThreads_ blocks
+	 *
+	 * @param rows the rows will be appended here in file order
+	 * @return whether any rows were read
+	 */
+	bool getNextRows(std::vector<VecStr> & rows);
+
+	/**@brief Read in and tokenize the rest of the stream
+	 *
+	 */
+	std::vector<VecStr> getAllRows();
+
+	/**@brief Split a block of text into lines the same way repeated calls of crossPlatGetline would
+	 *
+	 * @param block the text
+	 * @param lines the lines to fill, cleared first
+	 */
+	static void splitLines(std::string_view block, std::vector<std::string_view> & lines);
+
+private:
+	std::string remainder_; /**< the partial line left at the end of the last block */
+	bool done_ = false;
+
+	/**@brief Read the next block of complete lines
+	 *
+	 * @param block the block to fill
+	 * @return whether anything was read
+	 */
+	bool readNextBlock(std::string & block);
+
+	void parseBlock(const std::string & block, std::vector<VecStr> & rows) const;
+};
+
+}  // namespace njhseq
@@ -0,0 +1,413 @@
+/*
+ * StreamingTableAggregator.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: nick
+ */
+//
+// njhseq - A library for analyzing sequence data
+// Copyright (C) 2012-2018 Nicholas Hathaway <nicholas.hathaway@umassmed.edu>,
+//
+// This file is part of njhseq.
+//
+// njhseq is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// njhseq is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with njhseq.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "StreamingTableAggregator.hpp"
+
+namespace njhseq {
+
+StreamingTableAggregator::StreamingTableAggregator(const TableIOOpts & tabOpts,
+		const Pars & pars) :
+		tabOpts_(tabOpts), pars_(pars) {
+	if (0 == pars_.numPartitions_) {
+		std::stringstream ss;
+		ss << __PRETTY_FUNCTION__ << ", error " << "numPartitions_ can't be 0" << "\n";
+		throw std::runtime_error { ss.str() };
+	}
+}
+
+bool StreamingTableAggregator::isAggregateFunction(const std::string & function) {
+	return njh::in(function, VecStr { "mean", "median", "min", "max", "sum", "std" });
+}
+
+bool StreamingTableAggregator::parseDouble(std::string_view str, double & val) {
+	//same as the pattern [-+]?[0-9]*\.?[0-9]+([eE][-+]?[0-9]+)?
+	size_t pos = 0;
+	auto countDigits = [&str, &pos]() {
+		size_t start = pos;
+		while (pos < str.size() && std::isdigit(static_cast<unsigned char>(str[pos]))) {
+			++pos;
+		}
+		return pos - start;
+	};
+	if (pos < str.size() && ('-' == str[pos] || '+' == str[pos])) {
+		++pos;
+	}
+	size_t intDigits = countDigits();
+	if (pos < str.size() && '.' == str[pos]) {
+		++pos;
+		if (0 == countDigits()) {
+			return false;
+		}
+	} else if (0 == intDigits) {
+		return false;
+	}
+	if (pos < str.size() && ('e' == str[pos] || 'E' == str[pos])) {
+		++pos;
+		if (pos < str.size() && ('-' == str[pos] || '+' == str[pos])) {
+			++pos;
+		}
+		if (0 == countDigits()) {
+			return false;
+		}
+	}
+	if (pos != str.size()) {
+		return false;
+	}
+	//strtod needs a null terminated string, most numbers fit in the stack buffer
+	char buffer[64];
+	if (str.size() < sizeof(buffer)) {
+		std::copy(str.begin(), str.end(), buffer);
+		buffer[str.size()] = '\0';
+		val = std::strtod(buffer, nullptr);
+	} else {
+		val = std::strtod(std::string(str).c_str(), nullptr);
+	}
+	return true;
+}
+
+void StreamingTableAggregator::StatAccumulator::add(double val, bool keepVals) {
+	++count_;
+	sum_ += val;
+	double delta = val - mean_;
+	mean_ += delta / count_;
+	m2_ += delta * (val - mean_);
+	min_ = std::min(min_, val);
+	max_ = std::max(max_, val);
+	if (keepVals) {
+		vals_.emplace_back(val);
+	}
+}
+
+double StreamingTableAggregator::StatAccumulator::get(
+		const std::string & function) const {
+	if ("sum" == function) {
+		return sum_;
+	} else if ("mean" == function) {
+		return sum_ / count_;
+	} else if ("median" == function) {
+		return vectorMedianCopy(vals_);
+	} else if ("min" == function) {
+		return min_;
+	} else if ("max" == function) {
+		return max_;
+	} else if ("std" == function) {
+		//sample standard deviation like vectorStandardDeviationSamp
+		return std::pow(m2_ / static_cast<double>(count_ - 1), 0.5);
+	}
+	std::stringstream ss;
+	ss << __PRETTY_FUNCTION__ << ", error " << "unrecognized function: "
+			<< function << ", options are sum, mean, median, max, min, std" << "\n";
+	throw std::runtime_error { ss.str() };
+}
+
+std::vector<bool> StreamingTableAggregator::determineNumericColumns() const {
+	TableReader reader(tabOpts_);
+	std::vector<bool> numeric(reader.header_.nCol(), true);
+	std::vector<std::string_view> row;
+	double val = 0;
+	while (reader.getNextRowViews(row)) {
+		for (const auto colPos : iter::range(row.size())) {
+			if (numeric[colPos] && !row[colPos].empty()
+					&& !parseDouble(row[colPos], val)) {
+				numeric[colPos] = false;
+			}
+		}
+	}
+	return numeric;
+}
+
+table StreamingTableAggregator::countColumns(const VecStr & columns) const {
+	TableReader reader(tabOpts_);
+	reader.header_.checkForColumnsThrow(columns, __PRETTY_FUNCTION__);
+	std::vector<uint32_t> colPositions;
+	for (const auto & col : columns) {
+		colPositions.emplace_back(reader.header_.getColPos(col));
+	}
+	//same key as table::countColumn so the output order matches
+	const std::string keySep = "SPLITONTHIS";
+	std::unordered_map<std::string, std::pair<VecStr, uint32_t>> counts;
+	std::vector<std::string_view> row;
+	std::string key;
+	while (reader.getNextRowViews(row)) {
+		key.clear();
+		for (const auto pos : iter::range(colPositions.size())) {
+			if (0 != pos) {
+				key.append(keySep);
+			}
+			key.append(row[colPositions[pos]]);
+		}
+		auto search = counts.find(key);
+		if (counts.end() == search) {
+			VecStr keyVals;
+			for (const auto & colPos : colPositions) {
+				keyVals.emplace_back(row[colPos]);
+			}
+			search = counts.emplace(key, std::make_pair(keyVals, 0)).first;
+		}
+		++search->second.second;
+	}
+	auto keys = njh::getVecOfMapKeys(counts);
+	njh::sort(keys);
+	VecStr outColumnNames = columns;
+	if (1 == columns.size()) {
+		outColumnNames = VecStr { "element" };
+	}
+	outColumnNames.emplace_back("count");
+	table ret(outColumnNames);
+	for (const auto & k : keys) {
+		VecStr outRow = counts[k].first;
+		outRow.emplace_back(estd::to_string(counts[k].second));
+		ret.content_.emplace_back(outRow);
+	}
+	return ret;
+}
+
+void StreamingTableAggregator::aggregateStream(std::istream & in,
+		AggregateSetUp & setUp, std::map<std::string, GroupResult> & results,
+		uint32_t depth) const {
+	const bool keepVals = "median" == setUp.function_;
+	const uint64_t groupOverhead = sizeof(GroupState)
+			+ setUp.statCols_.size() * sizeof(StatAccumulator) + 64;
+	std::unordered_map<std::string, GroupState> groups;
+	uint64_t memoryUsed = 0;
+	bool spilling = false;
+	bfs::path spillDir;
+	std::vector<bfs::path> partitionFnps;
+	std::vector<std::unique_ptr<std::ofstream>> partitions;
+
+	std::string line;
+	std::string key;
+	std::vector<std::string_view> row;
+	double val = 0;
+	while (njh::files::crossPlatGetline(in, line)) {
+		TableReader::tokenizeLineViews(line, tabOpts_.inDelim_, row);
+		if (row.size() != setUp.numeric_.size()) {
+			std::stringstream ss;
+			ss << __PRETTY_FUNCTION__ << ", error the row has a different number of columns than the first line" << "\n";
+			ss << "rowSize: " << row.size() << ", firstLineSize: " << setUp.numeric_.size() << "\n";
+			ss << "row: " << line << "\n";
+			throw std::runtime_error { ss.str() };
+		}
+		key.clear();
+		for (const auto pos : iter::range(setUp.keyCols_.size())) {
+			if (0 != pos) {
+				key.append(setUp.keySep_);
+			}
+			key.append(row[setUp.keyCols_[pos]]);
+		}
+		auto search = groups.find(key);
+		if (groups.end() == search) {
+			if (spilling) {
+				//new groups go to disk, re-hashed with the depth so a partition that spills again splits differently
+				uint64_t hash = std::hash<std::string> { }(key)
+						+ (depth + 1) * 0x9E3779B97F4A7C15ULL;
+				hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9ULL;
+				hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EBULL;
+				hash = hash ^ (hash >> 31);
+				*partitions[hash % partitions.size()] << line << "\n";
+				continue;
+			}
+			GroupState state;
+			for (const auto & colPos : setUp.keyCols_) {
+				state.keyVals_.emplace_back(row[colPos]);
+			}
+			state.stats_.resize(setUp.statCols_.size());
+			memoryUsed += groupOverhead + 2 * key.size();
+			search = groups.emplace(key, std::move(state)).first;
+		}
+		for (const auto statPos : iter::range(setUp.statCols_.size())) {
+			const auto colPos = setUp.statCols_[statPos];
+			if (!setUp.numeric_[colPos]) {
+				continue;
+			}
+			//blanks count as zeros like table::fillWithZeros
+			val = 0;
+			if (!row[colPos].empty() && !parseDouble(row[colPos], val)) {
+				setUp.numeric_[colPos] = false;
+				continue;
+			}
+			search->second.stats_[statPos].add(val, keepVals);
+			if (keepVals) {
+				memoryUsed += sizeof(double);
+			}
+		}
+		if (!spilling && depth < pars_.maxSpillDepth_
+				&& memoryUsed > pars_.memoryBudget_) {
+			spilling = true;
+			spillDir = bfs::unique_path(
+					njh::files::make_path(pars_.tmpDir_, "tableAggregateSpill-%%%%-%%%%-%%%%"));
+			bfs::create_directories(spillDir);
+			for (const auto part : iter::range(pars_.numPartitions_)) {
+				partitionFnps.emplace_back(
+						njh::files::make_path(spillDir, "part_" + estd::to_string(part) + ".txt"));
+				partitions.emplace_back(
+						std::make_unique<std::ofstream>(partitionFnps.back().string()));
+				if (!(*partitions.back())) {
+					std::stringstream ss;
+					ss << __PRETTY_FUNCTION__ << ", error " << "couldn't open spill file "
+							<< partitionFnps.back() << "\n";
+					throw std::runtime_error { ss.str() };
+				}
+			}
+		}
+	}
+	for (auto & group : groups) {
+		GroupResult result;
+		result.keyVals_ = std::move(group.second.keyVals_);
+		result.stats_.resize(setUp.statCols_.size(), 0);
+		for (const auto statPos : iter::range(setUp.statCols_.size())) {
+			if (setUp.numeric_[setUp.statCols_[statPos]]) {
+				result.stats_[statPos] = group.second.stats_[statPos].get(setUp.function_);
+			}
+		}
+		results[group.first] = std::move(result);
+	}
+	groups.clear();
+	if (spilling) {
+		for (auto & part : partitions) {
+			part->close();
+		}
+		partitions.clear();
+		for (const auto & partFnp : partitionFnps) {
+			std::ifstream partIn(partFnp.string());
+			aggregateStream(partIn, setUp, results, depth + 1);
+		}
+		bfs::remove_all(spillDir);
+	}
+}
+
+table StreamingTableAggregator::aggregate(const std::string & columnName,
+		const std::string & function, bool advance) const {
+	if (!isAggregateFunction(function)) {
+		std::stringstream ss;
+		ss << __PRETTY_FUNCTION__ << ", error " << "unrecognized function for aggregate, "
+				<< function << ", options are sum, mean, median, max, min, std" << "\n";
+		throw std::runtime_error { ss.str() };
+	}
+	AggregateSetUp setUp;
+	setUp.function_ = function;
+	TableReader reader(tabOpts_);
+	const uint32_t nCol = reader.header_.nCol();
+	if (advance) {
+		//the groups are all the non-numeric columns so those need to be known before the aggregating pass
+		setUp.numeric_ = determineNumericColumns();
+		for (const auto colPos : iter::range(nCol)) {
+			if (setUp.numeric_[colPos]) {
+				setUp.statCols_.emplace_back(colPos);
+			} else {
+				setUp.keyCols_.emplace_back(colPos);
+			}
+		}
+		//same separator as table::aggregateAdvance so the output order matches
+		setUp.keySep_ = "______";
+	} else {
+		reader.header_.checkForColumnsThrow({columnName}, __PRETTY_FUNCTION__);
+		setUp.numeric_ = std::vector<bool>(nCol, true);
+		setUp.keyCols_.emplace_back(reader.header_.getColPos(columnName));
+		for (const auto colPos : iter::range(nCol)) {
+			setUp.statCols_.emplace_back(colPos);
+		}
+	}
+	std::map<std::string, GroupResult> results;
+	aggregateStream(*reader.in_, setUp, results, 0);
+	//numeric_ is only final now that every spill has been read
+
+	VecStr outColumnNames;
+	for (const auto & colPos : setUp.keyCols_) {
+		outColumnNames.emplace_back(reader.header_.columnNames_[colPos]);
+	}
+	for (const auto & colPos : setUp.statCols_) {
+		if (setUp.numeric_[colPos]) {
+			outColumnNames.emplace_back(reader.header_.columnNames_[colPos]);
+		}
+	}
+	table ret(outColumnNames);
+	for (auto & result : results) {
+		VecStr outRow = std::move(result.second.keyVals_);
+		for (const auto statPos : iter::range(setUp.statCols_.size())) {
+			if (setUp.numeric_[setUp.statCols_[statPos]]) {
+				outRow.emplace_back(estd::to_string(result.second.stats_[statPos]));
+			}
+		}
+		ret.content_.emplace_back(std::move(outRow));
+	}
+	return ret;
+}
+
+table StreamingTableAggregator::pivot(const std::string & column,
+		const std::string & matchColumn) const {
+	TableReader reader(tabOpts_);
+	reader.header_.checkForColumnsThrow({column, matchColumn}, __PRETTY_FUNCTION__);
+	const auto colPos = reader.header_.getColPos(column);
+	const auto matchPos = reader.header_.getColPos(matchColumn);
+	VecStr splitColNames;
+	for (const auto & col : reader.header_.columnNames_) {
+		if (col != matchColumn) {
+			splitColNames.emplace_back(col);
+		}
+	}
+	std::set<std::string> colVals;
+	std::map<std::string, std::unordered_map<std::string, VecStr>> rowsByMatch;
+	std::vector<std::string_view> row;
+	std::string colVal;
+	std::string matchVal;
+	while (reader.getNextRowViews(row)) {
+		colVal.assign(row[colPos]);
+		matchVal.assign(row[matchPos]);
+		auto & matchRows = rowsByMatch[matchVal];
+		if (matchRows.end() == matchRows.find(colVal)) {
+			VecStr splitRow;
+			splitRow.reserve(splitColNames.size());
+			for (const auto pos : iter::range(row.size())) {
+				if (pos != matchPos) {
+					splitRow.emplace_back(row[pos]);
+				}
+			}
+			matchRows.emplace(colVal, std::move(splitRow));
+			colVals.emplace(colVal);
+		}
+	}
+	VecStr outColumnNames{matchColumn};
+	for (uint32_t i = 0; i < colVals.size(); ++i) {
+		addOtherVec(outColumnNames, splitColNames);
+	}
+	table ret(outColumnNames);
+	for (const auto & matchRows : rowsByMatch) {
+		VecStr outRow{matchRows.first};
+		for (const auto & val : colVals) {
+			auto search = matchRows.second.find(val);
+			if (matchRows.second.end() == search) {
+				addOtherVec(outRow, VecStr(splitColNames.size(), ""));
+			} else {
+				addOtherVec(outRow, search->second);
+			}
+		}
+		ret.content_.emplace_back(outRow);
+	}
+	ret.fillWithZeros();
+	return ret;
+}
+
+}  // namespace njhseq
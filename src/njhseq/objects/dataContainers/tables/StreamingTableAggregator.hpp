@@ -0,0 +1,134 @@
+#pragma once
+/*
+ * StreamingTableAggregator.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: nick
+ */
+//
+// njhseq - A library for analyzing sequence data
+// Copyright (C) 2012-2018 Nicholas Hathaway <nicholas.hathaway@umassmed.edu>,
+//
+// This file is part of njhseq.
+//
+// njhseq is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// njhseq is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with njhseq.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "njhseq/objects/dataContainers/tables/TableReader.hpp"
+
+namespace njhseq {
+
+/**@brief Group by operations (counting, aggregating and pivoting) done while streaming through a table file with TableReader rather than loading it all into a table
+ *
+ * Groups are kept in a hash table so memory is proportional to the number of groups, when aggregating and the group state goes over the
+ * memory budget the rows of any new groups are spilled to partition files by hash and each partition is aggregated after the first pass
+ *
+ * The results match the table equivalents (table::countColumn, table::aggregateSimple/aggregateAdvance and table::cbind on a split table)
+ * with blank values treated as zeros in numeric columns
+ *
+ */
+class StreamingTableAggregator {
+public:
+
+	struct Pars {
+		uint64_t memoryBudget_ = 1024UL * 1024UL * 1024UL; /**< approximate bytes of group state to hold before spilling to disk */
+		bfs::path tmpDir_ = "./"; /**< where the spill partitions are written, they are removed when done */
+		uint32_t numPartitions_ = 16; /**< the number of partitions to spill into */
+		uint32_t maxSpillDepth_ = 3; /**< partitions still over budget are re-partitioned up to this many times before being done in memory */
+	};
+
+	StreamingTableAggregator(const TableIOOpts & tabOpts, const Pars & pars);
+
+	const TableIOOpts tabOpts_;
+	const Pars pars_;
+
+	/**@brief Count the occurrences of the values in columns, with one column the table has the columns element and count
+	 *
+	 * @param columns the columns to count
+	 * @return the counts sorted by the values
+	 */
+	table countColumns(const VecStr & columns) const;
+
+	/**@brief Aggregate the numeric columns with function
+	 *
+	 * @param columnName the column to group on
+	 * @param function the function, one of sum, mean, median, min, max or std
+	 * @param advance group on all the non-numeric columns rather than just columnName, needs an extra pass through the file
+	 * @return the aggregated table sorted by the groups
+	 */
+	table aggregate(const std::string & columnName, const std::string & function,
+			bool advance) const;
+
+	/**@brief Split on column and put the splits side by side matching rows on matchColumn, the first row for each pair of values is used
+	 *
+	 * The result itself is held in memory so memory is proportional to the number of column and matchColumn value pairs
+	 *
+	 */
+	table pivot(const std::string & column, const std::string & matchColumn) const;
+
+	static bool isAggregateFunction(const std::string & function);
+
+	/**@brief Parse a double with the same rules as isDoubleStr without needing a std::string
+	 *
+	 * @param str the value
+	 * @param val where to store the value
+	 * @return whether the value was a number
+	 */
+	static bool parseDouble(std::string_view str, double & val);
+
+private:
+
+	struct StatAccumulator {
+		uint64_t count_ = 0;
+		double sum_ = 0;
+		double mean_ = 0;
+		double m2_ = 0;
+		double min_ = std::numeric_limits<double>::max();
+		double max_ = std::numeric_limits<double>::lowest();
+		std::vector<double> vals_; /**< only kept for median */
+
+		void add(double val, bool keepVals);
+		double get(const std::string & function) const;
+	};
+
+	struct GroupState {
+		VecStr keyVals_;
+		std::vector<StatAccumulator> stats_;
+	};
+
+	/**@brief The finished stats of a group, turned into a row only once all the spills are done as a later spill can still find a column isn't numeric
+	 *
+	 */
+	struct GroupResult {
+		VecStr keyVals_;
+		std::vector<double> stats_; /**< by stat column, not set for columns already known not to be numeric */
+	};
+
+	struct AggregateSetUp {
+		std::string function_;
+		std::vector<uint32_t> keyCols_;
+		std::vector<uint32_t> statCols_;
+		std::vector<bool> numeric_; /**< per column whether every value so far has been blank or a number */
+		std::string keySep_;
+	};
+
+	/**@brief Aggregate the rows in in, spilling new groups to disk once over the memory budget and then aggregating the spills
+	 *
+	 */
+	void aggregateStream(std::istream & in, AggregateSetUp & setUp,
+			std::map<std::string, GroupResult> & results, uint32_t depth) const;
+
+	std::vector<bool> determineNumericColumns() const;
+};
+
+}  // namespace njhseq
@@ -0,0 +1,409 @@
+/*
+ * TableJoiner.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: nick
+ */
+//
+// njhseq - A library for analyzing sequence data
+// Copyright (C) 2012-2018 Nicholas Hathaway <nicholas.hathaway@umassmed.edu>,
+//
+// This file is part of njhseq.
+//
+// njhseq is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// njhseq is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with njhseq.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "TableJoiner.hpp"
+#include "njhseq/objects/dataContainers/tables/ColumnarTable.hpp"
+
+namespace njhseq {
+
+TableJoiner::TableJoiner(const TableIOOpts & leftOpts,
+		const TableIOOpts & rightOpts, const VecStr & leftByColumns,
+		const VecStr & rightByColumns, const Pars & pars) :
+		leftOpts_(leftOpts), rightOpts_(rightOpts), leftByColumns_(leftByColumns), rightByColumns_(
+				rightByColumns), pars_(pars) {
+	if (leftByColumns_.empty() || leftByColumns_.size() != rightByColumns_.size()) {
+		std::stringstream ss;
+		ss << __PRETTY_FUNCTION__ << ", error "
+				<< "need the same non-zero number of columns to join on for both tables, "
+				<< "leftByColumns: " << leftByColumns_.size() << ", rightByColumns: "
+				<< rightByColumns_.size() << "\n";
+		throw std::runtime_error { ss.str() };
+	}
+	TableReader leftReader(leftOpts_);
+	TableReader rightReader(rightOpts_);
+	leftReader.header_.checkForColumnsThrow(leftByColumns_, __PRETTY_FUNCTION__);
+	rightReader.header_.checkForColumnsThrow(rightByColumns_, __PRETTY_FUNCTION__);
+	for (const auto pos : iter::range(leftByColumns_.size())) {
+		leftKeyPositions_.emplace_back(leftReader.header_.getColPos(leftByColumns_[pos]));
+		rightKeyPositions_.emplace_back(rightReader.header_.getColPos(rightByColumns_[pos]));
+	}
+	for (const auto pos : iter::range(leftReader.header_.nCol())) {
+		if (!njh::in(pos, leftKeyPositions_)) {
+			leftValPositions_.emplace_back(pos);
+		}
+	}
+	for (const auto pos : iter::range(rightReader.header_.nCol())) {
+		if (!njh::in(pos, rightKeyPositions_)) {
+			rightValPositions_.emplace_back(pos);
+		}
+	}
+	outColumnNames_ = table::genJoinedColumnNames(leftReader.header_.columnNames_,
+			leftByColumns_, rightReader.header_.columnNames_, rightByColumns_);
+}
+
+bool TableJoiner::rightFitsInMemory() const {
+	//the parsed rows take up a few times the size of the text
+	return !ColumnarTable::inputIsLarge(rightOpts_, pars_.memoryBudget_ / 4);
+}
+
+void TableJoiner::join(std::ostream & out, const std::string & outDelim,
+		bool header) const {
+	if (!rightFitsInMemory()) {
+		sortMergeJoin(out, outDelim, header);
+		return;
+	}
+	//the file size says nothing about compressed input or stdin, so switch to the sort merge join if the right rows outgrow the budget while loading
+	TableReader rightReader(rightOpts_);
+	std::vector<VecStr> rightRows;
+	if (loadRows(rightReader, rightRows, true)) {
+		hashJoin(rightRows, out, outDelim, header);
+	} else {
+		sortMergeJoin(rightReader, rightRows, out, outDelim, header);
+	}
+}
+
+uint64_t TableJoiner::rowBytes(const VecStr & row) {
+	uint64_t ret = sizeof(VecStr);
+	for (const auto & field : row) {
+		ret += field.size() + sizeof(std::string);
+	}
+	return ret;
+}
+
+bool TableJoiner::loadRows(TableReader & reader, std::vector<VecStr> & rows,
+		bool checkBudget) const {
+	uint64_t bytes = 0;
+	for (const auto & row : rows) {
+		bytes += rowBytes(row);
+	}
+	std::vector<VecStr> batch;
+	while (reader.getNextRows(batch)) {
+		for (auto & row : batch) {
+			bytes += rowBytes(row);
+			rows.emplace_back(std::move(row));
+		}
+		if (checkBudget && bytes > pars_.memoryBudget_) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void TableJoiner::writeRow(std::ostream & out, const std::string & outDelim,
+		const VecStr * leftRow, const VecStr * rightRow) const {
+	bool first = true;
+	auto writeField = [&out, &outDelim, &first](const std::string & field) {
+		if (!first) {
+			out << outDelim;
+		}
+		first = false;
+		out << field;
+	};
+	for (const auto pos : iter::range(leftKeyPositions_.size())) {
+		writeField(nullptr != leftRow ? (*leftRow)[leftKeyPositions_[pos]] : (*rightRow)[rightKeyPositions_[pos]]);
+	}
+	for (const auto & pos : leftValPositions_) {
+		writeField(nullptr != leftRow ? (*leftRow)[pos] : pars_.fill_);
+	}
+	for (const auto & pos : rightValPositions_) {
+		writeField(nullptr != rightRow ? (*rightRow)[pos] : pars_.fill_);
+	}
+	out << "\n";
+}
+
+void TableJoiner::hashJoin(std::ostream & out, const std::string & outDelim,
+		bool header) const {
+	TableReader rightReader(rightOpts_);
+	std::vector<VecStr> rightRows;
+	loadRows(rightReader, rightRows, false);
+	hashJoin(rightRows, out, outDelim, header);
+}
+
+void TableJoiner::hashJoin(const std::vector<VecStr> & rightRows,
+		std::ostream & out, const std::string & outDelim, bool header) const {
+	if (header) {
+		out << njh::conToStr(outColumnNames_, outDelim) << "\n";
+	}
+	std::vector<VecStr> batch;
+	std::unordered_map<std::string, std::vector<uint32_t>> rightRowsByKey;
+	std::string key;
+	for (const auto rowPos : iter::range<uint32_t>(rightRows.size())) {
+		table::setJoinKey(rightRows[rowPos], rightKeyPositions_, key);
+		rightRowsByKey[key].emplace_back(rowPos);
+	}
+	std::vector<bool> rightMatched(rightRows.size(), false);
+	TableReader leftReader(leftOpts_);
+	while (leftReader.getNextRows(batch)) {
+		for (const auto & row : batch) {
+			table::setJoinKey(row, leftKeyPositions_, key);
+			auto search = rightRowsByKey.find(key);
+			if (rightRowsByKey.end() != search) {
+				for (const auto & rightRowPos : search->second) {
+					writeRow(out, outDelim, &row, &rightRows[rightRowPos]);
+					rightMatched[rightRowPos] = true;
+				}
+			} else if (table::JoinType::INNER != pars_.type_) {
+				writeRow(out, outDelim, &row, nullptr);
+			}
+		}
+	}
+	if (table::JoinType::OUTER == pars_.type_) {
+		for (const auto rowPos : iter::range(rightRows.size())) {
+			if (!rightMatched[rowPos]) {
+				writeRow(out, outDelim, nullptr, &rightRows[rowPos]);
+			}
+		}
+	}
+}
+
+std::string TableJoiner::escapeRunField(const std::string & field) {
+	std::string ret;
+	ret.reserve(field.size());
+	for (const auto c : field) {
+		switch (c) {
+		case '\\':
+			ret.append("\\\\");
+			break;
+		case '\t':
+			ret.append("\\t");
+			break;
+		case '\n':
+			ret.append("\\n");
+			break;
+		case '\r':
+			ret.append("\\r");
+			break;
+		default:
+			ret.push_back(c);
+			break;
+		}
+	}
+	return ret;
+}
+
+std::string TableJoiner::unescapeRunField(std::string_view field) {
+	std::string ret;
+	ret.reserve(field.size());
+	for (size_t pos = 0; pos < field.size(); ++pos) {
+		if ('\\' == field[pos] && pos + 1 < field.size()) {
+			++pos;
+			switch (field[pos]) {
+			case 't':
+				ret.push_back('\t');
+				break;
+			case 'n':
+				ret.push_back('\n');
+				break;
+			case 'r':
+				ret.push_back('\r');
+				break;
+			default:
+				ret.push_back(field[pos]);
+				break;
+			}
+		} else {
+			ret.push_back(field[pos]);
+		}
+	}
+	return ret;
+}
+
+std::vector<bfs::path> TableJoiner::writeSortedRuns(TableReader & reader,
+		std::vector<VecStr> & chunk, const std::vector<uint32_t> & keyPositions,
+		const bfs::path & runDir, const std::string & prefix) const {
+	std::vector<bfs::path> runFnps;
+	uint64_t chunkBytes = 0;
+	for (const auto & row : chunk) {
+		chunkBytes += rowBytes(row);
+	}
+	auto writeChunk = [&]() {
+		if (chunk.empty()) {
+			return;
+		}
+		std::stable_sort(chunk.begin(), chunk.end(),
+				[&keyPositions](const VecStr & row1, const VecStr & row2) {
+					return compareKeys(row1, keyPositions, row2, keyPositions) < 0;
+				});
+		runFnps.emplace_back(
+				njh::files::make_path(runDir, prefix + "_run" + estd::to_string(runFnps.size()) + ".txt"));
+		std::ofstream runFile(runFnps.back().string());
+		if (!runFile) {
+			std::stringstream ss;
+			ss << __PRETTY_FUNCTION__ << ", error " << "couldn't open run file "
+					<< runFnps.back() << "\n";
+			throw std::runtime_error { ss.str() };
+		}
+		for (const auto & row : chunk) {
+			for (const auto pos : iter::range(row.size())) {
+				if (0 != pos) {
+					runFile << '\t';
+				}
+				runFile << escapeRunField(row[pos]);
+			}
+			runFile << '\n';
+		}
+		chunk.clear();
+		chunkBytes = 0;
+	};
+	//rows already read in are the start of the first run
+	if (chunkBytes > pars_.memoryBudget_) {
+		writeChunk();
+	}
+	std::vector<VecStr> batch;
+	while (reader.getNextRows(batch)) {
+		for (auto & row : batch) {
+			chunkBytes += rowBytes(row);
+			chunk.emplace_back(std::move(row));
+			//the left and right runs are written one after the other so each gets the whole budget
+			if (chunkBytes > pars_.memoryBudget_) {
+				writeChunk();
+			}
+		}
+	}
+	writeChunk();
+	return runFnps;
+}
+
+TableJoiner::SortedRunsReader::SortedRunsReader(
+		const std::vector<bfs::path> & runFnps,
+		const std::vector<uint32_t> & keyPositions) :
+		currentRows_(runFnps.size()), hasRow_(runFnps.size(), false), keyPositions_(
+				keyPositions) {
+	for (const auto & runFnp : runFnps) {
+		runs_.emplace_back(std::make_unique<std::ifstream>(runFnp.string()));
+	}
+	for (const auto runPos : iter::range<uint32_t>(runs_.size())) {
+		readRow(runPos);
+	}
+}
+
+bool TableJoiner::SortedRunsReader::readRow(uint32_t runPos) {
+	hasRow_[runPos] = false;
+	if (std::getline(*runs_[runPos], line_)) {
+		std::vector<std::string_view> toks;
+		TableReader::tokenizeLineViews(line_, "\t", toks);
+		currentRows_[runPos].clear();
+		for (const auto & tok : toks) {
+			currentRows_[runPos].emplace_back(unescapeRunField(tok));
+		}
+		hasRow_[runPos] = true;
+	}
+	return hasRow_[runPos];
+}
+
+bool TableJoiner::SortedRunsReader::getNextRow(VecStr & row) {
+	//ties go to the earlier run so rows with the same key stay in file order
+	bool found = false;
+	uint32_t bestRun = 0;
+	for (const auto runPos : iter::range<uint32_t>(runs_.size())) {
+		if (hasRow_[runPos]
+				&& (!found
+						|| compareKeys(currentRows_[runPos], keyPositions_,
+								currentRows_[bestRun], keyPositions_) < 0)) {
+			bestRun = runPos;
+			found = true;
+		}
+	}
+	if (!found) {
+		return false;
+	}
+	row = std::move(currentRows_[bestRun]);
+	currentRows_[bestRun] = VecStr { };
+	readRow(bestRun);
+	return true;
+}
+
+void TableJoiner::sortMergeJoin(std::ostream & out, const std::string & outDelim,
+		bool header) const {
+	TableReader rightReader(rightOpts_);
+	std::vector<VecStr> rightRows;
+	sortMergeJoin(rightReader, rightRows, out, outDelim, header);
+}
+
+void TableJoiner::sortMergeJoin(TableReader & rightReader,
+		std::vector<VecStr> & rightRows, std::ostream & out,
+		const std::string & outDelim, bool header) const {
+	auto runDir = bfs::unique_path(
+			njh::files::make_path(pars_.tmpDir_, "tableJoinRuns-%%%%-%%%%-%%%%"));
+	bfs::create_directories(runDir);
+	//right first as it may already be part way through
+	auto rightRuns = writeSortedRuns(rightReader, rightRows, rightKeyPositions_, runDir, "right");
+	std::vector<VecStr> leftRows;
+	TableReader leftReader(leftOpts_);
+	auto leftRuns = writeSortedRuns(leftReader, leftRows, leftKeyPositions_, runDir, "left");
+	if (header) {
+		out << njh::conToStr(outColumnNames_, outDelim) << "\n";
+	}
+	{
+		SortedRunsReader leftRunsReader(leftRuns, leftKeyPositions_);
+		SortedRunsReader rightRunsReader(rightRuns, rightKeyPositions_);
+		VecStr leftRow;
+		VecStr rightRow;
+		bool hasLeft = leftRunsReader.getNextRow(leftRow);
+		bool hasRight = rightRunsReader.getNextRow(rightRow);
+		std::vector<VecStr> rightGroup;
+		while (hasLeft || hasRight) {
+			int32_t comp = 0;
+			if (!hasLeft) {
+				comp = 1;
+			} else if (!hasRight) {
+				comp = -1;
+			} else {
+				comp = compareKeys(leftRow, leftKeyPositions_, rightRow, rightKeyPositions_);
+			}
+			if (comp < 0) {
+				if (table::JoinType::INNER != pars_.type_) {
+					writeRow(out, outDelim, &leftRow, nullptr);
+				}
+				hasLeft = leftRunsReader.getNextRow(leftRow);
+			} else if (comp > 0) {
+				if (table::JoinType::OUTER == pars_.type_) {
+					writeRow(out, outDelim, nullptr, &rightRow);
+				}
+				hasRight = rightRunsReader.getNextRow(rightRow);
+			} else {
+				//only the right rows for a single key are held at once
+				rightGroup.clear();
+				rightGroup.emplace_back(rightRow);
+				hasRight = rightRunsReader.getNextRow(rightRow);
+				while (hasRight
+						&& 0 == compareKeys(rightGroup.front(), rightKeyPositions_, rightRow, rightKeyPositions_)) {
+					rightGroup.emplace_back(rightRow);
+					hasRight = rightRunsReader.getNextRow(rightRow);
+				}
+				while (hasLeft
+						&& 0 == compareKeys(leftRow, leftKeyPositions_, rightGroup.front(), rightKeyPositions_)) {
+					for (const auto & groupRow : rightGroup) {
+						writeRow(out, outDelim, &leftRow, &groupRow);
+					}
+					hasLeft = leftRunsReader.getNextRow(leftRow);
+				}
+			}
+		}
+	}
+	bfs::remove_all(runDir);
+}
+
+}  // namespace njhseq
@@ -0,0 +1,157 @@
+#pragma once
+/*
+ * TableJoiner.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: nick
+ */
+//
+// njhseq - A library for analyzing sequence data
+// Copyright (C) 2012-2018 Nicholas Hathaway <nicholas.hathaway@umassmed.edu>,
+//
+// This file is part of njhseq.
+//
+// njhseq is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// njhseq is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with njhseq.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "njhseq/objects/dataContainers/tables/TableReader.hpp"
+
+namespace njhseq {
+
+/**@brief Join two table files while streaming through them with TableReader, the streaming counterpart of table::join
+ *
+ * If the right table fits in the memory budget it's hashed and the left table is streamed past it (output in the left table's order
+ * same as table::join), otherwise both tables are externally sorted on the join columns into runs on disk and merge joined
+ * (output sorted by the join columns, only one group of matching right rows is held in memory at a time)
+ *
+ */
+class TableJoiner {
+public:
+
+	struct Pars {
+		table::JoinType type_ = table::JoinType::INNER;
+		std::string fill_ = "NA"; /**< the value for the columns of unmatched rows */
+		uint64_t memoryBudget_ = 1024UL * 1024UL * 1024UL; /**< approximate bytes of rows to hold in memory */
+		bfs::path tmpDir_ = "./"; /**< where the sorted runs for a sort merge join are written, they are removed when done */
+	};
+
+	/**@brief Set up the join, the columns are checked for here
+	 *
+	 * @param leftOpts the left table
+	 * @param rightOpts the right table
+	 * @param leftByColumns the columns in left to join on
+	 * @param rightByColumns the columns in right to join on, same number as leftByColumns
+	 * @param pars join type, fill and memory
+	 */
+	TableJoiner(const TableIOOpts & leftOpts, const TableIOOpts & rightOpts,
+			const VecStr & leftByColumns, const VecStr & rightByColumns,
+			const Pars & pars);
+
+	const TableIOOpts leftOpts_;
+	const TableIOOpts rightOpts_;
+	const VecStr leftByColumns_;
+	const VecStr rightByColumns_;
+	const Pars pars_;
+
+	VecStr outColumnNames_;
+
+	/**@brief Whether the right table's file is small enough to try hashing it in memory, same size check as ColumnarTable::inputIsLarge
+	 *
+	 */
+	bool rightFitsInMemory() const;
+
+	/**@brief Join choosing the hash join if the right table fits in memory and the sort merge join otherwise
+	 *
+	 * The right rows are counted while loading them for the hash join, if they go over the memory budget (compressed input, stdin) the rows
+	 * read so far become the start of the sorted runs of a sort merge join
+	 *
+	 */
+	void join(std::ostream & out, const std::string & outDelim, bool header) const;
+
+	void hashJoin(std::ostream & out, const std::string & outDelim, bool header) const;
+	void sortMergeJoin(std::ostream & out, const std::string & outDelim, bool header) const;
+
+private:
+	std::vector<uint32_t> leftKeyPositions_;
+	std::vector<uint32_t> leftValPositions_;
+	std::vector<uint32_t> rightKeyPositions_;
+	std::vector<uint32_t> rightValPositions_;
+
+	/**@brief Merges sorted run files back into one sorted stream of rows
+	 *
+	 */
+	class SortedRunsReader {
+	public:
+		SortedRunsReader(const std::vector<bfs::path> & runFnps,
+				const std::vector<uint32_t> & keyPositions);
+		bool getNextRow(VecStr & row);
+	private:
+		std::vector<std::unique_ptr<std::ifstream>> runs_;
+		std::vector<VecStr> currentRows_;
+		std::vector<bool> hasRow_;
+		std::vector<uint32_t> keyPositions_;
+		std::string line_;
+		bool readRow(uint32_t runPos);
+	};
+
+	/**@brief Sort the rows of a table on the key columns in chunks that fit in memory and write each chunk to a run file
+	 *
+	 * @param reader the table, read until the end
+	 * @param chunk rows already read from reader, they go in the first run, left empty
+	 */
+	std::vector<bfs::path> writeSortedRuns(TableReader & reader,
+			std::vector<VecStr> & chunk, const std::vector<uint32_t> & keyPositions,
+			const bfs::path & runDir, const std::string & prefix) const;
+
+	/**@brief The approximate bytes a parsed row takes up
+	 *
+	 */
+	static uint64_t rowBytes(const VecStr & row);
+
+	/**@brief Add the rest of reader's rows to rows
+	 *
+	 * @return false if checkBudget and the rows went over the memory budget, the rest of reader is then left unread
+	 */
+	bool loadRows(TableReader & reader, std::vector<VecStr> & rows,
+			bool checkBudget) const;
+
+	void hashJoin(const std::vector<VecStr> & rightRows, std::ostream & out,
+			const std::string & outDelim, bool header) const;
+	/**@brief Sort merge join with rightReader possibly part way through the right table and rightRows the rows already read from it
+	 *
+	 */
+	void sortMergeJoin(TableReader & rightReader, std::vector<VecStr> & rightRows,
+			std::ostream & out, const std::string & outDelim, bool header) const;
+
+	static std::string escapeRunField(const std::string & field);
+	static std::string unescapeRunField(std::string_view field);
+
+	void writeRow(std::ostream & out, const std::string & outDelim,
+			const VecStr * leftRow, const VecStr * rightRow) const;
+
+	template<typename LEFT, typename RIGHT>
+	static int32_t compareKeys(const LEFT & leftRow,
+			const std::vector<uint32_t> & leftKeyPositions, const RIGHT & rightRow,
+			const std::vector<uint32_t> & rightKeyPositions) {
+		for (const auto pos : iter::range(leftKeyPositions.size())) {
+			int32_t comp = std::string_view(leftRow[leftKeyPositions[pos]]).compare(
+					std::string_view(rightRow[rightKeyPositions[pos]]));
+			if (0 != comp) {
+				return comp < 0 ? -1 : 1;
+			}
+		}
+		return 0;
+	}
+};
+
+}  // namespace njhseq
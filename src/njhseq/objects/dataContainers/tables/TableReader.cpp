@@ -68,6 +68,77 @@ bool TableReader::getNextRow(VecStr & row){
 	return false;
 }
 
+bool TableReader::getNextRowViews(std::vector<std::string_view> & row){
+	row.clear();
+	if(njh::files::crossPlatGetline(*in_, currentLine_)){
+		tokenizeLineViews(currentLine_, tabOpts_.inDelim_, row);
+		if(row.size() != header_.nCol()){
+			std::stringstream ss;
+			ss << __PRETTY_FUNCTION__ << ", error the row has a different number of columns than the first line" << "\n";
+			ss << "rowSize: " << row.size() << ", firstLineSize: " << header_.nCol() << "\n";
+			ss << "row: " << currentLine_ << "\n";
+			throw std::runtime_error{ss.str()};
+		}
+		return true;
+	}
+	return false;
+}
+
+bool TableReader::getNextRows(std::vector<VecStr> & rows, uint32_t numThreads){
+	rows.clear();
+	if(nullptr == parser_){
+		DelimitedTextParser::Pars pars;
+		pars.numThreads_ = numThreads;
+		parser_ = std::make_unique<DelimitedTextParser>(*in_, tabOpts_.inDelim_, pars);
+	}
+	if(!parser_->getNextRows(rows)){
+		return false;
+	}
+	for(const auto & row : rows){
+		if(row.size() != header_.nCol()){
+			std::stringstream ss;
+			ss << __PRETTY_FUNCTION__ << ", error the row has a different number of columns than the first line" << "\n";
+			ss << "rowSize: " << row.size() << ", firstLineSize: " << header_.nCol() << "\n";
+			ss << "row: " << njh::conToStr(row, tabOpts_.inDelim_) << "\n";
+			throw std::runtime_error{ss.str()};
+		}
+	}
+	return true;
+}
+
+void TableReader::tokenizeLineViews(std::string_view lineView,
+		const std::string & delim, std::vector<std::string_view> & toks) {
+	toks.clear();
+	if ("whitespace" == delim) {
+		//mirrors reading with operator>> until the end, so trailing white space gives a last empty token
+		size_t pos = 0;
+		while (true) {
+			while (pos < lineView.size() && std::isspace(static_cast<unsigned char>(lineView[pos]))) {
+				++pos;
+			}
+			size_t start = pos;
+			while (pos < lineView.size() && !std::isspace(static_cast<unsigned char>(lineView[pos]))) {
+				++pos;
+			}
+			toks.emplace_back(lineView.substr(start, pos - start));
+			if (pos >= lineView.size()) {
+				break;
+			}
+		}
+	} else if (delim.empty()) {
+		toks.emplace_back(lineView);
+	} else {
+		size_t start = 0;
+		size_t pos = lineView.find(delim);
+		while (std::string_view::npos != pos) {
+			toks.emplace_back(lineView.substr(start, pos - start));
+			start = pos + delim.size();
+			pos = lineView.find(delim, start);
+		}
+		toks.emplace_back(lineView.substr(start));
+	}
+}
+
 VecStr TableReader::extractCols(const VecStr & row, const VecStr & cols) const{
 	VecStr ret;
 	ret.reserve(cols.size());
@@ -24,6 +24,7 @@
 // along with njhseq.  If not, see <http://www.gnu.org/licenses/>.
 //
 #include "njhseq/objects/dataContainers/tables/table.hpp"
+#include "njhseq/objects/dataContainers/tables/DelimitedTextParser.hpp"
 #include "njhseq/IO/IOOptions.h"
 #include "njhseq/IO/OutputStream.hpp"
 #include "njhseq/IO/InputStream.hpp"
@@ -38,9 +39,38 @@ public:
 	table header_;
 
 	std::unique_ptr<InputStream> in_;
+	std::unique_ptr<DelimitedTextParser> parser_;
 
 	bool getNextRow(VecStr & row);
 
+	std::string currentLine_; /**< the buffer the views from getNextRowViews point into */
+
+	/**@brief Get the next row as views into currentLine_ so no string is allocated per field, the views are only valid until the next read
+	 *
+	 * @param row the views to fill, cleared first
+	 * @return whether a row was read
+	 */
+	bool getNextRowViews(std::vector<std::string_view> & row);
+
+	/**@brief Split a line the same way tokenizeString(line, delim, true) would but into views of line
+	 *
+	 * @param line the line to split, must outlive the views
+	 * @param delim the delimiter, "whitespace" splits on runs of white space
+	 * @param toks the views to fill, cleared first
+	 */
+	static void tokenizeLineViews(std::string_view line, const std::string & delim,
+			std::vector<std::string_view> & toks);
+
+	/**@brief Get the next batch of rows, the input is read in large blocks which are tokenized on numThreads threads
+	 *
+	 * Reads ahead of the stream so shouldn't be mixed with getNextRow or getNextRowViews on the same reader
+	 *
+	 * @param rows the rows to fill, cleared first
+	 * @param numThreads the number of threads to tokenize with, only used on the first call
+	 * @return whether any rows were read
+	 */
+	bool getNextRows(std::vector<VecStr> & rows, uint32_t numThreads = 1);
+
 	VecStr extractCols(const VecStr & row, const VecStr & cols) const;
 
 };
@@ -2,6 +2,7 @@
 #include "njhseq/IO/fileUtils.hpp"
 #include "njhseq/IO/InputStream.hpp"
 #include "njhseq/IO/OutputStream.hpp"
+#include "njhseq/objects/dataContainers/tables/DelimitedTextParser.hpp"
 #include <njhcpp/bashUtils.h>
 
 //
@@ -60,8 +61,8 @@ bool table::empty()const{
 }
 
 
-table::table(const TableIOOpts & opts) :
-		table(opts.in_.inFilename_.string(), opts.inDelim_, opts.hasHeader_) {
+table::table(const TableIOOpts & opts, uint32_t numThreads) :
+		table(opts.in_.inFilename_.string(), opts.inDelim_, opts.hasHeader_, numThreads) {
 
 }
 
@@ -141,7 +142,7 @@ VecStr table::getColumnLevels(const std::string & colName) const {
 	return getColumnLevels(getColPos(colName));
 }
 
-void table::populateTable(std::istream & in, const std::string &inDelim, bool header){
+void table::populateTable(std::istream & in, const std::string &inDelim, bool header, uint32_t numThreads){
 	inDelim_ = inDelim;
 	if(inDelim == "tab"){
 		inDelim_ = "\t";
@@ -151,14 +152,24 @@ void table::populateTable(std::istream & in, const std::string &inDelim, bool he
 	columnNames_.clear();
 
 	std::string currentLine = "";
-	uint32_t lineCount = 0;
-	while(njh::files::crossPlatGetline(in, currentLine)){
-		if(lineCount == 0 && header){
+	if(numThreads > 1){
+		if(header && njh::files::crossPlatGetline(in, currentLine)){
 			columnNames_ = tokenizeString(currentLine, inDelim_, true);
-		}else{
-			content_.emplace_back(tokenizeString(currentLine, inDelim_, true));
 		}
-		++lineCount;
+		DelimitedTextParser::Pars parserPars;
+		parserPars.numThreads_ = numThreads;
+		DelimitedTextParser parser(in, inDelim_, parserPars);
+		content_ = parser.getAllRows();
+	}else{
+		uint32_t lineCount = 0;
+		while(njh::files::crossPlatGetline(in, currentLine)){
+			if(lineCount == 0 && header){
+				columnNames_ = tokenizeString(currentLine, inDelim_, true);
+			}else{
+				content_.emplace_back(tokenizeString(currentLine, inDelim_, true));
+			}
+			++lineCount;
+		}
 	}
 	if(!hasHeader_){
 		for (auto i : iter::range(content_[0].size())) {
@@ -172,13 +183,13 @@ void table::populateTable(std::istream & in, const std::string &inDelim, bool he
 }
 
 table::table(std::istream & in, const std::string &inDelim,
-        bool header){
-	populateTable(in, inDelim, header);
+        bool header, uint32_t numThreads){
+	populateTable(in, inDelim, header, numThreads);
 }
 
-table::table(const bfs::path &filename, const std::string &inDelim,bool header) {
+table::table(const bfs::path &filename, const std::string &inDelim,bool header, uint32_t numThreads) {
 	InputStream in(filename);
-	populateTable(in, inDelim, header);
+	populateTable(in, inDelim, header, numThreads);
 }
 
 void table::addPaddingToEndOfRows(const std::string & padding) {
@@ -1214,4 +1225,150 @@ void table::checkForColumnsThrow(const VecStr & requiredColumns, const std::stri
 	}
 }
 
+table::JoinType table::strToJoinType(const std::string & typeStr) {
+	auto lowerType = njh::strToLowerRet(typeStr);
+	if ("inner" == lowerType) {
+		return JoinType::INNER;
+	} else if ("left" == lowerType) {
+		return JoinType::LEFT;
+	} else if ("outer" == lowerType) {
+		return JoinType::OUTER;
+	}
+	std::stringstream ss;
+	ss << __PRETTY_FUNCTION__ << ", error " << "unrecognized join type: "
+			<< typeStr << ", options are inner, left or outer" << "\n";
+	throw std::runtime_error { ss.str() };
+}
+
+std::string table::getJoinTypeStr(JoinType type) {
+	switch (type) {
+	case JoinType::INNER:
+		return "inner";
+		break;
+	case JoinType::LEFT:
+		return "left";
+		break;
+	case JoinType::OUTER:
+		return "outer";
+		break;
+	default:
+		break;
+	}
+	return "unknown";
+}
+
+VecStr table::genJoinedColumnNames(const VecStr & columnNames,
+		const VecStr & byColumns, const VecStr & otherColumnNames,
+		const VecStr & otherByColumns, const std::string & otherSuffix) {
+	VecStr ret = byColumns;
+	for (const auto & col : columnNames) {
+		if (!njh::in(col, byColumns)) {
+			ret.emplace_back(col);
+		}
+	}
+	for (const auto & col : otherColumnNames) {
+		if (!njh::in(col, otherByColumns)) {
+			std::string outName = col;
+			while (njh::in(outName, ret)) {
+				outName += otherSuffix;
+			}
+			ret.emplace_back(outName);
+		}
+	}
+	return ret;
+}
+
+void table::setJoinKey(const VecStr & row,
+		const std::vector<uint32_t> & keyPositions, std::string & key) {
+	//each value is prefixed with it's length so values containing any separator can't collide
+	key.clear();
+	for (const auto & pos : keyPositions) {
+		key.append(estd::to_string(row[pos].size()));
+		key.push_back(':');
+		key.append(row[pos]);
+	}
+}
+
+table table::join(const table & other, const VecStr & byColumns, JoinType type,
+		const std::string & fill) const {
+	return join(other, byColumns, byColumns, type, fill);
+}
+
+table table::join(const table & other, const VecStr & byColumns,
+		const VecStr & otherByColumns, JoinType type,
+		const std::string & fill) const {
+	if (byColumns.empty() || byColumns.size() != otherByColumns.size()) {
+		std::stringstream ss;
+		ss << __PRETTY_FUNCTION__ << ", error "
+				<< "need the same non-zero number of columns to join on for both tables, "
+				<< "byColumns: " << byColumns.size() << ", otherByColumns: "
+				<< otherByColumns.size() << "\n";
+		throw std::runtime_error { ss.str() };
+	}
+	checkForColumnsThrow(byColumns, __PRETTY_FUNCTION__);
+	other.checkForColumnsThrow(otherByColumns, __PRETTY_FUNCTION__);
+	std::vector<uint32_t> keyPositions;
+	std::vector<uint32_t> otherKeyPositions;
+	for (const auto pos : iter::range(byColumns.size())) {
+		keyPositions.emplace_back(getColPos(byColumns[pos]));
+		otherKeyPositions.emplace_back(other.getColPos(otherByColumns[pos]));
+	}
+	std::vector<uint32_t> valPositions;
+	for (const auto pos : iter::range<uint32_t>(columnNames_.size())) {
+		if (!njh::in(pos, keyPositions)) {
+			valPositions.emplace_back(pos);
+		}
+	}
+	std::vector<uint32_t> otherValPositions;
+	for (const auto pos : iter::range<uint32_t>(other.columnNames_.size())) {
+		if (!njh::in(pos, otherKeyPositions)) {
+			otherValPositions.emplace_back(pos);
+		}
+	}
+	table ret(genJoinedColumnNames(columnNames_, byColumns, other.columnNames_, otherByColumns));
+
+	//hash other on the join columns, then a single pass over this table
+	std::unordered_map<std::string, std::vector<uint32_t>> otherRowsByKey;
+	std::string key;
+	for (const auto otherRowPos : iter::range<uint32_t>(other.content_.size())) {
+		setJoinKey(other.content_[otherRowPos], otherKeyPositions, key);
+		otherRowsByKey[key].emplace_back(otherRowPos);
+	}
+	std::vector<bool> otherMatched(other.content_.size(), false);
+	auto genRow = [&](const VecStr * row, const VecStr * otherRow) {
+		VecStr outRow;
+		outRow.reserve(ret.columnNames_.size());
+		for (const auto pos : iter::range(keyPositions.size())) {
+			outRow.emplace_back(nullptr != row ? (*row)[keyPositions[pos]] : (*otherRow)[otherKeyPositions[pos]]);
+		}
+		for (const auto & pos : valPositions) {
+			outRow.emplace_back(nullptr != row ? (*row)[pos] : fill);
+		}
+		for (const auto & pos : otherValPositions) {
+			outRow.emplace_back(nullptr != otherRow ? (*otherRow)[pos] : fill);
+		}
+		return outRow;
+	};
+	for (const auto & row : content_) {
+		setJoinKey(row, keyPositions, key);
+		auto search = otherRowsByKey.find(key);
+		if (otherRowsByKey.end() != search) {
+			for (const auto & otherRowPos : search->second) {
+				ret.content_.emplace_back(genRow(&row, &other.content_[otherRowPos]));
+				otherMatched[otherRowPos] = true;
+			}
+		} else if (JoinType::INNER != type) {
+			ret.content_.emplace_back(genRow(&row, nullptr));
+		}
+	}
+	if (JoinType::OUTER == type) {
+		for (const auto otherRowPos : iter::range(other.content_.size())) {
+			if (!otherMatched[otherRowPos]) {
+				ret.content_.emplace_back(genRow(nullptr, &other.content_[otherRowPos]));
+			}
+		}
+	}
+	return ret;
+}
+
 }  // namespace njh
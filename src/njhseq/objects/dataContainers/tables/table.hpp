@@ -72,28 +72,31 @@ public:
 	 * @param in In stream
 	 * @param inDelim The delimiter per line
 	 * @param header Whether the first line is a header
+	 * @param numThreads The number of threads to tokenize with, more than 1 reads the input in blocks with DelimitedTextParser
 	 */
 	table(std::istream & in, const std::string &inDelim = "whitespace",
-			bool header = false);
+			bool header = false, uint32_t numThreads = 1);
 	/**@b Construct with a file with lines separated by new line characters and each line is delimited
 	 *
 	 * @param in In file name
 	 * @param inDelim The delimiter per line
 	 * @param header Whether the first line is a header
+	 * @param numThreads The number of threads to tokenize with
 	 */
 	table(const bfs::path &filename, const std::string &inDelim = "whitespace",
-			bool header = false);
+			bool header = false, uint32_t numThreads = 1);
 
 	void populateTable(std::istream & in, const std::string &inDelim = "whitespace",
-			bool header = false);
+			bool header = false, uint32_t numThreads = 1);
 
 	/**@b Construct with a file with lines separated by new line characters and each line is delimited
 	 *
 	 * @param in In file name
 	 * @param inDelim The delimiter per line
 	 * @param header Whether the first line is a header
+	 * @param numThreads The number of threads to tokenize with
 	 */
-	table(const TableIOOpts & opts);
+	table(const TableIOOpts & opts, uint32_t numThreads = 1);
 
 	/**@b Construct with simple unordered_map
 	 *
@@ -353,6 +356,42 @@ public:
 	void checkForColumnsThrow(const VecStr & requiredColumns,
 			const std::string & funcName) const;
 
+	enum class JoinType {
+		INNER, LEFT, OUTER
+	};
+	static JoinType strToJoinType(const std::string & typeStr);
+	static std::string getJoinTypeStr(JoinType type);
+
+	/**@brief Join with another table on matching values in byColumns, done as a hash join on other
+	 *
+	 * The output columns are the join columns, then the rest of this table's columns, then the rest of other's columns.
+	 * Rows are in this table's order with each match in other's order; an outer join adds the unmatched rows of other at the end.
+	 *
+	 * @param other the table to join with
+	 * @param byColumns the columns to join on, must be in both tables
+	 * @param type inner, left or outer
+	 * @param fill the value for the columns of unmatched rows
+	 * @return the joined table
+	 */
+	table join(const table & other, const VecStr & byColumns, JoinType type,
+			const std::string & fill = "NA") const;
+	table join(const table & other, const VecStr & byColumns,
+			const VecStr & otherByColumns, JoinType type,
+			const std::string & fill = "NA") const;
+
+	/**@brief The column names of a join, other's columns already in this table get otherSuffix added
+	 *
+	 */
+	static VecStr genJoinedColumnNames(const VecStr & columnNames,
+			const VecStr & byColumns, const VecStr & otherColumnNames,
+			const VecStr & otherByColumns, const std::string & otherSuffix = "_other");
+
+	/**@brief Encode the values at keyPositions of row into key so that different values can never give the same key
+	 *
+	 */
+	static void setJoinKey(const VecStr & row, const std::vector<uint32_t> & keyPositions,
+			std::string & key);
+
 };
 }  // namespace njh
 
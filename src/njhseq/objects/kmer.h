@@ -32,5 +32,6 @@
 #include "njhseq/objects/kmer/kmerCalculator.hpp"
 #include "njhseq/objects/kmer/kmerInfo.hpp"
 #include "njhseq/objects/kmer/KmersSharedBlocks.hpp"
+#include "njhseq/objects/kmer/KmerCandidatePairIndex.hpp"
 
 
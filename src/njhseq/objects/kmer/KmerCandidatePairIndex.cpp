@@ -0,0 +1,179 @@
+/*
+ * KmerCandidatePairIndex.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: nick
+ */
+//
+// njhseq - A library for analyzing sequence data
+// Copyright (C) 2012-2018 Nicholas Hathaway <nicholas.hathaway@umassmed.edu>,
+//
+// This file is part of njhseq.
+//
+// njhseq is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// njhseq is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with njhseq.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "KmerCandidatePairIndex.hpp"
+
+namespace njhseq {
+
+uint32_t KmerCandidatePairIndex::Pars::maxEditsForPair(uint64_t len1,
+		uint64_t len2) const {
+	if (std::numeric_limits<double>::lowest() == minIdentity_) {
+		return maxEdits_;
+	}
+	return static_cast<uint32_t>(std::floor(
+			(1 - minIdentity_) * std::max(len1, len2)));
+}
+
+KmerCandidatePairIndex::KmerCandidatePairIndex(const Pars & pars) :
+		pars_(pars) {
+	if (0 == pars_.kLen_) {
+		std::stringstream ss;
+		ss << __PRETTY_FUNCTION__ << ", error " << "kLen_ can't be 0" << "\n";
+		throw std::runtime_error { ss.str() };
+	}
+}
+
+void KmerCandidatePairIndex::indexSeqs(const std::vector<std::string> & seqs) {
+	lens_.clear();
+	seqKmers_.clear();
+	postings_.clear();
+	lens_.reserve(seqs.size());
+	seqKmers_.reserve(seqs.size());
+	std::hash<std::string_view> hasher;
+	std::unordered_map<uint64_t, uint32_t> counts;
+	for (const auto seqPos : iter::range(seqs.size())) {
+		const auto & seq = seqs[seqPos];
+		lens_.emplace_back(seq.size());
+		counts.clear();
+		if (seq.size() >= pars_.kLen_) {
+			std::string_view seqView(seq);
+			for (uint64_t pos = 0; pos + pars_.kLen_ <= seq.size(); ++pos) {
+				++counts[hasher(seqView.substr(pos, pars_.kLen_))];
+			}
+		}
+		std::vector<KmerCount> kCounts;
+		kCounts.reserve(counts.size());
+		for (const auto & count : counts) {
+			kCounts.emplace_back(KmerCount { count.first, count.second });
+			postings_[count.first].emplace_back(
+					Posting { static_cast<uint32_t>(seqPos), count.second });
+		}
+		seqKmers_.emplace_back(std::move(kCounts));
+	}
+	lenOrder_ = std::vector<uint32_t>(seqs.size());
+	njh::iota<uint32_t>(lenOrder_, 0);
+	std::stable_sort(lenOrder_.begin(), lenOrder_.end(),
+			[this](uint32_t pos1, uint32_t pos2) {
+				return lens_[pos1] < lens_[pos2];
+			});
+}
+
+uint32_t KmerCandidatePairIndex::minSharedKmersForEdits(uint64_t len1,
+		uint64_t len2, uint32_t kLen, uint32_t maxEdits) {
+	//each edit can destroy at most kLen kmers of the longer sequence
+	int64_t longest = std::max(len1, len2);
+	int64_t minShared = longest - static_cast<int64_t>(kLen) + 1
+			- static_cast<int64_t>(kLen) * static_cast<int64_t>(maxEdits);
+	return minShared > 0 ? static_cast<uint32_t>(minShared) : 0;
+}
+
+uint32_t KmerCandidatePairIndex::numberOfSeqs() const {
+	return lens_.size();
+}
+
+void KmerCandidatePairIndex::setCandidatesForSeq(uint32_t pos,
+		std::vector<uint32_t> & sharedBuffer,
+		std::vector<uint32_t> & candidates) const {
+	candidates.clear();
+	const uint64_t len = lens_[pos];
+	auto passesFilter = [this, len](uint32_t otherPos, uint32_t shared) {
+		const uint64_t otherLen = lens_[otherPos];
+		uint32_t maxEdits = pars_.maxEditsForPair(len, otherLen);
+		uint64_t lenDiff = len > otherLen ? len - otherLen : otherLen - len;
+		return lenDiff <= maxEdits
+				&& shared >= minSharedKmersForEdits(len, otherLen, pars_.kLen_, maxEdits);
+	};
+	//count shared kmers with all lower positioned seqs, candidates is used to hold which seqs were touched
+	std::vector<uint32_t> & touched = candidates;
+	for (const auto & kCount : seqKmers_[pos]) {
+		for (const auto & posting : postings_.at(kCount.kHash_)) {
+			if (posting.seqPos_ >= pos) {
+				continue;
+			}
+			if (0 == sharedBuffer[posting.seqPos_]) {
+				touched.emplace_back(posting.seqPos_);
+			}
+			sharedBuffer[posting.seqPos_] += std::min(kCount.count_, posting.count_);
+		}
+	}
+	//filter in place and reset the buffer
+	uint32_t kept = 0;
+	for (const auto otherPos : touched) {
+		if (passesFilter(otherPos, sharedBuffer[otherPos])) {
+			touched[kept] = otherPos;
+			++kept;
+		}
+	}
+	//the buffer has to be reset after the filtering since touched is being overwritten as it goes
+	for (const auto & kCount : seqKmers_[pos]) {
+		for (const auto & posting : postings_.at(kCount.kHash_)) {
+			if (posting.seqPos_ < pos) {
+				sharedBuffer[posting.seqPos_] = 0;
+			}
+		}
+	}
+	touched.resize(kept);
+
+	//for short sequences or large number of edits the kmer filter can't exclude pairs that share no kmers at all,
+	//those pairs are found by length instead
+	double identityFactor = std::numeric_limits<double>::lowest() == pars_.minIdentity_ ?
+			0 : pars_.kLen_ * (1 - pars_.minIdentity_);
+	bool filterCanExclude = false;
+	if (std::numeric_limits<double>::lowest() == pars_.minIdentity_) {
+		filterCanExclude = minSharedKmersForEdits(len, len, pars_.kLen_, pars_.maxEdits_) > 0;
+	} else if (identityFactor < 1) {
+		filterCanExclude = len * (1 - identityFactor) + 1 > pars_.kLen_;
+	}
+	if (!filterCanExclude) {
+		//only sequences with a length within the max possible edits can be within range
+		uint64_t minLen = 0;
+		uint64_t maxLen = std::numeric_limits<uint64_t>::max();
+		if (std::numeric_limits<double>::lowest() == pars_.minIdentity_) {
+			minLen = len > pars_.maxEdits_ ? len - pars_.maxEdits_ : 0;
+			maxLen = len + pars_.maxEdits_;
+		} else if (pars_.minIdentity_ > 0) {
+			minLen = static_cast<uint64_t>(std::floor(len * pars_.minIdentity_));
+			maxLen = static_cast<uint64_t>(std::ceil(len / pars_.minIdentity_));
+		}
+		std::unordered_set<uint32_t> alreadyAdded(candidates.begin(), candidates.end());
+		auto lenStart = std::lower_bound(lenOrder_.begin(), lenOrder_.end(), minLen,
+				[this](uint32_t otherPos, uint64_t otherLen) {
+					return lens_[otherPos] < otherLen;
+				});
+		for (auto it = lenStart; it != lenOrder_.end() && lens_[*it] <= maxLen; ++it) {
+			const auto otherPos = *it;
+			if (otherPos >= pos || njh::in(otherPos, alreadyAdded)) {
+				continue;
+			}
+			//pairs sharing kmers were already checked above
+			if (passesFilter(otherPos, 0)) {
+				candidates.emplace_back(otherPos);
+			}
+		}
+	}
+	std::sort(candidates.begin(), candidates.end());
+}
+
+}  // namespace njhseq
@@ -0,0 +1,107 @@
+#pragma once
+/*
+ * KmerCandidatePairIndex.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: nick
+ */
+//
+// njhseq - A library for analyzing sequence data
+// Copyright (C) 2012-2018 Nicholas Hathaway <nicholas.hathaway@umassmed.edu>,
+//
+// This file is part of njhseq.
+//
+// njhseq is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// njhseq is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with njhseq.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "njhseq/objects/seqObjects/BaseObjects/seqInfo.hpp"
+
+#include <string_view>
+#include <unordered_set>
+
+namespace njhseq {
+
+/**@brief An inverted kmer index over a set of sequences used to generate the candidate pairs that could be within a number of edits of each other
+ *
+ * Uses the q-gram lemma, two sequences within e edits (mismatches + inserted/deleted bases, counting end gaps) of each other
+ * share at least max(len1, len2) - k + 1 - k * e kmers (counting multiplicity), and their lengths differ by at most e,
+ * so any pair not passing both is guaranteed to be further apart than e edits and never has to be aligned
+ *
+ */
+class KmerCandidatePairIndex {
+public:
+
+	struct Pars {
+		uint32_t kLen_ = 7; /**< the kmer length to index */
+		uint32_t maxEdits_ = 2; /**< the maximum number of edits between two sequences that must not be missed */
+		double minIdentity_ = std::numeric_limits<double>::lowest(); /**< if set, the max edits for a pair is instead (1 - minIdentity_) * the longer length */
+
+		/**@brief The maximum number of edits allowed for sequences of these lengths
+		 *
+		 */
+		uint32_t maxEditsForPair(uint64_t len1, uint64_t len2) const;
+	};
+
+	KmerCandidatePairIndex(const Pars & pars);
+
+	/**@brief Index the sequences, positions in seqs are the indexes used in the candidates
+	 *
+	 */
+	template<typename T>
+	void index(const std::vector<T> & seqs) {
+		std::vector<std::string> strs;
+		strs.reserve(seqs.size());
+		for (const auto & seq : seqs) {
+			strs.emplace_back(getSeqBase(seq).seq_);
+		}
+		indexSeqs(strs);
+	}
+
+	void indexSeqs(const std::vector<std::string> & seqs);
+
+	/**@brief The minimum number of shared kmers needed for two sequences to be within maxEdits of each other, 0 means the filter can't exclude anything
+	 *
+	 */
+	static uint32_t minSharedKmersForEdits(uint64_t len1, uint64_t len2,
+			uint32_t kLen, uint32_t maxEdits);
+
+	/**@brief Get the candidate partners for the sequence at pos, only partners with a lower index are returned so each pair is only generated once
+	 *
+	 * @param pos the position of the sequence
+	 * @param sharedBuffer a scratch buffer sized to the number of indexed sequences, must be all zeros on input and is left all zeros
+	 * @param candidates the candidate positions will be put in here, it's cleared first
+	 */
+	void setCandidatesForSeq(uint32_t pos, std::vector<uint32_t> & sharedBuffer,
+			std::vector<uint32_t> & candidates) const;
+
+	uint32_t numberOfSeqs() const;
+
+	const Pars pars_;
+
+private:
+	struct KmerCount {
+		uint64_t kHash_;
+		uint32_t count_;
+	};
+	struct Posting {
+		uint32_t seqPos_;
+		uint32_t count_;
+	};
+	std::vector<uint64_t> lens_;
+	std::vector<std::vector<KmerCount>> seqKmers_;
+	std::unordered_map<uint64_t, std::vector<Posting>> postings_;
+	std::vector<uint32_t> lenOrder_; /**< sequence positions sorted by length, for pairs where the kmer filter can't exclude anything */
+
+};
+
+}  // namespace njhseq
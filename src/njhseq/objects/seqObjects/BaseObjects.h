@@ -24,6 +24,7 @@
 // along with njhseq.  If not, see <http://www.gnu.org/licenses/>.
 //
 
+#include "njhseq/objects/seqObjects/BaseObjects/QualityScores.hpp"
 #include "njhseq/objects/seqObjects/BaseObjects/seqInfo.hpp"
 #include "njhseq/objects/seqObjects/BaseObjects/baseReadObject.hpp"
 
@@ -0,0 +1,164 @@
+/*
+ * QualityScores.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: nick
+ */
+// njhseq - A library for analyzing sequence data
+// Copyright (C) 2012-2018 Nicholas Hathaway <nicholas.hathaway@umassmed.edu>,
+//
+// This file is part of njhseq.
+//
+// njhseq is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// njhseq is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with njhseq.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "QualityScores.hpp"
+
+namespace njhseq {
+
+const std::array<uint8_t, 256> QualityScores::illuminaBins_ = []() {
+	std::array<uint8_t, 256> bins;
+	for (uint32_t qual = 0; qual < bins.size(); ++qual) {
+		if (qual < 2) {
+			bins[qual] = qual;
+		} else if (qual < 10) {
+			bins[qual] = 6;
+		} else if (qual < 20) {
+			bins[qual] = 15;
+		} else if (qual < 25) {
+			bins[qual] = 22;
+		} else if (qual < 30) {
+			bins[qual] = 27;
+		} else if (qual < 35) {
+			bins[qual] = 33;
+		} else if (qual < 40) {
+			bins[qual] = 37;
+		} else {
+			bins[qual] = 40;
+		}
+	}
+	return bins;
+}();
+
+std::vector<uint8_t> QualityScores::toStored(
+		const std::vector<uint32_t> & quals) {
+	std::vector<uint8_t> ret(quals.size());
+	for (const auto pos : iter::range(quals.size())) {
+		ret[pos] = toStored(quals[pos]);
+	}
+	return ret;
+}
+
+std::vector<uint32_t> QualityScores::toUInt32(
+		const std::vector<uint8_t> & quals) {
+	return std::vector<uint32_t>(quals.begin(), quals.end());
+}
+
+std::string QualityScores::toString(const std::vector<uint8_t> & quals,
+		const std::string & delim) {
+	std::string ret;
+	//at most three digits and the delimiter per quality
+	ret.reserve(quals.size() * (3 + delim.size()));
+	for (const auto pos : iter::range(quals.size())) {
+		if (0 != pos) {
+			ret.append(delim);
+		}
+		ret.append(estd::to_string(static_cast<uint32_t>(quals[pos])));
+	}
+	return ret;
+}
+
+std::string QualityScores::toFastqString(const std::vector<uint8_t> & quals,
+		uint32_t offset) {
+	std::string ret(quals.size(), ' ');
+	for (const auto pos : iter::range(quals.size())) {
+		ret[pos] = static_cast<char>(
+				std::min<uint32_t>(quals[pos], maxFastqQual_) + offset);
+	}
+	return ret;
+}
+
+void QualityScores::illuminaBin(std::vector<uint8_t> & quals) {
+	for (auto & qual : quals) {
+		qual = illuminaBins_[qual];
+	}
+}
+
+QualityScores::RunLengthEncoded::RunLengthEncoded() = default;
+
+QualityScores::RunLengthEncoded::RunLengthEncoded(
+		const std::vector<uint8_t> & quals) {
+	for (const auto pos : iter::range<uint32_t>(quals.size())) {
+		if (quals_.empty() || quals_.back() != quals[pos]) {
+			quals_.emplace_back(quals[pos]);
+			ends_.emplace_back(pos + 1);
+		} else {
+			++ends_.back();
+		}
+	}
+	quals_.shrink_to_fit();
+	ends_.shrink_to_fit();
+}
+
+uint32_t QualityScores::RunLengthEncoded::size() const {
+	return ends_.empty() ? 0 : ends_.back();
+}
+
+uint32_t QualityScores::RunLengthEncoded::numberOfRuns() const {
+	return quals_.size();
+}
+
+uint8_t QualityScores::RunLengthEncoded::at(uint32_t pos) const {
+	if (pos >= size()) {
+		std::stringstream ss;
+		ss << __PRETTY_FUNCTION__ << ", error " << "pos: " << pos
+				<< " out of range, size: " << size() << "\n";
+		throw std::out_of_range { ss.str() };
+	}
+	return quals_[std::upper_bound(ends_.begin(), ends_.end(), pos) - ends_.begin()];
+}
+
+std::vector<uint8_t> QualityScores::RunLengthEncoded::decode() const {
+	std::vector<uint8_t> ret(size());
+	uint32_t start = 0;
+	for (const auto run : iter::range(quals_.size())) {
+		std::fill(ret.begin() + start, ret.begin() + ends_[run], quals_[run]);
+		start = ends_[run];
+	}
+	return ret;
+}
+
+std::string QualityScores::RunLengthEncoded::toFastqString(
+		uint32_t offset) const {
+	std::string ret;
+	ret.reserve(size());
+	uint32_t start = 0;
+	for (const auto run : iter::range(quals_.size())) {
+		ret.append(ends_[run] - start,
+				static_cast<char>(std::min<uint32_t>(quals_[run], maxFastqQual_) + offset));
+		start = ends_[run];
+	}
+	return ret;
+}
+
+size_t QualityScores::RunLengthEncoded::memoryUsed() const {
+	return quals_.capacity() * sizeof(uint8_t)
+			+ ends_.capacity() * sizeof(uint32_t);
+}
+
+bool QualityScores::RunLengthEncoded::operator==(
+		const RunLengthEncoded & other) const {
+	return quals_ == other.quals_ && ends_ == other.ends_;
+}
+
+}  // namespace njhseq
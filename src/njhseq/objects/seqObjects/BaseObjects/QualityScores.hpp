@@ -0,0 +1,109 @@
+#pragma once
+/*
+ * QualityScores.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: nick
+ */
+// njhseq - A library for analyzing sequence data
+// Copyright (C) 2012-2018 Nicholas Hathaway <nicholas.hathaway@umassmed.edu>,
+//
+// This file is part of njhseq.
+//
+// njhseq is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// njhseq is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with njhseq.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "njhseq/utils.h"
+
+namespace njhseq {
+
+/**@brief Helpers for quality scores as seqInfo stores them, one byte per base
+ *
+ * Has the conversions to and from the std::vector<uint32_t> qualities the rest of the API used to take, writing them out without a copy,
+ * Illumina style binning and a run length encoding for holding many reads with long stretches of the same quality
+ *
+ */
+class QualityScores {
+public:
+	static constexpr uint32_t maxStoredQual_ = std::numeric_limits<uint8_t>::max(); /**< higher qualities are stored as this */
+	static constexpr uint32_t maxFastqQual_ = 93; /**< the highest quality that can be written in a fastq file, higher ones are written as this */
+
+	static uint8_t toStored(uint32_t qual) {
+		return static_cast<uint8_t>(std::min(qual, maxStoredQual_));
+	}
+	/**@brief Convert qualities to how seqInfo stores them, qualities above maxStoredQual_ become maxStoredQual_
+	 *
+	 */
+	static std::vector<uint8_t> toStored(const std::vector<uint32_t> & quals);
+	static std::vector<uint32_t> toUInt32(const std::vector<uint8_t> & quals);
+
+	/**@brief The qualities as numbers separated by delim
+	 *
+	 */
+	static std::string toString(const std::vector<uint8_t> & quals,
+			const std::string & delim = " ");
+	/**@brief The qualities as a fastq quality line
+	 *
+	 * @param quals the qualities
+	 * @param offset the offset, normally 33
+	 * @return the quality line
+	 */
+	static std::string toFastqString(const std::vector<uint8_t> & quals,
+			uint32_t offset);
+
+	/**@brief The Illumina eight level binning, 0-1 are kept, 2-9 go to 6, 10-19 to 15, 20-24 to 22, 25-29 to 27, 30-34 to 33, 35-39 to 37 and 40 and above to 40
+	 *
+	 */
+	static uint8_t illuminaBin(uint8_t qual) {
+		return illuminaBins_[qual];
+	}
+	static void illuminaBin(std::vector<uint8_t> & quals);
+
+	/**@brief Qualities kept as runs of the same quality
+	 *
+	 */
+	class RunLengthEncoded {
+	public:
+		RunLengthEncoded();
+		explicit RunLengthEncoded(const std::vector<uint8_t> & quals);
+
+		/**@brief The number of qualities (not runs)
+		 *
+		 */
+		uint32_t size() const;
+		uint32_t numberOfRuns() const;
+		/**@brief The quality at pos, a binary search over the runs
+		 *
+		 */
+		uint8_t at(uint32_t pos) const;
+
+		std::vector<uint8_t> decode() const;
+		std::string toFastqString(uint32_t offset) const;
+
+		/**@brief The bytes held, to compare with the one byte per quality of the decoded qualities
+		 *
+		 */
+		size_t memoryUsed() const;
+
+		bool operator==(const RunLengthEncoded & other) const;
+
+	private:
+		std::vector<uint8_t> quals_; /**< the quality of each run */
+		std::vector<uint32_t> ends_; /**< the end of each run (not inclusive) */
+	};
+
+private:
+	static const std::array<uint8_t, 256> illuminaBins_;
+};
+
+}  // namespace njhseq
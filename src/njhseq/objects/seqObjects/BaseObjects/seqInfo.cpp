@@ -1,5 +1,6 @@
 #include "seqInfo.hpp"
 #include "njhseq/helpers/seqUtil.hpp"
+#include "njhseq/helpers/SeqKernels.hpp"
 #include <njhcpp/bashUtils.h>
 
 //
@@ -31,7 +32,7 @@ seqInfo::seqInfo(const std::string & name) :
 }
 seqInfo::seqInfo(const std::string& name, const std::string& seq,
 		const std::vector<uint32_t>& qual) :
-		name_(name), seq_(seq), qual_(qual), cnt_(1), frac_(0) {
+		name_(name), seq_(seq), qual_(QualityScores::toStored(qual)), cnt_(1), frac_(0) {
 	if(qual_.size() != seq.size()){
 		std::stringstream ss;
 		ss << __PRETTY_FUNCTION__ << ", error seq and qual have to be the same size; seq: " << seq.size() << " qual: " << qual_.size()<< "\n";
@@ -40,7 +41,7 @@ seqInfo::seqInfo(const std::string& name, const std::string& seq,
 }
 seqInfo::seqInfo(const std::string& name, const std::string& seq,
 		const std::vector<uint32_t>& qual, double cnt) :
-		name_(name), seq_(seq), qual_(qual), cnt_(cnt), frac_(0) {
+		name_(name), seq_(seq), qual_(QualityScores::toStored(qual)), cnt_(cnt), frac_(0) {
 	if(qual_.size() != seq.size()){
 		std::stringstream ss;
 		ss << __PRETTY_FUNCTION__ << ", error seq and qual have to be the same size; seq: " << seq.size() << " qual: " << qual_.size()<< "\n";
@@ -48,7 +49,7 @@ seqInfo::seqInfo(const std::string& name, const std::string& seq,
 	}
 }
 seqInfo::seqInfo(const std::string& name, const std::string& seq) :
-		name_(name), seq_(seq), qual_(std::vector<uint32_t>(seq.size(), 40)), cnt_(
+		name_(name), seq_(seq), qual_(std::vector<uint8_t>(seq.size(), 40)), cnt_(
 				1), frac_(0) {
 
 }
@@ -61,7 +62,7 @@ seqInfo::seqInfo(const std::string& name, const std::string& seq) :
 
 seqInfo::seqInfo(const std::string& name, const std::string& seq,
 		const std::string& stringQual, uint32_t off_set) :
-		name_(name), seq_(seq), qual_(std::vector<uint32_t>(0)), cnt_(1), frac_(0) {
+		name_(name), seq_(seq), qual_(std::vector<uint8_t>(0)), cnt_(1), frac_(0) {
 	for (const auto & c : stringQual) {
 		qual_.emplace_back(c - off_set);
 	}
@@ -73,6 +74,23 @@ seqInfo::seqInfo(const std::string& name, const std::string& seq,
 }
 seqInfo::seqInfo(const std::string& name, const std::string& seq,
 		const std::vector<uint32_t>& qual, double cnt, double frac) :
+		name_(name), seq_(seq), qual_(QualityScores::toStored(qual)), cnt_(cnt), frac_(frac) {
+	if(qual_.size() != seq.size()){
+		std::stringstream ss;
+		ss << __PRETTY_FUNCTION__ << ", error seq and qual have to be the same size; seq: " << seq.size() << " qual: " << qual_.size()<< "\n";
+		throw std::runtime_error{ss.str()};
+	}
+}
+seqInfo::seqInfo(const std::string& name, const std::string& seq,
+		const std::vector<uint8_t>& qual) :
+		seqInfo(name, seq, qual, 1, 0) {
+}
+seqInfo::seqInfo(const std::string& name, const std::string& seq,
+		const std::vector<uint8_t>& qual, double cnt) :
+		seqInfo(name, seq, qual, cnt, 0) {
+}
+seqInfo::seqInfo(const std::string& name, const std::string& seq,
+		const std::vector<uint8_t>& qual, double cnt, double frac) :
 		name_(name), seq_(seq), qual_(qual), cnt_(cnt), frac_(frac) {
 	if(qual_.size() != seq.size()){
 		std::stringstream ss;
@@ -112,7 +130,7 @@ Json::Value seqInfo::toJsonJustInfo() const {
 Json::Value seqInfo::toJson() const {
 	Json::Value ret;
 	ret["seq"] = njh::json::toJson(seq_);
-	ret["qual"] = njh::json::toJson(qual_);
+	ret["qual"] = njh::json::toJson(QualityScores::toUInt32(qual_));
 	ret["cnt"] = njh::json::toJson(cnt_);
 	ret["frac"] = njh::json::toJson(frac_);
 	ret["name"] = njh::json::toJson(name_);
@@ -129,7 +147,7 @@ void seqInfo::translate(bool complement, bool reverse, size_t start) {
 	} else {
 		seq_ = seqUtil::convertToProtein(seq_, start, false);
 	}
-	qual_ = std::vector<uint32_t>(seq_.size(), 40);
+	qual_ = std::vector<uint8_t>(seq_.size(), 40);
 }
 
 seqInfo seqInfo::translateRet(bool complement, bool reverse,
@@ -223,9 +241,13 @@ void seqInfo::append(const std::string& seq, uint32_t defaultQuality) {
 }
 void seqInfo::append(const std::string& seq,
 		const std::vector<uint32_t>& qual) {
+	append(seq, QualityScores::toStored(qual));
+}
+void seqInfo::append(const std::string& seq,
+		const std::vector<uint8_t>& qual) {
 	if (qual.size() == 1) {
 		seq_.append(seq);
-		addOtherVec(qual_, std::vector<uint32_t>(seq.size(), qual.front()));
+		qual_.insert(qual_.end(), seq.size(), qual.front());
 	} else if (qual.size() == seq.size()) {
 		seq_.append(seq);
 		addOtherVec(qual_, qual);
@@ -261,23 +283,12 @@ void seqInfo::insert(uint32_t pos, const seqInfo & otherInfo){
 }
 
 void seqInfo::reverseHRunsQuals() {
-	std::vector<std::vector<uint32_t>> quals;
-	std::vector<uint32_t> currentQuals;
-	currentQuals.push_back(qual_[0]);
-	for (uint32_t i = 1; i < seq_.length(); ++i) {
-		if (seq_[i] == seq_[i - 1]) {
-			currentQuals.push_back(qual_[i]);
-		} else {
-			quals.push_back(currentQuals);
-			currentQuals.clear();
-			currentQuals.push_back(qual_[i]);
-		}
-	}
-	quals.push_back(currentQuals);
-	qual_.clear();
-	for (auto hrQuals : quals) {
-		njh::reverse(hrQuals);
-		addOtherVec(qual_, hrQuals);
+	std::vector<uint32_t> runEnds;
+	SeqKernels::homopolymerRunEnds(seq_, runEnds);
+	uint32_t runStart = 0;
+	for (const auto runEnd : runEnds) {
+		std::reverse(qual_.begin() + runStart, qual_.begin() + runEnd);
+		runStart = runEnd;
 	}
 }
 
@@ -285,23 +296,16 @@ void seqInfo::reverseComplementRead(bool mark, bool regQualReverse) {
 	if (regQualReverse) {
 		njh::reverse(qual_);
 	} else {
-		std::vector<std::vector<uint32_t>> quals;
-		std::vector<uint32_t> currentQuals;
-		currentQuals.push_back(qual_[0]);
-		for (uint32_t i = 1; i < seq_.length(); ++i) {
-			if (seq_[i] == seq_[i - 1]) {
-				currentQuals.push_back(qual_[i]);
-			} else {
-				quals.push_back(currentQuals);
-				currentQuals.clear();
-				currentQuals.push_back(qual_[i]);
-			}
-		}
-		quals.push_back(currentQuals);
-		qual_.clear();
-		for (auto iter = quals.rbegin(); iter != quals.rend(); ++iter) {
-			addOtherVec(qual_, *iter);
+		//the homopolymer runs are put in reverse order but the qualities within each run are kept in order
+		std::vector<uint32_t> runEnds;
+		SeqKernels::homopolymerRunEnds(seq_, runEnds);
+		std::vector<uint8_t> quals;
+		quals.reserve(qual_.size());
+		for (auto run = runEnds.size(); run > 0; --run) {
+			const uint32_t runStart = 1 == run ? 0 : runEnds[run - 2];
+			quals.insert(quals.end(), qual_.begin() + runStart, qual_.begin() + runEnds[run - 1]);
 		}
+		qual_ = std::move(quals);
 	}
 	seq_ = seqUtil::reverseComplement(seq_, "DNA");
 
@@ -316,9 +320,13 @@ void seqInfo::reverseComplementRead(bool mark, bool regQualReverse) {
 }
 void seqInfo::prepend(const std::string& seq,
 		const std::vector<uint32_t>& qual) {
+	prepend(seq, QualityScores::toStored(qual));
+}
+void seqInfo::prepend(const std::string& seq,
+		const std::vector<uint8_t>& qual) {
 	if (qual.size() == 1) {
 		seq_.insert(seq_.begin(), seq.begin(), seq.end());
-		prependVec(qual_, std::vector<uint32_t>(seq.size(), qual.front()));
+		qual_.insert(qual_.begin(), seq.size(), qual.front());
 	} else if (qual.size() == seq.size()) {
 		seq_.insert(seq_.begin(), seq.begin(), seq.end());
 		prependVec(qual_, qual);
@@ -341,9 +349,9 @@ void seqInfo::append(const seqInfo & other){
 }
 
 
-const std::vector<uint32_t> seqInfo::getLeadQual(uint32_t posA,
+const std::vector<uint8_t> seqInfo::getLeadQual(uint32_t posA,
 		uint32_t out) const {
-	std::vector<uint32_t> ans;
+	std::vector<uint8_t> ans;
 	uint32_t lowerBound = 0;
 	if (posA - out > lowerBound) {
 		lowerBound = posA - out;
@@ -353,9 +361,9 @@ const std::vector<uint32_t> seqInfo::getLeadQual(uint32_t posA,
 	}
 	return ans;
 }
-const std::vector<uint32_t> seqInfo::getTrailQual(uint32_t posA,
+const std::vector<uint8_t> seqInfo::getTrailQual(uint32_t posA,
 		uint32_t out) const {
-	std::vector<uint32_t> ret;
+	std::vector<uint8_t> ret;
 	uint32_t higherBound = qual_.size() - 1;
 	if (posA + out + 1 < higherBound) {
 		higherBound = posA + out + 1;
@@ -469,7 +477,7 @@ void seqInfo::removeGaps() {
 
 // quality strings for printing
 std::string seqInfo::getQualString() const {
-	return vectorToString(qual_);
+	return QualityScores::toString(qual_);
 }
 
 void seqInfo::setFractionByCount(double totalNumberOfReads){
@@ -488,8 +496,16 @@ std::string seqInfo::getFastqString(const std::vector<uint32_t>& quals,
 	}
 	return convertedQuals;
 }
+std::string seqInfo::getFastqString(const std::vector<uint8_t>& quals,
+		uint32_t offset) {
+	return QualityScores::toFastqString(quals, offset);
+}
 std::string seqInfo::getFastqQualString(uint32_t offset) const {
-	return getFastqString(qual_, offset);
+	return QualityScores::toFastqString(qual_, offset);
+}
+
+void seqInfo::binQualities() {
+	QualityScores::illuminaBin(qual_);
 }
 
 //
@@ -624,12 +640,23 @@ void seqInfo::addQual(const std::vector<uint32_t> & quals) {
 		ss << seq_ << "\n";
 		throw std::runtime_error { ss.str() };
 	}
+	qual_ = QualityScores::toStored(quals);
+}
+
+void seqInfo::addQual(const std::vector<uint8_t> & quals) {
+	if (quals.size() != seq_.size()) {
+		std::stringstream ss;
+		ss << "adding qual size does not equal seq size, qualSize: " << quals.size()
+				<< ", seqSize: " << seq_.size() << ", for " << name_ << "\n";
+		ss << QualityScores::toString(quals, ", ") << "\n";
+		ss << seq_ << "\n";
+		throw std::runtime_error { ss.str() };
+	}
 	qual_ = quals;
 }
 
 double seqInfo::getQualCheck(uint32_t qualCutOff) const {
-	uint32_t count = njh::count_if(qual_,
-			[&qualCutOff](uint32_t qual) {return qual >=qualCutOff;});
+	const uint32_t count = SeqKernels::countQualsAtOrAbove(qual_, qualCutOff);
 	return static_cast<double>(count) / qual_.size();
 }
 
@@ -758,7 +785,7 @@ bool seqInfo::nameHasMetaData() const {
 }
 
 void seqInfo::resetMetaInName(const MetaDataInName & meta) {
-	if (meta.meta_.empty()) {
+	if (meta.empty()) {
 		return;
 	}
 
@@ -841,41 +868,20 @@ bool seqInfo::operator ==(const seqInfo & other) const{
 
 
 void seqInfo::adjustHomopolymerRunQualities() {
-  std::string condensedSeq = "";
-  std::vector<uint32_t> condensedSeqQual;
-  std::vector<uint32_t>condensedSeqCount;
-  std::vector<std::pair<uint32_t, uint32_t>>condensedSeqQualPos;
-  int currentCount = 1;
-  std::vector<uint32_t> currentQuals;
-  currentQuals.push_back(qual_[0]);
-  std::pair<uint32_t, uint32_t> currentQualPos {0,1};
-  uint32_t i = 1;
-  for (; i < seq_.length(); i++) {
-    if (seq_[i] == seq_[i - 1]) {
-      currentQuals.push_back(qual_[i]);
-      ++currentCount;
-    } else {
-      condensedSeq.push_back(seq_[i - 1]);
-      condensedSeqQual.push_back(vectorMean(currentQuals));
-      currentQualPos.second = currentQuals.size();
-      condensedSeqQualPos.emplace_back(currentQualPos);
-      currentQualPos.first = i;
-      condensedSeqCount.push_back(currentCount);
-      currentCount = 1;
-      currentQuals.clear();
-      currentQuals.push_back(qual_[i]);
-    }
-  }
-  condensedSeq.push_back(seq_[i - 1]);
-  condensedSeqQual.push_back(vectorMean(currentQuals));
-  currentQualPos.second = currentQuals.size();
-  condensedSeqQualPos.emplace_back(currentQualPos);
-  condensedSeqCount.push_back(currentCount);
-  qual_.clear();
-  for (const auto& i : iter::range<uint64_t>(0, condensedSeq.length())) {
-    addOtherVec(qual_, std::vector<uint32_t>(condensedSeqCount[i],
-                                                      condensedSeqQual[i]));
-  }
+	std::vector<uint32_t> runEnds;
+	SeqKernels::homopolymerRunEnds(seq_, runEnds);
+	uint32_t runStart = 0;
+	for (const auto runEnd : runEnds) {
+		uint32_t qualSum = 0;
+		for (uint32_t pos = runStart; pos < runEnd; ++pos) {
+			qualSum += qual_[pos];
+		}
+		//every quality in the run is set to the truncated mean of the run
+		const uint32_t meanQual = qualSum / static_cast<double>(runEnd - runStart);
+		std::fill(qual_.begin() + runStart, qual_.begin() + runEnd,
+				QualityScores::toStored(meanQual));
+		runStart = runEnd;
+	}
 }
 
 
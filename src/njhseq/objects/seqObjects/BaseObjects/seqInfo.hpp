@@ -31,6 +31,7 @@
 #include "njhseq/IO/SeqIO/SeqIOOptions.hpp"
 #include "njhseq/alignment/alignerUtils/QualScorePars.hpp"
 #include "njhseq/objects/Meta/MetaDataInName.hpp"
+#include "njhseq/objects/seqObjects/BaseObjects/QualityScores.hpp"
 
 namespace njhseq {
 
@@ -57,10 +58,16 @@ struct seqInfo {
           const std::string& stringQual, uint32_t off_set);
   seqInfo(const std::string& name, const std::string& seq,
           const std::vector<uint32_t>& qual, double cnt, double frac);
+  seqInfo(const std::string& name, const std::string& seq,
+          const std::vector<uint8_t>& qual);
+  seqInfo(const std::string& name, const std::string& seq,
+          const std::vector<uint8_t>& qual, double cnt);
+  seqInfo(const std::string& name, const std::string& seq,
+          const std::vector<uint8_t>& qual, double cnt, double frac);
   // Members
   std::string name_;
   std::string seq_;
-  std::vector<uint32_t> qual_;
+  std::vector<uint8_t> qual_; /**< one byte per base, the constructors and functions that take std::vector<uint32_t> qualities convert them with QualityScores::toStored() */
   double cnt_;
   double frac_;
   bool on_ = true;
@@ -72,6 +79,8 @@ struct seqInfo {
 	// changing the seq and qual of the read
 	void prepend(const std::string& seq, const std::vector<uint32_t>& qual);
 	void append(const std::string& seq, const std::vector<uint32_t>& qual);
+	void prepend(const std::string& seq, const std::vector<uint8_t>& qual);
+	void append(const std::string& seq, const std::vector<uint8_t>& qual);
 	void prepend(const std::string& seq, uint32_t defaultQuality = 40);
 	void append(const std::string& seq, uint32_t defaultQuality = 40);
 	void prepend(const char & base, uint32_t quality = 40);
@@ -87,13 +96,19 @@ struct seqInfo {
 	bool checkPrimaryQual(uint32_t pos, uint32_t primaryQual) const;
 	bool checkQual(uint32_t pos, const QualScorePars & qScorePars) const;
 	uint32_t findLowestNeighborhoodQual(uint32_t posA, uint32_t out) const;
-	const std::vector<uint32_t> getLeadQual(uint32_t posA, uint32_t out) const;
-	const std::vector<uint32_t> getTrailQual(uint32_t posA, uint32_t out) const;
+	const std::vector<uint8_t> getLeadQual(uint32_t posA, uint32_t out) const;
+	const std::vector<uint8_t> getTrailQual(uint32_t posA, uint32_t out) const;
   // get a quality string from vector
   std::string getQualString() const;
   std::string getFastqQualString(uint32_t offset) const;
   static std::string getFastqString(const std::vector<uint32_t>& quals,
                                     uint32_t offset);
+  static std::string getFastqString(const std::vector<uint8_t>& quals,
+                                    uint32_t offset);
+  /**@brief Bin the qualities with QualityScores::illuminaBin()
+   *
+   */
+  void binQualities();
 
   //setting fraction
   void setFractionByCount(double totalNumberOfReads);
@@ -140,6 +155,7 @@ struct seqInfo {
   void addQual(const std::string & qualString);
   void addQual(const std::string & qualString, uint32_t offSet);
   void addQual(const std::vector<uint32_t> & quals);
+  void addQual(const std::vector<uint8_t> & quals);
   /**@brief clip from the front and the back of the sequence
    * no safety checks for whether these positions exist in the sequence
    * @param upToPosNotIncluding clip the front of the up to this position but keep this position
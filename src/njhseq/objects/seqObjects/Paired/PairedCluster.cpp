@@ -82,7 +82,7 @@ void PairedCluster::calculateConsensus(aligner & alignerObj, bool setToConsensus
 		std::cout << rInfo.seq_.size() << std::endl;
 		std::cout << rInfo.name_ << std::endl;
 		std::cout << rInfo.seq_ << std::endl;
-		std::cout << rInfo.qual_ << std::endl;
+		std::cout << QualityScores::toString(rInfo.qual_, ", ") << std::endl;
 		rInfo.outPutFastq(std::cout);
 		read.seqBase_.outPutFastq(std::cout);
 		read.mateSeqBase_.outPutFastq(std::cout);
@@ -24,6 +24,7 @@
 // along with njhseq.  If not, see <http://www.gnu.org/licenses/>.
 //
 #include "PairedRead.hpp"
+#include "njhseq/helpers/SeqKernels.hpp"
 
 namespace njhseq {
 PairedRead::PairedRead() :
@@ -43,8 +44,8 @@ void PairedRead::toggleReverseComplement(){
 }
 
 double PairedRead::getQualCheck(uint32_t qualCutOff)const{
-	uint32_t count = njh::count_if(seqBase_.qual_, [&qualCutOff](uint32_t qual){ return qual >=qualCutOff;});
-	count += njh::count_if(mateSeqBase_.qual_, [&qualCutOff](uint32_t qual){ return qual >=qualCutOff;});
+	uint32_t count = SeqKernels::countQualsAtOrAbove(seqBase_.qual_, qualCutOff);
+	count += SeqKernels::countQualsAtOrAbove(mateSeqBase_.qual_, qualCutOff);
 	return static_cast<double>(count)/(mateSeqBase_.qual_.size() + seqBase_.qual_.size());
 }
 
@@ -87,62 +88,8 @@ void PairedRead::createCondensedSeq(){
   condensedSeqQual.clear();
   condensedSeqCount.clear();
   condensedSeqQualPos.clear();
-  {
-    int currentCount = 1;
-    std::vector<uint32_t> currentQuals;
-    currentQuals.push_back(seqBase_.qual_[0]);
-    std::pair<uint32_t, uint32_t> currentQualPos {0,1};
-    uint32_t i = 1;
-    for (; i < seqBase_.seq_.length(); i++) {
-      if (seqBase_.seq_[i] == seqBase_.seq_[i - 1]) {
-        currentQuals.push_back(seqBase_.qual_[i]);
-        ++currentCount;
-      } else {
-        condensedSeq.push_back(seqBase_.seq_[i - 1]);
-        condensedSeqQual.push_back(vectorMean(currentQuals));
-        currentQualPos.second = currentQuals.size();
-        condensedSeqQualPos.emplace_back(currentQualPos);
-        currentQualPos.first = i;
-        condensedSeqCount.push_back(currentCount);
-        currentCount = 1;
-        currentQuals.clear();
-        currentQuals.push_back(seqBase_.qual_[i]);
-      }
-    }
-    condensedSeq.push_back(seqBase_.seq_[i - 1]);
-    condensedSeqQual.push_back(vectorMean(currentQuals));
-    currentQualPos.second = currentQuals.size();
-    condensedSeqQualPos.emplace_back(currentQualPos);
-    condensedSeqCount.push_back(currentCount);
-  }
-  {
-    int currentCount = 1;
-    std::vector<uint32_t> currentQuals;
-    currentQuals.push_back(mateSeqBase_.qual_[0]);
-    std::pair<uint32_t, uint32_t> currentQualPos {0,1};
-    uint32_t i = 1;
-    for (; i < mateSeqBase_.seq_.length(); i++) {
-      if (mateSeqBase_.seq_[i] == mateSeqBase_.seq_[i - 1]) {
-        currentQuals.push_back(mateSeqBase_.qual_[i]);
-        ++currentCount;
-      } else {
-        condensedSeq.push_back(mateSeqBase_.seq_[i - 1]);
-        condensedSeqQual.push_back(vectorMean(currentQuals));
-        currentQualPos.second = currentQuals.size();
-        condensedSeqQualPos.emplace_back(currentQualPos);
-        currentQualPos.first = i;
-        condensedSeqCount.push_back(currentCount);
-        currentCount = 1;
-        currentQuals.clear();
-        currentQuals.push_back(mateSeqBase_.qual_[i]);
-      }
-    }
-    condensedSeq.push_back(mateSeqBase_.seq_[i - 1]);
-    condensedSeqQual.push_back(vectorMean(currentQuals));
-    currentQualPos.second = currentQuals.size();
-    condensedSeqQualPos.emplace_back(currentQualPos);
-    condensedSeqCount.push_back(currentCount);
-  }
+  addCondensedSeq(seqBase_);
+  addCondensedSeq(mateSeqBase_);
 }
 
 void PairedRead::outFastq(std::ostream & firstOut, std::ostream & secondOut) const {
@@ -1,4 +1,5 @@
 #include "readObject.hpp"
+#include "njhseq/helpers/SeqKernels.hpp"
 
 //
 // njhseq - A library for analyzing sequence data
@@ -47,7 +48,7 @@ bool readObject::nameHasMetaData() const {
 }
 
 void readObject::processNameForMeta() {
-	meta_.meta_.clear();
+	meta_.clear();
 	meta_.processNameForMeta(seqBase_.name_, false);
 }
 
@@ -159,58 +160,26 @@ void readObject::createCondensedSeq() {
   condensedSeqQual.clear();
   condensedSeqCount.clear();
   condensedSeqQualPos.clear();
-  int currentCount = 1;
-  std::vector<uint32_t> currentQuals;
-  currentQuals.push_back(seqBase_.qual_[0]);
-  std::pair<uint32_t, uint32_t> currentQualPos {0,1};
-//  bool print = false;
-//  if (seqBase_.name_.find("WGHHT:02045:02871_t46.000000") !=
-//      std::string::npos) {
-//    print = false;
-//  }
-  uint32_t i = 1;
-  for (; i < seqBase_.seq_.length(); i++) {
-    if (seqBase_.seq_[i] == seqBase_.seq_[i - 1]) {
-      currentQuals.push_back(seqBase_.qual_[i]);
-      ++currentCount;
-    } else {
-      condensedSeq.push_back(seqBase_.seq_[i - 1]);
-      condensedSeqQual.push_back(vectorMean(currentQuals));
-      currentQualPos.second = currentQuals.size();
-      condensedSeqQualPos.emplace_back(currentQualPos);
-      currentQualPos.first = i;
-      condensedSeqCount.push_back(currentCount);
-//      if (print) {
-//        std::cout << "Base: " << seqBase_.seq_[i - 1] << std::endl;
-//        std::cout << "\t" << vectorToString(currentQuals) << std::endl;
-//        std::cout << "\t" << currentCount << std::endl;
-//      }
-      currentCount = 1;
-      currentQuals.clear();
-      currentQuals.push_back(seqBase_.qual_[i]);
+  addCondensedSeq(seqBase_);
+}
+
+void readObject::addCondensedSeq(const seqInfo & info) {
+  std::vector<uint32_t> runEnds;
+  SeqKernels::homopolymerRunEnds(info.seq_, runEnds);
+  uint32_t runStart = 0;
+  for (const auto runEnd : runEnds) {
+    const uint32_t runLength = runEnd - runStart;
+    uint32_t qualSum = 0;
+    for (uint32_t pos = runStart; pos < runEnd; ++pos) {
+      qualSum += info.qual_[pos];
     }
+    condensedSeq.push_back(info.seq_[runStart]);
+    //truncated mean of the run's qualities
+    condensedSeqQual.push_back(qualSum / static_cast<double>(runLength));
+    condensedSeqQualPos.emplace_back(runStart, runLength);
+    condensedSeqCount.push_back(runLength);
+    runStart = runEnd;
   }
-//  if (print) {
-//    std::cout << "Base: " << seqBase_.seq_[i - 1] << std::endl;
-//    std::cout << "\t" << vectorToString(currentQuals) << std::endl;
-//    std::cout << "\t" << currentCount << std::endl;
-//  }
-  condensedSeq.push_back(seqBase_.seq_[i - 1]);
-  condensedSeqQual.push_back(vectorMean(currentQuals));
-  currentQualPos.second = currentQuals.size();
-  condensedSeqQualPos.emplace_back(currentQualPos);
-  condensedSeqCount.push_back(currentCount);
-//  if (print) {
-//    std::cout << condensedSeq << std::endl;
-//    std::cout << vectorToString(condensedSeqQual) << std::endl;
-//    std::cout << vectorToString(condensedSeqCount) << std::endl;
-//    std::cout << seqBase_.seq_ << std::endl;
-//    std::cout << vectorToString(seqBase_.qual_) << std::endl;
-//    std::cout << seqBase_.seq_.size() << std::endl;
-//    std::cout << seqBase_.qual_.size() << std::endl;
-//    checkSeqQual(std::cout);
-//    exit(1);
-//  }
 }
 
 void readObject::setClip(size_t leftPos, size_t rightPos) {
@@ -270,7 +239,7 @@ void readObject::outPutCondensedQual(std::ostream& out) const {
 // special output
 void readObject::checkSeqQual(std::ostream& outFile) const {
   for (uint32_t i = 0; i < seqBase_.seq_.length(); ++i) {
-    outFile << seqBase_.seq_[i] << ":" << seqBase_.qual_[i] << " ";
+    outFile << seqBase_.seq_[i] << ":" << static_cast<uint32_t>(seqBase_.qual_[i]) << " ";
   }
   outFile << std::endl;
 }
@@ -388,7 +357,7 @@ bool readObject::operator<=(const readObject& otherRead) const {
 }
 
 double readObject::getQualCheck(uint32_t qualCutOff) const{
-  auto basesAboveQualCheck = njh::count_if(seqBase_.qual_, [&qualCutOff](const uint32_t & q){ return q>=qualCutOff;});
+  auto basesAboveQualCheck = SeqKernels::countQualsAtOrAbove(seqBase_.qual_, qualCutOff);
   return static_cast<double>(basesAboveQualCheck) / seqBase_.qual_.size();
 }
 
@@ -437,8 +406,8 @@ void readObject::adjustHomopolyerRunQualities() {
   createCondensedSeq();
   seqBase_.qual_.clear();
   for (const auto& i : iter::range<uint64_t>(0, condensedSeq.length())) {
-    addOtherVec(seqBase_.qual_, std::vector<uint32_t>(condensedSeqCount[i],
-                                                      condensedSeqQual[i]));
+    seqBase_.qual_.insert(seqBase_.qual_.end(), condensedSeqCount[i],
+        QualityScores::toStored(condensedSeqQual[i]));
   }
 }
 void readObject::updateQualCounts(std::map<uint32_t, uint32_t>& qualCounts)
@@ -461,8 +430,10 @@ void readObject::updateQualWindowCounts(
     int qualWindowSize) const {
   std::vector<uint32_t> currentQuals;
   currentQuals.push_back(seqBase_.qual_[pos]);
-  addOtherVec(currentQuals, seqBase_.getLeadQual(pos, qualWindowSize));
-  addOtherVec(currentQuals, seqBase_.getTrailQual(pos, qualWindowSize));
+  const auto leadQuals = seqBase_.getLeadQual(pos, qualWindowSize);
+  const auto trailQuals = seqBase_.getTrailQual(pos, qualWindowSize);
+  currentQuals.insert(currentQuals.end(), leadQuals.begin(), leadQuals.end());
+  currentQuals.insert(currentQuals.end(), trailQuals.begin(), trailQuals.end());
   counts["mean"][roundDecPlaces(vectorMean(currentQuals), 2)] += seqBase_.cnt_;
   counts["median"][roundDecPlaces(vectorMedianRef(currentQuals), 2)] +=
       seqBase_.cnt_;
@@ -495,8 +466,10 @@ void readObject::updateQaulCountsAtPos(
 
   std::vector<uint32_t> currentQuals;
   currentQuals.push_back(seqBase_.qual_[pos]);
-  addOtherVec(currentQuals, seqBase_.getLeadQual(pos, qualWindowSize));
-  addOtherVec(currentQuals, seqBase_.getTrailQual(pos, qualWindowSize));
+  const auto leadQuals = seqBase_.getLeadQual(pos, qualWindowSize);
+  const auto trailQuals = seqBase_.getTrailQual(pos, qualWindowSize);
+  currentQuals.insert(currentQuals.end(), leadQuals.begin(), leadQuals.end());
+  currentQuals.insert(currentQuals.end(), trailQuals.begin(), trailQuals.end());
   auto stats = getStatsOnVec(currentQuals);
   ++counts["base"][seqBase_.qual_[pos]];
   for (const auto& stat : stats) {
@@ -102,6 +102,11 @@ class readObject : public baseReadObject {
   virtual double getGCContent();
 
   virtual void createCondensedSeq();
+  /**@brief Add the homopolymer runs of info to condensedSeq, condensedSeqQual, condensedSeqQualPos and condensedSeqCount
+   *
+   * @param info the sequence to condense, the runs are added after any already there
+   */
+  void addCondensedSeq(const seqInfo & info);
 
   // get the quality clipings used with the sff file
   void setClip(size_t leftPos, size_t rightPos);
@@ -144,7 +144,7 @@ void sffObject::addSffInfo(std::unordered_map<std::string, std::string> &info) {
 	clipQualLeft_ = std::stoi(info["Clip Qual Left"]);
 	clipQualRight_ = std::stoi(info["Clip Qual Right"]);
 	// add qual info
-	seqBase_.qual_ = stringToVectorTest<uint32_t>(info["Quality Scores"]);
+	seqBase_.qual_ = QualityScores::toStored(stringToVectorTest<uint32_t>(info["Quality Scores"]));
 	// add flow indexes
 	flowIndex_ = stringToVectorTest<uint32_t>(info["Flow Indexes"]);
 	// add flowgram data
@@ -281,7 +281,7 @@ void sffObject::printSffTxtSeqData(std::ostream& out) {
 	out << std::endl << "Bases: " << seqBase_.seq_ << std::endl
 			<< "Quality Scores: ";
 	for (uint32_t i = 0; i < seqBase_.qual_.size(); ++i) {
-		out << seqBase_.qual_[i] << '\t';
+		out << static_cast<uint32_t>(seqBase_.qual_[i]) << '\t';
 	}
 	out << std::endl << std::endl;
 }
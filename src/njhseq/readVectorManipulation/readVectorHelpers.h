@@ -24,6 +24,7 @@
 // along with njhseq.  If not, see <http://www.gnu.org/licenses/>.
 //
 #include "njhseq/readVectorManipulation/readVectorHelpers/readChecker.hpp"
+#include "njhseq/readVectorManipulation/readVectorHelpers/ReadCheckerChain.hpp"
 #include "njhseq/readVectorManipulation/readVectorHelpers/readVecChecker.hpp"
 #include "njhseq/readVectorManipulation/readVectorHelpers/readVecExtractor.hpp"
 #include "njhseq/readVectorManipulation/readVectorHelpers/readVecSorter.hpp"
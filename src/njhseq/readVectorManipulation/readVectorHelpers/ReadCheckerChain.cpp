@@ -0,0 +1,242 @@
+/*
+ * ReadCheckerChain.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: nick
+ */
+// njhseq - A library for analyzing sequence data
+// Copyright (C) 2012-2018 Nicholas Hathaway <nicholas.hathaway@umassmed.edu>,
+//
+// This file is part of njhseq.
+//
+// njhseq is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// njhseq is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with njhseq.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "ReadCheckerChain.hpp"
+
+namespace njhseq {
+
+ReadCheckerChain::Counts::Counts(uint32_t numberOfCheckers) :
+		checked_(numberOfCheckers, 0), failed_(numberOfCheckers, 0) {
+}
+
+void ReadCheckerChain::Counts::addOtherCounts(const Counts & other) {
+	if (other.checked_.size() != checked_.size()) {
+		std::stringstream ss;
+		ss << __PRETTY_FUNCTION__ << ", error " << "other has counts for "
+				<< other.checked_.size() << " checkers but these are for "
+				<< checked_.size() << "\n";
+		throw std::runtime_error { ss.str() };
+	}
+	readsIn_ += other.readsIn_;
+	readsPassed_ += other.readsPassed_;
+	for (const auto pos : iter::range(checked_.size())) {
+		checked_[pos] += other.checked_[pos];
+		failed_[pos] += other.failed_[pos];
+	}
+}
+
+ReadCheckerChain::ReadCheckerChain() = default;
+
+void ReadCheckerChain::addChecker(
+		const std::shared_ptr<const ReadChecker> & checker) {
+	if (nullptr == checker) {
+		std::stringstream ss;
+		ss << __PRETTY_FUNCTION__ << ", error " << "checker can't be null" << "\n";
+		throw std::runtime_error { ss.str() };
+	}
+	CheckType type = CheckType::CHANGES_READ;
+	if (nullptr != std::dynamic_pointer_cast<const ReadCheckerQualCheck>(checker)) {
+		type = CheckType::QUAL_FRAC;
+		needQualCounts_ = true;
+	} else if (nullptr != std::dynamic_pointer_cast<const ReadCheckerOnNucComp>(checker)) {
+		type = CheckType::NUC_COMP;
+		needLetterCounts_ = true;
+	} else if (auto containing = std::dynamic_pointer_cast<const ReadCheckerOnSeqContaining>(checker)) {
+		if (1 == containing->str_.size()) {
+			type = CheckType::CONTAINS_LETTER;
+			needLetterCounts_ = true;
+		} else {
+			type = CheckType::READONLY;
+		}
+	} else if (nullptr != std::dynamic_pointer_cast<const ReadCheckerLenWithin>(checker)
+			|| nullptr != std::dynamic_pointer_cast<const ReadCheckerLenBelow>(checker)
+			|| nullptr != std::dynamic_pointer_cast<const ReadCheckerLenAbove>(checker)
+			|| nullptr != std::dynamic_pointer_cast<const ReadCheckerLenBetween>(checker)
+			|| nullptr != std::dynamic_pointer_cast<const ReadCheckerOnCount>(checker)
+			|| nullptr != std::dynamic_pointer_cast<const ReadCheckerOnFrac>(checker)
+			|| nullptr != std::dynamic_pointer_cast<const ReadCheckerOnNameContaining>(checker)
+			|| nullptr != std::dynamic_pointer_cast<const ReadCheckerOnQualityWindow>(checker)
+			|| nullptr != std::dynamic_pointer_cast<const ReadCheckerOnKmerComp>(checker)) {
+		type = CheckType::READONLY;
+	}
+	checks_.emplace_back(Check { checker, type });
+}
+
+uint32_t ReadCheckerChain::numberOfCheckers() const {
+	return checks_.size();
+}
+
+const ReadChecker & ReadCheckerChain::getChecker(uint32_t pos) const {
+	if (pos >= checks_.size()) {
+		std::stringstream ss;
+		ss << __PRETTY_FUNCTION__ << ", error " << "pos: " << pos
+				<< " out of range, number of checkers: " << checks_.size() << "\n";
+		throw std::out_of_range { ss.str() };
+	}
+	return *checks_[pos].checker_;
+}
+
+ReadCheckerChain::Counts ReadCheckerChain::makeCounts() const {
+	return Counts(checks_.size());
+}
+
+void ReadCheckerChain::setReadCounts(const seqInfo & info,
+		ReadCounts & readCounts) const {
+	if (needLetterCounts_) {
+		readCounts.letters_.fill(0);
+		for (const auto c : info.seq_) {
+			++readCounts.letters_[static_cast<unsigned char>(c)];
+		}
+	}
+	if (needQualCounts_) {
+		readCounts.quals_.fill(0);
+		for (const auto q : info.qual_) {
+			++readCounts.quals_[q];
+		}
+	}
+	readCounts.set_ = true;
+}
+
+bool ReadCheckerChain::runCheck(const Check & check, seqInfo & info,
+		ReadCounts & readCounts) const {
+	if (CheckType::READONLY == check.type_) {
+		return check.checker_->checkRead(info);
+	}
+	if (CheckType::CHANGES_READ == check.type_) {
+		readCounts.set_ = false;
+		return check.checker_->checkRead(info);
+	}
+	if (!readCounts.set_) {
+		setReadCounts(info, readCounts);
+	}
+	bool pass = true;
+	switch (check.type_) {
+	case CheckType::QUAL_FRAC: {
+		const auto & checker = static_cast<const ReadCheckerQualCheck &>(*check.checker_);
+		uint32_t count = 0;
+		for (uint32_t q = checker.qualCutOff_; q < readCounts.quals_.size(); ++q) {
+			count += readCounts.quals_[q];
+		}
+		//same as seqInfo::getQualCheck
+		pass = !(static_cast<double>(count) / info.qual_.size() < checker.qualFracCutOff_);
+		break;
+	}
+	case CheckType::NUC_COMP: {
+		//same as filling a charCounter and calling charCounter::getFracDifference
+		const auto & checker = static_cast<const ReadCheckerOnNucComp &>(*check.checker_);
+		const auto & alphabet = checker.counter_.alphabet_;
+		uint32_t total = 0;
+		for (const auto c : alphabet) {
+			total += readCounts.letters_[static_cast<unsigned char>(c)];
+		}
+		double sum = 0;
+		for (const auto c : alphabet) {
+			const double frac = 0 == total ? 0 :
+					readCounts.letters_[static_cast<unsigned char>(c)] / static_cast<double>(total);
+			sum += std::abs(checker.counter_.fractions_[c] - frac);
+		}
+		pass = !(sum > checker.fracDiff_);
+		break;
+	}
+	case CheckType::CONTAINS_LETTER: {
+		//the upper and lower case are both counted even when they're the same letter like ReadCheckerOnSeqContaining does
+		const auto & checker = static_cast<const ReadCheckerOnSeqContaining &>(*check.checker_);
+		const auto letter = static_cast<unsigned char>(checker.str_.front());
+		const auto lower = static_cast<unsigned char>(std::tolower(letter));
+		pass = readCounts.letters_[letter] + readCounts.letters_[lower] < checker.occurences_;
+		break;
+	}
+	default: {
+		std::stringstream ss;
+		ss << __PRETTY_FUNCTION__ << ", error " << "unhandled check type: "
+				<< static_cast<uint32_t>(check.type_) << "\n";
+		throw std::runtime_error { ss.str() };
+	}
+		break;
+	}
+	info.on_ = pass;
+	if (!pass) {
+		check.checker_->markName(info);
+	}
+	return pass;
+}
+
+bool ReadCheckerChain::checkRead(seqInfo & info) const {
+	ReadCounts readCounts;
+	for (const auto & check : checks_) {
+		if (!runCheck(check, info, readCounts)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool ReadCheckerChain::checkRead(seqInfo & info, Counts & counts) const {
+	++counts.readsIn_;
+	ReadCounts readCounts;
+	for (const auto pos : iter::range(checks_.size())) {
+		++counts.checked_[pos];
+		if (!runCheck(checks_[pos], info, readCounts)) {
+			++counts.failed_[pos];
+			return false;
+		}
+	}
+	++counts.readsPassed_;
+	return true;
+}
+
+bool ReadCheckerChain::checkRead(PairedRead & seq) const {
+	for (const auto & check : checks_) {
+		if (!check.checker_->checkRead(seq)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool ReadCheckerChain::checkRead(PairedRead & seq, Counts & counts) const {
+	++counts.readsIn_;
+	for (const auto pos : iter::range(checks_.size())) {
+		++counts.checked_[pos];
+		if (!checks_[pos].checker_->checkRead(seq)) {
+			++counts.failed_[pos];
+			return false;
+		}
+	}
+	++counts.readsPassed_;
+	return true;
+}
+
+void ReadCheckerChain::writeCounts(const Counts & counts,
+		std::ostream & out) const {
+	out << "checker\tchecked\tpassed\tfailed" << "\n";
+	for (const auto pos : iter::range(checks_.size())) {
+		out << checks_[pos].checker_->markWith_
+				<< "\t" << counts.checked_[pos]
+				<< "\t" << counts.checked_[pos] - counts.failed_[pos]
+				<< "\t" << counts.failed_[pos] << "\n";
+	}
+}
+
+}  // namespace njhseq
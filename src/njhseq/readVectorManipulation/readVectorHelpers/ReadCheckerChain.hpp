@@ -0,0 +1,153 @@
+#pragma once
+/*
+ * ReadCheckerChain.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: nick
+ */
+// njhseq - A library for analyzing sequence data
+// Copyright (C) 2012-2018 Nicholas Hathaway <nicholas.hathaway@umassmed.edu>,
+//
+// This file is part of njhseq.
+//
+// njhseq is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// njhseq is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with njhseq.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "njhseq/readVectorManipulation/readVectorHelpers/readChecker.hpp"
+
+namespace njhseq {
+
+/**@brief Several ReadCheckers applied in order, stopping at the first one a read fails, with the checks that scan the read sharing one pass
+ *
+ * ReadCheckerQualCheck, ReadCheckerOnNucComp and ReadCheckerOnSeqContaining (and ReadCheckerOnNs) with a single letter are answered from letter
+ * and quality counts taken in one pass over the read the first time one of them is reached, the rest are run as is. The counts are taken again
+ * after a checker that could change the read (ReadCheckerOnQualityWindowTrim or a checker not known here) so the decisions, names and on_ flags are the
+ * same as running the checkers one after the other. PairedReads are run through the checkers' own PairedRead checks
+ *
+ */
+class ReadCheckerChain {
+public:
+	/**@brief How many reads each checker was run on and how many it failed
+	 *
+	 */
+	class Counts {
+	public:
+		explicit Counts(uint32_t numberOfCheckers);
+
+		uint64_t readsIn_ { 0 };
+		uint64_t readsPassed_ { 0 };
+		std::vector<uint64_t> checked_; /**< by checker, reads failed by an earlier checker aren't counted */
+		std::vector<uint64_t> failed_; /**< by checker */
+
+		void addOtherCounts(const Counts & other);
+	};
+
+	ReadCheckerChain();
+
+	/**@brief Add a checker, checkers are run in the order added
+	 *
+	 */
+	void addChecker(const std::shared_ptr<const ReadChecker> & checker);
+	uint32_t numberOfCheckers() const;
+	const ReadChecker & getChecker(uint32_t pos) const;
+	/**@brief Empty counts sized for the checkers added so far
+	 *
+	 */
+	Counts makeCounts() const;
+
+	bool checkRead(seqInfo & info) const;
+	bool checkRead(seqInfo & info, Counts & counts) const;
+	bool checkRead(PairedRead & seq) const;
+	bool checkRead(PairedRead & seq, Counts & counts) const;
+
+	/**@brief Check all the reads that are on in reads over several threads
+	 *
+	 * @param reads the reads, anything getSeqBase() works on or PairedRead
+	 * @param numThreads the number of threads to use
+	 * @param batchAmount the number of reads each thread takes at a time
+	 * @return the counts summed over all the threads
+	 */
+	template<typename T>
+	Counts checkReads(std::vector<T> & reads, uint32_t numThreads,
+			uint32_t batchAmount = 1000) const {
+		Counts ret = makeCounts();
+		std::vector<uint32_t> positions(reads.size());
+		njh::iota<uint32_t>(positions, 0);
+		njh::concurrent::LockableQueue<uint32_t> posQueue(positions);
+		std::mutex retMut;
+		auto checkFunc = [this, &reads, &ret, &posQueue, &retMut, batchAmount]() {
+			Counts currentCounts = makeCounts();
+			std::vector<uint32_t> subPositions;
+			while (posQueue.getVals(subPositions, batchAmount)) {
+				for (const auto pos : subPositions) {
+					if (!getSeqBase(reads[pos]).on_) {
+						continue;
+					}
+					if constexpr (std::is_same<T, PairedRead>::value) {
+						checkRead(reads[pos], currentCounts);
+					} else {
+						checkRead(getSeqBase(reads[pos]), currentCounts);
+					}
+				}
+			}
+			std::lock_guard<std::mutex> lock(retMut);
+			ret.addOtherCounts(currentCounts);
+		};
+		uint32_t threadsToUse = std::max<uint32_t>(1, numThreads);
+		if (1 == threadsToUse) {
+			checkFunc();
+		} else {
+			std::vector<std::thread> threads;
+			for (uint32_t t = 0; t < threadsToUse; ++t) {
+				threads.emplace_back(checkFunc);
+			}
+			njh::concurrent::joinAllJoinableThreads(threads);
+		}
+		return ret;
+	}
+
+	/**@brief Write a tab delimited table of counts, one row per checker named by what it marks reads with
+	 *
+	 */
+	void writeCounts(const Counts & counts, std::ostream & out) const;
+
+private:
+	enum class CheckType {
+		READONLY, /**< run as is, doesn't change the sequence or qualities */
+		CHANGES_READ, /**< run as is, the counts have to be taken again after it */
+		QUAL_FRAC, /**< ReadCheckerQualCheck */
+		NUC_COMP, /**< ReadCheckerOnNucComp */
+		CONTAINS_LETTER /**< ReadCheckerOnSeqContaining with a single letter */
+	};
+
+	struct Check {
+		std::shared_ptr<const ReadChecker> checker_;
+		CheckType type_;
+	};
+	std::vector<Check> checks_;
+	bool needLetterCounts_ { false };
+	bool needQualCounts_ { false };
+
+	/**@brief The counts of each letter and each quality of a read
+	 *
+	 */
+	struct ReadCounts {
+		bool set_ { false };
+		std::array<uint32_t, 256> letters_;
+		std::array<uint32_t, 256> quals_;
+	};
+	void setReadCounts(const seqInfo & info, ReadCounts & readCounts) const;
+	bool runCheck(const Check & check, seqInfo & info, ReadCounts & readCounts) const;
+};
+
+}  // namespace njhseq
@@ -132,15 +132,99 @@ class readVecSorter {
 			std::sort(vec.rbegin(), vec.rend(), func);
 		}
 	}*/
+	/**@brief Re-order the elements of vec in the given slots, after this vec[slots[i]] will hold what was in vec[slots[order[i]]]
+	 *
+	 * Follows the cycles of the permutation so each element is moved once rather than copied or swapped repeatedly during the sort
+	 *
+	 * @param vec the vector to re-order
+	 * @param slots the positions in vec being re-ordered
+	 * @param order the permutation, indexes into slots
+	 */
+	template<typename T, typename POSTYPE>
+	static void applyPermutation(std::vector<T>& vec,
+			const std::vector<POSTYPE> & slots, std::vector<uint64_t> order) {
+		for (uint64_t start = 0; start < order.size(); ++start) {
+			if (order[start] == start) {
+				continue;
+			}
+			T temp = std::move(vec[slots[start]]);
+			uint64_t current = start;
+			while (true) {
+				uint64_t next = order[current];
+				order[current] = current;
+				if (next == start) {
+					vec[slots[current]] = std::move(temp);
+					break;
+				}
+				vec[slots[current]] = std::move(vec[slots[next]]);
+				current = next;
+			}
+		}
+	}
+
+	/**@brief Re-order all of vec, after this vec[i] will hold what was in vec[order[i]]
+	 *
+	 */
+	template<typename T>
+	static void applyPermutation(std::vector<T>& vec,
+			const std::vector<uint64_t> & order) {
+		std::vector<uint64_t> slots(vec.size());
+		njh::iota<uint64_t>(slots, 0);
+		applyPermutation(vec, slots, order);
+	}
+
+	/**@brief Get the positions of vec in sorted order, computing a light weight key once per element rather than comparing the full elements
+	 *
+	 * @param vec the vector to get the order for
+	 * @param keyFunc the function to make the key for an element
+	 * @param keyComp the comparison between keys, ties keep their original order
+	 * @return the positions of vec in sorted order
+	 */
+	template<typename T, typename KEYFUNC, typename KEYCOMP>
+	static std::vector<uint64_t> getSortedPositionsByKey(const std::vector<T>& vec,
+			KEYFUNC keyFunc, KEYCOMP keyComp) {
+		std::vector<decltype(keyFunc(vec.front()))> keys;
+		keys.reserve(vec.size());
+		for (const auto & read : vec) {
+			keys.emplace_back(keyFunc(read));
+		}
+		std::vector<uint64_t> order(vec.size());
+		njh::iota<uint64_t>(order, 0);
+		std::stable_sort(order.begin(), order.end(),
+				[&keys, &keyComp](uint64_t pos1, uint64_t pos2) {
+					return keyComp(keys[pos1], keys[pos2]);
+				});
+		return order;
+	}
+
+	/**@brief Sort vec by a light weight key computed once per element and then move the elements into place once
+	 *
+	 */
+	template<typename T, typename KEYFUNC, typename KEYCOMP>
+	static void sortReadVectorByKey(std::vector<T>& vec, KEYFUNC keyFunc,
+			KEYCOMP keyComp, bool decending = true) {
+		auto order = getSortedPositionsByKey(vec, keyFunc, keyComp);
+		if (!decending) {
+			njh::reverse(order);
+		}
+		applyPermutation(vec, order);
+	}
+
 	template <typename T, typename FUNC>
 	static void sortReadVectorFunc(std::vector<T>& vec,
 			FUNC func,
 			bool decending = true) {
-		if (decending) {
-			std::sort(vec.begin(), vec.end(), func);
-		} else {
-			std::sort(vec.rbegin(), vec.rend(), func);
+		//sort the positions rather than the elements so each element is only moved once
+		std::vector<uint64_t> order(vec.size());
+		njh::iota<uint64_t>(order, 0);
+		std::stable_sort(order.begin(), order.end(),
+				[&func, &vec](uint64_t pos1, uint64_t pos2) {
+					return func(vec[pos1], vec[pos2]);
+				});
+		if (!decending) {
+			njh::reverse(order);
 		}
+		applyPermutation(vec, order);
 	}
 
 	template <typename T, typename FUNC>
@@ -148,28 +232,148 @@ class readVecSorter {
 			const std::vector<uint32_t> & positions,
 			FUNC func,
 			bool decending = true) {
-		std::vector<uint32_t> sortedPositions = positions;
-		if (decending) {
-			std::sort(sortedPositions.begin(), sortedPositions.end(),
-					[&func, &vec](uint32_t pos1, uint32_t pos2){
-				return func(vec[pos1], vec[pos2]);
-			});
-		} else {
-			std::sort(sortedPositions.rbegin(), sortedPositions.rend(),
-					[&func, &vec](const uint32_t pos1, uint32_t pos2){
-				return func(vec[pos1], vec[pos2]);
-			});
+		std::vector<uint64_t> order(positions.size());
+		njh::iota<uint64_t>(order, 0);
+		std::stable_sort(order.begin(), order.end(),
+				[&func, &vec, &positions](uint64_t pos1, uint64_t pos2) {
+					return func(vec[positions[pos1]], vec[positions[pos2]]);
+				});
+		if (!decending) {
+			njh::reverse(order);
+		}
+		applyPermutation(vec, positions, order);
+	}
+
+	/**@brief Get the positions of the top k elements of vec in sorted order without sorting the rest
+	 *
+	 * @param vec the vector to get the top elements of
+	 * @param k the number of positions to get, if larger than vec all positions are returned
+	 * @param func the comparison, ties keep their original order
+	 * @return the positions of the top k elements, in order
+	 */
+	template<typename T, typename FUNC>
+	static std::vector<uint64_t> getTopPositions(const std::vector<T>& vec,
+			uint64_t k, FUNC func) {
+		std::vector<uint64_t> order(vec.size());
+		njh::iota<uint64_t>(order, 0);
+		k = std::min<uint64_t>(k, vec.size());
+		std::partial_sort(order.begin(), order.begin() + k, order.end(),
+				[&func, &vec](uint64_t pos1, uint64_t pos2) {
+					if (func(vec[pos1], vec[pos2])) {
+						return true;
+					}
+					if (func(vec[pos2], vec[pos1])) {
+						return false;
+					}
+					return pos1 < pos2;
+				});
+		order.resize(k);
+		return order;
+	}
+
+	/**@brief Move the top k elements of vec to the front in sorted order, the rest follow in their original relative order
+	 *
+	 */
+	template<typename T, typename FUNC>
+	static void partialSortReadVectorFunc(std::vector<T>& vec, uint64_t k,
+			FUNC func) {
+		auto order = getTopPositions(vec, k, func);
+		std::vector<bool> inTop(vec.size(), false);
+		for (const auto pos : order) {
+			inTop[pos] = true;
 		}
-		/**@todo find an more efficient way of doing this that would avoid the copy */
-		std::unordered_map<uint32_t, T> tempCpy;
-		for(const auto pos : iter::range(sortedPositions.size())){
-			if(positions[pos] !=  sortedPositions[pos]){
-				tempCpy.emplace(pos, vec[sortedPositions[pos]]);
+		for (const auto pos : iter::range<uint64_t>(vec.size())) {
+			if (!inTop[pos]) {
+				order.emplace_back(pos);
 			}
 		}
-		for(const auto&  pos : tempCpy){
-			vec[positions[pos.first]] = pos.second;
+		applyPermutation(vec, order);
+	}
+
+	template<typename T>
+	static void partialSortByTotalCount(std::vector<T>& vec, uint64_t k) {
+		partialSortReadVectorFunc(vec, k, [](const T& first, const T& second) -> bool {
+			return roundDecPlaces(getSeqBase(first).cnt_, 2) > roundDecPlaces(getSeqBase(second).cnt_, 2);
+		});
+	}
+
+	/**@brief The key used by readObject::operator<, count descending then average error rate ascending, both rounded to 2 decimal places
+	 *
+	 */
+	struct CountErrorKey {
+		double cnt_;
+		double averageErrorRate_;
+
+		bool operator<(const CountErrorKey & other) const {
+			if (cnt_ == other.cnt_) {
+				return averageErrorRate_ < other.averageErrorRate_;
+			}
+			return cnt_ > other.cnt_;
 		}
+		bool operator==(const CountErrorKey & other) const {
+			return cnt_ == other.cnt_ && averageErrorRate_ == other.averageErrorRate_;
+		}
+	};
+
+	template<typename T>
+	static CountErrorKey genCountErrorKey(const T & read) {
+		return CountErrorKey { roundDecPlaces(getSeqBase(read).cnt_, 2),
+				roundDecPlaces(getRef(read).averageErrorRate, 2) };
+	}
+
+	/**@brief Sort positions into vec by the elements' CountErrorKey, which is the same order as sorting by the elements' operator<
+	 *
+	 * @param vec the elements
+	 * @param positions the positions to sort
+	 * @param keys will be set to the key for every element of vec so the positions can later be re-sorted with resortChangedPositions
+	 */
+	template<typename T, typename POSTYPE>
+	static void sortPositionsByCountErrorKey(const std::vector<T>& vec,
+			std::vector<POSTYPE> & positions, std::vector<CountErrorKey> & keys) {
+		keys.clear();
+		keys.reserve(vec.size());
+		for (const auto & read : vec) {
+			keys.emplace_back(genCountErrorKey(read));
+		}
+		std::stable_sort(positions.begin(), positions.end(),
+				[&keys](POSTYPE pos1, POSTYPE pos2) {
+					return keys[pos1] < keys[pos2];
+				});
+	}
+
+	/**@brief Re-sort positions that were sorted by keys after only some of the elements have changed
+	 *
+	 * Only the positions whose key changed are taken out, sorted and merged back in with the unchanged positions,
+	 * which for iterative clustering where only a few counts change between iterations is linear rather than a full sort
+	 *
+	 * @param vec the elements
+	 * @param positions the positions, sorted by keys on input and by the current keys on output
+	 * @param keys the keys positions were sorted by, updated to the current keys on output
+	 */
+	template<typename T, typename POSTYPE>
+	static void resortChangedPositions(const std::vector<T>& vec,
+			std::vector<POSTYPE> & positions, std::vector<CountErrorKey> & keys) {
+		std::vector<POSTYPE> unchanged;
+		std::vector<POSTYPE> changed;
+		unchanged.reserve(positions.size());
+		for (const auto pos : positions) {
+			auto currentKey = genCountErrorKey(vec[pos]);
+			if (currentKey == keys[pos]) {
+				unchanged.emplace_back(pos);
+			} else {
+				keys[pos] = currentKey;
+				changed.emplace_back(pos);
+			}
+		}
+		if (changed.empty()) {
+			return;
+		}
+		auto keyComp = [&keys](POSTYPE pos1, POSTYPE pos2) {
+			return keys[pos1] < keys[pos2];
+		};
+		std::stable_sort(changed.begin(), changed.end(), keyComp);
+		std::merge(unchanged.begin(), unchanged.end(), changed.begin(), changed.end(),
+				positions.begin(), keyComp);
 	}
 
   // sorting functions
@@ -191,27 +395,22 @@ class readVecSorter {
 
   template <typename T>
   static void sortByTotalCountAE(std::vector<T>& vec, bool decending) {
-  	sortReadVectorFunc<T>(vec, [](const T& first, const T& second) -> bool{
-  		/*
-			if (getSeqBase(first).cnt_ == getSeqBase(second).cnt_) {
-				if (getRef(first).averageErrorRate < getRef(second).averageErrorRate) {
-					return true;
-				} else {
-					return false;
-				}
-			} else {
-				return getSeqBase(first).cnt_ > getSeqBase(second).cnt_;
-			}*/
-  		if (roundDecPlaces(getSeqBase(first).cnt_, 2) == roundDecPlaces(getSeqBase(second).cnt_, 2) ) {
-  			if (roundDecPlaces(getRef(first).averageErrorRate, 4)  < roundDecPlaces(getRef(second).averageErrorRate, 4) ) {
-  				return true;
-  			} else {
-  				return false;
-  			}
-  		} else {
-  			return roundDecPlaces(getSeqBase(first).cnt_, 4)  > roundDecPlaces(getSeqBase(second).cnt_, 4) ;
-  		}
-    }, decending);
+		//the rounding is done once per element rather than on every comparison
+		struct TotalCountAEKey {
+			double cnt2_;
+			double cnt4_;
+			double averageErrorRate4_;
+		};
+		sortReadVectorByKey(vec, [](const T& read) {
+			return TotalCountAEKey { roundDecPlaces(getSeqBase(read).cnt_, 2),
+					roundDecPlaces(getSeqBase(read).cnt_, 4),
+					roundDecPlaces(getRef(read).averageErrorRate, 4) };
+		}, [](const TotalCountAEKey & first, const TotalCountAEKey & second) -> bool {
+			if (first.cnt2_ == second.cnt2_) {
+				return first.averageErrorRate4_ < second.averageErrorRate4_;
+			}
+			return first.cnt4_ > second.cnt4_;
+		}, decending);
   }
 
   template <typename T>
@@ -18,6 +18,7 @@
 // along with njhseq.  If not, see <http://www.gnu.org/licenses/>.
 //
 #include "readVecTrimmer.hpp"
+#include "njhseq/helpers/SeqKernels.hpp"
 
 
 
@@ -140,10 +141,12 @@ void readVecTrimmer::trimToMaxLength(seqInfo &seq, size_t maxLength) {
 
 void readVecTrimmer::trimAtFirstQualScore(seqInfo &seq,
 		const uint32_t qualCutOff) {
-	auto iter = std::find_if(seq.qual_.begin(), seq.qual_.end(),
-			[&qualCutOff](uint32_t qual) {return qual <= qualCutOff;});
-	if (seq.qual_.end() != iter) {
-		seq.trimBack(iter - seq.qual_.begin());
+	//at or below qualCutOff is below qualCutOff + 1, any cut off of 255 or more trims every quality
+	const uint32_t cutOff = qualCutOff < std::numeric_limits<uint8_t>::max() ?
+			qualCutOff + 1 : std::numeric_limits<uint8_t>::max() + 1;
+	const auto pos = SeqKernels::findFirstQualBelow(seq.qual_, cutOff);
+	if (seq.qual_.size() != pos) {
+		seq.trimBack(pos);
 	}
 }
 
@@ -283,8 +283,8 @@ bool checkIfReadVecsAreSame(const std::vector<T> & reads1,
 		}
 		if(reads1[readPos].seqBase_.qual_ != reads2[readPos].seqBase_.qual_){
 			std::cout << "failed qual_ on read " << readPos << std::endl;
-			std::cout << "qual_ of 1: " << njh::conToStr(reads1[readPos].seqBase_.qual_,",") << std::endl;
-			std::cout << "qual_ of 2: " << njh::conToStr(reads2[readPos].seqBase_.qual_,",") << std::endl;
+			std::cout << "qual_ of 1: " << QualityScores::toString(reads1[readPos].seqBase_.qual_,",") << std::endl;
+			std::cout << "qual_ of 2: " << QualityScores::toString(reads2[readPos].seqBase_.qual_,",") << std::endl;
 			return false;
 		}
 		if(reads1[readPos].seqBase_.frac_ != reads2[readPos].seqBase_.frac_){
@@ -0,0 +1,172 @@
+#pragma once
+/*
+ * AlignerDistCalc.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: nick
+ */
+//
+// njhseq - A library for analyzing sequence data
+// Copyright (C) 2012-2018 Nicholas Hathaway <nicholas.hathaway@umassmed.edu>,
+//
+// This file is part of njhseq.
+//
+// njhseq is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// njhseq is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with njhseq.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "njhseq/utils.h"
+#include "njhseq/concurrency/PairwisePairFactory.hpp"
+#include "njhseq/concurrency/pools/AlignerPool.hpp"
+#include "njhseq/objects/kmer/KmerCandidatePairIndex.hpp"
+#include "njhseq/seqToolsUtils/distCalc.hpp"
+
+namespace njhseq {
+
+/**@brief Compute a lower triangular distance matrix where each comparison needs an aligner
+ *
+ * Each worker thread pops one aligner from the pool and keeps it for its whole
+ * lifetime so no locking is needed per comparison, the only shared state is the
+ * PairwisePairFactory which hands out comparisons in batches
+ *
+ * @param vec the elements to compare
+ * @param alnPool the pool to get the per thread aligners from, should already be initialized
+ * @param numThreads the number of threads to use
+ * @param func the distance function, given the two elements and the aligner for the current thread
+ * @param batchAmount the number of comparisons each thread takes at a time
+ * @return a distance matrix where ret[row][col] holds the distance between vec[row] and vec[col] for col < row
+ */
+template<typename T, typename RET>
+std::vector<std::vector<RET>> getDistanceWithAlignerPool(const std::vector<T> & vec,
+		concurrent::AlignerPool & alnPool, uint32_t numThreads,
+		const std::function<RET(const T & e1, const T& e2, aligner & alignerObj)> & func,
+		uint32_t batchAmount = 100) {
+	std::vector<std::vector<RET>> ret;
+	ret.reserve(vec.size());
+	for (const auto pos : iter::range(vec.size())) {
+		ret.emplace_back(std::vector<RET>(pos));
+	}
+	PairwisePairFactory pFactory(vec.size());
+	auto computeDists = [&vec, &ret, &alnPool, &pFactory, &func, batchAmount]() {
+		auto alignerObj = alnPool.popAligner();
+		PairwisePairFactory::PairwisePairVec pairs;
+		while (pFactory.setNextPairs(pairs, batchAmount)) {
+			for (const auto & pair : pairs.pairs_) {
+				//each cell is only ever set by one thread so no lock is needed
+				ret[pair.row_][pair.col_] = func(vec[pair.row_], vec[pair.col_], *alignerObj);
+			}
+		}
+	};
+	uint32_t threadsToUse = std::max<uint32_t>(1, numThreads);
+	if (1 == threadsToUse) {
+		computeDists();
+	} else {
+		std::vector<std::thread> threads;
+		for (uint32_t t = 0; t < threadsToUse; ++t) {
+			threads.emplace_back(computeDists);
+		}
+		njh::concurrent::joinAllJoinableThreads(threads);
+	}
+	return ret;
+}
+
+/**@brief Compute a lower triangular distance matrix where each comparison needs an aligner, each thread gets it's own copy of alignerObj
+ *
+ * After all comparisons are done, the alignment caches of the thread aligners are merged back into alignerObj
+ *
+ * @param vec the elements to compare
+ * @param alignerObj the aligner to copy for each thread and to merge the alignment caches back into
+ * @param numThreads the number of threads to use
+ * @param func the distance function, given the two elements and the aligner for the current thread
+ * @return a distance matrix where ret[row][col] holds the distance between vec[row] and vec[col] for col < row
+ */
+template<typename T, typename RET>
+std::vector<std::vector<RET>> getDistanceWithAligner(const std::vector<T> & vec,
+		aligner & alignerObj, uint32_t numThreads,
+		const std::function<RET(const T & e1, const T& e2, aligner & alignerObj)> & func) {
+	uint32_t threadsToUse = std::max<uint32_t>(1, numThreads);
+	concurrent::AlignerPool alnPool(alignerObj, threadsToUse);
+	alnPool.initAligners();
+	auto ret = getDistanceWithAlignerPool(vec, alnPool, threadsToUse, func);
+	alnPool.mergeAlnCachesInto(alignerObj);
+	return ret;
+}
+
+/**@brief Compute only the distances between elements that could be within a number of edits of each other
+ *
+ * Candidate pairs are generated with a KmerCandidatePairIndex so only those pairs are aligned,
+ * and only the distances that pass keepFunc are stored, so memory scales with the number of kept distances rather than n^2
+ *
+ * @param vec the elements to compare
+ * @param alnPool the pool to get the per thread aligners from, should already be initialized
+ * @param numThreads the number of threads to use
+ * @param candidatePars the parameters for the kmer candidate filter, pairs within candidatePars.maxEdits_ edits (or minIdentity_) are never missed
+ * @param func the distance function, given the two elements and the aligner for the current thread
+ * @param keepFunc whether to keep a computed distance
+ * @param batchAmount the number of rows each thread takes at a time
+ * @return the kept distances sorted by row then col
+ */
+template<typename T, typename RET>
+std::vector<SparseDistance<RET>> getSparseDistanceWithAlignerPool(const std::vector<T> & vec,
+		concurrent::AlignerPool & alnPool, uint32_t numThreads,
+		const KmerCandidatePairIndex::Pars & candidatePars,
+		const std::function<RET(const T & e1, const T& e2, aligner & alignerObj)> & func,
+		const std::function<bool(const RET & dist)> & keepFunc,
+		uint32_t batchAmount = 10) {
+	KmerCandidatePairIndex candidateIndex(candidatePars);
+	candidateIndex.index(vec);
+	std::vector<SparseDistance<RET>> ret;
+	std::vector<uint32_t> positions(vec.size());
+	njh::iota<uint32_t>(positions, 0);
+	njh::concurrent::LockableQueue<uint32_t> posQueue(positions);
+	std::mutex retMut;
+	auto computeDists = [&vec, &ret, &alnPool, &posQueue, &candidateIndex, &func, &keepFunc, &retMut, batchAmount]() {
+		auto alignerObj = alnPool.popAligner();
+		std::vector<uint32_t> sharedBuffer(vec.size(), 0);
+		std::vector<uint32_t> candidates;
+		std::vector<uint32_t> subPositions;
+		std::vector<SparseDistance<RET>> currentDists;
+		while (posQueue.getVals(subPositions, batchAmount)) {
+			for (const auto pos : subPositions) {
+				candidateIndex.setCandidatesForSeq(pos, sharedBuffer, candidates);
+				for (const auto otherPos : candidates) {
+					auto dist = func(vec[pos], vec[otherPos], *alignerObj);
+					if (keepFunc(dist)) {
+						currentDists.emplace_back(SparseDistance<RET>{pos, otherPos, dist});
+					}
+				}
+			}
+		}
+		std::lock_guard<std::mutex> lock(retMut);
+		ret.insert(ret.end(), std::make_move_iterator(currentDists.begin()),
+				std::make_move_iterator(currentDists.end()));
+	};
+	uint32_t threadsToUse = std::max<uint32_t>(1, numThreads);
+	if (1 == threadsToUse) {
+		computeDists();
+	} else {
+		std::vector<std::thread> threads;
+		for (uint32_t t = 0; t < threadsToUse; ++t) {
+			threads.emplace_back(computeDists);
+		}
+		njh::concurrent::joinAllJoinableThreads(threads);
+	}
+	//threads finish in any order so sort to keep the output deterministic
+	std::sort(ret.begin(), ret.end(),
+			[](const SparseDistance<RET> & dist1, const SparseDistance<RET> & dist2) {
+				return dist1.row_ == dist2.row_ ? dist1.col_ < dist2.col_ : dist1.row_ < dist2.row_;
+			});
+	return ret;
+}
+
+}  // namespace njhseq
+
@@ -41,6 +41,39 @@ public:
 		uint32_t batchAmount_ = 1;
 	};
 
+	/**@brief Score inputSeq against the refs at refPositions, the alignment score if pars.scoreBased_ otherwise the event based identity
+	 *
+	 * Alignment scores are done in one batch with aligner::alignOneToMany()
+	 *
+	 * @return the scores in the order of refPositions
+	 */
+	template<typename SEQTYPE,typename REFTYPE>
+	static std::vector<double> scoreRefs(
+			const SEQTYPE & inputSeq,
+			const std::vector<REFTYPE> & refSeqs,
+			const std::vector<uint32_t> & refPositions,
+			aligner & alignerObj,
+			const FindBestRefPars & pars){
+		std::vector<double> ret;
+		ret.reserve(refPositions.size());
+		if(pars.scoreBased_){
+			std::vector<const seqInfo *> refs;
+			refs.reserve(refPositions.size());
+			for(const auto refPos : refPositions){
+				refs.emplace_back(&getSeqBase(refSeqs[refPos]));
+			}
+			const auto alns = alignerObj.alignOneToMany(inputSeq, refs);
+			ret.insert(ret.end(), alns.scores_.begin(), alns.scores_.end());
+		}else{
+			for(const auto refPos : refPositions){
+				alignerObj.alignCacheGlobal(refSeqs[refPos], inputSeq);
+				alignerObj.profileAlignment(refSeqs[refPos], inputSeq, false, true, false);
+				ret.emplace_back(alignerObj.comp_.distances_.eventBasedIdentity_);
+			}
+		}
+		return ret;
+	}
+
 	template<typename SEQTYPE,typename REFTYPE>
 	static std::vector<comparison> findBestRef(
 			const SEQTYPE & inputSeq,
@@ -53,7 +86,12 @@ public:
     std::vector<uint32_t> bestRefs;
     double currentKmerCutOff = pars.kmerCutOff_;
     bool run = true;
+    {
+    //only the comparisons are needed while searching, so skip building the gapped sequences and recording the errors
+    aligner::NoGappedAlignmentGuard noGappedGuard(alignerObj);
+    aligner::CountsOnlyProfileGuard countsOnlyGuard(alignerObj);
     while(run){
+	    std::vector<uint32_t> refPositions;
 	    for (const auto& refPos : iter::range(refSeqs.size())) {
 	      const auto & ref = refSeqs[refPos];
 	      if (getSeqBase(ref).name_ == getSeqBase(inputSeq).name_) {
@@ -62,14 +100,12 @@ public:
 	      if(refInfos[refPos].compareKmers(inputKInfo).second < currentKmerCutOff){
 	       	continue;
 	      }
-				alignerObj.alignCacheGlobal(ref, inputSeq);
-				double currentScore = 0;
-				if(!pars.scoreBased_) {
-					alignerObj.profileAlignment(ref, inputSeq, false, true, false);
-					currentScore = alignerObj.comp_.distances_.eventBasedIdentity_;
-				} else {
-					currentScore = alignerObj.parts_.score_;
-				}
+	      refPositions.emplace_back(refPos);
+	    }
+	    const auto refScores = scoreRefs(inputSeq, refSeqs, refPositions, alignerObj, pars);
+	    for (const auto& scorePos : iter::range(refPositions.size())) {
+	    	const auto refPos = refPositions[scorePos];
+				const double currentScore = refScores[scorePos];
 				if (currentScore == bestScore) {
 					bestRefs.push_back(refPos);
 				}
@@ -84,6 +120,7 @@ public:
 	    		run = true;
 	    }
 	    currentKmerCutOff -= 0.1;
+    }
     }
 		std::vector<comparison> comps;
 		for (const auto& bestPos : bestRefs) {
@@ -115,12 +152,17 @@ public:
 	  auto compareInput = [&alnPool,&inputSeqs,&refSeqs,&posQueue,&pars,&mut,&ret](){
 	  	std::vector<uint32_t> subPositions;
 	  	auto curAligner = alnPool.popAligner();
+	  	//only the comparisons are kept, so skip building the gapped sequences
+	  	aligner::NoGappedAlignmentGuard noGappedGuard(*curAligner);
 	  	std::vector<kmerInfo> refInfos;
 	  	for (const auto& refPos : iter::range(refSeqs.size())){
 	  		refInfos.emplace_back(getSeqBase(refSeqs[refPos]).seq_, pars.kmerLen_, false);
 	  	}
 	  	while(posQueue.getVals(subPositions, pars.batchAmount_)){
 	  		std::unordered_map<uint32_t, std::vector<uint32_t>> bestRefsForPos;
+	  		{
+	  		//the errors are only needed for the comparisons kept below
+	  		aligner::CountsOnlyProfileGuard countsOnlyGuard(*curAligner);
 			for(const auto pos : iter::reversed(subPositions)){
 					const auto & input = inputSeqs[pos];
 					kmerInfo inputKInfo(getSeqBase(input).seq_, pars.kmerLen_, false);
@@ -129,6 +171,7 @@ public:
 			    double currentKmerCutOff = pars.kmerCutOff_;
 			    bool run = true;
 			    while(run){
+				    std::vector<uint32_t> refPositions;
 				    for (const auto& refPos : iter::range(refSeqs.size())) {
 				      const auto & ref = refSeqs[refPos];
 				      if (getSeqBase(ref).name_ == getSeqBase(input).name_) {
@@ -137,14 +180,12 @@ public:
 				      if(refInfos[refPos].compareKmers(inputKInfo).second < currentKmerCutOff){
 				       	continue;
 				      }
-							curAligner->alignCacheGlobal(ref, input);
-							double currentScore = 0;
-							if(!pars.scoreBased_) {
-								curAligner->profileAlignment(ref, input, false, true, false);
-								currentScore = curAligner->comp_.distances_.eventBasedIdentity_;
-							} else {
-								currentScore = curAligner->parts_.score_;
-							}
+				      refPositions.emplace_back(refPos);
+				    }
+				    const auto refScores = scoreRefs(input, refSeqs, refPositions, *curAligner, pars);
+				    for (const auto& scorePos : iter::range(refPositions.size())) {
+				    	const auto refPos = refPositions[scorePos];
+							const double currentScore = refScores[scorePos];
 							if (currentScore == bestScore) {
 								bestRefs.push_back(refPos);
 							}
@@ -163,6 +204,7 @@ public:
 				    currentKmerCutOff -= 0.1;
 			    }
 				}
+	  		}
 				{
 					std::lock_guard<std::mutex> lock(mut);
 					for(const auto & bestRefs : bestRefsForPos) {
@@ -28,6 +28,16 @@
 
 namespace njhseq {
 
+/**@brief A single entry of a sparse lower triangular distance matrix, row_ > col_
+ *
+ */
+template<typename DIST>
+struct SparseDistance {
+	uint32_t row_;
+	uint32_t col_;
+	DIST dist_;
+};
+
 
 template<typename T, typename RET, typename... Args>
 void paritialDis(const std::vector<T> & vec,
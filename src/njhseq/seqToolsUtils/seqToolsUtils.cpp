@@ -204,73 +204,47 @@ std::string genHtmlStrForPsuedoMintree(std::string jsonFileName, std::string jav
 }
 
 Json::Value genMinTreeData(const std::vector<readObject> & reads,
-		aligner & alignerObj,
-		std::unordered_map<std::string, std::unique_ptr<aligner>>& aligners,
-		std::mutex & alignerLock, uint32_t numThreads) {
-
-	std::function<
-			uint32_t(const readObject &, const readObject &,
-					std::unordered_map<std::string, std::unique_ptr<aligner>>&, aligner&)> getMismatchesFunc =
-			[&alignerLock](const readObject & read1, const readObject & read2,std::unordered_map<std::string, std::unique_ptr<aligner>>& aligners, aligner &alignerObj) {
-				alignerLock.lock();
-				auto threadId = estd::to_string(std::this_thread::get_id());
-				//std::cout << threadId<< std::endl;
-				if(aligners.find(threadId) == aligners.end()) {
-					aligners.emplace(threadId, std::make_unique<aligner>(alignerObj));
-				}
-				alignerLock.unlock();
-				aligners.at(threadId)->alignCache(read1.seqBase_,read2.seqBase_, false);
-				aligners.at(threadId)->profilePrimerAlignment(read1.seqBase_, read2.seqBase_);
-				return aligners.at(threadId)->comp_.hqMismatches_;
+		aligner & alignerObj, uint32_t numThreads,
+		const KmerCandidatePairIndex::Pars * sparsePars) {
+	std::function<uint32_t(const readObject &, const readObject &, aligner &)> getMismatchesFunc =
+			[](const readObject & read1, const readObject & read2, aligner & alignerObj) {
+				alignerObj.alignCache(read1.seqBase_,read2.seqBase_, false);
+				alignerObj.profilePrimerAlignment(read1.seqBase_, read2.seqBase_);
+				return alignerObj.comp_.hqMismatches_;
 			};
-	auto distances = getDistanceNonConst(reads, numThreads, getMismatchesFunc,
-			aligners, alignerObj);
-	readDistGraph<uint32_t> graphMis(distances, reads);
+	std::unique_ptr<readDistGraph<uint32_t>> graphMis;
+	if (nullptr != sparsePars) {
+		uint32_t threadsToUse = std::max<uint32_t>(1, numThreads);
+		concurrent::AlignerPool alnPool(alignerObj, threadsToUse);
+		alnPool.initAligners();
+		std::function<bool(const uint32_t &)> keepAll = [](const uint32_t &) {
+			return true;
+		};
+		auto distances = getSparseDistanceWithAlignerPool(reads, alnPool,
+				threadsToUse, *sparsePars, getMismatchesFunc, keepAll);
+		alnPool.mergeAlnCachesInto(alignerObj);
+		graphMis = std::make_unique<readDistGraph<uint32_t>>(distances, reads);
+	} else {
+		auto distances = getDistanceWithAligner(reads, alignerObj, numThreads, getMismatchesFunc);
+		graphMis = std::make_unique<readDistGraph<uint32_t>>(distances, reads);
+	}
 	std::vector<std::string> popNames;
-	for (const auto & n : graphMis.nodes_) {
+	for (const auto & n : graphMis->nodes_) {
 		popNames.emplace_back(n->name_);
 	}
 	auto nameColors = getColorsForNames(popNames);
-	auto ret = graphMis.toJsonMismatchGraphAll(njh::color("#000000"), nameColors);
-	return ret;
+	return graphMis->toJsonMismatchGraphAll(njh::color("#000000"), nameColors);
 }
 
+Json::Value genMinTreeData(const std::vector<readObject> & reads,
+		aligner & alignerObj,
+		std::unordered_map<std::string, std::unique_ptr<aligner>>& /*aligners*/,
+		std::mutex & /*alignerLock*/, uint32_t numThreads) {
+	return genMinTreeData(reads, alignerObj, numThreads);
+}
 
 Json::Value genMinTreeData(const std::vector<readObject> & reads, aligner & alignerObj){
-	std::unordered_map<std::string, std::unique_ptr<aligner>> aligners;
-	uint32_t numThreads = 2;
-	std::mutex alignerLock;
-	std::function<uint32_t(const readObject &, const readObject &,std::unordered_map<std::string, std::unique_ptr<aligner>>& , aligner& )> getMismatchesFunc =
-			[&alignerLock](const readObject & read1, const readObject & read2,std::unordered_map<std::string, std::unique_ptr<aligner>>&  aligners, aligner &alignerObj) {
-		alignerLock.lock();
-		auto threadId = estd::to_string(std::this_thread::get_id());
-		//std::cout << threadId<< std::endl;
-		if(aligners.find(threadId) == aligners.end()){
-			aligners.emplace(threadId, std::make_unique<aligner>(alignerObj));
-		}
-		alignerLock.unlock();
-		aligners.at(threadId)->alignCache(read1.seqBase_,read2.seqBase_, false);
-		aligners.at(threadId)->profilePrimerAlignment(read1.seqBase_, read2.seqBase_);
-				return aligners.at(threadId)->comp_.hqMismatches_;
-			};
-
-	auto distances = getDistanceNonConst(reads, numThreads, getMismatchesFunc, aligners, alignerObj);
-	readDistGraph<uint32_t> graphMis(distances, reads);
-	std::vector<std::string> popNames;
-	for (const auto & n : graphMis.nodes_) {
-		popNames.emplace_back(n->name_);
-	}
-	bool debug = false;
-	auto nameColors = getColorsForNames(popNames);
-	for(const auto & alnObj : aligners){
-		if(debug){
-			std::cout << alnObj.first << ": " << alnObj.second->numberOfAlingmentsDone_ << std::endl;
-		}
-		if(alnObj.second->numberOfAlingmentsDone_ > 0){
-			alignerObj.alnHolder_.mergeOtherHolder(alnObj.second->alnHolder_);
-		}
-	}
-	return graphMis.toJsonMismatchGraphAll(njh::color("#000000"), nameColors);
+	return genMinTreeData(reads, alignerObj, 2);
 }
 
 Json::Value genMinTreeData(const std::vector<readObject> & reads) {
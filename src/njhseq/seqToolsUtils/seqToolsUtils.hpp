@@ -51,41 +51,11 @@ uint32_t processRunCutoff(const std::string& runCutOffString, uint64_t counter);
 
 template<typename T>
 Json::Value genDetailMinTreeData(const std::vector<T> & reads,
-		uint32_t numThreads) {
-	uint64_t maxSize = 0;
-	readVec::getMaxLength(reads, maxSize);
-	aligner alignerObj(maxSize, gapScoringParameters(5, 1),
-			substituteMatrix(2, -2));
-	std::unordered_map<std::string, std::unique_ptr<aligner>> aligners;
-	std::mutex alignerLock;
-	return genDetailMinTreeData(reads, alignerObj, aligners, alignerLock,
-			numThreads, comparison(), false, false, false);
-}
-
-template<typename T>
-Json::Value genDetailMinTreeData(const std::vector<T> & reads,
-		uint32_t numThreads,
-		const comparison &allowableErrors, bool settingEventsLimits) {
-	uint64_t maxSize = 0;
-	readVec::getMaxLength(reads, maxSize);
-	aligner alignerObj(maxSize, gapScoringParameters(5, 1),
-			substituteMatrix(2, -2));
-	std::unordered_map<std::string, std::unique_ptr<aligner>> aligners;
-	std::mutex alignerLock;
-	return genDetailMinTreeData(reads, alignerObj, aligners, alignerLock,
-			numThreads, allowableErrors, settingEventsLimits, false, false);
-}
-
-template<typename T>
-Json::Value genDetailMinTreeData(const std::vector<T> & reads,
-		aligner & alignerObj,
-		std::unordered_map<std::string, std::unique_ptr<aligner>>& aligners,
-		std::mutex & alignerLock, uint32_t numThreads,
+		aligner & alignerObj, uint32_t numThreads,
 		const comparison &allowableErrors, bool settingEventsLimits,
 		bool justBest, bool doTies
 		){
-	auto graph = genReadComparisonGraph(reads, alignerObj, aligners, alignerLock,
-			numThreads);
+	auto graph = genReadComparisonGraph(reads, alignerObj, numThreads);
 	std::vector<std::string> popNames;
 	for (const auto & n : graph.nodes_) {
 		if (n->on_) {
@@ -118,6 +88,45 @@ Json::Value genDetailMinTreeData(const std::vector<T> & reads,
 	return treeData;
 }
 
+/**@brief Older interface kept so existing callers still compile, the aligner map and lock are not used, per thread aligners now come from an AlignerPool
+ *
+ */
+template<typename T>
+[[deprecated("the aligner map and lock are unused, call genDetailMinTreeData(reads, alignerObj, numThreads, ...)")]]
+Json::Value genDetailMinTreeData(const std::vector<T> & reads,
+		aligner & alignerObj,
+		std::unordered_map<std::string, std::unique_ptr<aligner>>& /*aligners*/,
+		std::mutex & /*alignerLock*/, uint32_t numThreads,
+		const comparison &allowableErrors, bool settingEventsLimits,
+		bool justBest, bool doTies
+		){
+	return genDetailMinTreeData(reads, alignerObj, numThreads, allowableErrors,
+			settingEventsLimits, justBest, doTies);
+}
+
+template<typename T>
+Json::Value genDetailMinTreeData(const std::vector<T> & reads,
+		uint32_t numThreads) {
+	uint64_t maxSize = 0;
+	readVec::getMaxLength(reads, maxSize);
+	aligner alignerObj(maxSize, gapScoringParameters(5, 1),
+			substituteMatrix(2, -2));
+	return genDetailMinTreeData(reads, alignerObj, numThreads, comparison(),
+			false, false, false);
+}
+
+template<typename T>
+Json::Value genDetailMinTreeData(const std::vector<T> & reads,
+		uint32_t numThreads,
+		const comparison &allowableErrors, bool settingEventsLimits) {
+	uint64_t maxSize = 0;
+	readVec::getMaxLength(reads, maxSize);
+	aligner alignerObj(maxSize, gapScoringParameters(5, 1),
+			substituteMatrix(2, -2));
+	return genDetailMinTreeData(reads, alignerObj, numThreads, allowableErrors,
+			settingEventsLimits, false, false);
+}
+
 template<typename T>
 uint32_t getMismatches(const T & read1,
 				const T & read2,
@@ -126,6 +135,21 @@ uint32_t getMismatches(const T & read1,
 	alignerObj.profilePrimerAlignment(read1.seqBase_, read2.seqBase_);
 	return alignerObj.comp_.hqMismatches_;
 };
+/**@brief Generate the json for a minimum spanning tree of the reads based on high quality mismatches
+ *
+ * @param reads the reads to compare
+ * @param alignerObj the aligner to copy per thread
+ * @param numThreads number of threads to use
+ * @param sparsePars if not null only the pairs passing this kmer candidate filter are aligned, otherwise every pair is
+ * @return the tree data for drawing
+ */
+Json::Value genMinTreeData(const std::vector<readObject> & reads,
+		aligner & alignerObj, uint32_t numThreads,
+		const KmerCandidatePairIndex::Pars * sparsePars = nullptr);
+/**@brief Older interface kept so existing callers still compile, the aligner map and lock are not used
+ *
+ */
+[[deprecated("the aligner map and lock are unused, call genMinTreeData(reads, alignerObj, numThreads)")]]
 Json::Value genMinTreeData(const std::vector<readObject> & reads,
 		aligner & alignerObj,
 		std::unordered_map<std::string, std::unique_ptr<aligner>>& aligners,
@@ -295,7 +319,7 @@ uint32_t seqQualSizeAgreementCheck(const std::vector<T>& reads) {
     if (read.seqBase_.seq_.size() != read.seqBase_.qual_.size()) {
       std::cout << "name:" << read.seqBase_.name_ << std::endl;
       std::cout << "seq:" << read.seqBase_.seq_ << std::endl;
-      std::cout << "qual:" << read.seqBase_.qual_ << std::endl;
+      std::cout << "qual:" << QualityScores::toString(read.seqBase_.qual_, ", ") << std::endl;
       std::cout << "sSize:" << read.seqBase_.seq_.size() << std::endl;
       std::cout << "qSize:" << read.seqBase_.qual_.size() << std::endl;
       ++count;
@@ -29,42 +29,7 @@ namespace njhseq {
 
 
 alnInfoGlobal Muscler::genGlobalAlnInfo(const std::string & seq){
-	uint64_t pos = 0;
-	uint32_t gapOffSet = 0;
-	uint32_t gapSize = 0;
-	uint32_t gapStartSiteInSeq = 0;
-	//first is pos, second is gap size
-	std::vector<std::pair<uint32_t, uint32_t>> gapInfos;
-	while(pos != seq.size()){
-		if(seq[pos] == '-'){
-			if(gapSize == 0){
-				gapStartSiteInSeq = pos - gapOffSet;
-			}
-			++gapSize;
-			++gapOffSet;
-		} else {
-			//log gap if currently building one
-			if(gapSize > 0){
-				gapInfos.emplace_back(gapStartSiteInSeq, gapSize);
-			}
-			//reset
-			gapSize = 0;
-			gapStartSiteInSeq = 0;
-		}
-		++pos;
-	}
-	if(gapSize > 0){
-		gapInfos.emplace_back(gapStartSiteInSeq, gapSize);
-	}
-	//sort backwards and add appropriate number of zeros, starting from back so pos is not invalidated
-	std::sort(gapInfos.begin(),
-			gapInfos.end(), [](const std::pair<uint32_t, uint32_t> & p1,
-					const std::pair<uint32_t, uint32_t> & p2){ return p1.first > p2.first;});
-	std::vector<gapInfo> gInfos;
-	for(const auto & g : gapInfos){
-		gInfos.emplace_back(gapInfo(g.first, g.second, false));
-	}
-	return alnInfoGlobal(gInfos, 1, false);
+	return ProgressiveAligner::genGlobalAlnInfo(seq);
 }
 
 
@@ -72,21 +37,90 @@ Muscler::Muscler(const bfs::path & musclePath) {
 	setMusclePath(musclePath);
 }
 
-Muscler::Muscler() :
-		Muscler("muscle") {
+Muscler::Muscler() {
 }
 
 void Muscler::setMusclePath(const bfs::path & musclePath) {
-	musclePath_ = musclePath;
-	auto hasProgram = njh::sys::hasSysCommand(musclePath_.string());
+	auto hasProgram = njh::sys::hasSysCommand(musclePath.string());
 	if (!hasProgram) {
 		std::stringstream ss;
-		ss << njh::bashCT::boldBlack(musclePath_.string())
+		ss << njh::bashCT::boldBlack(musclePath.string())
 				<< njh::bashCT::boldRed(
 						" is not in path or may not be executable, cannot be used")
 				<< "\n";
 		throw std::runtime_error { ss.str() };
 	}
+	musclePath_ = musclePath;
+	useMuscle_ = true;
+}
+
+bool Muscler::usingMuscle() const {
+	return useMuscle_;
+}
+
+std::vector<seqInfo> Muscler::alignRaw(const std::vector<seqInfo> & seqs) const {
+	std::vector<seqInfo> ret;
+	if (!useMuscle_) {
+		std::vector<std::string> strs;
+		for (const auto & seq : seqs) {
+			strs.emplace_back(seq.seq_);
+		}
+		auto alnStrs = progAligner_.alignStrs(strs);
+		for (const auto pos : iter::range(seqs.size())) {
+			ret.emplace_back(seqs[pos].name_, alnStrs[pos]);
+		}
+		return ret;
+	}
+	//create temporary file, the last 6 xs will be randomized characters
+	std::string tmpname = njh::files::make_path(workingPath_, "tmpfileXXXXXX").string();
+	auto mkTempRet = mkstemp(&tmpname[0]);
+	if(-1 == mkTempRet){
+		std::stringstream sErr;
+		sErr << __PRETTY_FUNCTION__ << ", error in creating file name from template " << tmpname << "\n";
+		throw std::runtime_error{sErr.str()};
+	}
+	close(mkTempRet);
+	{
+		//in it's own scope so that that tFile gets flushed at termination
+		std::ofstream tFile(tmpname);
+		if(!tFile){
+			throw std::runtime_error{njh::bashCT::boldRed("Error in opening " + tmpname)};
+		}
+		for (const auto & seq : seqs) {
+			tFile << ">" << seq.name_ << "\n";
+			tFile << seq.seq_ << "\n";
+		}
+	}
+	try {
+		std::vector<std::string> cmds { musclePath_.string(), "-quiet", "-in", tmpname };
+		auto rOut = njh::sys::run(cmds);
+		if(!rOut.success_){
+			std::stringstream sErr;
+			sErr << __PRETTY_FUNCTION__ << ", error " << "\n";
+			sErr << rOut.stdOut_ << std::endl;
+			sErr << njh::bashCT::red << "failure:" << std::endl;
+			sErr << rOut.stdErr_ << std::endl;
+			sErr << njh::bashCT::reset << std::endl;
+			throw std::runtime_error{sErr.str()};
+		}
+		std::stringstream ss(rOut.stdOut_);
+		SeqIOOptions opts;
+		SeqInput reader(opts);
+		seqInfo seq;
+		while(reader.readNextFastaStream(ss, seq,false)){
+			ret.emplace_back(seq);
+		}
+	} catch (std::exception & e) {
+		std::cerr << e.what() << std::endl;
+		if(!keepTemp_){
+			njh::files::bfs::remove(tmpname);
+		}
+		throw std::runtime_error{e.what()};
+	}
+	if(!keepTemp_){
+		njh::files::bfs::remove(tmpname);
+	}
+	return ret;
 }
 
 std::vector<seqInfo> Muscler::muscleSeqs(const SeqIOOptions & opts){
@@ -28,28 +28,54 @@
 #include "njhseq/alignment/alnCache/alnInfoGlobal.hpp"
 #include "njhseq/IO/SeqIO/SeqInput.hpp"
 #include "njhseq/alignment/aligner/alignCalc.hpp"
+#include "njhseq/alignment/multipleAlignment/ProgressiveAligner.hpp"
 #include "njhseq/readVectorManipulation/readVectorHelpers/readVecTrimmer.hpp"
 #include "njhseq/seqToolsUtils/seqToolsUtils.hpp"
 
 namespace njhseq {
 
 
+/**@brief Multiple alignment of sequences, done in process with ProgressiveAligner unless a muscle path is given, then the external muscle program is called
+ *
+ */
 class Muscler{
 public:
 	static alnInfoGlobal genGlobalAlnInfo(const std::string & seq);
 private:
 	bfs::path musclePath_;
+	bool useMuscle_ = false;
+
+	/**@brief Align seqs with muscle if a muscle path was set or with progAligner_ otherwise
+	 *
+	 * @param seqs the ungapped sequences, named so the aligned seqs can be matched back up as muscle reorders them
+	 * @return the aligned seqs
+	 */
+	std::vector<seqInfo> alignRaw(const std::vector<seqInfo> & seqs) const;
 public:
-	bfs::path workingPath_ = "/tmp/";
+	bfs::path workingPath_ = "/tmp/"; /**< where the temporary input for muscle is written */
 	bool keepTemp_ = false;
+	ProgressiveAligner progAligner_; /**< does the aligning when muscle isn't being used */
 
-
+	/**@brief Use the external muscle program at musclePath, throws if it can't be found
+	 *
+	 */
 	Muscler(const bfs::path & musclePath);
 
+	/**@brief Align in process with ProgressiveAligner
+	 *
+	 */
 	Muscler();
 
+	/**@brief Switch to calling the external muscle program at musclePath, throws if it can't be found
+	 *
+	 */
 	void setMusclePath(const bfs::path & musclePath);
 
+	/**@brief Whether the external muscle program is being called rather than ProgressiveAligner
+	 *
+	 */
+	bool usingMuscle() const;
+
 	/**@brief run muscle on this file
 	 *
 	 * @param filename name of the fasta file
@@ -76,90 +102,44 @@ public:
 	template<typename T, typename POSTYPE>
 	void muscleSeqs(std::vector<T> & seqs,
 			const std::vector<POSTYPE> & selected){
-		//create temporary file, the last 6 xs will be randomized characters
-		bfs::path tmpnameStr = njh::files::make_path(workingPath_, "tmpfileXXXXXX").string();
-		char * tmpname = strdup(tmpnameStr.c_str());
-		auto mkTempRet = mkstemp(tmpname);
-		if(-1 == mkTempRet){
-			std::stringstream sErr;
-			sErr << __PRETTY_FUNCTION__ << ", error in creating file name from template " << tmpname << "\n";
-			throw std::runtime_error{sErr.str()};
-		}
-		close(mkTempRet);
-		uint32_t seqsWritten = 0;
+		std::vector<seqInfo> toAlign;
 		std::vector<uint32_t> seqsWithStopCodonEndings;
-		{
-			//in it's own scope so that that tFile gets flushed at termination, (i could just call flush but this way i won't forget)
-			std::ofstream tFile(tmpname);
-			if(!tFile){
-				throw std::runtime_error{njh::bashCT::boldRed("Error in opening " + std::string(tmpname))};
+		//name each seq by its position as muscle will reorganize the seqs afterwards
+		for (const auto & pos : selected) {
+			if (pos >= seqs.size()) {
+				throw std::out_of_range {
+						"Error in njhseq::sys::muscleSeqs, position out of range, pos: "
+								+ estd::to_string(pos) + ", size: "
+								+ estd::to_string(seqs.size()) };
 			}
-			//make name the read position as muscle will reorganize the seqs afterwards
-
-			for (const auto & pos : selected) {
-				if (pos >= seqs.size()) {
-					throw std::out_of_range {
-							"Error in njhseq::sys::muscleSeqs, position out of range, pos: "
-									+ estd::to_string(pos) + ", size: "
-									+ estd::to_string(seqs.size()) };
-				}
-				//hack because muscle doesn't like stop codons
+			//hack because muscle doesn't like stop codons
 
-				if ('*' == getSeqBase(seqs[pos]).seq_.back()) {
-					seqsWithStopCodonEndings.emplace_back(pos);
-					getSeqBase(seqs[pos]).trimBack(len(seqs[pos]) - 1);
-				}
-				if (!njh::containsSubString(getSeqBase(seqs[pos]).seq_, "*")
-						&& "" != getSeqBase(seqs[pos]).seq_) {
-					++seqsWritten;
-					tFile << ">" << pos << "\n";
-					tFile << getSeqBase(seqs[pos]).seq_ << "\n";
-				}
+			if ('*' == getSeqBase(seqs[pos]).seq_.back()) {
+				seqsWithStopCodonEndings.emplace_back(pos);
+				getSeqBase(seqs[pos]).trimBack(len(seqs[pos]) - 1);
+			}
+			if (!njh::containsSubString(getSeqBase(seqs[pos]).seq_, "*")
+					&& "" != getSeqBase(seqs[pos]).seq_) {
+				toAlign.emplace_back(estd::to_string(pos), getSeqBase(seqs[pos]).seq_);
 			}
 		}
-		//this is for when there are no sequences written due to all having stop codons which muscle won't align;
-		if(seqsWritten > 0){
-			std::vector<readObject> tempObjs;
-			try {
-				std::vector<std::string> cmds { musclePath_.string(), "-quiet", "-in", tmpname };
-				auto rOut = njh::sys::run(cmds);
-				if(!rOut.success_){
-					std::stringstream sErr;
-					sErr << rOut.stdOut_ << std::endl;
-					sErr << njh::bashCT::red << "failure:" << std::endl;
-					sErr << rOut.stdErr_ << std::endl;
-					sErr << njh::bashCT::reset << std::endl;
-					throw std::runtime_error{sErr.str()};
-				}
-				std::stringstream ss(rOut.stdOut_);
-				SeqIOOptions opts;
-				SeqInput reader(opts);
-				seqInfo seq;
-				while(reader.readNextFastaStream(ss, seq,false)){
-					auto & currentRead = getSeqBase(seqs[std::stoul(seq.name_)]);
-					auto gAlnInfo = genGlobalAlnInfo(seq.seq_);
-					alignCalc::rearrangeGlobalQueryOnly(currentRead.seq_, '-', gAlnInfo );
-					alignCalc::rearrangeGlobalQueryOnly(currentRead.qual_, 0,  gAlnInfo );
-				}
-				for(const auto & pos : seqsWithStopCodonEndings){
-					if('-' == getSeqBase(seqs[pos]).seq_.back() ){
-						uint32_t lastBase = getSeqBase(seqs[pos]).seq_.find_last_not_of("-");
-						if(lastBase < len(getSeqBase(seqs[pos]))){
-							getSeqBase(seqs[pos]).insert(lastBase + 1, seqInfo("", "*"));
-						}
-					}else{
-						getSeqBase(seqs[pos]).append("*");
+		//this is for when there are no sequences to align due to all having stop codons which muscle won't align;
+		if(!toAlign.empty()){
+			for (const auto & seq : alignRaw(toAlign)) {
+				auto & currentRead = getSeqBase(seqs[std::stoul(seq.name_)]);
+				auto gAlnInfo = genGlobalAlnInfo(seq.seq_);
+				alignCalc::rearrangeGlobalQueryOnly(currentRead.seq_, '-', gAlnInfo );
+				alignCalc::rearrangeGlobalQueryOnly(currentRead.qual_, 0,  gAlnInfo );
+			}
+			for(const auto & pos : seqsWithStopCodonEndings){
+				if('-' == getSeqBase(seqs[pos]).seq_.back() ){
+					uint32_t lastBase = getSeqBase(seqs[pos]).seq_.find_last_not_of("-");
+					if(lastBase < len(getSeqBase(seqs[pos]))){
+						getSeqBase(seqs[pos]).insert(lastBase + 1, seqInfo("", "*"));
 					}
+				}else{
+					getSeqBase(seqs[pos]).append("*");
 				}
-			} catch (std::exception & e) {
-				std::cerr << e.what() << std::endl;
-				if(!keepTemp_){
-					njh::files::bfs::remove(tmpname);
-				}
-				throw e;
-			}
-			if(!keepTemp_){
-				njh::files::bfs::remove(tmpname);
 			}
 		}
 	}
@@ -180,131 +160,77 @@ public:
 	template<typename T>
 	void muscleSeqs(std::vector<T> & seqs,
 			const std::unordered_map<uint32_t, Muscler::MusPosSize> & posSizes){
-		//create temporary file, the last 6 xs will be randomized characters
-		bfs::path tmpnameStr = njh::files::make_path(workingPath_, "tmpfileXXXXXX").string();
-		char * tmpname = strdup(tmpnameStr.c_str());
-		auto mkTempRet = mkstemp(tmpname);
-		if(-1 == mkTempRet){
-			std::stringstream sErr;
-			sErr << __PRETTY_FUNCTION__ << ", error in creating file name from template " << tmpname << "\n";
-			throw std::runtime_error{sErr.str()};
-		}
-		close(mkTempRet);
-	//		auto mkTempRet = mktemp(tmpname);
-	//		if(nullptr == mkTempRet){
-	//			std::stringstream sErr;
-	//			sErr << __PRETTY_FUNCTION__ << ", error in creating file name from template " << tmpname << "\n";
-	//			throw std::runtime_error{sErr.str()};
-	//		}
-		uint32_t seqsWritten = 0;
+		std::vector<seqInfo> toAlign;
 		std::unordered_map<uint32_t, std::shared_ptr<seqInfo>> subInfos;
 		std::vector<uint32_t> seqsWithStopCodonEndings;
-		{
-			//in it's own scope so that that tFile gets flushed at termination
-			std::ofstream tFile(tmpname);
-			if(!tFile){
-				throw std::runtime_error{njh::bashCT::boldRed("Error in opening " + std::string(tmpname))};
+		//name each seq by its position as muscle will reorganize the seqs afterwards
+		for (const auto & pos : posSizes) {
+			if (pos.first >= seqs.size()) {
+				throw std::out_of_range {
+						"Error in " + std::string(__PRETTY_FUNCTION__) + ", position out of range, pos: "
+								+ estd::to_string(pos.first) + ", size: "
+								+ estd::to_string(seqs.size()) };
 			}
-			//make name the read position as muscle will reorganize the seqs afterwards
-
-			for (const auto & pos : posSizes) {
-				if (pos.first >= seqs.size()) {
-					throw std::out_of_range {
-							"Error in " + std::string(__PRETTY_FUNCTION__) + ", position out of range, pos: "
-									+ estd::to_string(pos.first) + ", size: "
-									+ estd::to_string(seqs.size()) };
-				}
-				if(pos.second.pos_ > len(getSeqBase(seqs[pos.first]))){
-					std::stringstream ss;
-					ss << __PRETTY_FUNCTION__ << ", error pos.second.pos_ " << pos.second.pos_ << " is greater than the length of "
-							<< getSeqBase(seqs[pos.first]).name_ << ", " << len(getSeqBase(seqs[pos.first])) << "\n";
-					throw std::out_of_range {ss.str()};
-				}
-				std::shared_ptr<seqInfo> subSeq;
-				if(std::numeric_limits<uint32_t>::max() == pos.second.size_ ){
-					subSeq = std::make_shared<seqInfo>(getSeqBase(seqs[pos.first]).getSubRead(pos.second.pos_));
-				}else{
-					subSeq = std::make_shared<seqInfo>(getSeqBase(seqs[pos.first]).getSubRead(pos.second.pos_, pos.second.size_));
-				}
-				//hack because muscle doesn't like stop codons
-
-				if ('*' == subSeq->seq_.back()) {
-					seqsWithStopCodonEndings.emplace_back(pos.first);
-					subSeq->trimBack(len(*subSeq) - 1);
-				}
+			if(pos.second.pos_ > len(getSeqBase(seqs[pos.first]))){
+				std::stringstream ss;
+				ss << __PRETTY_FUNCTION__ << ", error pos.second.pos_ " << pos.second.pos_ << " is greater than the length of "
+						<< getSeqBase(seqs[pos.first]).name_ << ", " << len(getSeqBase(seqs[pos.first])) << "\n";
+				throw std::out_of_range {ss.str()};
+			}
+			std::shared_ptr<seqInfo> subSeq;
+			if(std::numeric_limits<uint32_t>::max() == pos.second.size_ ){
+				subSeq = std::make_shared<seqInfo>(getSeqBase(seqs[pos.first]).getSubRead(pos.second.pos_));
+			}else{
+				subSeq = std::make_shared<seqInfo>(getSeqBase(seqs[pos.first]).getSubRead(pos.second.pos_, pos.second.size_));
+			}
+			//hack because muscle doesn't like stop codons
 
-				if(!njh::containsSubString(subSeq->seq_, "*")
-							&& "" != getSeqBase(seqs[pos.first]).seq_
-							&& getSeqBase(seqs[pos.first]).seq_.find_first_not_of('-') != std::string::npos) {
+			if ('*' == subSeq->seq_.back()) {
+				seqsWithStopCodonEndings.emplace_back(pos.first);
+				subSeq->trimBack(len(*subSeq) - 1);
+			}
 
-					++seqsWritten;
-					subSeq->removeGaps();
-					tFile << ">" << pos.first << "\n";
-					tFile << subSeq->seq_ << "\n";
-					subInfos[pos.first] = subSeq;
-				}
+			if(!njh::containsSubString(subSeq->seq_, "*")
+						&& "" != getSeqBase(seqs[pos.first]).seq_
+						&& getSeqBase(seqs[pos.first]).seq_.find_first_not_of('-') != std::string::npos) {
+				subSeq->removeGaps();
+				toAlign.emplace_back(estd::to_string(pos.first), subSeq->seq_);
+				subInfos[pos.first] = subSeq;
 			}
 		}
-		//this is for when there are no sequences written due to all having stop codons which muscle won't align;
-		if(seqsWritten > 0){
-			std::vector<readObject> tempObjs;
-			try {
-				std::vector<std::string> cmds { musclePath_.string(), "-quiet", "-in", tmpname };
-				auto rOut = njh::sys::run(cmds);
-				if(!rOut.success_){
-					std::stringstream sErr;
-					sErr << __PRETTY_FUNCTION__ << ", error " << "\n";
-					sErr << rOut.stdOut_ << std::endl;
-					sErr << njh::bashCT::red << "failure:" << std::endl;
-					sErr << rOut.stdErr_ << std::endl;
-					sErr << njh::bashCT::reset << std::endl;
-					throw std::runtime_error{sErr.str()};
+		//this is for when there are no sequences to align due to all having stop codons which muscle won't align;
+		if(!toAlign.empty()){
+			uint64_t maxLen = 0;
+			for (const auto & seq : alignRaw(toAlign)) {
+				readVec::getMaxLength(seq, maxLen);
+				uint32_t pos = estd::stou(seq.name_);
+				auto gAlnInfo = genGlobalAlnInfo(seq.seq_);
+				alignCalc::rearrangeGlobalQueryOnly(subInfos[pos]->seq_, '-', gAlnInfo );
+				alignCalc::rearrangeGlobalQueryOnly(subInfos[pos]->qual_, 0, gAlnInfo );
+				if(njh::in(pos, seqsWithStopCodonEndings)){
+					subInfos[pos]->append("*");
 				}
-				std::stringstream ss(rOut.stdOut_);
-				SeqIOOptions opts;
-				SeqInput reader(opts);
-				seqInfo seq;
-				uint64_t maxLen = 0;
-				while(reader.readNextFastaStream(ss, seq,false)){
-					readVec::getMaxLength(seq, maxLen);
-					uint32_t pos = estd::stou(seq.name_);
-					auto gAlnInfo = genGlobalAlnInfo(seq.seq_);
-					alignCalc::rearrangeGlobalQueryOnly(subInfos[pos]->seq_, '-', gAlnInfo );
-					alignCalc::rearrangeGlobalQueryOnly(subInfos[pos]->qual_, 0, gAlnInfo );
-					if(njh::in(pos, seqsWithStopCodonEndings)){
-						subInfos[pos]->append("*");
-					}
-					if(std::numeric_limits<uint32_t>::max() == posSizes.at(pos).size_){
-						getSeqBase(seqs[pos]).trimBack(posSizes.at(pos).pos_);
-					}else{
-						getSeqBase(seqs[pos]).clipOut(posSizes.at(pos).pos_, posSizes.at(pos).size_);
-					}
-					getSeqBase(seqs[pos]).insert(posSizes.at(pos).pos_, *(subInfos[pos]));
+				if(std::numeric_limits<uint32_t>::max() == posSizes.at(pos).size_){
+					getSeqBase(seqs[pos]).trimBack(posSizes.at(pos).pos_);
+				}else{
+					getSeqBase(seqs[pos]).clipOut(posSizes.at(pos).pos_, posSizes.at(pos).size_);
 				}
-				//muscle removes seqs that are all gaps so have to adjust gap sizes if sub selection was just all gaps
-				for (const auto & pos : posSizes) {
-					if(getSeqBase(seqs[pos.first]).seq_.substr(pos.second.pos_, pos.second.size_).find_first_not_of('-') == std::string::npos){
-						if (std::numeric_limits<uint32_t>::max()
-								== posSizes.at(pos.first).size_) {
-							getSeqBase(seqs[pos.first]).trimBack(posSizes.at(pos.first).pos_);
-						} else {
-							getSeqBase(seqs[pos.first]).clipOut(posSizes.at(pos.first).pos_,
-									posSizes.at(pos.first).size_);
-						}
-						getSeqBase(seqs[pos.first]).insert(posSizes.at(pos.first).pos_, seqInfo("", std::string(maxLen, '-'), std::vector<uint32_t>(maxLen, 0)));
+				getSeqBase(seqs[pos]).insert(posSizes.at(pos).pos_, *(subInfos[pos]));
+			}
+			//muscle removes seqs that are all gaps so have to adjust gap sizes if sub selection was just all gaps
+			for (const auto & pos : posSizes) {
+				if(getSeqBase(seqs[pos.first]).seq_.substr(pos.second.pos_, pos.second.size_).find_first_not_of('-') == std::string::npos){
+					if (std::numeric_limits<uint32_t>::max()
+							== posSizes.at(pos.first).size_) {
+						getSeqBase(seqs[pos.first]).trimBack(posSizes.at(pos.first).pos_);
+					} else {
+						getSeqBase(seqs[pos.first]).clipOut(posSizes.at(pos.first).pos_,
+								posSizes.at(pos.first).size_);
 					}
+					getSeqBase(seqs[pos.first]).insert(posSizes.at(pos.first).pos_, seqInfo("", std::string(maxLen, '-'), std::vector<uint32_t>(maxLen, 0)));
 				}
-			} catch (std::exception & e) {
-				std::cerr << e.what() << std::endl;
-				if(!keepTemp_){
-					njh::files::bfs::remove(tmpname);
-				}
-				throw std::runtime_error{e.what()};
 			}
 		}
-		if(!keepTemp_){
-			njh::files::bfs::remove(tmpname);
-		}
 	}
 
 	/**@brief muscle the sequences in seqs
@@ -0,0 +1,47 @@
+/*
+ * seqKernelsBenchmark.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: nick
+ */
+// njhseq - A library for analyzing sequence data
+// Copyright (C) 2012-2018 Nicholas Hathaway <nicholas.hathaway@umassmed.edu>,
+//
+// This file is part of njhseq.
+//
+// njhseq is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// njhseq is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with njhseq.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "njhseq/helpers/SeqKernels.hpp"
+
+//prints the SeqKernels timing table, build and run with make benchmarkKernels
+//optional arguments are the read length, the number of reads and the number of iterations
+int main(int argc, char* argv[]) {
+	uint32_t seqLength = 250;
+	uint32_t numberOfSeqs = 10000;
+	uint32_t iterations = 20;
+	if (argc > 1) {
+		seqLength = std::stoul(argv[1]);
+	}
+	if (argc > 2) {
+		numberOfSeqs = std::stoul(argv[2]);
+	}
+	if (argc > 3) {
+		iterations = std::stoul(argv[3]);
+	}
+	std::cout << "supported level: "
+			<< njhseq::SeqKernels::getLevelName(njhseq::SeqKernels::getSupportedLevel())
+			<< std::endl;
+	njhseq::SeqKernels::benchmark(std::cout, seqLength, numberOfSeqs, iterations);
+	return 0;
+}
@@ -0,0 +1,55 @@
+#include <catch.hpp>
+
+#include "njhseq/objects/dataContainers/tables/TableJoiner.hpp"
+using namespace njhseq;
+
+namespace {
+
+std::vector<VecStr> sortedRows(std::vector<VecStr> rows) {
+	std::sort(rows.begin(), rows.end());
+	return rows;
+}
+
+}  // namespace
+
+TEST_CASE("TableJoiner sort merge join matches table::join", "[TableJoiner]" ){
+	auto tmpDir = bfs::unique_path(bfs::temp_directory_path() / "tableJoinerTester-%%%%-%%%%");
+	bfs::create_directories(tmpDir);
+	auto leftFnp = tmpDir / "left.tab.txt";
+	auto rightFnp = tmpDir / "right.tab.txt";
+	{
+		//repeated keys on both sides so a key group has more than one left and right row
+		std::ofstream leftOut(leftFnp.string());
+		leftOut << "key\tleftVal\n"
+				<< "b\t1\n" << "a\t2\n" << "b\t3\n" << "c\t4\n" << "b\t5\n" << "e\t6\n" << "a\t7\n";
+		std::ofstream rightOut(rightFnp.string());
+		rightOut << "key\trightVal\n"
+				<< "a\tx\n" << "b\ty\n" << "d\tz\n" << "b\tw\n" << "f\tv\n" << "e\tu\n";
+	}
+	auto leftOpts = TableIOOpts::genTabFileIn(leftFnp, true);
+	auto rightOpts = TableIOOpts::genTabFileIn(rightFnp, true);
+	table leftTab(leftOpts);
+	table rightTab(rightOpts);
+
+	for (const auto type : { table::JoinType::INNER, table::JoinType::LEFT, table::JoinType::OUTER }) {
+		SECTION(table::getJoinTypeStr(type)){
+			auto expected = leftTab.join(rightTab, VecStr{"key"}, type);
+
+			TableJoiner::Pars pars;
+			pars.type_ = type;
+			pars.tmpDir_ = tmpDir;
+			//a budget of a few bytes forces the sorted runs and the sort merge join
+			pars.memoryBudget_ = 1;
+			TableJoiner joiner(leftOpts, rightOpts, VecStr{"key"}, VecStr{"key"}, pars);
+			REQUIRE_FALSE(joiner.rightFitsInMemory());
+
+			std::stringstream joined;
+			joiner.join(joined, "\t", true);
+			table observed(joined, "\t", true);
+
+			REQUIRE(expected.columnNames_ == observed.columnNames_);
+			REQUIRE(sortedRows(expected.content_) == sortedRows(observed.content_));
+		}
+	}
+	bfs::remove_all(tmpDir);
+}